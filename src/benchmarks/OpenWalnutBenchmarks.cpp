@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef OW_BOOST_PROGRAM_OPTIONS_FIX
+// This circumvents an issue with boost program_options. The linker complains about missing "arg".
+namespace boost
+{
+    namespace program_options
+    {
+        std::string arg;
+    }
+}
+#endif  // OW_BOOST_PROGRAM_OPTIONS_FIX
+#include <boost/program_options.hpp>
+
+#include "core/common/WLogger.h"
+#include "WBenchmark.h"
+#include "WCoreBenchmarks.h"
+
+/**
+ * Runs the benchmarks of the core library on synthetic data and optionally writes the results as JSON. Use
+ * tools/compareBenchmarks.py to compare the results against a baseline.
+ *
+ * \param argc As always.
+ * \param argv Nothing to see here.
+ *
+ * \return 0 on success.
+ */
+int main( int argc, char** argv )
+{
+    namespace po = boost::program_options;
+    WCoreBenchmarkParameters parameters;
+
+    po::options_description desc( "Options" );
+    desc.add_options()
+        ( "help,h", "Prints this help message" )
+        ( "list,l", "Lists the benchmarks" )
+        ( "filter,f", po::value< std::string >()->default_value( "" ), "Only run benchmarks whose name matches this regular expression." )
+        ( "json,j", po::value< std::string >(), "Write the results as JSON to this file." )
+        ( "repetitions,r", po::value< std::size_t >()->default_value( 10 ), "The number of timed runs of each benchmark." )
+        ( "volume-size", po::value< std::size_t >( &parameters.m_volumeSize )->default_value( parameters.m_volumeSize ),
+          "The number of voxels along each axis of the volumes." )
+        ( "fibers", po::value< std::size_t >( &parameters.m_nbFibers )->default_value( parameters.m_nbFibers ),
+          "The number of fibers." )
+        ( "fiber-points", po::value< std::size_t >( &parameters.m_nbFiberPoints )->default_value( parameters.m_nbFiberPoints ),
+          "The number of points per fiber." )
+        ( "mesh-resolution", po::value< std::size_t >( &parameters.m_meshResolution )->default_value( parameters.m_meshResolution ),
+          "The number of rings of the test mesh." )
+        ( "lookups", po::value< std::size_t >( &parameters.m_nbLookups )->default_value( parameters.m_nbLookups ),
+          "The number of random positions looked up in grids and datasets." );
+
+    po::variables_map optionsMap;
+    try
+    {
+        po::store( po::command_line_parser( argc, argv ).options( desc ).run(), optionsMap );
+        po::notify( optionsMap );
+    }
+    catch( const po::error &e )
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    if( optionsMap.count( "help" ) )
+    {
+        std::cout << "Benchmarks of the OpenWalnut core library on synthetic data." << std::endl
+                  << std::endl
+                  << "Usage: ow_benchmarks [OPTION]..." << std::endl
+                  << std::endl
+                  << desc << std::endl;
+        return 0;
+    }
+
+    // the algorithms log a lot, keep the results readable
+    WLogger::startup( std::cerr, LL_WARNING );
+
+    WBenchmarkSuite suite( optionsMap[ "repetitions" ].as< std::size_t >() );
+    addCoreBenchmarks( suite, parameters );
+
+    if( optionsMap.count( "list" ) )
+    {
+        std::vector< std::string > const names = suite.getNames();
+        for( std::size_t i = 0; i < names.size(); ++i )
+        {
+            std::cout << names[ i ] << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector< WBenchmarkResult > const results = suite.run( optionsMap[ "filter" ].as< std::string >(), std::cout );
+
+    if( optionsMap.count( "json" ) )
+    {
+        std::ofstream out( optionsMap[ "json" ].as< std::string >().c_str() );
+        WBenchmarkSuite::writeJSON( out, results, parameters.toList() );
+        if( !out )
+        {
+            std::cerr << "Could not write " << optionsMap[ "json" ].as< std::string >() << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include "core/common/exceptions/WNameNotUnique.h"
+#include "WBenchmark.h"
+
+WBenchmarkSuite::WBenchmarkSuite( std::size_t repetitions )
+    : m_repetitions( std::max< std::size_t >( repetitions, 1 ) )
+{
+}
+
+void WBenchmarkSuite::add( std::string const& name, Setup setup )
+{
+    if( std::find( m_names.begin(), m_names.end(), name ) != m_names.end() )
+    {
+        throw WNameNotUnique( "A benchmark named \"" + name + "\" already exists." );
+    }
+    m_names.push_back( name );
+    m_setups.push_back( setup );
+}
+
+std::vector< std::string > WBenchmarkSuite::getNames() const
+{
+    return m_names;
+}
+
+std::vector< WBenchmarkResult > WBenchmarkSuite::run( std::string const& filter, std::ostream& log ) const
+{
+    typedef std::chrono::steady_clock Clock;
+
+    boost::regex const expression( filter );
+    std::vector< WBenchmarkResult > results;
+    for( std::size_t i = 0; i < m_names.size(); ++i )
+    {
+        if( !boost::regex_search( m_names[ i ], expression ) )
+        {
+            continue;
+        }
+
+        log << m_names[ i ] << " ... " << std::flush;
+        Function const function = m_setups[ i ]();
+
+        // warm up
+        WBenchmarkResult result;
+        result.m_name = m_names[ i ];
+        result.m_repetitions = m_repetitions;
+        result.m_items = function();
+
+        std::vector< double > times( m_repetitions );
+        for( std::size_t k = 0; k < m_repetitions; ++k )
+        {
+            Clock::time_point const start = Clock::now();
+            function();
+            times[ k ] = std::chrono::duration< double, std::nano >( Clock::now() - start ).count();
+        }
+
+        std::sort( times.begin(), times.end() );
+        result.m_min = times.front();
+        result.m_median = ( times.size() % 2 == 1 ) ? times[ times.size() / 2 ] :
+                                                      0.5 * ( times[ times.size() / 2 - 1 ] + times[ times.size() / 2 ] );
+        result.m_mean = std::accumulate( times.begin(), times.end(), 0.0 ) / times.size();
+        results.push_back( result );
+
+        char line[ 128 ];
+        std::snprintf( line, sizeof( line ), "median %.3f ms, min %.3f ms, %.3g items/s", result.m_median * 1e-6, result.m_min * 1e-6,
+                       result.m_items / ( result.m_median * 1e-9 ) );
+        log << line << std::endl;
+    }
+    return results;
+}
+
+void WBenchmarkSuite::writeJSON( std::ostream& out, std::vector< WBenchmarkResult > const& results,
+                                 std::vector< std::pair< std::string, std::string > > const& parameters )
+{
+    // names and parameters are created by us and never need escaping
+    out << "{\n  \"format\": \"ow_benchmarks 1\",\n  \"parameters\": {";
+    for( std::size_t i = 0; i < parameters.size(); ++i )
+    {
+        out << ( i == 0 ? "" : "," ) << "\n    \"" << parameters[ i ].first << "\": \"" << parameters[ i ].second << "\"";
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+    for( std::size_t i = 0; i < results.size(); ++i )
+    {
+        WBenchmarkResult const& r = results[ i ];
+        // a median below the clock resolution has no rate, and JSON has no infinity
+        char rate[ 32 ] = "null";
+        if( r.m_median > 0.0 )
+        {
+            std::snprintf( rate, sizeof( rate ), "%.6g", r.m_items / ( r.m_median * 1e-9 ) );
+        }
+        char values[ 256 ];
+        std::snprintf( values, sizeof( values ),
+                       "\"repetitions\": %zu, \"items\": %zu, \"min_ns\": %.0f, \"median_ns\": %.0f, \"mean_ns\": %.0f, "
+                       "\"items_per_second\": %s",
+                       r.m_repetitions, r.m_items, r.m_min, r.m_median, r.m_mean, rate );
+        out << ( i == 0 ? "" : "," ) << "\n    { \"name\": \"" << r.m_name << "\", " << values << " }";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,131 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WBENCHMARK_H
+#define WBENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The result of a single benchmark. Times are wall clock times of a single repetition.
+ */
+struct WBenchmarkResult
+{
+    //! the name of the benchmark
+    std::string m_name;
+
+    //! the number of timed repetitions
+    std::size_t m_repetitions;
+
+    //! the number of items, like voxels or fibers, processed per repetition
+    std::size_t m_items;
+
+    //! the fastest repetition in nanoseconds
+    double m_min;
+
+    //! the median of all repetitions in nanoseconds
+    double m_median;
+
+    //! the mean of all repetitions in nanoseconds
+    double m_mean;
+};
+
+/**
+ * A set of named benchmarks. Each benchmark consists of an untimed setup, creating the input data, and the timed function
+ * returned by the setup. The timed function is run once to warm up caches and then repeatedly to collect the timings.
+ */
+class WBenchmarkSuite // NOLINT
+{
+public:
+    /**
+     * The timed part of a benchmark.
+     *
+     * \return the number of items processed, used to report the throughput
+     */
+    typedef std::function< std::size_t() > Function;
+
+    /**
+     * Creates the input data of a benchmark and returns the function to time.
+     *
+     * \return the timed function
+     */
+    typedef std::function< Function() > Setup;
+
+    /**
+     * Constructor.
+     *
+     * \param repetitions the number of timed repetitions per benchmark
+     */
+    explicit WBenchmarkSuite( std::size_t repetitions = 10 );
+
+    /**
+     * Add a benchmark.
+     *
+     * \param name a unique name, groups are separated by slashes like "WKdTree/build"
+     * \param setup creates the data and returns the function to time
+     */
+    void add( std::string const& name, Setup setup );
+
+    /**
+     * The names of all benchmarks, in the order they were added.
+     *
+     * \return the names
+     */
+    std::vector< std::string > getNames() const;
+
+    /**
+     * Run all benchmarks whose names match the given regular expression. Progress is written to the given stream.
+     *
+     * \param filter a regular expression, searched in the names
+     * \param log the stream to report progress to
+     *
+     * \return the results
+     */
+    std::vector< WBenchmarkResult > run( std::string const& filter, std::ostream& log ) const;
+
+    /**
+     * Write results as JSON. This is the format tools/compareBenchmarks.py reads.
+     *
+     * \param out the stream
+     * \param results the results
+     * \param parameters name and value pairs of the parameters used to create the data
+     */
+    static void writeJSON( std::ostream& out, std::vector< WBenchmarkResult > const& results,
+                           std::vector< std::pair< std::string, std::string > > const& parameters );
+
+private:
+    //! the number of timed repetitions
+    std::size_t m_repetitions;
+
+    //! the names of the benchmarks
+    std::vector< std::string > m_names;
+
+    //! the setups of the benchmarks
+    std::vector< Setup > m_setups;
+};
+
+#endif  // WBENCHMARK_H
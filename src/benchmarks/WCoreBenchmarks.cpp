@@ -0,0 +1,262 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "core/common/WIOTools.h"
+#include "core/common/WProgressCombiner.h"
+#include "core/common/algorithms/WMarchingCubesAlgorithm.h"
+#include "core/dataHandler/io/WWriterFiberVTK.h"
+#include "core/kernel/WKdTree.h"
+#include "modules/data/io/WReaderFiberVTK.h"
+#include "WCoreBenchmarks.h"
+#include "WSyntheticData.h"
+
+std::vector< std::pair< std::string, std::string > > WCoreBenchmarkParameters::toList() const
+{
+    std::vector< std::pair< std::string, std::string > > list;
+    list.push_back( std::make_pair( "volume-size", std::to_string( m_volumeSize ) ) );
+    list.push_back( std::make_pair( "fibers", std::to_string( m_nbFibers ) ) );
+    list.push_back( std::make_pair( "fiber-points", std::to_string( m_nbFiberPoints ) ) );
+    list.push_back( std::make_pair( "mesh-resolution", std::to_string( m_meshResolution ) ) );
+    list.push_back( std::make_pair( "lookups", std::to_string( m_nbLookups ) ) );
+    return list;
+}
+
+namespace
+{
+    //! Stores results nobody reads, to keep the compiler from removing the benchmarked code.
+    volatile double sink = 0.0;
+
+    /**
+     * A temporary file name. The file gets removed with the last copy of the pointer.
+     *
+     * \return the file name
+     */
+    std::shared_ptr< boost::filesystem::path > createTempFile()
+    {
+        return std::shared_ptr< boost::filesystem::path >( new boost::filesystem::path( tempFilename( "ow_benchmark_%%%%%%%%.fib" ) ),
+            []( boost::filesystem::path* path )
+            {
+                boost::filesystem::remove( *path );
+                delete path;
+            } );
+    }
+
+    /**
+     * Adds benchmarks constructing value sets and reading all values through the virtual WValueSetBase interface.
+     *
+     * \tparam T the type of the values
+     * \param suite the suite
+     * \param name the name of the type
+     * \param p the parameters
+     */
+    template< typename T >
+    void addValueSetBenchmarks( WBenchmarkSuite& suite, std::string const& name, WCoreBenchmarkParameters const& p ) // NOLINT non-const ref
+    {
+        suite.add( "WValueSet/construct<" + name + ">", [ p ]()
+            {
+                std::shared_ptr< WDataSetScalar > volume = synthetic::createVolume< T >( p.m_volumeSize );
+                std::shared_ptr< std::vector< T > > data( new std::vector< T >(
+                    *std::dynamic_pointer_cast< WValueSet< T > >( volume->getValueSet() )->rawDataVectorPointer() ) );
+                return WBenchmarkSuite::Function( [ data ]()
+                    {
+                        // the constructor determines minimum and maximum
+                        WValueSet< T > valueSet( 0, 1, data );
+                        return valueSet.size();
+                    } );
+            } );
+
+        suite.add( "WValueSet/getScalarDouble<" + name + ">", [ p ]()
+            {
+                std::shared_ptr< WValueSetBase > valueSet = synthetic::createVolume< T >( p.m_volumeSize )->getValueSet();
+                return WBenchmarkSuite::Function( [ valueSet ]()
+                    {
+                        double sum = 0.0;
+                        for( std::size_t i = 0; i < valueSet->size(); ++i )
+                        {
+                            sum += valueSet->getScalarDouble( i );
+                        }
+                        sink = sum;
+                        return valueSet->size();
+                    } );
+            } );
+    }
+
+    /**
+     * Adds a marching cubes benchmark.
+     *
+     * \tparam T the type of the values
+     * \param suite the suite
+     * \param name the name of the type
+     * \param p the parameters
+     */
+    template< typename T >
+    void addMarchingCubesBenchmark( WBenchmarkSuite& suite, std::string const& name, WCoreBenchmarkParameters const& p ) // NOLINT
+    {
+        suite.add( "WMarchingCubesAlgorithm/generateSurface<" + name + ">", [ p ]()
+            {
+                std::shared_ptr< WDataSetScalar > volume = synthetic::createVolume< T >( p.m_volumeSize );
+                std::shared_ptr< WValueSet< T > > valueSet = std::dynamic_pointer_cast< WValueSet< T > >( volume->getValueSet() );
+                std::shared_ptr< WGridRegular3D > grid = std::dynamic_pointer_cast< WGridRegular3D >( volume->getGrid() );
+                return WBenchmarkSuite::Function( [ volume, valueSet, grid ]()
+                    {
+                        WMarchingCubesAlgorithm algorithm;
+                        std::shared_ptr< WProgressCombiner > progress( new WProgressCombiner() );
+                        algorithm.generateSurface( grid->getNbCoordsX(), grid->getNbCoordsY(), grid->getNbCoordsZ(),
+                                                   grid->getTransformationMatrix(), valueSet->rawDataVectorPointer(), 50.0, progress );
+                        return valueSet->size();
+                    } );
+            } );
+    }
+}
+
+void addCoreBenchmarks( WBenchmarkSuite& suite, WCoreBenchmarkParameters const& p )
+{
+    // grids and datasets
+    suite.add( "WGridRegular3D/getVoxelNum", [ p ]()
+        {
+            std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( p.m_volumeSize, p.m_volumeSize, p.m_volumeSize ) );
+            std::shared_ptr< std::vector< WPosition > > positions(
+                new std::vector< WPosition >( synthetic::createPositions( p.m_nbLookups, static_cast< double >( p.m_volumeSize ) ) ) );
+            return WBenchmarkSuite::Function( [ grid, positions ]()
+                {
+                    double sum = 0.0;
+                    for( std::size_t i = 0; i < positions->size(); ++i )
+                    {
+                        sum += grid->getVoxelNum( ( *positions )[ i ] );
+                    }
+                    sink = sum;
+                    return positions->size();
+                } );
+        } );
+
+    suite.add( "WGridRegular3D/getCellId", [ p ]()
+        {
+            std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( p.m_volumeSize, p.m_volumeSize, p.m_volumeSize ) );
+            std::shared_ptr< std::vector< WPosition > > positions(
+                new std::vector< WPosition >( synthetic::createPositions( p.m_nbLookups, static_cast< double >( p.m_volumeSize ) ) ) );
+            return WBenchmarkSuite::Function( [ grid, positions ]()
+                {
+                    double sum = 0.0;
+                    bool success = false;
+                    for( std::size_t i = 0; i < positions->size(); ++i )
+                    {
+                        sum += grid->getCellId( ( *positions )[ i ], &success );
+                    }
+                    sink = sum;
+                    return positions->size();
+                } );
+        } );
+
+    suite.add( "WDataSetScalar/interpolate<float>", [ p ]()
+        {
+            std::shared_ptr< WDataSetScalar > volume = synthetic::createVolume< float >( p.m_volumeSize );
+            std::shared_ptr< std::vector< WPosition > > positions(
+                new std::vector< WPosition >( synthetic::createPositions( p.m_nbLookups, p.m_volumeSize - 1.0 ) ) );
+            return WBenchmarkSuite::Function( [ volume, positions ]()
+                {
+                    double sum = 0.0;
+                    bool success = false;
+                    for( std::size_t i = 0; i < positions->size(); ++i )
+                    {
+                        sum += volume->interpolate( ( *positions )[ i ], &success );
+                    }
+                    sink = sum;
+                    return positions->size();
+                } );
+        } );
+
+    addValueSetBenchmarks< uint8_t >( suite, "uint8", p );
+    addValueSetBenchmarks< int16_t >( suite, "int16", p );
+    addValueSetBenchmarks< float >( suite, "float", p );
+
+    addMarchingCubesBenchmark< uint8_t >( suite, "uint8", p );
+    addMarchingCubesBenchmark< float >( suite, "float", p );
+
+    // fibers
+    suite.add( "WKdTree/build", [ p ]()
+        {
+            synthetic::Tractogram tractogram = synthetic::createTractogram( p.m_nbFibers, p.m_nbFiberPoints, 160.0 );
+            WDataSetFibers::VertexArray vertices = tractogram.m_vertices;
+            return WBenchmarkSuite::Function( [ vertices ]()
+                {
+                    WKdTree tree( static_cast< int >( vertices->size() / 3 ), &( *vertices )[ 0 ] );
+                    return vertices->size() / 3;
+                } );
+        } );
+
+    suite.add( "WDataSetFibers/construct", [ p ]()
+        {
+            synthetic::Tractogram tractogram = synthetic::createTractogram( p.m_nbFibers, p.m_nbFiberPoints, 160.0 );
+            return WBenchmarkSuite::Function( [ tractogram ]()
+                {
+                    WDataSetFibers fibers( tractogram.m_vertices, tractogram.m_lineStartIndexes, tractogram.m_lineLengths,
+                                           tractogram.m_verticesReverse );
+                    return fibers.size();
+                } );
+        } );
+
+    suite.add( "WWriterFiberVTK/write", [ p ]()
+        {
+            synthetic::Tractogram t = synthetic::createTractogram( p.m_nbFibers, p.m_nbFiberPoints, 160.0 );
+            std::shared_ptr< WDataSetFibers > fibers( new WDataSetFibers( t.m_vertices, t.m_lineStartIndexes, t.m_lineLengths,
+                                                                          t.m_verticesReverse ) );
+            std::shared_ptr< boost::filesystem::path > file = createTempFile();
+            return WBenchmarkSuite::Function( [ fibers, file ]()
+                {
+                    WWriterFiberVTK( *file, true ).writeFibs( fibers );
+                    return fibers->size();
+                } );
+        } );
+
+    suite.add( "WReaderFiberVTK/read", [ p ]()
+        {
+            synthetic::Tractogram t = synthetic::createTractogram( p.m_nbFibers, p.m_nbFiberPoints, 160.0 );
+            std::shared_ptr< WDataSetFibers > fibers( new WDataSetFibers( t.m_vertices, t.m_lineStartIndexes, t.m_lineLengths,
+                                                                          t.m_verticesReverse ) );
+            std::shared_ptr< boost::filesystem::path > file = createTempFile();
+            WWriterFiberVTK( *file, true ).writeFibs( fibers );
+            return WBenchmarkSuite::Function( [ file ]()
+                {
+                    return WReaderFiberVTK( file->string() ).read()->size();
+                } );
+        } );
+
+    // meshes
+    suite.add( "WTriangleMesh/vertexNormals", [ p ]()
+        {
+            std::shared_ptr< WTriangleMesh > mesh = synthetic::createMesh( p.m_meshResolution );
+            return WBenchmarkSuite::Function( [ mesh ]()
+                {
+                    mesh->getVertexNormalArray( true );
+                    return mesh->triangleSize();
+                } );
+        } );
+}
@@ -0,0 +1,72 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCOREBENCHMARKS_H
+#define WCOREBENCHMARKS_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WBenchmark.h"
+
+/**
+ * The sizes of the synthetic data used by the core benchmarks.
+ */
+struct WCoreBenchmarkParameters
+{
+    //! the number of voxels along each axis of the volumes
+    std::size_t m_volumeSize = 128;
+
+    //! the number of fibers of the tractograms
+    std::size_t m_nbFibers = 20000;
+
+    //! the number of points per fiber
+    std::size_t m_nbFiberPoints = 100;
+
+    //! the number of rings of the test mesh
+    std::size_t m_meshResolution = 400;
+
+    //! the number of random lookups in grids and datasets
+    std::size_t m_nbLookups = 1000000;
+
+    /**
+     * The parameters as name and value pairs, written to the JSON output.
+     *
+     * \return the parameters
+     */
+    std::vector< std::pair< std::string, std::string > > toList() const;
+};
+
+/**
+ * Adds the benchmarks of grids, value sets, marching cubes, kd-trees, fiber datasets, the fiber VTK reader and writer and
+ * triangle meshes to the suite. None of them needs a graphics context.
+ *
+ * \param suite the suite to add the benchmarks to
+ * \param parameters the sizes of the data
+ */
+void addCoreBenchmarks( WBenchmarkSuite& suite, WCoreBenchmarkParameters const& parameters ); // NOLINT non-const ref
+
+#endif  // WCOREBENCHMARKS_H
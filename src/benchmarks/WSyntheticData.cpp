@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "WSyntheticData.h"
+
+namespace synthetic
+{
+    double noise( uint64_t index )
+    {
+        // splitmix64
+        uint64_t z = index + 0x9e3779b97f4a7c15ULL;
+        z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+        z = z ^ ( z >> 31 );
+        return static_cast< double >( z >> 11 ) / static_cast< double >( 1ULL << 53 );
+    }
+
+    std::vector< double > createVolumeValues( std::size_t size )
+    {
+        // blob centers and radii relative to the size of the volume
+        double const blobs[][ 4 ] = { { 0.3, 0.3, 0.4, 0.18 }, { 0.65, 0.6, 0.5, 0.22 }, { 0.5, 0.25, 0.75, 0.12 } }; // NOLINT curly braces
+
+        std::vector< double > values( size * size * size );
+        double const scale = 1.0 / std::max< std::size_t >( size - 1, 1 );
+        for( std::size_t z = 0; z < size; ++z )
+        {
+            for( std::size_t y = 0; y < size; ++y )
+            {
+                for( std::size_t x = 0; x < size; ++x )
+                {
+                    double v = 0.0;
+                    for( std::size_t b = 0; b < 3; ++b )
+                    {
+                        double const dx = x * scale - blobs[ b ][ 0 ];
+                        double const dy = y * scale - blobs[ b ][ 1 ];
+                        double const dz = z * scale - blobs[ b ][ 2 ];
+                        double const r = blobs[ b ][ 3 ];
+                        v += std::exp( -( dx * dx + dy * dy + dz * dz ) / ( r * r ) );
+                    }
+                    std::size_t const i = x + size * ( y + size * z );
+                    values[ i ] = std::min( 95.0 * v, 95.0 ) + 5.0 * noise( i );
+                }
+            }
+        }
+        return values;
+    }
+
+    Tractogram createTractogram( std::size_t nbFibers, std::size_t nbPoints, double size )
+    {
+        nbPoints = std::max< std::size_t >( nbPoints, 2 );
+
+        Tractogram t;
+        t.m_vertices.reset( new std::vector< float >() );
+        t.m_vertices->reserve( 3 * nbFibers * nbPoints );
+        t.m_lineStartIndexes.reset( new std::vector< std::size_t >( nbFibers ) );
+        t.m_lineLengths.reset( new std::vector< std::size_t >( nbFibers, nbPoints ) );
+        t.m_verticesReverse.reset( new std::vector< std::size_t >( nbFibers * nbPoints ) );
+
+        for( std::size_t f = 0; f < nbFibers; ++f )
+        {
+            // a wavy line from one side of the cube to the opposite one
+            double const y0 = size * ( 0.1 + 0.8 * noise( 3 * f ) );
+            double const z0 = size * ( 0.1 + 0.8 * noise( 3 * f + 1 ) );
+            double const phase = 6.283 * noise( 3 * f + 2 );
+            double const amplitude = 0.05 * size;
+
+            ( *t.m_lineStartIndexes )[ f ] = f * nbPoints;
+            for( std::size_t p = 0; p < nbPoints; ++p )
+            {
+                double const s = static_cast< double >( p ) / ( nbPoints - 1 );
+                t.m_vertices->push_back( static_cast< float >( size * s ) );
+                t.m_vertices->push_back( static_cast< float >( y0 + amplitude * std::sin( 6.283 * s + phase ) ) );
+                t.m_vertices->push_back( static_cast< float >( z0 + amplitude * std::cos( 9.425 * s + phase ) ) );
+                ( *t.m_verticesReverse )[ f * nbPoints + p ] = f;
+            }
+        }
+        return t;
+    }
+
+    std::shared_ptr< WTriangleMesh > createMesh( std::size_t resolution )
+    {
+        std::size_t const rings = std::max< std::size_t >( resolution, 3 );
+        std::size_t const segments = 2 * rings;
+        std::shared_ptr< WTriangleMesh > mesh( new WTriangleMesh( 2 + ( rings - 1 ) * segments, 2 * ( rings - 1 ) * segments ) );
+
+        mesh->addVertex( 0.0f, 0.0f, 1.0f );
+        for( std::size_t r = 1; r < rings; ++r )
+        {
+            double const theta = 3.14159265358979 * r / rings;
+            for( std::size_t s = 0; s < segments; ++s )
+            {
+                double const phi = 6.28318530717959 * s / segments;
+                double const radius = 1.0 + 0.05 * std::sin( 5.0 * theta ) * std::cos( 7.0 * phi );
+                mesh->addVertex( static_cast< float >( radius * std::sin( theta ) * std::cos( phi ) ),
+                                 static_cast< float >( radius * std::sin( theta ) * std::sin( phi ) ),
+                                 static_cast< float >( radius * std::cos( theta ) ) );
+            }
+        }
+        std::size_t const south = mesh->addVertex( 0.0f, 0.0f, -1.0f );
+
+        for( std::size_t s = 0; s < segments; ++s )
+        {
+            std::size_t const next = ( s + 1 ) % segments;
+            mesh->addTriangle( 0, 1 + s, 1 + next );
+            for( std::size_t r = 1; r + 1 < rings; ++r )
+            {
+                std::size_t const a = 1 + ( r - 1 ) * segments;
+                std::size_t const b = a + segments;
+                mesh->addTriangle( a + s, b + s, b + next );
+                mesh->addTriangle( a + s, b + next, a + next );
+            }
+            std::size_t const last = 1 + ( rings - 2 ) * segments;
+            mesh->addTriangle( south, last + next, last + s );
+        }
+        return mesh;
+    }
+
+    std::vector< WPosition > createPositions( std::size_t count, double size )
+    {
+        std::vector< WPosition > positions( count );
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            positions[ i ] = WPosition( size * noise( 3 * i + 1000003 ), size * noise( 3 * i + 1000004 ), size * noise( 3 * i + 1000005 ) );
+        }
+        return positions;
+    }
+}
@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSYNTHETICDATA_H
+#define WSYNTHETICDATA_H
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/common/math/linearAlgebra/WPosition.h"
+#include "core/dataHandler/WDataSetFibers.h"
+#include "core/dataHandler/WDataSetScalar.h"
+#include "core/dataHandler/WGridRegular3D.h"
+#include "core/dataHandler/WValueSet.h"
+#include "core/graphicsEngine/WTriangleMesh.h"
+
+/**
+ * Generators for deterministic test data of arbitrary size. The same parameters always give the same data, so benchmark
+ * results of different builds are comparable.
+ */
+namespace synthetic
+{
+    /**
+     * The arrays of a tractogram, in the layout WDataSetFibers expects.
+     */
+    struct Tractogram
+    {
+        //! the vertices, three floats each
+        WDataSetFibers::VertexArray m_vertices;
+
+        //! the index of the first vertex of each fiber
+        WDataSetFibers::IndexArray m_lineStartIndexes;
+
+        //! the number of vertices of each fiber
+        WDataSetFibers::LengthArray m_lineLengths;
+
+        //! the fiber of each vertex
+        WDataSetFibers::IndexArray m_verticesReverse;
+    };
+
+    /**
+     * A pseudo random number depending only on the given index.
+     *
+     * \param index the index
+     *
+     * \return a number in [0, 1)
+     */
+    double noise( uint64_t index );
+
+    /**
+     * Creates the values of a volume: a few smooth blobs with a little noise. The values are in [0, 100], so a
+     * surface at 50 has a few connected components.
+     *
+     * \param size the number of voxels along each axis
+     *
+     * \return size^3 values, x running fastest
+     */
+    std::vector< double > createVolumeValues( std::size_t size );
+
+    /**
+     * Creates a scalar volume with createVolumeValues() on a grid with unit voxels.
+     *
+     * \tparam T the type of the values
+     * \param size the number of voxels along each axis
+     *
+     * \return the dataset
+     */
+    template< typename T >
+    std::shared_ptr< WDataSetScalar > createVolume( std::size_t size )
+    {
+        std::vector< double > const values = createVolumeValues( size );
+        std::shared_ptr< std::vector< T > > data( new std::vector< T >( values.size() ) );
+        for( std::size_t i = 0; i < values.size(); ++i )
+        {
+            ( *data )[ i ] = static_cast< T >( values[ i ] );
+        }
+        std::shared_ptr< WValueSet< T > > valueSet( new WValueSet< T >( 0, 1, data ) );
+        std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( size, size, size ) );
+        return std::shared_ptr< WDataSetScalar >( new WDataSetScalar( valueSet, grid ) );
+    }
+
+    /**
+     * Creates a tractogram of wavy fibers running through a cube.
+     *
+     * \param nbFibers the number of fibers
+     * \param nbPoints the number of points of each fiber, at least 2
+     * \param size the edge length of the cube
+     *
+     * \return the arrays of the tractogram
+     */
+    Tractogram createTractogram( std::size_t nbFibers, std::size_t nbPoints, double size );
+
+    /**
+     * Creates a closed, bumpy sphere.
+     *
+     * \param resolution the number of rings, the mesh has about 2 * resolution^2 triangles
+     *
+     * \return the mesh
+     */
+    std::shared_ptr< WTriangleMesh > createMesh( std::size_t resolution );
+
+    /**
+     * Creates positions inside a cube.
+     *
+     * \param count the number of positions
+     * \param size the edge length of the cube
+     *
+     * \return the positions
+     */
+    std::vector< WPosition > createPositions( std::size_t count, double size );
+}
+
+#endif  // WSYNTHETICDATA_H
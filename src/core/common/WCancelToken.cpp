@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include "exceptions/WComputationCancelled.h"
+#include "WCancelToken.h"
+
+WCancelToken::WCancelToken()
+    : m_cancelled( false ),
+      m_cancelCondition( new WCondition() )
+{
+}
+
+WCancelToken::~WCancelToken()
+{
+}
+
+void WCancelToken::cancel()
+{
+    if( !m_cancelled.exchange( true ) )
+    {
+        m_cancelCondition->notify();
+    }
+}
+
+bool WCancelToken::isCancelled() const
+{
+    return m_cancelled.load( std::memory_order_relaxed );
+}
+
+void WCancelToken::throwIfCancelled() const
+{
+    if( isCancelled() )
+    {
+        throw WComputationCancelled();
+    }
+}
+
+WCondition::ConstSPtr WCancelToken::getCancelCondition() const
+{
+    return m_cancelCondition;
+}
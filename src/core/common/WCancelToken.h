@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCANCELTOKEN_H
+#define WCANCELTOKEN_H
+
+#include <atomic>
+#include <memory>
+
+#include "WCondition.h"
+
+/**
+ * A flag shared between a long running computation and whoever started it. Cancelling the token asks the computation
+ * to stop as soon as possible. Computations check the token cooperatively, either directly via isCancelled() and
+ * throwIfCancelled() or indirectly via a WProgress or WThreadedFunction the token was handed to.
+ *
+ * A token can be cancelled only once and never be reset. Start each computation with a new token.
+ *
+ * \see WRecomputeScheduler
+ */
+class WCancelToken // NOLINT
+{
+public:
+    /**
+     * Shared pointer on a WCancelToken.
+     */
+    typedef std::shared_ptr< WCancelToken > SPtr;
+
+    /**
+     * Const shared pointer on a WCancelToken.
+     */
+    typedef std::shared_ptr< const WCancelToken > ConstSPtr;
+
+    /**
+     * Creates a token which is not cancelled.
+     */
+    WCancelToken();
+
+    /**
+     * Destructor.
+     */
+    ~WCancelToken();
+
+    /**
+     * Cancel the computation. Notifies the cancel condition on the first call, further calls are ignored.
+     */
+    void cancel();
+
+    /**
+     * Checks whether the token was cancelled. This is cheap and may be called in inner loops.
+     *
+     * \return true if cancel() was called.
+     */
+    bool isCancelled() const;
+
+    /**
+     * Throws a WComputationCancelled if the token was cancelled.
+     */
+    void throwIfCancelled() const;
+
+    /**
+     * A condition notified when the token gets cancelled. Subscribers should check isCancelled() after subscribing, as the
+     * token might have been cancelled before.
+     *
+     * \return the condition
+     */
+    WCondition::ConstSPtr getCancelCondition() const;
+
+private:
+    //! true after the first call to cancel()
+    std::atomic< bool > m_cancelled;
+
+    //! notified on cancellation
+    WCondition::SPtr m_cancelCondition;
+};
+
+#endif  // WCANCELTOKEN_H
@@ -49,6 +49,8 @@ void WLogger::startup( std::ostream& output, LogLevel level )  // NOLINT - we ne
 WLogger::WLogger( std::ostream& output, LogLevel level ):       // NOLINT - we need this non-const ref here
     m_outputs()
 {
+    // every message reads the outputs, they are changed only rarely
+    m_outputs.enableSnapshots();
     m_outputs.push_back( WLogStream::SharedPtr( new WLogStream( output, level ) ) );
 
     addLogMessage( "Initalizing Logger", "Logger", LL_INFO );
@@ -91,8 +93,8 @@ void WLogger::addLogMessage( std::string message, std::string source, LogLevel l
     m_addLogSignal( entry );
 
     // output
-    Outputs::ReadTicket r = m_outputs.getReadTicket();
-    for( Outputs::ConstIterator i = r->get().begin(); i != r->get().end(); ++i )
+    Outputs::Snapshot r = m_outputs.getSnapshot();
+    for( Outputs::ConstIterator i = r->begin(); i != r->end(); ++i )
     {
         ( *i )->printEntry( entry );
     }
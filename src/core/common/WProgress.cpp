@@ -27,6 +27,7 @@
 #include <string>
 
 #include "../common/WCondition.h"
+#include "exceptions/WComputationCancelled.h"
 
 #include "WProgress.h"
 
@@ -87,6 +88,13 @@ bool WProgress::isDetermined()
 
 WProgress& WProgress::operator+( size_t steps )
 {
+    if( m_cancelToken && m_cancelToken->isCancelled() )
+    {
+        // nobody will finish us after the exception
+        finish();
+        throw WComputationCancelled();
+    }
+
     if( isDetermined() )
     {
         m_count = std::min( m_max, m_count + steps );
@@ -99,3 +107,8 @@ void WProgress::increment( size_t steps )
 {
     operator+( steps );
 }
+
+void WProgress::setCancelToken( WCancelToken::ConstSPtr token )
+{
+    m_cancelToken = token;
+}
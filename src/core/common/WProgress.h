@@ -29,6 +29,8 @@
 #include <set>
 #include <string>
 
+#include "WCancelToken.h"
+
 
 
 /**
@@ -133,6 +135,14 @@ public:
      */
     virtual void increment( size_t steps );
 
+    /**
+     * Lets this progress check the given token on every increment. Once the token is cancelled, incrementing finishes the
+     * progress and throws a WComputationCancelled, which ends the computation reporting its progress here.
+     *
+     * \param token the token, NULL to stop checking
+     */
+    void setCancelToken( WCancelToken::ConstSPtr token );
+
 protected:
     /**
      * Progress name. Can be set only once (during construction).
@@ -159,6 +169,11 @@ protected:
      */
     bool m_determined;
 
+    /**
+     * Checked on every increment if set.
+     */
+    WCancelToken::ConstSPtr m_cancelToken;
+
 private:
 };
 
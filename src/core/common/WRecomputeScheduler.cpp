@@ -0,0 +1,125 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <vector>
+
+#include <boost/bind/bind.hpp>
+
+#include "WRecomputeScheduler.h"
+
+WRecomputeScheduler::WRecomputeScheduler( std::chrono::milliseconds quietPeriod )
+    : m_quietPeriod( quietPeriod ),
+      m_requested( false ),
+      m_stopped( false ),
+      m_lastRequest( std::chrono::steady_clock::now() ),
+      m_token( new WCancelToken() ),
+      m_condition( new WCondition() )
+{
+    m_connections.push_back( m_condition->subscribeSignal( boost::bind( &WRecomputeScheduler::handleRequest, this ) ) );
+}
+
+WRecomputeScheduler::~WRecomputeScheduler()
+{
+    for( std::vector< boost::signals2::connection >::iterator it = m_connections.begin(); it != m_connections.end(); ++it )
+    {
+        it->disconnect();
+    }
+    stop();
+}
+
+WCondition::SPtr WRecomputeScheduler::getCondition() const
+{
+    return m_condition;
+}
+
+void WRecomputeScheduler::add( WCondition::ConstSPtr condition )
+{
+    boost::signals2::connection c = condition->subscribeSignal( boost::bind( &WRecomputeScheduler::handleRequest, this ) );
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_connections.push_back( c );
+}
+
+void WRecomputeScheduler::requestRecompute()
+{
+    // also wakes up everyone waiting for the condition
+    m_condition->notify();
+}
+
+void WRecomputeScheduler::handleRequest()
+{
+    WCancelToken::SPtr token;
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_requested = true;
+        m_lastRequest = std::chrono::steady_clock::now();
+        token = m_token;
+    }
+    m_wakeUp.notify_all();
+
+    // outside the lock, cancelling runs the callbacks of the token
+    token->cancel();
+}
+
+bool WRecomputeScheduler::isRequested() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_requested;
+}
+
+WCancelToken::SPtr WRecomputeScheduler::start()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    // each request moves the deadline, so a burst of requests is waited out completely
+    while( !m_stopped && std::chrono::steady_clock::now() < m_lastRequest + m_quietPeriod )
+    {
+        m_wakeUp.wait_until( lock, m_lastRequest + m_quietPeriod );
+    }
+
+    m_requested = false;
+    m_token.reset( new WCancelToken() );
+    if( m_stopped )
+    {
+        m_token->cancel();
+    }
+    return m_token;
+}
+
+void WRecomputeScheduler::stop()
+{
+    WCancelToken::SPtr token;
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_stopped = true;
+        token = m_token;
+    }
+    m_wakeUp.notify_all();
+    token->cancel();
+}
+
+bool WRecomputeScheduler::isStopped() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_stopped;
+}
@@ -0,0 +1,168 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WRECOMPUTESCHEDULER_H
+#define WRECOMPUTESCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/signals2/connection.hpp>
+
+#include "WCancelToken.h"
+#include "WCondition.h"
+
+/**
+ * Coalesces requests for an expensive recomputation. Every request cancels the computation currently running, start()
+ * waits until the requests calm down and hands out a new WCancelToken for the next run. Bursts of property changes, as
+ * caused by dragging a slider, thus result in a single computation using the latest values instead of a queue of
+ * outdated ones.
+ *
+ * Use it in a module thread like this:
+ * \code
+ * m_moduleState.add( m_recomputeScheduler.getCondition() );
+ * while( !m_shutdownFlag() )
+ * {
+ *     if( !m_recomputeScheduler.isRequested() )
+ *     {
+ *         m_moduleState.wait();
+ *     }
+ *     ...
+ *     WCancelToken::SPtr token = m_recomputeScheduler.start();
+ *     try
+ *     {
+ *         progress->setCancelToken( token );
+ *         ...
+ *     }
+ *     catch( WComputationCancelled const& )
+ *     {
+ *         // a newer request is pending, restart
+ *     }
+ * }
+ * \endcode
+ *
+ * All functions are thread-safe.
+ */
+class WRecomputeScheduler // NOLINT
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param quietPeriod start() waits until no request arrived for this time.
+     */
+    explicit WRecomputeScheduler( std::chrono::milliseconds quietPeriod = std::chrono::milliseconds( 150 ) );
+
+    /**
+     * Destructor. Cancels the current computation.
+     */
+    ~WRecomputeScheduler();
+
+    /**
+     * Notifying this condition requests a recomputation. Pass it to properties instead of the usual property condition, and
+     * add it to the condition set the module thread waits for.
+     *
+     * \return the condition
+     */
+    WCondition::SPtr getCondition() const;
+
+    /**
+     * Request a recomputation whenever the given condition gets notified, for example the data changed condition of an
+     * input connector.
+     *
+     * \param condition the condition
+     */
+    void add( WCondition::ConstSPtr condition );
+
+    /**
+     * Request a recomputation. Cancels the computation currently running.
+     */
+    void requestRecompute();
+
+    /**
+     * Checks whether a recomputation was requested since the last call to start().
+     *
+     * \return true if requested.
+     */
+    bool isRequested() const;
+
+    /**
+     * Waits until no request arrived for the quiet period, clears the request and returns the token for the computation
+     * to start now. The returned token is cancelled already if stop() was called.
+     *
+     * \return the token of the new computation.
+     */
+    WCancelToken::SPtr start();
+
+    /**
+     * Cancels the current computation and wakes up start(). Further computations are cancelled right away. Call this when
+     * shutting down.
+     */
+    void stop();
+
+    /**
+     * Checks whether stop() was called.
+     *
+     * \return true if stopped.
+     */
+    bool isStopped() const;
+
+private:
+    /**
+     * Called for each notification of the request condition.
+     */
+    void handleRequest();
+
+    //! the time start() waits for further requests
+    std::chrono::milliseconds m_quietPeriod;
+
+    //! protects the members below
+    mutable std::mutex m_mutex;
+
+    //! wakes up start()
+    std::condition_variable m_wakeUp;
+
+    //! true if a recomputation was requested since the last start()
+    bool m_requested;
+
+    //! true after stop()
+    bool m_stopped;
+
+    //! the time of the latest request
+    std::chrono::steady_clock::time_point m_lastRequest;
+
+    //! the token of the current computation
+    WCancelToken::SPtr m_token;
+
+    //! notifying it requests a recomputation
+    WCondition::SPtr m_condition;
+
+    //! the connections to the conditions requesting a recomputation
+    std::vector< boost::signals2::connection > m_connections;
+};
+
+#endif  // WRECOMPUTESCHEDULER_H
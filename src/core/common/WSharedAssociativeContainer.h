@@ -33,6 +33,7 @@
 
 /**
  * This class provides a common interface for thread-safe access to associative containers (set, multiset, map, multimap).
+ * For containers read far more often than modified, call enableSnapshots(). The const queries then read a snapshot instead of locking.
  */
 template < typename T >
 class WSharedAssociativeContainer: public WSharedObject< T >
@@ -150,29 +151,29 @@ void WSharedAssociativeContainer< T >::clear()
 template < typename T >
 bool WSharedAssociativeContainer< T >::empty() const
 {
-    typename WSharedAssociativeContainer< T >::ReadTicket r = WSharedObject< T >::getReadTicket();
-    return r->get().empty();
+    typename WSharedObject< T >::Snapshot r = WSharedObject< T >::getSnapshot();
+    return r->empty();
 }
 
 template < typename T >
 size_t WSharedAssociativeContainer< T >::size() const
 {
-    typename WSharedAssociativeContainer< T >::ReadTicket r = WSharedObject< T >::getReadTicket();
-    return r->get().size();
+    typename WSharedObject< T >::Snapshot r = WSharedObject< T >::getSnapshot();
+    return r->size();
 }
 
 template < typename T >
 size_t WSharedAssociativeContainer< T >::max_size() const
 {
-    typename WSharedAssociativeContainer< T >::ReadTicket r = WSharedObject< T >::getReadTicket();
-    return r->get().max_size();
+    typename WSharedObject< T >::Snapshot r = WSharedObject< T >::getSnapshot();
+    return r->max_size();
 }
 
 template < typename T >
 size_t WSharedAssociativeContainer< T >::count( const key_type& x ) const
 {
-    typename WSharedAssociativeContainer< T >::ReadTicket r = WSharedObject< T >::getReadTicket();
-    return r->get().count( x );
+    typename WSharedObject< T >::Snapshot r = WSharedObject< T >::getSnapshot();
+    return r->count( x );
 }
 
 template < typename T >
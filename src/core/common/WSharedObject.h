@@ -25,12 +25,18 @@
 #ifndef WSHAREDOBJECT_H
 #define WSHAREDOBJECT_H
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <utility>
+#include <vector>
 
 #include <boost/thread.hpp>
 
 #include "WCondition.h"
+#include "WSharedObjectReaders.h"
+#include "WSharedObjectSnapshot.h"
 #include "WSharedObjectTicket.h"
 #include "WSharedObjectTicketRead.h"
 #include "WSharedObjectTicketWrite.h"
@@ -39,21 +45,44 @@
  * Wrapper around an object/type for thread safe sharing of objects among multiple threads. The advantage of this class over WFlag
  * is, that WFlag just protects simple get/set operations, while this class can protect a whole bunch of operations on the
  * encapsulated object.
+ *
+ * For read-mostly objects, enable snapshots. Writers then publish an immutable copy of the object whenever they release their write ticket
+ * and \ref getSnapshot hands out views of the latest copy without locking or allocating. Read tickets keep working as before.
  */
 template < typename T >
 class WSharedObject
 {
+/**
+ * The write ticket publishes the snapshots.
+ */
+friend class WSharedObjectTicketWrite< T >;
 public:
     /**
      * Default constructor.
      */
     WSharedObject();
 
+    /**
+     * Copy constructor. The copy shares the lock with the original and has snapshots enabled if the original has.
+     *
+     * \param from the object to copy
+     */
+    WSharedObject( const WSharedObject& from );
+
     /**
      * Destructor.
      */
     virtual ~WSharedObject();
 
+    /**
+     * Copies the object and shares the lock with the original. Snapshots are enabled if the original has them.
+     *
+     * \param from the object to copy
+     *
+     * \return this
+     */
+    WSharedObject& operator=( const WSharedObject& from );
+
     /**
      * The type protected by this shared object class
      */
@@ -69,6 +98,11 @@ public:
      */
     typedef std::shared_ptr< WSharedObjectTicketWrite< T > > WriteTicket;
 
+    /**
+     * Type for snapshots.
+     */
+    typedef WSharedObjectSnapshot< T > Snapshot;
+
     /**
      * Shared pointer abbreviation.
      */
@@ -95,6 +129,28 @@ public:
      */
     WriteTicket getWriteTicket( bool suppressNotify = false ) const;
 
+    /**
+     * Returns a read-only view of the contained data. With snapshots enabled, this neither locks nor allocates and the view shows the data as
+     * of the last released write ticket. Without, the view holds the read lock like a read ticket. Do not request a write ticket while
+     * holding a locking snapshot.
+     *
+     * \return the view
+     */
+    Snapshot getSnapshot() const;
+
+    /**
+     * Switches this object to publishing snapshots. Each write ticket then copies the object on release. Call this before the object is
+     * shared with other threads.
+     */
+    void enableSnapshots();
+
+    /**
+     * Checks whether \ref enableSnapshots has been called.
+     *
+     * \return true if snapshots are published
+     */
+    bool hasSnapshots() const;
+
     /**
      * This condition fires whenever the encapsulated object changed. This is fired automatically by endWrite().
      *
@@ -121,6 +177,42 @@ protected:
     std::shared_ptr< WCondition > m_changeCondition;
 
 private:
+    /**
+     * The published versions of the object.
+     */
+    struct SnapshotState
+    {
+        /**
+         * Deletes all versions. Nobody may read them anymore.
+         */
+        ~SnapshotState()
+        {
+            delete m_current.load();
+            for( typename std::vector< std::pair< const T*, unsigned int > >::iterator it = m_retired.begin(); it != m_retired.end(); ++it )
+            {
+                delete it->first;
+            }
+        }
+
+        //! the readers of the versions
+        WSharedObjectReaders m_readers;
+
+        //! the latest version
+        std::atomic< const T* > m_current;
+
+        //! the replaced versions and the epochs seen idle since they were replaced, one bit per epoch
+        std::vector< std::pair< const T*, unsigned int > > m_retired;
+    };
+
+    /**
+     * Publishes a copy of m_object and deletes the replaced versions nobody reads anymore. Needs the write lock.
+     */
+    void publishSnapshot() const;
+
+    /**
+     * The snapshots. NULL unless enabled.
+     */
+    std::unique_ptr< SnapshotState > m_snapshots;
 };
 
 template < typename T >
@@ -131,12 +223,41 @@ WSharedObject< T >::WSharedObject():
     // init members
 }
 
+template < typename T >
+WSharedObject< T >::WSharedObject( const WSharedObject& from ):
+    m_object( from.m_object ),
+    m_lock( from.m_lock ),
+    m_changeCondition( from.m_changeCondition )
+{
+    if( from.hasSnapshots() )
+    {
+        enableSnapshots();
+    }
+}
+
 template < typename T >
 WSharedObject< T >::~WSharedObject()
 {
     // clean up
 }
 
+template < typename T >
+WSharedObject< T >& WSharedObject< T >::operator=( const WSharedObject& from )
+{
+    if( this != &from )
+    {
+        m_object = from.m_object;
+        m_lock = from.m_lock;
+        m_changeCondition = from.m_changeCondition;
+        m_snapshots.reset();
+        if( from.hasSnapshots() )
+        {
+            enableSnapshots();
+        }
+    }
+    return *this;
+}
+
 template < typename T >
 std::shared_ptr< WCondition > WSharedObject< T >::getChangeCondition() const
 {
@@ -157,16 +278,72 @@ typename WSharedObject< T >::WriteTicket WSharedObject< T >::getWriteTicket( boo
     if( suppressNotify )
     {
         return std::shared_ptr< WSharedObjectTicketWrite< T > >(
-                new WSharedObjectTicketWrite< T >( m_object, m_lock, std::shared_ptr< WCondition >() )
+                new WSharedObjectTicketWrite< T >( m_object, m_lock, std::shared_ptr< WCondition >(), m_snapshots ? this : NULL )
         );
     }
     else
     {
         return std::shared_ptr< WSharedObjectTicketWrite< T > >(
-                new WSharedObjectTicketWrite< T >( m_object, m_lock, m_changeCondition )
+                new WSharedObjectTicketWrite< T >( m_object, m_lock, m_changeCondition, m_snapshots ? this : NULL )
         );
     }
 }
 
+template < typename T >
+typename WSharedObject< T >::Snapshot WSharedObject< T >::getSnapshot() const
+{
+    if( !m_snapshots )
+    {
+        return Snapshot( m_object, *m_lock );
+    }
+
+    // register first, the writer only deletes versions replaced before it saw all readers gone
+    WSharedObjectReaders::Counter* readers = m_snapshots->m_readers.enter();
+    return Snapshot( *m_snapshots->m_current.load(), readers );
+}
+
+template < typename T >
+void WSharedObject< T >::enableSnapshots()
+{
+    std::unique_lock< std::shared_mutex > lock( *m_lock );
+    if( !m_snapshots )
+    {
+        m_snapshots.reset( new SnapshotState() );
+        m_snapshots->m_current = new T( m_object );
+    }
+}
+
+template < typename T >
+bool WSharedObject< T >::hasSnapshots() const
+{
+    return static_cast< bool >( m_snapshots );
+}
+
+template < typename T >
+void WSharedObject< T >::publishSnapshot() const
+{
+    SnapshotState& state = *m_snapshots;
+    state.m_retired.push_back( std::make_pair( state.m_current.exchange( new T( m_object ) ), 0u ) );
+
+    // new readers use the other epoch, so the current one drains
+    state.m_readers.flip();
+
+    unsigned int const idle = ( state.m_readers.isIdle( 0 ) ? 1u : 0u ) | ( state.m_readers.isIdle( 1 ) ? 2u : 0u );
+    std::size_t kept = 0;
+    for( std::size_t i = 0; i < state.m_retired.size(); ++i )
+    {
+        state.m_retired[ i ].second |= idle;
+        if( state.m_retired[ i ].second == 3u )
+        {
+            delete state.m_retired[ i ].first;
+        }
+        else
+        {
+            state.m_retired[ kept++ ] = state.m_retired[ i ];
+        }
+    }
+    state.m_retired.resize( kept );
+}
+
 #endif  // WSHAREDOBJECT_H
 
@@ -0,0 +1,66 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+
+#include "WSharedObjectReaders.h"
+
+std::size_t const WSharedObjectReaders::NumSlots;
+
+WSharedObjectReaders::WSharedObjectReaders():
+    m_epoch( 0 )
+{
+    for( std::size_t epoch = 0; epoch < 2; ++epoch )
+    {
+        for( std::size_t i = 0; i < NumSlots; ++i )
+        {
+            m_slots[ epoch ][ i ].m_readers = 0;
+        }
+    }
+}
+
+void WSharedObjectReaders::flip()
+{
+    m_epoch.fetch_add( 1 );
+}
+
+bool WSharedObjectReaders::isIdle( std::size_t epoch ) const
+{
+    for( std::size_t i = 0; i < NumSlots; ++i )
+    {
+        if( m_slots[ epoch & 1 ][ i ].m_readers.load() != 0 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t WSharedObjectReaders::getThreadSlot()
+{
+    static std::atomic< std::size_t > nextSlot( 0 );
+    thread_local std::size_t const slot = nextSlot.fetch_add( 1, std::memory_order_relaxed ) % NumSlots;
+    return slot;
+}
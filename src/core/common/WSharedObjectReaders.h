@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSHAREDOBJECTREADERS_H
+#define WSHAREDOBJECTREADERS_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Keeps track of the threads reading a snapshot of a WSharedObject, so that replaced versions of the object can be deleted as soon as nobody
+ * reads them anymore. Readers are counted per thread slot and per epoch. The counters are spread over separate cache lines, so entering and
+ * leaving only touches memory shared with the few other threads mapped to the same slot. A writer switches the epoch after publishing a new
+ * version, so the readers of the old epoch drain while new readers are counted in the other one.
+ *
+ * A replaced version is unused as soon as every counter of both epochs has been seen at zero after it got replaced. Readers always increment
+ * their counter before loading the current version.
+ */
+class WSharedObjectReaders // NOLINT
+{
+public:
+    /**
+     * The counter a reader incremented.
+     */
+    typedef std::atomic< std::size_t > Counter;
+
+    /**
+     * The number of slots per epoch. Threads are distributed round-robin among them.
+     */
+    static std::size_t const NumSlots = 8;
+
+    /**
+     * Constructor. There are no readers.
+     */
+    WSharedObjectReaders();
+
+    /**
+     * Registers the calling thread as reader in the current epoch. Call this before loading the current version.
+     *
+     * \return the counter to pass to \ref leave.
+     */
+    Counter* enter();
+
+    /**
+     * Unregisters a reader.
+     *
+     * \param counter the counter returned by \ref enter.
+     */
+    static void leave( Counter* counter );
+
+    /**
+     * Switches the epoch new readers are counted in. Only one thread may do this at a time.
+     */
+    void flip();
+
+    /**
+     * Checks whether there are readers in the given epoch.
+     *
+     * \param epoch 0 or 1
+     *
+     * \return true if all counters of the epoch are zero.
+     */
+    bool isIdle( std::size_t epoch ) const;
+
+private:
+    /**
+     * A counter on its own cache line.
+     */
+    struct alignas( 64 ) Slot
+    {
+        //! the number of readers
+        Counter m_readers;
+    };
+
+    /**
+     * The slot of the calling thread. It is assigned on the first call and stays the same for all objects.
+     *
+     * \return the slot index
+     */
+    static std::size_t getThreadSlot();
+
+    //! the epoch new readers are counted in, only the lowest bit is used
+    std::atomic< std::size_t > m_epoch;
+
+    //! the counters of both epochs
+    Slot m_slots[ 2 ][ NumSlots ];
+};
+
+inline WSharedObjectReaders::Counter* WSharedObjectReaders::enter()
+{
+    Counter* counter = &m_slots[ m_epoch.load() & 1 ][ getThreadSlot() ].m_readers;
+    counter->fetch_add( 1 );
+    return counter;
+}
+
+inline void WSharedObjectReaders::leave( Counter* counter )
+{
+    // release: everything the reader did with the version happens before the writer sees the counter drop
+    counter->fetch_sub( 1, std::memory_order_release );
+}
+
+#endif  // WSHAREDOBJECTREADERS_H
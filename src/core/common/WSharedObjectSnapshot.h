@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSHAREDOBJECTSNAPSHOT_H
+#define WSHAREDOBJECTSNAPSHOT_H
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "WSharedObjectReaders.h"
+
+// The shared object class
+template < typename T >
+class WSharedObject;
+
+/**
+ * Read-only view of a WSharedObject. In contrast to WSharedObjectTicketRead, it lives on the stack. If snapshots are enabled for the shared
+ * object, it refers to an immutable version of the object and does not lock at all. Writers publish a new version instead of waiting for the
+ * view to vanish. Otherwise, it holds the read lock of the object like a read ticket does.
+ *
+ * Keep snapshots short-lived. Replaced versions are kept in memory as long as a snapshot might still refer to them.
+ */
+template < typename Data >
+class WSharedObjectSnapshot
+{
+/**
+ * The shared object class needs protected access to create new instances.
+ */
+friend class WSharedObject< Data >;
+public:
+    /**
+     * Moves the view to a new instance.
+     *
+     * \param other the view to move. It is empty afterwards.
+     */
+    WSharedObjectSnapshot( WSharedObjectSnapshot&& other ):
+        m_data( other.m_data ),
+        m_readers( other.m_readers ),
+        m_lock( std::move( other.m_lock ) )
+    {
+        other.m_data = NULL;
+        other.m_readers = NULL;
+    }
+
+    /**
+     * Snapshots are not copyable. Move them if needed.
+     */
+    WSharedObjectSnapshot( const WSharedObjectSnapshot& ) = delete;
+
+    /**
+     * Snapshots are not assignable.
+     *
+     * \return this
+     */
+    WSharedObjectSnapshot& operator=( const WSharedObjectSnapshot& ) = delete;
+
+    /**
+     * Releases the view.
+     */
+    ~WSharedObjectSnapshot()
+    {
+        if( m_readers )
+        {
+            WSharedObjectReaders::leave( m_readers );
+        }
+    }
+
+    /**
+     * Returns the viewed data. As long as you own the snapshot, you are allowed to use it.
+     *
+     * \return the data (const!)
+     */
+    const Data& get() const
+    {
+        return *m_data;
+    }
+
+    /**
+     * Returns the viewed data.
+     *
+     * \return the data (const!)
+     */
+    const Data& operator*() const
+    {
+        return *m_data;
+    }
+
+    /**
+     * Access the members of the viewed data.
+     *
+     * \return the data (const!)
+     */
+    const Data* operator->() const
+    {
+        return m_data;
+    }
+
+protected:
+    /**
+     * Creates a view of a published version.
+     *
+     * \param data the version
+     * \param readers the reader counter incremented before loading the version
+     */
+    WSharedObjectSnapshot( const Data& data, WSharedObjectReaders::Counter* readers ):
+        m_data( &data ),
+        m_readers( readers )
+    {
+    }
+
+    /**
+     * Creates a view of data protected by a mutex. It locks the mutex for read.
+     *
+     * \param data the data
+     * \param mutex the mutex
+     */
+    WSharedObjectSnapshot( const Data& data, std::shared_mutex& mutex ): // NOLINT non-const ref
+        m_data( &data ),
+        m_readers( NULL ),
+        m_lock( mutex )
+    {
+    }
+
+private:
+    //! the viewed data
+    const Data* m_data;
+
+    //! the reader counter to decrement on release, NULL if the view is locked instead
+    WSharedObjectReaders::Counter* m_readers;
+
+    //! the read lock if snapshots are disabled
+    std::shared_lock< std::shared_mutex > m_lock;
+};
+
+#endif  // WSHAREDOBJECTSNAPSHOT_H
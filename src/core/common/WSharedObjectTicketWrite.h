@@ -70,10 +70,13 @@ protected:
      * \param data the data to protect
      * \param mutex the mutex used to lock
      * \param condition a condition that should be fired upon unlock. Can be NULL.
+     * \param owner the shared object to publish a snapshot of before unlocking. NULL if it has no snapshots.
      */
-    WSharedObjectTicketWrite( Data& data, std::shared_ptr< std::shared_mutex > mutex, std::shared_ptr< WCondition > condition ): // NOLINT
+    WSharedObjectTicketWrite( Data& data, std::shared_ptr< std::shared_mutex > mutex, std::shared_ptr< WCondition > condition, // NOLINT
+                              const WSharedObject< Data >* owner = NULL ):
         WSharedObjectTicket< Data >( data, mutex, condition ),
-        m_lock( std::unique_lock< std::shared_mutex >( *mutex ) )
+        m_lock( std::unique_lock< std::shared_mutex >( *mutex ) ),
+        m_owner( owner )
     {
     };
 
@@ -83,10 +86,20 @@ protected:
     std::unique_lock< std::shared_mutex > m_lock;
 
     /**
-     * Unlocks the mutex.
+     * The shared object publishing snapshots. NULL if it does not.
+     */
+    const WSharedObject< Data >* m_owner;
+
+    /**
+     * Publishes the snapshot and unlocks the mutex.
      */
     virtual void unlock()
     {
+        if( m_owner )
+        {
+            m_owner->publishSnapshot();
+            m_owner = NULL;
+        }
         m_lock.unlock();
     }
 
@@ -33,6 +33,7 @@
 
 /**
  * This class provides a common interface for thread-safe access to sequence containers (list, vector, dequeue ).
+ * For containers read far more often than modified, call enableSnapshots(). size() and count() then read a snapshot instead of locking.
  * \param S the sequence container to use. Everything is allowed here which provides push_back and pop_back as well as size functionality.
  */
 template < typename S >
@@ -345,10 +346,9 @@ void WSharedSequenceContainer< S >::clear()
 template < typename S >
 size_t WSharedSequenceContainer< S >::size() const
 {
-    // Lock, if "a" looses focus -> look is freed
-    typename WSharedObject< S >::ReadTicket a = WSharedObject< S >::getReadTicket();
-    size_t size = a->get().size();
-    return size;
+    // Lock or snapshot, if "a" looses focus -> it is freed
+    typename WSharedObject< S >::Snapshot a = WSharedObject< S >::getSnapshot();
+    return a->size();
 }
 
 template < typename S >
@@ -417,8 +417,8 @@ void WSharedSequenceContainer< S >::replace( const typename S::value_type& oldVa
 template < typename S >
 size_t WSharedSequenceContainer< S >::count( const value_type& value )
 {
-    typename WSharedObject< S >::ReadTicket a = WSharedObject< S >::getReadTicket();
-    return std::count( a->get().begin(), a->get().end(), value );
+    typename WSharedObject< S >::Snapshot a = WSharedObject< S >::getSnapshot();
+    return std::count( a->begin(), a->end(), value );
 }
 
 template < typename S >
@@ -38,6 +38,7 @@ WThreadedFunctionBase::WThreadedFunctionBase()
 WThreadedFunctionBase::~WThreadedFunctionBase()
 {
     m_exceptionSignal.disconnect_all_slots();
+    m_cancelConnection.disconnect();
 }
 
 WThreadedFunctionStatus WThreadedFunctionBase::status()
@@ -57,3 +58,8 @@ void WThreadedFunctionBase::subscribeExceptionSignal( ExceptionFunction func )
         m_exceptionSignal.connect( func );
     }
 }
+
+void WThreadedFunctionBase::setCancelToken( WCancelToken::ConstSPtr token )
+{
+    m_cancelToken = token;
+}
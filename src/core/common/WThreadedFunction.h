@@ -33,7 +33,9 @@
 #include <boost/thread.hpp>
 
 #include "WAssert.h"
+#include "WCancelToken.h"
 #include "WSharedObject.h"
+#include "WTracer.h"
 #include "WWorkerThread.h"
 
 
@@ -120,6 +122,14 @@ public:
      */
     void subscribeExceptionSignal( ExceptionFunction func );
 
+    /**
+     * Stop the threads as soon as the given token gets cancelled. Takes effect with the next call to run(), the threads
+     * are stopped right away if the token already is cancelled then.
+     *
+     * \param token The token, NULL to ignore cancellation.
+     */
+    void setCancelToken( WCancelToken::ConstSPtr token );
+
 protected:
     /**
      * WThreadedFunctionBase is non-copyable, so the copy constructor is not implemented.
@@ -141,6 +151,12 @@ protected:
 
     //! the current status
     WSharedObject< WThreadedFunctionStatus > m_status;
+
+    //! stops the threads when cancelled
+    WCancelToken::ConstSPtr m_cancelToken;
+
+    //! the connection to the cancel condition of the token
+    boost::signals2::connection m_cancelConnection;
 };
 
 /**
@@ -239,6 +255,11 @@ private:
      */
     void handleThreadException( WException const& e );
 
+    /**
+     * This function gets subscribed to the cancel condition of the cancel token.
+     */
+    void handleCancel();
+
     //! the number of threads to manage
     std::size_t m_numThreads;
 
@@ -292,6 +313,7 @@ WThreadedFunction< Function_T >::WThreadedFunction( std::size_t numThreads, std:
 template< class Function_T >
 WThreadedFunction< Function_T >::~WThreadedFunction()
 {
+    m_cancelConnection.disconnect();
     stop();
 }
 
@@ -302,11 +324,23 @@ void WThreadedFunction< Function_T >::run()
     m_threadsDone.getWriteTicket()->get() = 0;
     // change status
     m_status.getWriteTicket()->get() = W_THREADS_RUNNING;
+    WTracer::asyncBegin( "WThreadedFunction", reinterpret_cast< uint64_t >( this ) );
     // start threads
     for( std::size_t k = 0; k < m_numThreads; ++k )
     {
         m_threads[ k ]->run();
     }
+
+    // connect after starting, so a stop request does not reach threads that were not running yet
+    m_cancelConnection.disconnect();
+    if( m_cancelToken )
+    {
+        m_cancelConnection = m_cancelToken->getCancelCondition()->subscribeSignal( boost::bind( &WThreadedFunction::handleCancel, this ) );
+        if( m_cancelToken->isCancelled() )
+        {
+            handleCancel();
+        }
+    }
 }
 
 template< class Function_T >
@@ -347,6 +381,7 @@ void WThreadedFunction< Function_T >::handleThreadDone()
 
     if( m_numThreads == k )
     {
+        WTracer::asyncEnd( "WThreadedFunction", reinterpret_cast< uint64_t >( this ) );
         typedef typename WSharedObject< WThreadedFunctionStatus >::WriteTicket ST;
         ST s = m_status.getWriteTicket();
         if( s->get() == W_THREADS_RUNNING )
@@ -385,4 +420,14 @@ void WThreadedFunction< Function_T >::handleThreadException( WException const& e
     m_exceptionSignal( e );
 }
 
+template< class Function_T >
+void WThreadedFunction< Function_T >::handleCancel()
+{
+    // threads that already finished must not be marked as stopped
+    if( status() == W_THREADS_RUNNING )
+    {
+        stop();
+    }
+}
+
 #endif  // WTHREADEDFUNCTION_H
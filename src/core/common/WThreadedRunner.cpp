@@ -35,6 +35,7 @@
 #include "WException.h"
 #include "WLogger.h"
 #include "WThreadedRunner.h"
+#include "WTracer.h"
 
 WThreadedRunner::WThreadedRunner():
     m_shutdownFlag( new WConditionOneShot(), false ),
@@ -179,11 +180,13 @@ void WThreadedRunner::setThisThreadName( std::string name )
 {
     // set the name of the thread. This name is shown by the "top", for example.
     prctl( PR_SET_NAME, ( "openwalnut (" + name + ")" ).c_str() );
+    WTracer::setThreadName( name );
 }
 #else
-void WThreadedRunner::setThisThreadName( std::string /* name */ )
+void WThreadedRunner::setThisThreadName( std::string name )
 {
-    // Not supported
+    // Not supported by the OS, only used in traces
+    WTracer::setThreadName( name );
 }
 #endif
 
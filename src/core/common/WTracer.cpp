@@ -0,0 +1,456 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "WTracer.h"
+
+std::atomic< bool > WTracer::m_enabled( false );
+
+namespace
+{
+    //! The number of buffers of finished threads kept for export.
+    std::size_t const maxFinishedBuffers = 64;
+
+    /**
+     * A single recorded event.
+     */
+    struct Event
+    {
+        //! the name
+        char const* m_name;
+
+        //! the Chrome trace event phase, 'X', 'i', 'C', 'b' or 'e'
+        char m_phase;
+
+        //! the time in nanoseconds
+        int64_t m_time;
+
+        //! the duration of complete events in nanoseconds
+        int64_t m_duration;
+
+        //! the id of async events
+        uint64_t m_id;
+
+        //! the value of counters
+        double m_value;
+    };
+
+    /**
+     * The ring buffer of a single thread. Only the owning thread writes, the lock is only contended while exporting.
+     */
+    struct ThreadBuffer
+    {
+        //! protects the events
+        std::mutex m_lock;
+
+        //! the events, the oldest one at m_next if the buffer is full
+        std::vector< Event > m_events;
+
+        //! the maximum number of events
+        std::size_t m_capacity;
+
+        //! the position to overwrite next if the buffer is full
+        std::size_t m_next;
+
+        //! the id of the thread in the trace
+        std::size_t m_tid;
+
+        //! the name of the thread
+        std::string m_threadName;
+
+        //! true if the thread has finished
+        std::atomic< bool > m_finished;
+    };
+
+    /**
+     * The state shared by all threads.
+     */
+    struct Registry
+    {
+        //! protects everything in here
+        std::mutex m_lock;
+
+        //! the buffers of all threads that recorded anything, in the order they started recording
+        std::vector< std::shared_ptr< ThreadBuffer > > m_buffers;
+
+        //! the interned names
+        std::set< std::string > m_names;
+
+        //! the id of the next thread
+        std::size_t m_nextTid = 1;
+
+        //! the capacity of new buffers
+        std::size_t m_bufferSize = 1 << 15;
+    };
+
+    /**
+     * The registry, created on first use to avoid static initialization order problems.
+     *
+     * \return the registry
+     */
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /**
+     * Per thread state. Marks the buffer as finished when the thread ends.
+     */
+    struct ThreadState
+    {
+        /**
+         * Destructor.
+         */
+        ~ThreadState()
+        {
+            if( m_buffer )
+            {
+                m_buffer->m_finished = true;
+            }
+        }
+
+        //! the buffer, created when the thread records the first event
+        std::shared_ptr< ThreadBuffer > m_buffer;
+
+        //! the name of the thread
+        std::string m_name;
+    };
+
+    //! the state of the calling thread
+    thread_local ThreadState threadState;
+
+    /**
+     * Record an event into the buffer of the calling thread.
+     *
+     * \param event the event
+     */
+    void record( Event const& event )
+    {
+        if( !threadState.m_buffer )
+        {
+            std::shared_ptr< ThreadBuffer > buffer( new ThreadBuffer() );
+            buffer->m_next = 0;
+            buffer->m_threadName = threadState.m_name;
+            buffer->m_finished = false;
+
+            Registry& registry = getRegistry();
+            std::lock_guard< std::mutex > lock( registry.m_lock );
+            buffer->m_capacity = registry.m_bufferSize;
+            buffer->m_tid = registry.m_nextTid++;
+
+            // threads of WThreadedFunction come and go, only keep the most recent finished ones
+            std::size_t finished = 0;
+            for( std::size_t i = 0; i < registry.m_buffers.size(); ++i )
+            {
+                finished += registry.m_buffers[ i ]->m_finished ? 1 : 0;
+            }
+            for( std::vector< std::shared_ptr< ThreadBuffer > >::iterator it = registry.m_buffers.begin();
+                 finished >= maxFinishedBuffers && it != registry.m_buffers.end(); )
+            {
+                if( ( *it )->m_finished )
+                {
+                    it = registry.m_buffers.erase( it );
+                    --finished;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            registry.m_buffers.push_back( buffer );
+            threadState.m_buffer = buffer;
+        }
+
+        ThreadBuffer& buffer = *threadState.m_buffer;
+        std::lock_guard< std::mutex > lock( buffer.m_lock );
+        if( buffer.m_events.size() < buffer.m_capacity )
+        {
+            buffer.m_events.push_back( event );
+        }
+        else
+        {
+            buffer.m_events[ buffer.m_next ] = event;
+            buffer.m_next = ( buffer.m_next + 1 ) % buffer.m_capacity;
+        }
+    }
+
+    /**
+     * Create an event.
+     *
+     * \param name the name
+     * \param phase the Chrome trace event phase
+     * \param time the time
+     *
+     * \return the event
+     */
+    Event makeEvent( char const* name, char phase, int64_t time )
+    {
+        Event event;
+        event.m_name = name;
+        event.m_phase = phase;
+        event.m_time = time;
+        event.m_duration = 0;
+        event.m_id = 0;
+        event.m_value = 0.0;
+        return event;
+    }
+
+    /**
+     * Write a string as JSON string literal.
+     *
+     * \param out the stream
+     * \param str the string
+     */
+    void writeJSONString( std::ostream& out, std::string const& str )
+    {
+        out << '"';
+        for( std::size_t i = 0; i < str.size(); ++i )
+        {
+            unsigned char const c = static_cast< unsigned char >( str[ i ] );
+            if( c == '"' || c == '\\' )
+            {
+                out << '\\' << str[ i ];
+            }
+            else if( c < 0x20 )
+            {
+                char code[ 8 ];
+                std::snprintf( code, sizeof( code ), "\\u%04x", c );
+                out << code;
+            }
+            else
+            {
+                out << str[ i ];
+            }
+        }
+        out << '"';
+    }
+
+    /**
+     * Write nanoseconds as the microseconds the trace format uses.
+     *
+     * \param out the stream
+     * \param ns the nanoseconds
+     */
+    void writeMicroseconds( std::ostream& out, int64_t ns )
+    {
+        char str[ 32 ];
+        long long const us = ns / 1000; // NOLINT the format needs long long
+        long long const rest = ns % 1000; // NOLINT
+        std::snprintf( str, sizeof( str ), "%lld.%03lld", us, rest );
+        out << str;
+    }
+
+    /**
+     * Write a single event.
+     *
+     * \param out the stream
+     * \param event the event
+     * \param tid the id of the thread that recorded the event
+     */
+    void writeEvent( std::ostream& out, Event const& event, std::size_t tid )
+    {
+        out << ",\n{\"name\":";
+        writeJSONString( out, event.m_name );
+        out << ",\"cat\":\"openwalnut\",\"ph\":\"" << event.m_phase << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+        writeMicroseconds( out, event.m_time );
+        switch( event.m_phase )
+        {
+            case 'X':
+                out << ",\"dur\":";
+                writeMicroseconds( out, event.m_duration );
+                break;
+            case 'i':
+                out << ",\"s\":\"t\"";
+                break;
+            case 'C':
+                out << ",\"args\":{\"value\":" << event.m_value << "}";
+                break;
+            default:
+                out << ",\"id\":\"0x" << std::hex << event.m_id << std::dec << "\"";
+                break;
+        }
+        out << "}";
+    }
+}
+
+void WTracer::setEnabled( bool enabled )
+{
+    m_enabled = enabled;
+}
+
+void WTracer::setBufferSize( std::size_t events )
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.m_lock );
+    registry.m_bufferSize = std::max< std::size_t >( events, 1 );
+}
+
+void WTracer::setThreadName( std::string const& name )
+{
+    threadState.m_name = name;
+    if( threadState.m_buffer )
+    {
+        std::lock_guard< std::mutex > lock( threadState.m_buffer->m_lock );
+        threadState.m_buffer->m_threadName = name;
+    }
+}
+
+char const* WTracer::intern( std::string const& name )
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.m_lock );
+    return registry.m_names.insert( name ).first->c_str();
+}
+
+int64_t WTracer::now()
+{
+    static std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - epoch ).count();
+}
+
+void WTracer::complete( char const* name, int64_t start, int64_t duration )
+{
+    Event event = makeEvent( name, 'X', start );
+    event.m_duration = duration;
+    record( event );
+}
+
+void WTracer::instant( char const* name )
+{
+    if( isEnabled() )
+    {
+        record( makeEvent( name, 'i', now() ) );
+    }
+}
+
+void WTracer::counter( char const* name, double value )
+{
+    if( isEnabled() )
+    {
+        Event event = makeEvent( name, 'C', now() );
+        event.m_value = value;
+        record( event );
+    }
+}
+
+void WTracer::asyncBegin( char const* name, uint64_t id )
+{
+    if( isEnabled() )
+    {
+        Event event = makeEvent( name, 'b', now() );
+        event.m_id = id;
+        record( event );
+    }
+}
+
+void WTracer::asyncEnd( char const* name, uint64_t id )
+{
+    if( isEnabled() )
+    {
+        Event event = makeEvent( name, 'e', now() );
+        event.m_id = id;
+        record( event );
+    }
+}
+
+std::size_t WTracer::getNumEvents()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.m_lock );
+    std::size_t count = 0;
+    for( std::size_t i = 0; i < registry.m_buffers.size(); ++i )
+    {
+        std::lock_guard< std::mutex > bufferLock( registry.m_buffers[ i ]->m_lock );
+        count += registry.m_buffers[ i ]->m_events.size();
+    }
+    return count;
+}
+
+void WTracer::clear()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.m_lock );
+    std::vector< std::shared_ptr< ThreadBuffer > > running;
+    for( std::size_t i = 0; i < registry.m_buffers.size(); ++i )
+    {
+        ThreadBuffer& buffer = *registry.m_buffers[ i ];
+        std::lock_guard< std::mutex > bufferLock( buffer.m_lock );
+        buffer.m_events.clear();
+        buffer.m_next = 0;
+        if( !buffer.m_finished )
+        {
+            running.push_back( registry.m_buffers[ i ] );
+        }
+    }
+    registry.m_buffers.swap( running );
+}
+
+void WTracer::writeChromeTrace( std::ostream& out )
+{
+    Registry& registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.m_lock );
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"OpenWalnut\"}}";
+    for( std::size_t i = 0; i < registry.m_buffers.size(); ++i )
+    {
+        ThreadBuffer& buffer = *registry.m_buffers[ i ];
+        std::lock_guard< std::mutex > bufferLock( buffer.m_lock );
+
+        std::string const name = buffer.m_threadName.empty() ? "Thread " + std::to_string( buffer.m_tid ) : buffer.m_threadName;
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.m_tid << ",\"args\":{\"name\":";
+        writeJSONString( out, name );
+        out << "}}";
+
+        // oldest first
+        for( std::size_t k = 0; k < buffer.m_events.size(); ++k )
+        {
+            writeEvent( out, buffer.m_events[ ( buffer.m_next + k ) % buffer.m_events.size() ], buffer.m_tid );
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool WTracer::writeChromeTrace( boost::filesystem::path const& filename )
+{
+    std::ofstream out( filename.string().c_str() );
+    if( !out )
+    {
+        return false;
+    }
+    writeChromeTrace( out );
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WTRACER_H
+#define WTRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+/**
+ * Records what the threads of OpenWalnut are doing and exports it in the Chrome trace event format, which can be viewed
+ * with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Every thread records into its own ring buffer, so recording does not contend with other threads. When a buffer is
+ * full, the oldest events get overwritten. Tracing is compiled in but disabled by default. Then, recording costs a single
+ * relaxed atomic load, so the markers can stay in hot paths.
+ *
+ * Names handed to the tracer are stored as pointers. Use string literals or intern() them.
+ *
+ * \see WTraceScope
+ */
+class WTracer // NOLINT
+{
+public:
+    /**
+     * Checks whether events are recorded.
+     *
+     * \return true if tracing is enabled.
+     */
+    static bool isEnabled()
+    {
+        return m_enabled.load( std::memory_order_relaxed );
+    }
+
+    /**
+     * Enable or disable recording. Already recorded events are kept.
+     *
+     * \param enabled true to start recording
+     */
+    static void setEnabled( bool enabled );
+
+    /**
+     * Set the number of events kept per thread. Applies to threads starting to record after the call.
+     *
+     * \param events the ring buffer size
+     */
+    static void setBufferSize( std::size_t events );
+
+    /**
+     * Set the name the calling thread is shown with in the trace. WThreadedRunner::setThisThreadName() calls this.
+     *
+     * \param name the name
+     */
+    static void setThreadName( std::string const& name );
+
+    /**
+     * Get a pointer to a copy of the string which stays valid for the whole runtime. Equal strings give equal pointers.
+     *
+     * \param name the name to store
+     *
+     * \return the stored name
+     */
+    static char const* intern( std::string const& name );
+
+    /**
+     * The current time in the time base of the trace.
+     *
+     * \return nanoseconds since the tracer was first used
+     */
+    static int64_t now();
+
+    /**
+     * Record a finished scope of the calling thread.
+     *
+     * \param name the name of the scope
+     * \param start the start time as returned by now()
+     * \param duration the duration in nanoseconds
+     */
+    static void complete( char const* name, int64_t start, int64_t duration );
+
+    /**
+     * Record a single point in time on the calling thread.
+     *
+     * \param name the name of the event
+     */
+    static void instant( char const* name );
+
+    /**
+     * Record the value of a counter. Counters are shown as graphs.
+     *
+     * \param name the name of the counter
+     * \param value the current value
+     */
+    static void counter( char const* name, double value );
+
+    /**
+     * Begin an asynchronous span. Asynchronous spans may end on a different thread than they began.
+     *
+     * \param name the name of the span
+     * \param id identifies the span together with the name, an address for example
+     */
+    static void asyncBegin( char const* name, uint64_t id );
+
+    /**
+     * End an asynchronous span.
+     *
+     * \param name the name of the span
+     * \param id the id used with asyncBegin()
+     */
+    static void asyncEnd( char const* name, uint64_t id );
+
+    /**
+     * The number of events currently stored in all buffers.
+     *
+     * \return the number of events
+     */
+    static std::size_t getNumEvents();
+
+    /**
+     * Remove all recorded events and the buffers of finished threads.
+     */
+    static void clear();
+
+    /**
+     * Write all recorded events as Chrome trace event JSON.
+     *
+     * \param out the stream to write to
+     */
+    static void writeChromeTrace( std::ostream& out );
+
+    /**
+     * Write all recorded events as Chrome trace event JSON to a file.
+     *
+     * \param filename the file to write
+     *
+     * \return false if the file could not be written.
+     */
+    static bool writeChromeTrace( boost::filesystem::path const& filename );
+
+private:
+    //! true if events get recorded
+    static std::atomic< bool > m_enabled;
+};
+
+/**
+ * Records the lifetime of a scope as a single event. Use the WTRACE_SCOPE macros instead of creating instances directly.
+ */
+class WTraceScope // NOLINT
+{
+public:
+    /**
+     * Starts the scope if tracing is enabled.
+     *
+     * \param name the name of the scope, NULL to record nothing
+     */
+    explicit WTraceScope( char const* name )
+        : m_name( WTracer::isEnabled() ? name : NULL ),
+          m_start( m_name ? WTracer::now() : 0 )
+    {
+    }
+
+    /**
+     * Records the scope.
+     */
+    ~WTraceScope()
+    {
+        if( m_name )
+        {
+            WTracer::complete( m_name, m_start, WTracer::now() - m_start );
+        }
+    }
+
+private:
+    /**
+     * Not copyable.
+     */
+    WTraceScope( WTraceScope const& ); // NOLINT
+
+    /**
+     * Not copyable.
+     *
+     * \return this
+     */
+    WTraceScope& operator=( WTraceScope const& );
+
+    //! the name or NULL if not recording
+    char const* m_name;
+
+    //! the start time
+    int64_t m_start;
+};
+
+//! Helper for WTRACE_CONCAT.
+#define WTRACE_CONCAT_IMPL( a, b ) a ## b
+
+//! Helper for WTRACE_SCOPE, expands the arguments before concatenating them.
+#define WTRACE_CONCAT( a, b ) WTRACE_CONCAT_IMPL( a, b )
+
+//! Trace the enclosing scope. The name must be a string literal.
+#define WTRACE_SCOPE( name ) WTraceScope WTRACE_CONCAT( wTraceScope, __LINE__ )( name )
+
+//! Trace the enclosing scope using a std::string name. The name is only evaluated if tracing is enabled.
+#define WTRACE_SCOPE_DYNAMIC( name ) \
+    WTraceScope WTRACE_CONCAT( wTraceScope, __LINE__ )( WTracer::isEnabled() ? WTracer::intern( name ) : NULL )
+
+#endif  // WTRACER_H
@@ -34,6 +34,7 @@
 #include "WAssert.h"
 #include "WException.h"
 #include "WThreadedRunner.h"
+#include "WTracer.h"
 
 /**
  * A worker thread that belongs to a \see WThreadedFunction object.
@@ -167,6 +168,7 @@ void WWorkerThread< Function_T >::threadMain()
 {
     if( m_func )
     {
+        WTRACE_SCOPE( "WThreadedFunction worker" );
         try
         {
             m_func->operator() ( m_id, m_numThreads, m_shutdownFlag );
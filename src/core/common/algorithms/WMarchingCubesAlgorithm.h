@@ -29,6 +29,7 @@
 #include <memory>
 #include <vector>
 
+#include "../WCancelToken.h"
 #include "../WProgressCombiner.h"
 #include "../math/WMatrix.h"
 #include "WMarchingCubesCaseTables.h"
@@ -108,6 +109,7 @@ public:
      * \param vals the values at the vertices
      * \param isoValue The surface will run through all positions with this value.
      * \param mainProgress progress combiner used to report our progress to
+     * \param cancelToken if set, a WComputationCancelled is thrown after it got cancelled
      *
      * \return the genereated surface
      */
@@ -116,7 +118,8 @@ public:
                                                           const WMatrix< double >& mat,
                                                           const std::vector< T >* vals,
                                                           double isoValue,
-                                                          std::shared_ptr< WProgressCombiner > mainProgress );
+                                                          std::shared_ptr< WProgressCombiner > mainProgress,
+                                                          WCancelToken::ConstSPtr cancelToken = WCancelToken::ConstSPtr() );
 
 protected:
 private:
@@ -191,7 +194,8 @@ template<typename T> std::shared_ptr<WTriangleMesh> WMarchingCubesAlgorithm::gen
                                                                                                  const WMatrix< double >& mat,
                                                                                                  const std::vector< T >* vals,
                                                                                                  double isoValue,
-                                                                                                 std::shared_ptr< WProgressCombiner > mainProgress )
+                                                                                                 std::shared_ptr< WProgressCombiner > mainProgress,
+                                                                                                 WCancelToken::ConstSPtr cancelToken )
 {
     WAssert( vals, "No value set provided." );
 
@@ -213,6 +217,7 @@ template<typename T> std::shared_ptr<WTriangleMesh> WMarchingCubesAlgorithm::gen
     unsigned int nPointsInSlice = nX * nY;
 
     std::shared_ptr< WProgress > progress( new WProgress( "Marching Cubes", m_nCellsZ ) );
+    progress->setCancelToken( cancelToken );
     mainProgress->addSubProgress( progress );
     // Generate isosurface.
     for( unsigned int z = 0; z < m_nCellsZ; z++ )
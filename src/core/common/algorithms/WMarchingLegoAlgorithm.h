@@ -29,6 +29,7 @@
 #include <memory>
 #include <vector>
 
+#include "../WCancelToken.h"
 #include "../WProgressCombiner.h"
 #include "../math/WMatrix.h"
 #include "core/graphicsEngine/WTriangleMesh.h"
@@ -85,6 +86,7 @@ public:
      * \param vals the values at the vertices
      * \param isoValue The surface will run through all positions with this value.
      * \param mainProgress Pointer to the parent's progress reporter. Leave empty if no progress should be shown
+     * \param cancelToken if set, a WComputationCancelled is thrown after it got cancelled
      *
      * \return the created triangle mesh
      */
@@ -94,7 +96,8 @@ public:
                                                         const std::vector< T >* vals,
                                                         double isoValue,
                                                         std::shared_ptr<WProgressCombiner> mainProgress
-                                                            = std::shared_ptr < WProgressCombiner >() );
+                                                            = std::shared_ptr < WProgressCombiner >(),
+                                                        WCancelToken::ConstSPtr cancelToken = WCancelToken::ConstSPtr() );
 
     /**
      * Generate the triangles for the surface on the given dataSet (inGrid, vals). The texture coordinates in the resulting mesh are relative to
@@ -155,7 +158,8 @@ WMarchingLegoAlgorithm::generateSurface( size_t nbCoordsX, size_t nbCoordsY, siz
                                          const WMatrix< double >& mat,
                                          const std::vector< T >* vals,
                                          double isoValue,
-                                         std::shared_ptr<WProgressCombiner> mainProgress )
+                                         std::shared_ptr<WProgressCombiner> mainProgress,
+                                         WCancelToken::ConstSPtr cancelToken )
 {
     WAssert( vals, "No value set provided." );
 
@@ -179,6 +183,7 @@ WMarchingLegoAlgorithm::generateSurface( size_t nbCoordsX, size_t nbCoordsY, siz
     if( mainProgress )
     {
         progress = std::shared_ptr< WProgress >( new WProgress( "Marching Cubes", m_nCellsZ ) );
+        progress->setCancelToken( cancelToken );
         mainProgress->addSubProgress( progress );
     }
 
@@ -189,6 +194,10 @@ WMarchingLegoAlgorithm::generateSurface( size_t nbCoordsX, size_t nbCoordsY, siz
         {
             ++*progress;
         }
+        else if( cancelToken )
+        {
+            cancelToken->throwIfCancelled();
+        }
         for( size_t y = 0; y < m_nCellsY; y++ )
         {
             for( size_t x = 0; x < m_nCellsX; x++ )
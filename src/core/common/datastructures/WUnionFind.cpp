@@ -42,19 +42,31 @@ WUnionFind::WUnionFind( size_t size )
     }
 }
 
+size_t WUnionFind::size() const
+{
+    return m_component.size();
+}
+
 size_t WUnionFind::find( size_t x )
 {
     if( x >= m_component.size() )
     {
         throw WOutOfBounds( std::string( "Element index in UnionFind greater than overall elements!" ) );
     }
-    if( m_component[x] == x ) // we are the root
+    size_t root = x;
+    while( m_component[ root ] != root )
     {
-        return x;
+        root = m_component[ root ];
     }
 
-    m_component[x] = find( m_component[x] ); // path compression otherwise
-    return m_component[x];
+    // path compression
+    while( m_component[ x ] != root )
+    {
+        size_t const next = m_component[ x ];
+        m_component[ x ] = root;
+        x = next;
+    }
+    return root;
 }
 
 void WUnionFind::merge( size_t i, size_t j )
@@ -82,13 +82,19 @@ public:
      */
     explicit WUnionFind( size_t size );
 
+    /**
+     * The number of elements.
+     *
+     * \return The number of elements.
+     */
+    size_t size() const;
+
     /**
      * Find the canonical element of the given element and do path compression
      *
      * http://en.wikipedia.org/wiki/Disjoint-set_data_structure
      *
-     * depth of recursion is said to be small, therefore, recursion
-     * works fine for large dataset, too.
+     * The path is followed iteratively, as merges do not balance the trees and long chains would exhaust the stack.
      *
      * \throw WOutOfBounds If x is bigger than the number of elements available
      *
@@ -0,0 +1,55 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCOMPUTATIONCANCELLED_H
+#define WCOMPUTATIONCANCELLED_H
+
+#include <string>
+
+#include "../WException.h"
+
+/**
+ * Thrown when a computation notices that its WCancelToken was cancelled, usually because newer input arrived and the
+ * computation is about to be restarted.
+ * \ingroup common
+ */
+class WComputationCancelled: public WException
+{
+public:
+    /**
+     * Default constructor.
+     * \param msg the exception message.
+     */
+    explicit WComputationCancelled( const std::string& msg = "The computation was cancelled." );
+
+    /**
+     * Destructor.
+     */
+    virtual ~WComputationCancelled() throw();
+
+protected:
+private:
+};
+
+#endif  // WCOMPUTATIONCANCELLED_H
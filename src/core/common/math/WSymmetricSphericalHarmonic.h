@@ -214,6 +214,17 @@ public:
     */
     static WMatrix< T > calcBaseMatrix( const std::vector< WUnitSphereCoordinates< T > >& orientations, int order );
 
+    /**
+    * Calculates the values of all base functions up to the given order for a single orientation. This is one row of the
+    * base matrix B, computed with the recurrence of the normalized associated Legendre functions instead of evaluating
+    * every base function on its own.
+    * \param theta angle for the position on the unit sphere
+    * \param phi angle for the position on the unit sphere
+    * \param order The order of the spherical harmonics intended to create
+    * \param[out] base Receives the ( order + 1 ) * ( order + 2 ) / 2 values of the base functions
+    */
+    static void calcBaseFunctions( T theta, T phi, int order, T* base );
+
     /**
     * Calculates the base matrix B for the complex spherical harmonics.
     * \param orientations The vector with the used orientation on the unit sphere (usually the gradients of the HARDI)
@@ -276,6 +287,19 @@ public:
 
 protected:
 private:
+    /**
+     * Calls the given functor for every base function up to the given order, passing the index of the base function and its
+     * value at the given position. Uses the stable three-term recurrence of the normalized associated Legendre functions,
+     * so evaluating all base functions is about as expensive as evaluating a single one with boost::math::spherical_harmonic.
+     *
+     * \param theta angle for the position on the unit sphere
+     * \param phi angle for the position on the unit sphere
+     * \param order The order of the spherical harmonic
+     * \param visitor Functor called as visitor( index, value ) for every base function
+     */
+    template< typename Visitor_T >
+    static void visitBaseFunctions( T theta, T phi, int order, Visitor_T& visitor ); // NOLINT non-const reference
+
     /** order of the spherical harmonic */
     size_t m_order;
 
@@ -306,30 +330,120 @@ WSymmetricSphericalHarmonic< T >::~WSymmetricSphericalHarmonic()
 }
 
 template< typename T >
-T WSymmetricSphericalHarmonic< T >::getValue( T theta, T phi ) const
+template< typename Visitor_T >
+void WSymmetricSphericalHarmonic< T >::visitBaseFunctions( T theta, T phi, int order, Visitor_T& visitor ) // NOLINT non-const reference
 {
-  T result = 0.0;
-  int j = 0;
-  const T rootOf2 = std::sqrt( 2.0 );
-  for( int k = 0; k <= static_cast<int>( m_order ); k+=2 )
+  // the normalized associated Legendre functions Q_l^m = sqrt( ( 2l + 1 ) / 4pi * ( l - m )! / ( l + m )! ) P_l^m( cos( theta ) ),
+  // including the Condon-Shortley phase, exactly like boost::math::spherical_harmonic
+  const double x = std::cos( static_cast< double >( theta ) );
+  const double s = std::sin( static_cast< double >( theta ) );
+  const double rootOf2 = std::sqrt( 2.0 );
+  double qmm = 1.0 / std::sqrt( 4.0 * pi() );
+  for( int m = 0; m <= order; ++m )
   {
-    // m = 1 .. k
-    for( int m = 1; m <= k; m++ )
+    if( m > 0 )
     {
-      j = ( k*k+k+2 ) / 2 + m;
-      result += m_SHCoefficients[ j-1 ] * rootOf2 *
-                  static_cast< T >( std::pow( -1.0, m+1 ) ) * boost::math::spherical_harmonic_i( k, m, theta, phi );
+      qmm *= -std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) ) * s;
     }
-    // m = 0
-    result += m_SHCoefficients[ ( k*k+k+2 ) / 2 - 1 ] * boost::math::spherical_harmonic_r( k, 0, theta, phi );
-    // m = -k .. -1
-    for( int m = -k; m < 0; m++ )
+    const double cosMPhi = std::cos( m * static_cast< double >( phi ) );
+    const double sinMPhi = std::sin( m * static_cast< double >( phi ) );
+
+    double qPrev = 0.0;
+    double q = qmm;
+    for( int l = m; l <= order; ++l )
     {
-      j = ( k*k+k+2 ) / 2 + m;
-      result += m_SHCoefficients[ j-1 ] * rootOf2 * boost::math::spherical_harmonic_r( k, -m, theta, phi );
+      if( l == m + 1 )
+      {
+        qPrev = q;
+        q = std::sqrt( 2.0 * m + 3.0 ) * x * q;
+      }
+      else if( l > m + 1 )
+      {
+        const double a = std::sqrt( ( 4.0 * l * l - 1.0 ) / ( static_cast< double >( l ) * l - static_cast< double >( m ) * m ) );
+        const double b = std::sqrt( ( ( l - 1.0 ) * ( l - 1.0 ) - static_cast< double >( m ) * m ) / ( 4.0 * ( l - 1.0 ) * ( l - 1.0 ) - 1.0 ) );
+        const double next = a * ( x * q - b * qPrev );
+        qPrev = q;
+        q = next;
+      }
+
+      // the basis is symmetric, only even orders are used
+      if( l % 2 != 0 )
+      {
+        continue;
+      }
+      const int center = ( l * l + l + 2 ) / 2 - 1;
+      if( m == 0 )
+      {
+        visitor( center, static_cast< T >( q ) );
+      }
+      else
+      {
+        // this is rootOf2 * ( -1 )^( m + 1 ) * Y_l^m.imag and rootOf2 * Y_l^m.real, see calcBaseMatrix()
+        visitor( center + m, static_cast< T >( ( m % 2 == 0 ? -rootOf2 : rootOf2 ) * q * sinMPhi ) );
+        visitor( center - m, static_cast< T >( rootOf2 * q * cosMPhi ) );
+      }
     }
   }
-  return result;
+}
+
+/**
+ * Accumulates the value of a spherical harmonic from its coefficients and the values of the base functions.
+ */
+template< typename T >
+struct WSymmetricSphericalHarmonicAccumulator
+{
+    /**
+     * Adds a single term.
+     *
+     * \param index index of the base function
+     * \param value value of the base function
+     */
+    void operator()( int index, T value )
+    {
+        m_result += m_coefficients[ index ] * value;
+    }
+
+    /** the coefficients */
+    const WValue< T >& m_coefficients;
+
+    /** the accumulated value */
+    T m_result;
+};
+
+/**
+ * Writes the values of the base functions to an array.
+ */
+template< typename T >
+struct WSymmetricSphericalHarmonicBaseWriter
+{
+    /**
+     * Stores a single value.
+     *
+     * \param index index of the base function
+     * \param value value of the base function
+     */
+    void operator()( int index, T value )
+    {
+        m_base[ index ] = value;
+    }
+
+    /** the target array */
+    T* m_base;
+};
+
+template< typename T >
+T WSymmetricSphericalHarmonic< T >::getValue( T theta, T phi ) const
+{
+  WSymmetricSphericalHarmonicAccumulator< T > accumulator = { m_SHCoefficients, 0.0 }; // NOLINT curly braces
+  visitBaseFunctions( theta, phi, static_cast< int >( m_order ), accumulator );
+  return accumulator.m_result;
+}
+
+template< typename T >
+void WSymmetricSphericalHarmonic< T >::calcBaseFunctions( T theta, T phi, int order, T* base )
+{
+  WSymmetricSphericalHarmonicBaseWriter< T > writer = { base }; // NOLINT curly braces
+  visitBaseFunctions( theta, phi, order, writer );
 }
 
 template< typename T >
@@ -659,29 +773,13 @@ WMatrix< T > WSymmetricSphericalHarmonic< T >::calcBaseMatrix( const std::vector
   WMatrix< T > B( orientations.size(), ( ( order + 1 ) * ( order + 2 ) ) / 2 );
 
   // calc B Matrix like in the 2007 Descoteaux paper ("Regularized, Fast, and Robust Analytical Q-Ball Imaging")
-  int j = 0;
-  const T rootOf2 = std::sqrt( 2.0 );
-  for( uint32_t row = 0; row < orientations.size(); row++ )
+  std::vector< T > row( B.getNbCols() );
+  for( uint32_t i = 0; i < orientations.size(); i++ )
   {
-    const T theta = orientations[row].getTheta();
-    const T phi = orientations[row].getPhi();
-    for( int k = 0; k <= order; k+=2 )
+    calcBaseFunctions( orientations[ i ].getTheta(), orientations[ i ].getPhi(), order, &row[ 0 ] );
+    for( std::size_t j = 0; j < row.size(); ++j )
     {
-      // m = 1 .. k
-      for( int m = 1; m <= k; m++ )
-      {
-        j = ( k * k + k + 2 ) / 2 + m;
-        B( row, j-1 ) = rootOf2 * static_cast< T >( std::pow( static_cast< T >( -1 ), m + 1 ) )
-                        * boost::math::spherical_harmonic_i( k, m, theta, phi );
-      }
-      // m = 0
-      B( row, ( k * k + k + 2 ) / 2 - 1 ) = boost::math::spherical_harmonic_r( k, 0, theta, phi );
-      // m = -k .. -1
-      for( int m = -k; m < 0; m++ )
-      {
-        j = ( k * k + k + 2 ) / 2 + m;
-        B( row, j-1 ) = rootOf2*boost::math::spherical_harmonic_r( k, -m, theta, phi );
-      }
+      B( i, j ) = row[ j ];
     }
   }
   return B;
@@ -0,0 +1,284 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSYMMETRICSPHERICALHARMONICPLAN_H
+#define WSYMMETRICSPHERICALHARMONICPLAN_H
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "../WAssert.h"
+#include "WSymmetricSphericalHarmonic.h"
+#include "WUnitSphereCoordinates.h"
+
+/**
+ * A precomputed plan for evaluating many symmetric spherical harmonics of the same order at the same set of directions,
+ * as needed for glyphs, GFA or tracking on a sphere tesselation. The base matrix B is computed once, evaluating the
+ * spherical harmonics of many voxels then is a single matrix product of their coefficients with B.
+ *
+ * Plans are immutable and can be shared between threads. Use getPlan() to get a cached instance.
+ */
+template< typename T >
+class WSymmetricSphericalHarmonicPlan // NOLINT
+{
+public:
+    /**
+     * Constructor. Computes the base matrix.
+     *
+     * \param directions The directions to evaluate the spherical harmonics at.
+     * \param order The order of the spherical harmonics, must be even.
+     */
+    WSymmetricSphericalHarmonicPlan( std::vector< WUnitSphereCoordinates< T > > const& directions, std::size_t order );
+
+    /**
+     * Get a plan from the global cache or create a new one. The cache keeps the most recently used plans.
+     *
+     * \param directions The directions to evaluate the spherical harmonics at.
+     * \param order The order of the spherical harmonics, must be even.
+     *
+     * \return The plan.
+     */
+    static std::shared_ptr< WSymmetricSphericalHarmonicPlan const > getPlan( std::vector< WUnitSphereCoordinates< T > > const& directions,
+                                                                            std::size_t order );
+
+    /**
+     * The order of the spherical harmonics this plan is made for.
+     *
+     * \return The order.
+     */
+    std::size_t getOrder() const;
+
+    /**
+     * The number of coefficients read per spherical harmonic.
+     *
+     * \return ( order + 1 ) * ( order + 2 ) / 2
+     */
+    std::size_t getNbCoefficients() const;
+
+    /**
+     * The number of directions.
+     *
+     * \return The number of values written per spherical harmonic.
+     */
+    std::size_t getNbDirections() const;
+
+    /**
+     * The directions used by this plan.
+     *
+     * \return The directions.
+     */
+    std::vector< WUnitSphereCoordinates< T > > const& getDirections() const;
+
+    /**
+     * Evaluate a single spherical harmonic at all directions.
+     *
+     * \param coefficients getNbCoefficients() coefficients in the order used by WSymmetricSphericalHarmonic.
+     * \param[out] values Receives getNbDirections() values.
+     */
+    void evaluate( T const* coefficients, T* values ) const;
+
+    /**
+     * Evaluate many spherical harmonics at all directions. The coefficients of the i-th spherical harmonic start at
+     * coefficients + i * stride, so the raw data of a valueset with more than getNbCoefficients() components per voxel
+     * can be used directly.
+     *
+     * \param coefficients The coefficients.
+     * \param count The number of spherical harmonics.
+     * \param stride The distance between the coefficients of two spherical harmonics, at least getNbCoefficients().
+     * \param[out] values Receives count * getNbDirections() values, one row of getNbDirections() per spherical harmonic.
+     */
+    void evaluate( T const* coefficients, std::size_t count, std::size_t stride, T* values ) const;
+
+    /**
+     * Calculate the generalized fractional anisotropy of a spherical harmonic using the directions of this plan. The result
+     * equals WSymmetricSphericalHarmonic::calcGFA() without creating any temporaries.
+     *
+     * \param coefficients getNbCoefficients() coefficients.
+     *
+     * \return The generalized fractional anisotropy.
+     */
+    T calcGFA( T const* coefficients ) const;
+
+private:
+    //! row-major matrix type
+    typedef Eigen::Matrix< T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > MatrixType;
+
+    /**
+     * Checks whether this plan was made for the given parameters.
+     *
+     * \param directions The directions.
+     * \param order The order.
+     *
+     * \return true if directions and order match.
+     */
+    bool matches( std::vector< WUnitSphereCoordinates< T > > const& directions, std::size_t order ) const;
+
+    //! the order
+    std::size_t m_order;
+
+    //! the directions
+    std::vector< WUnitSphereCoordinates< T > > m_directions;
+
+    //! the base matrix, one row per direction
+    MatrixType m_base;
+};
+
+template< typename T >
+WSymmetricSphericalHarmonicPlan< T >::WSymmetricSphericalHarmonicPlan( std::vector< WUnitSphereCoordinates< T > > const& directions,
+                                                                     std::size_t order )
+    : m_order( order ),
+      m_directions( directions ),
+      m_base( directions.size(), ( ( order + 1 ) * ( order + 2 ) ) / 2 )
+{
+    WAssert( order % 2 == 0, "Symmetric spherical harmonics must be of even order." );
+    for( std::size_t i = 0; i < directions.size(); ++i )
+    {
+        WSymmetricSphericalHarmonic< T >::calcBaseFunctions( directions[ i ].getTheta(), directions[ i ].getPhi(),
+                                                             static_cast< int >( order ), m_base.row( i ).data() );
+    }
+}
+
+template< typename T >
+std::shared_ptr< WSymmetricSphericalHarmonicPlan< T > const >
+WSymmetricSphericalHarmonicPlan< T >::getPlan( std::vector< WUnitSphereCoordinates< T > > const& directions, std::size_t order )
+{
+    typedef std::shared_ptr< WSymmetricSphericalHarmonicPlan const > PlanPtr;
+    static std::mutex cacheLock;
+    static std::list< PlanPtr > cache;
+    static std::size_t const maxCacheSize = 8;
+
+    {
+        std::lock_guard< std::mutex > lock( cacheLock );
+        for( typename std::list< PlanPtr >::iterator it = cache.begin(); it != cache.end(); ++it )
+        {
+            if( ( *it )->matches( directions, order ) )
+            {
+                // move to front, the least recently used plan is at the back
+                cache.splice( cache.begin(), cache, it );
+                return cache.front();
+            }
+        }
+    }
+
+    // do not block other threads while computing the base matrix
+    PlanPtr plan( new WSymmetricSphericalHarmonicPlan( directions, order ) );
+
+    std::lock_guard< std::mutex > lock( cacheLock );
+    cache.push_front( plan );
+    if( cache.size() > maxCacheSize )
+    {
+        cache.pop_back();
+    }
+    return plan;
+}
+
+template< typename T >
+std::size_t WSymmetricSphericalHarmonicPlan< T >::getOrder() const
+{
+    return m_order;
+}
+
+template< typename T >
+std::size_t WSymmetricSphericalHarmonicPlan< T >::getNbCoefficients() const
+{
+    return m_base.cols();
+}
+
+template< typename T >
+std::size_t WSymmetricSphericalHarmonicPlan< T >::getNbDirections() const
+{
+    return m_base.rows();
+}
+
+template< typename T >
+std::vector< WUnitSphereCoordinates< T > > const& WSymmetricSphericalHarmonicPlan< T >::getDirections() const
+{
+    return m_directions;
+}
+
+template< typename T >
+void WSymmetricSphericalHarmonicPlan< T >::evaluate( T const* coefficients, T* values ) const
+{
+    Eigen::Map< Eigen::Matrix< T, Eigen::Dynamic, 1 > const > c( coefficients, m_base.cols() );
+    Eigen::Map< Eigen::Matrix< T, Eigen::Dynamic, 1 > > v( values, m_base.rows() );
+    v.noalias() = m_base * c;
+}
+
+template< typename T >
+void WSymmetricSphericalHarmonicPlan< T >::evaluate( T const* coefficients, std::size_t count, std::size_t stride, T* values ) const
+{
+    WAssert( stride >= getNbCoefficients(), "Coefficient stride must not be smaller than the number of coefficients." );
+    Eigen::Map< MatrixType const, 0, Eigen::OuterStride<> > c( coefficients, count, m_base.cols(), Eigen::OuterStride<>( stride ) );
+    Eigen::Map< MatrixType > v( values, count, m_base.rows() );
+    v.noalias() = c * m_base.transpose();
+}
+
+template< typename T >
+T WSymmetricSphericalHarmonicPlan< T >::calcGFA( T const* coefficients ) const
+{
+    Eigen::Map< Eigen::Matrix< T, Eigen::Dynamic, 1 > const > c( coefficients, m_base.cols() );
+
+    T const n = static_cast< T >( m_base.rows() );
+    T sum = 0.0;
+    T squares = 0.0;
+    for( Eigen::Index i = 0; i < m_base.rows(); ++i )
+    {
+        T const f = m_base.row( i ).dot( c.transpose() );
+        sum += f;
+        squares += f * f;
+    }
+
+    if( squares == 0.0 || n <= 1.0 )
+    {
+        return 0.0;
+    }
+    // sum of squared deviations from the mean
+    T const d = std::max( squares - sum * sum / n, static_cast< T >( 0.0 ) );
+    return std::min( std::sqrt( ( n * d ) / ( ( n - 1.0 ) * squares ) ), static_cast< T >( 1.0 ) );
+}
+
+template< typename T >
+bool WSymmetricSphericalHarmonicPlan< T >::matches( std::vector< WUnitSphereCoordinates< T > > const& directions, std::size_t order ) const
+{
+    if( order != m_order || directions.size() != m_directions.size() )
+    {
+        return false;
+    }
+    for( std::size_t i = 0; i < directions.size(); ++i )
+    {
+        if( directions[ i ].getTheta() != m_directions[ i ].getTheta() || directions[ i ].getPhi() != m_directions[ i ].getPhi() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif  // WSYMMETRICSPHERICALHARMONICPLAN_H
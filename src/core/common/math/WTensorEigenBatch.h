@@ -0,0 +1,454 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WTENSOREIGENBATCH_H
+#define WTENSOREIGENBATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "WTensorFunctions.h"
+
+/**
+ * Number of tensors that are decomposed together by cardanoEigenSystemBatch(). All per-lane loops run over this many
+ * tensors stored in structure-of-arrays order, so the compiler can keep them in vector registers.
+ */
+static const std::size_t W_EIGEN_BATCH_LANES = 16;
+
+/**
+ * A strided, non-owning view onto a number of symmetric 3x3 tensors. Each of the six unique components
+ * ( xx, xy, xz, yy, yz, zz ) has its own base pointer and the i-th tensor's component c is found at
+ * m_components[ c ][ i * m_stride ].
+ *
+ * This describes structure-of-arrays storage ( six separate arrays, stride 1 ) as well as interleaved storage like
+ * the one used by WDataSetDTI ( one array, component pointers offset by one, stride 6 ).
+ */
+template< typename Data_T >
+struct WTensorSymBlock
+{
+    /**
+     * The base pointers of the components in the order xx, xy, xz, yy, yz, zz.
+     */
+    Data_T const* m_components[ 6 ];
+
+    /**
+     * The distance between two consecutive tensors in elements.
+     */
+    std::size_t m_stride;
+};
+
+/**
+ * A strided, non-owning view onto the output of a batched eigen decomposition. The k-th eigenvalue of the i-th tensor
+ * is written to m_values[ k ][ i * m_valueStride ], the components of the corresponding eigenvector to
+ * m_vectors[ k ][ i * m_vectorStride + 0..2 ]. Eigenvalues are sorted ascending, as done by jacobiEigenvector3D().
+ *
+ * Set a pointer to NULL if you are not interested in the respective value or vector. If all vector pointers are NULL,
+ * the eigenvectors are not computed at all.
+ */
+template< typename Data_T >
+struct WEigenSystemBlock
+{
+    /**
+     * The base pointers of the three eigenvalues, smallest first.
+     */
+    Data_T* m_values[ 3 ];
+
+    /**
+     * The distance between two consecutive eigenvalues in elements.
+     */
+    std::size_t m_valueStride;
+
+    /**
+     * The base pointers of the three eigenvectors, in the order of the eigenvalues.
+     */
+    Data_T* m_vectors[ 3 ];
+
+    /**
+     * The distance between two consecutive eigenvectors in elements.
+     */
+    std::size_t m_vectorStride;
+};
+
+namespace wtensoreigen
+{
+    /**
+     * Computes the eigenvalues of the symmetric matrix ( a00 a01 a02; a01 a11 a12; a02 a12 a22 ) in closed form using
+     * the trigonometric solution of the characteristic polynomial. The matrix should be scaled to avoid over- and
+     * underflow. This function does not branch, so it can be vectorized by the compiler.
+     *
+     * \param a00 Matrix element.
+     * \param a01 Matrix element.
+     * \param a02 Matrix element.
+     * \param a11 Matrix element.
+     * \param a12 Matrix element.
+     * \param a22 Matrix element.
+     * \param eval The resulting eigenvalues, ascending.
+     * \param halfDet The half determinant of the normalized, shifted matrix. If it is non-negative, eval[ 2 ] is the
+     * eigenvalue best separated from the others, otherwise eval[ 0 ] is.
+     */
+    inline void eigenValues( double a00, double a01, double a02, double a11, double a12, double a22,
+                             double* eval, double* halfDet )
+    {
+        double const q = ( a00 + a11 + a22 ) / 3.0;
+        double const b00 = a00 - q;
+        double const b11 = a11 - q;
+        double const b22 = a22 - q;
+        double const p2 = ( b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * ( a01 * a01 + a02 * a02 + a12 * a12 ) ) / 6.0;
+        double const p = std::sqrt( p2 );
+
+        // for multiples of the identity p is zero, the angle does not matter in this case
+        double const invP = 1.0 / ( p > 0.0 ? p : 1.0 );
+        double const c00 = b11 * b22 - a12 * a12;
+        double const c01 = a01 * b22 - a12 * a02;
+        double const c02 = a01 * a12 - b11 * a02;
+        double const det = ( b00 * c00 - a01 * c01 + a02 * c02 ) * invP * invP * invP;
+        double const r = std::min( std::max( 0.5 * det, -1.0 ), 1.0 );
+
+        double const phi = std::acos( r ) / 3.0;
+        double const twoThirdsPi = 2.09439510239319549;
+        double const beta2 = 2.0 * std::cos( phi );
+        double const beta0 = 2.0 * std::cos( phi + twoThirdsPi );
+        double const beta1 = -( beta0 + beta2 );
+
+        eval[ 0 ] = q + p * beta0;
+        eval[ 1 ] = q + p * beta1;
+        eval[ 2 ] = q + p * beta2;
+        *halfDet = r;
+    }
+
+    /**
+     * Computes the eigenvector of an eigenvalue of algebraic multiplicity one. The vector is the normalized cross product
+     * of two rows of A - eval * I with the largest magnitude.
+     *
+     * \param a The six unique matrix elements ( xx, xy, xz, yy, yz, zz ).
+     * \param eval The eigenvalue.
+     * \param evec The resulting, normalized eigenvector.
+     */
+    inline void eigenVectorOfSingleValue( double const* a, double eval, double* evec )
+    {
+        double const r0[ 3 ] = { a[ 0 ] - eval, a[ 1 ], a[ 2 ] }; // NOLINT curly braces
+        double const r1[ 3 ] = { a[ 1 ], a[ 3 ] - eval, a[ 4 ] }; // NOLINT curly braces
+        double const r2[ 3 ] = { a[ 2 ], a[ 4 ], a[ 5 ] - eval }; // NOLINT curly braces
+
+        double c[ 3 ][ 3 ];
+        c[ 0 ][ 0 ] = r0[ 1 ] * r1[ 2 ] - r0[ 2 ] * r1[ 1 ];
+        c[ 0 ][ 1 ] = r0[ 2 ] * r1[ 0 ] - r0[ 0 ] * r1[ 2 ];
+        c[ 0 ][ 2 ] = r0[ 0 ] * r1[ 1 ] - r0[ 1 ] * r1[ 0 ];
+        c[ 1 ][ 0 ] = r0[ 1 ] * r2[ 2 ] - r0[ 2 ] * r2[ 1 ];
+        c[ 1 ][ 1 ] = r0[ 2 ] * r2[ 0 ] - r0[ 0 ] * r2[ 2 ];
+        c[ 1 ][ 2 ] = r0[ 0 ] * r2[ 1 ] - r0[ 1 ] * r2[ 0 ];
+        c[ 2 ][ 0 ] = r1[ 1 ] * r2[ 2 ] - r1[ 2 ] * r2[ 1 ];
+        c[ 2 ][ 1 ] = r1[ 2 ] * r2[ 0 ] - r1[ 0 ] * r2[ 2 ];
+        c[ 2 ][ 2 ] = r1[ 0 ] * r2[ 1 ] - r1[ 1 ] * r2[ 0 ];
+
+        std::size_t best = 0;
+        double bestLength = 0.0;
+        for( std::size_t i = 0; i < 3; ++i )
+        {
+            double const l = c[ i ][ 0 ] * c[ i ][ 0 ] + c[ i ][ 1 ] * c[ i ][ 1 ] + c[ i ][ 2 ] * c[ i ][ 2 ];
+            if( l > bestLength )
+            {
+                best = i;
+                bestLength = l;
+            }
+        }
+
+        if( bestLength > 0.0 )
+        {
+            double const inv = 1.0 / std::sqrt( bestLength );
+            evec[ 0 ] = c[ best ][ 0 ] * inv;
+            evec[ 1 ] = c[ best ][ 1 ] * inv;
+            evec[ 2 ] = c[ best ][ 2 ] * inv;
+        }
+        else
+        {
+            // A - eval * I is zero, so any vector is an eigenvector
+            evec[ 0 ] = 1.0;
+            evec[ 1 ] = 0.0;
+            evec[ 2 ] = 0.0;
+        }
+    }
+
+    /**
+     * Computes an eigenvector orthogonal to a given one. The problem is reduced to a 2x2 eigenproblem in the orthogonal
+     * complement of the known vector, which is robust even if the two remaining eigenvalues are equal.
+     *
+     * \param a The six unique matrix elements ( xx, xy, xz, yy, yz, zz ).
+     * \param known The known, normalized eigenvector.
+     * \param eval The eigenvalue of the vector to compute.
+     * \param evec The resulting, normalized eigenvector.
+     */
+    inline void eigenVectorInComplement( double const* a, double const* known, double eval, double* evec )
+    {
+        // find an orthonormal basis u, v of the plane orthogonal to the known vector
+        double u[ 3 ];
+        if( std::fabs( known[ 0 ] ) > std::fabs( known[ 1 ] ) )
+        {
+            double const inv = 1.0 / std::sqrt( known[ 0 ] * known[ 0 ] + known[ 2 ] * known[ 2 ] );
+            u[ 0 ] = -known[ 2 ] * inv;
+            u[ 1 ] = 0.0;
+            u[ 2 ] = known[ 0 ] * inv;
+        }
+        else
+        {
+            double const inv = 1.0 / std::sqrt( known[ 1 ] * known[ 1 ] + known[ 2 ] * known[ 2 ] );
+            u[ 0 ] = 0.0;
+            u[ 1 ] = known[ 2 ] * inv;
+            u[ 2 ] = -known[ 1 ] * inv;
+        }
+        double const v[ 3 ] = { known[ 1 ] * u[ 2 ] - known[ 2 ] * u[ 1 ], // NOLINT curly braces
+                                known[ 2 ] * u[ 0 ] - known[ 0 ] * u[ 2 ],
+                                known[ 0 ] * u[ 1 ] - known[ 1 ] * u[ 0 ] };
+
+        double const au[ 3 ] = { a[ 0 ] * u[ 0 ] + a[ 1 ] * u[ 1 ] + a[ 2 ] * u[ 2 ], // NOLINT curly braces
+                                 a[ 1 ] * u[ 0 ] + a[ 3 ] * u[ 1 ] + a[ 4 ] * u[ 2 ],
+                                 a[ 2 ] * u[ 0 ] + a[ 4 ] * u[ 1 ] + a[ 5 ] * u[ 2 ] };
+        double const av[ 3 ] = { a[ 0 ] * v[ 0 ] + a[ 1 ] * v[ 1 ] + a[ 2 ] * v[ 2 ], // NOLINT curly braces
+                                 a[ 1 ] * v[ 0 ] + a[ 3 ] * v[ 1 ] + a[ 4 ] * v[ 2 ],
+                                 a[ 2 ] * v[ 0 ] + a[ 4 ] * v[ 1 ] + a[ 5 ] * v[ 2 ] };
+
+        // the 2x2 matrix ( m00 m01; m01 m11 ) is J^T ( A - eval * I ) J with J = ( u v )
+        double m00 = u[ 0 ] * au[ 0 ] + u[ 1 ] * au[ 1 ] + u[ 2 ] * au[ 2 ] - eval;
+        double m01 = u[ 0 ] * av[ 0 ] + u[ 1 ] * av[ 1 ] + u[ 2 ] * av[ 2 ];
+        double m11 = v[ 0 ] * av[ 0 ] + v[ 1 ] * av[ 1 ] + v[ 2 ] * av[ 2 ] - eval;
+
+        double const absM00 = std::fabs( m00 );
+        double const absM01 = std::fabs( m01 );
+        double const absM11 = std::fabs( m11 );
+
+        double su = 1.0;
+        double sv = 0.0;
+        if( absM00 >= absM11 )
+        {
+            if( std::max( absM00, absM01 ) > 0.0 )
+            {
+                if( absM00 >= absM01 )
+                {
+                    m01 /= m00;
+                    m00 = 1.0 / std::sqrt( 1.0 + m01 * m01 );
+                    m01 *= m00;
+                }
+                else
+                {
+                    m00 /= m01;
+                    m01 = 1.0 / std::sqrt( 1.0 + m00 * m00 );
+                    m00 *= m01;
+                }
+                su = m01;
+                sv = -m00;
+            }
+        }
+        else
+        {
+            if( std::max( absM11, absM01 ) > 0.0 )
+            {
+                if( absM11 >= absM01 )
+                {
+                    m01 /= m11;
+                    m11 = 1.0 / std::sqrt( 1.0 + m01 * m01 );
+                    m01 *= m11;
+                }
+                else
+                {
+                    m11 /= m01;
+                    m01 = 1.0 / std::sqrt( 1.0 + m11 * m11 );
+                    m11 *= m01;
+                }
+                su = m11;
+                sv = -m01;
+            }
+        }
+
+        evec[ 0 ] = su * u[ 0 ] + sv * v[ 0 ];
+        evec[ 1 ] = su * u[ 1 ] + sv * v[ 1 ];
+        evec[ 2 ] = su * u[ 2 ] + sv * v[ 2 ];
+    }
+
+    /**
+     * Computes the three eigenvectors of a scaled symmetric matrix whose eigenvalues are already known. The eigenvector
+     * of the best separated eigenvalue is computed first, the second one in its orthogonal complement and the last one
+     * as their cross product. This way, the result is orthonormal even for repeated eigenvalues.
+     *
+     * \param a The six unique matrix elements ( xx, xy, xz, yy, yz, zz ).
+     * \param eval The ascending eigenvalues.
+     * \param halfDet The value computed by eigenValues().
+     * \param evec The resulting eigenvectors, evec[ 3 * k + j ] is component j of the k-th eigenvector.
+     */
+    inline void eigenVectors( double const* a, double const* eval, double halfDet, double* evec )
+    {
+        std::size_t const first = halfDet >= 0.0 ? 2 : 0;
+        std::size_t const last = 2 - first;
+        eigenVectorOfSingleValue( a, eval[ first ], evec + 3 * first );
+        eigenVectorInComplement( a, evec + 3 * first, eval[ 1 ], evec + 3 );
+
+        double const* x = evec + 3 * first;
+        double const* y = evec + 3;
+        double* z = evec + 3 * last;
+        double const sign = first == 0 ? 1.0 : -1.0; // keep a right-handed system ( e0, e1, e2 )
+        z[ 0 ] = sign * ( x[ 1 ] * y[ 2 ] - x[ 2 ] * y[ 1 ] );
+        z[ 1 ] = sign * ( x[ 2 ] * y[ 0 ] - x[ 0 ] * y[ 2 ] );
+        z[ 2 ] = sign * ( x[ 0 ] * y[ 1 ] - x[ 1 ] * y[ 0 ] );
+    }
+} // namespace wtensoreigen
+
+/**
+ * Compute the eigen decomposition of many symmetric 3x3 tensors at once. The eigenvalues are computed analytically
+ * ( Cardano / trigonometric solution of the characteristic polynomial ), the eigenvectors by a non-iterative method
+ * that stays orthonormal for repeated eigenvalues. Tensors are processed in blocks of W_EIGEN_BATCH_LANES, which
+ * are gathered into structure-of-arrays registers, so the eigenvalue stage is free of branches and can be vectorized.
+ *
+ * The results match jacobiEigenvector3D() up to the sign of the eigenvectors. This function is not
+ * multi-threaded on its own, but different threads may process disjoint ranges of the same block concurrently.
+ *
+ * \tparam In_T The type of the tensor components, must be castable to double.
+ * \tparam Out_T The type of the results.
+ *
+ * \param begin The index of the first tensor to decompose.
+ * \param end One behind the index of the last tensor to decompose.
+ * \param tensors The tensors.
+ * \param result Where to put the eigenvalues and eigenvectors.
+ */
+template< typename In_T, typename Out_T >
+void cardanoEigenSystemBatch( std::size_t begin, std::size_t end,
+                              WTensorSymBlock< In_T > const& tensors, WEigenSystemBlock< Out_T > const& result )
+{
+    bool const wantVectors = result.m_vectors[ 0 ] || result.m_vectors[ 1 ] || result.m_vectors[ 2 ];
+
+    double a[ 6 ][ W_EIGEN_BATCH_LANES ];
+    double scale[ W_EIGEN_BATCH_LANES ];
+    double eval[ 3 ][ W_EIGEN_BATCH_LANES ];
+    double halfDet[ W_EIGEN_BATCH_LANES ];
+
+    for( std::size_t blockStart = begin; blockStart < end; blockStart += W_EIGEN_BATCH_LANES )
+    {
+        std::size_t const lanes = std::min( W_EIGEN_BATCH_LANES, end - blockStart );
+
+        // gather the block and pad it with zeros
+        for( std::size_t c = 0; c < 6; ++c )
+        {
+            In_T const* src = tensors.m_components[ c ] + blockStart * tensors.m_stride;
+            for( std::size_t l = 0; l < lanes; ++l )
+            {
+                a[ c ][ l ] = static_cast< double >( src[ l * tensors.m_stride ] );
+            }
+            for( std::size_t l = lanes; l < W_EIGEN_BATCH_LANES; ++l )
+            {
+                a[ c ][ l ] = 0.0;
+            }
+        }
+
+        // scale each tensor to unit max-norm to avoid over- and underflow in the polynomial coefficients
+        for( std::size_t l = 0; l < W_EIGEN_BATCH_LANES; ++l )
+        {
+            double m = std::fabs( a[ 0 ][ l ] );
+            for( std::size_t c = 1; c < 6; ++c )
+            {
+                m = std::max( m, std::fabs( a[ c ][ l ] ) );
+            }
+            scale[ l ] = m > 0.0 ? m : 1.0;
+            double const inv = 1.0 / scale[ l ];
+            for( std::size_t c = 0; c < 6; ++c )
+            {
+                a[ c ][ l ] *= inv;
+            }
+        }
+
+        for( std::size_t l = 0; l < W_EIGEN_BATCH_LANES; ++l )
+        {
+            double e[ 3 ];
+            wtensoreigen::eigenValues( a[ 0 ][ l ], a[ 1 ][ l ], a[ 2 ][ l ], a[ 3 ][ l ], a[ 4 ][ l ], a[ 5 ][ l ], e, &halfDet[ l ] );
+            eval[ 0 ][ l ] = e[ 0 ];
+            eval[ 1 ][ l ] = e[ 1 ];
+            eval[ 2 ][ l ] = e[ 2 ];
+        }
+
+        // scatter the results
+        for( std::size_t k = 0; k < 3; ++k )
+        {
+            if( result.m_values[ k ] )
+            {
+                Out_T* dst = result.m_values[ k ] + blockStart * result.m_valueStride;
+                for( std::size_t l = 0; l < lanes; ++l )
+                {
+                    dst[ l * result.m_valueStride ] = static_cast< Out_T >( eval[ k ][ l ] * scale[ l ] );
+                }
+            }
+        }
+
+        if( !wantVectors )
+        {
+            continue;
+        }
+
+        for( std::size_t l = 0; l < lanes; ++l )
+        {
+            double const m[ 6 ] = { a[ 0 ][ l ], a[ 1 ][ l ], a[ 2 ][ l ], a[ 3 ][ l ], a[ 4 ][ l ], a[ 5 ][ l ] }; // NOLINT curly braces
+            double const e[ 3 ] = { eval[ 0 ][ l ], eval[ 1 ][ l ], eval[ 2 ][ l ] }; // NOLINT curly braces
+            double v[ 9 ];
+            wtensoreigen::eigenVectors( m, e, halfDet[ l ], v );
+
+            for( std::size_t k = 0; k < 3; ++k )
+            {
+                if( result.m_vectors[ k ] )
+                {
+                    Out_T* dst = result.m_vectors[ k ] + ( blockStart + l ) * result.m_vectorStride;
+                    dst[ 0 ] = static_cast< Out_T >( v[ 3 * k + 0 ] );
+                    dst[ 1 ] = static_cast< Out_T >( v[ 3 * k + 1 ] );
+                    dst[ 2 ] = static_cast< Out_T >( v[ 3 * k + 2 ] );
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Compute all eigenvalues as well as the corresponding eigenvectors of a symmetric real matrix using the closed form
+ * solver of cardanoEigenSystemBatch(). The eigenvalues are sorted ascending, like the ones of jacobiEigenvector3D().
+ *
+ * \note Data_T must be castable to double.
+ *
+ * \param[in] mat A real symmetric matrix.
+ * \param[out] es A pointer to an RealEigenSystem.
+ */
+template< typename Data_T >
+void cardanoEigenvector3D( WTensorSym< 2, 3, Data_T > const& mat, RealEigenSystem* es )
+{
+    Data_T const c[ 6 ] = { mat( 0, 0 ), mat( 0, 1 ), mat( 0, 2 ), mat( 1, 1 ), mat( 1, 2 ), mat( 2, 2 ) }; // NOLINT curly braces
+    WTensorSymBlock< Data_T > in = { { c, c + 1, c + 2, c + 3, c + 4, c + 5 }, 6 }; // NOLINT curly braces
+
+    double values[ 3 ];
+    double vectors[ 9 ];
+    WEigenSystemBlock< double > out = { { values, values + 1, values + 2 }, 3, { vectors, vectors + 3, vectors + 6 }, 9 }; // NOLINT
+
+    cardanoEigenSystemBatch( 0, 1, in, out );
+
+    for( std::size_t k = 0; k < 3; ++k )
+    {
+        ( *es )[ k ].first = values[ k ];
+        ( *es )[ k ].second = WVector3d( vectors[ 3 * k ], vectors[ 3 * k + 1 ], vectors[ 3 * k + 2 ] );
+    }
+}
+
+#endif  // WTENSOREIGENBATCH_H
@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSYMMETRICSPHERICALHARMONICPLAN_TEST_H
+#define WSYMMETRICSPHERICALHARMONICPLAN_TEST_H
+
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WGeometryFunctions.h"
+#include "../WSymmetricSphericalHarmonic.h"
+#include "../WSymmetricSphericalHarmonicPlan.h"
+#include "../WUnitSphereCoordinates.h"
+#include "../WValue.h"
+
+/**
+ * Testsuite for WSymmetricSphericalHarmonicPlan.
+ */
+class WSymmetricSphericalHarmonicPlanTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup the directions and some coefficients.
+     */
+    void setUp()
+    {
+        std::vector< unsigned int > triangles;
+        std::vector< WVector3d > vertices;
+        tesselateIcosahedron( &vertices, &triangles, 2 );
+
+        m_directions.clear();
+        for( std::size_t k = 0; k < vertices.size(); ++k )
+        {
+            m_directions.push_back( WUnitSphereCoordinates< double >( vertices[ k ] ) );
+        }
+
+        m_coefficients.resize( 3 * 15 );
+        for( std::size_t k = 0; k < m_coefficients.size(); ++k )
+        {
+            m_coefficients[ k ] = 1.0 / ( 1.0 + k ) - 0.05 * ( k % 4 );
+        }
+    }
+
+    /**
+     * The base matrix must be the same as the one computed by WSymmetricSphericalHarmonic.
+     */
+    void testMatchesBaseMatrix()
+    {
+        WSymmetricSphericalHarmonicPlan< double > plan( m_directions, 4 );
+        WMatrix< double > B = WSymmetricSphericalHarmonic< double >::calcBaseMatrix( m_directions, 4 );
+
+        TS_ASSERT_EQUALS( plan.getNbDirections(), m_directions.size() );
+        TS_ASSERT_EQUALS( plan.getNbCoefficients(), 15 );
+
+        std::vector< double > values( plan.getNbDirections() );
+        std::vector< double > unit( 15, 0.0 );
+        for( std::size_t j = 0; j < 15; ++j )
+        {
+            unit.assign( 15, 0.0 );
+            unit[ j ] = 1.0;
+            plan.evaluate( &unit[ 0 ], &values[ 0 ] );
+            for( std::size_t i = 0; i < values.size(); ++i )
+            {
+                TS_ASSERT_DELTA( values[ i ], B( i, j ), 1e-12 );
+            }
+        }
+    }
+
+    /**
+     * Batched evaluation must give the same values as WSymmetricSphericalHarmonic::getValue.
+     */
+    void testBatchedEvaluation()
+    {
+        WSymmetricSphericalHarmonicPlan< double > plan( m_directions, 2 );
+        std::size_t const n = plan.getNbDirections();
+        std::vector< double > values( 3 * n );
+
+        // use a stride of 15 to evaluate only the order 2 part of order 4 coefficients
+        plan.evaluate( &m_coefficients[ 0 ], 3, 15, &values[ 0 ] );
+
+        for( std::size_t v = 0; v < 3; ++v )
+        {
+            WValue< double > c( 6 );
+            for( std::size_t k = 0; k < 6; ++k )
+            {
+                c[ k ] = m_coefficients[ 15 * v + k ];
+            }
+            WSymmetricSphericalHarmonic< double > sh( c );
+            for( std::size_t i = 0; i < n; ++i )
+            {
+                TS_ASSERT_DELTA( values[ v * n + i ], sh.getValue( m_directions[ i ] ), 1e-12 );
+            }
+        }
+    }
+
+    /**
+     * The gfa must be the same as the one of WSymmetricSphericalHarmonic.
+     */
+    void testGFA()
+    {
+        std::shared_ptr< WSymmetricSphericalHarmonicPlan< double > const > plan =
+            WSymmetricSphericalHarmonicPlan< double >::getPlan( m_directions, 4 );
+
+        WValue< double > c( 15 );
+        for( std::size_t k = 0; k < 15; ++k )
+        {
+            c[ k ] = m_coefficients[ k ];
+        }
+        WSymmetricSphericalHarmonic< double > sh( c );
+        TS_ASSERT_DELTA( plan->calcGFA( &m_coefficients[ 0 ] ), sh.calcGFA( m_directions ), 1e-9 );
+    }
+
+    /**
+     * Plans for the same parameters are shared.
+     */
+    void testCache()
+    {
+        std::shared_ptr< WSymmetricSphericalHarmonicPlan< double > const > a = WSymmetricSphericalHarmonicPlan< double >::getPlan( m_directions, 4 );
+        std::shared_ptr< WSymmetricSphericalHarmonicPlan< double > const > b = WSymmetricSphericalHarmonicPlan< double >::getPlan( m_directions, 4 );
+        std::shared_ptr< WSymmetricSphericalHarmonicPlan< double > const > c = WSymmetricSphericalHarmonicPlan< double >::getPlan( m_directions, 2 );
+        TS_ASSERT_EQUALS( a, b );
+        TS_ASSERT_DIFFERS( a, c );
+        TS_ASSERT_EQUALS( c->getOrder(), 2 );
+    }
+
+private:
+    //! the directions to evaluate at
+    std::vector< WUnitSphereCoordinates< double > > m_directions;
+
+    //! coefficients of three order 4 spherical harmonics
+    std::vector< double > m_coefficients;
+};
+
+#endif  // WSYMMETRICSPHERICALHARMONICPLAN_TEST_H
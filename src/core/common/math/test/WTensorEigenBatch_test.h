@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WTENSOREIGENBATCH_TEST_H
+#define WTENSOREIGENBATCH_TEST_H
+
+#include <cstdlib>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WTensorEigenBatch.h"
+
+/**
+ * Test the batched closed form eigen decomposition against the Jacobi solver.
+ */
+class WTensorEigenBatchTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Diagonal and degenerate matrices should be decomposed into orthonormal systems.
+     */
+    void testDegenerateMatrices()
+    {
+        WTensorSym< 2, 3 > t;
+        RealEigenSystem sys;
+
+        t( 0, 0 ) = 1.0;
+        t( 1, 1 ) = 2.0;
+        t( 2, 2 ) = 3.0;
+        cardanoEigenvector3D( t, &sys );
+        TS_ASSERT_DELTA( sys[ 0 ].first, 1.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 1 ].first, 2.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 2 ].first, 3.0, 1e-9 );
+        assertOrthonormal( sys );
+
+        t( 2, 2 ) = 2.0;
+        cardanoEigenvector3D( t, &sys );
+        TS_ASSERT_DELTA( sys[ 0 ].first, 1.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 1 ].first, 2.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 2 ].first, 2.0, 1e-9 );
+        assertOrthonormal( sys );
+
+        t( 0, 0 ) = t( 1, 1 ) = t( 2, 2 ) = -1.0;
+        cardanoEigenvector3D( t, &sys );
+        TS_ASSERT_DELTA( sys[ 0 ].first, -1.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 1 ].first, -1.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 2 ].first, -1.0, 1e-9 );
+        assertOrthonormal( sys );
+
+        t( 0, 0 ) = t( 1, 1 ) = t( 2, 2 ) = 0.0;
+        cardanoEigenvector3D( t, &sys );
+        TS_ASSERT_DELTA( sys[ 0 ].first, 0.0, 1e-9 );
+        TS_ASSERT_DELTA( sys[ 2 ].first, 0.0, 1e-9 );
+        assertOrthonormal( sys );
+    }
+
+    /**
+     * The results should match the Jacobi solver for random, DTI-scaled tensors.
+     */
+    void testAgainstJacobi()
+    {
+        std::srand( 42 );
+        for( std::size_t i = 0; i < 1000; ++i )
+        {
+            WTensorSym< 2, 3 > t;
+            for( std::size_t j = 0; j < 3; ++j )
+            {
+                for( std::size_t k = j; k < 3; ++k )
+                {
+                    t( j, k ) = 1e-3 * ( 2.0 * std::rand() / RAND_MAX - 1.0 );
+                }
+            }
+
+            RealEigenSystem jacobi;
+            RealEigenSystem cardano;
+            jacobiEigenvector3D( t, &jacobi );
+            cardanoEigenvector3D( t, &cardano );
+
+            for( std::size_t k = 0; k < 3; ++k )
+            {
+                TS_ASSERT_DELTA( cardano[ k ].first, jacobi[ k ].first, 1e-9 );
+                // eigenvectors may differ in sign only
+                TS_ASSERT_DELTA( std::fabs( dot( cardano[ k ].second, jacobi[ k ].second ) ), 1.0, 1e-4 );
+            }
+            assertOrthonormal( cardano );
+        }
+    }
+
+    /**
+     * Interleaved input ( as stored in WDataSetDTI ) and separate output arrays, only some of them requested.
+     */
+    void testStridedBatch()
+    {
+        std::size_t const n = 37; // not a multiple of the lane count
+        std::vector< float > dti( 6 * n );
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            dti[ 6 * i + 0 ] = 1.0f + i;
+            dti[ 6 * i + 1 ] = 0.5f;
+            dti[ 6 * i + 3 ] = 2.0f;
+            dti[ 6 * i + 4 ] = -0.25f * i;
+            dti[ 6 * i + 5 ] = 3.0f;
+        }
+        std::vector< double > largest( n, -1.0 );
+        std::vector< double > principal( 3 * n, 0.0 );
+
+        WTensorSymBlock< float > in = { { &dti[ 0 ], &dti[ 1 ], &dti[ 2 ], &dti[ 3 ], &dti[ 4 ], &dti[ 5 ] }, 6 }; // NOLINT curly braces
+        WEigenSystemBlock< double > out = { { NULL, NULL, &largest[ 0 ] }, 1, { NULL, NULL, &principal[ 0 ] }, 3 }; // NOLINT curly braces
+        cardanoEigenSystemBatch( 1, n, in, out );
+
+        // the first tensor was not requested
+        TS_ASSERT_EQUALS( largest[ 0 ], -1.0 );
+        for( std::size_t i = 1; i < n; ++i )
+        {
+            WTensorSym< 2, 3 > t;
+            t( 0, 0 ) = dti[ 6 * i + 0 ];
+            t( 0, 1 ) = dti[ 6 * i + 1 ];
+            t( 0, 2 ) = dti[ 6 * i + 2 ];
+            t( 1, 1 ) = dti[ 6 * i + 3 ];
+            t( 1, 2 ) = dti[ 6 * i + 4 ];
+            t( 2, 2 ) = dti[ 6 * i + 5 ];
+            RealEigenSystem jacobi;
+            jacobiEigenvector3D( t, &jacobi );
+
+            TS_ASSERT_DELTA( largest[ i ], jacobi[ 2 ].first, 1e-6 * std::fabs( jacobi[ 2 ].first ) );
+            WVector3d v( principal[ 3 * i ], principal[ 3 * i + 1 ], principal[ 3 * i + 2 ] );
+            TS_ASSERT_DELTA( std::fabs( dot( v, jacobi[ 2 ].second ) ), 1.0, 1e-6 );
+        }
+    }
+
+private:
+    /**
+     * Checks that the eigenvectors are normalized and pairwise orthogonal.
+     *
+     * \param sys The eigensystem.
+     */
+    void assertOrthonormal( RealEigenSystem const& sys )
+    {
+        TS_ASSERT_DELTA( dot( sys[ 0 ].second, sys[ 1 ].second ), 0.0, 1e-9 );
+        TS_ASSERT_DELTA( dot( sys[ 1 ].second, sys[ 2 ].second ), 0.0, 1e-9 );
+        TS_ASSERT_DELTA( dot( sys[ 2 ].second, sys[ 0 ].second ), 0.0, 1e-9 );
+        TS_ASSERT_DELTA( length( sys[ 0 ].second ), 1.0, 1e-9 );
+        TS_ASSERT_DELTA( length( sys[ 1 ].second ), 1.0, 1e-9 );
+        TS_ASSERT_DELTA( length( sys[ 2 ].second ), 1.0, 1e-9 );
+    }
+};
+
+#endif  // WTENSOREIGENBATCH_TEST_H
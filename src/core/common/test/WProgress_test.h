@@ -29,7 +29,9 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "../WCancelToken.h"
 #include "../WProgress.h"
+#include "../exceptions/WComputationCancelled.h"
 
 /**
  * Test Class for the base progress class.
@@ -123,6 +125,27 @@ public:
         TS_ASSERT( p.m_count == 0 );
         TS_ASSERT( p.getProgress() == 0.0 );
     }
+
+    /**
+     * Incrementing throws after the token got cancelled and finishes the progress.
+     */
+    void testCancelToken()
+    {
+        WProgress p( "Test", 11 );
+        WCancelToken::SPtr token( new WCancelToken() );
+        p.setCancelToken( token );
+
+        TS_ASSERT_THROWS_NOTHING( ++p );
+        TS_ASSERT( p.isPending() );
+
+        token->cancel();
+        TS_ASSERT_THROWS( ++p, const WComputationCancelled& );
+        TS_ASSERT( !p.isPending() );
+
+        // without a token nothing gets checked
+        p.setCancelToken( WCancelToken::ConstSPtr() );
+        TS_ASSERT_THROWS_NOTHING( p.increment( 1 ) );
+    }
 };
 
 #endif  // WPROGRESS_TEST_H
@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WRECOMPUTESCHEDULER_TEST_H
+#define WRECOMPUTESCHEDULER_TEST_H
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WCondition.h"
+#include "../WRecomputeScheduler.h"
+
+/**
+ * Tests for WRecomputeScheduler.
+ */
+class WRecomputeSchedulerTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Requests, from the scheduler itself or from added conditions, cancel the current computation.
+     */
+    void testRequestCancels()
+    {
+        WRecomputeScheduler scheduler( std::chrono::milliseconds( 0 ) );
+        WCondition::SPtr dataChanged( new WCondition() );
+        scheduler.add( dataChanged );
+        TS_ASSERT( !scheduler.isRequested() );
+
+        scheduler.requestRecompute();
+        TS_ASSERT( scheduler.isRequested() );
+        WCancelToken::SPtr first = scheduler.start();
+        TS_ASSERT( !scheduler.isRequested() );
+        TS_ASSERT( !first->isCancelled() );
+
+        dataChanged->notify();
+        TS_ASSERT( scheduler.isRequested() );
+        TS_ASSERT( first->isCancelled() );
+
+        WCancelToken::SPtr second = scheduler.start();
+        TS_ASSERT( !second->isCancelled() );
+
+        // properties notify the condition of the scheduler
+        scheduler.getCondition()->notify();
+        TS_ASSERT( second->isCancelled() );
+    }
+
+    /**
+     * start() waits until no request arrived for the quiet period.
+     */
+    void testDebounce()
+    {
+        WRecomputeScheduler scheduler( std::chrono::milliseconds( 100 ) );
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        std::thread requests( [ &scheduler ]()
+        {
+            for( int i = 0; i < 5; ++i )
+            {
+                scheduler.requestRecompute();
+                std::this_thread::sleep_for( std::chrono::milliseconds( 40 ) );
+            }
+        } );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        WCancelToken::SPtr token = scheduler.start();
+        requests.join();
+
+        // the last request came after about 160ms, start() returns 100ms later
+        TS_ASSERT( std::chrono::steady_clock::now() - begin >= std::chrono::milliseconds( 260 ) );
+        TS_ASSERT( !token->isCancelled() );
+        TS_ASSERT( !scheduler.isRequested() );
+    }
+
+    /**
+     * stop() cancels the current computation, releases start() and cancels all further ones.
+     */
+    void testStop()
+    {
+        WRecomputeScheduler scheduler( std::chrono::hours( 1 ) );
+        WCancelToken::SPtr token;
+        scheduler.requestRecompute();
+        std::thread worker( [ &scheduler, &token ]()
+        {
+            token = scheduler.start();
+        } );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        scheduler.stop();
+        worker.join();
+
+        TS_ASSERT( scheduler.isStopped() );
+        TS_ASSERT( token->isCancelled() );
+        TS_ASSERT( scheduler.start()->isCancelled() );
+    }
+};
+
+#endif  // WRECOMPUTESCHEDULER_TEST_H
@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WSHAREDOBJECT_TEST_H
+#define WSHAREDOBJECT_TEST_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WSharedObject.h"
+#include "../WSharedSequenceContainer.h"
+
+/**
+ * Counts its living instances.
+ */
+struct WCountedValue
+{
+    /**
+     * Constructor.
+     */
+    WCountedValue()
+    {
+        ++m_alive;
+    }
+
+    /**
+     * Copy constructor.
+     */
+    WCountedValue( const WCountedValue& )
+    {
+        ++m_alive;
+    }
+
+    /**
+     * Destructor.
+     */
+    ~WCountedValue()
+    {
+        --m_alive;
+    }
+
+    //! the number of instances
+    static std::atomic< int > m_alive;
+};
+
+std::atomic< int > WCountedValue::m_alive( 0 );
+
+/**
+ * Test WSharedObject and its snapshots.
+ */
+class WSharedObjectTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Without snapshots enabled, the snapshot is a locked view of the object.
+     */
+    void testLockedSnapshot( void )
+    {
+        WSharedSequenceContainer< std::vector< int > > container;
+        TS_ASSERT( !container.hasSnapshots() );
+        container.push_back( 1 );
+        container.push_back( 2 );
+        {
+            WSharedSequenceContainer< std::vector< int > >::Snapshot s = container.getSnapshot();
+            TS_ASSERT_EQUALS( s->size(), 2 );
+            TS_ASSERT_EQUALS( ( *s )[ 1 ], 2 );
+        }
+        container.push_back( 2 );
+        TS_ASSERT_EQUALS( container.size(), 3 );
+        TS_ASSERT_EQUALS( container.count( 2 ), 2 );
+    }
+
+    /**
+     * A snapshot keeps showing the version it was taken from and does not block writers.
+     */
+    void testSnapshotIsolation( void )
+    {
+        WSharedSequenceContainer< std::vector< int > > container;
+        container.push_back( 1 );
+        container.enableSnapshots();
+        TS_ASSERT( container.hasSnapshots() );
+
+        WSharedSequenceContainer< std::vector< int > >::Snapshot before = container.getSnapshot();
+        TS_ASSERT_EQUALS( before->size(), 1 );
+
+        // would deadlock with a locked view
+        container.push_back( 2 );
+        container.push_back( 3 );
+
+        TS_ASSERT_EQUALS( before->size(), 1 );
+        TS_ASSERT_EQUALS( container.size(), 3 );
+        TS_ASSERT_EQUALS( container.getSnapshot()->back(), 3 );
+
+        // the read tickets see the same data
+        TS_ASSERT_EQUALS( container.getReadTicket()->get().size(), 3 );
+
+        // copies publish snapshots too
+        WSharedSequenceContainer< std::vector< int > > copy( container );
+        TS_ASSERT( copy.hasSnapshots() );
+        TS_ASSERT_EQUALS( copy.size(), 3 );
+    }
+
+    /**
+     * Replaced versions are deleted as soon as no snapshot can refer to them anymore.
+     */
+    void testReclamation( void )
+    {
+        TS_ASSERT_EQUALS( WCountedValue::m_alive, 0 );
+        {
+            WSharedObject< WCountedValue > object;
+            object.enableSnapshots();
+            TS_ASSERT_EQUALS( WCountedValue::m_alive, 2 );
+
+            // nobody reads, the replaced versions vanish right away
+            for( int i = 0; i < 10; ++i )
+            {
+                object.getWriteTicket();
+            }
+            TS_ASSERT_EQUALS( WCountedValue::m_alive, 2 );
+
+            // a snapshot keeps the versions replaced while it exists
+            {
+                WSharedObject< WCountedValue >::Snapshot s = object.getSnapshot();
+                for( int i = 0; i < 10; ++i )
+                {
+                    object.getWriteTicket();
+                }
+                TS_ASSERT( WCountedValue::m_alive > 2 );
+            }
+            object.getWriteTicket();
+            object.getWriteTicket();
+            TS_ASSERT_EQUALS( WCountedValue::m_alive, 2 );
+        }
+        TS_ASSERT_EQUALS( WCountedValue::m_alive, 0 );
+    }
+
+    /**
+     * Readers running concurrently with a writer always see consistent versions.
+     */
+    void testConcurrentReaders( void )
+    {
+        WSharedSequenceContainer< std::vector< std::size_t > > container;
+        container.enableSnapshots();
+        std::atomic< bool > done( false );
+        std::atomic< std::size_t > inconsistent( 0 );
+
+        // every version contains its size in all elements
+        std::vector< std::thread > readers;
+        for( std::size_t t = 0; t < 4; ++t )
+        {
+            readers.push_back( std::thread( [ & ]()
+                {
+                    while( !done )
+                    {
+                        WSharedSequenceContainer< std::vector< std::size_t > >::Snapshot s = container.getSnapshot();
+                        for( std::size_t i = 0; i < s->size(); ++i )
+                        {
+                            if( ( *s )[ i ] != s->size() )
+                            {
+                                ++inconsistent;
+                            }
+                        }
+                    }
+                } ) );
+        }
+
+        for( std::size_t n = 1; n <= 500; ++n )
+        {
+            WSharedSequenceContainer< std::vector< std::size_t > >::WriteTicket w = container.getWriteTicket();
+            w->get().assign( n, n );
+        }
+        done = true;
+        for( std::size_t t = 0; t < readers.size(); ++t )
+        {
+            readers[ t ].join();
+        }
+
+        TS_ASSERT_EQUALS( inconsistent, 0 );
+        TS_ASSERT_EQUALS( container.getSnapshot()->size(), 500 );
+    }
+};
+
+#endif  // WSHAREDOBJECT_TEST_H
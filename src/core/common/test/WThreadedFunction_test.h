@@ -218,6 +218,32 @@ public:
         func->reset();
     }
 
+    /**
+     * Cancelling the token stops the threads, a token cancelled before run() stops them right away.
+     */
+    void testCancelToken()
+    {
+        std::shared_ptr< FuncType > func( new FuncType( 100000000 ) );
+        WThreadedFunction< FuncType > f( 6, func );
+
+        WCancelToken::SPtr token( new WCancelToken() );
+        f.setCancelToken( token );
+        f.run();
+        TS_ASSERT_EQUALS( f.status(), W_THREADS_RUNNING );
+        token->cancel();
+        TS_ASSERT_EQUALS( f.status(), W_THREADS_STOP_REQUESTED );
+        f.wait();
+        TS_ASSERT_EQUALS( f.status(), W_THREADS_ABORTED );
+        TS_ASSERT( func->stopped() );
+
+        // the token stays cancelled
+        f.run();
+        TS_ASSERT_EQUALS( f.status(), W_THREADS_STOP_REQUESTED );
+        f.wait();
+        TS_ASSERT_EQUALS( f.status(), W_THREADS_ABORTED );
+        func->reset();
+    }
+
     /**
      * The stop condition should be notified correctly.
      */
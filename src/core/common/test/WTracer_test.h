@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WTRACER_TEST_H
+#define WTRACER_TEST_H
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WTracer.h"
+
+/**
+ * Tests for WTracer.
+ */
+class WTracerTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Start every test without events.
+     */
+    void setUp()
+    {
+        WTracer::setEnabled( false );
+        WTracer::clear();
+    }
+
+    /**
+     * Do not leave tracing enabled for other tests.
+     */
+    void tearDown()
+    {
+        WTracer::setEnabled( false );
+        WTracer::clear();
+        WTracer::setBufferSize( 1 << 15 );
+    }
+
+    /**
+     * Nothing gets recorded while disabled.
+     */
+    void testDisabled()
+    {
+        {
+            WTRACE_SCOPE( "disabled" );
+            WTRACE_SCOPE_DYNAMIC( std::string( "dynamic" ) );
+            WTracer::counter( "counter", 1.0 );
+            WTracer::asyncBegin( "async", 1 );
+            WTracer::instant( "instant" );
+        }
+        TS_ASSERT_EQUALS( WTracer::getNumEvents(), 0 );
+    }
+
+    /**
+     * All event types end up in the exported trace.
+     */
+    void testExport()
+    {
+        WTracer::setEnabled( true );
+        WTracer::setThreadName( "Test \"thread\"" );
+        {
+            WTRACE_SCOPE( "scope" );
+            WTRACE_SCOPE_DYNAMIC( std::string( "dyn" ) + "amic" );
+            WTracer::counter( "counter", 2.5 );
+            WTracer::asyncBegin( "async", 0xab );
+            WTracer::asyncEnd( "async", 0xab );
+            WTracer::instant( "instant" );
+        }
+        TS_ASSERT_EQUALS( WTracer::getNumEvents(), 6 );
+
+        std::ostringstream out;
+        WTracer::writeChromeTrace( out );
+        std::string const json = out.str();
+        TS_ASSERT( json.find( "\"traceEvents\"" ) != std::string::npos );
+        TS_ASSERT( json.find( "{\"name\":\"Test \\\"thread\\\"\"}" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"name\":\"scope\",\"cat\":\"openwalnut\",\"ph\":\"X\"" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"name\":\"dynamic\"" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"args\":{\"value\":2.5}" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"ph\":\"b\"" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"id\":\"0xab\"" ) != std::string::npos );
+        TS_ASSERT( json.find( "\"ph\":\"i\"" ) != std::string::npos );
+
+        WTracer::setThreadName( "" );
+    }
+
+    /**
+     * Interned names are stored once.
+     */
+    void testIntern()
+    {
+        char const* a = WTracer::intern( "name" );
+        char const* b = WTracer::intern( std::string( "na" ) + "me" );
+        TS_ASSERT_EQUALS( a, b );
+        TS_ASSERT_EQUALS( std::string( a ), "name" );
+    }
+
+    /**
+     * Full buffers overwrite the oldest events and every thread has its own buffer.
+     */
+    void testRingBuffers()
+    {
+        WTracer::setBufferSize( 10 );
+        WTracer::setEnabled( true );
+
+        std::vector< std::thread > threads;
+        for( std::size_t i = 0; i < 4; ++i )
+        {
+            threads.push_back( std::thread( []()
+                {
+                    for( std::size_t k = 0; k < 100; ++k )
+                    {
+                        WTRACE_SCOPE( "worker" );
+                    }
+                } ) );
+        }
+        for( std::size_t i = 0; i < threads.size(); ++i )
+        {
+            threads[ i ].join();
+        }
+        TS_ASSERT_EQUALS( WTracer::getNumEvents(), 40 );
+
+        // finished threads are removed on clear
+        WTracer::clear();
+        TS_ASSERT_EQUALS( WTracer::getNumEvents(), 0 );
+        std::ostringstream out;
+        WTracer::writeChromeTrace( out );
+        TS_ASSERT( out.str().find( "worker" ) == std::string::npos );
+    }
+};
+
+#endif  // WTRACER_TEST_H
@@ -0,0 +1,265 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../common/WAssert.h"
+#include "WCSVColumn.h"
+
+WCSVColumn::TypeDetector::TypeDetector()
+    : m_integral( true ),
+      m_numeric( true ),
+      m_anyNumber( false ),
+      m_anyMissing( false )
+{
+}
+
+void WCSVColumn::TypeDetector::add( char const* begin, char const* end )
+{
+    if( !m_numeric )
+    {
+        // nothing can change the type of a string column
+        return;
+    }
+    if( isMissingValue( begin, end ) )
+    {
+        m_anyMissing = true;
+        return;
+    }
+
+    double value;
+    if( !parseNumber( begin, end, &value ) )
+    {
+        m_numeric = false;
+        return;
+    }
+    m_anyNumber = true;
+    if( m_integral && !( std::floor( value ) == value && value >= std::numeric_limits< std::int32_t >::min()
+                                                      && value <= std::numeric_limits< std::int32_t >::max() ) )
+    {
+        m_integral = false;
+    }
+}
+
+void WCSVColumn::TypeDetector::merge( TypeDetector const& other )
+{
+    m_integral = m_integral && other.m_integral;
+    m_numeric = m_numeric && other.m_numeric;
+    m_anyNumber = m_anyNumber || other.m_anyNumber;
+    m_anyMissing = m_anyMissing || other.m_anyMissing;
+}
+
+WCSVColumn::ColumnType WCSVColumn::TypeDetector::getType() const
+{
+    if( !m_numeric || !m_anyNumber )
+    {
+        return COLUMN_STRING;
+    }
+    // missing values are stored as NaN, so they need a double column
+    if( m_integral && !m_anyMissing )
+    {
+        return COLUMN_INT;
+    }
+    return COLUMN_DOUBLE;
+}
+
+WCSVColumn::WCSVColumn( std::string const& name, ColumnType type, std::size_t size )
+    : m_name( name ),
+      m_type( type ),
+      m_size( size )
+{
+    switch( type )
+    {
+        case COLUMN_INT:
+            m_ints.resize( size );
+            break;
+        case COLUMN_DOUBLE:
+            m_doubles.resize( size );
+            break;
+        default:
+            m_codes.resize( size );
+            break;
+    }
+}
+
+WCSVColumn::~WCSVColumn()
+{
+}
+
+std::string const& WCSVColumn::getName() const
+{
+    return m_name;
+}
+
+WCSVColumn::ColumnType WCSVColumn::getType() const
+{
+    return m_type;
+}
+
+std::size_t WCSVColumn::size() const
+{
+    return m_size;
+}
+
+void WCSVColumn::setNumber( std::size_t row, char const* begin, char const* end )
+{
+    WAssert( row < m_size, "Row index out of range." );
+
+    double value = std::numeric_limits< double >::quiet_NaN();
+    if( !parseNumber( begin, end, &value ) )
+    {
+        value = std::numeric_limits< double >::quiet_NaN();
+    }
+
+    if( m_type == COLUMN_INT )
+    {
+        m_ints[ row ] = static_cast< std::int32_t >( value );
+    }
+    else
+    {
+        WAssert( m_type == COLUMN_DOUBLE, "Cannot store numbers in a string column." );
+        m_doubles[ row ] = value;
+    }
+}
+
+std::int32_t* WCSVColumn::getInts()
+{
+    return m_ints.empty() ? NULL : &m_ints[ 0 ];
+}
+
+std::int32_t const* WCSVColumn::getInts() const
+{
+    return m_ints.empty() ? NULL : &m_ints[ 0 ];
+}
+
+double* WCSVColumn::getDoubles()
+{
+    return m_doubles.empty() ? NULL : &m_doubles[ 0 ];
+}
+
+double const* WCSVColumn::getDoubles() const
+{
+    return m_doubles.empty() ? NULL : &m_doubles[ 0 ];
+}
+
+std::uint32_t* WCSVColumn::getCodes()
+{
+    return m_codes.empty() ? NULL : &m_codes[ 0 ];
+}
+
+std::uint32_t const* WCSVColumn::getCodes() const
+{
+    return m_codes.empty() ? NULL : &m_codes[ 0 ];
+}
+
+std::vector< std::string > const& WCSVColumn::getDictionary() const
+{
+    return m_dictionary;
+}
+
+void WCSVColumn::setDictionary( std::vector< std::string >* dictionary )
+{
+    m_dictionary.swap( *dictionary );
+    dictionary->clear();
+}
+
+double WCSVColumn::getNumber( std::size_t row ) const
+{
+    switch( m_type )
+    {
+        case COLUMN_INT:
+            return m_ints[ row ];
+        case COLUMN_DOUBLE:
+            return m_doubles[ row ];
+        default:
+            return std::numeric_limits< double >::quiet_NaN();
+    }
+}
+
+bool WCSVColumn::isMissing( std::size_t row ) const
+{
+    switch( m_type )
+    {
+        case COLUMN_INT:
+            return false;
+        case COLUMN_DOUBLE:
+            return std::isnan( m_doubles[ row ] );
+        default:
+        {
+            std::string const& s = m_dictionary[ m_codes[ row ] ];
+            return isMissingValue( s.data(), s.data() + s.size() );
+        }
+    }
+}
+
+std::string WCSVColumn::getString( std::size_t row ) const
+{
+    char buffer[ 64 ];
+    std::to_chars_result result;
+    switch( m_type )
+    {
+        case COLUMN_INT:
+            result = std::to_chars( buffer, buffer + sizeof( buffer ), m_ints[ row ] );
+            return std::string( buffer, result.ptr );
+        case COLUMN_DOUBLE:
+            if( std::isnan( m_doubles[ row ] ) )
+            {
+                return "NULL";
+            }
+            result = std::to_chars( buffer, buffer + sizeof( buffer ), m_doubles[ row ] );
+            return std::string( buffer, result.ptr );
+        default:
+            return m_dictionary[ m_codes[ row ] ];
+    }
+}
+
+bool WCSVColumn::parseNumber( char const* begin, char const* end, double* value )
+{
+    // std::from_chars does not accept an explicit plus sign
+    if( begin != end && *begin == '+' )
+    {
+        ++begin;
+        if( begin == end || *begin == '-' )
+        {
+            return false;
+        }
+    }
+    if( begin == end )
+    {
+        return false;
+    }
+
+    std::from_chars_result result = std::from_chars( begin, end, *value );
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool WCSVColumn::isMissingValue( char const* begin, char const* end )
+{
+    return begin == end || ( end - begin == 4 && std::memcmp( begin, "NULL", 4 ) == 0 );
+}
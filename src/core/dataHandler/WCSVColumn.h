@@ -0,0 +1,280 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCSVCOLUMN_H
+#define WCSVCOLUMN_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A typed column of a CSV file. Numeric columns store their values in a plain array, columns containing text store an
+ * index into a dictionary of the distinct strings of the column. This needs far less memory than one string per cell
+ * and allows reading whole columns without any conversion.
+ */
+class WCSVColumn
+{
+public:
+    /**
+     * Shared pointer to a column.
+     */
+    typedef std::shared_ptr< WCSVColumn > SPtr;
+
+    /**
+     * Shared pointer to a const column.
+     */
+    typedef std::shared_ptr< WCSVColumn const > ConstSPtr;
+
+    /**
+     * The possible types of a column.
+     */
+    enum ColumnType
+    {
+        COLUMN_INT,     //!< all cells are integral numbers fitting into 32 bit
+        COLUMN_DOUBLE,  //!< all cells are numbers or missing values, stored as double, missing values are NaN
+        COLUMN_STRING   //!< at least one cell is not a number, cells are stored as dictionary codes
+    };
+
+    /**
+     * Collects which kinds of values were found in the cells of a column to determine the type of the column.
+     * Detectors for different parts of a column can be merged.
+     */
+    class TypeDetector
+    {
+    public:
+        /**
+         * Constructor. Without any cells, the column is a string column.
+         */
+        TypeDetector();
+
+        /**
+         * Look at another cell.
+         *
+         * \param begin The first character of the cell.
+         * \param end One past the last character of the cell.
+         */
+        void add( char const* begin, char const* end );
+
+        /**
+         * Merge the findings of another detector into this one.
+         *
+         * \param other The other detector.
+         */
+        void merge( TypeDetector const& other );
+
+        /**
+         * The type of a column made of all cells seen so far.
+         *
+         * \return The column type.
+         */
+        ColumnType getType() const;
+
+    private:
+        //! true if all non-missing cells were integral numbers
+        bool m_integral;
+
+        //! true if all non-missing cells were numbers
+        bool m_numeric;
+
+        //! true if at least one number was found
+        bool m_anyNumber;
+
+        //! true if at least one missing value was found
+        bool m_anyMissing;
+    };
+
+    /**
+     * Constructor. Allocates storage for all cells of the column.
+     *
+     * \param name The name of the column.
+     * \param type The type of the column.
+     * \param size The number of rows.
+     */
+    WCSVColumn( std::string const& name, ColumnType type, std::size_t size );
+
+    /**
+     * Destructor.
+     */
+    ~WCSVColumn();
+
+    /**
+     * The name of the column as given in the header.
+     *
+     * \return The name.
+     */
+    std::string const& getName() const;
+
+    /**
+     * The type of the column.
+     *
+     * \return The type.
+     */
+    ColumnType getType() const;
+
+    /**
+     * The number of rows.
+     *
+     * \return The number of rows.
+     */
+    std::size_t size() const;
+
+    /**
+     * Parse a cell of a numeric column and store the value. Different rows may be set from different threads.
+     *
+     * \param row The row of the cell.
+     * \param begin The first character of the cell.
+     * \param end One past the last character of the cell.
+     */
+    void setNumber( std::size_t row, char const* begin, char const* end );
+
+    /**
+     * The values of an int column.
+     *
+     * \return size() values or NULL if this is not an int column.
+     */
+    std::int32_t* getInts();
+
+    /**
+     * The values of an int column.
+     *
+     * \return size() values or NULL if this is not an int column.
+     */
+    std::int32_t const* getInts() const;
+
+    /**
+     * The values of a double column.
+     *
+     * \return size() values or NULL if this is not a double column.
+     */
+    double* getDoubles();
+
+    /**
+     * The values of a double column.
+     *
+     * \return size() values or NULL if this is not a double column.
+     */
+    double const* getDoubles() const;
+
+    /**
+     * The dictionary codes of a string column.
+     *
+     * \return size() codes or NULL if this is not a string column.
+     */
+    std::uint32_t* getCodes();
+
+    /**
+     * The dictionary codes of a string column.
+     *
+     * \return size() codes or NULL if this is not a string column.
+     */
+    std::uint32_t const* getCodes() const;
+
+    /**
+     * The distinct strings of a string column, indexed by the codes.
+     *
+     * \return The dictionary.
+     */
+    std::vector< std::string > const& getDictionary() const;
+
+    /**
+     * Set the dictionary of a string column.
+     *
+     * \param dictionary The distinct strings of the column. Will be empty afterwards.
+     */
+    void setDictionary( std::vector< std::string >* dictionary );
+
+    /**
+     * The value of a cell as a number.
+     *
+     * \param row The row.
+     *
+     * \return The value or NaN for missing values and cells of string columns.
+     */
+    double getNumber( std::size_t row ) const;
+
+    /**
+     * Whether a cell holds no value, i.e. it was empty or "NULL".
+     *
+     * \param row The row.
+     *
+     * \return true if the value is missing.
+     */
+    bool isMissing( std::size_t row ) const;
+
+    /**
+     * The value of a cell as text. Numbers are written in their shortest form that reads back to the same value.
+     *
+     * \param row The row.
+     *
+     * \return The text of the cell.
+     */
+    std::string getString( std::size_t row ) const;
+
+    /**
+     * Parse a number. In contrast to std::strtod, the range does not need to be terminated and a leading '+' is allowed.
+     *
+     * \param begin The first character.
+     * \param end One past the last character.
+     * \param[out] value Receives the value.
+     *
+     * \return true if the whole range is a number.
+     */
+    static bool parseNumber( char const* begin, char const* end, double* value );
+
+    /**
+     * Checks whether a cell denotes a missing value.
+     *
+     * \param begin The first character of the cell.
+     * \param end One past the last character of the cell.
+     *
+     * \return true if the cell is empty or "NULL".
+     */
+    static bool isMissingValue( char const* begin, char const* end );
+
+private:
+    //! the name of the column
+    std::string m_name;
+
+    //! the type
+    ColumnType m_type;
+
+    //! the number of rows
+    std::size_t m_size;
+
+    //! the values of an int column
+    std::vector< std::int32_t > m_ints;
+
+    //! the values of a double column
+    std::vector< double > m_doubles;
+
+    //! the codes of a string column
+    std::vector< std::uint32_t > m_codes;
+
+    //! the distinct strings of a string column
+    std::vector< std::string > m_dictionary;
+};
+
+#endif  // WCSVCOLUMN_H
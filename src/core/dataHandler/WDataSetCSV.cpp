@@ -22,18 +22,101 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include "WDataSetCSV.h"
 
+namespace
+{
+    /**
+     * Splits a text into lines like the reader does. Line breaks may be "\n" or "\r\n", a final line break does not start
+     * another line.
+     *
+     * \param text The text.
+     *
+     * \return The lines without their line breaks, pointing into the text.
+     */
+    std::vector< std::string_view > splitLines( std::string_view text )
+    {
+        std::vector< std::string_view > lines;
+        std::size_t begin = 0;
+        while( begin < text.size() )
+        {
+            std::size_t const newline = std::min( text.find( '\n', begin ), text.size() );
+            std::size_t end = newline;
+            if( end > begin && text[ end - 1 ] == '\r' )
+            {
+                --end;
+            }
+            lines.push_back( text.substr( begin, end - begin ) );
+            begin = newline + 1;
+        }
+        return lines;
+    }
+
+    /**
+     * Splits a line into cells like std::getline( line, cell, ',' ) would do, i.e. a trailing comma does not start another cell.
+     *
+     * \param line The line.
+     * \param cells Receives the cells.
+     */
+    void splitLine( std::string_view line, WDataSetCSV::ContentElem* cells )
+    {
+        std::size_t begin = 0;
+        while( begin < line.size() )
+        {
+            std::size_t end = std::min( line.find( ',', begin ), line.size() );
+            cells->push_back( std::string( line.substr( begin, end - begin ) ) );
+            begin = end + 1;
+        }
+    }
+}
 
 WDataSetCSV::WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::ContentSPtr data )
     : m_header( header ), m_data( data )
 {
 }
 
+WDataSetCSV::WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::Columns const& columns )
+    : m_header( header ), m_columns( columns )
+{
+}
+
+WDataSetCSV::WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::Columns const& columns, WDataSetCSV::TextSPtr text )
+    : m_header( header ), m_columns( columns ), m_text( text )
+{
+}
+
 WDataSetCSV::WDataSetCSV()
 {
 }
 
+WDataSetCSV::WDataSetCSV( WDataSetCSV const& other )
+    : WDataSet( other )
+{
+    *this = other;
+}
+
+WDataSetCSV& WDataSetCSV::operator=( WDataSetCSV const& other )
+{
+    if( this != &other )
+    {
+        std::scoped_lock< std::recursive_mutex, std::recursive_mutex > lock( m_conversionMutex, other.m_conversionMutex );
+        WDataSet::operator=( other );
+        m_header = other.m_header;
+        m_data = other.m_data;
+        rawDataSet = other.rawDataSet;
+        m_columns = other.m_columns;
+        m_text = other.m_text;
+    }
+    return *this;
+}
+
 WDataSetCSV::~WDataSetCSV()
 {
 }
@@ -45,11 +128,84 @@ WDataSetCSV::ContentSPtr WDataSetCSV::getHeader()
 
 WDataSetCSV::ContentSPtr WDataSetCSV::getData()
 {
+    std::lock_guard< std::recursive_mutex > lock( m_conversionMutex );
+    if( !m_data && m_text )
+    {
+        std::vector< std::string_view > const lines = splitLines( *m_text );
+        ContentSPtr data( new Content( lines.empty() ? 0 : lines.size() - 1 ) );
+        for( std::size_t row = 0; row < data->size(); ++row )
+        {
+            splitLine( lines[ row + 1 ], &( *data )[ row ] );
+        }
+        m_data = data;
+    }
+    else if( !m_data && !m_columns.empty() )
+    {
+        std::size_t const numRows = m_columns.front()->size();
+        ContentSPtr data( new Content( numRows, ContentElem( m_columns.size() ) ) );
+        for( std::size_t col = 0; col < m_columns.size(); ++col )
+        {
+            for( std::size_t row = 0; row < numRows; ++row )
+            {
+                ( *data )[ row ][ col ] = m_columns[ col ]->getString( row );
+            }
+        }
+        m_data = data;
+    }
     return m_data;
 }
 
+WDataSetCSV::Columns const& WDataSetCSV::getColumns()
+{
+    std::lock_guard< std::recursive_mutex > lock( m_conversionMutex );
+    if( m_columns.empty() && m_header && m_data )
+    {
+        m_columns = createColumns( m_header, m_data );
+    }
+    return m_columns;
+}
+
+std::size_t WDataSetCSV::getNumberOfRows()
+{
+    std::lock_guard< std::recursive_mutex > lock( m_conversionMutex );
+    if( !m_columns.empty() )
+    {
+        return m_columns.front()->size();
+    }
+    return m_data ? m_data->size() : 0;
+}
+
 WDataSetCSV::SeperatedRowSPtr WDataSetCSV::getRawDataSet()
 {
+    std::lock_guard< std::recursive_mutex > lock( m_conversionMutex );
+    if( !rawDataSet && m_text )
+    {
+        std::vector< std::string_view > const lines = splitLines( *m_text );
+        SeperatedRowSPtr raw( new std::vector< std::string >( lines.begin(), lines.end() ) );
+        rawDataSet = raw;
+    }
+    else if( !rawDataSet && m_header && !m_header->empty() && getData() )
+    {
+        SeperatedRowSPtr raw( new std::vector< std::string >() );
+        raw->reserve( m_data->size() + 1 );
+
+        std::vector< ContentElem const* > rows;
+        rows.push_back( &m_header->front() );
+        for( Content::const_iterator it = m_data->begin(); it != m_data->end(); ++it )
+        {
+            rows.push_back( &*it );
+        }
+        for( std::size_t i = 0; i < rows.size(); ++i )
+        {
+            std::string line;
+            for( std::size_t col = 0; col < rows[ i ]->size(); ++col )
+            {
+                line += ( col == 0 ? "" : "," ) + ( *rows[ i ] )[ col ];
+            }
+            raw->push_back( line );
+        }
+        rawDataSet = raw;
+    }
     return rawDataSet;
 }
 
@@ -57,3 +213,55 @@ void WDataSetCSV::setRawDataSet( WDataSetCSV::SeperatedRowSPtr rawDataSetIn )
 {
     rawDataSet = rawDataSetIn;
 }
+
+WDataSetCSV::Columns WDataSetCSV::createColumns( WDataSetCSV::ContentSPtr header, WDataSetCSV::ContentSPtr data )
+{
+    Columns columns;
+    if( !header || header->empty() || !data )
+    {
+        return columns;
+    }
+
+    ContentElem const& names = header->front();
+    std::string const empty;
+    for( std::size_t col = 0; col < names.size(); ++col )
+    {
+        WCSVColumn::TypeDetector detector;
+        for( Content::const_iterator row = data->begin(); row != data->end(); ++row )
+        {
+            std::string const& cell = col < row->size() ? ( *row )[ col ] : empty;
+            detector.add( cell.data(), cell.data() + cell.size() );
+        }
+
+        WCSVColumn::SPtr column( new WCSVColumn( names[ col ], detector.getType(), data->size() ) );
+        if( column->getType() == WCSVColumn::COLUMN_STRING )
+        {
+            std::unordered_map< std::string, std::uint32_t > codes;
+            std::vector< std::string > dictionary;
+            std::uint32_t* out = column->getCodes();
+            for( Content::const_iterator row = data->begin(); row != data->end(); ++row, ++out )
+            {
+                std::string const& cell = col < row->size() ? ( *row )[ col ] : empty;
+                std::pair< std::unordered_map< std::string, std::uint32_t >::iterator, bool > code =
+                    codes.insert( std::make_pair( cell, static_cast< std::uint32_t >( dictionary.size() ) ) );
+                if( code.second )
+                {
+                    dictionary.push_back( cell );
+                }
+                *out = code.first->second;
+            }
+            column->setDictionary( &dictionary );
+        }
+        else
+        {
+            std::size_t index = 0;
+            for( Content::const_iterator row = data->begin(); row != data->end(); ++row, ++index )
+            {
+                std::string const& cell = col < row->size() ? ( *row )[ col ] : empty;
+                column->setNumber( index, cell.data(), cell.data() + cell.size() );
+            }
+        }
+        columns.push_back( column );
+    }
+    return columns;
+}
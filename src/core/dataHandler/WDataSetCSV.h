@@ -26,13 +26,18 @@
 #define WDATASETCSV_H
 
 #include <memory>
+#include <mutex>
+#include <string_view>
 
+#include "WCSVColumn.h"
 #include "WDataSet.h"
 #include "string"
 #include "vector"
 
 /**
- * Represents a CSV dataset.
+ * Represents a CSV dataset. The data is stored column-wise in typed columns (see WCSVColumn). The former representation
+ * as one string per cell is still available through getData() and getRawDataSet(), it is created on first use from the
+ * text of the file, so it reproduces the file exactly. The text is not copied, the dataset keeps the mapping of the file.
  */
 class WDataSetCSV : public WDataSet
 {
@@ -66,6 +71,16 @@ public:
      */
     typedef std::shared_ptr< std::vector< std::string > > ContentElemSPtr;
 
+    /**
+     * represents the typed columns of the data.
+     */
+    typedef std::vector< WCSVColumn::ConstSPtr > Columns;
+
+    /**
+     * represents the text of a CSV file. The pointer keeps the memory the text points into alive, e.g. a mapped file.
+     */
+    typedef std::shared_ptr< std::string_view const > TextSPtr;
+
     /**
      * Construct WDataSetCSV object
      *
@@ -74,11 +89,44 @@ public:
      */
     explicit WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::ContentSPtr data );
 
+    /**
+     * Construct WDataSetCSV object from typed columns.
+     *
+     * \param header Column names of the CSV file.
+     * \param columns The columns, all of the same size and in the order of the header.
+     */
+    WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::Columns const& columns );
+
+    /**
+     * Construct WDataSetCSV object from typed columns and the text they were read from.
+     *
+     * \param header Column names of the CSV file.
+     * \param columns The columns, all of the same size and in the order of the header.
+     * \param text The text of the file including the header line, used for getData() and getRawDataSet().
+     */
+    WDataSetCSV( WDataSetCSV::ContentSPtr header, WDataSetCSV::Columns const& columns, WDataSetCSV::TextSPtr text );
+
     /**
      * The standard constructor.
      */
     WDataSetCSV();
 
+    /**
+     * Copies the dataset, but not the mutex.
+     *
+     * \param other The dataset to copy.
+     */
+    WDataSetCSV( WDataSetCSV const& other );
+
+    /**
+     * Copy assignment operator which does not copy the mutex.
+     *
+     * \param other The dataset to copy.
+     *
+     * \return itself
+     */
+    WDataSetCSV& operator=( WDataSetCSV const& other );
+
     /**
      * Destructs this dataset.
      */
@@ -92,12 +140,27 @@ public:
     WDataSetCSV::ContentSPtr getHeader();
 
     /**
-     * Getter method to receive csv data
+     * Getter method to receive csv data. If the dataset was created from columns, the strings are created on the first call.
      *
      * \return m_data as WDataSetCSV::Content object
      */
     WDataSetCSV::ContentSPtr getData();
 
+    /**
+     * Getter method to receive the typed columns. If the dataset was created from strings, the columns are created on the
+     * first call.
+     *
+     * \return The columns in the order of the header.
+     */
+    WDataSetCSV::Columns const& getColumns();
+
+    /**
+     * The number of data rows.
+     *
+     * \return The number of rows, without the header.
+     */
+    std::size_t getNumberOfRows();
+
     /**
      * Getter method to receive csv rawdata
      *
@@ -112,6 +175,17 @@ public:
      */
     SeperatedRowSPtr getRawDataSet();
 
+    /**
+     * Creates typed columns from the string representation. The type of each column is the most specific type all of its
+     * cells can be stored in.
+     *
+     * \param header Column names.
+     * \param data The rows, each with as many cells as there are column names.
+     *
+     * \return The columns.
+     */
+    static WDataSetCSV::Columns createColumns( WDataSetCSV::ContentSPtr header, WDataSetCSV::ContentSPtr data );
+
 private:
     /**
      * Stores the column titles of a loaded CSV file.
@@ -127,6 +201,21 @@ private:
      * Stores the rawdata of a loaded CSV file.
      */
     SeperatedRowSPtr rawDataSet;
+
+    /**
+     * Stores the typed columns of a loaded CSV file.
+     */
+    WDataSetCSV::Columns m_columns;
+
+    /**
+     * Stores the text of a loaded CSV file, if the dataset was read from a file.
+     */
+    WDataSetCSV::TextSPtr m_text;
+
+    /**
+     * Guards the creation of one representation from the other, this happens once per dataset at most.
+     */
+    mutable std::recursive_mutex m_conversionMutex;
 };
 
 #endif  // WDATASETCSV_H
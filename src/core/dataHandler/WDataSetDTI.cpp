@@ -74,7 +74,7 @@ WTensorSym< 2, 3, float > WDataSetDTI::getTensor( size_t index ) const
 {
     std::shared_ptr< WValueSet< float > > values = std::dynamic_pointer_cast< WValueSet< float > >( m_valueSet );
     WAssert( values, "The value set of a WDataSetDTI must be a WValueSet< float >, nothing else!" );
-    return WTensorSym< 2, 3, float >( values->getWValue( index ) );
+    return values->getValueView< 6 >( index ).toTensorSym< 2, 3 >();
 }
 
 const std::string WDataSetDTI::getName() const
@@ -347,6 +347,10 @@ const WPropSelection WDataSetFibers::getColorSchemeProperty() const
 
 WDataSetFibers::VertexParemeterArray WDataSetFibers::getVertexParameters( size_t parameterIndex ) const
 {
+    if( parameterIndex >= m_vertexParameters.size() )
+    {
+        return WDataSetFibers::VertexParemeterArray();
+    }
     return m_vertexParameters[ parameterIndex ];
 }
 
@@ -357,6 +361,10 @@ void WDataSetFibers::setVertexParameters( std::vector< WDataSetFibers::VertexPar
 
 WDataSetFibers::LineParemeterArray WDataSetFibers::getLineParameters( size_t parameterIndex ) const
 {
+    if( parameterIndex >= m_lineParameters.size() )
+    {
+        return WDataSetFibers::LineParemeterArray();
+    }
     return m_lineParameters[ parameterIndex ];
 }
 
@@ -259,7 +259,7 @@ template< typename T > WValue< T > WDataSetRawHARDI::getNonZeroGradientSignals(
     WValue< T > result( m_nonZeroGradientIndexes.size() );
     size_t idx = 0;
     std::shared_ptr< WValueSet< T > > vs = std::dynamic_pointer_cast< WValueSet< T > >( m_valueSet );
-    WValue< T > signal( vs->getWValue( index ) );
+    typename WValueSet< T >::SubArray const signal = vs->getSubArray( index * vs->dimension(), vs->dimension() );
     for( std::vector< size_t >::const_iterator cit = m_nonZeroGradientIndexes.begin(); cit != m_nonZeroGradientIndexes.end(); ++cit )
     {
         result[ idx ] = signal[ *cit ];
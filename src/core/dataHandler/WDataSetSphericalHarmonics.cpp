@@ -107,7 +107,7 @@ WSymmetricSphericalHarmonic< double > WDataSetSphericalHarmonics::interpolate( c
     double lambdaY = localPos[1];
     double lambdaZ = localPos[2];
 
-    WValue< double > h( 8 );
+    double h[ 8 ];
 //         lZ     lY
 //         |      /
 //         | 6___/_7
@@ -126,11 +126,15 @@ WSymmetricSphericalHarmonic< double > WDataSetSphericalHarmonics::interpolate( c
     h[6] = ( 1 - lambdaX ) * (     lambdaY ) * (     lambdaZ );
     h[7] = (     lambdaX ) * (     lambdaY ) * (     lambdaZ );
 
-    // take
-    WValue<double> interpolatedCoefficients( m_valueSet->dimension() );
+    // take, reading the coefficients directly avoids a temporary WValue per vertex
+    std::size_t const dimension = m_valueSet->dimension();
+    WValue<double> interpolatedCoefficients( dimension );
     for( size_t i = 0; i < 8; ++i )
     {
-        interpolatedCoefficients += h[i] * m_valueSet->getWValueDouble( vertexIds[i] );
+        for( std::size_t j = 0; j < dimension; ++j )
+        {
+            interpolatedCoefficients[ j ] += h[i] * m_valueSet->getScalarDouble( vertexIds[i] * dimension + j );
+        }
     }
 
     *success = true;
@@ -23,18 +23,93 @@
 //---------------------------------------------------------------------------
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <boost/function.hpp>
+
 #include "../common/WAssert.h"
 #include "../common/WLimits.h"
+#include "../common/WThreadedFunction.h"
 #include "WDataSetTimeSeries.h"
 
 // prototype instance as singleton
 std::shared_ptr< WPrototyped > WDataSetTimeSeries::m_prototype = std::shared_ptr< WPrototyped >();
 
+namespace
+{
+    /**
+     * Calls a function for consecutive blocks of voxels. The voxels are split evenly between the threads.
+     * To be used with WThreadedFunction.
+     */
+    class WVoxelBlockFunction
+    {
+    public:
+        //! the function called for each block of voxels [ begin, end )
+        typedef boost::function< void ( std::size_t, std::size_t ) > BlockFunction;
+
+        /**
+         * Constructor.
+         *
+         * \param numVoxels The number of voxels.
+         * \param func The function to call for each block.
+         */
+        WVoxelBlockFunction( std::size_t numVoxels, BlockFunction const& func )
+            : m_numVoxels( numVoxels ),
+              m_func( func )
+        {
+        }
+
+        /**
+         * Processes the voxels of this thread.
+         *
+         * \param id The number of this thread.
+         * \param mx The number of threads.
+         * \param stop Set if the computation should be stopped.
+         */
+        void operator()( std::size_t id, std::size_t mx, WBoolFlag const& stop )
+        {
+            std::size_t const begin = m_numVoxels * id / mx;
+            std::size_t const end = m_numVoxels * ( id + 1 ) / mx;
+
+            // small blocks keep the time courses written or read per block in the cache
+            std::size_t const blockSize = 256;
+            for( std::size_t block = begin; block < end && !stop(); block += blockSize )
+            {
+                m_func( block, std::min( block + blockSize, end ) );
+            }
+        }
+
+    private:
+        //! the number of voxels
+        std::size_t m_numVoxels;
+
+        //! the function
+        BlockFunction m_func;
+    };
+
+    /**
+     * Calls a function for blocks of voxels in parallel and waits for all threads to finish.
+     *
+     * \param numVoxels The number of voxels.
+     * \param func The function to call for each block.
+     */
+    void forEachVoxelBlock( std::size_t numVoxels, WVoxelBlockFunction::BlockFunction const& func )
+    {
+        std::shared_ptr< WVoxelBlockFunction > function( new WVoxelBlockFunction( numVoxels, func ) );
+        WThreadedFunction< WVoxelBlockFunction > pool( W_AUTOMATIC_NB_THREADS, function );
+        pool.run();
+        pool.wait();
+        if( pool.status() != W_THREADS_FINISHED )
+        {
+            throw WException( std::string( "A thread processing the time series was aborted." ) );
+        }
+    }
+}
+
 WDataSetTimeSeries::WDataSetTimeSeries( std::vector< std::shared_ptr< WDataSetScalar const > > datasets,
                                         std::vector< float > times )
     : m_dataSets()
@@ -241,3 +316,177 @@ double WDataSetTimeSeries::getMaxValue()
 {
     return m_maxValue;
 }
+
+std::size_t WDataSetTimeSeries::getNumberOfTimeSlices() const
+{
+    return m_dataSets.size();
+}
+
+std::size_t WDataSetTimeSeries::getNumberOfVoxels() const
+{
+    return m_dataSets.front().first->getValueSet()->size();
+}
+
+std::shared_ptr< WGridRegular3D > WDataSetTimeSeries::getGrid() const
+{
+    return std::dynamic_pointer_cast< WGridRegular3D >( m_dataSets.front().first->getGrid() );
+}
+
+float const* WDataSetTimeSeries::getTimeCourse( std::size_t voxel ) const
+{
+    WAssert( voxel < getNumberOfVoxels(), "Voxel index out of range." );
+    buildVoxelMajorLayout();
+    return &( *m_timeCourses )[ voxel * getNumberOfTimeSlices() ];
+}
+
+void WDataSetTimeSeries::getTimeCourses( std::vector< std::size_t > const& voxels, float* courses ) const
+{
+    buildVoxelMajorLayout();
+    std::size_t const numSlices = getNumberOfTimeSlices();
+    for( std::size_t k = 0; k < voxels.size(); ++k )
+    {
+        WAssert( voxels[ k ] < getNumberOfVoxels(), "Voxel index out of range." );
+        float const* course = &( *m_timeCourses )[ voxels[ k ] * numSlices ];
+        std::copy( course, course + numSlices, courses + k * numSlices );
+    }
+}
+
+std::shared_ptr< WDataSetScalar > WDataSetTimeSeries::calcSeedCorrelation( std::size_t seedVoxel ) const
+{
+    WAssert( seedVoxel < getNumberOfVoxels(), "Voxel index out of range." );
+    buildVoxelMajorLayout();
+
+    std::size_t const numSlices = getNumberOfTimeSlices();
+    std::size_t const numVoxels = getNumberOfVoxels();
+    std::vector< float > const& timeCourses = *m_timeCourses;
+    std::vector< float > const& inverseNorms = *m_inverseNorms;
+
+    // as the mean-free seed sums up to zero, the correlation with any time course x is <x, seed> scaled by both inverse norms,
+    // so the other time courses do not need to be made mean-free
+    std::vector< double > seed( timeCourses.begin() + seedVoxel * numSlices, timeCourses.begin() + ( seedVoxel + 1 ) * numSlices );
+    double mean = 0.0;
+    for( std::size_t t = 0; t < numSlices; ++t )
+    {
+        mean += seed[ t ];
+    }
+    mean /= static_cast< double >( numSlices );
+    for( std::size_t t = 0; t < numSlices; ++t )
+    {
+        seed[ t ] -= mean;
+    }
+    double const seedInverseNorm = inverseNorms[ seedVoxel ];
+
+    std::shared_ptr< std::vector< float > > correlation( new std::vector< float >( numVoxels, 0.0f ) );
+    std::vector< float >& result = *correlation;
+    forEachVoxelBlock( numVoxels, [ & ]( std::size_t begin, std::size_t end )
+    {
+        for( std::size_t v = begin; v < end; ++v )
+        {
+            float const* course = &timeCourses[ v * numSlices ];
+            double dot = 0.0;
+            for( std::size_t t = 0; t < numSlices; ++t )
+            {
+                dot += course[ t ] * seed[ t ];
+            }
+            result[ v ] = static_cast< float >( std::max( -1.0, std::min( 1.0, dot * inverseNorms[ v ] * seedInverseNorm ) ) );
+        }
+    } );
+
+    std::shared_ptr< WValueSet< float > > values( new WValueSet< float >( 0, 1, correlation, W_DT_FLOAT ) );
+    return std::shared_ptr< WDataSetScalar >( new WDataSetScalar( values, m_dataSets.front().first->getGrid() ) );
+}
+
+void WDataSetTimeSeries::buildVoxelMajorLayout() const
+{
+    std::lock_guard< std::mutex > lock( m_layoutMutex );
+    if( m_timeCourses )
+    {
+        return;
+    }
+
+    std::shared_ptr< std::vector< float > > timeCourses( new std::vector< float >( getNumberOfVoxels() * getNumberOfTimeSlices() ) );
+    std::shared_ptr< std::vector< float > > inverseNorms( new std::vector< float >( getNumberOfVoxels() ) );
+    switch( m_dataSets.front().first->getValueSet()->getDataType() )
+    {
+    case W_DT_UINT8:
+        fillVoxelMajorLayout< uint8_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_INT8:
+        fillVoxelMajorLayout< int8_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_UINT16:
+        fillVoxelMajorLayout< uint16_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_INT16:
+        fillVoxelMajorLayout< int16_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_UINT32:
+        fillVoxelMajorLayout< uint32_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_SIGNED_INT:
+        fillVoxelMajorLayout< int32_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_UINT64:
+        fillVoxelMajorLayout< uint64_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_INT64:
+        fillVoxelMajorLayout< int64_t >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_FLOAT:
+        fillVoxelMajorLayout< float >( timeCourses.get(), inverseNorms.get() );
+        break;
+    case W_DT_DOUBLE:
+        fillVoxelMajorLayout< double >( timeCourses.get(), inverseNorms.get() );
+        break;
+    default:
+        throw WException( std::string( "Unsupported datatype in WDataSetTimeSeries::buildVoxelMajorLayout()" ) );
+        break;
+    }
+    m_timeCourses = timeCourses;
+    m_inverseNorms = inverseNorms;
+}
+
+template< typename Data_T >
+void WDataSetTimeSeries::fillVoxelMajorLayout( std::vector< float >* timeCourses, std::vector< float >* inverseNorms ) const
+{
+    std::size_t const numSlices = getNumberOfTimeSlices();
+    std::vector< Data_T const* > slices( numSlices );
+    for( std::size_t t = 0; t < numSlices; ++t )
+    {
+        std::shared_ptr< WValueSet< Data_T > const > vs = std::dynamic_pointer_cast< WValueSet< Data_T > const >(
+                m_dataSets[ t ].first->getValueSet() );
+        WAssert( vs, "" );
+        slices[ t ] = vs->rawData();
+    }
+
+    std::vector< float >& courses = *timeCourses;
+    std::vector< float >& norms = *inverseNorms;
+    forEachVoxelBlock( getNumberOfVoxels(), [ & ]( std::size_t begin, std::size_t end )
+    {
+        // transpose slice by slice, the block of each slice is read contiguously
+        for( std::size_t t = 0; t < numSlices; ++t )
+        {
+            Data_T const* slice = slices[ t ];
+            for( std::size_t v = begin; v < end; ++v )
+            {
+                courses[ v * numSlices + t ] = static_cast< float >( slice[ v ] );
+            }
+        }
+        for( std::size_t v = begin; v < end; ++v )
+        {
+            float const* course = &courses[ v * numSlices ];
+            double mean = 0.0;
+            for( std::size_t t = 0; t < numSlices; ++t )
+            {
+                mean += course[ t ];
+            }
+            mean /= static_cast< double >( numSlices );
+            double squares = 0.0;
+            for( std::size_t t = 0; t < numSlices; ++t )
+            {
+                squares += ( course[ t ] - mean ) * ( course[ t ] - mean );
+            }
+            norms[ v ] = squares > 0.0 ? static_cast< float >( 1.0 / std::sqrt( squares ) ) : 0.0f;
+        }
+    } );
+}
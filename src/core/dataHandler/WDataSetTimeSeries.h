@@ -27,6 +27,7 @@
 
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,6 +44,10 @@ class WDataSetTimeSeriesTest;
 /**
  * A dataset that stores a time series.
  *
+ * Besides the time slices, the values can be accessed in a voxel-major layout where the time course of every voxel is a
+ * contiguous array of floats. This layout is built in parallel on the first access to a time course and is meant for
+ * analyses working on whole time courses, like seed-based correlation.
+ *
  * \note Only works for scalar datasets at the moment!
  * \note this is only a temporary solution
  */
@@ -174,6 +179,62 @@ public:
      */
     double getMaxValue();
 
+    /**
+     * Get the number of time slices.
+     *
+     * \return The number of time slices.
+     */
+    std::size_t getNumberOfTimeSlices() const;
+
+    /**
+     * Get the number of voxels of every time slice.
+     *
+     * \return The number of voxels.
+     */
+    std::size_t getNumberOfVoxels() const;
+
+    /**
+     * Get the grid shared by all time slices.
+     *
+     * \return The grid.
+     */
+    std::shared_ptr< WGridRegular3D > getGrid() const;
+
+    /**
+     * Get the time course of a voxel. The values are ordered by time and stored contiguously, so the pointer can be
+     * used directly for computations. Builds the voxel-major layout if needed.
+     *
+     * \param voxel The index of the voxel.
+     *
+     * \return A pointer to getNumberOfTimeSlices() values.
+     */
+    float const* getTimeCourse( std::size_t voxel ) const;
+
+    /**
+     * Copy the time courses of many voxels. Builds the voxel-major layout if needed.
+     *
+     * \param voxels The indices of the voxels.
+     * \param[out] courses Receives voxels.size() * getNumberOfTimeSlices() values, one time course after the other.
+     */
+    void getTimeCourses( std::vector< std::size_t > const& voxels, float* courses ) const;
+
+    /**
+     * Calculate the pearson correlation of the time course of a seed voxel with the time courses of all voxels.
+     * The correlation is computed in parallel and uses the voxel-major layout, which is built if needed.
+     *
+     * \param seedVoxel The index of the seed voxel.
+     *
+     * \return A dataset of float correlation coefficients on the grid of the time series. Voxels with a constant time
+     * course get a correlation of 0.
+     */
+    std::shared_ptr< WDataSetScalar > calcSeedCorrelation( std::size_t seedVoxel ) const;
+
+    /**
+     * Build the voxel-major layout of the values if it does not exist yet. Called automatically by the time course
+     * accessors, calling it explicitly moves the cost to a convenient point in time.
+     */
+    void buildVoxelMajorLayout() const;
+
 private:
     /**
      * Find the largest time slice position that is smaller than or equal to time,
@@ -204,6 +265,15 @@ private:
     template< typename Data_T >
     std::shared_ptr< WValueSetBase > calcInterpolatedValueSet( float lb, float ub, float time ) const;
 
+    /**
+     * Copy the values of all time slices into the voxel-major layout.
+     *
+     * \param timeCourses The voxel-major values to fill.
+     * \param inverseNorms The inverse norms of the mean-free time courses to fill.
+     */
+    template< typename Data_T >
+    void fillVoxelMajorLayout( std::vector< float >* timeCourses, std::vector< float >* inverseNorms ) const;
+
     /**
      * Standard constructor.
      */
@@ -254,6 +324,15 @@ private:
 
     //! the largest value
     double m_maxValue;
+
+    //! protects the creation of the voxel-major layout
+    mutable std::mutex m_layoutMutex;
+
+    //! the values in voxel-major order, the time course of each voxel is contiguous
+    mutable std::shared_ptr< std::vector< float > const > m_timeCourses;
+
+    //! for each voxel, the inverse euclidean norm of its mean-free time course or 0 for constant time courses
+    mutable std::shared_ptr< std::vector< float > const > m_inverseNorms;
 };
 
 template< typename Data_T >
@@ -22,12 +22,16 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 
+#include "../common/WLogger.h"
 #include "../common/exceptions/WOutOfBounds.h"
 #include "WEEG2Segment.h"
 #include "WEEGValueMatrix.h"
@@ -37,7 +41,9 @@
 
 WEEG2Segment::WEEG2Segment( std::size_t segmentID, std::shared_ptr< WPagerEEG > pager )
     : m_segmentID( segmentID ),
-      m_pager( pager )
+      m_pager( pager ),
+      m_readAheadRunning( false ),
+      m_lastStart( 0 )
 {
     if( !m_pager )
     {
@@ -56,6 +62,33 @@ WEEG2Segment::WEEG2Segment( std::size_t segmentID, std::shared_ptr< WPagerEEG >
     {
         throw WDHException( std::string( "Couldn't construct new EEG segment: invalid number of samples" ) );
     }
+
+    // blocks of about 1 MiB, the cache holds about 64 MiB of blocks and 16 MiB of pyramids
+    m_nbChannels = m_pager->getNumberOfChannels();
+    m_blockSize = SUMMARY_BUCKET_SIZE * 64;
+    while( m_blockSize < SUMMARY_BUCKET_SIZE * 1024 && m_blockSize * m_nbChannels * sizeof( double ) < ( 1u << 20 ) )
+    {
+        m_blockSize *= 4;
+    }
+    std::size_t const nbChannels = std::max< std::size_t >( m_nbChannels, 1 );
+    std::size_t const blockBytes = m_blockSize * nbChannels * sizeof( double );
+    m_maxCachedBlocks = std::max< std::size_t >( 4, ( 64u << 20 ) / blockBytes );
+
+    std::size_t summaryBytes = 0;
+    for( std::size_t bucketSize = SUMMARY_BUCKET_SIZE; bucketSize <= m_blockSize; bucketSize *= 4 )
+    {
+        summaryBytes += 2 * nbChannels * ( m_blockSize / bucketSize ) * sizeof( float );
+    }
+    m_maxCachedSummaries = std::max( m_maxCachedBlocks, ( 16u << 20 ) / summaryBytes );
+}
+
+WEEG2Segment::~WEEG2Segment()
+{
+    // the reading thread locks the cache itself, so do not hold the lock here
+    if( m_readAheadThread.joinable() )
+    {
+        m_readAheadThread.join();
+    }
 }
 
 std::size_t WEEG2Segment::getNumberOfSamples() const
@@ -63,9 +96,344 @@ std::size_t WEEG2Segment::getNumberOfSamples() const
     return m_nbSamples;
 }
 
+std::size_t WEEG2Segment::getBlockSize() const
+{
+    return m_blockSize;
+}
+
 std::shared_ptr< WEEGValueMatrix > WEEG2Segment::getValues( std::size_t start, std::size_t length ) const
 {
-    // No test whether start and length are valid - this should be done only
-    // one time by the pager.
-    return m_pager->getValues( m_segmentID, start, length );
+    if( start + length > m_nbSamples )
+    {
+        std::ostringstream stream;
+        stream << "Could not read sample number " << start + length - 1 << " of segment " << m_segmentID << ", it only has "
+               << m_nbSamples << " samples";
+        throw WOutOfBounds( stream.str() );
+    }
+
+    std::shared_ptr< WEEGValueMatrix > values( new WEEGValueMatrix( m_nbChannels, std::vector< double >( length ) ) );
+    if( length == 0 )
+    {
+        return values;
+    }
+
+    std::size_t const firstBlock = start / m_blockSize;
+    std::size_t const lastBlock = ( start + length - 1 ) / m_blockSize;
+    for( std::size_t block = firstBlock; block <= lastBlock; ++block )
+    {
+        std::shared_ptr< WEEGValueMatrix const > blockValues = getBlock( block );
+        std::size_t const blockStart = block * m_blockSize;
+        std::size_t const from = std::max( start, blockStart );
+        std::size_t const to = std::min( start + length, blockStart + m_blockSize );
+        for( std::size_t channelID = 0; channelID < m_nbChannels; ++channelID )
+        {
+            std::copy( ( *blockValues )[ channelID ].begin() + ( from - blockStart ),
+                       ( *blockValues )[ channelID ].begin() + ( to - blockStart ),
+                       ( *values )[ channelID ].begin() + ( from - start ) );
+        }
+    }
+
+    readAhead( start, firstBlock, lastBlock );
+    return values;
+}
+
+void WEEG2Segment::getMinMaxValues( std::size_t channelID, std::size_t start, std::size_t length, std::size_t maxPoints,
+                                    std::vector< double >* samples, std::vector< double >* values ) const
+{
+    samples->clear();
+    values->clear();
+    if( length == 0 || start >= m_nbSamples || channelID >= m_nbChannels )
+    {
+        return;
+    }
+    length = std::min( length, m_nbSamples - start );
+
+    if( length <= maxPoints )
+    {
+        std::shared_ptr< WEEGValueMatrix > raw = getValues( start, length );
+        samples->reserve( length );
+        values->assign( ( *raw )[ channelID ].begin(), ( *raw )[ channelID ].end() );
+        for( std::size_t i = 0; i < length; ++i )
+        {
+            samples->push_back( static_cast< double >( start + i ) );
+        }
+        return;
+    }
+
+    std::size_t const nbBuckets = std::max< std::size_t >( 1, maxPoints / 2 );
+    std::size_t const samplesPerBucket = ( length + nbBuckets - 1 ) / nbBuckets;
+
+    // use the coarsest pyramid level that is not coarser than the requested buckets, small buckets use the raw values
+    std::size_t level = 0;
+    std::size_t levelBucketSize = 1;
+    if( samplesPerBucket >= SUMMARY_BUCKET_SIZE )
+    {
+        levelBucketSize = SUMMARY_BUCKET_SIZE;
+        while( levelBucketSize * 4 <= samplesPerBucket && levelBucketSize * 4 <= m_blockSize )
+        {
+            levelBucketSize *= 4;
+            ++level;
+        }
+    }
+    std::size_t const bucketSize = ( ( samplesPerBucket + levelBucketSize - 1 ) / levelBucketSize ) * levelBucketSize;
+
+    std::size_t const firstBucket = start / bucketSize;
+    std::size_t const lastBucket = ( start + length - 1 ) / bucketSize;
+    std::vector< float > mins( lastBucket - firstBucket + 1, std::numeric_limits< float >::max() );
+    std::vector< float > maxs( lastBucket - firstBucket + 1, -std::numeric_limits< float >::max() );
+
+    std::size_t const rangeStart = firstBucket * bucketSize;
+    std::size_t const rangeEnd = std::min( ( lastBucket + 1 ) * bucketSize, m_nbSamples );
+    std::size_t const firstBlock = rangeStart / m_blockSize;
+    std::size_t const lastBlock = ( rangeEnd - 1 ) / m_blockSize;
+    for( std::size_t block = firstBlock; block <= lastBlock; ++block )
+    {
+        std::size_t const blockStart = block * m_blockSize;
+        std::size_t const from = std::max( rangeStart, blockStart );
+        std::size_t const to = std::min( rangeEnd, blockStart + m_blockSize );
+        if( levelBucketSize == 1 )
+        {
+            std::vector< double > const& blockValues = ( *getBlock( block ) )[ channelID ];
+            for( std::size_t sample = from; sample < to; ++sample )
+            {
+                std::size_t const bucket = sample / bucketSize - firstBucket;
+                float const value = static_cast< float >( blockValues[ sample - blockStart ] );
+                mins[ bucket ] = std::min( mins[ bucket ], value );
+                maxs[ bucket ] = std::max( maxs[ bucket ], value );
+            }
+        }
+        else
+        {
+            std::vector< float > const& summary = ( *getBlockSummary( block ) )[ level ];
+            std::size_t const nbLevelBuckets = summary.size() / ( 2 * m_nbChannels );
+            float const* minMax = &summary[ 2 * channelID * nbLevelBuckets ];
+            std::size_t const fromEntry = ( from - blockStart ) / levelBucketSize;
+            std::size_t const toEntry = ( to - blockStart + levelBucketSize - 1 ) / levelBucketSize;
+            for( std::size_t entry = fromEntry; entry < toEntry; ++entry )
+            {
+                std::size_t const bucket = ( blockStart + entry * levelBucketSize ) / bucketSize - firstBucket;
+                mins[ bucket ] = std::min( mins[ bucket ], minMax[ 2 * entry ] );
+                maxs[ bucket ] = std::max( maxs[ bucket ], minMax[ 2 * entry + 1 ] );
+            }
+        }
+    }
+
+    samples->reserve( 2 * mins.size() );
+    values->reserve( 2 * mins.size() );
+    std::size_t const lastSample = start + length - 1;
+    for( std::size_t bucket = 0; bucket < mins.size(); ++bucket )
+    {
+        if( mins[ bucket ] > maxs[ bucket ] )
+        {
+            continue;
+        }
+        std::size_t const bucketStart = ( firstBucket + bucket ) * bucketSize;
+        samples->push_back( static_cast< double >( std::min( std::max( bucketStart, start ), lastSample ) ) );
+        values->push_back( mins[ bucket ] );
+        samples->push_back( static_cast< double >( std::min( std::max( bucketStart + bucketSize / 2, start ), lastSample ) ) );
+        values->push_back( maxs[ bucket ] );
+    }
+
+    readAhead( start, firstBlock, lastBlock );
+}
+
+std::shared_ptr< WEEGValueMatrix const > WEEG2Segment::getBlock( std::size_t block ) const
+{
+    {
+        std::lock_guard< std::mutex > lock( m_cacheMutex );
+        for( std::list< std::pair< std::size_t, std::shared_ptr< WEEGValueMatrix const > > >::iterator it = m_blocks.begin();
+             it != m_blocks.end(); ++it )
+        {
+            if( it->first == block )
+            {
+                m_blocks.splice( m_blocks.begin(), m_blocks, it );
+                return m_blocks.front().second;
+            }
+        }
+    }
+
+    std::size_t const blockStart = block * m_blockSize;
+    std::size_t const blockLength = std::min( m_blockSize, m_nbSamples - blockStart );
+    std::shared_ptr< WEEGValueMatrix const > values;
+    {
+        std::lock_guard< std::mutex > lock( m_pager->getReadMutex() );
+        values = m_pager->getValues( m_segmentID, blockStart, blockLength );
+    }
+
+    bool hasSummary;
+    {
+        std::lock_guard< std::mutex > lock( m_cacheMutex );
+        hasSummary = m_summaries.count( block ) > 0;
+    }
+    std::shared_ptr< BlockSummary const > summary;
+    if( !hasSummary )
+    {
+        summary = computeSummary( *values );
+    }
+
+    std::lock_guard< std::mutex > lock( m_cacheMutex );
+    if( summary )
+    {
+        storeSummary( block, summary );
+    }
+    // another thread may have read the same block in the meantime
+    for( std::list< std::pair< std::size_t, std::shared_ptr< WEEGValueMatrix const > > >::iterator it = m_blocks.begin();
+         it != m_blocks.end(); ++it )
+    {
+        if( it->first == block )
+        {
+            return it->second;
+        }
+    }
+    m_blocks.push_front( std::make_pair( block, values ) );
+    if( m_blocks.size() > m_maxCachedBlocks )
+    {
+        m_blocks.pop_back();
+    }
+    return values;
+}
+
+std::shared_ptr< WEEG2Segment::BlockSummary const > WEEG2Segment::getBlockSummary( std::size_t block ) const
+{
+    {
+        std::lock_guard< std::mutex > lock( m_cacheMutex );
+        SummaryMap::iterator it = m_summaries.find( block );
+        if( it != m_summaries.end() )
+        {
+            m_summaryOrder.splice( m_summaryOrder.begin(), m_summaryOrder, it->second.second );
+            return it->second.first;
+        }
+    }
+
+    std::shared_ptr< WEEGValueMatrix const > values = getBlock( block );
+    {
+        std::lock_guard< std::mutex > lock( m_cacheMutex );
+        SummaryMap::iterator it = m_summaries.find( block );
+        if( it != m_summaries.end() )
+        {
+            return it->second.first;
+        }
+    }
+
+    // the block came from the cache, but its pyramid was evicted
+    std::shared_ptr< BlockSummary const > summary = computeSummary( *values );
+    std::lock_guard< std::mutex > lock( m_cacheMutex );
+    return storeSummary( block, summary );
+}
+
+std::shared_ptr< WEEG2Segment::BlockSummary const > WEEG2Segment::storeSummary( std::size_t block,
+                                                                                 std::shared_ptr< BlockSummary const > summary ) const
+{
+    SummaryMap::iterator it = m_summaries.find( block );
+    if( it != m_summaries.end() )
+    {
+        return it->second.first;
+    }
+
+    m_summaryOrder.push_front( block );
+    m_summaries[ block ] = std::make_pair( summary, m_summaryOrder.begin() );
+    if( m_summaryOrder.size() > m_maxCachedSummaries )
+    {
+        m_summaries.erase( m_summaryOrder.back() );
+        m_summaryOrder.pop_back();
+    }
+    return summary;
+}
+
+std::shared_ptr< WEEG2Segment::BlockSummary const > WEEG2Segment::computeSummary( WEEGValueMatrix const& values ) const
+{
+    std::shared_ptr< BlockSummary > summary( new BlockSummary );
+    std::size_t const nbSamples = values.empty() ? 0 : values.front().size();
+
+    // the finest level from the samples
+    std::size_t nbBuckets = ( nbSamples + SUMMARY_BUCKET_SIZE - 1 ) / SUMMARY_BUCKET_SIZE;
+    summary->push_back( std::vector< float >( 2 * m_nbChannels * nbBuckets ) );
+    for( std::size_t channelID = 0; channelID < m_nbChannels; ++channelID )
+    {
+        std::vector< double > const& channel = values[ channelID ];
+        float* minMax = &summary->back()[ 2 * channelID * nbBuckets ];
+        for( std::size_t bucket = 0; bucket < nbBuckets; ++bucket )
+        {
+            std::vector< double >::const_iterator begin = channel.begin() + bucket * SUMMARY_BUCKET_SIZE;
+            std::vector< double >::const_iterator end = channel.begin() + std::min( nbSamples, ( bucket + 1 ) * SUMMARY_BUCKET_SIZE );
+            std::pair< std::vector< double >::const_iterator, std::vector< double >::const_iterator > range
+                = std::minmax_element( begin, end );
+            minMax[ 2 * bucket ] = static_cast< float >( *range.first );
+            minMax[ 2 * bucket + 1 ] = static_cast< float >( *range.second );
+        }
+    }
+
+    // each coarser level combines four buckets of the previous one
+    for( std::size_t bucketSize = SUMMARY_BUCKET_SIZE * 4; bucketSize <= m_blockSize; bucketSize *= 4 )
+    {
+        std::size_t const nbFinerBuckets = nbBuckets;
+        nbBuckets = ( nbFinerBuckets + 3 ) / 4;
+        std::vector< float > level( 2 * m_nbChannels * nbBuckets );
+        std::vector< float > const& finer = summary->back();
+        for( std::size_t channelID = 0; channelID < m_nbChannels; ++channelID )
+        {
+            float const* in = &finer[ 2 * channelID * nbFinerBuckets ];
+            float* out = &level[ 2 * channelID * nbBuckets ];
+            for( std::size_t bucket = 0; bucket < nbBuckets; ++bucket )
+            {
+                std::size_t const end = std::min( nbFinerBuckets, 4 * bucket + 4 );
+                out[ 2 * bucket ] = in[ 8 * bucket ];
+                out[ 2 * bucket + 1 ] = in[ 8 * bucket + 1 ];
+                for( std::size_t i = 4 * bucket + 1; i < end; ++i )
+                {
+                    out[ 2 * bucket ] = std::min( out[ 2 * bucket ], in[ 2 * i ] );
+                    out[ 2 * bucket + 1 ] = std::max( out[ 2 * bucket + 1 ], in[ 2 * i + 1 ] );
+                }
+            }
+        }
+        summary->push_back( level );
+    }
+    return summary;
+}
+
+void WEEG2Segment::readAhead( std::size_t start, std::size_t firstBlock, std::size_t lastBlock ) const
+{
+    std::lock_guard< std::mutex > lock( m_cacheMutex );
+
+    bool const forward = start >= m_lastStart;
+    m_lastStart = start;
+
+    std::size_t const nbBlocks = ( m_nbSamples + m_blockSize - 1 ) / m_blockSize;
+    if( ( forward && lastBlock + 1 >= nbBlocks ) || ( !forward && firstBlock == 0 ) )
+    {
+        return;
+    }
+    std::size_t const block = forward ? lastBlock + 1 : firstBlock - 1;
+
+    for( std::list< std::pair< std::size_t, std::shared_ptr< WEEGValueMatrix const > > >::const_iterator it = m_blocks.begin();
+         it != m_blocks.end(); ++it )
+    {
+        if( it->first == block )
+        {
+            return;
+        }
+    }
+
+    // only one block is read ahead at a time, the previous thread has finished if the flag is not set
+    if( m_readAheadRunning )
+    {
+        return;
+    }
+    if( m_readAheadThread.joinable() )
+    {
+        m_readAheadThread.join();
+    }
+    m_readAheadRunning = true;
+    m_readAheadThread = std::thread( [ this, block ]()
+    {
+        try
+        {
+            getBlock( block );
+        }
+        catch( WException const& e )
+        {
+            wlog::warn( "WEEG2Segment" ) << "Reading ahead failed: " << e.what();
+        }
+        m_readAheadRunning = false;
+    } );
 }
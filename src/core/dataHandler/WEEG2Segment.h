@@ -25,8 +25,15 @@
 #ifndef WEEG2SEGMENT_H
 #define WEEG2SEGMENT_H
 
+#include <atomic>
 #include <cstddef>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 #include "WEEGValueMatrix.h"
@@ -36,6 +43,11 @@
 
 /**
  * Class which contains one segment of an EEG recording, read from a WPagerEEG.
+ *
+ * The samples are read in blocks of all channels, which are kept in a small cache shared by everyone using the segment.
+ * When a range is requested, the next block in the direction of movement is read in the background. For every block read,
+ * a min/max pyramid is computed. The pyramids are much smaller than the blocks, so a separate cache keeps them for many
+ * more blocks. They allow drawing long time ranges with a bounded number of points, see getMinMaxValues().
  * \ingroup dataHandler
  */
 class WEEG2Segment // NOLINT
@@ -50,6 +62,11 @@ public:
      */
     WEEG2Segment( std::size_t segmentID, std::shared_ptr< WPagerEEG > pager );
 
+    /**
+     * Destructor. Waits for a running read-ahead.
+     */
+    ~WEEG2Segment();
+
     /**
      * Get the number of samples this segment consists of.
      *
@@ -66,11 +83,104 @@ public:
      */
     std::shared_ptr< WEEGValueMatrix > getValues( std::size_t start, std::size_t length ) const;
 
+    /**
+     * Get the values of one channel for a sample range, reduced to at most about maxPoints points. If the range has more
+     * samples than that, it is split into buckets of equal size and the minimum and the maximum of each bucket are
+     * returned. Drawn as a line strip, this looks like the full resolution graph. The buckets are aligned to multiples
+     * of their size, so the points do not change when scrolling.
+     *
+     * \param channelID the channel
+     * \param start start sample of the sample range
+     * \param length length of the sample range
+     * \param maxPoints the maximum number of points, e.g. twice the number of pixels
+     * \param samples receives the sample position of each point
+     * \param values receives the value of each point
+     */
+    void getMinMaxValues( std::size_t channelID, std::size_t start, std::size_t length, std::size_t maxPoints,
+                          std::vector< double >* samples, std::vector< double >* values ) const;
+
+    /**
+     * Get the number of samples per cached block.
+     *
+     * \return number of samples
+     */
+    std::size_t getBlockSize() const;
+
 protected:
 private:
+    /**
+     * The min/max pyramid of a block. Level i has buckets of SUMMARY_BUCKET_SIZE * 4^i samples, the minimum and maximum
+     * of bucket b of channel c are stored at index 2 * ( c * numberOfBuckets + b ).
+     */
+    typedef std::vector< std::vector< float > > BlockSummary;
+
+    /**
+     * The cached pyramids by block index, each with its position in the order of use.
+     */
+    typedef std::map< std::size_t, std::pair< std::shared_ptr< BlockSummary const >, std::list< std::size_t >::iterator > > SummaryMap;
+
+    /**
+     * Get a block from the cache or read it from the pager.
+     *
+     * \param block the index of the block
+     * \return the values of all channels
+     */
+    std::shared_ptr< WEEGValueMatrix const > getBlock( std::size_t block ) const;
+
+    /**
+     * Get the min/max pyramid of a block. Reads the block, if it was not read before.
+     *
+     * \param block the index of the block
+     * \return the pyramid
+     */
+    std::shared_ptr< BlockSummary const > getBlockSummary( std::size_t block ) const;
+
+    /**
+     * Put a pyramid into the cache, evicting the least recently used one if the cache is full. The cache mutex must be locked.
+     *
+     * \param block the index of the block
+     * \param summary the pyramid of the block
+     * \return the cached pyramid, which is another one if the block was cached before
+     */
+    std::shared_ptr< BlockSummary const > storeSummary( std::size_t block, std::shared_ptr< BlockSummary const > summary ) const;
+
+    /**
+     * Compute the min/max pyramid of a block.
+     *
+     * \param values the values of the block
+     * \return the pyramid
+     */
+    std::shared_ptr< BlockSummary const > computeSummary( WEEGValueMatrix const& values ) const;
+
+    /**
+     * Read the block following the requested ones in the direction of movement in the background.
+     *
+     * \param start start sample of the current request
+     * \param firstBlock the first block of the current request
+     * \param lastBlock the last block of the current request
+     */
+    void readAhead( std::size_t start, std::size_t firstBlock, std::size_t lastBlock ) const;
+
+    //! the number of samples in the smallest bucket of the min/max pyramid
+    static const std::size_t SUMMARY_BUCKET_SIZE = 64;
+
     std::size_t m_segmentID; //!< number of this segment
     std::shared_ptr< WPagerEEG > m_pager; //!< pager class which contains the data, read from a file on demand
     std::size_t m_nbSamples; //!< number of samples this segment consists of
+    std::size_t m_nbChannels; //!< number of channels
+    std::size_t m_blockSize; //!< number of samples per block, SUMMARY_BUCKET_SIZE times a power of 4
+    std::size_t m_maxCachedBlocks; //!< the maximum number of blocks in the cache
+    std::size_t m_maxCachedSummaries; //!< the maximum number of pyramids in the cache
+
+    mutable std::mutex m_cacheMutex; //!< protects the cache, the pyramids and the read-ahead state
+    //! cached blocks, most recently used first
+    mutable std::list< std::pair< std::size_t, std::shared_ptr< WEEGValueMatrix const > > > m_blocks;
+    mutable SummaryMap m_summaries; //!< cached pyramids
+    mutable std::list< std::size_t > m_summaryOrder; //!< blocks of the cached pyramids, most recently used first
+
+    mutable std::thread m_readAheadThread; //!< the thread reading ahead
+    mutable std::atomic< bool > m_readAheadRunning; //!< true while the read-ahead thread works
+    mutable std::size_t m_lastStart; //!< start sample of the previous request, to determine the direction of movement
 };
 
 #endif  // WEEG2SEGMENT_H
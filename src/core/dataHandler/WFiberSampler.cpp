@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "WFiberSampler.h"
+#include "WFiberView.h"
+#include "WGridRegular3D.h"
+#include "WValueSet.h"
+#include "exceptions/WDHException.h"
+
+WFiberSampler::WFiberSampler( WDataSetScalar const& data, double outside )
+    : m_valueSet( data.getValueSet() ),
+      m_outside( outside )
+{
+    std::shared_ptr< WGridRegular3D > grid = std::dynamic_pointer_cast< WGridRegular3D >( data.getGrid() );
+    if( !grid )
+    {
+        throw WDHException( std::string( "Sampling fibers needs a dataset on a regular grid." ) );
+    }
+    if( m_valueSet->order() != 0 || m_valueSet->dimension() != 1 )
+    {
+        throw WDHException( std::string( "Sampling fibers needs a scalar dataset." ) );
+    }
+
+    WGridTransformOrtho const transform = grid->getTransform();
+    WVector3d const origin = transform.getOrigin();
+    WVector3d const directions[] = { transform.getUnitDirectionX(), transform.getUnitDirectionY(), // NOLINT curly braces
+                                     transform.getUnitDirectionZ() };
+    double const scaling[] = { transform.getOffsetX(), transform.getOffsetY(), transform.getOffsetZ() }; // NOLINT curly braces
+    for( std::size_t i = 0; i < 3; ++i )
+    {
+        m_origin[ i ] = origin[ i ];
+        for( std::size_t j = 0; j < 3; ++j )
+        {
+            m_toGrid[ i ][ j ] = directions[ i ][ j ] / scaling[ i ];
+        }
+    }
+    m_nbCoords[ 0 ] = grid->getNbCoordsX();
+    m_nbCoords[ 1 ] = grid->getNbCoordsY();
+    m_nbCoords[ 2 ] = grid->getNbCoordsZ();
+
+    switch( m_valueSet->getDataType() )
+    {
+        case W_DT_UNSIGNED_CHAR:
+            setDataType< uint8_t >();
+            break;
+        case W_DT_UINT16:
+            setDataType< uint16_t >();
+            break;
+        case W_DT_INT16:
+            setDataType< int16_t >();
+            break;
+        case W_DT_SIGNED_INT:
+            setDataType< int32_t >();
+            break;
+        case W_DT_FLOAT:
+            setDataType< float >();
+            break;
+        case W_DT_DOUBLE:
+            setDataType< double >();
+            break;
+        default:
+            throw WDHException( std::string( "Sampling fibers does not support the data type of the dataset." ) );
+    }
+}
+
+bool WFiberSampler::sample( WPosition const& pos, double* value ) const
+{
+    double const p[] = { pos[ 0 ], pos[ 1 ], pos[ 2 ] }; // NOLINT curly braces
+    return m_positionFunction( *this, p, value );
+}
+
+void WFiberSampler::sample( float const* vertices, std::size_t nbVertices, double* values ) const
+{
+    m_vertexFunction( *this, vertices, nbVertices, values );
+}
+
+WDataSetFibers::VertexParemeterArray WFiberSampler::sample( WDataSetFibers const& fibers ) const
+{
+    WFiberConstView const view = createFiberView( fibers );
+    WDataSetFibers::VertexParemeterArray values( new std::vector< double >( fibers.getVertices()->size() / 3, m_outside ) );
+    double* target = values->data();
+    forEachFiberBlock( view.size(), [ this, &view, target ]( std::size_t begin, std::size_t end )
+    {
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            sample( view[ i ].data(), view[ i ].size(), target + view.getStartIndex( i ) );
+        }
+    } );
+    return values;
+}
+
+WDataSetFibers::SPtr WFiberSampler::createSampledFibers( WDataSetFibers const& fibers ) const
+{
+    return WDataSetFibers::SPtr( new WDataSetFibers( fibers.getVertices(), fibers.getLineStartIndexes(), fibers.getLineLengths(),
+                                                     fibers.getVerticesReverse(), fibers.getBoundingBox(), sample( fibers ) ) );
+}
+
+template< typename T >
+bool WFiberSampler::interpolate( double const* pos, double* value ) const
+{
+    double const p[] = { pos[ 0 ] - m_origin[ 0 ], pos[ 1 ] - m_origin[ 1 ], pos[ 2 ] - m_origin[ 2 ] }; // NOLINT curly braces
+    double lambda[ 3 ];
+    std::size_t cell[ 3 ];
+    for( std::size_t i = 0; i < 3; ++i )
+    {
+        double const g = m_toGrid[ i ][ 0 ] * p[ 0 ] + m_toGrid[ i ][ 1 ] * p[ 1 ] + m_toGrid[ i ][ 2 ] * p[ 2 ];
+        double const c = std::floor( g );
+        // the same cells as WGridRegular3D::getCellId(), NaN positions are outside too
+        if( !( c >= 0.0 && c < static_cast< double >( m_nbCoords[ i ] ) - 1.0 ) )
+        {
+            *value = m_outside;
+            return false;
+        }
+        cell[ i ] = static_cast< std::size_t >( c );
+        lambda[ i ] = g - c;
+    }
+
+    std::size_t const dx = 1;
+    std::size_t const dy = m_nbCoords[ 0 ];
+    std::size_t const dz = m_nbCoords[ 0 ] * m_nbCoords[ 1 ];
+    T const* v = static_cast< T const* >( m_data ) + cell[ 0 ] + cell[ 1 ] * dy + cell[ 2 ] * dz;
+
+    // interpolate along x, then y, then z
+    double const c00 = v[ 0 ] + lambda[ 0 ] * ( static_cast< double >( v[ dx ] ) - v[ 0 ] );
+    double const c10 = v[ dy ] + lambda[ 0 ] * ( static_cast< double >( v[ dy + dx ] ) - v[ dy ] );
+    double const c01 = v[ dz ] + lambda[ 0 ] * ( static_cast< double >( v[ dz + dx ] ) - v[ dz ] );
+    double const c11 = v[ dz + dy ] + lambda[ 0 ] * ( static_cast< double >( v[ dz + dy + dx ] ) - v[ dz + dy ] );
+    double const c0 = c00 + lambda[ 1 ] * ( c10 - c00 );
+    double const c1 = c01 + lambda[ 1 ] * ( c11 - c01 );
+    *value = c0 + lambda[ 2 ] * ( c1 - c0 );
+    return true;
+}
+
+template< typename T >
+bool WFiberSampler::samplePosition( WFiberSampler const& sampler, double const* pos, double* value )
+{
+    return sampler.interpolate< T >( pos, value );
+}
+
+template< typename T >
+void WFiberSampler::sampleVertices( WFiberSampler const& sampler, float const* vertices, std::size_t nbVertices, double* values )
+{
+    for( std::size_t i = 0; i < nbVertices; ++i )
+    {
+        double const pos[] = { vertices[ 3 * i ], vertices[ 3 * i + 1 ], vertices[ 3 * i + 2 ] }; // NOLINT curly braces
+        sampler.interpolate< T >( pos, values + i );
+    }
+}
+
+template< typename T >
+void WFiberSampler::setDataType()
+{
+    m_data = std::dynamic_pointer_cast< WValueSet< T > >( m_valueSet )->rawData();
+    m_vertexFunction = &WFiberSampler::sampleVertices< T >;
+    m_positionFunction = &WFiberSampler::samplePosition< T >;
+}
@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERSAMPLER_H
+#define WFIBERSAMPLER_H
+
+#include <cstddef>
+#include <memory>
+
+#include "../common/math/linearAlgebra/WPosition.h"
+#include "WDataSetFibers.h"
+#include "WDataSetScalar.h"
+
+/**
+ * Samples a scalar dataset on a regular grid at the vertices of fibers using trilinear interpolation. The grid
+ * transformation and the typed value array are looked up once on construction, so sampling a vertex does neither
+ * virtual calls nor type dispatch. Sampling whole fiber datasets runs in parallel over the fibers.
+ *
+ * The sampled values equal WDataSetScalar::interpolate(), vertices outside the grid get a fixed value.
+ */
+class WFiberSampler // NOLINT
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param data the scalar dataset to sample
+     * \param outside the value of vertices outside the grid
+     *
+     * \throw WDHException if the dataset has no regular grid or an unsupported data type
+     */
+    explicit WFiberSampler( WDataSetScalar const& data, double outside = 0.0 );
+
+    /**
+     * Sample the dataset at a position.
+     *
+     * \param pos the position in world space
+     * \param[out] value receives the interpolated value or the outside value
+     *
+     * \return true if the position is inside the grid
+     */
+    bool sample( WPosition const& pos, double* value ) const;
+
+    /**
+     * Sample the dataset at the vertices of a flat x1,y1,z1,x2,y2,z2,... array.
+     *
+     * \param vertices the coordinates of the vertices
+     * \param nbVertices the number of vertices
+     * \param[out] values receives nbVertices values
+     */
+    void sample( float const* vertices, std::size_t nbVertices, double* values ) const;
+
+    /**
+     * Sample the dataset at all vertices of the fibers in parallel. The result has the same indexing as the vertices and
+     * can directly be used as vertex parameters of the fibers.
+     *
+     * \param fibers the fibers
+     *
+     * \return one value per vertex
+     */
+    WDataSetFibers::VertexParemeterArray sample( WDataSetFibers const& fibers ) const;
+
+    /**
+     * Create fibers sharing the vertices of the given fibers with the sampled values as vertex parameters.
+     *
+     * \param fibers the fibers
+     *
+     * \return the new fiber dataset
+     */
+    WDataSetFibers::SPtr createSampledFibers( WDataSetFibers const& fibers ) const;
+
+private:
+    //! samples vertices with the data type of the value set
+    typedef void ( *VertexFunction )( WFiberSampler const&, float const*, std::size_t, double* );
+
+    //! samples a position with the data type of the value set
+    typedef bool ( *PositionFunction )( WFiberSampler const&, double const*, double* );
+
+    /**
+     * Interpolate the values at a position.
+     *
+     * \tparam T the data type of the values
+     * \param pos the position in world space
+     * \param[out] value receives the interpolated value or the outside value
+     *
+     * \return true if the position is inside the grid
+     */
+    template< typename T >
+    bool interpolate( double const* pos, double* value ) const;
+
+    /**
+     * Sample a position with the given data type.
+     *
+     * \tparam T the data type of the values
+     * \param sampler the sampler
+     * \param pos the position in world space
+     * \param[out] value receives the interpolated value or the outside value
+     *
+     * \return true if the position is inside the grid
+     */
+    template< typename T >
+    static bool samplePosition( WFiberSampler const& sampler, double const* pos, double* value );
+
+    /**
+     * Sample vertices with the given data type.
+     *
+     * \tparam T the data type of the values
+     * \param sampler the sampler
+     * \param vertices the coordinates of the vertices
+     * \param nbVertices the number of vertices
+     * \param[out] values receives nbVertices values
+     */
+    template< typename T >
+    static void sampleVertices( WFiberSampler const& sampler, float const* vertices, std::size_t nbVertices, double* values );
+
+    /**
+     * Select the sample functions for a data type.
+     *
+     * \tparam T the data type of the values
+     */
+    template< typename T >
+    void setDataType();
+
+    //! keeps the values alive
+    std::shared_ptr< WValueSetBase > m_valueSet;
+
+    //! the raw values, the type is known to m_sampleFunction
+    void const* m_data;
+
+    //! samples vertices with the data type of the values
+    VertexFunction m_vertexFunction;
+
+    //! samples a position with the data type of the values
+    PositionFunction m_positionFunction;
+
+    //! the origin of the grid
+    double m_origin[ 3 ];
+
+    //! rows of the world to grid space matrix, the unit directions divided by the voxel sizes
+    double m_toGrid[ 3 ][ 3 ];
+
+    //! the number of grid positions per axis
+    std::size_t m_nbCoords[ 3 ];
+
+    //! the value of vertices outside the grid
+    double m_outside;
+};
+
+#endif  // WFIBERSAMPLER_H
@@ -0,0 +1,320 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/WAssert.h"
+#include "../common/WException.h"
+#include "../common/WLimits.h"
+#include "../common/WThreadedFunction.h"
+#include "../common/math/WPolynomialEquationSolvers.h"
+#include "WFiberView.h"
+
+namespace
+{
+    /**
+     * Calls a function for consecutive blocks of fibers. The fibers are split evenly between the threads.
+     * To be used with WThreadedFunction.
+     */
+    class WFiberBlockThreadFunction
+    {
+    public:
+        /**
+         * Constructor.
+         *
+         * \param nbFibers The number of fibers.
+         * \param func The function to call for each block.
+         */
+        WFiberBlockThreadFunction( std::size_t nbFibers, WFiberBlockFunction const& func )
+            : m_nbFibers( nbFibers ),
+              m_func( func )
+        {
+        }
+
+        /**
+         * Processes the fibers of this thread.
+         *
+         * \param id The number of this thread.
+         * \param mx The number of threads.
+         * \param stop Set if the computation should be stopped.
+         */
+        void operator()( std::size_t id, std::size_t mx, WBoolFlag const& stop )
+        {
+            std::size_t const begin = m_nbFibers * id / mx;
+            std::size_t const end = m_nbFibers * ( id + 1 ) / mx;
+
+            // blocks keep stop requests responsive without calling the function for every fiber
+            std::size_t const blockSize = 1024;
+            for( std::size_t block = begin; block < end && !stop(); block += blockSize )
+            {
+                m_func( block, std::min( block + blockSize, end ) );
+            }
+        }
+
+    private:
+        //! the number of fibers
+        std::size_t m_nbFibers;
+
+        //! the function
+        WFiberBlockFunction m_func;
+    };
+
+    /**
+     * The next vertex of a fiber which differs from the given one, see WLine::removeAdjacentDuplicates().
+     *
+     * \param fiber The fiber.
+     * \param vertex The index of the vertex.
+     *
+     * \return The index of the next different vertex, or the size of the fiber if there is none.
+     */
+    std::size_t nextDistinctVertex( WFiberConstSpan const& fiber, std::size_t vertex )
+    {
+        WPosition const position = fiber.getPosition( vertex );
+        std::size_t next = vertex + 1;
+        while( next < fiber.size() && length( fiber.getPosition( next ) - position ) <= wlimits::DBL_EPS )
+        {
+            ++next;
+        }
+        return next;
+    }
+}
+
+WFiberConstView createFiberView( WDataSetFibers const& fibers )
+{
+    WDataSetFibers::VertexArray vertices = fibers.getVertices();
+    WDataSetFibers::IndexArray startIndexes = fibers.getLineStartIndexes();
+    WDataSetFibers::LengthArray lengths = fibers.getLineLengths();
+    return WFiberConstView( vertices->empty() ? NULL : &( *vertices )[ 0 ],
+                            startIndexes->empty() ? NULL : &( *startIndexes )[ 0 ],
+                            lengths->empty() ? NULL : &( *lengths )[ 0 ],
+                            startIndexes->size() );
+}
+
+WFiberView createFiberView( std::vector< float >* vertices, std::vector< std::size_t > const& startIndexes,
+                            std::vector< std::size_t > const& lengths )
+{
+    return WFiberView( vertices->empty() ? NULL : &( *vertices )[ 0 ],
+                       startIndexes.empty() ? NULL : &startIndexes[ 0 ],
+                       lengths.empty() ? NULL : &lengths[ 0 ],
+                       startIndexes.size() );
+}
+
+WDataSetFibers::IndexArray createStartIndexes( std::vector< std::size_t > const& lengths )
+{
+    WDataSetFibers::IndexArray startIndexes( new std::vector< std::size_t >( lengths.size() ) );
+    std::size_t start = 0;
+    for( std::size_t fiber = 0; fiber < lengths.size(); ++fiber )
+    {
+        ( *startIndexes )[ fiber ] = start;
+        start += lengths[ fiber ];
+    }
+    return startIndexes;
+}
+
+WDataSetFibers::IndexArray createVerticesReverse( std::vector< std::size_t > const& lengths )
+{
+    WDataSetFibers::IndexArray reverse( new std::vector< std::size_t >() );
+    std::size_t nbVertices = 0;
+    for( std::size_t fiber = 0; fiber < lengths.size(); ++fiber )
+    {
+        nbVertices += lengths[ fiber ];
+    }
+    reverse->reserve( nbVertices );
+    for( std::size_t fiber = 0; fiber < lengths.size(); ++fiber )
+    {
+        reverse->insert( reverse->end(), lengths[ fiber ], fiber );
+    }
+    return reverse;
+}
+
+void computeArcLength( float const* vertices, std::size_t size, double* arcLength )
+{
+    if( size == 0 )
+    {
+        return;
+    }
+
+    // the segment lengths do not depend on each other and are vectorized by the compiler, only the sum is sequential
+    arcLength[ 0 ] = 0.0;
+    for( std::size_t i = 1; i < size; ++i )
+    {
+        float const* a = vertices + 3 * ( i - 1 );
+        double const dx = a[ 3 ] - a[ 0 ];
+        double const dy = a[ 4 ] - a[ 1 ];
+        double const dz = a[ 5 ] - a[ 2 ];
+        arcLength[ i ] = std::sqrt( dx * dx + dy * dy + dz * dz );
+    }
+    for( std::size_t i = 1; i < size; ++i )
+    {
+        arcLength[ i ] += arcLength[ i - 1 ];
+    }
+}
+
+void resampleByNumberOfPoints( WFiberConstSpan const& fiber, WFiberSpan const& target, std::vector< double >* arcLength )
+{
+    std::size_t const numPoints = target.size();
+    if( fiber.size() == numPoints )
+    {
+        std::copy( fiber.data(), fiber.data() + 3 * numPoints, target.data() );
+        return;
+    }
+
+    arcLength->resize( fiber.size() );
+    computeArcLength( fiber.data(), fiber.size(), arcLength->data() );
+    double const length = arcLength->back();
+    if( fiber.size() == 1 || length <= 0.0 )
+    {
+        for( std::size_t i = 0; i < numPoints; ++i )
+        {
+            std::copy( fiber[ 0 ], fiber[ 0 ] + 3, target[ i ] );
+        }
+        return;
+    }
+
+    // walk along the fiber once, the segment containing the next sample point is never before the current one
+    double const step = length / static_cast< double >( numPoints - 1 );
+    std::size_t segment = 0;
+    std::copy( fiber[ 0 ], fiber[ 0 ] + 3, target[ 0 ] );
+    for( std::size_t i = 1; i + 1 < numPoints; ++i )
+    {
+        double const position = step * static_cast< double >( i );
+        while( segment + 2 < fiber.size() && ( *arcLength )[ segment + 1 ] < position )
+        {
+            ++segment;
+        }
+
+        double const segmentLength = ( *arcLength )[ segment + 1 ] - ( *arcLength )[ segment ];
+        double t = 0.0;
+        if( segmentLength > 0.0 )
+        {
+            t = std::min( std::max( ( position - ( *arcLength )[ segment ] ) / segmentLength, 0.0 ), 1.0 );
+        }
+        float const* a = fiber[ segment ];
+        float const* b = fiber[ segment + 1 ];
+        float* v = target[ i ];
+        for( std::size_t c = 0; c < 3; ++c )
+        {
+            v[ c ] = static_cast< float >( a[ c ] + t * ( b[ c ] - a[ c ] ) );
+        }
+    }
+    std::copy( fiber[ fiber.size() - 1 ], fiber[ fiber.size() - 1 ] + 3, target[ numPoints - 1 ] );
+}
+
+std::size_t resampleBySegmentLength( WFiberConstSpan const& fiber, double segmentLength, bool keepShortFibers, WFiberSpan const* target )
+{
+    if( fiber.size() == 0 )
+    {
+        return 0;
+    }
+
+    // walk along the fiber once, skipping adjacent duplicates, current is the first vertex not yet passed
+    WPosition last = fiber.getPosition( 0 );
+    std::size_t size = 1;
+    if( target )
+    {
+        target->setPosition( 0, last );
+    }
+    std::size_t previous = 0;
+    std::size_t current = nextDistinctVertex( fiber, 0 );
+    while( current < fiber.size() )
+    {
+        // find the first vertex outside of a sphere of radius segmentLength around the last new vertex
+        std::size_t const first = current;
+        while( current < fiber.size() && length( last - fiber.getPosition( current ) ) < segmentLength )
+        {
+            previous = current;
+            current = nextDistinctVertex( fiber, current );
+        }
+
+        if( current == fiber.size() )
+        {
+            if( keepShortFibers && length( last - fiber.getPosition( previous ) ) > 0.001 )
+            {
+                if( target )
+                {
+                    target->setPosition( size, fiber.getPosition( previous ) );
+                }
+                ++size;
+            }
+            break;
+        }
+
+        WPosition const position = fiber.getPosition( current );
+        if( current == first )
+        {
+            last = last + normalize( position - last ) * segmentLength;
+        }
+        else
+        {
+            // the intersection of the sphere with the segment entering it
+            WPosition const pred = fiber.getPosition( previous );
+            WVector3d const lineDirection = position - pred;
+            WVector3d const o_c = pred - last;
+            double const alpha = dot( lineDirection, lineDirection );
+            double const beta = 2.0 * dot( lineDirection, o_c );
+            double const gamma = dot( o_c, o_c ) - segmentLength * segmentLength;
+
+            std::pair< std::complex< double >, std::complex< double > > solution = solveRealQuadraticEquation( alpha, beta, gamma );
+            WAssert( std::imag( solution.first ) == 0.0 && std::imag( solution.second ) == 0.0, "Imaginary solution detected." );
+            double const t = std::real( solution.first ) > 0.0 ? std::real( solution.first ) : std::real( solution.second );
+            last = pred + t * lineDirection;
+        }
+        if( target )
+        {
+            target->setPosition( size, last );
+        }
+        ++size;
+    }
+    return size;
+}
+
+void forEachFiberBlock( std::size_t nbFibers, WFiberBlockFunction const& func )
+{
+    if( nbFibers == 0 )
+    {
+        return;
+    }
+
+    // starting threads for a single block costs more than they save
+    if( nbFibers <= 1024 )
+    {
+        func( 0, nbFibers );
+        return;
+    }
+
+    std::shared_ptr< WFiberBlockThreadFunction > function( new WFiberBlockThreadFunction( nbFibers, func ) );
+    WThreadedFunction< WFiberBlockThreadFunction > pool( W_AUTOMATIC_NB_THREADS, function );
+    pool.run();
+    pool.wait();
+    if( pool.status() != W_THREADS_FINISHED )
+    {
+        throw WException( std::string( "A thread processing the fibers was aborted." ) );
+    }
+}
@@ -0,0 +1,364 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERVIEW_H
+#define WFIBERVIEW_H
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <boost/function.hpp>
+
+#include "../common/math/WLine.h"
+#include "../common/math/linearAlgebra/WPosition.h"
+#include "WDataSetFibers.h"
+
+/**
+ * A non-owning view of the vertices of a single fiber inside a flat x1,y1,z1,x2,y2,z2,... float array. Use
+ * WFiberSpan for writable and WFiberConstSpan for read-only vertices.
+ */
+template< typename T >
+class WFiberSpanT
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param vertices pointer to the x coordinate of the first vertex
+     * \param size the number of vertices
+     */
+    WFiberSpanT( T* vertices, std::size_t size )
+        : m_vertices( vertices ),
+          m_size( size )
+    {
+    }
+
+    /**
+     * The number of vertices.
+     *
+     * \return number of vertices
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * The coordinates of the vertices.
+     *
+     * \return pointer to 3 * size() floats
+     */
+    T* data() const
+    {
+        return m_vertices;
+    }
+
+    /**
+     * The coordinates of a vertex.
+     *
+     * \param vertex the vertex index inside this fiber
+     * \return pointer to x, y and z
+     */
+    T* operator[]( std::size_t vertex ) const
+    {
+        return m_vertices + 3 * vertex;
+    }
+
+    /**
+     * The position of a vertex.
+     *
+     * \param vertex the vertex index inside this fiber
+     * \return the position
+     */
+    WPosition getPosition( std::size_t vertex ) const
+    {
+        T* v = m_vertices + 3 * vertex;
+        return WPosition( v[ 0 ], v[ 1 ], v[ 2 ] );
+    }
+
+    /**
+     * Set the position of a vertex. Only available for writable spans.
+     *
+     * \param vertex the vertex index inside this fiber
+     * \param position the new position
+     */
+    void setPosition( std::size_t vertex, WPosition const& position ) const
+    {
+        T* v = m_vertices + 3 * vertex;
+        v[ 0 ] = static_cast< float >( position[ 0 ] );
+        v[ 1 ] = static_cast< float >( position[ 1 ] );
+        v[ 2 ] = static_cast< float >( position[ 2 ] );
+    }
+
+    /**
+     * The sum of the segment lengths.
+     *
+     * \return the length of the fiber
+     */
+    double getLength() const
+    {
+        double length = 0.0;
+        for( std::size_t i = 1; i < m_size; ++i )
+        {
+            T* a = m_vertices + 3 * ( i - 1 );
+            T* b = a + 3;
+            double const dx = b[ 0 ] - a[ 0 ];
+            double const dy = b[ 1 ] - a[ 1 ];
+            double const dz = b[ 2 ] - a[ 2 ];
+            length += std::sqrt( dx * dx + dy * dy + dz * dz );
+        }
+        return length;
+    }
+
+    /**
+     * Copy the vertices into a line, reusing the memory of the line.
+     *
+     * \param line the line to overwrite
+     */
+    void copyTo( WLine* line ) const
+    {
+        line->resize( m_size );
+        for( std::size_t i = 0; i < m_size; ++i )
+        {
+            ( *line )[ i ] = getPosition( i );
+        }
+    }
+
+private:
+    //! the first coordinate of the first vertex
+    T* m_vertices;
+
+    //! the number of vertices
+    std::size_t m_size;
+};
+
+//! writable vertices of one fiber
+typedef WFiberSpanT< float > WFiberSpan;
+
+//! read-only vertices of one fiber
+typedef WFiberSpanT< float const > WFiberConstSpan;
+
+/**
+ * A non-owning view of fibers stored as flat vertex, start index and length arrays, the layout of WDataSetFibers.
+ * Fibers are accessed as spans without copying them into WFiber objects. The arrays must outlive the view. Use
+ * WFiberView for writable and WFiberConstView for read-only vertices.
+ */
+template< typename T >
+class WFiberViewT
+{
+public:
+    //! the span type of a single fiber
+    typedef WFiberSpanT< T > Span;
+
+    /**
+     * Constructor.
+     *
+     * \param vertices the vertices, 3 floats per vertex
+     * \param startIndexes the index of the first vertex of each fiber, in vertices not floats
+     * \param lengths the number of vertices of each fiber
+     * \param nbFibers the number of fibers
+     */
+    WFiberViewT( T* vertices, std::size_t const* startIndexes, std::size_t const* lengths, std::size_t nbFibers )
+        : m_vertices( vertices ),
+          m_startIndexes( startIndexes ),
+          m_lengths( lengths ),
+          m_nbFibers( nbFibers )
+    {
+    }
+
+    /**
+     * The number of fibers.
+     *
+     * \return number of fibers
+     */
+    std::size_t size() const
+    {
+        return m_nbFibers;
+    }
+
+    /**
+     * The vertices of a fiber.
+     *
+     * \param fiber the fiber index
+     * \return the span of the fiber
+     */
+    Span operator[]( std::size_t fiber ) const
+    {
+        return Span( m_vertices + 3 * m_startIndexes[ fiber ], m_lengths[ fiber ] );
+    }
+
+    /**
+     * The index of the first vertex of a fiber.
+     *
+     * \param fiber the fiber index
+     * \return the vertex index
+     */
+    std::size_t getStartIndex( std::size_t fiber ) const
+    {
+        return m_startIndexes[ fiber ];
+    }
+
+    /**
+     * The number of vertices of a fiber.
+     *
+     * \param fiber the fiber index
+     * \return number of vertices
+     */
+    std::size_t getLength( std::size_t fiber ) const
+    {
+        return m_lengths[ fiber ];
+    }
+
+private:
+    //! the vertices
+    T* m_vertices;
+
+    //! the start vertex of each fiber
+    std::size_t const* m_startIndexes;
+
+    //! the number of vertices of each fiber
+    std::size_t const* m_lengths;
+
+    //! the number of fibers
+    std::size_t m_nbFibers;
+};
+
+//! fibers with writable vertices
+typedef WFiberViewT< float > WFiberView;
+
+//! fibers with read-only vertices
+typedef WFiberViewT< float const > WFiberConstView;
+
+/**
+ * Create a read-only view of the fibers of a dataset. The dataset must outlive the view.
+ *
+ * \param fibers the fiber dataset
+ * \return the view
+ */
+WFiberConstView createFiberView( WDataSetFibers const& fibers );
+
+/**
+ * Create a writable view of fibers stored in flat arrays, e.g. the preallocated output of an algorithm. The arrays must
+ * outlive the view and must not be resized while it is used.
+ *
+ * \param vertices the vertices, 3 floats per vertex
+ * \param startIndexes the index of the first vertex of each fiber
+ * \param lengths the number of vertices of each fiber
+ * \return the view
+ */
+WFiberView createFiberView( std::vector< float >* vertices, std::vector< std::size_t > const& startIndexes,
+                            std::vector< std::size_t > const& lengths );
+
+/**
+ * Compute the start index of every fiber from the fiber lengths, the fibers are stored consecutively.
+ *
+ * \param lengths the number of vertices of each fiber
+ * \return the start indexes
+ */
+WDataSetFibers::IndexArray createStartIndexes( std::vector< std::size_t > const& lengths );
+
+/**
+ * Compute the fiber index of every vertex, as needed for the verticesReverse array of WDataSetFibers.
+ *
+ * \param lengths the number of vertices of each fiber, the fibers are stored consecutively
+ * \return the fiber index of each vertex
+ */
+WDataSetFibers::IndexArray createVerticesReverse( std::vector< std::size_t > const& lengths );
+
+/**
+ * Compute the arc length from the first vertex to each vertex of a fiber.
+ *
+ * \param vertices the vertices, 3 floats per vertex
+ * \param size the number of vertices
+ * \param arcLength receives size values, the first is zero
+ */
+void computeArcLength( float const* vertices, std::size_t size, double* arcLength );
+
+/**
+ * Resample a fiber to the number of vertices of the target, placed at equal arc length distances. The first and last
+ * vertex are kept, a fiber with as many vertices as the target is copied unchanged. Unlike WLine::resampleByNumberOfPoints()
+ * this never misses the last vertex due to rounding errors.
+ *
+ * \param fiber the fiber to resample, with at least one vertex
+ * \param target the vertices of the resampled fiber, at least two
+ * \param arcLength buffer for the arc length of the vertices of fiber, may be reused between calls
+ */
+void resampleByNumberOfPoints( WFiberConstSpan const& fiber, WFiberSpan const& target, std::vector< double >* arcLength );
+
+/**
+ * Resample a fiber to segments of the given length, with the same result as WLine::resampleBySegmentLength() or
+ * WLine::resampleBySegmentLengthKeepShortFibers() on a copy of the fiber. Without a target only the number of vertices of
+ * the result is computed, so the output can be allocated before the vertices are written.
+ *
+ * \param fiber the fiber to resample
+ * \param segmentLength the distance between consecutive vertices of the result
+ * \param keepShortFibers append the last vertex of the fiber if the remainder is shorter than a segment
+ * \param target receives the vertices if not NULL, it must have as many vertices as returned without target
+ * \return the number of vertices of the resampled fiber
+ */
+std::size_t resampleBySegmentLength( WFiberConstSpan const& fiber, double segmentLength, bool keepShortFibers, WFiberSpan const* target );
+
+//! a function called for the fibers [ begin, end )
+typedef boost::function< void ( std::size_t, std::size_t ) > WFiberBlockFunction;
+
+/**
+ * Call a function for consecutive blocks of fibers in parallel and wait for all threads to finish. Each fiber is
+ * processed by exactly one call, so writing per fiber results into preallocated arrays needs no locking. A single block
+ * is processed in the calling thread.
+ *
+ * \param nbFibers the number of fibers
+ * \param func the function to call for each block
+ *
+ * \throw WException if a thread was aborted
+ */
+void forEachFiberBlock( std::size_t nbFibers, WFiberBlockFunction const& func );
+
+/**
+ * Transform all vertices of the input fibers and write them to the same vertices of the output fibers in parallel. Both
+ * views need to have the same fibers with the same lengths, they may share the vertex array for an in-place transform.
+ *
+ * \param in the input fibers
+ * \param out the output fibers
+ * \param func the function mapping an input position to the output position
+ */
+template< typename Func >
+void transformFibers( WFiberConstView const& in, WFiberView const& out, Func func )
+{
+    forEachFiberBlock( in.size(), [ &in, &out, &func ]( std::size_t begin, std::size_t end )
+    {
+        for( std::size_t fiber = begin; fiber < end; ++fiber )
+        {
+            WFiberConstSpan const source = in[ fiber ];
+            WFiberSpan const target = out[ fiber ];
+            for( std::size_t i = 0; i < source.size(); ++i )
+            {
+                target.setPosition( i, func( source.getPosition( i ) ) );
+            }
+        }
+    } );
+}
+
+#endif  // WFIBERVIEW_H
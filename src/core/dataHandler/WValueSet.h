@@ -38,6 +38,7 @@
 #include "../common/math/linearAlgebra/WVectorFixed.h"
 #include "WDataHandlerEnums.h"
 #include "WValueSetBase.h"
+#include "WValueView.h"
 
 /**
  * Base Class for all value set types.
@@ -210,7 +211,16 @@ public:
      */
     virtual WValue< double > getWValueDouble( size_t i ) const
     {
-        return WValue< double >( getWValue( i ) );
+        WAssert( m_order == 1, "WValueSet<T>::getWValueDouble only implemented for order==1 value sets" );
+        WAssert( ( i + 1 ) * m_dimension <= m_data->size(), "index in WValueSet<T>::getWValueDouble too big" );
+
+        // convert while copying instead of creating a temporary WValue< T >
+        WValue< double > result( m_dimension );
+        for( std::size_t j = 0; j < m_dimension; ++j )
+        {
+            result[ j ] = static_cast< double >( ( *m_data )[ i * m_dimension + j ] );
+        }
+        return result;
     }
 
     /**
@@ -232,6 +242,18 @@ public:
      */
     WValue< T > getWValue( size_t index ) const;
 
+    /**
+     * Get a view of the i'th value. In contrast to \ref getWValue, this does not copy anything. Use it in per-voxel loops.
+     *
+     * \tparam N the dimension of the value set, checked at runtime
+     *
+     * \param index the index number of the value
+     *
+     * \return a view of the value, valid as long as this value set exists
+     */
+    template< std::size_t N >
+    WValueView< T, N > getValueView( size_t index ) const;
+
     /**
      * Sometimes we need raw access to the data array, for e.g. OpenGL.
      *
@@ -353,6 +375,16 @@ template< typename T > WValue< T > WValueSet< T >::getWValue( size_t index ) con
     return result;
 }
 
+template< typename T >
+template< std::size_t N >
+WValueView< T, N > WValueSet< T >::getValueView( size_t index ) const
+{
+    WAssert( m_order == 1, "WValueSet<T>::getValueView only implemented for order==1 value sets" );
+    WAssert( m_dimension == N, "WValueSet<T>::getValueView used with the wrong dimension" );
+    WAssert( ( index + 1 ) * N <= m_data->size(), "index in WValueSet<T>::getValueView too big" );
+    return WValueView< T, N >( rawData() + index * N );
+}
+
 template< typename T >
 size_t WValueSet< T >::getRequiredRawSizePerVoxel( size_t oder, size_t dimension )
 {
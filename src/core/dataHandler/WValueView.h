@@ -0,0 +1,163 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WVALUEVIEW_H
+#define WVALUEVIEW_H
+
+#include <cstddef>
+
+#include <boost/array.hpp>
+
+#include "../common/WAssert.h"
+#include "../common/math/WTensorSym.h"
+#include "../common/math/WValue.h"
+#include "../common/math/linearAlgebra/WMatrixFixed.h"
+
+/**
+ * A read-only view of a single value of a WValueSet with a dimension known at compile time. It does not copy the data, it simply points into
+ * the value set. Thus, it is cheap to create in per-voxel loops where WValueSet::getWValue would allocate a new WValue each time. The view is
+ * only valid as long as the value set exists.
+ *
+ * \tparam T the type of the components
+ * \tparam N the number of components
+ */
+template< typename T, std::size_t N >
+class WValueView
+{
+public:
+    /**
+     * Creates a view of the N components starting at data.
+     *
+     * \param data the first component
+     */
+    explicit WValueView( T const* data )
+        : m_data( data )
+    {
+    }
+
+    /**
+     * The number of components.
+     *
+     * \return N
+     */
+    static std::size_t size()
+    {
+        return N;
+    }
+
+    /**
+     * Access a component.
+     *
+     * \param i the component index
+     *
+     * \return the component
+     */
+    T const& operator[]( std::size_t i ) const
+    {
+        WAssert( i < N, "Index out of bounds." );
+        return m_data[ i ];
+    }
+
+    /**
+     * The first component.
+     *
+     * \return pointer to the first component
+     */
+    T const* begin() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Behind the last component.
+     *
+     * \return pointer behind the last component
+     */
+    T const* end() const
+    {
+        return m_data + N;
+    }
+
+    /**
+     * Copies the components into a column vector.
+     *
+     * \tparam S the component type of the vector
+     *
+     * \return the vector
+     */
+    template< typename S >
+    WMatrixFixed< S, N, 1 > toVector() const
+    {
+        WMatrixFixed< S, N, 1 > result;
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            result[ i ] = static_cast< S >( m_data[ i ] );
+        }
+        return result;
+    }
+
+    /**
+     * Copies the components into a symmetric tensor. They need to be ordered like the data of WTensorSym.
+     *
+     * \tparam order the order of the tensor
+     * \tparam dim the dimension of the tensor
+     *
+     * \return the tensor
+     */
+    template< std::size_t order, std::size_t dim >
+    WTensorSym< order, dim, T > toTensorSym() const
+    {
+        static_assert( WTensorBaseSym< order, dim, T >::dataSize == N, "The number of components does not fit the tensor." );
+        boost::array< T, N > components;
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            components[ i ] = m_data[ i ];
+        }
+        return WTensorSym< order, dim, T >( components );
+    }
+
+    /**
+     * Copies the components into a WValue. Note that this allocates.
+     *
+     * \tparam S the component type of the WValue
+     *
+     * \return the WValue
+     */
+    template< typename S >
+    WValue< S > toWValue() const
+    {
+        WValue< S > result( N );
+        for( std::size_t i = 0; i < N; ++i )
+        {
+            result[ i ] = static_cast< S >( m_data[ i ] );
+        }
+        return result;
+    }
+
+private:
+    //! the first component
+    T const* m_data;
+};
+
+#endif  // WVALUEVIEW_H
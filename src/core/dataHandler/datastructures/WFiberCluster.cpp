@@ -23,7 +23,6 @@
 //---------------------------------------------------------------------------
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,9 +30,11 @@
 
 #include "../../common/WLimits.h"
 #include "../../common/WTransferable.h"
+#include "../../common/datastructures/WUnionFind.h"
 #include "../../common/math/WMath.h"
 #include "../../common/math/WPlane.h"
 #include "../WDataSetFiberVector.h"
+#include "../WFiberView.h"
 #include "WFiberCluster.h"
 
 // The prototype as singleton. Created during first getPrototype() call
@@ -76,7 +77,7 @@ WFiberCluster::WFiberCluster( WFiberCluster::IndexListConstIterator indicesBegin
     m_longestLineCreationLock( new std::shared_mutex() )
 {
     // now copy the index list
-    std::copy( indicesBegin, indicesEnd, m_memberIndices.begin() );
+    m_memberIndices.assign( indicesBegin, indicesEnd );
 }
 
 WFiberCluster::WFiberCluster( const WFiberCluster& other )
@@ -108,16 +109,50 @@ WFiberCluster::~WFiberCluster()
     delete m_longestLineCreationLock;
 }
 
+std::vector< WFiberCluster::SPtr > WFiberCluster::createClusters( WUnionFind* components )
+{
+    // number the sets in the order of their smallest element and count their elements
+    size_t const nbFibers = components->size();
+    std::vector< size_t > setOfFiber( nbFibers );
+    std::vector< size_t > setOfRoot( nbFibers, nbFibers );
+    std::vector< size_t > setSizes;
+    for( size_t fiber = 0; fiber < nbFibers; ++fiber )
+    {
+        size_t const root = components->find( fiber );
+        if( setOfRoot[ root ] == nbFibers )
+        {
+            setOfRoot[ root ] = setSizes.size();
+            setSizes.push_back( 0 );
+        }
+        setOfFiber[ fiber ] = setOfRoot[ root ];
+        ++setSizes[ setOfFiber[ fiber ] ];
+    }
+
+    std::vector< SPtr > clusters( setSizes.size() );
+    for( size_t set = 0; set < setSizes.size(); ++set )
+    {
+        clusters[ set ] = SPtr( new WFiberCluster() );
+        clusters[ set ]->m_memberIndices.reserve( setSizes[ set ] );
+    }
+    for( size_t fiber = 0; fiber < nbFibers; ++fiber )
+    {
+        clusters[ setOfFiber[ fiber ] ]->m_memberIndices.push_back( fiber );
+    }
+    return clusters;
+}
+
 void WFiberCluster::merge( WFiberCluster& other ) // NOLINT
 {
-    WFiberCluster::IndexList::const_iterator cit = other.m_memberIndices.begin();
-    for( ; cit != other.m_memberIndices.end(); ++cit )
+    if( m_memberIndices.empty() )
     {
-        m_memberIndices.push_back( *cit );
+        m_memberIndices.swap( other.m_memberIndices );
     }
+    else
+    {
+        m_memberIndices.insert( m_memberIndices.end(), other.m_memberIndices.begin(), other.m_memberIndices.end() );
+    }
+    resetLines();
     // make sure that those indices aren't occuring anywhere else
-    other.m_centerLine.reset();     // they are not valid anymore
-    other.m_longestLine.reset();
     other.clear();
 }
 
@@ -126,6 +161,7 @@ void WFiberCluster::merge( WFiberCluster::IndexListConstIterator indicesBegin,
 {
     // now copy the index list
     m_memberIndices.insert( m_memberIndices.end(), indicesBegin, indicesEnd );
+    resetLines();
 }
 
 // NODOXYGEN
@@ -165,24 +201,40 @@ void WFiberCluster::generateCenterLine() const
         return;
     }
 
-    // make copies of the fibers
-    std::shared_ptr< WDataSetFiberVector > fibs( new WDataSetFiberVector() );
+    m_centerLine = std::shared_ptr< WFiber >( new WFiber() );
+    if( m_memberIndices.empty() )
+    {
+        return;
+    }
+
     size_t avgFiberSize = 0;
     for( WFiberCluster::IndexList::const_iterator cit = m_memberIndices.begin(); cit != m_memberIndices.end(); ++cit )
     {
-        fibs->push_back( m_fibs->at( *cit ) );
-        avgFiberSize += fibs->back().size();
+        avgFiberSize += m_fibs->at( *cit ).size();
     }
-    avgFiberSize /= fibs->size();
+    avgFiberSize /= m_memberIndices.size();
+
+    // make copies of the fibers
+    std::shared_ptr< WDataSetFiberVector > fibs( new WDataSetFiberVector() );
+    fibs->resize( m_memberIndices.size() );
+    forEachFiberBlock( fibs->size(), [ this, &fibs ]( size_t begin, size_t end )
+    {
+        for( size_t i = begin; i < end; ++i )
+        {
+            ( *fibs )[ i ] = m_fibs->at( m_memberIndices[ i ] );
+        }
+    } );
 
     unifyDirection( fibs );
 
-    for( WDataSetFiberVector::iterator cit = fibs->begin(); cit != fibs->end(); ++cit )
+    forEachFiberBlock( fibs->size(), [ &fibs, avgFiberSize ]( size_t begin, size_t end )
     {
-        cit->resampleByNumberOfPoints( avgFiberSize );
-    }
+        for( size_t i = begin; i < end; ++i )
+        {
+            ( *fibs )[ i ].resampleByNumberOfPoints( avgFiberSize );
+        }
+    } );
 
-    m_centerLine = std::shared_ptr< WFiber >( new WFiber() );
     m_centerLine->reserve( avgFiberSize );
     for( size_t i = 0; i < avgFiberSize; ++i )
     {
@@ -195,7 +247,10 @@ void WFiberCluster::generateCenterLine() const
         m_centerLine->push_back( avgPosition );
     }
 
-    elongateCenterLine();
+    if( m_centerLine->size() > 1 )
+    {
+        elongateCenterLine();
+    }
     lock.unlock();
 }
 
@@ -212,27 +267,25 @@ void WFiberCluster::generateLongestLine() const
 
     m_longestLine = std::shared_ptr< WFiber >( new WFiber() );
 
-    // empty datasets can be ignored
-    if( m_fibs->size() == 0 )
+    // empty clusters can be ignored
+    if( m_memberIndices.empty() )
     {
         return;
     }
 
+    // only the sizes are compared, the line is copied once
     size_t longest = 0;
-    size_t longestID = 0;
-    for( size_t cit = 0; cit < m_fibs->size(); ++cit )
+    size_t longestID = m_memberIndices.front();
+    for( WFiberCluster::IndexList::const_iterator cit = m_memberIndices.begin(); cit != m_memberIndices.end(); ++cit )
     {
-        if( m_fibs->at( cit ).size() > longest )
+        if( m_fibs->at( *cit ).size() > longest )
         {
-            longest = m_fibs->at( cit ).size();
-            longestID = cit;
+            longest = m_fibs->at( *cit ).size();
+            longestID = *cit;
         }
     }
 
-    for( WFiber::const_iterator cit = m_fibs->at( longestID ).begin(); cit != m_fibs->at( longestID ).end(); ++cit )
-    {
-        m_longestLine->push_back( *cit );
-    }
+    *m_longestLine = m_fibs->at( longestID );
 
     lock.unlock();
 }
@@ -246,39 +299,26 @@ void WFiberCluster::elongateCenterLine() const
     std::shared_ptr< WPosition > cutPoint( new WPosition( 0, 0, 0 ) );
     bool intersectionFound = true;
 
-    // in the beginning all fibers participate
-    std::shared_ptr< WDataSetFiberVector > fibs( new WDataSetFiberVector() );
-    for( WFiberCluster::IndexList::const_iterator cit = m_memberIndices.begin(); cit != m_memberIndices.end(); ++cit )
-    {
-        fibs->push_back( m_fibs->at( *cit ) );
-    }
+    // in the beginning all fibers participate, they are referenced by index instead of being copied
+    std::vector< size_t > fibs( m_memberIndices );
 
     while( intersectionFound )
     {
         intersectionFound = false;
         size_t intersectingFibers = 0;
 //        WPosition avg( 0, 0, 0 );
-        for( WDataSetFiberVector::iterator cit = fibs->begin(); cit != fibs->end(); )
+        // keep the intersecting fibers in place instead of erasing the others one by one
+        for( size_t i = 0; i < fibs.size(); ++i )
         {
-            if( intersectPlaneLineNearCP( p, *cit, cutPoint ) )
-            {
-                if( length( *cutPoint - p.getPosition() ) < 20 )
-                {
-//                    avg += *cutPoint;
-                    intersectingFibers++;
-                    intersectionFound = true;
-                    ++cit;
-                }
-                else
-                {
-                    cit = fibs->erase( cit );
-                }
-            }
-            else
+            if( intersectPlaneLineNearCP( p, m_fibs->at( fibs[ i ] ), cutPoint ) && length( *cutPoint - p.getPosition() ) < 20 )
             {
-                cit = fibs->erase( cit );
+//                avg += *cutPoint;
+                fibs[ intersectingFibers ] = fibs[ i ];
+                intersectingFibers++;
+                intersectionFound = true;
             }
         }
+        fibs.resize( intersectingFibers );
         if( intersectingFibers > 10 )
         {
             cL.insert( cL.begin(), cL[0] + ( cL[0] - cL[1] ) );
@@ -296,11 +336,7 @@ void WFiberCluster::elongateCenterLine() const
         }
     }
     // second ending of the centerline
-    std::shared_ptr< WDataSetFiberVector > fobs( new WDataSetFiberVector() );
-    for( WFiberCluster::IndexList::const_iterator cit = m_memberIndices.begin(); cit != m_memberIndices.end(); ++cit )
-    {
-        fobs->push_back( m_fibs->at( *cit ) );
-    }
+    std::vector< size_t > fobs( m_memberIndices );
 
     // try to discard other lines from other end
 
@@ -311,27 +347,18 @@ void WFiberCluster::elongateCenterLine() const
         intersectionFound = false;
         size_t intersectingFibers = 0;
 //        WPosition avg( 0, 0, 0 );
-        for( WDataSetFiberVector::iterator cit = fobs->begin(); cit != fobs->end(); )
+        // keep the intersecting fibers in place instead of erasing the others one by one
+        for( size_t i = 0; i < fobs.size(); ++i )
         {
-            if( intersectPlaneLineNearCP( q, *cit, cutPoint ) )
-            {
-                if( length( *cutPoint - q.getPosition() ) < 20 )
-                {
-//                    avg += *cutPoint;
-                    intersectingFibers++;
-                    intersectionFound = true;
-                    ++cit;
-                }
-                else
-                {
-                    cit = fobs->erase( cit );
-                }
-            }
-            else
+            if( intersectPlaneLineNearCP( q, m_fibs->at( fobs[ i ] ), cutPoint ) && length( *cutPoint - q.getPosition() ) < 20 )
             {
-                cit = fobs->erase( cit );
+//                avg += *cutPoint;
+                fobs[ intersectingFibers ] = fobs[ i ];
+                intersectingFibers++;
+                intersectionFound = true;
             }
         }
+        fobs.resize( intersectingFibers );
         if( intersectingFibers > 10 )
         {
             cL.push_back(  cL.back() + ( cL.back() - cL[ cL.size() - 2 ] ) );
@@ -367,24 +394,28 @@ void WFiberCluster::unifyDirection( std::shared_ptr< WDataSetFiberVector > fibs
     const WPosition m2    = firstFib.at( firstFib.size() * 2.0 / 3.0 );
     const WPosition end   = firstFib.back();
 
-    for( WDataSetFiberVector::iterator cit = fibs->begin() + 1; cit != fibs->end(); ++cit )
+    // every fiber is only compared with the first one
+    forEachFiberBlock( fibs->size() - 1, [ &fibs, &start, &m1, &m2, &end ]( size_t begin, size_t blockEnd )
     {
-        const WFiber& other = *cit;
-        double        distance = length2( start - other.front() ) +
-                                 length2( m1 - other.at( other.size() * 1.0 / 3.0 ) ) +
-                                 length2( m2 - other.at( other.size() * 2.0 / 3.0 ) ) +
-                                 length2( end - other.back() );
-        double inverseDistance = length2( start - other.back() ) +
-                                 length2( m1 - other.at( other.size() * 2.0 / 3.0 ) ) +
-                                 length2( m2 - other.at( other.size() * 1.0 / 3.0 ) ) +
-                                 length2( end - other.front() );
-        distance        /= 4.0;
-        inverseDistance /= 4.0;
-        if( inverseDistance < distance )
+        for( size_t i = begin + 1; i < blockEnd + 1; ++i )
         {
-            cit->reverseOrder();
+            WFiber& other = ( *fibs )[ i ];
+            double        distance = length2( start - other.front() ) +
+                                     length2( m1 - other.at( other.size() * 1.0 / 3.0 ) ) +
+                                     length2( m2 - other.at( other.size() * 2.0 / 3.0 ) ) +
+                                     length2( end - other.back() );
+            double inverseDistance = length2( start - other.back() ) +
+                                     length2( m1 - other.at( other.size() * 2.0 / 3.0 ) ) +
+                                     length2( m2 - other.at( other.size() * 1.0 / 3.0 ) ) +
+                                     length2( end - other.front() );
+            distance        /= 4.0;
+            inverseDistance /= 4.0;
+            if( inverseDistance < distance )
+            {
+                other.reverseOrder();
+            }
         }
-    }
+    } );
 }
 
 std::shared_ptr< WFiber > WFiberCluster::getCenterLine() const
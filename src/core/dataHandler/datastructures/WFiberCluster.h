@@ -25,7 +25,7 @@
 #ifndef WFIBERCLUSTER_H
 #define WFIBERCLUSTER_H
 
-#include <list>
+#include <algorithm>
 #include <memory>
 #include <shared_mutex>
 #include <string>
@@ -37,6 +37,7 @@
 #include "../../common/WTransferable.h"
 #include "../WDataSetFiberVector.h"
 
+class WUnionFind;
 
 /**
  * Represents a cluster of indices of a WDataSetFiberVector.
@@ -56,9 +57,9 @@ public:
     typedef std::shared_ptr< const WFiberCluster > ConstSPtr;
 
     /**
-     * This is the list of indices of fibers.
+     * This is the list of indices of fibers, stored contiguously.
      */
-    typedef std::list< size_t > IndexList;
+    typedef std::vector< size_t > IndexList;
 
     /**
      * Const iterator on the index list.
@@ -111,6 +112,16 @@ public:
      */
     virtual ~WFiberCluster();
 
+    /**
+     * Creates one cluster for each set of a union-find structure over fiber indices. Merging many clusters is cheaper with
+     * WUnionFind::merge() than with merge(), as the indices are only copied once here.
+     *
+     * \param components The sets of fibers, the elements are the fiber indices. Not const as finding the sets compresses paths.
+     *
+     * \return The clusters ordered by their smallest fiber index, the indices of each cluster are sorted ascending.
+     */
+    static std::vector< SPtr > createClusters( WUnionFind* components );
+
     /**
      * Returns true if there are no fibers in that cluster, false otherwise.
      *
@@ -290,19 +301,19 @@ public:
     std::shared_ptr< WFiber > getCenterLine() const;
 
     /**
-     * Returns the center line of this cluster. The longest line gets calculated during the first call if this method.
+     * Returns the longest line of this cluster. The longest line gets calculated during the first call if this method.
      *
      * \return Reference to the longest line
      */
     std::shared_ptr< WFiber > getLongestLine() const;
 
     /**
-     * Makes the hard work to compute the center line.
+     * Makes the hard work to compute the center line. The member fibers are copied, aligned and resampled in parallel.
      */
     void generateCenterLine() const;
 
     /**
-     * Makes the hard work to find the longest line.
+     * Makes the hard work to find the member fiber with the most points.
      */
     void generateLongestLine() const;
 
@@ -321,7 +332,8 @@ protected:
 
     /**
      * Alings all fibers within the given dataset to be in one main direction. But Alignment only may swap the ordering of the fibers
-     * but not the positions or something similar. We need this only for the centerline generation.
+     * but not the positions or something similar. We need this only for the centerline generation. The fibers are compared with
+     * the first one in parallel.
      *
      * \param fibs The dataset
      */
@@ -338,6 +350,11 @@ private:
      */
     void elongateCenterLine() const;
 
+    /**
+     * Drops the center line and longest line, they need to be recomputed after the members changed.
+     */
+    void resetLines();
+
     /**
      * All indices in this set are members of this cluster
      */
@@ -399,7 +416,9 @@ inline bool WFiberCluster::empty() const
 
 inline void WFiberCluster::sort()
 {
-    m_memberIndices.sort();
+    // the center line depends on the first fiber
+    std::sort( m_memberIndices.begin(), m_memberIndices.end() );
+    resetLines();
 }
 
 inline size_t WFiberCluster::size() const
@@ -410,6 +429,7 @@ inline size_t WFiberCluster::size() const
 inline void WFiberCluster::clear()
 {
     m_memberIndices.clear();
+    resetLines();
 }
 
 inline void WFiberCluster::setColor( WColor color )
@@ -470,6 +490,13 @@ inline const WFiberCluster::IndexList& WFiberCluster::getIndices() const
 inline void WFiberCluster::setIndices( const WFiberCluster::IndexList& indices )
 {
     m_memberIndices = indices;
+    resetLines();
+}
+
+inline void WFiberCluster::resetLines()
+{
+    m_centerLine.reset();
+    m_longestLine.reset();
 }
 
 inline std::ostream& operator<<( std::ostream& os, const WFiberCluster& c )
@@ -25,13 +25,14 @@
 #ifndef WFIBERCLUSTER_TEST_H
 #define WFIBERCLUSTER_TEST_H
 
-#include <list>
 #include <memory>
+#include <vector>
 
 #include <cxxtest/TestSuite.h>
 
 #include "../../../common/WLimits.h"
 #include "../../../common/WLogger.h"
+#include "../../../common/datastructures/WUnionFind.h"
 #include "../../test/WDataSetFiberVectorTraits.h"
 #include "../WFiberCluster.h"
 
@@ -50,17 +51,52 @@ public:
         WFiberCluster a( 1 );
         WFiberCluster b;
         size_t mydata[] = { 16, 2, 77, 29 }; // NOLINT
-        std::list< size_t > data( mydata, mydata + sizeof( mydata ) / sizeof( size_t ) );
+        WFiberCluster::IndexList data( mydata, mydata + sizeof( mydata ) / sizeof( size_t ) );
         b.m_memberIndices = data;
         a.merge( b );
         TS_ASSERT( b.empty() );
         size_t mxdata[] = { 1, 16, 2, 77, 29 }; // NOLINT
-        std::list< size_t > xdata( mxdata, mxdata + sizeof( mxdata ) / sizeof( size_t ) );
+        WFiberCluster::IndexList xdata( mxdata, mxdata + sizeof( mxdata ) / sizeof( size_t ) );
         WFiberCluster expected;
         expected.m_memberIndices = xdata;
         TS_ASSERT_EQUALS( expected, a );
     }
 
+    /**
+     * Clusters created from a union-find structure contain the sorted members of each set.
+     */
+    void testCreateClusters( void )
+    {
+        WUnionFind components( 6 );
+        components.merge( 4, 1 );
+        components.merge( 5, 0 );
+        components.merge( 1, 5 );
+        std::vector< WFiberCluster::SPtr > clusters = WFiberCluster::createClusters( &components );
+        TS_ASSERT_EQUALS( clusters.size(), 3 );
+
+        size_t data[] = { 0, 1, 4, 5 }; // NOLINT
+        TS_ASSERT_EQUALS( clusters[ 0 ]->getIndices(), WFiberCluster::IndexList( data, data + 4 ) );
+        TS_ASSERT_EQUALS( clusters[ 1 ]->getIndices(), WFiberCluster::IndexList( 1, 2 ) );
+        TS_ASSERT_EQUALS( clusters[ 2 ]->getIndices(), WFiberCluster::IndexList( 1, 3 ) );
+    }
+
+    /**
+     * The longest line is the member with the most points, not the longest fiber of the whole dataset.
+     */
+    void testLongestLine( void )
+    {
+        WFiberCluster::IndexList indices( 1, 1 );
+        WFiberCluster cluster( indices );
+        cluster.setDataSetReference( m_cluster->getDataSetReference() );
+        TS_ASSERT_EQUALS( *cluster.getLongestLine(), m_cluster->getDataSetReference()->at( 1 ) );
+        TS_ASSERT_EQUALS( *m_cluster->getLongestLine(), m_cluster->getDataSetReference()->at( 0 ) );
+
+        // merging invalidates the cached line
+        WFiberCluster other( 0 );
+        cluster.merge( other );
+        TS_ASSERT_EQUALS( *cluster.getLongestLine(), m_cluster->getDataSetReference()->at( 0 ) );
+    }
+
     /**
      * Generates a dataset for some unit tests.
      \verbatim
@@ -430,7 +466,7 @@ private:
         m_cluster.reset();
         m_cluster = std::shared_ptr< WFiberCluster >( new WFiberCluster() );
         m_cluster->setDataSetReference( ds );
-        std::list< size_t > idx;
+        WFiberCluster::IndexList idx;
         for( size_t i = 0; i < ds->size(); ++i )
         {
             idx.push_back( i );
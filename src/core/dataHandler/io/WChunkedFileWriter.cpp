@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "../../common/WAssert.h"
+#include "../../common/WIOTools.h"
+#include "../exceptions/WDHIOFailure.h"
+#include "WChunkedFileWriter.h"
+
+WChunkedFileWriter::WChunkedFileWriter( std::string const& fname, bool background, std::size_t bufferSize )
+    : m_file( fname.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc ),
+      m_fname( fname ),
+      m_buffer( std::max< std::size_t >( bufferSize, 64 ) ),
+      m_used( 0 ),
+      m_swap( !isBigEndian() ),
+      m_closed( false ),
+      m_failed( false ),
+      m_pendingSize( 0 ),
+      m_stop( false )
+{
+    if( !m_file )
+    {
+        throw WDHIOFailure( std::string( "Invalid file, or permission: " + m_fname ) );
+    }
+    if( background )
+    {
+        m_pending.resize( m_buffer.size() );
+        m_thread = std::thread( &WChunkedFileWriter::writeThread, this );
+    }
+}
+
+WChunkedFileWriter::~WChunkedFileWriter()
+{
+    try
+    {
+        close();
+    }
+    catch( ... )
+    {
+        // errors are only reported by an explicit close()
+    }
+}
+
+void WChunkedFileWriter::write( char const* data, std::size_t size )
+{
+    while( size > 0 )
+    {
+        std::size_t const n = std::min( size, m_buffer.size() - m_used );
+        std::memcpy( m_buffer.data() + m_used, data, n );
+        m_used += n;
+        data += n;
+        size -= n;
+        if( m_used == m_buffer.size() )
+        {
+            flush();
+        }
+    }
+}
+
+void WChunkedFileWriter::write( std::string const& text )
+{
+    write( text.data(), text.size() );
+}
+
+void WChunkedFileWriter::close()
+{
+    if( m_closed )
+    {
+        return;
+    }
+    m_closed = true;
+
+    flush();
+    if( m_thread.joinable() )
+    {
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    m_file.close();
+    if( m_failed || m_file.fail() )
+    {
+        throw WDHIOFailure( std::string( "Writing to file failed: " + m_fname ) );
+    }
+}
+
+void WChunkedFileWriter::swapByteOrder( char* data, std::size_t count, std::size_t size )
+{
+    // shifts on whole words instead of swapping single bytes allow the compiler to vectorize the loops
+    switch( size )
+    {
+        case 2:
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                uint16_t v;
+                std::memcpy( &v, data + 2 * i, 2 );
+                v = static_cast< uint16_t >( ( v >> 8 ) | ( v << 8 ) );
+                std::memcpy( data + 2 * i, &v, 2 );
+            }
+            break;
+        case 4:
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                uint32_t v;
+                std::memcpy( &v, data + 4 * i, 4 );
+                v = ( v >> 24 ) | ( ( v >> 8 ) & 0x0000ff00u ) | ( ( v << 8 ) & 0x00ff0000u ) | ( v << 24 );
+                std::memcpy( data + 4 * i, &v, 4 );
+            }
+            break;
+        case 8:
+            for( std::size_t i = 0; i < count; ++i )
+            {
+                uint64_t v;
+                std::memcpy( &v, data + 8 * i, 8 );
+                v = ( ( v & 0x00000000ffffffffull ) << 32 ) | ( v >> 32 );
+                v = ( ( v & 0x0000ffff0000ffffull ) << 16 ) | ( ( v >> 16 ) & 0x0000ffff0000ffffull );
+                v = ( ( v & 0x00ff00ff00ff00ffull ) << 8 ) | ( ( v >> 8 ) & 0x00ff00ff00ff00ffull );
+                std::memcpy( data + 8 * i, &v, 8 );
+            }
+            break;
+        default:
+            WAssert( false, "Unsupported value size." );
+    }
+}
+
+void WChunkedFileWriter::flush()
+{
+    if( m_used == 0 )
+    {
+        return;
+    }
+
+    if( !m_thread.joinable() )
+    {
+        if( !m_file.write( m_buffer.data(), m_used ) )
+        {
+            m_failed = true;
+        }
+        m_used = 0;
+        return;
+    }
+
+    // wait for the previous buffer, then hand over the full one and continue with the written one
+    std::unique_lock< std::mutex > lock( m_mutex );
+    m_condition.wait( lock, [ this ]() { return m_pendingSize == 0; } ); // NOLINT curly braces
+    std::swap( m_buffer, m_pending );
+    m_pendingSize = m_used;
+    m_used = 0;
+    lock.unlock();
+    m_condition.notify_all();
+}
+
+void WChunkedFileWriter::writeThread()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    while( true )
+    {
+        m_condition.wait( lock, [ this ]() { return m_pendingSize > 0 || m_stop; } ); // NOLINT curly braces
+        if( m_pendingSize == 0 )
+        {
+            // stopped and nothing left to write
+            return;
+        }
+
+        // the writing thread does not touch m_pending until m_pendingSize is zero again
+        std::size_t const size = m_pendingSize;
+        lock.unlock();
+        bool const success = static_cast< bool >( m_file.write( m_pending.data(), size ) );
+        lock.lock();
+        m_failed = m_failed || !success;
+        m_pendingSize = 0;
+        m_condition.notify_all();
+    }
+}
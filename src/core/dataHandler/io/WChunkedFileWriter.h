@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCHUNKEDFILEWRITER_H
+#define WCHUNKEDFILEWRITER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Writes a file through a large reusable buffer, so many small writes become few large ones. Binary values can be
+ * converted to big endian while they are copied to the buffer. Optionally, a background thread writes full buffers to
+ * the file while the next buffer is filled.
+ *
+ * Errors are reported by close(). The destructor closes the file but ignores errors.
+ */
+class WChunkedFileWriter // NOLINT
+{
+public:
+    /**
+     * Opens the file for writing and truncates it.
+     *
+     * \param fname the file to write
+     * \param background if true, full buffers are written by a background thread
+     * \param bufferSize the size of the buffer in bytes
+     *
+     * \throw WDHIOFailure if the file cannot be opened
+     */
+    explicit WChunkedFileWriter( std::string const& fname, bool background = false, std::size_t bufferSize = 8 * 1024 * 1024 );
+
+    /**
+     * Destructor. Closes the file if close() was not called.
+     */
+    ~WChunkedFileWriter();
+
+    /**
+     * Write raw bytes.
+     *
+     * \param data the bytes
+     * \param size the number of bytes
+     */
+    void write( char const* data, std::size_t size );
+
+    /**
+     * Write a string without the terminating zero.
+     *
+     * \param text the text
+     */
+    void write( std::string const& text );
+
+    /**
+     * Write values with a size of 1, 2, 4 or 8 bytes in big endian byte order.
+     *
+     * \tparam T the type of the values
+     * \param values the values
+     * \param count the number of values
+     */
+    template< typename T >
+    void writeBigEndian( T const* values, std::size_t count );
+
+    /**
+     * Write the remaining buffer, wait for the background thread and close the file.
+     *
+     * \throw WDHIOFailure if writing failed
+     */
+    void close();
+
+private:
+    /**
+     * Swap the byte order of values in place.
+     *
+     * \param data the values
+     * \param count the number of values
+     * \param size the size of a value, 2, 4 or 8
+     */
+    static void swapByteOrder( char* data, std::size_t count, std::size_t size );
+
+    /**
+     * Write the buffer to the file or pass it to the background thread.
+     */
+    void flush();
+
+    /**
+     * Writes the buffers passed by flush() until close() is called.
+     */
+    void writeThread();
+
+    //! the file
+    std::ofstream m_file;
+
+    //! the name of the file
+    std::string m_fname;
+
+    //! the buffer filled by the write calls
+    std::vector< char > m_buffer;
+
+    //! the number of used bytes of m_buffer
+    std::size_t m_used;
+
+    //! whether values need to be swapped to become big endian
+    bool m_swap;
+
+    //! whether close() was called
+    bool m_closed;
+
+    //! whether writing failed
+    bool m_failed;
+
+    //! the buffer written by the background thread
+    std::vector< char > m_pending;
+
+    //! the number of bytes in m_pending to write, zero if the background thread is idle
+    std::size_t m_pendingSize;
+
+    //! tells the background thread to finish
+    bool m_stop;
+
+    //! protects m_pendingSize, m_stop and m_failed while the background thread runs
+    std::mutex m_mutex;
+
+    //! signals changes of m_pendingSize and m_stop
+    std::condition_variable m_condition;
+
+    //! the background thread, not joinable without background writing
+    std::thread m_thread;
+};
+
+template< typename T >
+void WChunkedFileWriter::writeBigEndian( T const* values, std::size_t count )
+{
+    static_assert( sizeof( T ) == 1 || sizeof( T ) == 2 || sizeof( T ) == 4 || sizeof( T ) == 8, "Unsupported value size." );
+    while( count > 0 )
+    {
+        std::size_t const n = std::min( count, ( m_buffer.size() - m_used ) / sizeof( T ) );
+        if( n == 0 )
+        {
+            flush();
+            continue;
+        }
+        char* target = m_buffer.data() + m_used;
+        std::memcpy( target, values, n * sizeof( T ) );
+        if( m_swap && sizeof( T ) > 1 )
+        {
+            swapByteOrder( target, n, sizeof( T ) );
+        }
+        m_used += n * sizeof( T );
+        values += n;
+        count -= n;
+        if( m_used == m_buffer.size() )
+        {
+            flush();
+        }
+    }
+}
+
+#endif  // WCHUNKEDFILEWRITER_H
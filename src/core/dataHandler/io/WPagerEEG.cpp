@@ -22,6 +22,7 @@
 //
 //---------------------------------------------------------------------------
 
+#include <mutex>
 #include <string>
 
 #include "../../common/WIOTools.h"
@@ -43,6 +44,11 @@ std::string WPagerEEG::getFilename() const
     return m_filename;
 }
 
+std::mutex& WPagerEEG::getReadMutex() const
+{
+    return m_readMutex;
+}
+
 WPagerEEG::WPagerEEG( std::string filename )
     : m_filename( filename )
 {
@@ -27,6 +27,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 
 
@@ -115,6 +116,14 @@ public:
      */
     virtual std::string getChannelLabel( std::size_t channelID ) const = 0;
 
+    /**
+     * Get the mutex to lock while reading values. Pagers keep a file position, so reads of the same file must not
+     * interleave, reads of different files may.
+     *
+     * \return the mutex of this pager
+     */
+    std::mutex& getReadMutex() const;
+
 protected:
     /**
      * Constructor
@@ -124,6 +133,8 @@ protected:
     explicit WPagerEEG( std::string filename );
 private:
     std::string m_filename; //!< name of the loaded file
+
+    mutable std::mutex m_readMutex; //!< serializes the reads of this file
 };
 
 #endif  // WPAGEREEG_H
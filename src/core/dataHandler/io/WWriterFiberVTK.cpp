@@ -22,80 +22,223 @@
 //
 //---------------------------------------------------------------------------
 
-#include <fstream>
+#include <limits>
 #include <memory>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
 #include "../../common/WAssert.h"
-#include "../../common/WIOTools.h"
 #include "../WDataSetFiberVector.h"
 #include "../exceptions/WDHIOFailure.h"
+#include "WChunkedFileWriter.h"
 #include "WWriterFiberVTK.h"
 
-WWriterFiberVTK::WWriterFiberVTK( const boost::filesystem::path& path, bool overwrite )
-    : WWriter( path.string(), overwrite )
-{
-}
-void WWriterFiberVTK::writeFibs( std::shared_ptr< const WDataSetFibers > fiberDS ) const
-{
-    writeFibs( std::shared_ptr< WDataSetFiberVector >( new WDataSetFiberVector( fiberDS ) ) );
-}
-
-void WWriterFiberVTK::writeFibs( std::shared_ptr< const WDataSetFiberVector > fiberDS ) const
+namespace
 {
-    using std::fstream;
-    fstream out( m_fname.c_str(), fstream::out | fstream::in | fstream::trunc );
-    if( !out || out.bad() )
+    /**
+     * Provides the vertices of the tracts of a WDataSetFibers without copying them.
+     */
+    class WTractSource
     {
-        throw WDHIOFailure( std::string( "Invalid file, or permission: " + m_fname ) );
-    }
-    // We use '\n' as line delimiter so also files written under windows (having '\r\n' as delimtier) may be read anywhere
-    char lineDelimiter = '\n';
-
-    out << "# vtk DataFile Version 3.0" << lineDelimiter;
-    out << "Fibers from OpenWalnut" << lineDelimiter;
-    out << "BINARY" << lineDelimiter;
-    out << "DATASET POLYDATA" << lineDelimiter;
-    unsigned int numPoints = 0;
-    unsigned int numLines = fiberDS->size();
-    for( size_t i = 0; i < fiberDS->size(); ++i )
+    public:
+        /**
+         * Constructor.
+         *
+         * \param fibers the tracts
+         */
+        explicit WTractSource( WDataSetFibers const& fibers )
+            : m_vertices( fibers.getVertices() ),
+              m_starts( fibers.getLineStartIndexes() ),
+              m_lengths( fibers.getLineLengths() )
+        {
+        }
+
+        /**
+         * The number of tracts.
+         *
+         * \return number of tracts
+         */
+        std::size_t size() const
+        {
+            return m_lengths->size();
+        }
+
+        /**
+         * The number of vertices of a tract.
+         *
+         * \param i the tract
+         * \return number of vertices
+         */
+        std::size_t length( std::size_t i ) const
+        {
+            return ( *m_lengths )[ i ];
+        }
+
+        /**
+         * The coordinates of the vertices of a tract.
+         *
+         * \param i the tract
+         * \return pointer to 3 * length( i ) floats
+         */
+        float const* vertices( std::size_t i, std::vector< float >* /* buffer */ ) const
+        {
+            return m_vertices->data() + 3 * ( *m_starts )[ i ];
+        }
+
+    private:
+        WDataSetFibers::VertexArray m_vertices; //!< the vertices
+        WDataSetFibers::IndexArray m_starts; //!< the start indexes
+        WDataSetFibers::LengthArray m_lengths; //!< the lengths
+    };
+
+    /**
+     * Provides the vertices of the fibers of a WDataSetFiberVector converted to float.
+     */
+    class WFiberVectorSource
     {
-        numPoints += (*fiberDS)[i].size();
-    }
-    out << "POINTS " << numPoints << " float" << lineDelimiter;
-    unsigned int *rawLineData = new unsigned int[numPoints + numLines];
-    float *rawPointData = new float[numPoints * 3];
+    public:
+        /**
+         * Constructor.
+         *
+         * \param fibers the fibers
+         */
+        explicit WFiberVectorSource( WDataSetFiberVector const& fibers )
+            : m_fibers( fibers )
+        {
+        }
+
+        /**
+         * The number of fibers.
+         *
+         * \return number of fibers
+         */
+        std::size_t size() const
+        {
+            return m_fibers.size();
+        }
+
+        /**
+         * The number of vertices of a fiber.
+         *
+         * \param i the fiber
+         * \return number of vertices
+         */
+        std::size_t length( std::size_t i ) const
+        {
+            return m_fibers[ i ].size();
+        }
 
-    unsigned int pntPosOffset = 0;
-    unsigned int lnsPosOffset = 0;
-    for( size_t i = 0; i < fiberDS->size(); ++i )
+        /**
+         * The coordinates of the vertices of a fiber.
+         *
+         * \param i the fiber
+         * \param buffer receives the coordinates, reused for all fibers
+         * \return pointer to 3 * length( i ) floats
+         */
+        float const* vertices( std::size_t i, std::vector< float >* buffer ) const
+        {
+            WFiber const& fib = m_fibers[ i ];
+            buffer->resize( 3 * fib.size() );
+            for( std::size_t j = 0; j < fib.size(); ++j )
+            {
+                ( *buffer )[ 3 * j + 0 ] = static_cast< float >( fib[ j ][ 0 ] );
+                ( *buffer )[ 3 * j + 1 ] = static_cast< float >( fib[ j ][ 1 ] );
+                ( *buffer )[ 3 * j + 2 ] = static_cast< float >( fib[ j ][ 2 ] );
+            }
+            return buffer->data();
+        }
+
+    private:
+        WDataSetFiberVector const& m_fibers; //!< the fibers
+    };
+
+    /**
+     * Write the selected fibers as binary VTK polydata.
+     *
+     * \tparam Source WTractSource or WFiberVectorSource
+     * \param fname the file to write
+     * \param fibers the fibers
+     * \param selection the fibers to write, all if NULL
+     */
+    template< typename Source >
+    void writeFiberVTK( std::string const& fname, Source const& fibers, std::vector< bool > const* selection )
     {
-        const WFiber &fib = (*fiberDS)[i];
-        rawLineData[lnsPosOffset++] = static_cast< unsigned int >( fib.size() );
-        for( size_t j = 0; j < fib.size(); ++j )
+        WAssert( !selection || selection->size() == fibers.size(), "The selection does not match the number of fibers." );
+
+        // the header needs the sizes, count them first
+        std::size_t numPoints = 0;
+        std::size_t numLines = 0;
+        for( std::size_t i = 0; i < fibers.size(); ++i )
+        {
+            if( !selection || ( *selection )[ i ] )
+            {
+                numPoints += fibers.length( i );
+                ++numLines;
+            }
+        }
+        if( numPoints + numLines > std::numeric_limits< uint32_t >::max() )
+        {
+            throw WDHIOFailure( std::string( "Too many fibers for the VTK format: " + fname ) );
+        }
+
+        // writing in the background pays off as soon as the file spans a few buffers
+        std::size_t const fileSize = sizeof( float ) * 3 * numPoints + sizeof( uint32_t ) * ( numPoints + numLines );
+        WChunkedFileWriter out( fname, fileSize > 32 * 1024 * 1024 );
+
+        // We use '\n' as line delimiter so also files written under windows (having '\r\n' as delimtier) may be read anywhere
+        out.write( std::string( "# vtk DataFile Version 3.0\n" ) );
+        out.write( std::string( "Fibers from OpenWalnut\n" ) );
+        out.write( std::string( "BINARY\n" ) );
+        out.write( std::string( "DATASET POLYDATA\n" ) );
+        out.write( "POINTS " + std::to_string( numPoints ) + " float\n" );
+
+        std::vector< float > vertexBuffer;
+        for( std::size_t i = 0; i < fibers.size(); ++i )
         {
-            const WPosition &point = fib[j];
-            WAssert( pntPosOffset % 3 == 0, "(pOff % 3) was not equal to 0" );
-            WAssert( pntPosOffset / 3 < numPoints, "pntPosOffset is to large." );
-            rawLineData[lnsPosOffset++] = static_cast< unsigned int >( pntPosOffset / 3 );
-            rawPointData[pntPosOffset++] = static_cast< float >( point[0] );
-            rawPointData[pntPosOffset++] = static_cast< float >( point[1] );
-            rawPointData[pntPosOffset++] = static_cast< float >( point[2] );
-            WAssert( pntPosOffset < ( ( numPoints * 3 ) + 1 ), "pOff < #pts" );
+            if( !selection || ( *selection )[ i ] )
+            {
+                out.writeBigEndian( fibers.vertices( i, &vertexBuffer ), 3 * fibers.length( i ) );
+            }
         }
+        out.write( "\nLINES " + std::to_string( numLines ) + " " + std::to_string( numPoints + numLines ) + "\n" );
+
+        // each line is its number of points followed by the indexes of its points
+        std::vector< uint32_t > line;
+        uint32_t index = 0;
+        for( std::size_t i = 0; i < fibers.size(); ++i )
+        {
+            if( !selection || ( *selection )[ i ] )
+            {
+                line.resize( fibers.length( i ) + 1 );
+                line[ 0 ] = static_cast< uint32_t >( fibers.length( i ) );
+                for( std::size_t j = 1; j < line.size(); ++j )
+                {
+                    line[ j ] = index++;
+                }
+                out.writeBigEndian( line.data(), line.size() );
+            }
+        }
+        out.write( std::string( "\n" ) );
+        out.close();
     }
-    switchByteOrderOfArray< float >( rawPointData, numPoints * 3 );
-    switchByteOrderOfArray< unsigned int >( rawLineData, numLines + numPoints );
-    out.write( reinterpret_cast< char* >( rawPointData ), sizeof( float ) * numPoints * 3 );
-    out << lineDelimiter;
-    out << "LINES " << numLines << " " << numPoints + numLines << lineDelimiter;
-    out.write( reinterpret_cast< char* >( rawLineData ), sizeof( unsigned int ) * ( numPoints + numLines ) );
-    out << lineDelimiter;
-    out.close();
-
-    // free memory
-    delete[] rawLineData;
-    delete[] rawPointData;
+}
+
+WWriterFiberVTK::WWriterFiberVTK( const boost::filesystem::path& path, bool overwrite )
+    : WWriter( path.string(), overwrite )
+{
+}
+
+void WWriterFiberVTK::writeFibs( std::shared_ptr< const WDataSetFibers > fiberDS,
+                                 std::shared_ptr< const std::vector< bool > > selection ) const
+{
+    writeFiberVTK( m_fname, WTractSource( *fiberDS ), selection.get() );
+}
+
+void WWriterFiberVTK::writeFibs( std::shared_ptr< const WDataSetFiberVector > fiberDS,
+                                 std::shared_ptr< const std::vector< bool > > selection ) const
+{
+    writeFiberVTK( m_fname, WFiberVectorSource( *fiberDS ), selection.get() );
 }
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -35,7 +36,8 @@
 #include "WWriter.h"
 
 /**
- * Writes a FiberVTK file.
+ * Writes a FiberVTK file. The fibers are streamed through a WChunkedFileWriter, so no copy of the dataset is created,
+ * even if only a selection of the fibers is written.
  */
 class WWriterFiberVTK : public WWriter // NOLINT
 {
@@ -52,15 +54,19 @@ public:
      * Writes a WDataSetFiberVector down to the previousely given file
      *
      * \param fiberDS The WDataSetFiberVector where the data is taken from
+     * \param selection If not NULL, only the fibers whose flag is set are written.
      */
-    void writeFibs( std::shared_ptr< const WDataSetFiberVector > fiberDS ) const;
+    void writeFibs( std::shared_ptr< const WDataSetFiberVector > fiberDS,
+                    std::shared_ptr< const std::vector< bool > > selection = std::shared_ptr< const std::vector< bool > >() ) const;
 
     /**
      * Writes tracts of a WDataSetFibers to the previousely given file.
      *
      * \param fiberDS The tract data set
+     * \param selection If not NULL, only the tracts whose flag is set are written, e.g. the bitfield of a WFiberSelector.
      */
-    void writeFibs( std::shared_ptr< const WDataSetFibers > fiberDS ) const;
+    void writeFibs( std::shared_ptr< const WDataSetFibers > fiberDS,
+                    std::shared_ptr< const std::vector< bool > > selection = std::shared_ptr< const std::vector< bool > >() ) const;
 
 protected:
 private:
@@ -0,0 +1,217 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WWRITERFIBERVTK_TEST_H
+#define WWRITERFIBERVTK_TEST_H
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <cxxtest/TestSuite.h>
+
+#include "../../../common/WIOTools.h"
+#include "../../../common/WLogger.h"
+#include "../../WDataSetFiberVector.h"
+#include "../../WDataSetFibers.h"
+#include "../../WFiberView.h"
+#include "../WChunkedFileWriter.h"
+#include "../WWriterFiberVTK.h"
+
+/**
+ * Tests for WWriterFiberVTK and WChunkedFileWriter.
+ */
+class WWriterFiberVTKTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger, fibers and a temporary file.
+     */
+    void setUp( void )
+    {
+        WLogger::startup();
+
+        // fiber 0: ( 0, 0, 0 ) -> ( 3, 4, 0 ), fiber 1: ( 1, 1, 1 ) -> ( 1, 1, 2 ) -> ( 1, 1, 4 ), fiber 2: ( 5, 5, 5 ) -> ( 6, 6, 6 )
+        float const vertices[] = { 0, 0, 0, 3, 4, 0, 1, 1, 1, 1, 1, 2, 1, 1, 4, 5, 5, 5, 6, 6, 6 }; // NOLINT curly braces
+        std::vector< size_t > lengths( 1, 2 );
+        lengths.push_back( 3 );
+        lengths.push_back( 2 );
+        m_fibers = std::shared_ptr< WDataSetFibers >( new WDataSetFibers(
+                    std::shared_ptr< std::vector< float > >( new std::vector< float >( vertices, vertices + 21 ) ),
+                    createStartIndexes( lengths ),
+                    std::shared_ptr< std::vector< size_t > >( new std::vector< size_t >( lengths ) ),
+                    createVerticesReverse( lengths ) ) );
+        m_file = tempFilename();
+    }
+
+    /**
+     * Remove the temporary file.
+     */
+    void tearDown( void )
+    {
+        boost::filesystem::remove( m_file );
+    }
+
+    /**
+     * All fibers are written as binary VTK polydata.
+     */
+    void testWriteAll( void )
+    {
+        WWriterFiberVTK( m_file, true ).writeFibs( m_fibers );
+        std::vector< bool > all( 3, true );
+        TS_ASSERT( readFile() == expected( all ) );
+
+        // the fiber vector gives the same file
+        WWriterFiberVTK( m_file, true ).writeFibs( std::shared_ptr< WDataSetFiberVector >( new WDataSetFiberVector( m_fibers ) ) );
+        TS_ASSERT( readFile() == expected( all ) );
+    }
+
+    /**
+     * Only the selected fibers are written, the point indexes refer to the written points.
+     */
+    void testWriteSelection( void )
+    {
+        std::shared_ptr< std::vector< bool > > selection( new std::vector< bool >( 3, true ) );
+        ( *selection )[ 0 ] = false;
+        WWriterFiberVTK( m_file, true ).writeFibs( m_fibers, selection );
+        TS_ASSERT( readFile() == expected( *selection ) );
+    }
+
+    /**
+     * Values are written in big endian through small buffers and with a background thread.
+     */
+    void testChunkedWriter( void )
+    {
+        std::vector< uint32_t > values( 1000 );
+        for( size_t i = 0; i < values.size(); ++i )
+        {
+            values[ i ] = static_cast< uint32_t >( i * 2654435761u );
+        }
+
+        for( int background = 0; background < 2; ++background )
+        {
+            {
+                WChunkedFileWriter out( m_file, background != 0, 100 );
+                out.write( std::string( "abc" ) );
+                out.writeBigEndian( values.data(), values.size() );
+                out.close();
+            }
+            std::string const data = readFile();
+            TS_ASSERT_EQUALS( data.size(), 3 + 4 * values.size() );
+            TS_ASSERT_EQUALS( data.substr( 0, 3 ), "abc" );
+            for( size_t i = 0; i < values.size() && data.size() == 3 + 4 * values.size(); ++i )
+            {
+                uint32_t const v = ( static_cast< uint32_t >( static_cast< unsigned char >( data[ 3 + 4 * i ] ) ) << 24 ) |
+                                   ( static_cast< uint32_t >( static_cast< unsigned char >( data[ 4 + 4 * i ] ) ) << 16 ) |
+                                   ( static_cast< uint32_t >( static_cast< unsigned char >( data[ 5 + 4 * i ] ) ) << 8 ) |
+                                   static_cast< uint32_t >( static_cast< unsigned char >( data[ 6 + 4 * i ] ) );
+                TS_ASSERT_EQUALS( v, values[ i ] );
+            }
+        }
+    }
+
+private:
+    /**
+     * A file name in the temporary directory.
+     *
+     * \return the file name
+     */
+    static std::string tempFilename()
+    {
+        return ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "ow_fibers_%%%%%%%%.fib" ) ).string();
+    }
+
+    /**
+     * Read the temporary file.
+     *
+     * \return the content
+     */
+    std::string readFile() const
+    {
+        std::ifstream in( m_file.c_str(), std::ios_base::binary );
+        return std::string( std::istreambuf_iterator< char >( in ), std::istreambuf_iterator< char >() );
+    }
+
+    /**
+     * Append values in big endian byte order.
+     *
+     * \param data the string to append to
+     * \param value the value
+     */
+    template< typename T >
+    static void append( std::string* data, T value )
+    {
+        if( !isBigEndian() )
+        {
+            value = switchByteOrder( value );
+        }
+        data->append( reinterpret_cast< char const* >( &value ), sizeof( T ) );
+    }
+
+    /**
+     * The expected file for the selected fibers, created the same way as the writer did before it streamed the data.
+     *
+     * \param selection the selected fibers
+     *
+     * \return the expected content
+     */
+    std::string expected( std::vector< bool > const& selection ) const
+    {
+        std::string points;
+        std::string lines;
+        uint32_t numPoints = 0;
+        uint32_t numLines = 0;
+        for( size_t i = 0; i < m_fibers->size(); ++i )
+        {
+            if( !selection[ i ] )
+            {
+                continue;
+            }
+            size_t const start = ( *m_fibers->getLineStartIndexes() )[ i ];
+            size_t const length = ( *m_fibers->getLineLengths() )[ i ];
+            append( &lines, static_cast< uint32_t >( length ) );
+            for( size_t j = 0; j < length; ++j )
+            {
+                append( &lines, numPoints++ );
+                for( size_t c = 0; c < 3; ++c )
+                {
+                    append( &points, ( *m_fibers->getVertices() )[ 3 * ( start + j ) + c ] );
+                }
+            }
+            ++numLines;
+        }
+        return "# vtk DataFile Version 3.0\nFibers from OpenWalnut\nBINARY\nDATASET POLYDATA\nPOINTS " + std::to_string( numPoints ) +
+               " float\n" + points + "\nLINES " + std::to_string( numLines ) + " " + std::to_string( numPoints + numLines ) + "\n" +
+               lines + "\n";
+    }
+
+    std::shared_ptr< WDataSetFibers > m_fibers; //!< the fibers to write
+    std::string m_file; //!< the temporary file
+};
+
+#endif  // WWRITERFIBERVTK_TEST_H
@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCSVCOLUMN_TEST_H
+#define WCSVCOLUMN_TEST_H
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WCSVColumn.h"
+
+/**
+ * Tests for the typed csv columns.
+ */
+class WCSVColumnTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Numbers should be parsed completely, with or without sign and exponent.
+     */
+    void testParseNumber()
+    {
+        TS_ASSERT_DELTA( parse( "1000.1" ), 1000.1, 1e-10 );
+        TS_ASSERT_DELTA( parse( "1." ), 1.0, 1e-10 );
+        TS_ASSERT_DELTA( parse( ".1" ), 0.1, 1e-10 );
+        TS_ASSERT_DELTA( parse( "+1" ), 1.0, 1e-10 );
+        TS_ASSERT_DELTA( parse( "-.1" ), -0.1, 1e-10 );
+        TS_ASSERT_DELTA( parse( "+1e-1" ), 0.1, 1e-10 );
+        TS_ASSERT_DELTA( parse( "4.20922e-09" ), 4.20922e-09, 1e-20 );
+
+        double value;
+        TS_ASSERT( !WCSVColumn::parseNumber( NULL, NULL, &value ) );
+        char const* invalid[] = { "", "+", "+-1", "1.g", "Test", "1.1.2", "1,2", " 1" }; // NOLINT curly braces
+        for( std::size_t i = 0; i < sizeof( invalid ) / sizeof( invalid[ 0 ] ); ++i )
+        {
+            TS_ASSERT( !WCSVColumn::parseNumber( invalid[ i ], invalid[ i ] + std::strlen( invalid[ i ] ), &value ) );
+        }
+
+        // the range does not need to be terminated
+        char const* cells = "12,34";
+        TS_ASSERT( WCSVColumn::parseNumber( cells, cells + 2, &value ) );
+        TS_ASSERT_EQUALS( value, 12.0 );
+    }
+
+    /**
+     * The type of a column should be the most specific type all cells fit into.
+     */
+    void testTypeDetection()
+    {
+        char const* ints[] = { "1", "-500", "1e1", "2.0" }; // NOLINT curly braces
+        char const* floats[] = { "1", "0.5", "NULL", "" }; // NOLINT curly braces
+        char const* missingInts[] = { "1", "NULL" }; // NOLINT curly braces
+        char const* strings[] = { "1", "Transportation" }; // NOLINT curly braces
+        char const* missing[] = { "NULL", "NULL" }; // NOLINT curly braces
+        char const* large[] = { "1", "3000000000" }; // NOLINT curly braces
+
+        TS_ASSERT_EQUALS( detect( ints, 4 ), WCSVColumn::COLUMN_INT );
+        TS_ASSERT_EQUALS( detect( floats, 4 ), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( detect( missingInts, 2 ), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( detect( strings, 2 ), WCSVColumn::COLUMN_STRING );
+        TS_ASSERT_EQUALS( detect( missing, 2 ), WCSVColumn::COLUMN_STRING );
+        TS_ASSERT_EQUALS( detect( large, 2 ), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( detect( ints, 0 ), WCSVColumn::COLUMN_STRING );
+
+        // merging the detectors of two halves gives the same type as one detector for all cells
+        WCSVColumn::TypeDetector first;
+        WCSVColumn::TypeDetector second;
+        first.add( ints[ 0 ], ints[ 0 ] + 1 );
+        second.add( floats[ 1 ], floats[ 1 ] + 3 );
+        TS_ASSERT_EQUALS( first.getType(), WCSVColumn::COLUMN_INT );
+        first.merge( second );
+        TS_ASSERT_EQUALS( first.getType(), WCSVColumn::COLUMN_DOUBLE );
+    }
+
+    /**
+     * Values should be stored in the arrays of their type and read back as numbers and strings.
+     */
+    void testValues()
+    {
+        char const* cells[] = { "-500", "0.0199097", "NULL" }; // NOLINT curly braces
+
+        WCSVColumn ints( "ints", WCSVColumn::COLUMN_INT, 1 );
+        ints.setNumber( 0, cells[ 0 ], cells[ 0 ] + std::strlen( cells[ 0 ] ) );
+        TS_ASSERT_EQUALS( ints.getName(), "ints" );
+        TS_ASSERT_EQUALS( ints.size(), 1 );
+        TS_ASSERT( ints.getDoubles() == NULL );
+        TS_ASSERT_EQUALS( ints.getInts()[ 0 ], -500 );
+        TS_ASSERT_EQUALS( ints.getNumber( 0 ), -500.0 );
+        TS_ASSERT( !ints.isMissing( 0 ) );
+        TS_ASSERT_EQUALS( ints.getString( 0 ), "-500" );
+
+        WCSVColumn doubles( "doubles", WCSVColumn::COLUMN_DOUBLE, 2 );
+        doubles.setNumber( 0, cells[ 1 ], cells[ 1 ] + std::strlen( cells[ 1 ] ) );
+        doubles.setNumber( 1, cells[ 2 ], cells[ 2 ] + std::strlen( cells[ 2 ] ) );
+        TS_ASSERT( doubles.getInts() == NULL );
+        TS_ASSERT_EQUALS( doubles.getDoubles()[ 0 ], 0.0199097 );
+        TS_ASSERT( !doubles.isMissing( 0 ) );
+        TS_ASSERT( doubles.isMissing( 1 ) );
+        TS_ASSERT( std::isnan( doubles.getNumber( 1 ) ) );
+        TS_ASSERT_EQUALS( doubles.getString( 0 ), "0.0199097" );
+        TS_ASSERT_EQUALS( doubles.getString( 1 ), "NULL" );
+
+        WCSVColumn strings( "strings", WCSVColumn::COLUMN_STRING, 3 );
+        std::vector< std::string > dictionary;
+        dictionary.push_back( "Transportation" );
+        dictionary.push_back( "NULL" );
+        strings.setDictionary( &dictionary );
+        TS_ASSERT( dictionary.empty() );
+        strings.getCodes()[ 0 ] = 1;
+        strings.getCodes()[ 1 ] = 0;
+        strings.getCodes()[ 2 ] = 0;
+        TS_ASSERT_EQUALS( strings.getDictionary().size(), 2 );
+        TS_ASSERT_EQUALS( strings.getString( 0 ), "NULL" );
+        TS_ASSERT_EQUALS( strings.getString( 2 ), "Transportation" );
+        TS_ASSERT( strings.isMissing( 0 ) );
+        TS_ASSERT( !strings.isMissing( 1 ) );
+        TS_ASSERT( std::isnan( strings.getNumber( 1 ) ) );
+    }
+
+    /**
+     * Large integers and doubles with many digits in columns with missing values are stored exactly.
+     */
+    void testLargeNumbersWithMissingValues()
+    {
+        char const* pdg[] = { "1000020040", "", "-2212" }; // NOLINT curly braces
+        char const* energy[] = { "0.123456789012345", "NULL", "12345678.9" }; // NOLINT curly braces
+        TS_ASSERT_EQUALS( detect( pdg, 3 ), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( detect( energy, 3 ), WCSVColumn::COLUMN_DOUBLE );
+
+        WCSVColumn ids( "PDGEncoding", WCSVColumn::COLUMN_DOUBLE, 3 );
+        WCSVColumn values( "edep", WCSVColumn::COLUMN_DOUBLE, 3 );
+        for( std::size_t row = 0; row < 3; ++row )
+        {
+            ids.setNumber( row, pdg[ row ], pdg[ row ] + std::strlen( pdg[ row ] ) );
+            values.setNumber( row, energy[ row ], energy[ row ] + std::strlen( energy[ row ] ) );
+        }
+        TS_ASSERT_EQUALS( ids.getNumber( 0 ), 1000020040.0 );
+        TS_ASSERT( ids.isMissing( 1 ) );
+        TS_ASSERT_EQUALS( ids.getNumber( 2 ), -2212.0 );
+        TS_ASSERT_EQUALS( ids.getString( 0 ), "1000020040" );
+        TS_ASSERT_EQUALS( values.getNumber( 0 ), 0.123456789012345 );
+        TS_ASSERT_EQUALS( values.getNumber( 2 ), 12345678.9 );
+        TS_ASSERT_EQUALS( values.getString( 0 ), "0.123456789012345" );
+    }
+
+private:
+    /**
+     * Parses a number that is expected to be valid.
+     *
+     * \param str The string to parse.
+     *
+     * \return The value.
+     */
+    double parse( char const* str )
+    {
+        double value = 0.0;
+        TS_ASSERT( WCSVColumn::parseNumber( str, str + std::strlen( str ), &value ) );
+        return value;
+    }
+
+    /**
+     * Determines the type of a column.
+     *
+     * \param cells The cells of the column.
+     * \param count The number of cells.
+     *
+     * \return The type.
+     */
+    WCSVColumn::ColumnType detect( char const** cells, std::size_t count )
+    {
+        WCSVColumn::TypeDetector detector;
+        for( std::size_t i = 0; i < count; ++i )
+        {
+            detector.add( cells[ i ], cells[ i ] + std::strlen( cells[ i ] ) );
+        }
+        return detector.getType();
+    }
+};
+
+#endif  // WCSVCOLUMN_TEST_H
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <cxxtest/TestSuite.h>
@@ -103,6 +104,59 @@ public:
     {
         TS_ASSERT_EQUALS( csvDataSet.getData(), m_data );
     }
+
+    /**
+     * Test that typed columns are created from the strings and the strings from typed columns
+     */
+    void testColumns()
+    {
+        WDataSetCSV::ContentSPtr header( new WDataSetCSV::Content() );
+        WDataSetCSV::ContentSPtr data( new WDataSetCSV::Content() );
+        header->push_back( { "id", "edep", "name" } ); // NOLINT curly braces
+        data->push_back( { "1", "0.5", "Transportation" } ); // NOLINT curly braces
+        data->push_back( { "2", "NULL", "eIoni" } ); // NOLINT curly braces
+        data->push_back( { "3", "1.25", "Transportation" } ); // NOLINT curly braces
+
+        WDataSetCSV fromStrings( header, data );
+        TS_ASSERT_EQUALS( fromStrings.getNumberOfRows(), 3 );
+        WDataSetCSV::Columns const& columns = fromStrings.getColumns();
+        TS_ASSERT_EQUALS( columns.size(), 3 );
+        TS_ASSERT_EQUALS( columns[ 0 ]->getType(), WCSVColumn::COLUMN_INT );
+        TS_ASSERT_EQUALS( columns[ 1 ]->getType(), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( columns[ 2 ]->getType(), WCSVColumn::COLUMN_STRING );
+        TS_ASSERT_EQUALS( columns[ 0 ]->getInts()[ 2 ], 3 );
+        TS_ASSERT_EQUALS( columns[ 1 ]->getDoubles()[ 2 ], 1.25 );
+        TS_ASSERT( columns[ 1 ]->isMissing( 1 ) );
+        TS_ASSERT_EQUALS( columns[ 2 ]->getDictionary().size(), 2 );
+        TS_ASSERT_EQUALS( columns[ 2 ]->getCodes()[ 0 ], columns[ 2 ]->getCodes()[ 2 ] );
+        TS_ASSERT_EQUALS( columns[ 0 ]->getName(), "id" );
+
+        WDataSetCSV fromColumns( header, columns );
+        TS_ASSERT_EQUALS( fromColumns.getNumberOfRows(), 3 );
+        TS_ASSERT_EQUALS( *fromColumns.getData(), *data );
+        TS_ASSERT_EQUALS( fromColumns.getRawDataSet()->size(), 4 );
+        TS_ASSERT_EQUALS( fromColumns.getRawDataSet()->at( 2 ), "2,NULL,eIoni" );
+    }
+
+    /**
+     * The strings of a dataset read from a file are taken from the text, not from the columns
+     */
+    void testText()
+    {
+        WDataSetCSV::ContentSPtr header( new WDataSetCSV::Content() );
+        header->push_back( { "id", "edep" } ); // NOLINT curly braces
+        std::string const text = "id,edep\n1000020040,1.0e-3\r\n2,\n";
+        WDataSetCSV::ContentSPtr data( new WDataSetCSV::Content() );
+        data->push_back( { "1000020040", "1.0e-3" } ); // NOLINT curly braces
+        data->push_back( { "2" } ); // NOLINT curly braces
+
+        WDataSetCSV fromText( header, WDataSetCSV::createColumns( header, data ), WDataSetCSV::TextSPtr( new std::string_view( text ) ) );
+        TS_ASSERT_EQUALS( *fromText.getData(), *data );
+        TS_ASSERT_EQUALS( fromText.getRawDataSet()->size(), 3 );
+        TS_ASSERT_EQUALS( fromText.getRawDataSet()->at( 0 ), "id,edep" );
+        TS_ASSERT_EQUALS( fromText.getRawDataSet()->at( 1 ), "1000020040,1.0e-3" );
+        TS_ASSERT_EQUALS( fromText.getRawDataSet()->at( 2 ), "2," );
+    }
 };
 
 #endif  // WDATASETCSV_TEST_H
@@ -533,7 +533,106 @@ public:
         // it is the callers responsibility to check for nan
     }
 
+    /**
+     * The time courses should be ordered by time and contain the values of the time slices.
+     */
+    void testTimeCourses()
+    {
+        DataSetPtrVector d;
+        TimesVector t;
+        createVaryingData( d, t );
+        WDataSetTimeSeries ts( d, t );
+
+        TS_ASSERT_EQUALS( ts.getNumberOfTimeSlices(), 4 );
+        TS_ASSERT_EQUALS( ts.getNumberOfVoxels(), 27 );
+
+        // the slices were given in reverse order of time
+        for( std::size_t v = 0; v < 27; ++v )
+        {
+            float const* course = ts.getTimeCourse( v );
+            for( std::size_t k = 0; k < 4; ++k )
+            {
+                TS_ASSERT_EQUALS( course[ k ], static_cast< float >( ( v + 1 ) * ( 4 - k ) ) );
+            }
+        }
+
+        std::vector< std::size_t > voxels;
+        voxels.push_back( 26 );
+        voxels.push_back( 3 );
+        std::vector< float > courses( 8 );
+        ts.getTimeCourses( voxels, &courses[ 0 ] );
+        for( std::size_t k = 0; k < 4; ++k )
+        {
+            TS_ASSERT_EQUALS( courses[ k ], ts.getTimeCourse( 26 )[ k ] );
+            TS_ASSERT_EQUALS( courses[ k + 4 ], ts.getTimeCourse( 3 )[ k ] );
+        }
+    }
+
+    /**
+     * Seed correlation should be 1 for scaled and shifted time courses, -1 for inverted ones and 0 for constant ones.
+     */
+    void testSeedCorrelation()
+    {
+        DataSetPtrVector d;
+        TimesVector t;
+        createVaryingData( d, t );
+
+        // make voxel 1 inverted and voxel 2 constant
+        for( std::size_t k = 0; k < d.size(); ++k )
+        {
+            std::shared_ptr< WValueSet< double > const > vs = std::dynamic_pointer_cast< WValueSet< double > const >( d[ k ]->getValueSet() );
+            std::shared_ptr< std::vector< double > > v( new std::vector< double >( vs->rawData(), vs->rawData() + vs->size() ) );
+            ( *v )[ 1 ] = -( *v )[ 1 ];
+            ( *v )[ 2 ] = 5.0;
+            std::shared_ptr< WValueSet< double > > nvs( new WValueSet< double >( 0, 1, v, W_DT_DOUBLE ) );
+            d[ k ] = std::shared_ptr< WDataSetScalar const >( new WDataSetScalar( nvs, d[ k ]->getGrid() ) );
+        }
+        WDataSetTimeSeries ts( d, t );
+
+        std::shared_ptr< WDataSetScalar > corr = ts.calcSeedCorrelation( 0 );
+        TS_ASSERT( corr );
+        TS_ASSERT_EQUALS( corr->getValueSet()->size(), 27 );
+        TS_ASSERT_EQUALS( corr->getGrid(), d.front()->getGrid() );
+        TS_ASSERT_DELTA( corr->getValueAt( 0 ), 1.0, 1e-6 );
+        TS_ASSERT_DELTA( corr->getValueAt( 1 ), -1.0, 1e-6 );
+        TS_ASSERT_DELTA( corr->getValueAt( 2 ), 0.0, 1e-6 );
+        for( std::size_t v = 3; v < 27; ++v )
+        {
+            TS_ASSERT_DELTA( corr->getValueAt( v ), 1.0, 1e-6 );
+        }
+    }
+
 private:
+    /**
+     * Creates 4 time slices on a 3x3x3 grid, the value of voxel v in the slice at time k is ( v + 1 ) * ( 4 - k ).
+     * The slices are given in reverse order of time.
+     *
+     * \param dsets The output datasets.
+     * \param times The times for the output datasets.
+     */
+    void createVaryingData( DataSetPtrVector& dsets, TimesVector& times ) // NOLINT
+    {
+        dsets.clear();
+        times.clear();
+
+        WMatrix< double > mat( 4, 4 );
+        mat.makeIdentity();
+        WGridTransformOrtho transform( mat );
+        std::shared_ptr< WGridRegular3D > g( new WGridRegular3D( 3, 3, 3, transform ) );
+
+        for( int k = 3; k >= 0; --k )
+        {
+            std::shared_ptr< std::vector< double > > v( new std::vector< double >( 27 ) );
+            for( std::size_t i = 0; i < 27; ++i )
+            {
+                ( *v )[ i ] = static_cast< double >( ( i + 1 ) * ( 4 - k ) );
+            }
+            std::shared_ptr< WValueSet< double > > vs( new WValueSet< double >( 0, 1, v, W_DT_DOUBLE ) );
+            dsets.push_back( std::shared_ptr< WDataSetScalar const >( new WDataSetScalar( vs, g ) ) );
+            times.push_back( static_cast< float >( k ) );
+        }
+    }
+
     /**
      * A helper function that creates some input data.
      *
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WEEG2SEGMENT_TEST_H
+#define WEEG2SEGMENT_TEST_H
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/exceptions/WOutOfBounds.h"
+#include "../WEEG2Segment.h"
+#include "../WEEGValueMatrix.h"
+#include "../io/WPagerEEG.h"
+
+/**
+ * A pager generating deterministic values instead of reading a file.
+ */
+class WFakePagerEEG : public WPagerEEG
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param nbChannels number of channels
+     * \param nbSamples number of samples of the only segment
+     */
+    WFakePagerEEG( std::size_t nbChannels, std::size_t nbSamples )
+        : WPagerEEG( boost::filesystem::temp_directory_path().string() ), // the pager only checks that the path exists
+          m_nbChannels( nbChannels ),
+          m_nbSamples( nbSamples )
+    {
+    }
+
+    /**
+     * The value of a sample.
+     *
+     * \param channel the channel
+     * \param sample the sample
+     * \return the value
+     */
+    static double value( std::size_t channel, std::size_t sample )
+    {
+        return std::sin( 0.01 * sample * ( channel + 1 ) ) * 100.0 + static_cast< double >( ( sample * 7919 ) % 13 ) - 6.0;
+    }
+
+    virtual std::size_t getNumberOfSegments() const
+    {
+        return 1;
+    }
+
+    virtual std::size_t getNumberOfChannels() const
+    {
+        return m_nbChannels;
+    }
+
+    virtual std::size_t getNumberOfSamples( std::size_t /* segmentID */ ) const
+    {
+        return m_nbSamples;
+    }
+
+    virtual std::shared_ptr< WEEGValueMatrix > getValues( std::size_t /* segmentID */, std::size_t start, std::size_t length ) const
+    {
+        std::shared_ptr< WEEGValueMatrix > values( new WEEGValueMatrix( m_nbChannels, std::vector< double >( length ) ) );
+        for( std::size_t channel = 0; channel < m_nbChannels; ++channel )
+        {
+            for( std::size_t i = 0; i < length; ++i )
+            {
+                ( *values )[ channel ][ i ] = value( channel, start + i );
+            }
+        }
+        return values;
+    }
+
+    virtual double getSamplingRate() const
+    {
+        return 1000.0;
+    }
+
+    virtual std::string getChannelUnit( std::size_t /* channelID */ ) const
+    {
+        return "uV";
+    }
+
+    virtual std::string getChannelLabel( std::size_t /* channelID */ ) const
+    {
+        return "C";
+    }
+
+private:
+    std::size_t m_nbChannels; //!< number of channels
+    std::size_t m_nbSamples; //!< number of samples
+};
+
+/**
+ * Tests for WEEG2Segment.
+ */
+class WEEG2SegmentTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Values read across block boundaries equal the values of the pager.
+     */
+    void testGetValues( void )
+    {
+        // many channels keep the blocks small
+        std::shared_ptr< WFakePagerEEG > pager( new WFakePagerEEG( 64, 50000 ) );
+        WEEG2Segment segment( 0, pager );
+        std::size_t const blockSize = segment.getBlockSize();
+        TS_ASSERT( blockSize < 50000 );
+
+        std::size_t const starts[] = { 0, blockSize - 10, 2 * blockSize + 1, 49990 }; // NOLINT curly braces
+        for( std::size_t i = 0; i < 4; ++i )
+        {
+            std::size_t const length = std::min< std::size_t >( 50000 - starts[ i ], blockSize + 20 );
+            std::shared_ptr< WEEGValueMatrix > values = segment.getValues( starts[ i ], length );
+            TS_ASSERT_EQUALS( values->size(), 64 );
+            for( std::size_t channel = 0; channel < 64; ++channel )
+            {
+                TS_ASSERT_EQUALS( ( *values )[ channel ].size(), length );
+                for( std::size_t s = 0; s < length; ++s )
+                {
+                    TS_ASSERT_EQUALS( ( *values )[ channel ][ s ], WFakePagerEEG::value( channel, starts[ i ] + s ) );
+                }
+            }
+        }
+
+        TS_ASSERT_THROWS( segment.getValues( 49990, 11 ), const WOutOfBounds& );
+    }
+
+    /**
+     * The decimated values contain the minimum and maximum of every part of the requested range.
+     */
+    void testMinMaxValues( void )
+    {
+        std::shared_ptr< WFakePagerEEG > pager( new WFakePagerEEG( 64, 100000 ) );
+        WEEG2Segment segment( 0, pager );
+
+        // few points use the raw values
+        std::vector< double > samples;
+        std::vector< double > values;
+        segment.getMinMaxValues( 1, 100, 50, 200, &samples, &values );
+        TS_ASSERT_EQUALS( samples.size(), 50 );
+        TS_ASSERT_EQUALS( values.size(), 50 );
+        TS_ASSERT_EQUALS( samples[ 3 ], 103.0 );
+        TS_ASSERT_EQUALS( values[ 3 ], WFakePagerEEG::value( 1, 103 ) );
+
+        // raw values, the pyramid and a range spanning all blocks
+        std::size_t const starts[] = { 1000, 333, 17, 0 }; // NOLINT curly braces
+        std::size_t const lengths[] = { 3000, 40000, 99983, 100000 }; // NOLINT curly braces
+        for( std::size_t i = 0; i < 4; ++i )
+        {
+            segment.getMinMaxValues( 0, starts[ i ], lengths[ i ], 100, &samples, &values );
+            TS_ASSERT_EQUALS( samples.size(), values.size() );
+            TS_ASSERT( samples.size() <= 104 );
+            TS_ASSERT( samples.size() >= 50 );
+
+            double min = values[ 0 ];
+            double max = values[ 0 ];
+            for( std::size_t j = 0; j < samples.size(); ++j )
+            {
+                TS_ASSERT( samples[ j ] >= starts[ i ] );
+                TS_ASSERT( samples[ j ] < starts[ i ] + lengths[ i ] );
+                min = std::min( min, values[ j ] );
+                max = std::max( max, values[ j ] );
+            }
+
+            // the envelope covers the requested range, buckets at the borders may reach a little beyond
+            double rawMin = WFakePagerEEG::value( 0, starts[ i ] );
+            double rawMax = rawMin;
+            for( std::size_t s = starts[ i ]; s < starts[ i ] + lengths[ i ]; ++s )
+            {
+                rawMin = std::min( rawMin, WFakePagerEEG::value( 0, s ) );
+                rawMax = std::max( rawMax, WFakePagerEEG::value( 0, s ) );
+            }
+            TS_ASSERT( min <= static_cast< float >( rawMin ) );
+            TS_ASSERT( max >= static_cast< float >( rawMax ) );
+        }
+    }
+};
+
+#endif  // WEEG2SEGMENT_TEST_H
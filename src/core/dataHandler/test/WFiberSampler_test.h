@@ -0,0 +1,143 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERSAMPLER_TEST_H
+#define WFIBERSAMPLER_TEST_H
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/WLogger.h"
+#include "../WDataSetFibers.h"
+#include "../WDataSetScalar.h"
+#include "../WFiberSampler.h"
+#include "../WFiberView.h"
+#include "../WGridRegular3D.h"
+#include "../WValueSet.h"
+
+/**
+ * Tests for WFiberSampler.
+ */
+class WFiberSamplerTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger.
+     */
+    void setUp( void )
+    {
+        WLogger::startup();
+    }
+
+    /**
+     * Sampled values equal the interpolation of the dataset, also for rotated grids and other data types.
+     */
+    void testSamplePosition( void )
+    {
+        // rotation around z with 45 degrees and a voxel size of 2 in z direction
+        WMatrix< double > mat( 4, 4 );
+        mat.makeIdentity();
+        mat( 0, 0 ) =  1.0 / std::sqrt( 2.0 );
+        mat( 0, 1 ) =  1.0 / std::sqrt( 2.0 );
+        mat( 1, 0 ) = -1.0 / std::sqrt( 2.0 );
+        mat( 1, 1 ) =  1.0 / std::sqrt( 2.0 );
+        mat( 2, 2 ) = 2.0;
+        mat( 0, 3 ) = 1.0;
+
+        std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( 5, 4, 3, WGridTransformOrtho( mat ) ) );
+        std::shared_ptr< std::vector< uint8_t > > data( new std::vector< uint8_t >( grid->size() ) );
+        for( size_t i = 0; i < grid->size(); ++i )
+        {
+            ( *data )[ i ] = static_cast< uint8_t >( ( i * 37 ) % 251 );
+        }
+        WDataSetScalar ds( std::shared_ptr< WValueSet< uint8_t > >( new WValueSet< uint8_t >( 0, 1, data, W_DT_UNSIGNED_CHAR ) ), grid );
+        WFiberSampler sampler( ds, -1.0 );
+
+        for( double x = -2.0; x < 6.0; x += 0.37 )
+        {
+            for( double y = -1.0; y < 6.0; y += 0.41 )
+            {
+                for( double z = -1.0; z < 6.0; z += 0.43 )
+                {
+                    bool inside = false;
+                    double expected = ds.interpolate( WPosition( x, y, z ), &inside );
+                    double value = 0.0;
+                    TS_ASSERT_EQUALS( sampler.sample( WPosition( x, y, z ), &value ), inside );
+                    TS_ASSERT_DELTA( value, inside ? expected : -1.0, 1e-9 );
+                }
+            }
+        }
+    }
+
+    /**
+     * Sampling fibers yields one value per vertex, also when the fibers are processed in parallel.
+     */
+    void testSampleFibers( void )
+    {
+        std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( 8, 8, 8 ) );
+        std::shared_ptr< std::vector< float > > data( new std::vector< float >( grid->size() ) );
+        for( size_t i = 0; i < grid->size(); ++i )
+        {
+            ( *data )[ i ] = static_cast< float >( i );
+        }
+        WDataSetScalar ds( std::shared_ptr< WValueSet< float > >( new WValueSet< float >( 0, 1, data, W_DT_FLOAT ) ), grid );
+        WFiberSampler sampler( ds );
+
+        // the value of a position inside the grid is x + 8 y + 64 z
+        size_t const nbFibers = 3000;
+        std::vector< size_t > lengths( nbFibers );
+        std::shared_ptr< std::vector< float > > vertices( new std::vector< float >() );
+        for( size_t i = 0; i < nbFibers; ++i )
+        {
+            lengths[ i ] = 2 + i % 5;
+            for( size_t k = 0; k < lengths[ i ]; ++k )
+            {
+                vertices->push_back( 0.5f + 0.25f * k );
+                vertices->push_back( static_cast< float >( i % 7 ) );
+                vertices->push_back( 0.125f * ( i % 11 ) );
+            }
+        }
+        // the last vertex is outside
+        vertices->back() = 20.0f;
+        WDataSetFibers fibers( vertices, createStartIndexes( lengths ), std::shared_ptr< std::vector< size_t > >(
+                               new std::vector< size_t >( lengths ) ), createVerticesReverse( lengths ) );
+
+        WDataSetFibers::SPtr sampled = sampler.createSampledFibers( fibers );
+        TS_ASSERT_EQUALS( sampled->getVertices(), fibers.getVertices() );
+        WDataSetFibers::VertexParemeterArray values = sampled->getVertexParameters();
+        TS_ASSERT( values );
+        TS_ASSERT_EQUALS( values->size(), vertices->size() / 3 );
+        for( size_t i = 0; i + 1 < values->size(); ++i )
+        {
+            double const expected = ( *vertices )[ 3 * i ] + 8.0 * ( *vertices )[ 3 * i + 1 ] + 64.0 * ( *vertices )[ 3 * i + 2 ];
+            TS_ASSERT_DELTA( ( *values )[ i ], expected, 1e-4 );
+        }
+        TS_ASSERT_EQUALS( values->back(), 0.0 );
+    }
+};
+
+#endif  // WFIBERSAMPLER_TEST_H
@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERVIEW_TEST_H
+#define WFIBERVIEW_TEST_H
+
+#include <memory>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/WLogger.h"
+#include "../WDataSetFibers.h"
+#include "../WFiberView.h"
+
+/**
+ * Tests for the fiber views.
+ */
+class WFiberViewTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger and fibers.
+     */
+    void setUp( void )
+    {
+        WLogger::startup();
+
+        // fiber 0: ( 0, 0, 0 ) -> ( 3, 4, 0 ), fiber 1: ( 1, 1, 1 ) -> ( 1, 1, 2 ) -> ( 1, 1, 4 )
+        float const vertices[] = { 0, 0, 0, 3, 4, 0, 1, 1, 1, 1, 1, 2, 1, 1, 4 }; // NOLINT curly braces
+        std::vector< size_t > lengths( 1, 2 );
+        lengths.push_back( 3 );
+        m_fibers = std::shared_ptr< WDataSetFibers >( new WDataSetFibers(
+                    std::shared_ptr< std::vector< float > >( new std::vector< float >( vertices, vertices + 15 ) ),
+                    createStartIndexes( lengths ),
+                    std::shared_ptr< std::vector< size_t > >( new std::vector< size_t >( lengths ) ),
+                    createVerticesReverse( lengths ) ) );
+    }
+
+    /**
+     * Start indexes and reverse indexes follow from the lengths.
+     */
+    void testIndexes( void )
+    {
+        TS_ASSERT_EQUALS( m_fibers->getLineStartIndexes()->size(), 2 );
+        TS_ASSERT_EQUALS( ( *m_fibers->getLineStartIndexes() )[ 0 ], 0 );
+        TS_ASSERT_EQUALS( ( *m_fibers->getLineStartIndexes() )[ 1 ], 2 );
+
+        std::vector< size_t > const& reverse = *m_fibers->getVerticesReverse();
+        TS_ASSERT_EQUALS( reverse.size(), 5 );
+        TS_ASSERT_EQUALS( reverse[ 1 ], 0 );
+        TS_ASSERT_EQUALS( reverse[ 2 ], 1 );
+        TS_ASSERT_EQUALS( reverse[ 4 ], 1 );
+    }
+
+    /**
+     * The spans of a dataset view reference the vertices of each fiber.
+     */
+    void testDataSetView( void )
+    {
+        WFiberConstView const view = createFiberView( *m_fibers );
+        TS_ASSERT_EQUALS( view.size(), 2 );
+        TS_ASSERT_EQUALS( view.getLength( 1 ), 3 );
+        TS_ASSERT_EQUALS( view.getStartIndex( 1 ), 2 );
+        TS_ASSERT_EQUALS( view[ 1 ].data(), &( *m_fibers->getVertices() )[ 6 ] );
+        TS_ASSERT_EQUALS( view[ 1 ].getPosition( 2 ), WPosition( 1, 1, 4 ) );
+        TS_ASSERT_EQUALS( view[ 0 ][ 1 ][ 1 ], 4.0f );
+        TS_ASSERT_DELTA( view[ 0 ].getLength(), 5.0, 1e-9 );
+        TS_ASSERT_DELTA( view[ 1 ].getLength(), 3.0, 1e-9 );
+
+        WLine line;
+        view[ 1 ].copyTo( &line );
+        TS_ASSERT_EQUALS( line.size(), 3 );
+        TS_ASSERT_EQUALS( line[ 1 ], WPosition( 1, 1, 2 ) );
+        view[ 0 ].copyTo( &line );
+        TS_ASSERT_EQUALS( line.size(), 2 );
+        TS_ASSERT_EQUALS( line[ 1 ], WPosition( 3, 4, 0 ) );
+    }
+
+    /**
+     * Transforms write into preallocated arrays or in place.
+     */
+    void testTransform( void )
+    {
+        WFiberConstView const in = createFiberView( *m_fibers );
+        std::vector< float > vertices( m_fibers->getVertices()->size() );
+        WFiberView const out = createFiberView( &vertices, *m_fibers->getLineStartIndexes(), *m_fibers->getLineLengths() );
+        transformFibers( in, out, []( WPosition const& p )
+        {
+            return WPosition( p[ 0 ] + 1.0, 2.0 * p[ 1 ], -p[ 2 ] );
+        } );
+        TS_ASSERT_EQUALS( out[ 0 ].getPosition( 1 ), WPosition( 4, 8, 0 ) );
+        TS_ASSERT_EQUALS( out[ 1 ].getPosition( 2 ), WPosition( 2, 2, -4 ) );
+        TS_ASSERT_EQUALS( in[ 1 ].getPosition( 2 ), WPosition( 1, 1, 4 ) );
+
+        // in place
+        WFiberConstView const outRead( &vertices[ 0 ], &( *m_fibers->getLineStartIndexes() )[ 0 ],
+                                       &( *m_fibers->getLineLengths() )[ 0 ], 2 );
+        transformFibers( outRead, out, []( WPosition const& p )
+        {
+            return WPosition( p[ 0 ] - 1.0, p[ 1 ], p[ 2 ] );
+        } );
+        TS_ASSERT_EQUALS( out[ 1 ].getPosition( 0 ), WPosition( 1, 2, -1 ) );
+    }
+
+    /**
+     * Every fiber is processed exactly once.
+     */
+    void testForEachFiberBlock( void )
+    {
+        std::vector< int > visited( 10000, 0 );
+        forEachFiberBlock( visited.size(), [ &visited ]( size_t begin, size_t end )
+        {
+            for( size_t i = begin; i < end; ++i )
+            {
+                ++visited[ i ];
+            }
+        } );
+        for( size_t i = 0; i < visited.size(); ++i )
+        {
+            TS_ASSERT_EQUALS( visited[ i ], 1 );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( forEachFiberBlock( 0, []( size_t, size_t ) {} ) ); // NOLINT curly braces
+    }
+
+    /**
+     * Resampling by segment length gives the vertices of the line resampling, without target only the size is computed.
+     */
+    void testResampleBySegmentLength( void )
+    {
+        // a zigzag with a duplicate vertex, a long segment and a short remainder
+        float const vertices[] = { 0, 0, 0, 0, 0, 0, 1.3f, 0.4f, 0, 1.6f, 1.9f, 0.2f, 6, 2, 0.5f, 6.2f, 2.1f, 0.5f }; // NOLINT curly braces
+        WFiberConstSpan const fiber( vertices, 6 );
+        for( int keep = 0; keep < 2; ++keep )
+        {
+            WLine line;
+            fiber.copyTo( &line );
+            if( keep == 1 )
+            {
+                line.resampleBySegmentLengthKeepShortFibers( 0.7 );
+            }
+            else
+            {
+                line.resampleBySegmentLength( 0.7 );
+            }
+
+            std::size_t const size = resampleBySegmentLength( fiber, 0.7, keep == 1, NULL );
+            TS_ASSERT_EQUALS( size, line.size() );
+            std::vector< float > resampled( 3 * size );
+            WFiberSpan const target( &resampled[ 0 ], size );
+            TS_ASSERT_EQUALS( resampleBySegmentLength( fiber, 0.7, keep == 1, &target ), size );
+            for( std::size_t i = 0; i < size; ++i )
+            {
+                for( std::size_t c = 0; c < 3; ++c )
+                {
+                    TS_ASSERT_EQUALS( target[ i ][ c ], static_cast< float >( line[ i ][ c ] ) );
+                }
+            }
+        }
+
+        TS_ASSERT_EQUALS( resampleBySegmentLength( WFiberConstSpan( vertices, 2 ), 0.7, true, NULL ), 1 );
+        TS_ASSERT_EQUALS( resampleBySegmentLength( WFiberConstSpan( vertices, 0 ), 0.7, false, NULL ), 0 );
+    }
+
+private:
+    //! the test fibers
+    std::shared_ptr< WDataSetFibers > m_fibers;
+};
+
+#endif  // WFIBERVIEW_TEST_H
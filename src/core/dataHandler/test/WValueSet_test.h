@@ -147,6 +147,31 @@ public:
         TS_ASSERT_THROWS_ANYTHING( set2.getWValue( 0 ) );
     }
 
+    /**
+     * A value view points to the components of the i-th value without copying them.
+     */
+    void testGetValueView( void )
+    {
+        int8_t a[6] = { 1, 2, 3, 4, 5, 6 }; // NOLINT curly braces
+        const std::shared_ptr< std::vector< int8_t > > v( new std::vector< int8_t >( a, a + 6 ) );
+        WValueSet< int8_t > set( 1, 2, v, W_DT_INT8 );
+
+        for( std::size_t idx = 0; idx < 3; ++idx )
+        {
+            WValueView< int8_t, 2 > view = set.getValueView< 2 >( idx );
+            TS_ASSERT_EQUALS( view.begin(), &( *v )[ idx * 2 ] );
+            TS_ASSERT_EQUALS( view[ 0 ], a[ idx * 2 ] );
+            TS_ASSERT_EQUALS( view[ 1 ], a[ idx * 2 + 1 ] );
+            TS_ASSERT_EQUALS( set.getWValueDouble( idx ), WValue< double >( set.getWValue( idx ) ) );
+        }
+
+        // catch wrong indices, dimensions and orders
+        TS_ASSERT_THROWS_ANYTHING( set.getValueView< 2 >( 3 ) );
+        TS_ASSERT_THROWS_ANYTHING( set.getValueView< 3 >( 0 ) );
+        WValueSet< int8_t > set2( 2, 2, v, W_DT_INT8 );
+        TS_ASSERT_THROWS_ANYTHING( set2.getValueView< 2 >( 0 ) );
+    }
+
     /**
      * A subarray should never exceed the valuesets boundaries and should not have a length of 0.
      */
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WVALUEVIEW_TEST_H
+#define WVALUEVIEW_TEST_H
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WValueView.h"
+
+/**
+ * Tests the conversions of WValueView.
+ */
+class WValueViewTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * The view reads the components in place.
+     */
+    void testAccess( void )
+    {
+        float data[ 4 ] = { 1.0f, 2.0f, 3.0f, 4.0f }; // NOLINT curly braces
+        WValueView< float, 3 > view( data + 1 );
+        TS_ASSERT_EQUALS( view.size(), 3 );
+        TS_ASSERT_EQUALS( view[ 0 ], 2.0f );
+        TS_ASSERT_EQUALS( view[ 2 ], 4.0f );
+        TS_ASSERT_EQUALS( view.end() - view.begin(), 3 );
+
+        data[ 2 ] = 7.0f;
+        TS_ASSERT_EQUALS( view[ 1 ], 7.0f );
+        TS_ASSERT_THROWS_ANYTHING( view[ 3 ] );
+    }
+
+    /**
+     * The conversions copy all components in order.
+     */
+    void testConversions( void )
+    {
+        float data[ 6 ] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f }; // NOLINT curly braces
+        WValueView< float, 6 > view( data );
+
+        WMatrixFixed< double, 6, 1 > vector = view.toVector< double >();
+        WValue< double > value = view.toWValue< double >();
+        TS_ASSERT_EQUALS( value.size(), 6 );
+        for( std::size_t i = 0; i < 6; ++i )
+        {
+            TS_ASSERT_EQUALS( vector[ i ], data[ i ] );
+            TS_ASSERT_EQUALS( value[ i ], data[ i ] );
+        }
+
+        // the same tensor as constructed from a WValue
+        WValue< float > components( 6 );
+        for( std::size_t i = 0; i < 6; ++i )
+        {
+            components[ i ] = data[ i ];
+        }
+        WTensorSym< 2, 3, float > expected( components );
+        WTensorSym< 2, 3, float > tensor = view.toTensorSym< 2, 3 >();
+        for( std::size_t i = 0; i < 3; ++i )
+        {
+            for( std::size_t j = 0; j < 3; ++j )
+            {
+                TS_ASSERT_EQUALS( tensor( i, j ), expected( i, j ) );
+            }
+        }
+    }
+};
+
+#endif  // WVALUEVIEW_TEST_H
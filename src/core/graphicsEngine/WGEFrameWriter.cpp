@@ -0,0 +1,283 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <string>
+
+#include <osgDB/WriteFile>
+
+#include "../common/WLogger.h"
+
+#include "WGEFrameWriter.h"
+
+WGEFrameWriter::WGEFrameWriter( std::size_t threads, std::size_t queueSize, QueuePolicy policy ):
+    m_queueSize( std::max< std::size_t >( queueSize, 1 ) ),
+    m_policy( policy ),
+    m_active( 0 ),
+    m_written( 0 ),
+    m_dropped( 0 ),
+    m_stop( false ),
+    m_rawQueued( 0 ),
+    m_rawWritten( 0 ),
+    m_rawFrames( 0 )
+{
+    if( threads == 0 )
+    {
+        threads = std::max< std::size_t >( std::thread::hardware_concurrency() / 2, 1 );
+    }
+    for( std::size_t i = 0; i < threads; ++i )
+    {
+        m_threads.push_back( std::thread( &WGEFrameWriter::encodeThread, this ) );
+    }
+}
+
+WGEFrameWriter::~WGEFrameWriter()
+{
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_stop = true;
+    }
+    m_frameQueued.notify_all();
+    for( std::size_t i = 0; i < m_threads.size(); ++i )
+    {
+        m_threads[ i ].join();
+    }
+    closeRawFile();
+}
+
+void WGEFrameWriter::setQueuePolicy( QueuePolicy policy )
+{
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_policy = policy;
+    }
+    // blocked pushes need to check the new policy
+    m_frameTaken.notify_all();
+}
+
+bool WGEFrameWriter::setRawFile( std::string const& fname )
+{
+    // frames queued before the switch still go to the old file
+    std::unique_lock< std::mutex > lock( m_mutex );
+    while( !m_queue.empty() || m_active )
+    {
+        m_frameTaken.wait( lock );
+    }
+
+    closeRawFile();
+    if( fname.empty() )
+    {
+        return true;
+    }
+
+    m_rawFile.open( fname.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+    if( !m_rawFile )
+    {
+        wlog::error( "WGEFrameWriter" ) << "Could not open raw file " << fname << ". Writing image files instead.";
+        m_rawFile.clear();
+        return false;
+    }
+    m_rawFilename = fname;
+    m_rawQueued = 0;
+    m_rawWritten = 0;
+    m_rawFrames = 0;
+    return true;
+}
+
+bool WGEFrameWriter::push( osg::ref_ptr< osg::Image > image, std::string const& filename )
+{
+    bool dropped = false;
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        while( m_queue.size() >= m_queueSize && m_policy == BLOCK )
+        {
+            m_frameTaken.wait( lock );
+        }
+        if( m_queue.size() >= m_queueSize )
+        {
+            ++m_dropped;
+            dropped = true;
+            if( m_policy == DROP_NEWEST )
+            {
+                return false;
+            }
+            m_queue.pop_front();
+        }
+
+        Frame frame;
+        frame.m_image = image;
+        frame.m_filename = m_rawFilename.empty() ? filename : std::string();
+        frame.m_rawIndex = 0;
+        m_queue.push_back( frame );
+    }
+    m_frameQueued.notify_one();
+    return !dropped;
+}
+
+void WGEFrameWriter::wait()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    while( !m_queue.empty() || m_active )
+    {
+        m_frameTaken.wait( lock );
+    }
+}
+
+std::size_t WGEFrameWriter::getWrittenFrames() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_written;
+}
+
+std::size_t WGEFrameWriter::getDroppedFrames() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_dropped;
+}
+
+bool WGEFrameWriter::writeImage( osg::Image const& image, std::string const& filename ) const
+{
+    return osgDB::writeImageFile( image, filename );
+}
+
+void WGEFrameWriter::encodeThread()
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    while( true )
+    {
+        while( m_queue.empty() && !m_stop )
+        {
+            m_frameQueued.wait( lock );
+        }
+        if( m_queue.empty() )
+        {
+            return;
+        }
+
+        Frame frame = m_queue.front();
+        m_queue.pop_front();
+        if( frame.m_filename.empty() )
+        {
+            // the order of the frames in the raw file is the order they leave the queue
+            frame.m_rawIndex = m_rawQueued++;
+        }
+        ++m_active;
+        lock.unlock();
+        m_frameTaken.notify_all();
+
+        bool success = false;
+        if( frame.m_filename.empty() )
+        {
+            success = writeRaw( frame );
+        }
+        else
+        {
+            success = writeImage( *frame.m_image, frame.m_filename );
+            if( !success )
+            {
+                wlog::error( "WGEFrameWriter" ) << "Could not write frame to " << frame.m_filename << ".";
+            }
+        }
+
+        lock.lock();
+        --m_active;
+        if( success )
+        {
+            ++m_written;
+        }
+        else
+        {
+            ++m_dropped;
+        }
+        m_frameTaken.notify_all();
+    }
+}
+
+bool WGEFrameWriter::writeRaw( Frame const& frame )
+{
+    std::unique_lock< std::mutex > lock( m_rawMutex );
+    while( m_rawWritten != frame.m_rawIndex )
+    {
+        m_rawCondition.wait( lock );
+    }
+
+    osg::Image const& image = *frame.m_image;
+    if( !m_rawFormat.valid() )
+    {
+        m_rawFormat = frame.m_image;
+    }
+    bool success = image.s() == m_rawFormat->s() && image.t() == m_rawFormat->t() && image.r() == m_rawFormat->r() &&
+                   image.getPixelFormat() == m_rawFormat->getPixelFormat() && image.getDataType() == m_rawFormat->getDataType();
+    if( !success )
+    {
+        wlog::warn( "WGEFrameWriter" ) << "Dropped frame " << frame.m_rawIndex << " as its size or format differs from the first frame.";
+    }
+    else
+    {
+        // skip the row padding, raw video tools expect tightly packed rows
+        std::size_t const rowSize = image.getRowSizeInBytes();
+        for( int slice = 0; slice < image.r(); ++slice )
+        {
+            for( int row = 0; row < image.t(); ++row )
+            {
+                m_rawFile.write( reinterpret_cast< char const* >( image.data( 0, row, slice ) ), rowSize );
+            }
+        }
+        success = static_cast< bool >( m_rawFile );
+        if( !success )
+        {
+            wlog::error( "WGEFrameWriter" ) << "Could not write frame " << frame.m_rawIndex << " to " << m_rawFilename << ".";
+            m_rawFile.clear();
+        }
+        else
+        {
+            ++m_rawFrames;
+        }
+    }
+
+    ++m_rawWritten;
+    lock.unlock();
+    m_rawCondition.notify_all();
+    return success;
+}
+
+void WGEFrameWriter::closeRawFile()
+{
+    if( m_rawFilename.empty() )
+    {
+        return;
+    }
+
+    m_rawFile.close();
+    if( m_rawFormat.valid() )
+    {
+        bool const rgba = m_rawFormat->getPixelFormat() == GL_RGBA;
+        wlog::info( "WGEFrameWriter" ) << "Wrote " << m_rawFrames << " raw frames of " << m_rawFormat->s() << "x" << m_rawFormat->t()
+                                       << " pixels to " << m_rawFilename << ". Encode them with: ffmpeg -f rawvideo -pix_fmt "
+                                       << ( rgba ? "rgba" : "rgb24" ) << " -video_size " << m_rawFormat->s() << "x" << m_rawFormat->t()
+                                       << " -framerate 24 -i \"" << m_rawFilename << "\" -vf vflip movie.mp4";
+    }
+    m_rawFilename.clear();
+    m_rawFormat = NULL;
+}
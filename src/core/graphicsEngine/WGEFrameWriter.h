@@ -0,0 +1,228 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WGEFRAMEWRITER_H
+#define WGEFRAMEWRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osg/Image>
+
+/**
+ * Writes captured frames in the background. Frames are queued by push() and a pool of encoder threads compresses and writes them, so the
+ * thread grabbing the frames (usually the draw traversal) only pays for the queue operation. The queue is bounded. What happens if it is
+ * full is defined by the QueuePolicy.
+ *
+ * Instead of encoding each frame into its own image file, the frames can be appended uncompressed to a single raw file (see setRawFile()).
+ * This is the cheapest way to record as no compression is done at all. The raw file can be encoded later, for example with ffmpeg.
+ *
+ * \ingroup GE
+ */
+class WGEFrameWriter // NOLINT
+{
+public:
+    /**
+     * Convenience typedef for a std::shared_ptr< WGEFrameWriter >.
+     */
+    typedef std::shared_ptr< WGEFrameWriter > SPtr;
+
+    /**
+     * What push() does if the queue is full.
+     */
+    enum QueuePolicy
+    {
+        BLOCK,          //!< wait until an encoder took a frame, slows down the caller but no frame gets lost
+        DROP_NEWEST,    //!< drop the frame to push
+        DROP_OLDEST     //!< drop the oldest queued frame
+    };
+
+    /**
+     * Creates the writer and starts the encoder threads.
+     *
+     * \param threads the number of encoder threads, 0 uses half of the available cores
+     * \param queueSize the maximum number of queued frames
+     * \param policy what to do if the queue is full
+     */
+    explicit WGEFrameWriter( std::size_t threads = 0, std::size_t queueSize = 8, QueuePolicy policy = BLOCK );
+
+    /**
+     * Destructor. Writes all queued frames and stops the encoder threads.
+     */
+    virtual ~WGEFrameWriter();
+
+    /**
+     * Sets what happens if the queue is full.
+     *
+     * \param policy the new policy
+     */
+    void setQueuePolicy( QueuePolicy policy );
+
+    /**
+     * Append all frames pushed from now on to the given raw file instead of writing image files. The rows of each frame are written as
+     * they are stored in the image, without padding. Frames with a different size or pixel format than the first one are dropped. Waits
+     * for all queued frames and closes the previous raw file.
+     *
+     * \param fname the raw file, an empty name switches back to image files
+     *
+     * \return false if the file could not be opened. Frames are written as image files in this case.
+     */
+    bool setRawFile( std::string const& fname );
+
+    /**
+     * Queue a frame for writing.
+     *
+     * \param image the frame. It must not be modified afterwards.
+     * \param filename the image file to write. Its extension selects the format. Ignored if a raw file is set.
+     *
+     * \return false if this or another frame was dropped because the queue was full.
+     */
+    bool push( osg::ref_ptr< osg::Image > image, std::string const& filename );
+
+    /**
+     * Wait until all queued frames are written.
+     */
+    void wait();
+
+    /**
+     * The number of frames written so far.
+     *
+     * \return the number of frames
+     */
+    std::size_t getWrittenFrames() const;
+
+    /**
+     * The number of frames dropped so far because the queue was full or the frame did not fit into the raw file.
+     *
+     * \return the number of frames
+     */
+    std::size_t getDroppedFrames() const;
+
+protected:
+    /**
+     * Encodes a frame and writes it to an image file. Called by the encoder threads.
+     *
+     * \param image the frame
+     * \param filename the file
+     *
+     * \return true if successful
+     */
+    virtual bool writeImage( osg::Image const& image, std::string const& filename ) const;
+
+private:
+    /**
+     * A queued frame.
+     */
+    struct Frame
+    {
+        osg::ref_ptr< osg::Image > m_image; //!< the frame
+        std::string m_filename; //!< the image file, empty if the frame goes to the raw file
+        std::size_t m_rawIndex; //!< the position of the frame in the raw file
+    };
+
+    /**
+     * Takes frames from the queue and writes them until the writer gets destroyed.
+     */
+    void encodeThread();
+
+    /**
+     * Appends a frame to the raw file. Frames are appended in the order given by their m_rawIndex.
+     *
+     * \param frame the frame
+     *
+     * \return true if successful
+     */
+    bool writeRaw( Frame const& frame );
+
+    /**
+     * Closes the raw file and logs how to encode it.
+     */
+    void closeRawFile();
+
+    //! the queued frames
+    std::deque< Frame > m_queue;
+
+    //! the maximum size of m_queue
+    std::size_t m_queueSize;
+
+    //! what to do if m_queue is full
+    QueuePolicy m_policy;
+
+    //! the number of frames taken from the queue but not yet written
+    std::size_t m_active;
+
+    //! the number of frames written
+    std::size_t m_written;
+
+    //! the number of frames dropped
+    std::size_t m_dropped;
+
+    //! tells the encoder threads to finish
+    bool m_stop;
+
+    //! protects all members above
+    mutable std::mutex m_mutex;
+
+    //! signals new frames and m_stop to the encoder threads
+    std::condition_variable m_frameQueued;
+
+    //! signals that frames were taken from the queue or were written
+    std::condition_variable m_frameTaken;
+
+    //! the name of the raw file, empty if image files are written
+    std::string m_rawFilename;
+
+    //! the raw file
+    std::ofstream m_rawFile;
+
+    //! the number of frames passed to the encoder threads for the raw file so far, protected by m_mutex
+    std::size_t m_rawQueued;
+
+    //! the number of queued frames done with the raw file so far, including dropped ones, protected by m_rawMutex
+    std::size_t m_rawWritten;
+
+    //! the number of frames appended to the raw file so far, protected by m_rawMutex
+    std::size_t m_rawFrames;
+
+    //! the first frame of the raw file which defines the size of all frames, protected by m_rawMutex
+    osg::ref_ptr< osg::Image > m_rawFormat;
+
+    //! makes the encoder threads append to the raw file one after another
+    std::mutex m_rawMutex;
+
+    //! signals changes of m_rawWritten
+    std::condition_variable m_rawCondition;
+
+    //! the encoder threads
+    std::vector< std::thread > m_threads;
+};
+
+#endif  // WGEFRAMEWRITER_H
@@ -364,72 +364,215 @@ osg::ref_ptr< osg::Node > wge::generateSolidBoundingBoxNode( const WBoundingBox&
     return transform;
 }
 
-osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometry( WTriangleMesh::SPtr mesh,
-                                                          const WColor& defaultColor,
-                                                          bool includeNormals,
-                                                          bool lighting,
-                                                          bool useMeshColor )
+namespace
 {
-    osg::ref_ptr< osg::Geometry> geometry( new osg::Geometry );
-    geometry->setVertexArray( mesh->getVertexArray() );
+    //! below this number of elements, the arrays are filled by the calling thread only
+    std::ptrdiff_t const minParallelSize = 16384;
+
+    /**
+     * Fills the first primitive set of a geometry with indices. A primitive set of the same mode and size is reused and only marked dirty if
+     * an index changed.
+     *
+     * \param geometry the geometry
+     * \param mode the primitive mode
+     * \param size the number of indices
+     * \param index function returning the i-th index
+     */
+    template< typename IndexFunction >
+    void updateElements( osg::Geometry* geometry, GLenum mode, std::size_t size, IndexFunction const& index )
+    {
+        osg::DrawElementsUInt* elements = NULL;
+        if( geometry->getNumPrimitiveSets() == 1 )
+        {
+            elements = dynamic_cast< osg::DrawElementsUInt* >( geometry->getPrimitiveSet( 0 ) );
+        }
+        if( !elements || elements->getMode() != mode || elements->size() != size )
+        {
+            if( geometry->getNumPrimitiveSets() )
+            {
+                geometry->removePrimitiveSet( 0, geometry->getNumPrimitiveSets() );
+            }
+            elements = new osg::DrawElementsUInt( mode, size );
+            geometry->addPrimitiveSet( elements );
+        }
 
-    osg::DrawElementsUInt* surfaceElement;
+        bool changed = false;
+        std::ptrdiff_t const nbElements = size;
+        #pragma omp parallel for schedule( static ) reduction( || : changed ) if( nbElements > minParallelSize )
+        for( std::ptrdiff_t i = 0; i < nbElements; ++i )
+        {
+            GLuint const value = static_cast< GLuint >( index( i ) );
+            if( ( *elements )[ i ] != value )
+            {
+                ( *elements )[ i ] = value;
+                changed = true;
+            }
+        }
+        if( changed )
+        {
+            elements->dirty();
+        }
+    }
 
-    surfaceElement = new osg::DrawElementsUInt( osg::PrimitiveSet::TRIANGLES, 0 );
+    /**
+     * Fills an array owned by a geometry. The current array of the geometry is reused if it has the right type and is not shared with the
+     * mesh. It is only marked dirty if its size or an element changed.
+     *
+     * \tparam ArrayType the type of the array
+     * \param current the array the geometry uses now, may be NULL
+     * \param shared an array of the mesh which must not be overwritten, may be NULL
+     * \param size the number of elements
+     * \param value function returning the i-th element
+     *
+     * \return the filled array
+     */
+    template< typename ArrayType, typename ValueFunction >
+    osg::ref_ptr< ArrayType > updateArray( osg::Array* current, osg::Array const* shared, std::size_t size, ValueFunction const& value )
+    {
+        osg::ref_ptr< ArrayType > array = dynamic_cast< ArrayType* >( current );
+        if( !array.valid() || array.get() == shared )
+        {
+            array = new ArrayType( size );
+        }
 
-    std::vector< size_t > tris = mesh->getTriangles();
-    surfaceElement->reserve( tris.size() );
+        bool changed = array->size() != size;
+        array->resize( size );
+        std::ptrdiff_t const nbElements = size;
+        #pragma omp parallel for schedule( static ) reduction( || : changed ) if( nbElements > minParallelSize )
+        for( std::ptrdiff_t i = 0; i < nbElements; ++i )
+        {
+            typename ArrayType::ElementDataType const v = value( i );
+            if( ( *array )[ i ] != v )
+            {
+                ( *array )[ i ] = v;
+                changed = true;
+            }
+        }
+        if( changed )
+        {
+            array->dirty();
+        }
+        return array;
+    }
 
-    for( unsigned int vertId = 0; vertId < tris.size(); ++vertId )
+    /**
+     * Prepares an array of the mesh for use in a geometry. If the geometry already uses it, it is marked dirty as the mesh might have changed it.
+     *
+     * \param current the array the geometry uses now, may be NULL
+     * \param array the array of the mesh
+     *
+     * \return the array of the mesh
+     */
+    template< typename ArrayType >
+    osg::ref_ptr< ArrayType > shareArray( osg::Array const* current, osg::ref_ptr< ArrayType > array )
     {
-        surfaceElement->push_back( tris[vertId] );
+        if( current == array.get() )
+        {
+            array->dirty();
+        }
+        return array;
     }
-    geometry->addPrimitiveSet( surfaceElement );
 
-    // add the mesh colors
-    if( mesh->getVertexColorArray() && useMeshColor )
+    /**
+     * Sets the color of the whole geometry.
+     *
+     * \param geometry the geometry
+     * \param shared the color array of the mesh which must not be overwritten, may be NULL
+     * \param color the color
+     */
+    void setOverallColor( osg::Geometry* geometry, osg::Array const* shared, WColor const& color )
     {
-        geometry->setColorArray( mesh->getVertexColorArray() );
-        geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+        geometry->setColorArray( updateArray< osg::Vec4Array >( geometry->getColorArray(), shared, 1,
+                                                                 [ &color ]( std::ptrdiff_t ){ return color; } ) ); // NOLINT
+        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
     }
-    else
+
+    /**
+     * Sets up a standard two-sided lighting for the geometry, if it has none yet.
+     *
+     * \param geometry the geometry
+     */
+    void setupLighting( osg::Geometry* geometry )
     {
-        osg::ref_ptr< osg::Vec4Array > colors = osg::ref_ptr< osg::Vec4Array >( new osg::Vec4Array );
-        colors->push_back( defaultColor );
-        geometry->setColorArray( colors );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+        osg::StateSet* state = geometry->getOrCreateStateSet();
+        if( state->getAttribute( osg::StateAttribute::LIGHTMODEL ) )
+        {
+            return;
+        }
+
+        osg::ref_ptr<osg::LightModel> lightModel = new osg::LightModel();
+        lightModel->setTwoSided( true );
+        state->setAttributeAndModes( lightModel.get(), osg::StateAttribute::ON );
+        state->setMode( GL_BLEND, osg::StateAttribute::ON  );
+        {
+            osg::ref_ptr< osg::Material > material = new osg::Material();
+            material->setDiffuse(   osg::Material::FRONT, osg::Vec4( 1.0, 1.0, 1.0, 1.0 ) );
+            material->setSpecular(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
+            material->setAmbient(   osg::Material::FRONT, osg::Vec4( 0.1, 0.1, 0.1, 1.0 ) );
+            material->setEmission(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
+            material->setShininess( osg::Material::FRONT, 25.0 );
+            state->setAttribute( material );
+        }
     }
 
-    // ------------------------------------------------
-    // normals
-    if( includeNormals )
+    /**
+     * Sets the vertices, triangles and optionally normals and lighting of a geometry rendering the mesh with smooth shading.
+     *
+     * \param mesh the mesh
+     * \param includeNormals if true, the vertex normals are used
+     * \param lighting if true and normals are used, a standard lighting is activated
+     * \param geometry the geometry to set up
+     */
+    void setupSmoothShadedGeometry( WTriangleMesh::SPtr mesh, bool includeNormals, bool lighting, osg::Geometry* geometry )
     {
-        geometry->setNormalArray( mesh->getVertexNormalArray() );
-        geometry->setNormalBinding( osg::Geometry::BIND_PER_VERTEX );
+        geometry->setVertexArray( shareArray( geometry->getVertexArray(), mesh->getVertexArray() ) );
 
-        if( lighting )
+        std::vector< size_t > const& tris = mesh->getTriangles();
+        updateElements( geometry, osg::PrimitiveSet::TRIANGLES, tris.size(), [ &tris ]( std::ptrdiff_t i ){ return tris[ i ]; } ); // NOLINT
+
+        // ------------------------------------------------
+        // normals
+        if( includeNormals )
         {
-            // if normals are specified, we also setup a default lighting.
-            osg::StateSet* state = geometry->getOrCreateStateSet();
-            osg::ref_ptr<osg::LightModel> lightModel = new osg::LightModel();
-            lightModel->setTwoSided( true );
-            state->setAttributeAndModes( lightModel.get(), osg::StateAttribute::ON );
-            state->setMode( GL_BLEND, osg::StateAttribute::ON  );
+            geometry->setNormalArray( shareArray( geometry->getNormalArray(), mesh->getVertexNormalArray() ) );
+            geometry->setNormalBinding( osg::Geometry::BIND_PER_VERTEX );
+
+            if( lighting )
             {
-                osg::ref_ptr< osg::Material > material = new osg::Material();
-                material->setDiffuse(   osg::Material::FRONT, osg::Vec4( 1.0, 1.0, 1.0, 1.0 ) );
-                material->setSpecular(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
-                material->setAmbient(   osg::Material::FRONT, osg::Vec4( 0.1, 0.1, 0.1, 1.0 ) );
-                material->setEmission(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
-                material->setShininess( osg::Material::FRONT, 25.0 );
-                state->setAttribute( material );
+                // if normals are specified, we also setup a default lighting.
+                setupLighting( geometry );
             }
         }
+
+        // enable VBO
+        geometry->setUseDisplayList( false );
+        geometry->setUseVertexBufferObjects( true );
     }
+}
 
-    // enable VBO
-    geometry->setUseDisplayList( false );
-    geometry->setUseVertexBufferObjects( true );
+osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometry( WTriangleMesh::SPtr mesh,
+                                                          const WColor& defaultColor,
+                                                          bool includeNormals,
+                                                          bool lighting,
+                                                          bool useMeshColor,
+                                                          osg::ref_ptr< osg::Geometry > geometry )
+{
+    if( !geometry.valid() )
+    {
+        geometry = new osg::Geometry;
+    }
+    setupSmoothShadedGeometry( mesh, includeNormals, lighting, geometry );
+
+    // add the mesh colors
+    if( mesh->getVertexColorArray() && useMeshColor )
+    {
+        geometry->setColorArray( shareArray( geometry->getColorArray(), mesh->getVertexColorArray() ) );
+        geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+    }
+    else
+    {
+        setOverallColor( geometry, mesh->getVertexColorArray(), defaultColor );
+    }
 
     return geometry;
 }
@@ -438,40 +581,35 @@ osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometryFlatShaded( WTriangleMesh
                                                                     const WColor& defaultColor,
                                                                     bool includeNormals,
                                                                     bool lighting,
-                                                                    bool useMeshColor )
+                                                                    bool useMeshColor,
+                                                                    osg::ref_ptr< osg::Geometry > geometry )
 {
-    osg::DrawElementsUInt* surfaceElement;
-    surfaceElement = new osg::DrawElementsUInt( osg::PrimitiveSet::TRIANGLES, 0 );
-    std::vector< size_t > tris = mesh->getTriangles();
+    if( !geometry.valid() )
+    {
+        geometry = new osg::Geometry;
+    }
 
-    osg::ref_ptr< osg::Geometry> geometry( new osg::Geometry );
+    std::vector< size_t > const& tris = mesh->getTriangles();
     osg::ref_ptr< osg::Vec3Array > oldVertexArray( mesh->getVertexArray() );
-    osg::ref_ptr< osg::Vec3Array > newVertexArray( new osg::Vec3Array );
     osg::ref_ptr< osg::Vec4Array > oldVertexColorArray( mesh->getVertexColorArray() );
-    osg::ref_ptr< osg::Vec4Array > newVertexColorArray( new osg::Vec4Array );
 
     // Make separate vertices for all triangle corners
-    for( size_t index = 0; index < tris.size(); ++index )
-    {
-        newVertexArray->push_back( (*oldVertexArray)[tris[index]] );
-        surfaceElement->push_back( index );
-        newVertexColorArray->push_back( (*oldVertexColorArray)[tris[index]] );
-    }
-    geometry->setVertexArray( newVertexArray );
-    geometry->addPrimitiveSet( surfaceElement );
+    osg::Vec3Array const& verts = *oldVertexArray;
+    geometry->setVertexArray( updateArray< osg::Vec3Array >( geometry->getVertexArray(), oldVertexArray, tris.size(),
+                                                             [ &verts, &tris ]( std::ptrdiff_t i ){ return verts[ tris[ i ] ]; } ) ); // NOLINT
+    updateElements( geometry, osg::PrimitiveSet::TRIANGLES, tris.size(), []( std::ptrdiff_t i ){ return i; } ); // NOLINT
 
     // add the mesh colors
-    if( mesh->getVertexColorArray() && useMeshColor )
+    if( oldVertexColorArray && useMeshColor )
     {
-        geometry->setColorArray( newVertexColorArray );
+        osg::Vec4Array const& colors = *oldVertexColorArray;
+        geometry->setColorArray( updateArray< osg::Vec4Array >( geometry->getColorArray(), oldVertexColorArray, tris.size(),
+                                                                [ &colors, &tris ]( std::ptrdiff_t i ){ return colors[ tris[ i ] ]; } ) ); // NOLINT
         geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
     }
     else
     {
-        osg::ref_ptr< osg::Vec4Array > colors = osg::ref_ptr< osg::Vec4Array >( new osg::Vec4Array );
-        colors->push_back( defaultColor );
-        geometry->setColorArray( colors );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+        setOverallColor( geometry, oldVertexColorArray, defaultColor );
     }
 
     // ------------------------------------------------
@@ -481,31 +619,15 @@ osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometryFlatShaded( WTriangleMesh
         // Set all vertex normals to the normals of the corresponding
         // triangles causing uniform shading in a triangle
         osg::ref_ptr< osg::Vec3Array > oldTriNormals = mesh->getTriangleNormalArray( true );
-        osg::ref_ptr< osg::Vec3Array > newVertNormals( new osg::Vec3Array );
-        for( size_t index = 0; index < tris.size(); ++index )
-        {
-            newVertNormals->push_back( (*oldTriNormals)[index/3] );
-        }
-        geometry->setNormalArray( newVertNormals );
+        osg::Vec3Array const& normals = *oldTriNormals;
+        geometry->setNormalArray( updateArray< osg::Vec3Array >( geometry->getNormalArray(), oldTriNormals, tris.size(),
+                                                                 [ &normals ]( std::ptrdiff_t i ){ return normals[ i / 3 ]; } ) ); // NOLINT
         geometry->setNormalBinding( osg::Geometry::BIND_PER_VERTEX );
 
         if( lighting )
         {
             // if normals are specified, we also setup a default lighting.
-            osg::StateSet* state = geometry->getOrCreateStateSet();
-            osg::ref_ptr<osg::LightModel> lightModel = new osg::LightModel();
-            lightModel->setTwoSided( true );
-            state->setAttributeAndModes( lightModel.get(), osg::StateAttribute::ON );
-            state->setMode( GL_BLEND, osg::StateAttribute::ON  );
-            {
-                osg::ref_ptr< osg::Material > material = new osg::Material();
-                material->setDiffuse(   osg::Material::FRONT, osg::Vec4( 1.0, 1.0, 1.0, 1.0 ) );
-                material->setSpecular(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
-                material->setAmbient(   osg::Material::FRONT, osg::Vec4( 0.1, 0.1, 0.1, 1.0 ) );
-                material->setEmission(  osg::Material::FRONT, osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
-                material->setShininess( osg::Material::FRONT, 25.0 );
-                state->setAttribute( material );
-            }
+            setupLighting( geometry );
         }
     }
 
@@ -519,25 +641,26 @@ osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometryFlatShaded( WTriangleMesh
 osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometry( WTriangleMesh::SPtr mesh,
                                                           const WColoredVertices& colorMap,
                                                           const WColor& defaultColor,
-                                                          bool includeNormals, bool lighting )
+                                                          bool includeNormals, bool lighting,
+                                                          osg::ref_ptr< osg::Geometry > geometry )
 {
-    osg::ref_ptr< osg::Geometry >  geometry = convertToOsgGeometry( mesh, defaultColor, includeNormals, lighting, false );
+    if( !geometry.valid() )
+    {
+        geometry = new osg::Geometry;
+    }
+    setupSmoothShadedGeometry( mesh, includeNormals, lighting, geometry );
 
     // ------------------------------------------------
     // colors
-    osg::ref_ptr< osg::Vec4Array > colors = osg::ref_ptr< osg::Vec4Array >( new osg::Vec4Array );
-    for( size_t i = 0; i < mesh->vertSize(); ++i )
-    {
-        colors->push_back( defaultColor );
-    }
-    for( std::map< size_t, WColor >::const_iterator vc = colorMap.getData().begin(); vc != colorMap.getData().end(); ++vc )
-    {
-        // ATTENTION: the colormap might not be available and hence an old one, but the new mesh might have triggered the update
-        if( vc->first < colors->size() )
+    // ATTENTION: the colormap might not be available and hence an old one, but the new mesh might have triggered the update. Colors of
+    // vertices not in the mesh are ignored.
+    std::map< size_t, WColor > const& colorData = colorMap.getData();
+    osg::ref_ptr< osg::Vec4Array > colors = updateArray< osg::Vec4Array >( geometry->getColorArray(), mesh->getVertexColorArray(),
+                                                                             mesh->vertSize(), [ &colorData, &defaultColor ]( std::ptrdiff_t i ) // NOLINT
         {
-            colors->at( vc->first ) = vc->second;
-        }
-    }
+            std::map< size_t, WColor >::const_iterator vc = colorData.find( i );
+            return vc == colorData.end() ? defaultColor : vc->second;
+        } );
 
     geometry->setColorArray( colors );
     geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
@@ -547,40 +670,33 @@ osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometry( WTriangleMesh::SPtr mes
 
 osg::ref_ptr< osg::Geometry > wge::convertToOsgGeometryLines( WTriangleMesh::SPtr mesh,
                                                               const WColor& defaultColor,
-                                                              bool useMeshColor )
+                                                              bool useMeshColor,
+                                                              osg::ref_ptr< osg::Geometry > geometry )
 {
-    osg::ref_ptr< osg::Geometry > geometry( new osg::Geometry );
-    geometry->setVertexArray( mesh->getVertexArray() );
-
-    osg::DrawElementsUInt* meshElement;
-
-    meshElement = new osg::DrawElementsUInt( osg::PrimitiveSet::LINES, 0 );
-
-    std::vector< size_t > tris = mesh->getTriangles();
-    meshElement->reserve( tris.size() * 3 );
-
-    for( unsigned int triId = 0; triId < tris.size() / 3.; ++triId )
+    if( !geometry.valid() )
     {
-        for( size_t edgeId = 0; edgeId < 3; ++edgeId )
-        {
-            meshElement->push_back( tris[triId*3 + edgeId] );
-            meshElement->push_back( tris[triId*3 + ( edgeId + 1 ) % 3] );
-        }
+        geometry = new osg::Geometry;
     }
-    geometry->addPrimitiveSet( meshElement );
+    geometry->setVertexArray( shareArray( geometry->getVertexArray(), mesh->getVertexArray() ) );
+
+    // each triangle gives the lines of its three edges
+    std::vector< size_t > const& tris = mesh->getTriangles();
+    updateElements( geometry, osg::PrimitiveSet::LINES, tris.size() / 3 * 6, [ &tris ]( std::ptrdiff_t i ) // NOLINT
+        {
+            std::ptrdiff_t const triId = i / 6;
+            std::ptrdiff_t const edgeId = ( i % 6 ) / 2;
+            return tris[ triId * 3 + ( edgeId + i % 2 ) % 3 ];
+        } );
 
     // add the mesh colors
     if( mesh->getVertexColorArray() && useMeshColor )
     {
-        geometry->setColorArray( mesh->getVertexColorArray() );
+        geometry->setColorArray( shareArray( geometry->getColorArray(), mesh->getVertexColorArray() ) );
         geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
     }
     else
     {
-        osg::ref_ptr< osg::Vec4Array > colors = osg::ref_ptr< osg::Vec4Array >( new osg::Vec4Array );
-        colors->push_back( defaultColor );
-        geometry->setColorArray( colors );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+        setOverallColor( geometry, mesh->getVertexColorArray(), defaultColor );
     }
 
     osg::StateSet* stateset = geometry->getOrCreateStateSet();
@@ -127,14 +127,21 @@ namespace wge
      * \param defaultColor This color is used in case the useMeshColor parameter is false or no colors are defined in the mesh.
      * \param lighting if true, a standard lighting is activated for this geometry
      * \param useMeshColor if true, the mesh color is used. If false, the defaultColor is used.
+     * \param geometry if valid, this geometry is updated and returned instead of creating a new one.
      * \return an osg::Geometry containing the mesh
      * \note mesh cannot be const since osg::Geometry needs non-const pointers to the contained arrays
+     * \note All mesh conversions can update the geometry they returned before, e.g. after the mesh got deformed or
+     * re-colored. Arrays owned by the geometry, like the indices or expanded vertices, are reused and only marked dirty if an element
+     * changed, so unchanged arrays are not uploaded again. Arrays shared with the mesh are always marked dirty. The arrays are filled
+     * in parallel. The geometry must not be drawn while it gets updated, so update one which is not in the scene graph, or do this in an
+     * update callback.
      */
     osg::ref_ptr< osg::Geometry > convertToOsgGeometry( WTriangleMesh::SPtr mesh,
                                                         const WColor& defaultColor = WColor( 1.0, 1.0, 1.0, 1.0 ),
                                                         bool includeNormals = false,
                                                         bool lighting = false,
-                                                        bool useMeshColor = true );
+                                                        bool useMeshColor = true,
+                                                        osg::ref_ptr< osg::Geometry > geometry = osg::ref_ptr< osg::Geometry >() );
 
 
     /**
@@ -147,6 +154,7 @@ namespace wge
      * \param defaultColor This color is used in case the useMeshColor parameter is false or no colors are defined in the mesh.
      * \param lighting if true, a standard lighting is activated for this geometry
      * \param useMeshColor if true, the mesh color is used. If false, the defaultColor is used.
+     * \param geometry if valid, this geometry is updated and returned instead of creating a new one. See convertToOsgGeometry().
      * \return an osg::Geometry containing the mesh
      * \note mesh cannot be const since osg::Geometry needs non-const pointers to the contained arrays
      */
@@ -154,7 +162,8 @@ namespace wge
                                                                         const WColor& defaultColor = WColor( 1.0, 1.0, 1.0, 1.0 ),
                                                                         bool includeNormals = false,
                                                                         bool lighting = false,
-                                                                        bool useMeshColor = true );
+                                                                        bool useMeshColor = true,
+                                                                        osg::ref_ptr< osg::Geometry > geometry = osg::ref_ptr< osg::Geometry >() );
     /**
      * Extract the vertices and triangles from a WTriangleMesh and save them
      * into an osg::Geometry. It can use the normals and per-vertex colors of the mesh.
@@ -166,13 +175,15 @@ namespace wge
      *                       them into the geometry.
      * \param defaultColor This color is used in case the colorMap does not provide a color for a vertex
      * \param lighting if true, a standard lighting is activated for this geometry*
+     * \param geometry if valid, this geometry is updated and returned instead of creating a new one. See convertToOsgGeometry().
      * \return an osg::Geometry containing the mesh
      * \note mesh cannot be const since osg::Geometry needs non-const pointers to the contained arrays
      */
     osg::ref_ptr< osg::Geometry > convertToOsgGeometry( WTriangleMesh::SPtr mesh, const WColoredVertices& colorMap,
                                                                    const WColor& defaultColor = WColor( 1.0, 1.0, 1.0, 1.0 ),
                                                                    bool includeNormals = false,
-                                                                   bool lighting = false
+                                                                   bool lighting = false,
+                                                                   osg::ref_ptr< osg::Geometry > geometry = osg::ref_ptr< osg::Geometry >()
                                                                    );
 
 
@@ -182,12 +193,14 @@ namespace wge
      * \param mesh The WTriangleMesh used as input.
      * \param defaultColor This color is used in case the useMeshColor parameter is false or no colors are defined in the mesh.
      * \param useMeshColor If true, the mesh color is used. If false, the defaultColor is used.
+     * \param geometry if valid, this geometry is updated and returned instead of creating a new one. See convertToOsgGeometry().
      *
      * \return an osg::Geometry containing the mesh as lines
      */
     osg::ref_ptr< osg::Geometry > convertToOsgGeometryLines( WTriangleMesh::SPtr mesh,
                                                              const WColor& defaultColor = WColor( 1.0, 1.0, 1.0, 1.0 ),
-                                                             bool useMeshColor = true );
+                                                             bool useMeshColor = true,
+                                                             osg::ref_ptr< osg::Geometry > geometry = osg::ref_ptr< osg::Geometry >() );
 
     /**
      * helper function to add a label somewhere
@@ -50,7 +50,7 @@
  *
  * This class is abstract. Derive your own class and handle image writing.
  *
- * \note This class does NOT write the images to disk. Set a callback for this.
+ * \note This class does NOT write the images to disk. Set a callback for this. WGEFrameWriter can write them in the background.
  *
  * \ingroup GE
  */
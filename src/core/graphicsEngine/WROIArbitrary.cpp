@@ -22,7 +22,9 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -144,6 +146,69 @@ float WROIArbitrary::getValue( size_t i )
     return m_vals[i];
 }
 
+std::shared_ptr< const WROIArbitrary::Occupancy > WROIArbitrary::getOccupancy()
+{
+    float const threshold = static_cast< float >( m_threshold->get() );
+
+    boost::unique_lock< boost::mutex > lock( m_occupancyMutex );
+    if( !m_occupancy || m_occupancy->getThreshold() != threshold )
+    {
+        m_occupancy.reset( new Occupancy( m_nbCoordsVec, m_vals, threshold ) );
+    }
+    return m_occupancy;
+}
+
+WROIArbitrary::Occupancy::Occupancy( std::vector< size_t > const& dims, std::vector< float > const& vals, float threshold ) :
+    m_threshold( threshold )
+{
+    for( std::size_t axis = 0; axis < 3; ++axis )
+    {
+        m_nbBlocks[ axis ] = ( dims[ axis ] + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+        m_min[ axis ] = std::numeric_limits< std::size_t >::max();
+        m_max[ axis ] = 0;
+    }
+    m_blocks.resize( m_nbBlocks[ 0 ] * m_nbBlocks[ 1 ] * m_nbBlocks[ 2 ], false );
+
+    std::size_t index = 0;
+    for( std::size_t z = 0; z < dims[ 2 ]; ++z )
+    {
+        for( std::size_t y = 0; y < dims[ 1 ]; ++y )
+        {
+            for( std::size_t x = 0; x < dims[ 0 ]; ++x, ++index )
+            {
+                if( WROIArbitrary::isInside( vals[ index ], threshold ) )
+                {
+                    m_blocks[ x / BLOCK_SIZE + m_nbBlocks[ 0 ] * ( y / BLOCK_SIZE + m_nbBlocks[ 1 ] * ( z / BLOCK_SIZE ) ) ] = true;
+                    m_min[ 0 ] = std::min( m_min[ 0 ], x );
+                    m_min[ 1 ] = std::min( m_min[ 1 ], y );
+                    m_min[ 2 ] = std::min( m_min[ 2 ], z );
+                    m_max[ 0 ] = std::max( m_max[ 0 ], x );
+                    m_max[ 1 ] = std::max( m_max[ 1 ], y );
+                    m_max[ 2 ] = std::max( m_max[ 2 ], z );
+                }
+            }
+        }
+    }
+
+    // the table has an additional leading zero layer in each direction
+    m_blockCounts.resize( ( m_nbBlocks[ 0 ] + 1 ) * ( m_nbBlocks[ 1 ] + 1 ) * ( m_nbBlocks[ 2 ] + 1 ), 0 );
+    std::size_t block = 0;
+    for( std::size_t z = 1; z <= m_nbBlocks[ 2 ]; ++z )
+    {
+        for( std::size_t y = 1; y <= m_nbBlocks[ 1 ]; ++y )
+        {
+            for( std::size_t x = 1; x <= m_nbBlocks[ 0 ]; ++x, ++block )
+            {
+                m_blockCounts[ tableIndex( x, y, z ) ] = ( m_blocks[ block ] ? 1 : 0 )
+                    + m_blockCounts[ tableIndex( x - 1, y, z ) ] + m_blockCounts[ tableIndex( x, y - 1, z ) ]
+                    + m_blockCounts[ tableIndex( x, y, z - 1 ) ] - m_blockCounts[ tableIndex( x - 1, y - 1, z ) ]
+                    - m_blockCounts[ tableIndex( x - 1, y, z - 1 ) ] - m_blockCounts[ tableIndex( x, y - 1, z - 1 ) ]
+                    + m_blockCounts[ tableIndex( x - 1, y - 1, z - 1 ) ];
+            }
+        }
+    }
+}
+
 void WROIArbitrary::updateGFX()
 {
     if( m_dirty->get() )
@@ -25,6 +25,7 @@
 #ifndef WROIARBITRARY_H
 #define WROIARBITRARY_H
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -48,6 +49,106 @@ class WDataSetScalar;
 class WROIArbitrary : public WROI
 {
 public:
+    /**
+     * Coarse description of the voxels inside the ROI. The grid is divided into blocks of BLOCK_SIZE^3 voxels and a bit marks the
+     * blocks containing at least one voxel inside the ROI. A summed-volume table over these bits answers whether any block of a range
+     * is occupied in constant time, which allows skipping whole parts of a kd-tree at once.
+     */
+    class Occupancy
+    {
+    public:
+        /**
+         * Edge length of a block in voxels.
+         */
+        static constexpr std::size_t BLOCK_SIZE = 8;
+
+        /**
+         * Computes the occupancy of the given values.
+         *
+         * \param dims the number of voxels in X, Y and Z direction
+         * \param vals the values at the voxels
+         * \param threshold the threshold, see WROIArbitrary::isInside()
+         */
+        Occupancy( std::vector< size_t > const& dims, std::vector< float > const& vals, float threshold );
+
+        /**
+         * The threshold this occupancy was computed for.
+         *
+         * \return the threshold
+         */
+        float getThreshold() const;
+
+        /**
+         * Whether no voxel is inside the ROI.
+         *
+         * \return true if the ROI is empty
+         */
+        bool isEmpty() const;
+
+        /**
+         * The first voxel of the bounding box of all voxels inside the ROI.
+         *
+         * \param axis the axis
+         *
+         * \return the lower voxel coordinate along the axis
+         */
+        std::size_t getMin( std::size_t axis ) const;
+
+        /**
+         * The last voxel of the bounding box of all voxels inside the ROI.
+         *
+         * \param axis the axis
+         *
+         * \return the upper voxel coordinate along the axis, inclusive
+         */
+        std::size_t getMax( std::size_t axis ) const;
+
+        /**
+         * Whether the block containing a voxel has any voxel inside the ROI. The voxel must be part of the grid.
+         *
+         * \param x the voxel in X direction
+         * \param y the voxel in Y direction
+         * \param z the voxel in Z direction
+         *
+         * \return true if the block is occupied
+         */
+        bool isOccupied( std::size_t x, std::size_t y, std::size_t z ) const;
+
+        /**
+         * Whether any block touching a range of voxels is occupied. The range is inclusive and must be part of the grid.
+         *
+         * \param min the first voxel of the range
+         * \param max the last voxel of the range
+         *
+         * \return true if at least one block in the range is occupied
+         */
+        bool isOccupied( std::size_t const min[ 3 ], std::size_t const max[ 3 ] ) const;
+
+    private:
+        /**
+         * The index of a block in the summed-volume table.
+         *
+         * \param x block in X direction
+         * \param y block in Y direction
+         * \param z block in Z direction
+         *
+         * \return the index
+         */
+        std::size_t tableIndex( std::size_t x, std::size_t y, std::size_t z ) const;
+
+        float m_threshold; //!< the threshold the occupancy was computed for
+
+        std::size_t m_nbBlocks[ 3 ]; //!< number of blocks in X, Y and Z direction
+
+        std::vector< bool > m_blocks; //!< one bit per block, set if the block has a voxel inside the ROI
+
+        std::vector< std::size_t > m_blockCounts; //!< number of occupied blocks before each block in all three directions
+
+        std::size_t m_min[ 3 ]; //!< first voxel of the bounding box
+
+        std::size_t m_max[ 3 ]; //!< last voxel of the bounding box
+    };
+
     /**
      * constructor
      * \param nbCoordsX number of vertices in X direction
@@ -135,6 +236,30 @@ public:
      */
     float getValue( size_t i );
 
+    /**
+     * Get the data defining the ROI.
+     *
+     * \return The values at the vertices.
+     */
+    std::vector< float > const& getValues() const;
+
+    /**
+     * Whether a value is inside the ROI.
+     *
+     * \param value the value at a vertex
+     * \param threshold the threshold of the ROI
+     *
+     * \return true if the vertex is inside the ROI
+     */
+    static bool isInside( float value, float threshold );
+
+    /**
+     * Get the occupancy of the ROI for the current threshold. It is computed once per threshold and shared by all callers.
+     *
+     * \return The occupancy.
+     */
+    std::shared_ptr< const Occupancy > getOccupancy();
+
     /**
      *  updates the graphics
      */
@@ -157,6 +282,10 @@ private:
      */
     WColor m_color;
 
+    std::shared_ptr< const Occupancy > m_occupancy; //!< the occupancy for the last requested threshold
+
+    boost::mutex m_occupancyMutex; //!< protects m_occupancy
+
     /**
      * Node callback to handle updates properly
      */
@@ -181,4 +310,60 @@ private:
     };
 };
 
+inline std::vector< float > const& WROIArbitrary::getValues() const
+{
+    return m_vals;
+}
+
+inline bool WROIArbitrary::isInside( float value, float threshold )
+{
+    return value - threshold > 0.1;
+}
+
+inline float WROIArbitrary::Occupancy::getThreshold() const
+{
+    return m_threshold;
+}
+
+inline bool WROIArbitrary::Occupancy::isEmpty() const
+{
+    return m_min[ 0 ] > m_max[ 0 ];
+}
+
+inline std::size_t WROIArbitrary::Occupancy::getMin( std::size_t axis ) const
+{
+    return m_min[ axis ];
+}
+
+inline std::size_t WROIArbitrary::Occupancy::getMax( std::size_t axis ) const
+{
+    return m_max[ axis ];
+}
+
+inline std::size_t WROIArbitrary::Occupancy::tableIndex( std::size_t x, std::size_t y, std::size_t z ) const
+{
+    return x + ( m_nbBlocks[ 0 ] + 1 ) * ( y + ( m_nbBlocks[ 1 ] + 1 ) * z );
+}
+
+inline bool WROIArbitrary::Occupancy::isOccupied( std::size_t x, std::size_t y, std::size_t z ) const
+{
+    return m_blocks[ x / BLOCK_SIZE + m_nbBlocks[ 0 ] * ( y / BLOCK_SIZE + m_nbBlocks[ 1 ] * ( z / BLOCK_SIZE ) ) ];
+}
+
+inline bool WROIArbitrary::Occupancy::isOccupied( std::size_t const min[ 3 ], std::size_t const max[ 3 ] ) const
+{
+    std::size_t const x0 = min[ 0 ] / BLOCK_SIZE;
+    std::size_t const y0 = min[ 1 ] / BLOCK_SIZE;
+    std::size_t const z0 = min[ 2 ] / BLOCK_SIZE;
+    std::size_t const x1 = max[ 0 ] / BLOCK_SIZE + 1;
+    std::size_t const y1 = max[ 1 ] / BLOCK_SIZE + 1;
+    std::size_t const z1 = max[ 2 ] / BLOCK_SIZE + 1;
+
+    // inclusion-exclusion, the unsigned wrap-around of the intermediate results cancels out
+    return m_blockCounts[ tableIndex( x1, y1, z1 ) ] - m_blockCounts[ tableIndex( x0, y1, z1 ) ]
+         - m_blockCounts[ tableIndex( x1, y0, z1 ) ] - m_blockCounts[ tableIndex( x1, y1, z0 ) ]
+         + m_blockCounts[ tableIndex( x0, y0, z1 ) ] + m_blockCounts[ tableIndex( x0, y1, z0 ) ]
+         + m_blockCounts[ tableIndex( x1, y0, z0 ) ] - m_blockCounts[ tableIndex( x0, y0, z0 ) ] > 0;
+}
+
 #endif  // WROIARBITRARY_H
@@ -0,0 +1,246 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WGEFRAMEWRITER_TEST_H
+#define WGEFRAMEWRITER_TEST_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/WLogger.h"
+#include "../WGEFrameWriter.h"
+
+/**
+ * A frame writer remembering the written files instead of writing them. Writing can be blocked to fill the queue.
+ */
+class WRecordingFrameWriter : public WGEFrameWriter
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param threads number of encoder threads
+     * \param queueSize the maximum number of queued frames
+     * \param policy what to do if the queue is full
+     */
+    WRecordingFrameWriter( std::size_t threads, std::size_t queueSize, QueuePolicy policy )
+        : WGEFrameWriter( threads, queueSize, policy ),
+          m_blocked( false ),
+          m_entered( 0 )
+    {
+    }
+
+    /**
+     * Block or unblock writing.
+     *
+     * \param blocked true to block
+     */
+    void setBlocked( bool blocked )
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_blocked = blocked;
+        m_condition.notify_all();
+    }
+
+    /**
+     * Wait until the given number of frames started writing.
+     *
+     * \param count the number of frames
+     */
+    void waitEntered( std::size_t count )
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        while( m_entered < count )
+        {
+            m_condition.wait( lock );
+        }
+    }
+
+    /**
+     * The files written so far.
+     *
+     * \return the file names
+     */
+    std::vector< std::string > getFiles()
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        return m_files;
+    }
+
+protected:
+    virtual bool writeImage( osg::Image const& /* image */, std::string const& filename ) const
+    {
+        std::unique_lock< std::mutex > lock( m_mutex );
+        ++m_entered;
+        m_condition.notify_all();
+        while( m_blocked )
+        {
+            m_condition.wait( lock );
+        }
+        m_files.push_back( filename );
+        return true;
+    }
+
+private:
+    mutable std::mutex m_mutex; //!< protects the members below
+    mutable std::condition_variable m_condition; //!< signals changes of m_blocked and m_entered
+    bool m_blocked; //!< whether writeImage blocks
+    mutable std::size_t m_entered; //!< the number of writeImage calls
+    mutable std::vector< std::string > m_files; //!< the written files
+};
+
+/**
+ * Tests for WGEFrameWriter.
+ */
+class WGEFrameWriterTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger and other stuff for each test.
+     */
+    void setUp()
+    {
+        WLogger::startup();
+    }
+
+    /**
+     * All pushed frames get written to their files.
+     */
+    void testImageFiles( void )
+    {
+        WRecordingFrameWriter writer( 3, 4, WGEFrameWriter::BLOCK );
+        for( std::size_t i = 0; i < 50; ++i )
+        {
+            TS_ASSERT( writer.push( createFrame( 4, 2, i ), "frame" + std::to_string( i ) + ".png" ) );
+        }
+        writer.wait();
+
+        TS_ASSERT_EQUALS( writer.getWrittenFrames(), 50 );
+        TS_ASSERT_EQUALS( writer.getDroppedFrames(), 0 );
+        std::vector< std::string > files = writer.getFiles();
+        TS_ASSERT_EQUALS( files.size(), 50 );
+        for( std::size_t i = 0; i < 50; ++i )
+        {
+            TS_ASSERT_EQUALS( std::count( files.begin(), files.end(), "frame" + std::to_string( i ) + ".png" ), 1 );
+        }
+    }
+
+    /**
+     * A full queue drops the newest or oldest frame.
+     */
+    void testDropPolicies( void )
+    {
+        WRecordingFrameWriter writer( 1, 2, WGEFrameWriter::DROP_NEWEST );
+        writer.setBlocked( true );
+
+        // the only encoder takes the first frame and blocks, the next two fill the queue
+        TS_ASSERT( writer.push( createFrame( 4, 2, 0 ), "0" ) );
+        writer.waitEntered( 1 );
+        TS_ASSERT( writer.push( createFrame( 4, 2, 1 ), "1" ) );
+        TS_ASSERT( writer.push( createFrame( 4, 2, 2 ), "2" ) );
+
+        TS_ASSERT( !writer.push( createFrame( 4, 2, 3 ), "3" ) );
+        writer.setQueuePolicy( WGEFrameWriter::DROP_OLDEST );
+        TS_ASSERT( !writer.push( createFrame( 4, 2, 4 ), "4" ) );
+
+        writer.setBlocked( false );
+        writer.wait();
+
+        std::vector< std::string > files = writer.getFiles();
+        TS_ASSERT_EQUALS( files.size(), 3 );
+        TS_ASSERT_EQUALS( files[ 0 ], "0" );
+        TS_ASSERT_EQUALS( files[ 1 ], "2" );
+        TS_ASSERT_EQUALS( files[ 2 ], "4" );
+        TS_ASSERT_EQUALS( writer.getWrittenFrames(), 3 );
+        TS_ASSERT_EQUALS( writer.getDroppedFrames(), 2 );
+    }
+
+    /**
+     * Raw frames are appended in order and without row padding, even with several encoder threads.
+     */
+    void testRawFile( void )
+    {
+        boost::filesystem::path const fname = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        {
+            WRecordingFrameWriter writer( 4, 8, WGEFrameWriter::BLOCK );
+            TS_ASSERT( writer.setRawFile( fname.string() ) );
+            for( std::size_t i = 0; i < 40; ++i )
+            {
+                writer.push( createFrame( 5, 3, i ), "ignored.png" );
+            }
+            // different size, gets dropped
+            writer.push( createFrame( 6, 3, 40 ), "ignored.png" );
+            TS_ASSERT( writer.setRawFile( "" ) );
+
+            TS_ASSERT_EQUALS( writer.getWrittenFrames(), 40 );
+            TS_ASSERT_EQUALS( writer.getDroppedFrames(), 1 );
+            TS_ASSERT( writer.getFiles().empty() );
+
+            // back to image files
+            writer.push( createFrame( 5, 3, 0 ), "image.png" );
+            writer.wait();
+            TS_ASSERT_EQUALS( writer.getFiles().size(), 1 );
+        }
+
+        std::ifstream in( fname.string().c_str(), std::ios_base::in | std::ios_base::binary );
+        std::vector< char > data( ( std::istreambuf_iterator< char >( in ) ), std::istreambuf_iterator< char >() );
+        in.close();
+        boost::filesystem::remove( fname );
+
+        TS_ASSERT_EQUALS( data.size(), 40 * 5 * 3 * 3 );
+        for( std::size_t i = 0; i < data.size(); ++i )
+        {
+            TS_ASSERT_EQUALS( static_cast< unsigned char >( data[ i ] ), i / ( 5 * 3 * 3 ) );
+        }
+    }
+
+private:
+    /**
+     * Creates an RGB frame with all components set to the frame number.
+     *
+     * \param width the width
+     * \param height the height
+     * \param frame the frame number
+     *
+     * \return the image
+     */
+    osg::ref_ptr< osg::Image > createFrame( int width, int height, std::size_t frame )
+    {
+        osg::ref_ptr< osg::Image > image = new osg::Image();
+        image->allocateImage( width, height, 1, GL_RGB, GL_UNSIGNED_BYTE );
+        std::memset( image->data(), static_cast< int >( frame ), image->getTotalSizeInBytes() );
+        return image;
+    }
+};
+
+#endif  // WGEFRAMEWRITER_TEST_H
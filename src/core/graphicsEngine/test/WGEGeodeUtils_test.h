@@ -0,0 +1,210 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WGEGEODEUTILS_TEST_H
+#define WGEGEODEUTILS_TEST_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/datastructures/WColoredVertices.h"
+#include "../WGEGeodeUtils.h"
+#include "../WTriangleMesh.h"
+
+/**
+ * Tests the mesh conversions of WGEGeodeUtils.
+ */
+class WGEGeodeUtilsTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * The smooth shaded geometry shares the mesh arrays and reuses its index array.
+     */
+    void testConvertToOsgGeometry( void )
+    {
+        WTriangleMesh::SPtr mesh = createGrid( 100 );
+        osg::ref_ptr< osg::Geometry > geometry = wge::convertToOsgGeometry( mesh, WColor( 1.0, 0.0, 0.0, 1.0 ), true, false, true );
+        TS_ASSERT_EQUALS( geometry->getVertexArray(), mesh->getVertexArray().get() );
+        TS_ASSERT_EQUALS( geometry->getColorArray(), mesh->getVertexColorArray().get() );
+        TS_ASSERT_EQUALS( geometry->getNormalArray(), mesh->getVertexNormalArray().get() );
+        osg::DrawElementsUInt* elements = getElements( geometry, osg::PrimitiveSet::TRIANGLES );
+        TS_ASSERT_EQUALS( elements->size(), mesh->getTriangles().size() );
+        for( std::size_t i = 0; i < elements->size(); ++i )
+        {
+            TS_ASSERT_EQUALS( ( *elements )[ i ], mesh->getTriangles()[ i ] );
+        }
+
+        // deforming the mesh keeps the topology
+        unsigned int const modified = elements->getModifiedCount();
+        mesh->setVertex( 0, osg::Vec3( -1.0, -1.0, 0.0 ) );
+        TS_ASSERT_EQUALS( wge::convertToOsgGeometry( mesh, WColor( 1.0, 0.0, 0.0, 1.0 ), true, false, true, geometry ), geometry );
+        TS_ASSERT_EQUALS( getElements( geometry, osg::PrimitiveSet::TRIANGLES ), elements );
+        TS_ASSERT_EQUALS( elements->getModifiedCount(), modified );
+
+        // switch to a default color
+        wge::convertToOsgGeometry( mesh, WColor( 1.0, 0.0, 0.0, 1.0 ), true, false, false, geometry );
+        osg::Vec4Array* colors = dynamic_cast< osg::Vec4Array* >( geometry->getColorArray() );
+        TS_ASSERT( colors );
+        TS_ASSERT_EQUALS( colors->size(), 1 );
+        TS_ASSERT_EQUALS( ( *colors )[ 0 ], WColor( 1.0, 0.0, 0.0, 1.0 ) );
+        TS_ASSERT_EQUALS( ( *mesh->getVertexColorArray() )[ 0 ], WColor( 0.0, 0.0, 0.0, 1.0 ) );
+    }
+
+    /**
+     * The flat shaded geometry has a vertex per triangle corner. Re-coloring only touches the color array.
+     */
+    void testConvertToOsgGeometryFlatShaded( void )
+    {
+        WTriangleMesh::SPtr mesh = createGrid( 100 );
+        osg::ref_ptr< osg::Geometry > geometry = wge::convertToOsgGeometryFlatShaded( mesh, WColor( 1.0, 1.0, 1.0, 1.0 ), true, false, true );
+        std::vector< size_t > const& tris = mesh->getTriangles();
+        osg::Vec3Array* verts = dynamic_cast< osg::Vec3Array* >( geometry->getVertexArray() );
+        osg::Vec4Array* colors = dynamic_cast< osg::Vec4Array* >( geometry->getColorArray() );
+        osg::Vec3Array* normals = dynamic_cast< osg::Vec3Array* >( geometry->getNormalArray() );
+        TS_ASSERT( verts && colors && normals );
+        TS_ASSERT_EQUALS( verts->size(), tris.size() );
+        TS_ASSERT_EQUALS( colors->size(), tris.size() );
+        TS_ASSERT_EQUALS( normals->size(), tris.size() );
+        osg::DrawElementsUInt* elements = getElements( geometry, osg::PrimitiveSet::TRIANGLES );
+        for( std::size_t i = 0; i < tris.size(); ++i )
+        {
+            TS_ASSERT_EQUALS( ( *verts )[ i ], mesh->getVertex( tris[ i ] ) );
+            TS_ASSERT_EQUALS( ( *colors )[ i ], ( *mesh->getVertexColorArray() )[ tris[ i ] ] );
+            TS_ASSERT_EQUALS( ( *normals )[ i ], ( *mesh->getTriangleNormalArray() )[ i / 3 ] );
+            TS_ASSERT_EQUALS( ( *elements )[ i ], i );
+        }
+
+        unsigned int const vertsModified = verts->getModifiedCount();
+        unsigned int const colorsModified = colors->getModifiedCount();
+        mesh->setVertexColor( tris[ 5 ], WColor( 0.0, 0.0, 1.0, 1.0 ) );
+        wge::convertToOsgGeometryFlatShaded( mesh, WColor( 1.0, 1.0, 1.0, 1.0 ), true, false, true, geometry );
+        TS_ASSERT_EQUALS( geometry->getVertexArray(), verts );
+        TS_ASSERT_EQUALS( geometry->getColorArray(), colors );
+        TS_ASSERT_EQUALS( verts->getModifiedCount(), vertsModified );
+        TS_ASSERT_EQUALS( colors->getModifiedCount(), colorsModified + 1 );
+        TS_ASSERT_EQUALS( ( *colors )[ 5 ], WColor( 0.0, 0.0, 1.0, 1.0 ) );
+    }
+
+    /**
+     * Each triangle gives its three edges.
+     */
+    void testConvertToOsgGeometryLines( void )
+    {
+        WTriangleMesh::SPtr mesh = createGrid( 100 );
+        osg::ref_ptr< osg::Geometry > geometry = wge::convertToOsgGeometryLines( mesh, WColor( 1.0, 1.0, 1.0, 1.0 ), false );
+        std::vector< size_t > const& tris = mesh->getTriangles();
+        osg::DrawElementsUInt* elements = getElements( geometry, osg::PrimitiveSet::LINES );
+        TS_ASSERT_EQUALS( elements->size(), tris.size() * 2 );
+        for( std::size_t t = 0; t < tris.size() / 3; ++t )
+        {
+            for( std::size_t e = 0; e < 3; ++e )
+            {
+                TS_ASSERT_EQUALS( ( *elements )[ t * 6 + e * 2 ], tris[ t * 3 + e ] );
+                TS_ASSERT_EQUALS( ( *elements )[ t * 6 + e * 2 + 1 ], tris[ t * 3 + ( e + 1 ) % 3 ] );
+            }
+        }
+    }
+
+    /**
+     * Vertices missing in the color map get the default color.
+     */
+    void testConvertToOsgGeometryColorMap( void )
+    {
+        WTriangleMesh::SPtr mesh = createGrid( 10 );
+        WColoredVertices colorMap;
+        std::map< size_t, WColor > data;
+        data[ 3 ] = WColor( 0.0, 1.0, 0.0, 1.0 );
+        data[ 1000 ] = WColor( 0.0, 1.0, 0.0, 1.0 );
+        colorMap.setData( data );
+
+        osg::ref_ptr< osg::Geometry > geometry = wge::convertToOsgGeometry( mesh, colorMap, WColor( 1.0, 1.0, 1.0, 1.0 ) );
+        osg::Vec4Array* colors = dynamic_cast< osg::Vec4Array* >( geometry->getColorArray() );
+        TS_ASSERT( colors );
+        TS_ASSERT_DIFFERS( colors, mesh->getVertexColorArray().get() );
+        TS_ASSERT_EQUALS( colors->size(), mesh->vertSize() );
+        for( std::size_t i = 0; i < colors->size(); ++i )
+        {
+            TS_ASSERT_EQUALS( ( *colors )[ i ], i == 3 ? WColor( 0.0, 1.0, 0.0, 1.0 ) : WColor( 1.0, 1.0, 1.0, 1.0 ) );
+        }
+
+        // an unchanged color map does not touch the colors
+        unsigned int const modified = colors->getModifiedCount();
+        wge::convertToOsgGeometry( mesh, colorMap, WColor( 1.0, 1.0, 1.0, 1.0 ), false, false, geometry );
+        TS_ASSERT_EQUALS( geometry->getColorArray(), colors );
+        TS_ASSERT_EQUALS( colors->getModifiedCount(), modified );
+    }
+
+private:
+    /**
+     * Creates a planar grid of vertices with two triangles per cell. The vertex colors encode the vertex position.
+     *
+     * \param n the number of vertices per side
+     *
+     * \return the mesh
+     */
+    WTriangleMesh::SPtr createGrid( std::size_t n )
+    {
+        WTriangleMesh::SPtr mesh( new WTriangleMesh( n * n, 2 * ( n - 1 ) * ( n - 1 ) ) );
+        for( std::size_t y = 0; y < n; ++y )
+        {
+            for( std::size_t x = 0; x < n; ++x )
+            {
+                mesh->addVertex( osg::Vec3( x, y, 0.0 ) );
+                mesh->setVertexColor( y * n + x, WColor( x / static_cast< float >( n ), y / static_cast< float >( n ), 0.0, 1.0 ) );
+            }
+        }
+        for( std::size_t y = 0; y + 1 < n; ++y )
+        {
+            for( std::size_t x = 0; x + 1 < n; ++x )
+            {
+                mesh->addTriangle( y * n + x, y * n + x + 1, ( y + 1 ) * n + x );
+                mesh->addTriangle( y * n + x + 1, ( y + 1 ) * n + x + 1, ( y + 1 ) * n + x );
+            }
+        }
+        return mesh;
+    }
+
+    /**
+     * The only primitive set of a geometry.
+     *
+     * \param geometry the geometry
+     * \param mode the expected mode
+     *
+     * \return the primitive set, NULL if it is missing or not of the expected mode
+     */
+    osg::DrawElementsUInt* getElements( osg::ref_ptr< osg::Geometry > geometry, GLenum mode )
+    {
+        TS_ASSERT_EQUALS( geometry->getNumPrimitiveSets(), 1 );
+        osg::DrawElementsUInt* elements = dynamic_cast< osg::DrawElementsUInt* >( geometry->getPrimitiveSet( 0 ) );
+        TS_ASSERT( elements );
+        TS_ASSERT_EQUALS( elements->getMode(), mode );
+        return elements;
+    }
+};
+
+#endif  // WGEGEODEUTILS_TEST_H
@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WROIARBITRARY_TEST_H
+#define WROIARBITRARY_TEST_H
+
+#include <cstddef>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "../WROIArbitrary.h"
+
+/**
+ * Tests the occupancy of WROIArbitrary.
+ */
+class WROIArbitraryTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * The bounding box and the blocks cover the voxels above the threshold.
+     */
+    void testOccupancy( void )
+    {
+        std::vector< size_t > dims( 3 );
+        dims[ 0 ] = 20;
+        dims[ 1 ] = 10;
+        dims[ 2 ] = 9;
+        std::vector< float > vals( 20 * 10 * 9, 0.0f );
+        vals[ index( dims, 3, 2, 1 ) ] = 1.0f;
+        vals[ index( dims, 17, 9, 8 ) ] = 1.0f;
+        vals[ index( dims, 10, 5, 4 ) ] = 0.5f;
+
+        WROIArbitrary::Occupancy occupancy( dims, vals, 0.01f );
+        TS_ASSERT( !occupancy.isEmpty() );
+        TS_ASSERT_EQUALS( occupancy.getThreshold(), 0.01f );
+        TS_ASSERT_EQUALS( occupancy.getMin( 0 ), 3 );
+        TS_ASSERT_EQUALS( occupancy.getMin( 1 ), 2 );
+        TS_ASSERT_EQUALS( occupancy.getMin( 2 ), 1 );
+        TS_ASSERT_EQUALS( occupancy.getMax( 0 ), 17 );
+        TS_ASSERT_EQUALS( occupancy.getMax( 1 ), 9 );
+        TS_ASSERT_EQUALS( occupancy.getMax( 2 ), 8 );
+
+        // blocks
+        TS_ASSERT( occupancy.isOccupied( 0, 0, 0 ) );
+        TS_ASSERT( occupancy.isOccupied( 7, 7, 7 ) );
+        TS_ASSERT( occupancy.isOccupied( 8, 0, 0 ) );
+        TS_ASSERT( occupancy.isOccupied( 16, 8, 8 ) );
+        TS_ASSERT( !occupancy.isOccupied( 16, 0, 0 ) );
+        TS_ASSERT( !occupancy.isOccupied( 0, 8, 8 ) );
+
+        // ranges
+        std::size_t min[ 3 ] = { 16, 0, 0 }; // NOLINT curly braces
+        std::size_t max[ 3 ] = { 19, 7, 7 }; // NOLINT curly braces
+        TS_ASSERT( !occupancy.isOccupied( min, max ) );
+        max[ 1 ] = 8;
+        TS_ASSERT( !occupancy.isOccupied( min, max ) );
+        max[ 2 ] = 8;
+        TS_ASSERT( occupancy.isOccupied( min, max ) );
+        min[ 0 ] = 0;
+        min[ 1 ] = 8;
+        min[ 2 ] = 0;
+        max[ 0 ] = 15;
+        TS_ASSERT( !occupancy.isOccupied( min, max ) );
+    }
+
+    /**
+     * A threshold above all values gives an empty occupancy.
+     */
+    void testEmptyOccupancy( void )
+    {
+        std::vector< size_t > dims( 3, 9 );
+        std::vector< float > vals( 9 * 9 * 9, 1.0f );
+
+        WROIArbitrary::Occupancy occupancy( dims, vals, 0.95f );
+        TS_ASSERT( occupancy.isEmpty() );
+        std::size_t const min[ 3 ] = { 0, 0, 0 }; // NOLINT curly braces
+        std::size_t const max[ 3 ] = { 8, 8, 8 }; // NOLINT curly braces
+        TS_ASSERT( !occupancy.isOccupied( min, max ) );
+        TS_ASSERT( !WROIArbitrary::Occupancy( dims, vals, 0.8f ).isEmpty() );
+    }
+
+private:
+    /**
+     * The index of a voxel.
+     *
+     * \param dims the number of voxels in each direction
+     * \param x the voxel in X direction
+     * \param y the voxel in Y direction
+     * \param z the voxel in Z direction
+     *
+     * \return the index
+     */
+    std::size_t index( std::vector< size_t > const& dims, std::size_t x, std::size_t y, std::size_t z )
+    {
+        return x + dims[ 0 ] * ( y + dims[ 1 ] * z );
+    }
+};
+
+#endif  // WROIARBITRARY_TEST_H
@@ -56,7 +56,7 @@ WKdTree::WKdTree( int size, float *pointArray ) :
     int rootLeft = ( root - 1 ) / 2;
     if( m_size > 2 )
     {
-        std::nth_element( m_tree.begin(), m_tree.begin() + rootLeft, m_tree.begin() + root - 1, lessy( m_pointArray, 1 ) );
+        std::nth_element( m_tree.begin(), m_tree.begin() + rootLeft, m_tree.begin() + root, lessy( m_pointArray, 1 ) );
     }
 
     int rootRight = ( m_size + root ) / 2;
@@ -105,7 +105,7 @@ void WKdTree::buildTree( int left, int right, int axis )
         return;
 
     int div = ( left + right ) / 2;
-    std::nth_element( m_tree.begin() + left, m_tree.begin() + div, m_tree.begin() + right, lessy( m_pointArray, axis ) );
+    std::nth_element( m_tree.begin() + left, m_tree.begin() + div, m_tree.begin() + right + 1, lessy( m_pointArray, axis ) );
 
     buildTree( left, div - 1, ( axis + 1 ) % 3 );
     buildTree( div + 1, right, ( axis + 1 ) % 3 );
@@ -128,7 +128,7 @@ void WKdTreeThread::buildTree( int left, int right, int axis )
         return;
 
     int div = ( left + right ) / 2;
-    std::nth_element( m_tree->begin() + left, m_tree->begin() + div, m_tree->begin() + right, lessy( m_pointArray, axis ) );
+    std::nth_element( m_tree->begin() + left, m_tree->begin() + div, m_tree->begin() + right + 1, lessy( m_pointArray, axis ) );
 
     buildTree( left, div - 1, ( axis + 1 ) % 3 );
     buildTree( div + 1, right, ( axis + 1 ) % 3 );
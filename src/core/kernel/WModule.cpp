@@ -23,6 +23,7 @@
 //---------------------------------------------------------------------------
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -40,6 +41,7 @@
 #include "../common/WPathHelper.h"
 #include "../common/WPredicateHelper.h"
 #include "../common/WProgressCombiner.h"
+#include "../common/WTracer.h"
 #include "../common/exceptions/WNameNotUnique.h"
 #include "../common/exceptions/WSignalSubscriptionFailed.h"
 #include "../common/exceptions/WSignalUnknown.h"
@@ -70,6 +72,7 @@ WModule::WModule():
     m_restoreMode( false ),
     m_readyProgress( std::shared_ptr< WProgress >( new WProgress( "Initializing Module" ) ) ),
     m_moduleState(),
+    m_recomputeScheduler(),
     m_localPath( WPathHelper::getSharePath() )
 {
     // initialize members
@@ -98,6 +101,7 @@ WModule::WModule():
 
     // our internal state consist out of two conditions: data changed and the exit flag from WThreadedRunner.
     m_moduleState.add( m_shutdownFlag.getCondition() );
+    m_moduleState.add( m_recomputeScheduler.getCondition() );
 }
 
 WModule::~WModule()
@@ -523,8 +527,15 @@ const WRequirement* WModule::checkRequirements() const
     return NULL;
 }
 
+namespace
+{
+    //! the number of modules inside moduleMain, shown as counter in traces
+    std::atomic< int > runningModules( 0 );
+}
+
 void WModule::threadMain()
 {
+    WTRACE_SCOPE_DYNAMIC( "Module " + getName() );
     WLogger::getLogger()->addLogMessage( "Starting module main method.", "Module (" + getName() + ")", LL_INFO );
 
     // check requirements
@@ -536,7 +547,17 @@ void WModule::threadMain()
 
     // call main thread function
     m_isRunning( true );
-    moduleMain();
+    WTracer::counter( "Running modules", ++runningModules );
+    try
+    {
+        moduleMain();
+    }
+    catch( ... )
+    {
+        WTracer::counter( "Running modules", --runningModules );
+        throw;
+    }
+    WTracer::counter( "Running modules", --runningModules );
 
     // NOTE: if there is any exception in the module thread, WThreadedRunner calls onThreadException for us. We can then disconnect the
     // module and call our own error notification mechanism.
@@ -547,6 +568,11 @@ void WModule::threadMain()
     m_isRunning( false );
 }
 
+void WModule::notifyStop()
+{
+    m_recomputeScheduler.stop();
+}
+
 void WModule::onThreadException( const WException& e )
 {
     // use our own error callback which includes the exact module pointer which caused the problem
@@ -41,6 +41,7 @@
 #include "../common/WProgressCombiner.h"
 #include "../common/WProperties.h"
 #include "../common/WPrototyped.h"
+#include "../common/WRecomputeScheduler.h"
 #include "../common/WRequirement.h"
 #include "../common/WThreadedRunner.h"
 #include "../dataHandler/WDataSet.h"
@@ -445,6 +446,12 @@ protected:
      */
     virtual void onThreadException( const WException& e );
 
+    /**
+     * Stops m_recomputeScheduler, so a computation started with one of its tokens ends before the module thread is joined.
+     * If you overwrite this method, call WModule::notifyStop.
+     */
+    virtual void notifyStop();
+
      /**
       * Sets the container this module is associated with.
       *
@@ -702,6 +709,12 @@ protected:
      */
     WConditionSet m_moduleState;
 
+    /**
+     * Coalesces requests to recompute the output of the module and cancels outdated computations. Its condition is part of
+     * m_moduleState. Modules doing expensive computations pass it to their properties and inputs, see WRecomputeScheduler.
+     */
+    WRecomputeScheduler m_recomputeScheduler;
+
     /**
      * The container this module belongs to.
      */
@@ -54,6 +54,7 @@ WModuleContainer::WModuleContainer( std::string name, std::string description ):
 {
     WLogger::getLogger()->addLogMessage( "Constructing module container." , "ModuleContainer (" + getName() + ")", LL_DEBUG );
     // initialize members
+    m_modules.enableSnapshots();
 }
 
 WModuleContainer::~WModuleContainer()
@@ -247,11 +248,11 @@ WModuleContainer::DataModuleListType WModuleContainer::getDataModules()
 {
     DataModuleListType l;
 
-    // lock, unlocked if l looses focus
-    ModuleSharedContainerType::ReadTicket lock = m_modules.getReadTicket();
+    // snapshot, released if it looses focus
+    ModuleSharedContainerType::Snapshot modules = m_modules.getSnapshot();
 
     // iterate module list
-    for( ModuleConstIterator iter = lock->get().begin(); iter != lock->get().end(); ++iter )
+    for( ModuleConstIterator iter = modules->begin(); iter != modules->end(); ++iter )
     {
         // is this module a data module?
         if( ( *iter )->getType() == MODULE_DATA )
@@ -521,16 +522,21 @@ WModuleContainer::ModuleSharedContainerType::ReadTicket WModuleContainer::getMod
     return m_modules.getReadTicket();
 }
 
+WModuleContainer::ModuleSharedContainerType::Snapshot WModuleContainer::getModuleSnapshot() const
+{
+    return m_modules.getSnapshot();
+}
+
 WModuleContainer::ModuleVectorType WModuleContainer::getModules( std::string name ) const
 {
     // get the list of all first.
-    WModuleContainer::ModuleSharedContainerType::ReadTicket lock = getModules();
+    WModuleContainer::ModuleSharedContainerType::Snapshot modules = getModuleSnapshot();
 
     // put results in here
     WModuleContainer::ModuleVectorType result;
 
     // handle each module
-    for( ModuleConstIterator listIter = lock->get().begin(); listIter != lock->get().end(); ++listIter )
+    for( ModuleConstIterator listIter = modules->begin(); listIter != modules->end(); ++listIter )
     {
         // check name
         if( name == ( *listIter )->getName() )
@@ -552,11 +558,11 @@ WCombinerTypes::WCompatiblesList WModuleContainer::getPossibleConnections( std::
         return complist;
     }
 
-    // read lock the container
-    ModuleSharedContainerType::ReadTicket lock = m_modules.getReadTicket();
+    // snapshot of the container
+    ModuleSharedContainerType::Snapshot modules = m_modules.getSnapshot();
 
     // handle each module
-    for( ModuleConstIterator listIter = lock->get().begin(); listIter != lock->get().end(); ++listIter )
+    for( ModuleConstIterator listIter = modules->begin(); listIter != modules->end(); ++listIter )
     {
         WCombinerTypes::WOneToOneCombiners lComp = WApplyCombiner::createCombinerList< WApplyCombiner>( module, ( *listIter ) );
 
@@ -282,6 +282,14 @@ public:
      */
     ModuleSharedContainerType::ReadTicket getModules() const;
 
+    /**
+     * Returns a snapshot of the list of modules inside the container. In contrast to \ref getModules, it neither locks nor allocates. Modules
+     * added or removed meanwhile are not visible in the snapshot.
+     *
+     * \return the snapshot.
+     */
+    ModuleSharedContainerType::Snapshot getModuleSnapshot() const;
+
     /**
      * Queries the container to find all modules with a given name. This can be useful to check for existence of certain modules inside the
      * container.
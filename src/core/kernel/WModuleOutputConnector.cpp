@@ -29,6 +29,7 @@
 #include <boost/signals2/signal.hpp>
 
 #include "../common/WCondition.h"
+#include "../common/WTracer.h"
 #include "WModuleConnectorSignals.h"
 #include "WModuleInputConnector.h"
 #include "WModuleOutputConnector.h"
@@ -80,6 +81,7 @@ boost::signals2::connection WModuleOutputConnector::subscribeSignal( MODULE_CONN
 
 void WModuleOutputConnector::propagateDataChange()
 {
+    WTRACE_SCOPE_DYNAMIC( "Propagate " + getCanonicalName() );
     signal_DataChanged( std::shared_ptr<WModuleConnector>(), shared_from_this() );
     m_dataChangedCondition->notify();
 }
@@ -34,6 +34,8 @@
 #include "../common/WTransferable.h"
 #include "WModuleInputData.h"
 #include "WModuleOutputConnector.h"
+#include "WResultCache.h"
+#include "WResultKey.h"
 
 /**
  * Class offering an instantiate-able data connection between modules.
@@ -124,11 +126,52 @@ public:
     virtual void updateData( std::shared_ptr< T > data )
     {
         m_data = data;
+        m_key.reset();
 
         // broadcast this event
         triggerUpdate();
     };
 
+    /**
+     * Update the data associated and store it in the result cache. Use this for data which is a deterministic function of everything
+     * added to the key, see \ref updateDataFromCache().
+     *
+     * \param data the data do send
+     * \param key identifies the data
+     */
+    void updateData( std::shared_ptr< T > data, WResultKey const& key )
+    {
+        WResultCache::getResultCache()->put( key, data );
+        updateData( data );
+        m_key.reset( new WResultKey( key ) );
+    }
+
+    /**
+     * Sends the data cached for the given key, if any. Nothing is sent if this output already holds the data for this key, so the
+     * connected modules do not recompute anything either. Compute and send the data using \ref updateData( data, key ) if this
+     * returns false.
+     *
+     * \param key identifies the data, built from everything the data depends on
+     *
+     * \return true if the data was found in the cache.
+     */
+    bool updateDataFromCache( WResultKey const& key )
+    {
+        if( m_key && *m_key == key && m_data )
+        {
+            return true;
+        }
+
+        std::shared_ptr< T > data = WResultCache::getResultCache()->get< T >( key );
+        if( !data )
+        {
+            return false;
+        }
+        updateData( data );
+        m_key.reset( new WResultKey( key ) );
+        return true;
+    }
+
     /**
      * Resets the data on this output. It actually sets NULL and triggers an update.
      */
@@ -197,6 +240,11 @@ protected:
      * \note If you modify this or its contents, consider triggering an update. See \ref updateData() for details.
      */
     std::shared_ptr< T > m_data;
+
+    /**
+     * The key of the data, if it was sent with one. See \ref updateDataFromCache().
+     */
+    std::shared_ptr< WResultKey > m_key;
 private:
 };
 
@@ -0,0 +1,492 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/WLogger.h"
+#include "../dataHandler/WDataSetScalar.h"
+#include "../dataHandler/WGridRegular3D.h"
+#include "../graphicsEngine/WTriangleMesh.h"
+#include "WResultCache.h"
+
+WResultCache::SPtr WResultCache::m_instance = WResultCache::SPtr();
+
+namespace
+{
+    /**
+     * Writes the raw values of a value set.
+     */
+    struct ValueSetWriter : public boost::static_visitor< void >
+    {
+        /**
+         * Constructor.
+         *
+         * \param out the stream to write to
+         */
+        explicit ValueSetWriter( std::ostream& out )
+            : m_out( out )
+        {
+        }
+
+        /**
+         * Write the values.
+         *
+         * \param valueSet the value set
+         */
+        template< typename T >
+        void operator()( WValueSet< T > const* valueSet ) const
+        {
+            uint64_t const size = valueSet->rawSize();
+            m_out.write( reinterpret_cast< char const* >( &size ), sizeof( size ) );
+            m_out.write( reinterpret_cast< char const* >( valueSet->rawData() ), size * sizeof( T ) );
+        }
+
+        //! the stream
+        std::ostream& m_out;
+    };
+
+    /**
+     * Computes the size of the raw values of a value set.
+     */
+    struct ValueSetBytes : public boost::static_visitor< std::size_t >
+    {
+        /**
+         * The size of the values.
+         *
+         * \param valueSet the value set
+         *
+         * \return the size in bytes
+         */
+        template< typename T >
+        std::size_t operator()( WValueSet< T > const* valueSet ) const
+        {
+            return valueSet->rawSize() * sizeof( T );
+        }
+    };
+
+    /**
+     * Reads values written by ValueSetWriter.
+     *
+     * \param in the stream
+     * \param order the order of the values
+     * \param dimension the dimension of the values
+     * \param type the data type
+     *
+     * \return the value set, NULL on errors.
+     */
+    template< typename T >
+    std::shared_ptr< WValueSetBase > readValueSet( std::istream& in, std::size_t order, std::size_t dimension, dataType type )
+    {
+        uint64_t size = 0;
+        in.read( reinterpret_cast< char* >( &size ), sizeof( size ) );
+        std::shared_ptr< std::vector< T > > data( new std::vector< T >( in ? size : 0 ) );
+        in.read( reinterpret_cast< char* >( data->data() ), data->size() * sizeof( T ) );
+        if( !in )
+        {
+            return std::shared_ptr< WValueSetBase >();
+        }
+        return std::shared_ptr< WValueSetBase >( new WValueSet< T >( order, dimension, data, type ) );
+    }
+
+    /**
+     * Writes a scalar dataset on a regular grid.
+     *
+     * \param result the dataset
+     * \param out the stream
+     */
+    void writeScalar( WTransferable const& result, std::ostream& out )
+    {
+        WDataSetScalar const& dataSet = dynamic_cast< WDataSetScalar const& >( result );
+        std::shared_ptr< WGridRegular3D > grid = std::dynamic_pointer_cast< WGridRegular3D >( dataSet.getGrid() );
+        if( !grid )
+        {
+            throw WException( std::string( "Only scalar datasets on regular grids can be stored." ) );
+        }
+
+        std::shared_ptr< WValueSetBase > values = dataSet.getValueSet();
+        uint64_t const header[] = { values->getDataType(), values->order(), values->dimension(), // NOLINT curly braces
+                                    grid->getNbCoordsX(), grid->getNbCoordsY(), grid->getNbCoordsZ() };
+        out.write( reinterpret_cast< char const* >( header ), sizeof( header ) );
+
+        WMatrix< double > const matrix = grid->getTransformationMatrix();
+        for( std::size_t i = 0; i < 4; ++i )
+        {
+            for( std::size_t j = 0; j < 4; ++j )
+            {
+                double const v = matrix( i, j );
+                out.write( reinterpret_cast< char const* >( &v ), sizeof( v ) );
+            }
+        }
+        values->applyFunction( ValueSetWriter( out ) );
+    }
+
+    /**
+     * Reads a dataset written by writeScalar.
+     *
+     * \param in the stream
+     *
+     * \return the dataset, NULL on errors.
+     */
+    std::shared_ptr< WTransferable > readScalar( std::istream& in )
+    {
+        uint64_t header[ 6 ];
+        in.read( reinterpret_cast< char* >( header ), sizeof( header ) );
+        WMatrix< double > matrix( 4, 4 );
+        for( std::size_t i = 0; i < 4; ++i )
+        {
+            for( std::size_t j = 0; j < 4; ++j )
+            {
+                in.read( reinterpret_cast< char* >( &matrix( i, j ) ), sizeof( double ) );
+            }
+        }
+        if( !in )
+        {
+            return std::shared_ptr< WTransferable >();
+        }
+
+        dataType const type = static_cast< dataType >( header[ 0 ] );
+        std::shared_ptr< WValueSetBase > values;
+        switch( type )
+        {
+            case W_DT_UNSIGNED_CHAR:
+                values = readValueSet< uint8_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_INT8:
+                values = readValueSet< int8_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_SIGNED_SHORT:
+                values = readValueSet< int16_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_UINT16:
+                values = readValueSet< uint16_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_SIGNED_INT:
+                values = readValueSet< int32_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_UINT32:
+                values = readValueSet< uint32_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_INT64:
+                values = readValueSet< int64_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_UINT64:
+                values = readValueSet< uint64_t >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_FLOAT:
+                values = readValueSet< float >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_DOUBLE:
+                values = readValueSet< double >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            case W_DT_FLOAT128:
+                values = readValueSet< long double >( in, header[ 1 ], header[ 2 ], type );
+                break;
+            default:
+                break;
+        }
+        if( !values )
+        {
+            return std::shared_ptr< WTransferable >();
+        }
+
+        std::shared_ptr< WGrid > grid( new WGridRegular3D( header[ 3 ], header[ 4 ], header[ 5 ], WGridTransformOrtho( matrix ) ) );
+        return std::shared_ptr< WTransferable >( new WDataSetScalar( values, grid ) );
+    }
+
+    //! identifies the files of the cache
+    std::string const fileMagic = "OpenWalnut result cache 2";
+}  // namespace
+
+WResultCache::WResultCache( std::size_t maxEntries, std::size_t maxBytes )
+    : m_maxEntries( maxEntries ),
+      m_maxBytes( maxBytes ),
+      m_bytes( 0 ),
+      m_hits( 0 ),
+      m_misses( 0 )
+{
+    registerSerializer( WDataSetScalar().getName(), &writeScalar, &readScalar );
+}
+
+WResultCache::~WResultCache()
+{
+}
+
+WResultCache::SPtr WResultCache::getResultCache()
+{
+    static std::mutex instanceLock;
+    std::lock_guard< std::mutex > lock( instanceLock );
+    if( !m_instance )
+    {
+        m_instance = SPtr( new WResultCache() );
+        if( getenv( "OW_RESULT_CACHE" ) )
+        {
+            m_instance->setDirectory( getenv( "OW_RESULT_CACHE" ) );
+        }
+        if( getenv( "OW_RESULT_CACHE_SIZE" ) )
+        {
+            char* end = NULL;
+            uint64_t const megabytes = std::strtoull( getenv( "OW_RESULT_CACHE_SIZE" ), &end, 10 );
+            if( end && *end == '\0' && end != getenv( "OW_RESULT_CACHE_SIZE" ) )
+            {
+                m_instance->setMaxBytes( static_cast< std::size_t >( megabytes ) << 20 );
+            }
+            else
+            {
+                wlog::warn( "WResultCache" ) << "OW_RESULT_CACHE_SIZE is not a number of MiB, using the default size.";
+            }
+        }
+    }
+    return m_instance;
+}
+
+std::shared_ptr< WTransferable > WResultCache::get( WResultKey const& key )
+{
+    std::unique_lock< std::mutex > lock( m_mutex );
+    std::map< uint64_t, EntryList::iterator >::iterator it = m_index.find( key.getDigest() );
+    // the digest only finds the entry, the key decides
+    if( it != m_index.end() && it->second->m_key == key )
+    {
+        // most recently used
+        m_entries.splice( m_entries.begin(), m_entries, it->second );
+        ++m_hits;
+        return m_entries.front().m_result;
+    }
+
+    boost::filesystem::path const file = getFile( key );
+    std::map< std::string, std::pair< WriteFunction, ReadFunction > > const serializers = m_serializers;
+    lock.unlock();
+
+    // reading might take a while, do not block the other modules
+    std::shared_ptr< WTransferable > result;
+    if( !file.empty() && boost::filesystem::exists( file ) )
+    {
+        try
+        {
+            std::ifstream in( file.string().c_str(), std::ios::in | std::ios::binary );
+            std::string magic;
+            std::string name;
+            std::getline( in, magic );
+
+            // files of other keys with the same digest are ignored
+            std::string const& material = key.getMaterial();
+            uint64_t size = 0;
+            in.read( reinterpret_cast< char* >( &size ), sizeof( size ) );
+            std::string stored( size == material.size() ? size : 0, '\0' );
+            in.read( &stored[ 0 ], stored.size() );
+            std::getline( in, name );
+            if( in && magic == fileMagic && stored == material && serializers.count( name ) )
+            {
+                result = serializers.find( name )->second.second( in );
+            }
+        }
+        catch( std::exception const& e )
+        {
+            wlog::warn( "WResultCache" ) << "Could not read " << file.string() << ": " << e.what();
+        }
+    }
+
+    lock.lock();
+    if( result )
+    {
+        ++m_hits;
+        insert( key, result );
+    }
+    else
+    {
+        ++m_misses;
+    }
+    return result;
+}
+
+void WResultCache::put( WResultKey const& key, std::shared_ptr< WTransferable > result )
+{
+    if( !result )
+    {
+        return;
+    }
+
+    std::unique_lock< std::mutex > lock( m_mutex );
+    insert( key, result );
+
+    boost::filesystem::path const file = getFile( key );
+    std::map< std::string, std::pair< WriteFunction, ReadFunction > >::const_iterator serializer = m_serializers.find( result->getName() );
+    if( file.empty() || serializer == m_serializers.end() || boost::filesystem::exists( file ) )
+    {
+        return;
+    }
+    WriteFunction const write = serializer->second.first;
+    lock.unlock();
+
+    // write to a temporary file first, so other processes never read a partial result
+    boost::filesystem::path const temporary = file.string() + "." + boost::filesystem::unique_path().string();
+    try
+    {
+        {
+            std::ofstream out( temporary.string().c_str(), std::ios::out | std::ios::binary );
+            uint64_t const size = key.getMaterial().size();
+            out << fileMagic << "\n";
+            out.write( reinterpret_cast< char const* >( &size ), sizeof( size ) );
+            out << key.getMaterial() << result->getName() << "\n";
+            write( *result, out );
+            if( !out )
+            {
+                throw WException( std::string( "Write failed." ) );
+            }
+        }
+        boost::filesystem::rename( temporary, file );
+    }
+    catch( std::exception const& e )
+    {
+        wlog::warn( "WResultCache" ) << "Could not write " << file.string() << ": " << e.what();
+        boost::system::error_code ignored;
+        boost::filesystem::remove( temporary, ignored );
+    }
+}
+
+void WResultCache::clear()
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+std::size_t WResultCache::size() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_entries.size();
+}
+
+void WResultCache::setMaxEntries( std::size_t maxEntries )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_maxEntries = maxEntries;
+    evict();
+}
+
+std::size_t WResultCache::getBytes() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_bytes;
+}
+
+void WResultCache::setMaxBytes( std::size_t maxBytes )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_maxBytes = maxBytes;
+    evict();
+}
+
+void WResultCache::setDirectory( boost::filesystem::path const& directory )
+{
+    if( !directory.empty() )
+    {
+        boost::system::error_code error;
+        boost::filesystem::create_directories( directory, error );
+        if( error )
+        {
+            wlog::warn( "WResultCache" ) << "Could not create " << directory.string() << ", keeping results in memory only.";
+            return;
+        }
+    }
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_directory = directory;
+}
+
+void WResultCache::registerSerializer( std::string const& name, WriteFunction write, ReadFunction read )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_serializers[ name ] = std::make_pair( write, read );
+}
+
+std::size_t WResultCache::getHits() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_hits;
+}
+
+std::size_t WResultCache::getMisses() const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_misses;
+}
+
+void WResultCache::insert( WResultKey const& key, std::shared_ptr< WTransferable > result )
+{
+    std::map< uint64_t, EntryList::iterator >::iterator it = m_index.find( key.getDigest() );
+    if( it != m_index.end() )
+    {
+        m_bytes -= it->second->m_bytes;
+        m_entries.erase( it->second );
+    }
+    Entry const entry = { key, result, estimateBytes( *result ) }; // NOLINT curly braces
+    m_entries.push_front( entry );
+    m_index[ key.getDigest() ] = m_entries.begin();
+    m_bytes += entry.m_bytes;
+    evict();
+}
+
+void WResultCache::evict()
+{
+    while( !m_entries.empty() && ( m_entries.size() > m_maxEntries || m_bytes > m_maxBytes ) )
+    {
+        m_bytes -= m_entries.back().m_bytes;
+        m_index.erase( m_entries.back().m_key.getDigest() );
+        m_entries.pop_back();
+    }
+}
+
+std::size_t WResultCache::estimateBytes( WTransferable const& result )
+{
+    WDataSetSingle const* dataSet = dynamic_cast< WDataSetSingle const* >( &result );
+    if( dataSet && dataSet->getValueSet() )
+    {
+        return dataSet->getValueSet()->applyFunction( ValueSetBytes() );
+    }
+
+    // positions, texture coordinates, normals and colors of the vertices, indexes, normals and colors of the triangles
+    WTriangleMesh const* mesh = dynamic_cast< WTriangleMesh const* >( &result );
+    if( mesh )
+    {
+        return mesh->vertSize() * ( 3 * sizeof( osg::Vec3 ) + sizeof( osg::Vec4 ) )
+               + mesh->triangleSize() * ( 3 * sizeof( std::size_t ) + sizeof( osg::Vec3 ) + sizeof( osg::Vec4 ) );
+    }
+    return 0;
+}
+
+boost::filesystem::path WResultCache::getFile( WResultKey const& key ) const
+{
+    if( m_directory.empty() )
+    {
+        return boost::filesystem::path();
+    }
+    return m_directory / ( key.toString() + ".owresult" );
+}
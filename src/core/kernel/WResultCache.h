@@ -0,0 +1,270 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WRESULTCACHE_H
+#define WRESULTCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+#include <boost/function.hpp>
+
+#include "../common/WTransferable.h"
+#include "WResultKey.h"
+
+/**
+ * Remembers the results of deterministic computations, so toggling a property back to a previous value or loading the same
+ * project again does not recompute them. Results are looked up by a WResultKey built from everything the computation depends on.
+ *
+ * The most recently used results are kept in memory, limited by their number and by their estimated size. Optionally, results
+ * are also written to a directory and read back from there, even by other processes. This only works for result types with a
+ * registered serializer, WDataSetScalar on regular grids is supported out of the box. The directory of the global cache can be
+ * set with the OW_RESULT_CACHE environment variable, its size limit in MiB with OW_RESULT_CACHE_SIZE.
+ *
+ * Modules usually use the cache via WModuleOutputData::updateDataFromCache. All functions are thread-safe.
+ */
+class WResultCache // NOLINT
+{
+public:
+    /**
+     * Shared pointer abbreviation.
+     */
+    typedef std::shared_ptr< WResultCache > SPtr;
+
+    /**
+     * Writes a result to a stream.
+     */
+    typedef boost::function< void ( WTransferable const&, std::ostream& ) > WriteFunction;
+
+    /**
+     * Reads a result from a stream. Returns NULL or throws if the stream is invalid.
+     */
+    typedef boost::function< std::shared_ptr< WTransferable > ( std::istream& ) > ReadFunction;
+
+    /**
+     * Creates an empty cache without directory.
+     *
+     * \param maxEntries the number of results kept in memory
+     * \param maxBytes the estimated size of the results kept in memory
+     */
+    explicit WResultCache( std::size_t maxEntries = 16, std::size_t maxBytes = std::size_t( 1 ) << 30 );
+
+    /**
+     * Destructor.
+     */
+    ~WResultCache();
+
+    /**
+     * The cache used by the modules.
+     *
+     * \return the instance
+     */
+    static SPtr getResultCache();
+
+    /**
+     * Look up a result, in memory first, then in the directory.
+     *
+     * \param key the key
+     *
+     * \return the result, NULL if not cached.
+     */
+    std::shared_ptr< WTransferable > get( WResultKey const& key );
+
+    /**
+     * Look up a result of a given type.
+     *
+     * \param key the key
+     *
+     * \return the result, NULL if not cached or of another type.
+     */
+    template< typename T >
+    std::shared_ptr< T > get( WResultKey const& key );
+
+    /**
+     * Store a result in memory and, if it can be serialized, in the directory.
+     *
+     * \param key the key
+     * \param result the result, must not be changed afterwards.
+     */
+    void put( WResultKey const& key, std::shared_ptr< WTransferable > result );
+
+    /**
+     * Remove all results from memory. The directory is not touched.
+     */
+    void clear();
+
+    /**
+     * The number of results in memory.
+     *
+     * \return the number of results
+     */
+    std::size_t size() const;
+
+    /**
+     * Set the number of results kept in memory. Removes the least recently used ones if needed.
+     *
+     * \param maxEntries the number of results
+     */
+    void setMaxEntries( std::size_t maxEntries );
+
+    /**
+     * The estimated size of the results in memory. Value sets and triangle meshes are counted, other results are not.
+     *
+     * \return the size in bytes
+     */
+    std::size_t getBytes() const;
+
+    /**
+     * Set the estimated size of the results kept in memory. Removes the least recently used ones if needed, a single result larger
+     * than this is not kept in memory at all.
+     *
+     * \param maxBytes the size in bytes
+     */
+    void setMaxBytes( std::size_t maxBytes );
+
+    /**
+     * Set the directory to store results in. It gets created if needed.
+     *
+     * \param directory the directory, empty to keep results in memory only.
+     */
+    void setDirectory( boost::filesystem::path const& directory );
+
+    /**
+     * Allows storing results of the given type in the directory.
+     *
+     * \param name the name of the type as returned by WPrototyped::getName()
+     * \param write writes a result of this type
+     * \param read reads a result of this type
+     */
+    void registerSerializer( std::string const& name, WriteFunction write, ReadFunction read );
+
+    /**
+     * The number of successful lookups.
+     *
+     * \return the number of hits
+     */
+    std::size_t getHits() const;
+
+    /**
+     * The number of failed lookups.
+     *
+     * \return the number of misses
+     */
+    std::size_t getMisses() const;
+
+private:
+    /**
+     * Inserts a result in memory as most recently used one. Replaces the result of a key with the same digest. Expects m_mutex
+     * to be locked.
+     *
+     * \param key the key
+     * \param result the result
+     */
+    void insert( WResultKey const& key, std::shared_ptr< WTransferable > result );
+
+    /**
+     * Removes the least recently used results until the limits are met. Expects m_mutex to be locked.
+     */
+    void evict();
+
+    /**
+     * Estimates the memory used by a result.
+     *
+     * \param result the result
+     *
+     * \return the size in bytes, zero for unknown types
+     */
+    static std::size_t estimateBytes( WTransferable const& result );
+
+    /**
+     * The file storing the result with the given key.
+     *
+     * \param key the key
+     *
+     * \return the path
+     */
+    boost::filesystem::path getFile( WResultKey const& key ) const;
+
+    /**
+     * A result in memory.
+     */
+    struct Entry
+    {
+        WResultKey m_key; //!< the key
+        std::shared_ptr< WTransferable > m_result; //!< the result
+        std::size_t m_bytes; //!< the estimated size of the result
+    };
+
+    //! the list of results with their keys, the most recently used first
+    typedef std::list< Entry > EntryList;
+
+    //! protects all members
+    mutable std::mutex m_mutex;
+
+    //! the results in memory
+    EntryList m_entries;
+
+    //! finds the results in m_entries by the digest of their key
+    std::map< uint64_t, EntryList::iterator > m_index;
+
+    //! the number of results kept in memory
+    std::size_t m_maxEntries;
+
+    //! the estimated size of the results kept in memory
+    std::size_t m_maxBytes;
+
+    //! the estimated size of the results in memory
+    std::size_t m_bytes;
+
+    //! the directory, empty if not used
+    boost::filesystem::path m_directory;
+
+    //! the serializers by type name
+    std::map< std::string, std::pair< WriteFunction, ReadFunction > > m_serializers;
+
+    //! number of hits
+    std::size_t m_hits;
+
+    //! number of misses
+    std::size_t m_misses;
+
+    //! the global instance
+    static SPtr m_instance;
+};
+
+template< typename T >
+std::shared_ptr< T > WResultCache::get( WResultKey const& key )
+{
+    return std::dynamic_pointer_cast< T >( get( key ) );
+}
+
+#endif  // WRESULTCACHE_H
@@ -0,0 +1,355 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "../common/WPropertyTypes.h"
+#include "../common/WPropertyVariable.h"
+#include "../dataHandler/WDataSetFibers.h"
+#include "../dataHandler/WDataSetSingle.h"
+#include "../dataHandler/WGridRegular3D.h"
+#include "WResultKey.h"
+
+namespace
+{
+    //! FNV-1a offset basis
+    uint64_t const fnvOffset = 14695981039346656037ULL;
+
+    //! FNV-1a prime
+    uint64_t const fnvPrime = 1099511628211ULL;
+
+    /**
+     * Hash some bytes. Works on whole words where possible, which is a lot faster than the byte wise FNV-1a for large datasets.
+     *
+     * \param hash the hash so far
+     * \param data the bytes
+     * \param size the number of bytes
+     *
+     * \return the new hash
+     */
+    uint64_t hashBytes( uint64_t hash, void const* data, std::size_t size )
+    {
+        unsigned char const* bytes = static_cast< unsigned char const* >( data );
+        std::size_t const words = size / sizeof( uint64_t );
+        for( std::size_t i = 0; i < words; ++i )
+        {
+            uint64_t word;
+            std::memcpy( &word, bytes + i * sizeof( uint64_t ), sizeof( uint64_t ) );
+            hash = ( hash ^ word ) * fnvPrime;
+            hash ^= hash >> 29;
+        }
+        for( std::size_t i = words * sizeof( uint64_t ); i < size; ++i )
+        {
+            hash = ( hash ^ bytes[ i ] ) * fnvPrime;
+        }
+        // the length separates "ab" + "c" from "a" + "bc"
+        return ( hash ^ size ) * fnvPrime;
+    }
+
+    //! seed of mixBytes
+    uint64_t const mixSeed = 0x9e3779b97f4a7c15ULL;
+
+    /**
+     * Rotate the bits of a word left.
+     *
+     * \param word the word
+     * \param bits the number of bits, 1 to 63
+     *
+     * \return the rotated word
+     */
+    inline uint64_t rotateLeft( uint64_t word, int bits )
+    {
+        return ( word << bits ) | ( word >> ( 64 - bits ) );
+    }
+
+    /**
+     * Hash some bytes with a function independent of hashBytes, following the 64 bit MurmurHash3 mixing. Together both give a
+     * 128 bit hash of dataset contents.
+     *
+     * \param hash the hash so far
+     * \param data the bytes
+     * \param size the number of bytes
+     *
+     * \return the new hash
+     */
+    uint64_t mixBytes( uint64_t hash, void const* data, std::size_t size )
+    {
+        unsigned char const* bytes = static_cast< unsigned char const* >( data );
+        for( std::size_t i = 0; i < size; i += sizeof( uint64_t ) )
+        {
+            // the last word is padded with zeros
+            uint64_t word = 0;
+            std::memcpy( &word, bytes + i, std::min( sizeof( uint64_t ), size - i ) );
+            hash ^= rotateLeft( word * 0x87c37b91114253d5ULL, 31 ) * 0x4cf5ad432745937fULL;
+            hash = rotateLeft( hash, 27 ) * 5 + 0x52dce729;
+        }
+        hash ^= size;
+        hash = ( hash ^ ( hash >> 33 ) ) * 0xff51afd7ed558ccdULL;
+        hash = ( hash ^ ( hash >> 33 ) ) * 0xc4ceb9fe1a85ec53ULL;
+        return hash ^ ( hash >> 33 );
+    }
+
+    /**
+     * Hash some bytes with both hash functions.
+     *
+     * \param hash the hashes so far
+     * \param data the bytes
+     * \param size the number of bytes
+     *
+     * \return the new hashes
+     */
+    WResultKey::ContentHash hashBoth( WResultKey::ContentHash const& hash, void const* data, std::size_t size )
+    {
+        return WResultKey::ContentHash( hashBytes( hash.first, data, size ), mixBytes( hash.second, data, size ) );
+    }
+
+    /**
+     * Hashes the raw values of a value set.
+     */
+    struct ValueSetHasher : public boost::static_visitor< WResultKey::ContentHash >
+    {
+        /**
+         * Hash the values.
+         *
+         * \param valueSet the value set
+         *
+         * \return the hash
+         */
+        template< typename T >
+        WResultKey::ContentHash operator()( WValueSet< T > const* valueSet ) const
+        {
+            return hashBoth( WResultKey::ContentHash( fnvOffset, mixSeed ), valueSet->rawData(), valueSet->rawSize() * sizeof( T ) );
+        }
+    };
+
+    /**
+     * Computes the content hash of a dataset.
+     *
+     * \param dataSet the dataset
+     * \param[out] hash the hash
+     *
+     * \return false if the content of datasets of this type can not be hashed.
+     */
+    bool hashContent( WDataSet const& dataSet, WResultKey::ContentHash* hash )
+    {
+        WResultKey::ContentHash h( fnvOffset, mixSeed );
+        std::string const type = dataSet.getName();
+        h = hashBoth( h, type.data(), type.size() );
+
+        WDataSetSingle const* single = dynamic_cast< WDataSetSingle const* >( &dataSet );
+        if( single && single->getValueSet() )
+        {
+            std::shared_ptr< WGridRegular3D > grid = std::dynamic_pointer_cast< WGridRegular3D >( single->getGrid() );
+            if( !grid )
+            {
+                return false;
+            }
+            std::shared_ptr< WValueSetBase > values = single->getValueSet();
+            uint64_t const layout[] = { values->getDataType(), values->order(), values->dimension(), // NOLINT curly braces
+                                        grid->getNbCoordsX(), grid->getNbCoordsY(), grid->getNbCoordsZ() };
+            h = hashBoth( h, layout, sizeof( layout ) );
+
+            WMatrix< double > const matrix = grid->getTransformationMatrix();
+            for( std::size_t i = 0; i < 4; ++i )
+            {
+                for( std::size_t j = 0; j < 4; ++j )
+                {
+                    double const v = matrix( i, j );
+                    h = hashBoth( h, &v, sizeof( v ) );
+                }
+            }
+
+            WResultKey::ContentHash const valueHash = values->applyFunction( ValueSetHasher() );
+            h = hashBoth( h, &valueHash.first, sizeof( valueHash.first ) );
+            *hash = hashBoth( h, &valueHash.second, sizeof( valueHash.second ) );
+            return true;
+        }
+
+        WDataSetFibers const* fibers = dynamic_cast< WDataSetFibers const* >( &dataSet );
+        if( fibers && fibers->getVertices() )
+        {
+            h = hashBoth( h, fibers->getVertices()->data(), fibers->getVertices()->size() * sizeof( float ) );
+            h = hashBoth( h, fibers->getLineStartIndexes()->data(), fibers->getLineStartIndexes()->size() * sizeof( size_t ) );
+            *hash = hashBoth( h, fibers->getLineLengths()->data(), fibers->getLineLengths()->size() * sizeof( size_t ) );
+            return true;
+        }
+        return false;
+    }
+}  // namespace
+
+WResultKey::WResultKey( std::string const& scope )
+    : m_digest( fnvOffset )
+{
+    add( scope );
+}
+
+WResultKey& WResultKey::add( void const* data, std::size_t size )
+{
+    m_digest = hashBytes( m_digest, data, size );
+    uint64_t const length = size;
+    m_material.append( reinterpret_cast< char const* >( &length ), sizeof( length ) );
+    m_material.append( static_cast< char const* >( data ), size );
+    return *this;
+}
+
+WResultKey& WResultKey::add( std::string const& value )
+{
+    return add( value.data(), value.size() );
+}
+
+WResultKey& WResultKey::add( std::shared_ptr< WPropertyBase > property )
+{
+    add( property->getName() );
+
+    // the string representation rounds floating point values
+    switch( property->getType() )
+    {
+        case PV_INT:
+            return add( property->toPropInt()->get() );
+        case PV_DOUBLE:
+            return add( property->toPropDouble()->get() );
+        case PV_BOOL:
+            return add( property->toPropBool()->get() );
+        case PV_POSITION:
+        {
+            WPosition const position = property->toPropPosition()->get();
+            return add( position[ 0 ] ).add( position[ 1 ] ).add( position[ 2 ] );
+        }
+        case PV_COLOR:
+        {
+            WColor const color = property->toPropColor()->get();
+            return add( color[ 0 ] ).add( color[ 1 ] ).add( color[ 2 ] ).add( color[ 3 ] );
+        }
+        case PV_MATRIX4X4:
+        {
+            WMatrix4d const matrix = property->toPropMatrix4X4()->get();
+            for( std::size_t i = 0; i < 4; ++i )
+            {
+                for( std::size_t j = 0; j < 4; ++j )
+                {
+                    add( matrix( i, j ) );
+                }
+            }
+            return *this;
+        }
+        case PV_INTERVAL:
+        {
+            WIntervalDouble const interval = property->toPropInterval()->get();
+            return add( interval.getLower() ).add( interval.getUpper() );
+        }
+        default:
+            return add( property->getAsString() );
+    }
+}
+
+WResultKey& WResultKey::add( std::shared_ptr< WDataSet const > dataSet )
+{
+    ContentHash const hash = hashDataSet( dataSet );
+    return add( hash.first ).add( hash.second );
+}
+
+uint64_t WResultKey::getDigest() const
+{
+    return m_digest;
+}
+
+std::string const& WResultKey::getMaterial() const
+{
+    return m_material;
+}
+
+std::string WResultKey::toString() const
+{
+    std::ostringstream s;
+    s << std::hex << std::setw( 16 ) << std::setfill( '0' ) << m_digest;
+    return s.str();
+}
+
+bool WResultKey::operator==( WResultKey const& other ) const
+{
+    return m_digest == other.m_digest && m_material == other.m_material;
+}
+
+bool WResultKey::operator!=( WResultKey const& other ) const
+{
+    return !( *this == other );
+}
+
+WResultKey::ContentHash WResultKey::hashDataSet( std::shared_ptr< WDataSet const > dataSet )
+{
+    if( !dataSet )
+    {
+        return ContentHash( 0, 0 );
+    }
+
+    typedef std::map< WDataSet const*, std::pair< std::weak_ptr< WDataSet const >, ContentHash > > HashMap;
+    static std::mutex hashesLock;
+    static HashMap hashes;
+    static uint64_t instanceCounter = 0;
+
+    {
+        std::lock_guard< std::mutex > lock( hashesLock );
+        HashMap::iterator it = hashes.find( dataSet.get() );
+        // the address might belong to a deleted dataset
+        if( it != hashes.end() && it->second.first.lock() == dataSet )
+        {
+            return it->second.second;
+        }
+    }
+
+    // hash outside the lock, this might take a while for large datasets
+    ContentHash hash;
+    bool const content = hashContent( *dataSet, &hash );
+
+    std::lock_guard< std::mutex > lock( hashesLock );
+    if( !content )
+    {
+        // unique per instance
+        ++instanceCounter;
+        hash = hashBoth( ContentHash( fnvPrime, mixSeed ), &instanceCounter, sizeof( instanceCounter ) );
+    }
+
+    // forget the deleted datasets
+    for( HashMap::iterator it = hashes.begin(); it != hashes.end(); )
+    {
+        if( it->second.first.expired() )
+        {
+            hashes.erase( it++ );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    hashes[ dataSet.get() ] = std::make_pair( std::weak_ptr< WDataSet const >( dataSet ), hash );
+    return hash;
+}
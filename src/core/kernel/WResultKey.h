@@ -0,0 +1,179 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WRESULTKEY_H
+#define WRESULTKEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "../common/WPropertyBase.h"
+#include "../dataHandler/WDataSet.h"
+
+/**
+ * Identifies the result of a deterministic computation by everything it depends on: the input datasets, the property
+ * values and any other parameter. The key keeps all values added, so two keys are equal exactly if they were built from the
+ * same values in the same order. The digest is a hash of these values used to look up results in the WResultCache.
+ *
+ * Datasets are hashed by content, i.e. the values, the grid or the fiber geometry, so a dataset loaded twice from the same
+ * file yields the same key. They contribute two independent 64 bit hashes of their content to the key. Datasets of other types
+ * are identified by their instance only. The content hash of a dataset is computed once and remembered as long as the dataset
+ * exists.
+ *
+ * \code
+ * WResultKey key( getName() );
+ * key.add( m_dataSet ).add( m_isoValueProp );
+ * \endcode
+ */
+class WResultKey // NOLINT
+{
+public:
+    /**
+     * The content hash of a dataset, two independent hashes.
+     */
+    typedef std::pair< uint64_t, uint64_t > ContentHash;
+
+    /**
+     * Creates a key.
+     *
+     * \param scope the name of the computation, usually the name of the module and the output. This separates the results of
+     * different computations on the same inputs.
+     */
+    explicit WResultKey( std::string const& scope );
+
+    /**
+     * Add raw bytes to the key.
+     *
+     * \param data the bytes
+     * \param size the number of bytes
+     *
+     * \return this key
+     */
+    WResultKey& add( void const* data, std::size_t size );
+
+    /**
+     * Add a string to the key.
+     *
+     * \param value the string
+     *
+     * \return this key
+     */
+    WResultKey& add( std::string const& value );
+
+    /**
+     * Add a number to the key.
+     *
+     * \param value the number
+     *
+     * \return this key
+     */
+    template< typename T >
+    typename std::enable_if< std::is_arithmetic< T >::value, WResultKey& >::type add( T value );
+
+    /**
+     * Add the current value of a property to the key. Numbers, positions, colors, matrices and intervals are added with their
+     * exact binary value, other properties by their string representation.
+     *
+     * \param property the property
+     *
+     * \return this key
+     */
+    WResultKey& add( std::shared_ptr< WPropertyBase > property );
+
+    /**
+     * Add a dataset to the key. NULL is allowed and differs from any dataset.
+     *
+     * \param dataSet the dataset
+     *
+     * \return this key
+     */
+    WResultKey& add( std::shared_ptr< WDataSet const > dataSet );
+
+    /**
+     * The hash of everything added.
+     *
+     * \return the digest
+     */
+    uint64_t getDigest() const;
+
+    /**
+     * All values added so far, including their sizes. Keys are compared by this.
+     *
+     * \return the values
+     */
+    std::string const& getMaterial() const;
+
+    /**
+     * The digest as fixed length hex string, usable as file name.
+     *
+     * \return the string
+     */
+    std::string toString() const;
+
+    /**
+     * Compare two keys.
+     *
+     * \param other the other key
+     *
+     * \return true if both were built from the same values.
+     */
+    bool operator==( WResultKey const& other ) const;
+
+    /**
+     * Compare two keys.
+     *
+     * \param other the other key
+     *
+     * \return true if the keys differ.
+     */
+    bool operator!=( WResultKey const& other ) const;
+
+    /**
+     * The content hash of a dataset, see the class description.
+     *
+     * \param dataSet the dataset
+     *
+     * \return the hash
+     */
+    static ContentHash hashDataSet( std::shared_ptr< WDataSet const > dataSet );
+
+private:
+    //! everything added so far, each value preceded by its size
+    std::string m_material;
+
+    //! the hash of everything added so far
+    uint64_t m_digest;
+};
+
+template< typename T >
+typename std::enable_if< std::is_arithmetic< T >::value, WResultKey& >::type WResultKey::add( T value )
+{
+    return add( &value, sizeof( T ) );
+}
+
+#endif  // WRESULTKEY_H
@@ -22,6 +22,7 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -36,7 +37,9 @@ WSelectorRoi::WSelectorRoi( osg::ref_ptr< WROI > roi, std::shared_ptr< const WDa
     m_fibers( fibers ),
     m_kdTree( kdTree ),
     m_size( fibers->size() ),
-    m_dirty( true )
+    m_dirty( true ),
+    m_maskValues( NULL ),
+    m_maskThreshold( 0.0f )
 {
     m_bitField = std::shared_ptr< std::vector<bool> >( new std::vector<bool>( m_size, false ) );
 
@@ -83,27 +86,31 @@ void WSelectorRoi::recalculate()
     {
         osg::ref_ptr<WROIArbitrary>roi = osg::dynamic_pointer_cast<WROIArbitrary>( m_roi );
 
-        float threshold = static_cast<float>( roi->getThreshold() );
+        m_occupancy = roi->getOccupancy();
 
-        size_t nx = roi->getCoordDimensions()[0];
-        size_t ny = roi->getCoordDimensions()[1];
-
-        double dx = roi->getCoordOffsets()[0];
-        double dy = roi->getCoordOffsets()[1];
-        double dz = roi->getCoordOffsets()[2];
-
-        for( size_t i = 0; i < m_currentArray->size()/3; ++i )
+        if( !m_occupancy->isEmpty() )
         {
-            size_t x = static_cast<size_t>( ( *m_currentArray )[i * 3 ] / dx );
-            size_t y = static_cast<size_t>( ( *m_currentArray )[i * 3 + 1] / dy );
-            size_t z = static_cast<size_t>( ( *m_currentArray )[i * 3 + 2] / dz );
-            int index = x + y * nx + z * nx * ny;
+            m_maskValues = &roi->getValues();
+            m_maskThreshold = m_occupancy->getThreshold();
 
-            if( static_cast<float>( roi->getValue( index ) ) - threshold > 0.1 )
+            std::vector< size_t > dims = roi->getCoordDimensions();
+            std::vector< double > offsets = roi->getCoordOffsets();
+
+            osg::Vec3f lower;
+            osg::Vec3f upper;
+            for( size_t axis = 0; axis < 3; ++axis )
             {
-                ( *m_workerBitfield )[getLineForPoint( i )] = 1;
+                m_maskDims[axis] = dims[axis];
+                m_voxelSize[axis] = offsets[axis];
+                lower[axis] = m_occupancy->getMin( axis );
+                upper[axis] = m_occupancy->getMax( axis ) + 1;
             }
+
+            maskTest( 0, m_currentArray->size() / 3 - 1, 0, lower, upper );
         }
+
+        m_occupancy.reset();
+        m_maskValues = NULL;
     }
     m_dirty = false;
     m_bitField = m_workerBitfield;
@@ -140,3 +147,50 @@ void WSelectorRoi::boxTest( int left, int right, int axis )
         boxTest( root + 1, right, axis1 );
     }
 }
+
+void WSelectorRoi::maskTest( int left, int right, int axis, osg::Vec3f lower, osg::Vec3f upper )
+{
+    // abort condition
+    if( left > right || !isRegionOccupied( lower, upper ) )
+        return;
+
+    int root = left + ( ( right - left ) / 2 );
+    int axis1 = ( axis + 1 ) % 3;
+    size_t point = m_kdTree->m_tree[root];
+    osg::Vec3f position = toVoxel( point * 3 );
+
+    size_t line = getLineForPoint( point );
+    if( !( *m_workerBitfield )[line] && isInsideMask( position ) )
+    {
+        ( *m_workerBitfield )[line] = 1;
+    }
+
+    osg::Vec3f split = upper;
+    split[axis] = std::min( upper[axis], position[axis] );
+    maskTest( left, root - 1, axis1, lower, split );
+
+    split = lower;
+    split[axis] = std::max( lower[axis], position[axis] );
+    maskTest( root + 1, right, axis1, split, upper );
+}
+
+bool WSelectorRoi::isRegionOccupied( osg::Vec3f const& lower, osg::Vec3f const& upper ) const
+{
+    // the region never grows beyond the bounding box of the roi it started with
+    size_t min[3];
+    size_t max[3];
+    for( size_t axis = 0; axis < 3; ++axis )
+    {
+        if( lower[axis] > upper[axis] )
+        {
+            return false;
+        }
+        min[axis] = static_cast< size_t >( lower[axis] );
+        max[axis] = std::min( static_cast< size_t >( upper[axis] ), m_occupancy->getMax( axis ) );
+        if( min[axis] > max[axis] )
+        {
+            return false;
+        }
+    }
+    return m_occupancy->isOccupied( min, max );
+}
@@ -25,11 +25,15 @@
 #ifndef WSELECTORROI_H
 #define WSELECTORROI_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
+#include <osg/Vec3>
+
 #include "../dataHandler/WDataSetFibers.h"
 #include "../graphicsEngine/WROI.h"
+#include "../graphicsEngine/WROIArbitrary.h"
 
 class WKdTree;
 
@@ -87,6 +91,39 @@ private:
      */
     void boxTest( int left, int right, int axis );
 
+    /**
+     * recursive function to check for intersections with an arbitrary roi. Subtrees whose region does not touch an occupied block of
+     * the roi are skipped.
+     * \param left
+     * \param right
+     * \param axis
+     * \param lower lower corner of the region of the subtree, in voxels
+     * \param upper upper corner of the region of the subtree, in voxels
+     */
+    void maskTest( int left, int right, int axis, osg::Vec3f lower, osg::Vec3f upper );
+
+    /**
+     * Checks whether a region touches an occupied block of the arbitrary roi.
+     * \param lower lower corner of the region, in voxels
+     * \param upper upper corner of the region, in voxels
+     * \return true if the subtree of the region needs to be tested
+     */
+    bool isRegionOccupied( osg::Vec3f const& lower, osg::Vec3f const& upper ) const;
+
+    /**
+     * Checks whether a point is inside the arbitrary roi.
+     * \param point the position of the point in voxels
+     * \return true if the voxel containing the point is inside the roi
+     */
+    bool isInsideMask( osg::Vec3f const& point ) const;
+
+    /**
+     * The position of a point in voxels of the arbitrary roi.
+     * \param pointIndex the index of the first coordinate of the point in the vertex array
+     * \return the position
+     */
+    osg::Vec3f toVoxel( size_t pointIndex ) const;
+
     /**
      * getter
      * \param point point to check
@@ -145,6 +182,12 @@ private:
     std::vector<float> m_boxMin; //!< lower boundary of the box, used for boxtest
     std::vector<float> m_boxMax; //!< upper boundary of the box, used for boxtest
 
+    std::shared_ptr< const WROIArbitrary::Occupancy > m_occupancy; //!< blocks of the arbitrary roi, used for masktest
+    std::vector< float > const* m_maskValues; //!< values of the arbitrary roi, used for masktest
+    size_t m_maskDims[ 3 ]; //!< number of voxels of the arbitrary roi, used for masktest
+    osg::Vec3f m_voxelSize; //!< voxel size of the arbitrary roi, used for masktest
+    float m_maskThreshold; //!< threshold of the arbitrary roi, used for masktest
+
     std::shared_ptr< boost::function< void() > > m_changeRoiSignal; //!< Signal that can be used to update the selector ROI
 };
 
@@ -162,6 +205,29 @@ inline size_t WSelectorRoi::getLineForPoint( size_t point )
     return ( *m_currentReverse )[point];
 }
 
+inline osg::Vec3f WSelectorRoi::toVoxel( size_t pointIndex ) const
+{
+    return osg::Vec3f( ( *m_currentArray )[pointIndex] / m_voxelSize[0],
+                       ( *m_currentArray )[pointIndex + 1] / m_voxelSize[1],
+                       ( *m_currentArray )[pointIndex + 2] / m_voxelSize[2] );
+}
+
+inline bool WSelectorRoi::isInsideMask( osg::Vec3f const& point ) const
+{
+    if( point[0] < 0.0f || point[1] < 0.0f || point[2] < 0.0f )
+    {
+        return false;
+    }
+    size_t x = static_cast< size_t >( point[0] );
+    size_t y = static_cast< size_t >( point[1] );
+    size_t z = static_cast< size_t >( point[2] );
+    if( x >= m_maskDims[0] || y >= m_maskDims[1] || z >= m_maskDims[2] || !m_occupancy->isOccupied( x, y, z ) )
+    {
+        return false;
+    }
+    return WROIArbitrary::isInside( ( *m_maskValues )[x + m_maskDims[0] * ( y + m_maskDims[1] * z )], m_maskThreshold );
+}
+
 inline osg::ref_ptr< WROI > WSelectorRoi::getRoi()
 {
     return m_roi;
@@ -0,0 +1,219 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WRESULTCACHE_TEST_H
+#define WRESULTCACHE_TEST_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <cxxtest/TestSuite.h>
+
+#include "../../common/WLogger.h"
+#include "../../common/WProperties.h"
+#include "../../dataHandler/WDataSetScalar.h"
+#include "../../dataHandler/WGridRegular3D.h"
+#include "../WResultCache.h"
+#include "../WResultKey.h"
+
+/**
+ * Tests for WResultKey and WResultCache.
+ */
+class WResultCacheTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger and other stuff for each test.
+     */
+    void setUp()
+    {
+        WLogger::startup();
+    }
+
+    /**
+     * Keys depend on the values added, datasets are compared by content.
+     */
+    void testKey()
+    {
+        std::shared_ptr< WDataSetScalar > a = createDataSet( 1.0 );
+        std::shared_ptr< WDataSetScalar > b = createDataSet( 1.0 );
+        std::shared_ptr< WDataSetScalar > c = createDataSet( 2.0 );
+
+        TS_ASSERT( WResultKey( "m" ).add( a ) == WResultKey( "m" ).add( b ) );
+        TS_ASSERT( WResultKey( "m" ).add( a ) != WResultKey( "m" ).add( c ) );
+        TS_ASSERT( WResultKey( "m" ).add( a ) != WResultKey( "n" ).add( a ) );
+        TS_ASSERT( WResultKey( "m" ).add( a ) != WResultKey( "m" ).add( std::shared_ptr< WDataSet const >() ) );
+
+        std::shared_ptr< WProperties > properties( new WProperties( "p", "p" ) );
+        WPropDouble iso = properties->addProperty( "iso", "iso", 0.5 );
+        WResultKey first( "m" );
+        first.add( a ).add( iso ).add( 3 );
+        iso->set( 0.7 );
+        WResultKey second( "m" );
+        second.add( a ).add( iso ).add( 3 );
+        TS_ASSERT( first != second );
+        iso->set( 0.5 );
+        TS_ASSERT( first == WResultKey( "m" ).add( a ).add( iso ).add( 3 ) );
+        TS_ASSERT_EQUALS( first.toString().size(), 16 );
+    }
+
+    /**
+     * Properties are added with their exact value, not the rounded string representation.
+     */
+    void testKeyExactProperties()
+    {
+        std::shared_ptr< WProperties > properties( new WProperties( "p", "p" ) );
+        WPropDouble iso = properties->addProperty( "iso", "iso", 100.0001 );
+        WResultKey first( "m" );
+        first.add( iso );
+        iso->set( 100.0003 );
+        WResultKey second( "m" );
+        second.add( iso );
+        TS_ASSERT( first != second );
+        TS_ASSERT( first.getMaterial() != second.getMaterial() );
+
+        WPropPosition position = properties->addProperty( "pos", "pos", WPosition( 1.0, 2.0, 3.0 ) );
+        WResultKey third( "m" );
+        third.add( position );
+        position->set( WPosition( 1.0, 2.0, 3.0000001 ) );
+        TS_ASSERT( third != WResultKey( "m" ).add( position ) );
+    }
+
+    /**
+     * The cache keeps the most recently used results.
+     */
+    void testMemory()
+    {
+        WResultCache cache( 2 );
+        std::shared_ptr< WDataSetScalar > results[] = { createDataSet( 1.0 ), createDataSet( 2.0 ), createDataSet( 3.0 ) }; // NOLINT
+        WResultKey keys[] = { WResultKey( "1" ), WResultKey( "2" ), WResultKey( "3" ) }; // NOLINT curly braces
+
+        TS_ASSERT( !cache.get( keys[ 0 ] ) );
+        cache.put( keys[ 0 ], results[ 0 ] );
+        cache.put( keys[ 1 ], results[ 1 ] );
+        TS_ASSERT_EQUALS( cache.get< WDataSetScalar >( keys[ 0 ] ), results[ 0 ] );
+
+        // the second one is the least recently used now
+        cache.put( keys[ 2 ], results[ 2 ] );
+        TS_ASSERT_EQUALS( cache.size(), 2 );
+        TS_ASSERT_EQUALS( cache.get( keys[ 0 ] ), results[ 0 ] );
+        TS_ASSERT( !cache.get( keys[ 1 ] ) );
+        TS_ASSERT_EQUALS( cache.get( keys[ 2 ] ), results[ 2 ] );
+        TS_ASSERT_EQUALS( cache.getHits(), 3 );
+        TS_ASSERT_EQUALS( cache.getMisses(), 2 );
+
+        cache.clear();
+        TS_ASSERT_EQUALS( cache.size(), 0 );
+    }
+
+    /**
+     * The cache keeps results up to their estimated size.
+     */
+    void testMemoryBytes()
+    {
+        std::size_t const bytes = 27 * sizeof( float );
+        WResultCache cache( 16, 2 * bytes );
+        std::shared_ptr< WDataSetScalar > results[] = { createDataSet( 1.0 ), createDataSet( 2.0 ), createDataSet( 3.0 ) }; // NOLINT
+        WResultKey keys[] = { WResultKey( "1" ), WResultKey( "2" ), WResultKey( "3" ) }; // NOLINT curly braces
+
+        cache.put( keys[ 0 ], results[ 0 ] );
+        cache.put( keys[ 1 ], results[ 1 ] );
+        TS_ASSERT_EQUALS( cache.getBytes(), 2 * bytes );
+        cache.put( keys[ 2 ], results[ 2 ] );
+        TS_ASSERT_EQUALS( cache.size(), 2 );
+        TS_ASSERT_EQUALS( cache.getBytes(), 2 * bytes );
+        TS_ASSERT( !cache.get( keys[ 0 ] ) );
+
+        // replacing a result does not count it twice
+        cache.put( keys[ 2 ], results[ 0 ] );
+        TS_ASSERT_EQUALS( cache.getBytes(), 2 * bytes );
+
+        cache.setMaxBytes( bytes );
+        TS_ASSERT_EQUALS( cache.size(), 1 );
+        TS_ASSERT_EQUALS( cache.get( keys[ 2 ] ), results[ 0 ] );
+
+        // too large to be kept at all
+        cache.setMaxBytes( bytes - 1 );
+        TS_ASSERT_EQUALS( cache.size(), 0 );
+        TS_ASSERT_EQUALS( cache.getBytes(), 0 );
+    }
+
+    /**
+     * Scalar datasets survive in the directory.
+     */
+    void testDirectory()
+    {
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        WResultKey key( "disk" );
+        std::shared_ptr< WDataSetScalar > result = createDataSet( 4.0 );
+        {
+            WResultCache cache;
+            cache.setDirectory( directory );
+            cache.put( key, result );
+        }
+
+        WResultCache cache;
+        cache.setDirectory( directory );
+        std::shared_ptr< WDataSetScalar > read = cache.get< WDataSetScalar >( key );
+        TS_ASSERT( read );
+        if( read )
+        {
+            TS_ASSERT( read != result );
+            TS_ASSERT_EQUALS( WResultKey::hashDataSet( read ), WResultKey::hashDataSet( result ) );
+            TS_ASSERT_EQUALS( read->getValueSet()->getDataType(), W_DT_FLOAT );
+        }
+        TS_ASSERT( !cache.get( WResultKey( "other" ) ) );
+
+        // a file of another key with the same name, as if the digests collided
+        boost::filesystem::copy_file( directory / ( key.toString() + ".owresult" ),
+                                      directory / ( WResultKey( "other" ).toString() + ".owresult" ) );
+        TS_ASSERT( !cache.get( WResultKey( "other" ) ) );
+
+        boost::filesystem::remove_all( directory );
+    }
+
+private:
+    /**
+     * Creates a small float dataset.
+     *
+     * \param scale scales the values
+     *
+     * \return the dataset
+     */
+    std::shared_ptr< WDataSetScalar > createDataSet( double scale )
+    {
+        std::shared_ptr< std::vector< float > > data( new std::vector< float >( 27 ) );
+        for( std::size_t i = 0; i < data->size(); ++i )
+        {
+            ( *data )[ i ] = static_cast< float >( scale * i );
+        }
+        std::shared_ptr< WValueSetBase > values( new WValueSet< float >( 0, 1, data, W_DT_FLOAT ) );
+        std::shared_ptr< WGrid > grid( new WGridRegular3D( 3, 3, 3, 1.0, 2.0, 3.0 ) );
+        return std::shared_ptr< WDataSetScalar >( new WDataSetScalar( values, grid ) );
+    }
+};
+
+#endif  // WRESULTCACHE_TEST_H
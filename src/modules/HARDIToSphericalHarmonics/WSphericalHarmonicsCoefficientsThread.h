@@ -220,6 +220,17 @@ void WSphericalHarmonicsCoefficientsThread< T >::threadMain()
     WMatrix<double> transformMatrix( *m_parameter.m_TransformMatrix );
     size_t l = ( m_parameter.m_order + 1 ) * ( m_parameter.m_order + 2 ) / 2;
 
+    std::shared_ptr< WValueSet< T > > vs = std::dynamic_pointer_cast< WValueSet< T > >( m_parameter.m_valueSet );
+    if( !vs )
+    {
+        throw WException( "Valueset pointer not valid." );
+    }
+
+    // the measures for gradients != 0 and the resulting coefficients, reused for all voxels
+    WValue< double > measures( m_parameter.m_validIndices.size() );
+    WValue< double > coefficients( transformMatrix.getNbRows() );
+    WAssert( transformMatrix.getNbCols() == measures.size(), "Incompatible number of rows of rhs and columns of lhs." );
+
     for( size_t i = m_range.first; i < m_range.second; i++ )
     {
         if( m_parameter.m_shutdownFlag() )
@@ -227,17 +238,10 @@ void WSphericalHarmonicsCoefficientsThread< T >::threadMain()
             break;
         }
 
-        // get measure vector
-        std::shared_ptr< WValueSet< T > > vs = std::dynamic_pointer_cast< WValueSet< T > >( m_parameter.m_valueSet );
-        if( !vs )
-        {
-            throw WException( "Valueset pointer not valid." );
-        }
-
-        WValue< T > allMeasures( vs->getWValue( i ) );
+        // get measure vector, without copying it
+        typename WValueSet< T >::SubArray const allMeasures = vs->getSubArray( i * vs->dimension(), vs->dimension() );
 
         // extract measures for gradients != 0
-        WValue< double > measures( m_parameter.m_validIndices.size() );
         unsigned int idx = 0;
 
         // find max S0 value
@@ -285,7 +289,15 @@ void WSphericalHarmonicsCoefficientsThread< T >::threadMain()
             }
         }
 
-        WValue< double > coefficients( *m_parameter.m_TransformMatrix * measures );
+        // coefficients = transformMatrix * measures
+        for( std::size_t r = 0; r < transformMatrix.getNbRows(); ++r )
+        {
+            coefficients[ r ] = 0.0;
+            for( std::size_t c = 0; c < transformMatrix.getNbCols(); ++c )
+            {
+                coefficients[ r ] += transformMatrix( r, c ) * measures[ c ];
+            }
+        }
 
         if( m_parameter.m_doResidualCalculation || m_parameter.m_doErrorCalculation )
         {
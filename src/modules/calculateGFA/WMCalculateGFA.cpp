@@ -38,8 +38,7 @@
 W_LOADABLE_MODULE( WMCalculateGFA )
 
 WMCalculateGFA::WMCalculateGFA():
-    WModule(),
-    m_BMat( 1, 1 )
+    WModule()
 {
 }
 
@@ -114,7 +113,7 @@ void WMCalculateGFA::moduleMain()
     }
     grad.clear();
 
-    m_BMat = WSymmetricSphericalHarmonic< double >::calcBaseMatrix( ori, 4 );
+    m_plan = WSymmetricSphericalHarmonicPlan< double >::getPlan( ori, 4 );
     ori.clear();
 
     ready();
@@ -214,13 +213,12 @@ boost::array< double, 1 > WMCalculateGFA::perVoxelGFAFunc( WValueSet< double >::
 {
     ++*m_currentProgress;
     boost::array< double, 1 > a;
-    WValue<double> w( 15 );
+    double w[ 15 ];
     for( int i = 0; i < 15; ++i )
     {
         w[ i ] = s[ i ];
     }
-    WSymmetricSphericalHarmonic< double > h( w );
-    a[ 0 ] = h.calcGFA( m_BMat );
+    a[ 0 ] = m_plan->calcGFA( w );
 
     return a;
 }
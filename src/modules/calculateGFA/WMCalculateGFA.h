@@ -30,7 +30,7 @@
 #include <vector>
 
 #include "core/common/WThreadedFunction.h"
-#include "core/common/math/WMatrix.h"
+#include "core/common/math/WSymmetricSphericalHarmonicPlan.h"
 #include "core/dataHandler/WDataSetScalar.h"
 #include "core/dataHandler/WDataSetSphericalHarmonics.h"
 #include "core/dataHandler/WThreadedPerVoxelOperation.h"
@@ -165,8 +165,8 @@ private:
     //! The threadpool.
     std::shared_ptr< GFAPoolType > m_gfaPool;
 
-    //! A matrix of SH base function values for various gradients.
-    WMatrix<double> m_BMat;
+    //! The precomputed SH base function values for various gradients.
+    std::shared_ptr< WSymmetricSphericalHarmonicPlan< double > const > m_plan;
 };
 
 #endif  // WMCALCULATEGFA_H
@@ -35,6 +35,7 @@
 #include "core/common/WException.h"
 #include "core/common/WLogger.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WEEG.h"
 #include "core/dataHandler/WSubject.h"
 
@@ -73,6 +74,7 @@ void WReaderBiosig::fillSegmentRowBased( std::vector<std::vector<double> >* segm
 
 std::shared_ptr< WDataSet > WReaderBiosig::load()
 {
+    WTRACE_SCOPE( "WReaderBiosig::load" );
     WAssert( m_fname.substr( m_fname.size() - 4 ) == ".edf", "We expect only EDF for the biosig loader so far." );
 
     hd =  sopen( m_fname.c_str(), "r", 0 );
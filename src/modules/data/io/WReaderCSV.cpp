@@ -22,12 +22,182 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <boost/filesystem.hpp>
+#include <boost/function.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread.hpp>
+
+#include "core/common/WThreadedFunction.h"
+#include "core/common/WTracer.h"
 #include "WReaderCSV.h"
 
+namespace
+{
+    //! the distinct strings of a column and their codes, the strings point into the mapped file
+    typedef std::unordered_map< std::string_view, std::uint32_t > Dictionary;
+
+    /**
+     * A range of complete lines of the file together with what the threads found in it.
+     */
+    struct WCSVChunk
+    {
+        //! the first character of the first line
+        char const* begin;
+
+        //! one past the last character of the last line
+        char const* end;
+
+        //! the index of the first row of this chunk in the whole file
+        std::size_t firstRow;
+
+        //! the number of rows in this chunk
+        std::size_t numRows;
+
+        //! true if a row with a wrong number of cells was found
+        bool invalidRow;
+
+        //! the findings per column
+        std::vector< WCSVColumn::TypeDetector > detectors;
+
+        //! for each string column, the distinct strings of this chunk in the order of their chunk local codes
+        std::vector< std::vector< std::string_view > > strings;
+
+        //! for each string column, the mapping from the chunk local codes to the codes of the whole column
+        std::vector< std::vector< std::uint32_t > > codeMap;
+    };
+
+    /**
+     * Calls a function once per chunk. To be used with WThreadedFunction, the number of threads equals the number of chunks.
+     */
+    class WCSVChunkFunction
+    {
+    public:
+        //! the function called with the index of the chunk
+        typedef boost::function< void ( std::size_t ) > ChunkFunction;
+
+        /**
+         * Constructor.
+         *
+         * \param func The function to call for each chunk.
+         */
+        explicit WCSVChunkFunction( ChunkFunction const& func )
+            : m_func( func )
+        {
+        }
+
+        /**
+         * Processes the chunk of this thread.
+         *
+         * \param id The number of this thread, which is the index of the chunk.
+         * \param stop Set if the computation should be stopped.
+         */
+        void operator()( std::size_t id, std::size_t /* mx */, WBoolFlag const& stop )
+        {
+            if( !stop() )
+            {
+                m_func( id );
+            }
+        }
+
+    private:
+        //! the function
+        ChunkFunction m_func;
+    };
+
+    /**
+     * Processes all chunks in parallel and waits for all threads to finish.
+     *
+     * \param numChunks The number of chunks.
+     * \param func The function to call for each chunk.
+     */
+    void forEachChunk( std::size_t numChunks, WCSVChunkFunction::ChunkFunction const& func )
+    {
+        std::shared_ptr< WCSVChunkFunction > function( new WCSVChunkFunction( func ) );
+        WThreadedFunction< WCSVChunkFunction > pool( numChunks, function );
+        pool.run();
+        pool.wait();
+        if( pool.status() != W_THREADS_FINISHED )
+        {
+            throw WException( std::string( "A thread reading the CSV file was aborted." ) );
+        }
+    }
+
+    /**
+     * Finds the end of a line.
+     *
+     * \param begin The first character of the line.
+     * \param end The end of the text.
+     *
+     * \return The position of the newline character or end.
+     */
+    char const* findLineEnd( char const* begin, char const* end )
+    {
+        char const* newline = static_cast< char const* >( std::memchr( begin, '\n', end - begin ) );
+        return newline ? newline : end;
+    }
+
+    /**
+     * Calls func( begin, end ) for each line of a range of the file. Line breaks may be "\n" or "\r\n".
+     *
+     * \param begin The first character of the first line.
+     * \param end One past the last character of the last line.
+     * \param func The function to call.
+     */
+    template< typename Func >
+    void forEachLine( char const* begin, char const* end, Func func )
+    {
+        while( begin < end )
+        {
+            char const* lineEnd = findLineEnd( begin, end );
+            char const* next = lineEnd == end ? end : lineEnd + 1;
+            if( lineEnd != begin && *( lineEnd - 1 ) == '\r' )
+            {
+                --lineEnd;
+            }
+            func( begin, lineEnd );
+            begin = next;
+        }
+    }
+
+    /**
+     * Calls func( column, begin, end ) for the cells of a line. Cells are split like std::getline( line, cell, ',' ) would
+     * do, i.e. a trailing comma does not start another cell. Cells beyond numColumns are counted, but not passed on.
+     *
+     * \param begin The first character of the line.
+     * \param end One past the last character of the line.
+     * \param numColumns The maximum number of cells passed to func.
+     * \param func The function to call.
+     *
+     * \return The number of cells of the line.
+     */
+    template< typename Func >
+    std::size_t forEachCell( char const* begin, char const* end, std::size_t numColumns, Func func )
+    {
+        std::size_t count = 0;
+        while( begin != end )
+        {
+            char const* cellEnd = static_cast< char const* >( std::memchr( begin, ',', end - begin ) );
+            cellEnd = cellEnd ? cellEnd : end;
+            if( count < numColumns )
+            {
+                func( count, begin, cellEnd );
+            }
+            ++count;
+            begin = cellEnd == end ? end : cellEnd + 1;
+        }
+        return count;
+    }
+}
 
 WReaderCSV::WReaderCSV( std::string fname )
         : WReader( fname )
@@ -38,74 +208,212 @@ WReaderCSV::~WReaderCSV() throw()
 {
 }
 
-
 std::shared_ptr< WDataSetCSV > WReaderCSV::read()
 {
-    size_t columnCount = 0;
-    std::string line;
-    std::vector< std::string >  row;
-    WDataSetCSV::SeperatedRowSPtr rawRow = WDataSetCSV::SeperatedRowSPtr( new std::vector< std::string >() );
-
-    WDataSetCSV::ContentSPtr header = WDataSetCSV::ContentSPtr( new WDataSetCSV::Content() );
-    WDataSetCSV::ContentSPtr data = WDataSetCSV::ContentSPtr( new WDataSetCSV::Content() );
-
-    std::fstream file;
-    file.open( m_fname );
+    WTRACE_SCOPE( "WReaderCSV::read" );
+    boost::system::error_code error;
+    boost::uintmax_t const fileSize = boost::filesystem::file_size( m_fname, error );
+    if( error )
+    {
+        throw WException( "File could not be opened!" );
+    }
+    if( fileSize == 0 )
+    {
+        throw WException( "CSV file is empty!" );
+    }
 
-    if( !file.is_open() )
+    std::shared_ptr< boost::interprocess::mapped_region > region;
+    try
+    {
+        boost::interprocess::file_mapping file( m_fname.c_str(), boost::interprocess::read_only );
+        region.reset( new boost::interprocess::mapped_region( file, boost::interprocess::read_only ) );
+        region->advise( boost::interprocess::mapped_region::advice_sequential );
+    }
+    catch( boost::interprocess::interprocess_exception const& )
     {
         throw WException( "File could not be opened!" );
     }
 
+    char const* const fileBegin = static_cast< char const* >( region->get_address() );
+    char const* const fileEnd = fileBegin + region->get_size();
+
     // treat first line as header
-    std::getline( file, line );
-    if( line == "" )
+    WDataSetCSV::ContentSPtr header = WDataSetCSV::ContentSPtr( new WDataSetCSV::Content( 1 ) );
+    forEachLine( fileBegin, findLineEnd( fileBegin, fileEnd ), [ & ]( char const* begin, char const* end )
+    {
+        forEachCell( begin, end, std::string::npos, [ & ]( std::size_t, char const* cellBegin, char const* cellEnd )
+        {
+            header->front().push_back( std::string( cellBegin, cellEnd ) );
+        } );
+    } );
+    if( header->front().empty() )
     {
         throw WException( "CSV file is empty!" );
     }
+    std::size_t const numColumns = header->front().size();
+    char const* const dataBegin = std::min( findLineEnd( fileBegin, fileEnd ) + 1, fileEnd );
 
-    rawRow->push_back( line );
-    header->push_back( transformLineToVector( line ) );
-    columnCount = header->at( 0 ).size();
+    // split the remaining lines into one chunk per thread, small files are read by a single thread
+    std::size_t const minChunkSize = 1 << 20;
+    std::size_t const dataSize = fileEnd - dataBegin;
+    std::size_t const numChunks = std::max< std::size_t >( 1, std::min< std::size_t >( boost::thread::hardware_concurrency(),
+                                                                                       dataSize / minChunkSize ) );
+    std::vector< WCSVChunk > chunks( numChunks );
+    char const* chunkBegin = dataBegin;
+    for( std::size_t i = 0; i < numChunks; ++i )
+    {
+        char const* chunkEnd = fileEnd;
+        if( i + 1 < numChunks )
+        {
+            chunkEnd = findLineEnd( std::max( chunkBegin, dataBegin + dataSize * ( i + 1 ) / numChunks ), fileEnd );
+            chunkEnd = std::min( chunkEnd + 1, fileEnd );
+        }
+        chunks[ i ].begin = chunkBegin;
+        chunks[ i ].end = chunkEnd;
+        chunks[ i ].firstRow = 0;
+        chunks[ i ].numRows = 0;
+        chunks[ i ].invalidRow = false;
+        chunks[ i ].detectors.resize( numColumns );
+        chunks[ i ].strings.resize( numColumns );
+        chunks[ i ].codeMap.resize( numColumns );
+        chunkBegin = chunkEnd;
+    }
 
-    // treat remaining lines as data
-    while( std::getline( file, line ) )
+    // first pass: count the rows and determine the column types
+    forEachChunk( numChunks, [ & ]( std::size_t id )
     {
-        rawRow->push_back( line );
-        row = transformLineToVector( line );
-        if( row.size() != columnCount )
+        WCSVChunk& chunk = chunks[ id ];
+        forEachLine( chunk.begin, chunk.end, [ & ]( char const* begin, char const* end )
+        {
+            std::size_t cells = forEachCell( begin, end, numColumns, [ & ]( std::size_t column, char const* cellBegin, char const* cellEnd )
+            {
+                chunk.detectors[ column ].add( cellBegin, cellEnd );
+            } );
+            chunk.invalidRow = chunk.invalidRow || cells != numColumns;
+            ++chunk.numRows;
+        } );
+    } );
+
+    std::size_t numRows = 0;
+    WCSVColumn::TypeDetector initial;
+    std::vector< WCSVColumn::TypeDetector > detectors( numColumns, initial );
+    for( std::size_t i = 0; i < numChunks; ++i )
+    {
+        if( chunks[ i ].invalidRow )
         {
             throw WException( "Data row count does not equal header count!" );
         }
-        else
+        chunks[ i ].firstRow = numRows;
+        numRows += chunks[ i ].numRows;
+        for( std::size_t column = 0; column < numColumns; ++column )
         {
-            data->push_back( row );
+            detectors[ column ].merge( chunks[ i ].detectors[ column ] );
         }
     }
 
-    if( data->size() == 0 )
+    if( numRows == 0 )
     {
         throw WException( "CSV File does not contain data!" );
     }
 
-    file.close();
-
-    std::shared_ptr< WDataSetCSV > datasetcsv = std::shared_ptr< WDataSetCSV >( new WDataSetCSV( header, data ) );
-    datasetcsv->setRawDataSet( rawRow );
-
-    return datasetcsv;
-}
+    std::vector< WCSVColumn::SPtr > columns( numColumns );
+    bool anyStringColumn = false;
+    for( std::size_t column = 0; column < numColumns; ++column )
+    {
+        columns[ column ] = WCSVColumn::SPtr( new WCSVColumn( header->front()[ column ], detectors[ column ].getType(), numRows ) );
+        anyStringColumn = anyStringColumn || detectors[ column ].getType() == WCSVColumn::COLUMN_STRING;
+    }
 
-std::vector< std::string > WReaderCSV::transformLineToVector( std::string line )
-{
-    std::string cell;
-    std::vector< std::string >  row;
+    // second pass: parse the cells directly into the columns, strings get chunk local codes
+    forEachChunk( numChunks, [ & ]( std::size_t id )
+    {
+        WCSVChunk& chunk = chunks[ id ];
+        std::vector< Dictionary > dictionaries( numColumns );
+        std::size_t row = chunk.firstRow;
+        forEachLine( chunk.begin, chunk.end, [ & ]( char const* begin, char const* end )
+        {
+            forEachCell( begin, end, numColumns, [ & ]( std::size_t column, char const* cellBegin, char const* cellEnd )
+            {
+                WCSVColumn& target = *columns[ column ];
+                if( target.getType() == WCSVColumn::COLUMN_STRING )
+                {
+                    std::vector< std::string_view >& strings = chunk.strings[ column ];
+                    std::pair< Dictionary::iterator, bool > code = dictionaries[ column ].insert(
+                        std::make_pair( std::string_view( cellBegin, cellEnd - cellBegin ), static_cast< std::uint32_t >( strings.size() ) ) );
+                    if( code.second )
+                    {
+                        strings.push_back( code.first->first );
+                    }
+                    target.getCodes()[ row ] = code.first->second;
+                }
+                else
+                {
+                    target.setNumber( row, cellBegin, cellEnd );
+                }
+            } );
+            ++row;
+        } );
+    } );
 
-    std::istringstream inLine( line );
-    while( std::getline( inLine, cell, ',' ) )
+    if( anyStringColumn )
     {
-        row.push_back( cell );
+        // merge the dictionaries of the chunks in order, so the codes of the first chunk stay valid
+        for( std::size_t column = 0; column < numColumns; ++column )
+        {
+            if( columns[ column ]->getType() != WCSVColumn::COLUMN_STRING )
+            {
+                continue;
+            }
+            Dictionary merged;
+            std::vector< std::string > dictionary;
+            for( std::size_t i = 0; i < numChunks; ++i )
+            {
+                std::vector< std::string_view > const& strings = chunks[ i ].strings[ column ];
+                chunks[ i ].codeMap[ column ].resize( strings.size() );
+                for( std::size_t local = 0; local < strings.size(); ++local )
+                {
+                    std::pair< Dictionary::iterator, bool > code =
+                        merged.insert( std::make_pair( strings[ local ], static_cast< std::uint32_t >( dictionary.size() ) ) );
+                    if( code.second )
+                    {
+                        dictionary.push_back( std::string( strings[ local ] ) );
+                    }
+                    chunks[ i ].codeMap[ column ][ local ] = code.first->second;
+                }
+            }
+            columns[ column ]->setDictionary( &dictionary );
+        }
+
+        // third pass: translate the chunk local codes
+        if( numChunks > 1 )
+        {
+            forEachChunk( numChunks, [ & ]( std::size_t id )
+            {
+                WCSVChunk const& chunk = chunks[ id ];
+                for( std::size_t column = 0; column < numColumns && id > 0; ++column )
+                {
+                    if( columns[ column ]->getType() != WCSVColumn::COLUMN_STRING )
+                    {
+                        continue;
+                    }
+                    std::uint32_t* codes = columns[ column ]->getCodes() + chunk.firstRow;
+                    std::vector< std::uint32_t > const& codeMap = chunk.codeMap[ column ];
+                    for( std::size_t row = 0; row < chunk.numRows; ++row )
+                    {
+                        codes[ row ] = codeMap[ codes[ row ] ];
+                    }
+                }
+            } );
+        }
     }
 
-    return row;
+    WDataSetCSV::Columns result( columns.begin(), columns.end() );
+    // the string representation of the dataset reproduces the file exactly, so the mapping lives as long as the dataset. Its pages
+    // are released now and read from the file again only if the string representation gets created.
+    region->advise( boost::interprocess::mapped_region::advice_dontneed );
+    WDataSetCSV::TextSPtr text( new std::string_view( fileBegin, fileEnd - fileBegin ), [ region ]( std::string_view const* view )
+    {
+        delete view;
+    } );
+    return std::shared_ptr< WDataSetCSV >( new WDataSetCSV( header, result, text ) );
 }
@@ -36,7 +36,8 @@
 
 
 /**
- * Read content from a CSV file.
+ * Read content from a CSV file. The file is memory mapped and parsed by several threads directly into typed columns,
+ * see WCSVColumn. No strings are created for the cells of numeric columns.
  * \ingroup dataHandler
  */
 class WReaderCSV : WReader
@@ -65,13 +66,6 @@ public:
      * \throws WException If the file could not be opened.
      */
     virtual std::shared_ptr< WDataSetCSV > read();
-private:
-    /**
-     * Transforms a given string into a string vector, by a predefined delimiter
-     * \param line The line, which shell be split into a string vector
-     * \return The splitted string as a string vector
-     */
-    std::vector< std::string > transformLineToVector( std::string line );
 };
 
 #endif  // WREADERCSV_H
@@ -24,7 +24,6 @@
 
 #include <cstdlib>
 #include <fstream>
-#include <list>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -38,6 +37,7 @@
 #include "core/common/WLimits.h"
 #include "core/common/WLogger.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WDataSetHierarchicalClustering.h"
 #include "core/dataHandler/datastructures/WFiberCluster.h"
 #include "core/dataHandler/exceptions/WDHIOFailure.h"
@@ -56,6 +56,7 @@ WReaderClustering::~WReaderClustering() throw()
 
 std::shared_ptr< WDataSetHierarchicalClustering > WReaderClustering::read()
 {
+    WTRACE_SCOPE( "WReaderClustering::read" );
     //Read file to line list
     std::shared_ptr< std::ifstream > ifs( new std::ifstream() );
     ifs->open( m_fname.c_str(), std::ifstream::in | std::ifstream::binary );
@@ -108,7 +109,7 @@ std::shared_ptr< WDataSetHierarchicalClustering > WReaderClustering::read()
 
         if( level == 0 )
         {
-            std::list< size_t > indices;
+            WFiberCluster::IndexList indices;
             // start after ( level (
             size_t k = 3;
             while( svec[k] != ")" && svec[k] != "" )
@@ -124,7 +125,7 @@ std::shared_ptr< WDataSetHierarchicalClustering > WReaderClustering::read()
         }
         else
         {
-            std::list< size_t > indices;
+            WFiberCluster::IndexList indices;
             // start after ( level (
             size_t k = 3;
             while( svec[k] != ")" )
@@ -32,6 +32,7 @@
 #include "core/common/WAssert.h"
 #include "core/common/WException.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WEEG.h"
 #include "core/dataHandler/WSubject.h"
 
@@ -42,6 +43,7 @@ WReaderEEGASCII::WReaderEEGASCII( std::string fileName )
 
 std::shared_ptr< WDataSet > WReaderEEGASCII::load()
 {
+    WTRACE_SCOPE( "WReaderEEGASCII::load" );
     std::ifstream in( m_fname.c_str() );
     if( in.fail() )
         throw WException( std::string( "Could not read file \"" + m_fname + "\"" ) );
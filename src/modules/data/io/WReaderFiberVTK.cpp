@@ -36,6 +36,7 @@
 #include "core/common/WLimits.h"
 #include "core/common/WLogger.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WDataSetFibers.h"
 #include "core/dataHandler/exceptions/WDHIOFailure.h"
 #include "core/dataHandler/exceptions/WDHNoSuchFile.h"
@@ -52,6 +53,7 @@ WReaderFiberVTK::~WReaderFiberVTK() throw()
 
 std::shared_ptr< WDataSetFibers > WReaderFiberVTK::read()
 {
+    WTRACE_SCOPE( "WReaderFiberVTK::read" );
     m_ifs = std::shared_ptr< std::ifstream >( new std::ifstream() );
     m_ifs->open( m_fname.c_str(), std::ifstream::in | std::ifstream::binary );
     if( !m_ifs || m_ifs->bad() )
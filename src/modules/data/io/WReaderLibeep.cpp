@@ -35,6 +35,7 @@ extern "C"
 
 #include "WReaderLibeep.h"
 #include "core/common/WLogger.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WEEG.h"
 #include "core/dataHandler/exceptions/WDHNoSuchFile.h"
 
@@ -45,6 +46,7 @@ WReaderLibeep::WReaderLibeep( std::string fileName )
 
 std::shared_ptr< WDataSet > WReaderLibeep::load()
 {
+    WTRACE_SCOPE( "WReaderLibeep::load" );
     wlog::debug( "Libeep Reader" ) << "Opening " << m_fname;
 
     // libeep needs the standard C locale to load float values from ASCII
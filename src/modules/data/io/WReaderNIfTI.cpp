@@ -33,6 +33,7 @@
 #include "WReaderNIfTI.h"
 #include "core/common/WIOTools.h"
 #include "core/common/WLogger.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WDataHandlerEnums.h"
 #include "core/dataHandler/WDataSet.h"
 #include "core/dataHandler/WDataSetDTI.h"
@@ -209,6 +210,7 @@ WReaderNIfTI::BValues WReaderNIfTI::readBValuesIfAvailable( unsigned int vDim )
 
 std::shared_ptr< WDataSet > WReaderNIfTI::load( DataSetType dataSetType )
 {
+    WTRACE_SCOPE( "WReaderNIfTI::load" );
     std::shared_ptr< nifti_image > filedata( nifti_image_read( m_fname.c_str(), 1 ), &nifti_image_free );
 
     WAssert( filedata, "Error during file access to NIfTI file. This probably means that the file is corrupted." );
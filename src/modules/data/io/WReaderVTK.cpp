@@ -36,6 +36,7 @@
 #include "core/common/WLimits.h"
 #include "core/common/WLogger.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WDataSet.h"
 #include "core/dataHandler/WDataSetDTI.h"
 #include "core/dataHandler/WDataSetRawHARDI.h"
@@ -57,6 +58,7 @@ WReaderVTK::~WReaderVTK() throw()
 
 std::shared_ptr< WDataSet > WReaderVTK::read()
 {
+    WTRACE_SCOPE( "WReaderVTK::read" );
     std::shared_ptr< WDataSet > ds;
 
     m_ifs = std::shared_ptr< std::ifstream >( new std::ifstream() );
@@ -25,7 +25,9 @@
 #ifndef WREADERCSV_TEST_H
 #define WREADERCSV_TEST_H
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 #include <cxxtest/TestSuite.h>
 
@@ -127,6 +129,47 @@ public:
         // compare last data rows
         TS_ASSERT_EQUALS( tmpCsvReader.read()->getData()->back(), testDataLastRow->front() );
     }
+
+    /**
+     * The string representation reproduces the lines of the file.
+     */
+    void testRawDataSet()
+    {
+        std::string fileName = W_FIXTURE_PATH + "CSVs/valid.csv";
+        std::vector< std::string > lines;
+        std::ifstream file( fileName.c_str() );
+        std::string line;
+        while( std::getline( file, line ) )
+        {
+            lines.push_back( line );
+        }
+
+        std::shared_ptr< WDataSetCSV > csv = WReaderCSV( fileName ).read();
+        TS_ASSERT_EQUALS( *csv->getRawDataSet(), lines );
+        TS_ASSERT_EQUALS( csv->getData()->size(), lines.size() - 1 );
+    }
+
+    /**
+     * Large integers and numbers with many digits in columns with missing values are read exactly, the strings keep their text.
+     */
+    void testLargeNumbers()
+    {
+        std::string fileName = W_FIXTURE_PATH + "CSVs/largeNumbers.csv";
+        std::shared_ptr< WDataSetCSV > csv = WReaderCSV( fileName ).read();
+
+        WDataSetCSV::Columns const& columns = csv->getColumns();
+        TS_ASSERT_EQUALS( columns.size(), 3 );
+        TS_ASSERT_EQUALS( columns[ 0 ]->getType(), WCSVColumn::COLUMN_DOUBLE );
+        TS_ASSERT_EQUALS( columns[ 0 ]->getNumber( 0 ), 1000020040.0 );
+        TS_ASSERT( columns[ 0 ]->isMissing( 1 ) );
+        TS_ASSERT_EQUALS( columns[ 1 ]->getNumber( 0 ), 0.123456789012345 );
+        TS_ASSERT_EQUALS( columns[ 1 ]->getNumber( 2 ), 12345678.9 );
+
+        TS_ASSERT_EQUALS( csv->getData()->at( 0 ).at( 0 ), "1000020040" );
+        TS_ASSERT_EQUALS( csv->getData()->at( 1 ).at( 0 ), "" );
+        TS_ASSERT_EQUALS( csv->getData()->at( 1 ).at( 1 ), "1e-3" );
+        TS_ASSERT_EQUALS( csv->getRawDataSet()->at( 2 ), ",1e-3,NULL" );
+    }
 };
 
 #endif  // WREADERCSV_TEST_H
@@ -31,6 +31,7 @@
 #include "WMDeterministicFTMori.xpm"
 #include "core/common/WAssert.h"
 #include "core/common/math/WLinearAlgebraFunctions.h"
+#include "core/common/math/WTensorEigenBatch.h"
 #include "core/common/math/WTensorFunctions.h"
 #include "core/common/math/WTensorSym.h"
 #include "core/dataHandler/WDataSetFiberVector.h"
@@ -377,7 +378,7 @@ boost::array< double, 4 > const WMDeterministicFTMori::computeFaAndEigenVec( WTe
     std::vector< WVector3d > t( 3 );
 
     // calc eigenvectors
-    jacobiEigenvector3D( m, &eigenSys );
+    cardanoEigenvector3D( m, &eigenSys );
 
     // find the eigenvector with largest absolute eigenvalue
     int u = 0;
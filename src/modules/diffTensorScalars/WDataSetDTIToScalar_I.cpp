@@ -51,7 +51,7 @@ WDataSetScalar::SPtr WDataSetDTIToScalar_I::operator()( WProgress::SPtr progress
 
     for( unsigned int i = 0; i < grid->size() && !shutdown; ++i )
     {
-        WTensorSym< 2, 3, float > tensor( t->getWValue( i ) );
+        WTensorSym< 2, 3, float > tensor( t->getValueView< 6 >( i ).toTensorSym< 2, 3 >() );
         WVector3d ev = evals->getVectorAt( i );
         (*data)[i] = tensorToScalar( ev, tensor );
         ++*progress;
@@ -26,6 +26,7 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <osg/Array>
 #include <osg/Drawable>
@@ -44,12 +45,16 @@ WLineStripCallback::WLineStripCallback( std::size_t channelID,
                                         WPropDouble timePos,
                                         WPropDouble timeRange,
                                         std::shared_ptr< WEEG2Segment > segment,
-                                        double samplingRate )
+                                        double samplingRate,
+                                        WPropInt graphWidth )
     : m_channelID( channelID ),
       m_currentTimePos( 0.0 ),
       m_currentTimeRange( -1.0 ),
+      m_currentGraphWidth( 0 ),
+      m_currentDecimated( false ),
       m_timePos( timePos ),
       m_timeRange( timeRange ),
+      m_graphWidth( graphWidth ),
       m_segment( segment ),
       m_samplingRate( samplingRate )
 {
@@ -59,8 +64,9 @@ void WLineStripCallback::update( osg::NodeVisitor* /*nv*/, osg::Drawable* drawab
 {
     const double timePos = m_timePos->get();
     const double timeRange = m_timeRange->get();
+    const int graphWidth = m_graphWidth->get();
 
-    if( timePos != m_currentTimePos || timeRange != m_currentTimeRange )
+    if( timePos != m_currentTimePos || timeRange != m_currentTimeRange || graphWidth != m_currentGraphWidth )
     {
         osg::Geometry* geometry = static_cast< osg::Geometry* >( drawable );
         if( geometry )
@@ -71,7 +77,33 @@ void WLineStripCallback::update( osg::NodeVisitor* /*nv*/, osg::Drawable* drawab
                                                         startSample,
                                                         nbSamples );
             const std::size_t currentStartSample = clampToRange( m_currentTimePos * m_samplingRate, 0u, nbSamples - 1u );
-            const std::size_t currentEndSample = ( 0.0 <= m_currentTimeRange ) ?
+            const std::size_t maxPoints = 2 * static_cast< std::size_t >( std::max( graphWidth, 1 ) );
+
+            // more samples than pixels: draw the minimum and maximum of the samples of every pixel
+            if( endSample - startSample > maxPoints )
+            {
+                m_segment->getMinMaxValues( m_channelID, startSample, endSample - startSample, maxPoints,
+                                            &m_envelopeSamples, &m_envelopeValues );
+                osg::Vec3Array* vertices = new osg::Vec3Array();
+                vertices->reserve( m_envelopeSamples.size() );
+                for( std::size_t i = 0; i < m_envelopeSamples.size(); ++i )
+                {
+                    vertices->push_back( osg::Vec3( m_envelopeSamples[i] / m_samplingRate, m_envelopeValues[i], -0.001 ) );
+                }
+                geometry->setVertexArray( vertices );
+
+                osg::DrawArrays* primitiveSet = static_cast< osg::DrawArrays* >( geometry->getPrimitiveSet( 0 ) );
+                primitiveSet->setCount( vertices->size() );
+
+                m_currentTimePos = timePos;
+                m_currentTimeRange = timeRange;
+                m_currentGraphWidth = graphWidth;
+                m_currentDecimated = true;
+                return;
+            }
+
+            // the vertices of an envelope can not be reused
+            const std::size_t currentEndSample = ( 0.0 <= m_currentTimeRange && !m_currentDecimated ) ?
                     clampToRange( std::ceil( ( m_currentTimePos + m_currentTimeRange ) * m_samplingRate ) + 1.0,
                                   currentStartSample,
                                   nbSamples ) :
@@ -125,6 +157,8 @@ void WLineStripCallback::update( osg::NodeVisitor* /*nv*/, osg::Drawable* drawab
 
         m_currentTimePos = timePos;
         m_currentTimeRange = timeRange;
+        m_currentGraphWidth = graphWidth;
+        m_currentDecimated = false;
     }
 }
 
@@ -27,6 +27,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <osg/Drawable>
 #include <osg/NodeVisitor>
@@ -51,12 +52,15 @@ public:
      * \param timeRange    the width of the graph in seconds as property
      * \param segment      pointer to the EEG segment
      * \param samplingRate sampling rate used by the recording
+     * \param graphWidth   the width of the graph in pixels as property, wider
+     *                     time ranges are drawn as min/max envelope
      */
     WLineStripCallback( std::size_t channelID,
                         WPropDouble timePos,
                         WPropDouble timeRange,
                         std::shared_ptr< WEEG2Segment > segment,
-                        double samplingRate );
+                        double samplingRate,
+                        WPropInt graphWidth );
 
     /**
      * Callback method called by the NodeVisitor.
@@ -85,6 +89,17 @@ private:
      */
     double m_currentTimeRange;
 
+    /**
+     * the width of the graph in pixels which is currently used
+     */
+    int m_currentGraphWidth;
+
+    /**
+     * whether the current vertices are a min/max envelope instead of one
+     * vertex per sample
+     */
+    bool m_currentDecimated;
+
     /**
      * the time position in seconds where to start the graph at the left edge as
      * property
@@ -96,6 +111,11 @@ private:
      */
     WPropDouble m_timeRange;
 
+    /**
+     * the width of the graph in pixels as property
+     */
+    WPropInt m_graphWidth;
+
     /**
      * pointer to the EEG segment
      */
@@ -106,6 +126,16 @@ private:
      */
     double m_samplingRate;
 
+    /**
+     * sample positions of the min/max envelope, reused between updates
+     */
+    std::vector< double > m_envelopeSamples;
+
+    /**
+     * values of the min/max envelope, reused between updates
+     */
+    std::vector< double > m_envelopeValues;
+
     /**
      * Convert the given double value to std::size_t and clamp it into the given
      * range
@@ -579,7 +579,7 @@ void WMEEGView::redraw()
             geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, 0 ) );
 
             geometry->setDataVariance( osg::Object::DYNAMIC );
-            geometry->setUpdateCallback( new WLineStripCallback( channelID, m_timePos, m_timeRange, segment, rate ) );
+            geometry->setUpdateCallback( new WLineStripCallback( channelID, m_timePos, m_timeRange, segment, rate, m_graphWidth ) );
 
             osg::Geode* linesGeode = new osg::Geode;
             linesGeode->addDrawable( geometry );
@@ -0,0 +1,116 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2009 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WCARDANOEIGENFUNCTION_H
+#define WCARDANOEIGENFUNCTION_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "core/common/WFlag.h"
+#include "core/common/WProgress.h"
+#include "core/common/math/WTensorEigenBatch.h"
+#include "core/dataHandler/WDataSetSingle.h"
+#include "core/dataHandler/WValueSet.h"
+
+/**
+ * Threaded function computing the eigen systems of a whole tensor field with cardanoEigenSystemBatch(). Every thread
+ * processes a contiguous range of voxels in chunks and writes directly into the interleaved output format that is also
+ * produced by the per-voxel strategies: ev, evec, ev, evec, ev, evec ( 12 doubles per voxel ).
+ *
+ * To be used with WThreadedFunction.
+ */
+template< typename Value_T >
+class WCardanoEigenFunction
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param tensors The tensor dataset, 6 components per voxel.
+     * \param progress Incremented once per voxel.
+     */
+    WCardanoEigenFunction( std::shared_ptr< WDataSetSingle const > tensors, std::shared_ptr< WProgress > progress )
+        : m_tensors( tensors ),
+          m_input( std::dynamic_pointer_cast< WValueSet< Value_T > const >( tensors->getValueSet() ) ),
+          m_output( new std::vector< double >( m_input->size() * 12 ) ),
+          m_progress( progress )
+    {
+    }
+
+    /**
+     * Decomposes the part of the field belonging to this thread.
+     *
+     * \param id The number of this thread.
+     * \param mx The number of threads.
+     * \param stop Set if the computation should be stopped.
+     */
+    void operator()( std::size_t id, std::size_t mx, WBoolFlag const& stop )
+    {
+        std::size_t const n = m_input->size();
+        std::size_t const begin = n * id / mx;
+        std::size_t const end = n * ( id + 1 ) / mx;
+
+        Value_T const* in = m_input->rawData();
+        double* out = &( *m_output )[ 0 ];
+        WTensorSymBlock< Value_T > tensors = { { in, in + 1, in + 2, in + 3, in + 4, in + 5 }, 6 }; // NOLINT curly braces
+        WEigenSystemBlock< double > result = { { out, out + 4, out + 8 }, 12, { out + 1, out + 5, out + 9 }, 12 }; // NOLINT curly braces
+
+        // keep the chunks small enough to react to stop requests quickly
+        std::size_t const chunkSize = 16384;
+        for( std::size_t chunk = begin; chunk < end && !stop(); chunk += chunkSize )
+        {
+            std::size_t const chunkEnd = std::min( chunk + chunkSize, end );
+            cardanoEigenSystemBatch( chunk, chunkEnd, tensors, result );
+            m_progress->increment( chunkEnd - chunk );
+        }
+    }
+
+    /**
+     * Get the resulting eigen systems.
+     *
+     * \return A dataset with 12 doubles per voxel.
+     */
+    std::shared_ptr< WDataSetSingle > getResult()
+    {
+        std::shared_ptr< WValueSet< double > > values( new WValueSet< double >( 1, 12, m_output, W_DT_DOUBLE ) );
+        return std::shared_ptr< WDataSetSingle >( new WDataSetSingle( values, m_tensors->getGrid() ) );
+    }
+
+private:
+    //! the input dataset
+    std::shared_ptr< WDataSetSingle const > m_tensors;
+
+    //! the tensor values
+    std::shared_ptr< WValueSet< Value_T > const > m_input;
+
+    //! the eigen systems
+    std::shared_ptr< std::vector< double > > m_output;
+
+    //! the progress of the computation
+    std::shared_ptr< WProgress > m_progress;
+};
+
+#endif  // WCARDANOEIGENFUNCTION_H
@@ -93,6 +93,7 @@ void WMEigenSystem::properties()
     std::shared_ptr< WItemSelection > strategies( new WItemSelection() );
     strategies->addItem( "LibEigen", "Eigensystem is computed via libEigen and its SelfAdjointEigenSolver" );
     strategies->addItem( "Jacobi", "Self implemented Jacobi iterative eigen decomposition" );
+    strategies->addItem( "Cardano", "Closed form eigen decomposition, processing blocks of tensors at once" );
     m_strategySelector = m_properties->addProperty( "Strategy", "How the eigen system should be computed",
             strategies->getSelectorFirst() );
 
@@ -131,12 +132,13 @@ void WMEigenSystem::moduleMain()
         {
             // start the eigenvector computation if input is DTI double or float otherwise continue
             // when the computation finishes, we'll be notified by the threadspool's threadsDoneCondition
+            resetProgress( tensors->getValueSet()->size(), "Compute eigen system" );
             resetEigenFunction( tensors );
             if( !m_eigenPool )
             {
+                m_currentProgress->finish();
                 continue;
             }
-            resetProgress( tensors->getValueSet()->size(), "Compute eigen system" );
             m_eigenPool->run();
             infoLog() << "Computing eigen systems...";
         }
@@ -144,9 +146,18 @@ void WMEigenSystem::moduleMain()
         {
             // the computation of the eigenvectors has finished we have a new field of eigen systems
             m_currentProgress->finish();
-            WAssert( m_eigenOperationFloat || m_eigenOperationDouble, "Bug: No result is available. Checked double and float!" );
+            WAssert( m_eigenOperationFloat || m_eigenOperationDouble || m_cardanoOperationFloat || m_cardanoOperationDouble,
+                     "Bug: No result is available. Checked double and float!" );
 
-            if( tensors->getValueSet()->getDataType() == W_DT_DOUBLE )
+            if( m_cardanoOperationDouble )
+            {
+                updateOCs( m_cardanoOperationDouble->getResult() );
+            }
+            else if( m_cardanoOperationFloat )
+            {
+                updateOCs( m_cardanoOperationFloat->getResult() );
+            }
+            else if( tensors->getValueSet()->getDataType() == W_DT_DOUBLE )
             {
                 updateOCs( m_eigenOperationDouble->getResult() );
             }
@@ -181,7 +192,7 @@ void WMEigenSystem::updateOCs( std::shared_ptr< const WDataSetSingle > es )
 
     for( size_t i = 0; i < vs->size(); ++i )
     {
-        WValue< double > sys = vs->getWValue( i );
+        WValueView< double, 12 > sys = vs->getValueView< 12 >( i );
         // eigenvalues
         ( *vecdata[0] )[ i * 3 ] = sys[0];
         ( *valdata[0] )[ i ] = sys[0];
@@ -329,6 +340,8 @@ void WMEigenSystem::resetEigenFunction( std::shared_ptr< WDataSetDTI > tensors )
 
     m_eigenOperationFloat = std::shared_ptr< TPVOFloat >();
     m_eigenOperationDouble = std::shared_ptr< TPVODouble >();
+    m_cardanoOperationFloat = std::shared_ptr< CardanoFloat >();
+    m_cardanoOperationDouble = std::shared_ptr< CardanoDouble >();
 
     // create a new one
     if( tensors->getValueSet()->getDataType() == W_DT_DOUBLE )
@@ -341,6 +354,13 @@ void WMEigenSystem::resetEigenFunction( std::shared_ptr< WDataSetDTI > tensors )
         {
             m_eigenOperationDouble = std::shared_ptr< TPVODouble >( new TPVODouble( tensors, boost::bind( &WMEigenSystem::eigenFuncDouble, this, boost::placeholders::_1 ) ) ); // NOLINT line length
         }
+        else if( m_strategySelector->get().at( 0 )->getName() == "Cardano" )
+        {
+            m_cardanoOperationDouble = std::shared_ptr< CardanoDouble >( new CardanoDouble( tensors, m_currentProgress ) );
+            m_eigenPool = std::shared_ptr< WThreadedFunctionBase >( new WThreadedFunction< CardanoDouble >( W_AUTOMATIC_NB_THREADS, m_cardanoOperationDouble ) ); // NOLINT line length
+            m_moduleState.add( m_eigenPool->getThreadsDoneCondition() );
+            return;
+        }
         else
         {
             WAssert( 0, "Bug: Invalid strategy for eigen decomposition selected!" );
@@ -358,6 +378,13 @@ void WMEigenSystem::resetEigenFunction( std::shared_ptr< WDataSetDTI > tensors )
         {
             m_eigenOperationFloat = std::shared_ptr< TPVOFloat >( new TPVOFloat( tensors, boost::bind( &WMEigenSystem::eigenFuncFloat, this, boost::placeholders::_1 ) ) ); // NOLINT line length
         }
+        else if( m_strategySelector->get().at( 0 )->getName() == "Cardano" )
+        {
+            m_cardanoOperationFloat = std::shared_ptr< CardanoFloat >( new CardanoFloat( tensors, m_currentProgress ) );
+            m_eigenPool = std::shared_ptr< WThreadedFunctionBase >( new WThreadedFunction< CardanoFloat >( W_AUTOMATIC_NB_THREADS, m_cardanoOperationFloat ) ); // NOLINT line length
+            m_moduleState.add( m_eigenPool->getThreadsDoneCondition() );
+            return;
+        }
         else
         {
             WAssert( 0, "Bug: Invalid strategy for eigen decomposition selected!" );
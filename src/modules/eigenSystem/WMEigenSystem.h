@@ -38,6 +38,7 @@
 #include "core/dataHandler/WThreadedPerVoxelOperation.h"
 #include "core/dataHandler/WThreadedTrackingFunction.h"
 #include "core/kernel/WModule.h"
+#include "WCardanoEigenFunction.h"
 
 // forward declaration
 class WDataSetDTI;
@@ -124,6 +125,12 @@ private:
     //! the thread pool type for the eigencomputation (double input)
     typedef WThreadedFunction< TPVODouble > EigenFunctionTypeDouble;
 
+    //! the batched closed form eigen decomposition (float input)
+    typedef WCardanoEigenFunction< float > CardanoFloat;
+
+    //! the batched closed form eigen decomposition (double input)
+    typedef WCardanoEigenFunction< double > CardanoDouble;
+
     //! the valueset type
     typedef WValueSet< double > FloatValueSetType;
 
@@ -236,6 +243,12 @@ private:
     //! the functor used for the calculation of the eigenvectors
     std::shared_ptr< TPVODouble > m_eigenOperationDouble;
 
+    //! the functor used for the batched calculation of the eigenvectors
+    std::shared_ptr< CardanoFloat > m_cardanoOperationFloat;
+
+    //! the functor used for the batched calculation of the eigenvectors
+    std::shared_ptr< CardanoDouble > m_cardanoOperationDouble;
+
     /**
      * Indicating current work progress.
      */
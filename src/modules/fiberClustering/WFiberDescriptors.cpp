@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/common/WAssert.h"
+#include "core/dataHandler/WFiberView.h"
+#include "WFiberDescriptors.h"
+
+WFiberDescriptors::WFiberDescriptors( WDataSetFibers const& fibers, std::size_t nbPoints )
+    : m_nbPoints( nbPoints )
+{
+    WAssert( nbPoints >= 2, "Fiber descriptors need at least two points." );
+
+    WFiberConstView const view = createFiberView( fibers );
+    m_coordinates.resize( 3 * nbPoints * view.size() );
+    m_boxes.resize( 6 * view.size() );
+
+    forEachFiberBlock( view.size(), [ this, &view ]( std::size_t begin, std::size_t end )
+    {
+        std::vector< float > points( 3 * m_nbPoints );
+        std::vector< double > arcLength;
+        WFiberSpan const resampled( &points[ 0 ], m_nbPoints );
+        for( std::size_t fiber = begin; fiber < end; ++fiber )
+        {
+            if( view.getLength( fiber ) == 0 )
+            {
+                std::fill( points.begin(), points.end(), 0.0f );
+            }
+            else
+            {
+                resampleByNumberOfPoints( view[ fiber ], resampled, &arcLength );
+            }
+
+            float* coordinates = &m_coordinates[ 3 * m_nbPoints * fiber ];
+            float* box = &m_boxes[ 6 * fiber ];
+            for( std::size_t c = 0; c < 3; ++c )
+            {
+                box[ c ] = std::numeric_limits< float >::max();
+                box[ c + 3 ] = -std::numeric_limits< float >::max();
+                for( std::size_t i = 0; i < m_nbPoints; ++i )
+                {
+                    float const value = points[ 3 * i + c ];
+                    coordinates[ c * m_nbPoints + i ] = value;
+                    box[ c ] = std::min( box[ c ], value );
+                    box[ c + 3 ] = std::max( box[ c + 3 ], value );
+                }
+            }
+        }
+    } );
+}
+
+double WFiberDescriptors::getBoxDistance( std::size_t q, std::size_t r ) const
+{
+    double distanceSquare = 0.0;
+    for( std::size_t c = 0; c < 3; ++c )
+    {
+        double const gap = std::max( std::max( getMin( r )[ c ] - getMax( q )[ c ], getMin( q )[ c ] - getMax( r )[ c ] ), 0.0f );
+        distanceSquare += gap * gap;
+    }
+    return std::sqrt( distanceSquare );
+}
+
+double WFiberDescriptors::distDST( double thresholdSquare, std::size_t q, std::size_t r, double bound ) const
+{
+    double const limit = bound * m_nbPoints;
+    double const qr = sumOfMinimalDistances( thresholdSquare, ( *this )[ q ], ( *this )[ r ], limit );
+    // the other direction is only needed if it is smaller
+    double const rq = sumOfMinimalDistances( thresholdSquare, ( *this )[ r ], ( *this )[ q ], std::min( limit, qr ) );
+    double const sum = std::min( qr, rq );
+    return sum > limit ? std::numeric_limits< double >::infinity() : sum / m_nbPoints;
+}
+
+double WFiberDescriptors::distDLT( double thresholdSquare, std::size_t q, std::size_t r, double bound ) const
+{
+    double const limit = bound * m_nbPoints;
+    double const qr = sumOfMinimalDistances( thresholdSquare, ( *this )[ q ], ( *this )[ r ], limit );
+    if( qr > limit )
+    {
+        return std::numeric_limits< double >::infinity();
+    }
+    double const rq = sumOfMinimalDistances( thresholdSquare, ( *this )[ r ], ( *this )[ q ], limit );
+    if( rq > limit )
+    {
+        return std::numeric_limits< double >::infinity();
+    }
+    return std::max( qr, rq ) / m_nbPoints;
+}
+
+double WFiberDescriptors::sumOfMinimalDistances( double thresholdSquare, float const* q, float const* r, double limit ) const
+{
+    std::size_t const n = m_nbPoints;
+    float const* rx = r;
+    float const* ry = r + n;
+    float const* rz = r + 2 * n;
+
+    double sum = 0.0;
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        float const x = q[ i ];
+        float const y = q[ n + i ];
+        float const z = q[ 2 * n + i ];
+
+        // the iterations only depend on each other through the minimum, so the loop is vectorized as a reduction
+        float minimum = std::numeric_limits< float >::max();
+        #pragma omp simd reduction( min : minimum )
+        for( std::size_t j = 0; j < n; ++j )
+        {
+            float const dx = rx[ j ] - x;
+            float const dy = ry[ j ] - y;
+            float const dz = rz[ j ] - z;
+            float const d = dx * dx + dy * dy + dz * dz;
+            minimum = std::min( d, minimum );
+        }
+
+        if( minimum > thresholdSquare )
+        {
+            sum += std::sqrt( static_cast< double >( minimum ) );
+            if( sum > limit )
+            {
+                return std::numeric_limits< double >::infinity();
+            }
+        }
+    }
+    return sum;
+}
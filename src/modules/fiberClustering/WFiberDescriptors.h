@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERDESCRIPTORS_H
+#define WFIBERDESCRIPTORS_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/dataHandler/WDataSetFibers.h"
+
+/**
+ * Fibers resampled to the same number of points at equal arc length distances, stored in one flat array. The coordinates of
+ * a fiber are stored as all x, then all y, then all z values so the distance kernels can be vectorized.
+ *
+ * The thresholded distances of Zhang (see WFiber::distDST() and WFiber::distDLT()) between two descriptors cost
+ * O( nbPoints^2 ) regardless of the number of vertices of the fibers. They take a bound and stop as soon as the distance is
+ * known to exceed it, the bounding boxes of the fibers give a lower bound to prune pairs without evaluating the kernel.
+ */
+class WFiberDescriptors
+{
+public:
+    /**
+     * Shared pointer abbreviation.
+     */
+    typedef std::shared_ptr< WFiberDescriptors > SPtr;
+
+    /**
+     * Const shared pointer abbreviation.
+     */
+    typedef std::shared_ptr< const WFiberDescriptors > ConstSPtr;
+
+    /**
+     * Resamples all fibers in parallel. Fibers without vertices get all points at the origin.
+     *
+     * \param fibers The fibers.
+     * \param nbPoints The number of points per descriptor, at least two.
+     */
+    WFiberDescriptors( WDataSetFibers const& fibers, std::size_t nbPoints );
+
+    /**
+     * The number of fibers.
+     *
+     * \return The number of descriptors.
+     */
+    std::size_t size() const;
+
+    /**
+     * The number of points of each descriptor.
+     *
+     * \return The number of points.
+     */
+    std::size_t getNbPoints() const;
+
+    /**
+     * The coordinates of a descriptor, first the x coordinates of all points, then the y and then the z coordinates.
+     *
+     * \param fiber The index of the fiber.
+     *
+     * \return 3 * getNbPoints() values.
+     */
+    float const* operator[]( std::size_t fiber ) const;
+
+    /**
+     * The corner of the bounding box of a descriptor with the smallest coordinates.
+     *
+     * \param fiber The index of the fiber.
+     *
+     * \return x, y and z.
+     */
+    float const* getMin( std::size_t fiber ) const;
+
+    /**
+     * The corner of the bounding box of a descriptor with the largest coordinates.
+     *
+     * \param fiber The index of the fiber.
+     *
+     * \return x, y and z.
+     */
+    float const* getMax( std::size_t fiber ) const;
+
+    /**
+     * The euclidean distance between the bounding boxes of two descriptors. Every point of one descriptor is at least this
+     * far away from the other one, so both thresholded distances are at least as large if it exceeds the proximity threshold.
+     *
+     * \param q The index of the first fiber.
+     * \param r The index of the second fiber.
+     *
+     * \return The distance, zero if the boxes overlap.
+     */
+    double getBoxDistance( std::size_t q, std::size_t r ) const;
+
+    /**
+     * The smaller thresholded distance of Zhang between two descriptors, see WFiber::distDST().
+     *
+     * \param thresholdSquare Point distances up to the root of this are ignored.
+     * \param q The index of the first fiber.
+     * \param r The index of the second fiber.
+     * \param bound The evaluation stops as soon as the distance is known to be larger than this.
+     *
+     * \return The distance, or infinity if it is larger than bound.
+     */
+    double distDST( double thresholdSquare, std::size_t q, std::size_t r, double bound ) const;
+
+    /**
+     * The larger thresholded distance of Zhang between two descriptors, see WFiber::distDLT().
+     *
+     * \param thresholdSquare Point distances up to the root of this are ignored.
+     * \param q The index of the first fiber.
+     * \param r The index of the second fiber.
+     * \param bound The evaluation stops as soon as the distance is known to be larger than this.
+     *
+     * \return The distance, or infinity if it is larger than bound.
+     */
+    double distDLT( double thresholdSquare, std::size_t q, std::size_t r, double bound ) const;
+
+private:
+    /**
+     * The sum of the thresholded distances of each point of q to the nearest point of r, i.e. dt( q, r ) * getNbPoints().
+     *
+     * \param thresholdSquare Point distances up to the root of this are ignored.
+     * \param q The coordinates of the first descriptor.
+     * \param r The coordinates of the second descriptor.
+     * \param limit The summation stops as soon as this is exceeded.
+     *
+     * \return The sum, or infinity if it is larger than limit.
+     */
+    double sumOfMinimalDistances( double thresholdSquare, float const* q, float const* r, double limit ) const;
+
+    //! the number of points of each descriptor
+    std::size_t m_nbPoints;
+
+    //! the coordinates of all descriptors
+    std::vector< float > m_coordinates;
+
+    //! the bounding boxes, minimum and maximum corner of each descriptor
+    std::vector< float > m_boxes;
+};
+
+inline std::size_t WFiberDescriptors::size() const
+{
+    return m_boxes.size() / 6;
+}
+
+inline std::size_t WFiberDescriptors::getNbPoints() const
+{
+    return m_nbPoints;
+}
+
+inline float const* WFiberDescriptors::operator[]( std::size_t fiber ) const
+{
+    return &m_coordinates[ 3 * m_nbPoints * fiber ];
+}
+
+inline float const* WFiberDescriptors::getMin( std::size_t fiber ) const
+{
+    return &m_boxes[ 6 * fiber ];
+}
+
+inline float const* WFiberDescriptors::getMax( std::size_t fiber ) const
+{
+    return &m_boxes[ 6 * fiber + 3 ];
+}
+
+#endif  // WFIBERDESCRIPTORS_H
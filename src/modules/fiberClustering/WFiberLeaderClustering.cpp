@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/common/WColor.h"
+#include "core/common/datastructures/WUnionFind.h"
+#include "core/dataHandler/WFiberView.h"
+#include "WFiberLeaderClustering.h"
+
+namespace
+{
+    //! marks fibers without a cluster
+    std::size_t const NO_CLUSTER = std::numeric_limits< std::size_t >::max();
+
+    //! the number of fibers compared with the leaders in parallel before new leaders are added
+    std::size_t const BATCH_SIZE = 4096;
+
+    //! the largest number of grid cells along an axis
+    std::size_t const MAX_GRID_SIZE = 64;
+}
+
+WFiberLeaderClustering::WFiberLeaderClustering( WFiberDescriptors::ConstSPtr descriptors, double proximityThreshold,
+                                                double clusterDistance, bool larger )
+    : m_descriptors( descriptors ),
+      m_thresholdSquare( proximityThreshold * proximityThreshold ),
+      m_clusterDistance( clusterDistance ),
+      m_larger( larger ),
+      m_pruneDistance( std::max( proximityThreshold, clusterDistance ) )
+{
+    // the grid covers all bounding boxes, positions outside are clamped to the border cells
+    double lower[ 3 ] = { 0.0, 0.0, 0.0 }; // NOLINT curly braces
+    double upper[ 3 ] = { 0.0, 0.0, 0.0 }; // NOLINT curly braces
+    for( std::size_t c = 0; c < 3; ++c )
+    {
+        if( m_descriptors->size() > 0 )
+        {
+            lower[ c ] = m_descriptors->getMin( 0 )[ c ];
+            upper[ c ] = m_descriptors->getMax( 0 )[ c ];
+        }
+    }
+    for( std::size_t fiber = 0; fiber < m_descriptors->size(); ++fiber )
+    {
+        for( std::size_t c = 0; c < 3; ++c )
+        {
+            lower[ c ] = std::min( lower[ c ], static_cast< double >( m_descriptors->getMin( fiber )[ c ] ) );
+            upper[ c ] = std::max( upper[ c ], static_cast< double >( m_descriptors->getMax( fiber )[ c ] ) );
+        }
+    }
+
+    // cells smaller than the prune distance would only add cells to visit
+    std::size_t nbCells = 1;
+    for( std::size_t c = 0; c < 3; ++c )
+    {
+        double const range = upper[ c ] - lower[ c ];
+        m_gridOrigin[ c ] = lower[ c ];
+        m_gridSize[ c ] = 1;
+        if( m_pruneDistance > 0.0 )
+        {
+            m_gridSize[ c ] = std::min( MAX_GRID_SIZE, static_cast< std::size_t >( std::ceil( range / m_pruneDistance ) ) );
+            m_gridSize[ c ] = std::max< std::size_t >( m_gridSize[ c ], 1 );
+        }
+        m_cellSize[ c ] = range > 0.0 ? range / m_gridSize[ c ] : 1.0;
+        nbCells *= m_gridSize[ c ];
+    }
+    m_grid.resize( nbCells );
+}
+
+bool WFiberLeaderClustering::compute( WProgress::SPtr progress, WBoolFlag const& shutdown )
+{
+    std::size_t const nbFibers = m_descriptors->size();
+    m_clusterIndexes.assign( nbFibers, NO_CLUSTER );
+    m_leaders.clear();
+    m_leaderCells.clear();
+    for( std::size_t cell = 0; cell < m_grid.size(); ++cell )
+    {
+        m_grid[ cell ].clear();
+    }
+
+    std::vector< std::size_t > leaders( BATCH_SIZE );
+    std::vector< double > distances( BATCH_SIZE );
+    for( std::size_t begin = 0; begin < nbFibers; begin += BATCH_SIZE )
+    {
+        if( shutdown() )
+        {
+            return false;
+        }
+
+        std::size_t const end = std::min( begin + BATCH_SIZE, nbFibers );
+        std::size_t const firstNewLeader = m_leaders.size();
+
+        // the leaders of the previous batches do not change while the batch is compared with them
+        forEachFiberBlock( end - begin, [ this, begin, &leaders, &distances ]( std::size_t blockBegin, std::size_t blockEnd )
+        {
+            for( std::size_t i = blockBegin; i < blockEnd; ++i )
+            {
+                leaders[ i ] = NO_CLUSTER;
+                distances[ i ] = std::numeric_limits< double >::infinity();
+                findNearestLeader( begin + i, 0, &leaders[ i ], &distances[ i ] );
+            }
+        } );
+
+        for( std::size_t fiber = begin; fiber < end; ++fiber )
+        {
+            std::size_t leader = leaders[ fiber - begin ];
+            double distance = distances[ fiber - begin ];
+            findNearestLeader( fiber, firstNewLeader, &leader, &distance );
+            m_clusterIndexes[ fiber ] = leader == NO_CLUSTER ? addLeader( fiber ) : leader;
+        }
+
+        progress->increment( end - begin );
+    }
+    return true;
+}
+
+std::size_t WFiberLeaderClustering::getNbClusters() const
+{
+    return m_leaders.size();
+}
+
+std::vector< std::size_t > const& WFiberLeaderClustering::getClusterIndexes() const
+{
+    return m_clusterIndexes;
+}
+
+WDataSetFiberClustering::SPtr WFiberLeaderClustering::createClustering() const
+{
+    // join each fiber with its leader, the indices of all clusters are then copied at once
+    WUnionFind components( m_clusterIndexes.size() );
+    for( std::size_t fiber = 0; fiber < m_clusterIndexes.size(); ++fiber )
+    {
+        if( m_clusterIndexes[ fiber ] != NO_CLUSTER )
+        {
+            components.merge( m_leaders[ m_clusterIndexes[ fiber ] ], fiber );
+        }
+    }
+
+    // leaders are added in the order of the fibers and are the first fiber of their cluster, so the clusters come in the order of
+    // the leaders. Fibers without a cluster are left over as sets of their own.
+    std::vector< WFiberCluster::SPtr > const clusters = WFiberCluster::createClusters( &components );
+    WDataSetFiberClustering::SPtr clustering( new WDataSetFiberClustering() );
+    std::size_t cluster = 0;
+    for( std::size_t set = 0; set < clusters.size(); ++set )
+    {
+        if( m_clusterIndexes[ clusters[ set ]->getIndices().front() ] == NO_CLUSTER )
+        {
+            continue;
+        }
+        // the golden ratio spreads the hues of consecutive clusters
+        double const hue = std::fmod( 0.618033988749895 * cluster, 1.0 );
+        clusters[ set ]->setColor( convertHSVtoRGBA( hue, 0.8, 1.0 ) );
+        clustering->setCluster( cluster, clusters[ set ] );
+        ++cluster;
+    }
+    return clustering;
+}
+
+void WFiberLeaderClustering::findNearestLeader( std::size_t fiber, std::size_t firstLeader, std::size_t* leader, double* distance ) const
+{
+    std::size_t first[ 3 ];
+    std::size_t last[ 3 ];
+    for( std::size_t c = 0; c < 3; ++c )
+    {
+        // the leaders are stored with their boxes grown by the prune distance, so the box of the fiber suffices
+        first[ c ] = getCell( c, m_descriptors->getMin( fiber )[ c ] );
+        last[ c ] = getCell( c, m_descriptors->getMax( fiber )[ c ] );
+    }
+
+    for( std::size_t z = first[ 2 ]; z <= last[ 2 ]; ++z )
+    {
+        for( std::size_t y = first[ 1 ]; y <= last[ 1 ]; ++y )
+        {
+            for( std::size_t x = first[ 0 ]; x <= last[ 0 ]; ++x )
+            {
+                std::vector< std::size_t > const& cell = m_grid[ x + m_gridSize[ 0 ] * ( y + m_gridSize[ 1 ] * z ) ];
+                for( std::size_t i = 0; i < cell.size(); ++i )
+                {
+                    std::size_t const candidate = cell[ i ];
+                    if( candidate < firstLeader )
+                    {
+                        continue;
+                    }
+
+                    // a leader is in several cells, only check it in the first cell it shares with the fiber
+                    std::size_t const* leaderCells = &m_leaderCells[ 3 * candidate ];
+                    if( x != std::max( first[ 0 ], leaderCells[ 0 ] ) || y != std::max( first[ 1 ], leaderCells[ 1 ] ) ||
+                        z != std::max( first[ 2 ], leaderCells[ 2 ] ) )
+                    {
+                        continue;
+                    }
+
+                    std::size_t const leaderFiber = m_leaders[ candidate ];
+                    if( m_descriptors->getBoxDistance( fiber, leaderFiber ) > m_pruneDistance )
+                    {
+                        continue;
+                    }
+
+                    double const bound = std::min( m_clusterDistance, *distance );
+                    double const d = m_larger ? m_descriptors->distDLT( m_thresholdSquare, fiber, leaderFiber, bound ) :
+                                                m_descriptors->distDST( m_thresholdSquare, fiber, leaderFiber, bound );
+                    if( d <= m_clusterDistance && ( d < *distance || ( d == *distance && candidate < *leader ) ) )
+                    {
+                        *leader = candidate;
+                        *distance = d;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::size_t WFiberLeaderClustering::addLeader( std::size_t fiber )
+{
+    std::size_t first[ 3 ];
+    std::size_t last[ 3 ];
+    for( std::size_t c = 0; c < 3; ++c )
+    {
+        first[ c ] = getCell( c, m_descriptors->getMin( fiber )[ c ] - m_pruneDistance );
+        last[ c ] = getCell( c, m_descriptors->getMax( fiber )[ c ] + m_pruneDistance );
+        m_leaderCells.push_back( first[ c ] );
+    }
+
+    for( std::size_t z = first[ 2 ]; z <= last[ 2 ]; ++z )
+    {
+        for( std::size_t y = first[ 1 ]; y <= last[ 1 ]; ++y )
+        {
+            for( std::size_t x = first[ 0 ]; x <= last[ 0 ]; ++x )
+            {
+                m_grid[ x + m_gridSize[ 0 ] * ( y + m_gridSize[ 1 ] * z ) ].push_back( m_leaders.size() );
+            }
+        }
+    }
+    m_leaders.push_back( fiber );
+    return m_leaders.size() - 1;
+}
+
+std::size_t WFiberLeaderClustering::getCell( std::size_t axis, double position ) const
+{
+    double const cell = std::floor( ( position - m_gridOrigin[ axis ] ) / m_cellSize[ axis ] );
+    if( cell <= 0.0 )
+    {
+        return 0;
+    }
+    return std::min( static_cast< std::size_t >( cell ), m_gridSize[ axis ] - 1 );
+}
@@ -0,0 +1,159 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERLEADERCLUSTERING_H
+#define WFIBERLEADERCLUSTERING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "core/common/WFlag.h"
+#include "core/common/WProgress.h"
+#include "core/dataHandler/WDataSetFiberClustering.h"
+#include "WFiberDescriptors.h"
+
+/**
+ * Clusters fibers in a single sweep: every fiber joins the cluster of the nearest leader closer than the cluster distance,
+ * otherwise it becomes the leader of a new cluster. The distance is one of the thresholded distances of Zhang evaluated on
+ * fiber descriptors.
+ *
+ * Each leader is stored in all grid cells its bounding box, grown by the prune distance, overlaps. A fiber only looks at the
+ * cells of its own bounding box, so a single long fiber does not widen the search of all others. Only leaders whose bounding
+ * box is close enough are compared with it, and the distance kernel stops at the distance of the nearest leader found so
+ * far. Fibers are processed in batches: all fibers of a batch are compared with the leaders of the previous batches in
+ * parallel, only the leaders created within the batch are checked sequentially. The result is the same as processing the
+ * fibers one after another, ties go to the leader created first.
+ */
+class WFiberLeaderClustering
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param descriptors The descriptors of the fibers.
+     * \param proximityThreshold Point distances up to this are ignored by the thresholded distances.
+     * \param clusterDistance Fibers farther away from every leader start a new cluster.
+     * \param larger Use the larger thresholded distance dLT instead of the smaller one dST.
+     */
+    WFiberLeaderClustering( WFiberDescriptors::ConstSPtr descriptors, double proximityThreshold, double clusterDistance, bool larger );
+
+    /**
+     * Assigns every fiber to a cluster.
+     *
+     * \param progress Is incremented for each fiber.
+     * \param shutdown Stops the clustering if set.
+     *
+     * \return False if the clustering was stopped.
+     */
+    bool compute( WProgress::SPtr progress, WBoolFlag const& shutdown );
+
+    /**
+     * The number of clusters.
+     *
+     * \return The number of leaders.
+     */
+    std::size_t getNbClusters() const;
+
+    /**
+     * The cluster of each fiber.
+     *
+     * \return For every fiber the index of its cluster.
+     */
+    std::vector< std::size_t > const& getClusterIndexes() const;
+
+    /**
+     * Creates the clustering dataset, the IDs of the clusters are the indexes of getClusterIndexes().
+     *
+     * \return The clustering.
+     */
+    WDataSetFiberClustering::SPtr createClustering() const;
+
+private:
+    /**
+     * The nearest of a range of leaders closer than the cluster distance. Keeps the given leader if it is at least as close.
+     *
+     * \param fiber The fiber.
+     * \param firstLeader Leaders with a smaller index are ignored.
+     * \param leader The cluster index of the nearest leader found so far, updated.
+     * \param distance The distance to this leader, updated.
+     */
+    void findNearestLeader( std::size_t fiber, std::size_t firstLeader, std::size_t* leader, double* distance ) const;
+
+    /**
+     * Makes a fiber the leader of a new cluster.
+     *
+     * \param fiber The fiber.
+     *
+     * \return The index of the new cluster.
+     */
+    std::size_t addLeader( std::size_t fiber );
+
+    /**
+     * The grid cell containing a position, clamped to the grid.
+     *
+     * \param axis The axis.
+     * \param position The coordinate along the axis.
+     *
+     * \return The index of the cell along the axis.
+     */
+    std::size_t getCell( std::size_t axis, double position ) const;
+
+    //! the fiber descriptors
+    WFiberDescriptors::ConstSPtr m_descriptors;
+
+    //! the square of the proximity threshold
+    double m_thresholdSquare;
+
+    //! the cluster distance
+    double m_clusterDistance;
+
+    //! use dLT instead of dST
+    bool m_larger;
+
+    //! pairs of fibers with bounding boxes farther apart than this cannot be in the same cluster
+    double m_pruneDistance;
+
+    //! the cluster of each fiber
+    std::vector< std::size_t > m_clusterIndexes;
+
+    //! the fiber of each leader
+    std::vector< std::size_t > m_leaders;
+
+    //! the origin of the grid
+    double m_gridOrigin[ 3 ];
+
+    //! the size of the grid cells
+    double m_cellSize[ 3 ];
+
+    //! the number of grid cells along each axis
+    std::size_t m_gridSize[ 3 ];
+
+    //! the first grid cell of each leader along each axis, three per leader
+    std::vector< std::size_t > m_leaderCells;
+
+    //! the cluster indexes of the leaders overlapping each grid cell
+    std::vector< std::vector< std::size_t > > m_grid;
+};
+
+#endif  // WFIBERLEADERCLUSTERING_H
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#include <memory>
+#include <string>
+
+#include <core/kernel/WKernel.h>
+
+#include "WFiberDescriptors.h"
+#include "WFiberLeaderClustering.h"
+#include "WMFiberClustering.h"
+
+W_LOADABLE_MODULE( WMFiberClustering )
+
+WMFiberClustering::WMFiberClustering():
+    WModule()
+{
+}
+
+WMFiberClustering::~WMFiberClustering()
+{
+}
+
+std::shared_ptr< WModule > WMFiberClustering::factory() const
+{
+    return std::shared_ptr< WModule >( new WMFiberClustering() );
+}
+
+const std::string WMFiberClustering::getName() const
+{
+    return "Fiber Clustering";
+}
+
+const std::string WMFiberClustering::getDescription() const
+{
+    return "Clusters fibers by their thresholded distances. Each fiber joins the cluster of the nearest leader fiber or starts a new "
+           "cluster if there is no leader within the cluster distance.";
+}
+
+void WMFiberClustering::connectors()
+{
+    m_fiberIC = WModuleInputData< WDataSetFibers >::createAndAdd( shared_from_this(), "fibers", "The fibers to cluster." );
+    m_clusteringOC = WModuleOutputData< WDataSetFiberClustering >::createAndAdd( shared_from_this(), "clustering",
+                                                                               "The clusters of the fibers." );
+
+    WModule::connectors();
+}
+
+void WMFiberClustering::properties()
+{
+    m_propCondition = std::shared_ptr< WCondition >( new WCondition() );
+
+    m_nbPoints = m_properties->addProperty( "Descriptor points", "Fibers are resampled to this number of points before comparing them.",
+                                            12, m_propCondition );
+    m_nbPoints->setMin( 2 );
+    m_nbPoints->setMax( 100 );
+    m_proximityThreshold = m_properties->addProperty( "Proximity threshold", "Point distances up to this are ignored.", 1.0,
+                                                      m_propCondition );
+    m_proximityThreshold->setMin( 0.0 );
+    m_proximityThreshold->setMax( 100.0 );
+    m_clusterDistance = m_properties->addProperty( "Cluster distance", "Fibers farther away from the leaders of all clusters start a new "
+                                                   "cluster.", 6.5, m_propCondition );
+    m_clusterDistance->setMin( 0.0 );
+    m_clusterDistance->setMax( 100.0 );
+    m_larger = m_properties->addProperty( "Larger distance", "Use the larger instead of the smaller thresholded distance of both "
+                                          "directions. Clusters of the larger distance contain fibers of similar length.", true,
+                                          m_propCondition );
+
+    WModule::properties();
+}
+
+void WMFiberClustering::moduleMain()
+{
+    m_moduleState.setResetable( true, true );
+    m_moduleState.add( m_fiberIC->getDataChangedCondition() );
+    m_moduleState.add( m_propCondition );
+
+    ready();
+
+    WDataSetFibers::SPtr fibers;
+    WFiberDescriptors::SPtr descriptors;
+    while( !m_shutdownFlag() )
+    {
+        debugLog() << "Waiting ...";
+        m_moduleState.wait();
+
+        if( m_shutdownFlag() )
+        {
+            break;
+        }
+
+        WDataSetFibers::SPtr newFibers = m_fiberIC->getData();
+        if( !newFibers )
+        {
+            continue;
+        }
+
+        // the descriptors only change with the fibers and their number of points
+        if( newFibers != fibers || !descriptors || descriptors->getNbPoints() != static_cast< size_t >( m_nbPoints->get( true ) ) )
+        {
+            fibers = newFibers;
+            debugLog() << "Creating descriptors";
+            descriptors.reset( new WFiberDescriptors( *fibers, m_nbPoints->get() ) );
+        }
+
+        WProgress::SPtr progress( new WProgress( "Clustering Fibers", fibers->size() ) );
+        m_progress->addSubProgress( progress );
+        debugLog() << "Start clustering";
+        WFiberLeaderClustering clustering( descriptors, m_proximityThreshold->get( true ), m_clusterDistance->get( true ),
+                                           m_larger->get( true ) );
+        if( clustering.compute( progress, m_shutdownFlag ) )
+        {
+            debugLog() << "Found " << clustering.getNbClusters() << " clusters";
+            m_clusteringOC->updateData( clustering.createClustering() );
+        }
+        progress->finish();
+        m_progress->removeSubProgress( progress );
+    }
+}
@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WMFIBERCLUSTERING_H
+#define WMFIBERCLUSTERING_H
+
+#include <memory>
+#include <string>
+
+#include <core/dataHandler/WDataSetFiberClustering.h>
+#include <core/dataHandler/WDataSetFibers.h>
+#include <core/kernel/WModule.h>
+#include <core/kernel/WModuleInputData.h>
+#include <core/kernel/WModuleOutputData.h>
+
+/**
+ * Clusters fibers by the thresholded distances of Zhang, see WFiberLeaderClustering. The fibers are compared by descriptors
+ * with a fixed number of points, so large datasets can be clustered within seconds.
+ *
+ * \ingroup modules
+ */
+class WMFiberClustering: public WModule
+{
+public:
+    /**
+     * Default constructor.
+     */
+    WMFiberClustering();
+
+    /**
+     * Destructor.
+     */
+    virtual ~WMFiberClustering();
+
+    /**
+     * Gives back the name of this module.
+     * \return the module's name.
+     */
+    virtual const std::string getName() const;
+
+    /**
+     * Gives back a description of this module.
+     * \return description to module.
+     */
+    virtual const std::string getDescription() const;
+
+    /**
+     * Due to the prototype design pattern used to build modules, this method returns a new instance of this method. NOTE: it
+     * should never be initialized or modified in some other way. A simple new instance is required.
+     *
+     * \return the prototype used to create every module in OpenWalnut.
+     */
+    virtual std::shared_ptr< WModule > factory() const;
+
+protected:
+    /**
+     * Entry point after loading the module. Runs in separate thread.
+     */
+    virtual void moduleMain();
+
+    /**
+     * Initialize the connectors this module is using.
+     */
+    virtual void connectors();
+
+    /**
+     * Initialize the properties for this module.
+     */
+    virtual void properties();
+
+private:
+    /**
+     * The fibers to cluster.
+     */
+    std::shared_ptr< WModuleInputData< WDataSetFibers > > m_fiberIC;
+
+    /**
+     * The clustering of the fibers.
+     */
+    std::shared_ptr< WModuleOutputData< WDataSetFiberClustering > > m_clusteringOC;
+
+    /**
+     * Notified on property changes.
+     */
+    std::shared_ptr< WCondition > m_propCondition;
+
+    /**
+     * The number of points of the fiber descriptors.
+     */
+    WPropInt m_nbPoints;
+
+    /**
+     * Point distances up to this are ignored.
+     */
+    WPropDouble m_proximityThreshold;
+
+    /**
+     * Fibers farther away from every cluster start a new one.
+     */
+    WPropDouble m_clusterDistance;
+
+    /**
+     * Use the larger thresholded distance instead of the smaller one.
+     */
+    WPropBool m_larger;
+};
+
+#endif  // WMFIBERCLUSTERING_H
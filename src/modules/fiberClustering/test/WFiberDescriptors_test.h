@@ -0,0 +1,172 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERDESCRIPTORS_TEST_H
+#define WFIBERDESCRIPTORS_TEST_H
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "core/common/WLogger.h"
+#include "core/common/datastructures/WFiber.h"
+#include "core/dataHandler/WDataSetFibers.h"
+#include "core/dataHandler/WFiberView.h"
+#include "../WFiberDescriptors.h"
+
+/**
+ * Tests for WFiberDescriptors.
+ */
+class WFiberDescriptorsTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger and other stuff for each test.
+     */
+    void setUp()
+    {
+        WLogger::startup();
+    }
+
+    /**
+     * The points are placed at equal arc length distances and stored coordinate by coordinate.
+     */
+    void testDescriptor( void )
+    {
+        std::vector< float > vertices = { 0, 0, 0, 1, 0, 0, 4, 0, 0, 0, 0, 0, 0, 2, 2 }; // NOLINT curly braces
+        std::vector< size_t > lengths = { 3, 2 }; // NOLINT curly braces
+        WDataSetFibers fibers( WDataSetFibers::VertexArray( new std::vector< float >( vertices ) ), createStartIndexes( lengths ),
+                               WDataSetFibers::LengthArray( new std::vector< size_t >( lengths ) ), createVerticesReverse( lengths ) );
+        WFiberDescriptors descriptors( fibers, 5 );
+
+        TS_ASSERT_EQUALS( descriptors.size(), 2 );
+        TS_ASSERT_EQUALS( descriptors.getNbPoints(), 5 );
+        for( size_t i = 0; i < 5; ++i )
+        {
+            TS_ASSERT_DELTA( descriptors[ 0 ][ i ], static_cast< float >( i ), 1e-6 );
+            TS_ASSERT_EQUALS( descriptors[ 0 ][ 5 + i ], 0.0f );
+            TS_ASSERT_EQUALS( descriptors[ 0 ][ 10 + i ], 0.0f );
+            TS_ASSERT_DELTA( descriptors[ 1 ][ 5 + i ], 0.5f * i, 1e-6 );
+        }
+        TS_ASSERT_EQUALS( descriptors.getMin( 0 )[ 0 ], 0.0f );
+        TS_ASSERT_EQUALS( descriptors.getMax( 0 )[ 0 ], 4.0f );
+        TS_ASSERT_EQUALS( descriptors.getMax( 1 )[ 2 ], 2.0f );
+
+        // the boxes touch at the origin
+        TS_ASSERT_EQUALS( descriptors.getBoxDistance( 0, 1 ), 0.0 );
+    }
+
+    /**
+     * Fibers without vertices have all points at the origin.
+     */
+    void testEmptyFiber( void )
+    {
+        std::vector< float > vertices = { 1, 1, 1, 3, 1, 1, 5, 5, 5, 6, 6, 6, 2, 2, 2, 2, 4, 2, 2, 6, 2 }; // NOLINT curly braces
+        std::vector< size_t > lengths = { 2, 2, 3 }; // NOLINT curly braces
+        WDataSetFibers::LengthArray lineLengths( new std::vector< size_t >( lengths ) );
+        WDataSetFibers fibers( WDataSetFibers::VertexArray( new std::vector< float >( vertices ) ), createStartIndexes( lengths ),
+                               lineLengths, createVerticesReverse( lengths ) );
+        // the dataset rejects empty fibers on construction, but the length array is shared and may change later
+        ( *lineLengths )[ 1 ] = 0;
+        WFiberDescriptors descriptors( fibers, 3 );
+
+        TS_ASSERT_EQUALS( descriptors.size(), 3 );
+        for( size_t i = 0; i < 9; ++i )
+        {
+            TS_ASSERT_EQUALS( descriptors[ 1 ][ i ], 0.0f );
+        }
+        for( size_t c = 0; c < 3; ++c )
+        {
+            TS_ASSERT_EQUALS( descriptors.getMin( 1 )[ c ], 0.0f );
+            TS_ASSERT_EQUALS( descriptors.getMax( 1 )[ c ], 0.0f );
+        }
+
+        // the neighbours are unaffected
+        TS_ASSERT_EQUALS( descriptors[ 0 ][ 1 ], 2.0f );
+        TS_ASSERT_EQUALS( descriptors[ 2 ][ 3 + 1 ], 4.0f );
+    }
+
+    /**
+     * The distances equal the ones of WFiber, bounds below the distance give infinity.
+     */
+    void testDistances( void )
+    {
+        std::vector< float > vertices;
+        std::vector< size_t > lengths;
+        unsigned int seed = 17;
+        for( size_t fiber = 0; fiber < 20; ++fiber )
+        {
+            lengths.push_back( 2 + fiber % 7 );
+            for( size_t i = 0; i < 3 * lengths.back(); ++i )
+            {
+                seed = seed * 1103515245 + 12345;
+                vertices.push_back( static_cast< float >( ( seed >> 16 ) % 1000 ) / 100.0f + ( i % 3 == 0 ? i : 0 ) );
+            }
+        }
+        WDataSetFibers fibers( WDataSetFibers::VertexArray( new std::vector< float >( vertices ) ), createStartIndexes( lengths ),
+                               WDataSetFibers::LengthArray( new std::vector< size_t >( lengths ) ), createVerticesReverse( lengths ) );
+        WFiberDescriptors descriptors( fibers, 8 );
+
+        std::vector< WFiber > reference( descriptors.size() );
+        for( size_t fiber = 0; fiber < descriptors.size(); ++fiber )
+        {
+            for( size_t i = 0; i < 8; ++i )
+            {
+                float const* d = descriptors[ fiber ];
+                reference[ fiber ].push_back( WPosition( d[ i ], d[ 8 + i ], d[ 16 + i ] ) );
+            }
+        }
+
+        double const infinity = std::numeric_limits< double >::infinity();
+        double const thresholdSquare = 2.0;
+        for( size_t q = 0; q < descriptors.size(); ++q )
+        {
+            for( size_t r = 0; r < descriptors.size(); ++r )
+            {
+                double const dlt = WFiber::distDLT( thresholdSquare, reference[ q ], reference[ r ] );
+                double const dst = WFiber::distDST( thresholdSquare, reference[ q ], reference[ r ] );
+                TS_ASSERT_DELTA( descriptors.distDLT( thresholdSquare, q, r, infinity ), dlt, 1e-4 );
+                TS_ASSERT_DELTA( descriptors.distDST( thresholdSquare, q, r, infinity ), dst, 1e-4 );
+                TS_ASSERT_DELTA( descriptors.distDLT( thresholdSquare, q, r, dlt + 0.01 ), dlt, 1e-4 );
+                TS_ASSERT_DELTA( descriptors.distDST( thresholdSquare, q, r, dst + 0.01 ), dst, 1e-4 );
+                if( dst > 0.01 )
+                {
+                    TS_ASSERT_EQUALS( descriptors.distDLT( thresholdSquare, q, r, dlt - 0.01 ), infinity );
+                    TS_ASSERT_EQUALS( descriptors.distDST( thresholdSquare, q, r, dst - 0.01 ), infinity );
+                }
+
+                double const box = descriptors.getBoxDistance( q, r );
+                if( box * box > thresholdSquare )
+                {
+                    TS_ASSERT( box <= dst + 1e-4 );
+                }
+            }
+        }
+    }
+};
+
+#endif  // WFIBERDESCRIPTORS_TEST_H
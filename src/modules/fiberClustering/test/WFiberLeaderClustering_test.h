@@ -0,0 +1,171 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WFIBERLEADERCLUSTERING_TEST_H
+#define WFIBERLEADERCLUSTERING_TEST_H
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <cxxtest/TestSuite.h>
+
+#include "core/common/WLogger.h"
+#include "core/dataHandler/WDataSetFibers.h"
+#include "core/dataHandler/WFiberView.h"
+#include "../WFiberLeaderClustering.h"
+
+/**
+ * Tests for WFiberLeaderClustering.
+ */
+class WFiberLeaderClusteringTest : public CxxTest::TestSuite
+{
+public:
+    /**
+     * Setup logger and other stuff for each test.
+     */
+    void setUp()
+    {
+        WLogger::startup();
+    }
+
+    /**
+     * Two bundles of parallel fibers far apart give two clusters.
+     */
+    void testBundles( void )
+    {
+        std::vector< float > vertices;
+        std::vector< size_t > lengths;
+        for( size_t fiber = 0; fiber < 10; ++fiber )
+        {
+            float const offset = fiber % 2 == 0 ? 0.0f : 50.0f;
+            lengths.push_back( 4 );
+            for( size_t i = 0; i < 4; ++i )
+            {
+                float const position[] = { 10.0f * i, offset + 0.3f * fiber, offset }; // NOLINT curly braces
+                vertices.insert( vertices.end(), position, position + 3 );
+            }
+        }
+
+        WFiberLeaderClustering clustering( createDescriptors( vertices, lengths, 6 ), 1.0, 3.0, true );
+        WProgress::SPtr progress( new WProgress( "test", lengths.size() ) );
+        TS_ASSERT( clustering.compute( progress, WBoolFlag( new WCondition(), false ) ) );
+        TS_ASSERT_EQUALS( clustering.getNbClusters(), 2 );
+        for( size_t fiber = 0; fiber < lengths.size(); ++fiber )
+        {
+            TS_ASSERT_EQUALS( clustering.getClusterIndexes()[ fiber ], fiber % 2 );
+        }
+
+        WDataSetFiberClustering::SPtr result = clustering.createClustering();
+        TS_ASSERT_EQUALS( result->size(), 2 );
+        TS_ASSERT_EQUALS( result->getCluster( 1 )->size(), 5 );
+        TS_ASSERT_EQUALS( result->getCluster( 1 )->getIndices().front(), 1 );
+    }
+
+    /**
+     * The batched and pruned clustering equals assigning the fibers one after another to the nearest of all leaders.
+     */
+    void testSequentialResult( void )
+    {
+        std::vector< float > vertices;
+        std::vector< size_t > lengths;
+        unsigned int seed = 5;
+        for( size_t fiber = 0; fiber < 6000; ++fiber )
+        {
+            lengths.push_back( 3 );
+            float start[ 3 ];
+            for( size_t c = 0; c < 3; ++c )
+            {
+                seed = seed * 1103515245 + 12345;
+                start[ c ] = static_cast< float >( ( seed >> 16 ) % 4000 ) / 100.0f;
+            }
+            // some fibers span the whole domain and overlap many grid cells
+            float const step = fiber % 1000 == 500 ? 20.0f : 5.0f;
+            if( fiber % 1000 == 500 )
+            {
+                start[ 0 ] = 0.0f;
+            }
+            for( size_t i = 0; i < 3; ++i )
+            {
+                seed = seed * 1103515245 + 12345;
+                float const wiggle = static_cast< float >( ( seed >> 16 ) % 100 ) / 100.0f;
+                float const position[] = { start[ 0 ] + step * i, start[ 1 ] + wiggle, start[ 2 ] }; // NOLINT curly braces
+                vertices.insert( vertices.end(), position, position + 3 );
+            }
+        }
+
+        for( size_t larger = 0; larger < 2; ++larger )
+        {
+            WFiberDescriptors::SPtr descriptors = createDescriptors( vertices, lengths, 4 );
+            WFiberLeaderClustering clustering( descriptors, 0.5, 4.0, larger == 1 );
+            WProgress::SPtr progress( new WProgress( "test", lengths.size() ) );
+            TS_ASSERT( clustering.compute( progress, WBoolFlag( new WCondition(), false ) ) );
+
+            std::vector< size_t > leaders;
+            for( size_t fiber = 0; fiber < lengths.size(); ++fiber )
+            {
+                size_t nearest = leaders.size();
+                double nearestDistance = 4.0;
+                for( size_t leader = 0; leader < leaders.size(); ++leader )
+                {
+                    double const infinity = std::numeric_limits< double >::infinity();
+                    double const d = larger == 1 ? descriptors->distDLT( 0.25, fiber, leaders[ leader ], infinity ) :
+                                                   descriptors->distDST( 0.25, fiber, leaders[ leader ], infinity );
+                    if( d < nearestDistance || ( d == nearestDistance && nearest == leaders.size() ) )
+                    {
+                        nearest = leader;
+                        nearestDistance = d;
+                    }
+                }
+                if( nearest == leaders.size() )
+                {
+                    leaders.push_back( fiber );
+                }
+                TS_ASSERT_EQUALS( clustering.getClusterIndexes()[ fiber ], nearest );
+            }
+            TS_ASSERT_EQUALS( clustering.getNbClusters(), leaders.size() );
+            TS_ASSERT( leaders.size() > 10 );
+            TS_ASSERT( leaders.size() < lengths.size() / 2 );
+        }
+    }
+
+private:
+    /**
+     * Creates the descriptors of fibers.
+     *
+     * \param vertices The vertices.
+     * \param lengths The number of vertices of each fiber.
+     * \param nbPoints The number of points per descriptor.
+     *
+     * \return The descriptors.
+     */
+    WFiberDescriptors::SPtr createDescriptors( std::vector< float > const& vertices, std::vector< size_t > const& lengths, size_t nbPoints )
+    {
+        WDataSetFibers fibers( WDataSetFibers::VertexArray( new std::vector< float >( vertices ) ), createStartIndexes( lengths ),
+                               WDataSetFibers::LengthArray( new std::vector< size_t >( lengths ) ), createVerticesReverse( lengths ) );
+        return WFiberDescriptors::SPtr( new WFiberDescriptors( fibers, nbPoints ) );
+    }
+};
+
+#endif  // WFIBERLEADERCLUSTERING_TEST_H
@@ -22,6 +22,7 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
 
@@ -60,3 +61,49 @@ WFiber WResampleByMaxPoints::resample( WFiber fib ) const
     }
     return fib;
 }
+
+bool WResampleByMaxPoints::getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* buffers ) const
+{
+    *size = computeSize( reduce( fib, buffers ) );
+    return true;
+}
+
+void WResampleByMaxPoints::resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const
+{
+    WFiberConstSpan const reduced = reduce( fib, buffers );
+    if( target.size() < reduced.size() )
+    {
+        resampleBySegmentLength( reduced, m_segLength->get(), false, &target );
+    }
+    else
+    {
+        std::copy( reduced.data(), reduced.data() + 3 * reduced.size(), target.data() );
+    }
+}
+
+WFiberConstSpan WResampleByMaxPoints::reduce( WFiberConstSpan const& fib, Buffers* buffers ) const
+{
+    size_t const numPoints = static_cast< size_t >( m_numPoints->get() );
+    if( fib.size() <= numPoints )
+    {
+        return fib;
+    }
+
+    buffers->m_vertices.resize( 3 * numPoints );
+    resampleByNumberOfPoints( fib, WFiberSpan( buffers->m_vertices.data(), numPoints ), &buffers->m_arcLength );
+    return WFiberConstSpan( buffers->m_vertices.data(), numPoints );
+}
+
+size_t WResampleByMaxPoints::computeSize( WFiberConstSpan const& reduced ) const
+{
+    // the segment length resampling is only used if it reduces the number of vertices
+    if( m_segLength->get() != 0.0 )
+    {
+        size_t const size = resampleBySegmentLength( reduced, m_segLength->get(), false, NULL );
+        if( static_cast< int >( size ) < m_numPoints->get() && size < reduced.size() )
+        {
+            return size;
+        }
+    }
+    return reduced.size();
+}
@@ -51,6 +51,26 @@ protected:
      */
     virtual WFiber resample( WFiber fib ) const;
 
+    /**
+     * Computes the size like resample() does, but without storing the resampled fiber.
+     *
+     * \param fib The fiber to resample.
+     * \param size Receives the number of vertices after resampling.
+     * \param buffers Buffers of the calling thread.
+     *
+     * \return Always true.
+     */
+    virtual bool getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* buffers ) const;
+
+    /**
+     * Resamples the fiber like resample() does, directly into the target.
+     *
+     * \param fib The fiber to resample.
+     * \param target The vertices of the resampled fiber.
+     * \param buffers Buffers of the calling thread.
+     */
+    virtual void resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const;
+
     /**
      * Number of new sample points all tracts are resampled to.
      */
@@ -61,6 +81,24 @@ protected:
      */
     WPropInt m_numPoints;
 private:
+    /**
+     * Reduces a fiber with more than m_numPoints vertices to that many, see ::resampleByNumberOfPoints().
+     *
+     * \param fib The fiber.
+     * \param buffers Receive the reduced fiber.
+     *
+     * \return The reduced fiber, or fib if it has few enough vertices.
+     */
+    WFiberConstSpan reduce( WFiberConstSpan const& fib, Buffers* buffers ) const;
+
+    /**
+     * The number of vertices of the resampled fiber.
+     *
+     * \param reduced The fiber reduced to at most m_numPoints vertices.
+     *
+     * \return The number of vertices.
+     */
+    size_t computeSize( WFiberConstSpan const& reduced ) const;
 };
 
 #endif  // WRESAMPLEBYMAXPOINTS_H
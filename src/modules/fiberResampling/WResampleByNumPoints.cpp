@@ -43,3 +43,14 @@ WFiber WResampleByNumPoints::resample( WFiber fib ) const
     fib.resampleByNumberOfPoints( m_numPoints->get( true ) );
     return fib;
 }
+
+bool WResampleByNumPoints::getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* /* buffers */ ) const
+{
+    *size = fib.size() == 0 ? 0 : static_cast< size_t >( m_numPoints->get() );
+    return true;
+}
+
+void WResampleByNumPoints::resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const
+{
+    resampleByNumberOfPoints( fib, target, &buffers->m_arcLength );
+}
@@ -25,6 +25,8 @@
 #ifndef WRESAMPLEBYNUMPOINTS_H
 #define WRESAMPLEBYNUMPOINTS_H
 
+#include <vector>
+
 #include <core/common/datastructures/WFiber.h>
 #include <core/common/WObjectNDIP.h>
 
@@ -51,6 +53,26 @@ protected:
      */
     virtual WFiber resample( WFiber fib ) const;
 
+    /**
+     * Every fiber with vertices has m_numPoints vertices afterwards.
+     *
+     * \param fib The fiber to resample.
+     * \param size Receives the number of vertices after resampling.
+     * \param buffers Not used.
+     *
+     * \return Always true.
+     */
+    virtual bool getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* buffers ) const;
+
+    /**
+     * Places the vertices at equal arc length distances along the fiber, see ::resampleByNumberOfPoints().
+     *
+     * \param fib The fiber to resample.
+     * \param target The vertices of the resampled fiber.
+     * \param buffers Buffers of the calling thread.
+     */
+    virtual void resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const;
+
     /**
      * Number of new sample points all tracts are resampled to.
      */
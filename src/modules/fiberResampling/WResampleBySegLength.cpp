@@ -44,3 +44,14 @@ WFiber WResampleBySegLength::resample( WFiber fib ) const
     fib.resampleBySegmentLength( m_segLength->get( true ) );
     return fib;
 }
+
+bool WResampleBySegLength::getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* /* buffers */ ) const
+{
+    *size = resampleBySegmentLength( fib, m_segLength->get(), false, NULL );
+    return true;
+}
+
+void WResampleBySegLength::resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* /* buffers */ ) const
+{
+    resampleBySegmentLength( fib, m_segLength->get(), false, &target );
+}
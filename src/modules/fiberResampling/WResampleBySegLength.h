@@ -51,6 +51,26 @@ protected:
      */
     virtual WFiber resample( WFiber fib ) const;
 
+    /**
+     * Computes the size by running the segment length resampling without storing the vertices.
+     *
+     * \param fib The fiber to resample.
+     * \param size Receives the number of vertices after resampling.
+     * \param buffers Not used.
+     *
+     * \return Always true.
+     */
+    virtual bool getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* buffers ) const;
+
+    /**
+     * Resamples the fiber by segment length, see ::resampleBySegmentLength().
+     *
+     * \param fib The fiber to resample.
+     * \param target The vertices of the resampled fiber.
+     * \param buffers Not used.
+     */
+    virtual void resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const;
+
     /**
      * Number of new sample points all tracts are resampled to.
      */
@@ -43,3 +43,14 @@ WFiber WResampleBySegLengthKeepShortFibers::resample( WFiber fib ) const
     fib.resampleBySegmentLengthKeepShortFibers( m_segLength->get( true ) );
     return fib;
 }
+
+bool WResampleBySegLengthKeepShortFibers::getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* /* buffers */ ) const
+{
+    *size = resampleBySegmentLength( fib, m_segLength->get(), true, NULL );
+    return true;
+}
+
+void WResampleBySegLengthKeepShortFibers::resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* /* buffers */ ) const
+{
+    resampleBySegmentLength( fib, m_segLength->get(), true, &target );
+}
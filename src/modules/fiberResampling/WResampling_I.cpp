@@ -22,10 +22,35 @@
 //
 //---------------------------------------------------------------------------
 
-#include <core/dataHandler/WDataSetFiberVector.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <core/common/WAssert.h>
+#include <core/common/WLogger.h>
+#include <core/common/datastructures/WFiber.h>
 
 #include "WResampling_I.h"
 
+namespace
+{
+    /**
+     * The fibers of a block resampled in the first pass because their size was not known in advance.
+     */
+    struct WResampledBlock
+    {
+        //! for each fiber of the block the index of its first vertex in m_vertices
+        std::vector< size_t > m_offsets;
+
+        //! the vertices of the resampled fibers, 3 floats per vertex
+        std::vector< float > m_vertices;
+    };
+
+    //! the blocks with fibers resampled in the first pass by the index of their first fiber
+    typedef std::map< size_t, WResampledBlock > WResampledBlocks;
+}
+
 WResampling_I::~WResampling_I()
 {
 }
@@ -34,14 +59,115 @@ WDataSetFibers::SPtr WResampling_I::operator()( WProgress::SPtr progress, WBoolF
 {
     wlog::debug( "WResampling_I" ) << "Start resampling: " << fibers->getLineStartIndexes()->size() << " fibers";
 
-    WDataSetFiberVector::SPtr newDS( new WDataSetFiberVector() );
+    WFiberConstView const view = createFiberView( *fibers );
+    WDataSetFibers::LengthArray lengths( new std::vector< size_t >( view.size() ) );
+    std::vector< char > direct( view.size(), 0 );
+    WResampledBlocks blocks;
+    std::mutex blocksLock;
+
+    // first pass: the size of each resampled fiber, fibers with unknown size are resampled right away
+    forEachFiberBlock( view.size(), [ & ]( size_t begin, size_t end )
+    {
+        if( shutdown() )
+        {
+            return;
+        }
+
+        WResampledBlock block;
+        WFiber fiber;
+        Buffers buffers;
+        for( size_t fidx = begin; fidx < end; ++fidx )
+        {
+            WFiberConstSpan const source = view[ fidx ];
+            direct[ fidx ] = getResampledSize( source, &( *lengths )[ fidx ], &buffers );
+            if( direct[ fidx ] )
+            {
+                continue;
+            }
+
+            if( block.m_offsets.empty() )
+            {
+                block.m_offsets.resize( end - begin, 0 );
+            }
+            block.m_offsets[ fidx - begin ] = block.m_vertices.size() / 3;
+            source.copyTo( &fiber );
+            WFiber const resampled = resample( fiber );
+            ( *lengths )[ fidx ] = resampled.size();
+            for( size_t i = 0; i < resampled.size(); ++i )
+            {
+                block.m_vertices.push_back( resampled[ i ][ 0 ] );
+                block.m_vertices.push_back( resampled[ i ][ 1 ] );
+                block.m_vertices.push_back( resampled[ i ][ 2 ] );
+            }
+        }
+
+        if( !block.m_offsets.empty() )
+        {
+            std::lock_guard< std::mutex > lock( blocksLock );
+            std::swap( blocks[ begin ], block );
+        }
+        progress->increment( end - begin );
+    } );
+
+    if( shutdown() )
+    {
+        return WDataSetFibers::SPtr();
+    }
 
-    for( size_t fidx = 0; fidx < fibers->getLineStartIndexes()->size() && !shutdown; ++fidx )
+    WDataSetFibers::IndexArray startIndexes = createStartIndexes( *lengths );
+    size_t const nbVertices = lengths->empty() ? 0 : startIndexes->back() + lengths->back();
+    WDataSetFibers::VertexArray vertices( new std::vector< float >( 3 * nbVertices ) );
+    WDataSetFibers::VertexParemeterArray arcLengths( new std::vector< double >( nbVertices ) );
+    WFiberView const out = createFiberView( vertices.get(), *startIndexes, *lengths );
+
+    // second pass: write all fibers to their place in the preallocated arrays
+    forEachFiberBlock( view.size(), [ & ]( size_t begin, size_t end )
     {
-        newDS->push_back( resample( (*fibers)[ fidx ] ) );
-        ++*progress;
+        if( shutdown() )
+        {
+            return;
+        }
+
+        Buffers buffers;
+        for( size_t fidx = begin; fidx < end; ++fidx )
+        {
+            WFiberSpan const target = out[ fidx ];
+            if( direct[ fidx ] )
+            {
+                resampleInto( view[ fidx ], target, &buffers );
+            }
+            else
+            {
+                WResampledBlocks::const_iterator block = blocks.upper_bound( fidx );
+                --block;
+                float const* source = block->second.m_vertices.data() + 3 * block->second.m_offsets[ fidx - block->first ];
+                std::copy( source, source + 3 * target.size(), target.data() );
+            }
+            computeArcLength( target.data(), target.size(), arcLengths->data() + ( *startIndexes )[ fidx ] );
+        }
+    } );
+
+    if( shutdown() )
+    {
+        return WDataSetFibers::SPtr();
     }
 
-    return newDS->toWDataSetFibers();
+    return WDataSetFibers::SPtr( new WDataSetFibers( vertices, startIndexes, lengths, createVerticesReverse( *lengths ), arcLengths ) );
 }
 
+bool WResampling_I::getResampledSize( WFiberConstSpan const& /* fib */, size_t* /* size */, Buffers* /* buffers */ ) const
+{
+    return false;
+}
+
+void WResampling_I::resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* /* buffers */ ) const
+{
+    WFiber fiber;
+    fib.copyTo( &fiber );
+    WFiber const resampled = resample( fiber );
+    WAssert( resampled.size() == target.size(), "The resampled fiber does not have the announced size." );
+    for( size_t i = 0; i < target.size(); ++i )
+    {
+        target.setPosition( i, resampled[ i ] );
+    }
+}
@@ -25,9 +25,12 @@
 #ifndef WRESAMPLING_I_H
 #define WRESAMPLING_I_H
 
+#include <vector>
+
 #include <core/common/WProgress.h>
 #include <core/common/WFlag.h>
 #include <core/dataHandler/WDataSetFibers.h>
+#include <core/dataHandler/WFiberView.h>
 
 /**
  * Interface for Resampling fibers.
@@ -38,11 +41,16 @@ public:
     /**
      * Resample each fiber within the given fiber dataset according to the given implementation of virtual resample().
      *
+     * The fibers are resampled in parallel in two passes. The first pass determines the number of vertices of each resampled
+     * fiber, the second one writes the vertices directly into the preallocated arrays of the new dataset. Strategies which
+     * can compute the size without storing the result (see getResampledSize()) resample in the second pass, the results of
+     * all others are kept in temporary buffers between the passes. The arc length from the start of its fiber is stored as vertex parameter.
+     *
      * \param progress This will indicate progress.
      * \param shutdown Possibility to abort in case of shutdown.
      * \param fibers The fibers which should be resampled.
      *
-     * \return Colored fibers
+     * \return The resampled fibers, or an empty pointer if aborted.
      */
     virtual WDataSetFibers::SPtr operator()( WProgress::SPtr progress, WBoolFlag const &shutdown, WDataSetFibers::SPtr fibers );
 
@@ -52,6 +60,18 @@ public:
     virtual ~WResampling_I();
 
 protected:
+    /**
+     * Buffers of a thread, reused for all fibers it resamples.
+     */
+    struct Buffers
+    {
+        //! e.g. the arc length of the vertices of a fiber
+        std::vector< double > m_arcLength;
+
+        //! e.g. the vertices of an intermediate fiber, 3 floats per vertex
+        std::vector< float > m_vertices;
+    };
+
     /**
      * All overrided methods should resample the fiber in their specific way.
      *
@@ -61,6 +81,28 @@ protected:
      */
     virtual WFiber resample( WFiber fib ) const = 0;
 
+    /**
+     * Get the number of vertices of a fiber after resampling without storing the resampled fiber. Strategies able to do so
+     * should override this and resampleInto(), the default returns false.
+     *
+     * \param fib The fiber to resample.
+     * \param size Receives the number of vertices after resampling.
+     * \param buffers Buffers of the calling thread.
+     *
+     * \return True if the size is known.
+     */
+    virtual bool getResampledSize( WFiberConstSpan const& fib, size_t* size, Buffers* buffers ) const;
+
+    /**
+     * Resample a fiber directly into the output. Only called if getResampledSize() returned true, the default copies
+     * the fiber and uses resample().
+     *
+     * \param fib The fiber to resample.
+     * \param target The vertices of the resampled fiber, as many as given by getResampledSize().
+     * \param buffers Buffers of the calling thread.
+     */
+    virtual void resampleInto( WFiberConstSpan const& fib, WFiberSpan const& target, Buffers* buffers ) const;
+
 private:
 };
 
@@ -37,6 +37,7 @@
 #include "WMFiberSelection.h"
 #include "WMFiberSelection.xpm"
 #include "core/common/WColor.h"
+#include "core/dataHandler/WFiberView.h"
 #include "core/kernel/WKernel.h"
 
 // This line is needed by the module loader to actually find your module.
@@ -225,9 +226,7 @@ void WMFiberSelection::moduleMain()
             bool   preferShortestPath = m_preferShortestPath->get( true );
 
             // get the fiber definitions
-            std::shared_ptr< std::vector< size_t > > fibStart = m_fibers->getLineStartIndexes();
-            std::shared_ptr< std::vector< size_t > > fibLen   = m_fibers->getLineLengths();
-            std::shared_ptr< std::vector< float > >  fibVerts = m_fibers->getVertices();
+            WFiberConstView const fibers = createFiberView( *m_fibers );
 
             // currently, both grids need to be the same
             // the grid of voi1 and voi2 is needed here
@@ -238,7 +237,7 @@ void WMFiberSelection::moduleMain()
             std::vector< boost::tuple< size_t, size_t, size_t > > matches;  // a match contains the fiber ID, the start vertex ID and the stop ID
 
             // progress indication
-            std::shared_ptr< WProgress > progress1( new WProgress( "Checking fibers against ", fibStart->size() ) );
+            std::shared_ptr< WProgress > progress1( new WProgress( "Checking fibers against ", fibers.size() ) );
             m_progress->addSubProgress( progress1 );
 
             // there are several scenarios possible, how the VOIs can be. They can intersect each other, one being inside the other or they might
@@ -247,15 +246,13 @@ void WMFiberSelection::moduleMain()
 
             // for each fiber:
             debugLog() << "Iterating over all fibers.";
-            for( size_t fidx = 0; fidx < fibStart->size() ; ++fidx )
+            for( size_t fidx = 0; fidx < fibers.size() ; ++fidx )
             {
                 ++*progress1;
 
-                // the start vertex index
-                size_t sidx = fibStart->at( fidx ) * 3;
-
-                // the length of the fiber
-                size_t len = fibLen->at( fidx );
+                // the vertices of the fiber
+                WFiberConstSpan const fiber = fibers[ fidx ];
+                size_t len = fiber.size();
 
                 // trace information for both VOI
                 FibTrace current1 = { 0, true, false, false };  // NOLINT
@@ -266,16 +263,15 @@ void WMFiberSelection::moduleMain()
                 // walk along the fiber
                 for( size_t k = 0; k < len; ++k )
                 {
-                    float x = fibVerts->at( ( 3 * k ) + sidx );
-                    float y = fibVerts->at( ( 3 * k ) + sidx + 1 );
-                    float z = fibVerts->at( ( 3 * k ) + sidx + 2 );
+                    WPosition const position = fiber.getPosition( k );
 
                     // get the voxel id
-                    int voxel1 = grid1->getVoxelNum( WPosition( x, y, z ) );
-                    int voxel2 = grid2->getVoxelNum( WPosition( x, y, z ) );
+                    int voxel1 = grid1->getVoxelNum( position );
+                    int voxel2 = grid2->getVoxelNum( position );
                     if( ( voxel1 < 0 ) || ( voxel2 < 0 ) )
                     {
-                        warnLog() << "Fiber vertex (" << x << "," << y << "," << z << ") not in VOI1 or VOI2 grid. Ignoring vertex.";
+                        warnLog() << "Fiber vertex (" << position[0] << "," << position[1] << "," << position[2]
+                                  << ") not in VOI1 or VOI2 grid. Ignoring vertex.";
                         continue;
                     }
 
@@ -348,12 +344,6 @@ void WMFiberSelection::moduleMain()
             infoLog() << "Found " << matches.size() << " fibers going through VOI1 and VOI2.";
 
             // combine it to a new fiber dataset
-            // the required arrays:
-            std::shared_ptr< std::vector< float > >  newFibVerts( new std::vector< float >() );
-            std::shared_ptr< std::vector< size_t > > newFibStart( new std::vector< size_t >() );
-            std::shared_ptr< std::vector< size_t > > newFibLen( new std::vector< size_t >() );
-            std::shared_ptr< std::vector< size_t > > newFibVertsRev( new std::vector< size_t >() );
-
             progress1 = std::shared_ptr< WProgress >( new WProgress( "Creating Output Dataset.", matches.size() ) );
             m_progress->addSubProgress( progress1 );
             debugLog() << "Creating new Fiber Dataset and Cluster.";
@@ -361,21 +351,26 @@ void WMFiberSelection::moduleMain()
             // the cluster which gets iteratively build
             std::shared_ptr< WFiberCluster > newFiberCluster( new WFiberCluster() );
 
-            // add each match to the above arrays
-            size_t curVertIdx = 0;  // the current index in the vertex array
+            // first determine the part of each match which is kept, so the output arrays can be allocated at once
+            std::vector< size_t > sourceFibers;   // the original fiber of each new fiber
+            std::vector< size_t > sourceOffsets;  // the first vertex of the original fiber which is kept
+            std::shared_ptr< std::vector< size_t > > newFibLen( new std::vector< size_t >() );
+            sourceFibers.reserve( matches.size() );
+            sourceOffsets.reserve( matches.size() );
+            newFibLen->reserve( matches.size() );
             size_t curRealFibIdx = 0; // since some fibers get discarded, the for loop counter "i" is not the correct fiber index
             for( size_t i = 0; i < matches.size(); ++i )
             {
                 ++*progress1;
 
-                // start index and length of original fiber
-                size_t sidx = fibStart->at( matches[ i ].get< 0 >() ) * 3;
-                size_t len = fibLen->at( matches[ i ].get< 0 >() );
+                // start offset and length of original fiber
+                size_t offset = 0;
+                size_t len = fibers.getLength( matches[ i ].get< 0 >() );
 
                 if( cutFibers )
                 {
                     // if the fibers should be cut: add an offset to the start index and recalculate the length
-                    sidx = sidx + ( matches[ i ].get< 1 >() * 3 );
+                    offset = matches[ i ].get< 1 >();
                     len =  matches[ i ].get< 2 >() - matches[ i ].get< 1 >();
                 }
 
@@ -385,31 +380,30 @@ void WMFiberSelection::moduleMain()
                     continue;
                 }
 
-                // set the new length
+                sourceFibers.push_back( matches[ i ].get< 0 >() );
+                sourceOffsets.push_back( offset );
                 newFibLen->push_back( len );
 
-                // set new start index
-                newFibStart->push_back( curVertIdx );
-
                 // copy the index to the cluster
                 WFiberCluster a( curRealFibIdx );
                 newFiberCluster->merge( a );
 
-                // copy the fiber vertices
-                for( size_t vi = 0; vi < len; ++vi )
-                {
-                    curVertIdx++;
-
-                    newFibVerts->push_back( fibVerts->at( sidx + ( 3 * vi ) ) );
-                    newFibVerts->push_back( fibVerts->at( sidx + ( 3 * vi ) + 1 ) );
-                    newFibVerts->push_back( fibVerts->at( sidx + ( 3 * vi ) + 2 ) );
-                    newFibVertsRev->push_back( curRealFibIdx );
-                    newFibVertsRev->push_back( curRealFibIdx );
-                    newFibVertsRev->push_back( curRealFibIdx );
-                }
-
                 curRealFibIdx++;
             }
+
+            // copy the fiber vertices into the preallocated arrays
+            std::shared_ptr< std::vector< size_t > > newFibStart = createStartIndexes( *newFibLen );
+            std::shared_ptr< std::vector< size_t > > newFibVertsRev = createVerticesReverse( *newFibLen );
+            std::shared_ptr< std::vector< float > > newFibVerts( new std::vector< float >( 3 * newFibVertsRev->size() ) );
+            WFiberView const newFiberView = createFiberView( newFibVerts.get(), *newFibStart, *newFibLen );
+            forEachFiberBlock( newFiberView.size(), [ & ]( size_t begin, size_t end )
+            {
+                for( size_t i = begin; i < end; ++i )
+                {
+                    float const* source = fibers[ sourceFibers[ i ] ][ sourceOffsets[ i ] ];
+                    std::copy( source, source + 3 * newFiberView.getLength( i ), newFiberView[ i ].data() );
+                }
+            } );
             progress1->finish();
 
             // create the new dataset
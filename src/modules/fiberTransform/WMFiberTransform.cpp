@@ -24,10 +24,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "WMFiberTransform.h"
 #include "WMFiberTransform.xpm"
 #include "core/common/WPropertyHelper.h"
+#include "core/dataHandler/WFiberView.h"
 #include "core/dataHandler/io/WWriterFiberVTK.h"
 
 // This line is needed by the module loader to actually find your module.
@@ -170,36 +172,32 @@ void WMFiberTransform::update()
     transformationMatrix( 3, 2 ) = m_matrix3Prop->get()[2];
     transformationMatrix( 3, 3 ) = 1.0;
 
-    std::shared_ptr< WProgress > progress( new WProgress( "Transforming", 4 + save ) );
+    std::shared_ptr< WProgress > progress( new WProgress( "Transforming", 2 + save ) );
     m_progress->addSubProgress( progress );
 
-    infoLog() << "Start: WDataSetFibers => WDataSetFiberVector";
-    std::shared_ptr< WDataSetFiberVector > dataset( new WDataSetFiberVector( m_rawDataset ) );
-    infoLog() << "Stop:  WDataSetFibers => WDataSetFiberVector";
-    ++*progress;
-
-    //transform
-    WValue< double > vec( 4 );
-    WValue< double > vec_transformed( 4 );
-    for( std::size_t fiberID = 0; fiberID < dataset->size(); ++fiberID )
+    // transform the flat vertex array directly into a new one, the fibers keep their start indexes and lengths
+    WDataSetFibers::VertexArray vertices( new std::vector< float >( m_rawDataset->getVertices()->size() ) );
+    WFiberConstView const in = createFiberView( *m_rawDataset );
+    WFiberView const out = createFiberView( vertices.get(), *m_rawDataset->getLineStartIndexes(), *m_rawDataset->getLineLengths() );
+    transformFibers( in, out, [ &transformationMatrix ]( WPosition const& p )
     {
-        WFiber& fiber = (*dataset)[fiberID];
-        for( std::size_t positionID = 0; positionID < fiber.size(); ++positionID )
+        WPosition transformed;
+        for( std::size_t i = 0; i < 3; ++i )
         {
-            vec[0] = fiber[positionID][0];
-            vec[1] = fiber[positionID][1];
-            vec[2] = fiber[positionID][2];
-            vec[3] = 1.0;
-            vec_transformed = transformationMatrix * vec;
-            vec_transformed = ( 1.0 / vec_transformed[3] ) * vec_transformed;
-            fiber[positionID] = WPosition( vec_transformed[0], vec_transformed[1], vec_transformed[2] );
+            transformed[i] = transformationMatrix( i, 0 ) * p[0] + transformationMatrix( i, 1 ) * p[1]
+                             + transformationMatrix( i, 2 ) * p[2] + transformationMatrix( i, 3 );
         }
-    }
+        double const w = transformationMatrix( 3, 0 ) * p[0] + transformationMatrix( 3, 1 ) * p[1]
+                         + transformationMatrix( 3, 2 ) * p[2] + transformationMatrix( 3, 3 );
+        return WPosition( ( 1.0 / w ) * transformed );
+    } );
     ++*progress;
 
-    infoLog() << "Start: WDataSetFibers <= WDataSetFiberVector";
-    m_output->updateData( dataset->toWDataSetFibers() );
-    infoLog() << "Stop:  WDataSetFibers <= WDataSetFiberVector";
+    std::shared_ptr< WDataSetFibers > dataset( new WDataSetFibers( vertices,
+                                                                  m_rawDataset->getLineStartIndexes(),
+                                                                  m_rawDataset->getLineLengths(),
+                                                                  m_rawDataset->getVerticesReverse() ) );
+    m_output->updateData( dataset );
     ++*progress;
 
     if( save )
@@ -74,26 +74,47 @@ void WCsvConverter::setOutputFromCSV( )
         return;
     }
 
-    WDataSetCSV::ContentSPtr data = m_protonData->getCSVData();
+    m_columns = m_protonData->getColumns();
+    m_indexes->update( m_protonData );
+
+    checkNumericColumn( m_indexes->getPosX() );
+    checkNumericColumn( m_indexes->getPosY() );
+    checkNumericColumn( m_indexes->getPosZ() );
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getEdep() ) )
+    {
+        checkNumericColumn( m_indexes->getEdep() );
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getParentId() ) )
+    {
+        checkNumericColumn( m_indexes->getParentID() );
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getPDG() ) )
+    {
+        checkNumericColumn( m_indexes->getPDGEncoding() );
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getEventId() ) )
+    {
+        checkNumericColumn( m_indexes->getEventID() );
+    }
 
     WColor plainColor = m_propertyStatus->getVisualizationPropertyHandler()->getColorSelection()->get( true );
 
     m_vectors->clear();
-    m_indexes->update( m_protonData );
 
     float maxEdep = 0.0;
     float minEdep = 1.0;
 
-    for( WDataSetCSV::Content::iterator dataRow = data->begin(); dataRow < data->end(); dataRow++ )
+    size_t const numRows = m_protonData->getNumberOfRows();
+    for( size_t row = 0; row < numRows; row++ )
     {
-        if( !checkConditionToPass( dataRow ) )
+        if( !hasRequiredValues( row ) || !checkConditionToPass( row ) )
         {
             continue;
         }
 
         if( m_protonData->isColumnAvailable( WSingleSelectorName::getEdep() ) )
         {
-            float edep = stringToDouble( dataRow->at( m_indexes->getEdep() ) );
+            float edep = getValue( m_indexes->getEdep(), row );
 
             if( getClusterSize( edep ) < 1.0 || getClusterSize( edep ) > 35.0 )
             {
@@ -101,10 +122,10 @@ void WCsvConverter::setOutputFromCSV( )
             }
         }
 
-        addVertex( dataRow );
+        addVertex( row );
         addColor( plainColor );
-        addEdepAndSize( dataRow, &maxEdep, &minEdep );
-        addEventID( dataRow );
+        addEdepAndSize( row, &maxEdep, &minEdep );
+        addEventID( row );
     }
 
     if( checkIfOutputIsNull() )
@@ -176,16 +197,11 @@ void WCsvConverter::normalizeEdeps( SPFloatVector edeps, SPFloatVector colorArra
     }
 }
 
-bool WCsvConverter::checkConditionToPass( WDataSetCSV::Content::iterator dataRow )
+bool WCsvConverter::checkConditionToPass( size_t row )
 {
-    if( dataRow->empty() )
-    {
-        return false;
-    }
-
     if( m_protonData->isColumnAvailable( WSingleSelectorName::getParentId() ) )
     {
-        int PrimaryValue = stringToInt( dataRow->at( m_indexes->getParentID() ) );
+        int PrimaryValue = static_cast< int >( getValue( m_indexes->getParentID(), row ) );
 
         if( !m_propertyStatus->getFilterPropertyHandler()->getShowPrimaries()->get() && PrimaryValue == 0 )
         {
@@ -201,7 +217,7 @@ bool WCsvConverter::checkConditionToPass( WDataSetCSV::Content::iterator dataRow
     if( m_protonData->isColumnAvailable( WSingleSelectorName::getPDG() ) )
     {
         if( !m_propertyStatus->getFilterPropertyHandler()->isPDGTypeSelected(
-           ( int )stringToDouble( dataRow->at( m_indexes->getPDGEncoding( ) ) ) ) )
+           ( int )getValue( m_indexes->getPDGEncoding(), row ) ) )
         {
             return false;
         }
@@ -209,12 +225,12 @@ bool WCsvConverter::checkConditionToPass( WDataSetCSV::Content::iterator dataRow
 
     if( m_protonData->isColumnAvailable( WSingleSelectorName::getEventId() ) )
     {
-        if( dataRow->at( m_indexes->getEventID() ) == "NULL" )
+        if( m_columns[ m_indexes->getEventID() ]->isMissing( row ) )
         {
             return true;
         }
 
-        int eventID = stringToInt( dataRow->at( m_indexes->getEventID() ) );
+        int eventID = static_cast< int >( getValue( m_indexes->getEventID(), row ) );
         if( eventID < m_propertyStatus->getEventIDLimitationPropertyHandler()->getMinCap()->get() ||
             eventID > m_propertyStatus->getEventIDLimitationPropertyHandler()->getMaxCap()->get() )
         {
@@ -225,11 +241,11 @@ bool WCsvConverter::checkConditionToPass( WDataSetCSV::Content::iterator dataRow
     return true;
 }
 
-void WCsvConverter::addVertex( WDataSetCSV::Content::iterator dataRow )
+void WCsvConverter::addVertex( size_t row )
 {
-    m_vectors->getVertices()->push_back( stringToDouble( dataRow->at( m_indexes->getPosX() ) ) );
-    m_vectors->getVertices()->push_back( stringToDouble( dataRow->at( m_indexes->getPosY() ) ) );
-    m_vectors->getVertices()->push_back( stringToDouble( dataRow->at( m_indexes->getPosZ() ) ) );
+    m_vectors->getVertices()->push_back( getValue( m_indexes->getPosX(), row ) );
+    m_vectors->getVertices()->push_back( getValue( m_indexes->getPosY(), row ) );
+    m_vectors->getVertices()->push_back( getValue( m_indexes->getPosZ(), row ) );
 }
 
 void WCsvConverter::addColor( WColor plainColor )
@@ -244,14 +260,14 @@ void WCsvConverter::addColor( WColor plainColor )
     }
 }
 
-void WCsvConverter::addEdepAndSize( WDataSetCSV::Content::iterator dataRow, float* maxEdep, float* minEdep )
+void WCsvConverter::addEdepAndSize( size_t row, float* maxEdep, float* minEdep )
 {
     if( !m_protonData->isColumnAvailable( WSingleSelectorName::getEdep() ) )
     {
         return;
     }
 
-    float edep = stringToDouble( dataRow->at( m_indexes->getEdep() ) );
+    float edep = getValue( m_indexes->getEdep(), row );
     if( edep > *maxEdep )
     {
         *maxEdep = edep;
@@ -396,16 +412,16 @@ void WCsvConverter::createOutputPointsAndData()
     }
 }
 
-void WCsvConverter::addEventID( WDataSetCSV::Content::iterator dataRow )
+void WCsvConverter::addEventID( size_t row )
 {
     if( m_protonData->isColumnAvailable( WSingleSelectorName::getEventId() ) )
     {
-        if( dataRow->at( m_indexes->getEventID() ) == "NULL" )
+        if( m_columns[ m_indexes->getEventID() ]->isMissing( row ) )
         {
             return;
         }
 
-        m_vectors->getEventIDs()->push_back( stringToInt( dataRow->at( m_indexes->getEventID() ) ) );
+        m_vectors->getEventIDs()->push_back( static_cast< int >( getValue( m_indexes->getEventID(), row ) ) );
     }
 }
 
@@ -437,6 +453,44 @@ float WCsvConverter::getClusterSize( float edep )
     return 7.6626f * powf( edep * 40.0f, 0.420307f );
 }
 
+double WCsvConverter::getValue( int column, size_t row ) const
+{
+    return m_columns[ column ]->getNumber( row );
+}
+
+void WCsvConverter::checkNumericColumn( int column ) const
+{
+    if( m_columns.at( column )->getType() == WCSVColumn::COLUMN_STRING )
+    {
+        throw WException( "The selected column has an incorrect format. Received: text in column " + m_columns[ column ]->getName() +
+                          ". Required: Numbers are expected." );
+    }
+}
+
+bool WCsvConverter::hasRequiredValues( size_t row ) const
+{
+    // the event id may be missing, such rows are handled in checkConditionToPass() and addEventID()
+    if( m_columns[ m_indexes->getPosX() ]->isMissing( row ) ||
+        m_columns[ m_indexes->getPosY() ]->isMissing( row ) ||
+        m_columns[ m_indexes->getPosZ() ]->isMissing( row ) )
+    {
+        return false;
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getEdep() ) && m_columns[ m_indexes->getEdep() ]->isMissing( row ) )
+    {
+        return false;
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getParentId() ) && m_columns[ m_indexes->getParentID() ]->isMissing( row ) )
+    {
+        return false;
+    }
+    if( m_protonData->isColumnAvailable( WSingleSelectorName::getPDG() ) && m_columns[ m_indexes->getPDGEncoding() ]->isMissing( row ) )
+    {
+        return false;
+    }
+    return true;
+}
+
 float WCsvConverter::stringToDouble( std::string str )
 {
     try
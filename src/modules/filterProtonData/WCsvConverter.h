@@ -48,7 +48,8 @@
 
 
 /**
- * Converts the csv data to points and fibers.
+ * Converts the csv data to points and fibers. The values are read from the typed columns of the csv data, so no strings
+ * are converted during the conversion.
  */
 class WCsvConverter
 {
@@ -148,6 +149,11 @@ private:
      */
     WPropertyStatus::SPtr m_propertyStatus;
 
+    /**
+     * The typed columns of the csv data
+     */
+    WDataSetCSV::Columns m_columns;
+
     /**
      * Computes gradient vector from transfer function specified in visualization properties.
      * \return shared_ptr of mapped gradim_plainColorent from transfer function in RGBA format
@@ -166,18 +172,18 @@ private:
 
     /**
      * checks whether the requirements are fulfilled.
-     * \param dataRow the row to check.
+     * \param row the row to check.
      * \return true The row can be displayed.
      * \return false The row can not be displayed.
      */
-    bool checkConditionToPass( WDataSetCSV::Content::iterator dataRow );
+    bool checkConditionToPass( size_t row );
 
     /**
      * Create vertex for point/fiber renderer
      *
-     * \param dataRow each row of the csv file (content of row)
+     * \param row index of the row of the csv file
      */
-    void addVertex( WDataSetCSV::Content::iterator dataRow );
+    void addVertex( size_t row );
 
     /**
      * Create color for point/Fiber renderer
@@ -189,18 +195,43 @@ private:
     /**
      * Create edep and sizes for point/fiber renderer
      *
-     * \param dataRow each row of the csv file (content of row)
+     * \param row index of the row of the csv file
      * \param maxEdep a pointer to the current maximum of the edep
      * \param minEdep a pointer to the current minimum of the edep
      */
-    void addEdepAndSize( WDataSetCSV::Content::iterator dataRow, float* maxEdep, float* minEdep );
+    void addEdepAndSize( size_t row, float* maxEdep, float* minEdep );
 
     /**
      * Create eventID for Fiber renderer
      *
-     * \param dataRow each row of the csv file (content of row)
+     * \param row index of the row of the csv file
+     */
+    void addEventID( size_t row );
+
+    /**
+     * Reads a cell of a numeric column
+     *
+     * \param column index of the column
+     * \param row index of the row
+     * \return the value, NaN for missing values
+     */
+    double getValue( int column, size_t row ) const;
+
+    /**
+     * Throws if a selected column does not contain numbers
+     *
+     * \param column index of the column
+     * \throws WException If the column contains text.
+     */
+    void checkNumericColumn( int column ) const;
+
+    /**
+     * Checks whether all selected numeric columns contain values in a row
+     *
+     * \param row index of the row
+     * \return true if no required value is missing
      */
-    void addEventID( WDataSetCSV::Content::iterator dataRow );
+    bool hasRequiredValues( size_t row ) const;
 
     /**
      * calculate the property of WDataSetFiber (index, length, verticesReverse)
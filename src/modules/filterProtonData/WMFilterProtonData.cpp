@@ -84,7 +84,7 @@ void WMFilterProtonData::moduleMain()
 
         if( m_protonData == NULL )
         {
-            m_protonData = WProtonData::SPtr( new WProtonData(  m_input->getData()->getHeader(),  m_input->getData()->getData() ) );
+            m_protonData = WProtonData::SPtr( new WProtonData( m_input->getData() ) );
 
             m_propertyStatus->setColumnPropertyHandler( WColumnPropertyHandler::SPtr( new WColumnPropertyHandler( m_protonData, m_properties,
                 boost::bind( &WMFilterProtonData::setOutputFromCSV, this ) ) ) );
@@ -105,8 +105,7 @@ void WMFilterProtonData::moduleMain()
         }
         else
         {
-            m_protonData->setCSVHeader( m_input->getData()->getHeader() );
-            m_protonData->setCSVData( m_input->getData()->getData() );
+            m_protonData->setCSVDataSet( m_input->getData() );
         }
         m_propertyStatus->getFilterPropertyHandler()->createPDGMap(
             ( m_localPath / getMetaInformation()->query< std::string >( "common/pdgnames" , "NoFile" ) ).string() );
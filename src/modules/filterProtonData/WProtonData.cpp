@@ -26,7 +26,6 @@
 #include <list>
 #include <string>
 #include <vector>
-#include <boost/lexical_cast.hpp>
 
 #include "WProtonData.h"
 
@@ -37,6 +36,11 @@ WProtonData::WProtonData( WDataSetCSV::ContentSPtr csvHeader, WDataSetCSV::Conte
     setCSVData( csvData );
 }
 
+WProtonData::WProtonData( std::shared_ptr< WDataSetCSV > csvDataSet )
+{
+    setCSVDataSet( csvDataSet );
+}
+
 void WProtonData::setCSVHeader( WDataSetCSV::ContentSPtr csvHeader )
 {
     if( csvHeader == nullptr )
@@ -73,14 +77,48 @@ void WProtonData::setCSVData( WDataSetCSV::ContentSPtr csvData )
         throw WException( "Can not set data! No data content found!" );
     }
 
-    m_csvData = csvData;
+    m_csvDataSet = std::shared_ptr< WDataSetCSV >( new WDataSetCSV( m_csvHeader, csvData ) );
 
-    detectColumnTypesFromCsvData( csvData );
+    detectColumnTypes();
+}
+
+void WProtonData::setCSVDataSet( std::shared_ptr< WDataSetCSV > csvDataSet )
+{
+    if( csvDataSet == nullptr )
+    {
+        throw WException( "Can not set data! No data specified!" );
+    }
+
+    setCSVHeader( csvDataSet->getHeader() );
+
+    if( csvDataSet->getNumberOfRows() == 0 )
+    {
+        throw WException( "Can not set data! No data content found!" );
+    }
+
+    m_csvDataSet = csvDataSet;
+
+    detectColumnTypes();
 }
 
 WDataSetCSV::ContentSPtr WProtonData::getCSVData()
 {
-    return m_csvData;
+    return m_csvDataSet->getData();
+}
+
+size_t WProtonData::getNumberOfRows()
+{
+    return m_csvDataSet->getNumberOfRows();
+}
+
+WCSVColumn::ConstSPtr WProtonData::getColumn( int columnIndex )
+{
+    return m_csvDataSet->getColumns().at( columnIndex );
+}
+
+WDataSetCSV::Columns const& WProtonData::getColumns()
+{
+    return m_csvDataSet->getColumns();
 }
 
 WDataSetCSV::ContentSPtr WProtonData::getCSVHeader()
@@ -120,32 +158,29 @@ WDataSetCSV::ContentElemSPtr WProtonData::getColumnTypes()
     return m_columnTypes;
 }
 
-void WProtonData::detectColumnTypesFromCsvData( WDataSetCSV::ContentSPtr csvData )
+void WProtonData::detectColumnTypes()
 {
     m_columnTypes = WDataSetCSV::ContentElemSPtr( new std::vector< std::string >() );
 
-    auto currentRow = csvData->begin();
-
-    // determine column types based on first csv data row
-    for( auto cell : *currentRow )
+    // the reader already determined the most specific type of each column
+    for( WCSVColumn::ConstSPtr column : m_csvDataSet->getColumns() )
     {
-        m_columnTypes->push_back( determineColumnTypeByString( cell ) );
+        switch( column->getType() )
+        {
+            case WCSVColumn::COLUMN_INT:
+                m_columnTypes->push_back( WDataType::getInt() );
+                break;
+            case WCSVColumn::COLUMN_DOUBLE:
+                m_columnTypes->push_back( WDataType::getDouble() );
+                break;
+            default:
+                m_columnTypes->push_back( WDataType::getString() );
+                break;
+        }
     }
 
-    assert( m_columnTypes != nullptr );
     assert( !m_columnTypes->empty() );
     assert( m_columnTypes->size() == m_csvHeader->at( 0 ).size() );
-
-    for( size_t idx = 0; idx < m_columnTypes->size(); idx++ )
-    {
-        if( m_columnTypes->at( idx ) == WDataType::getDouble() )
-        {
-            if( checkIfDoubleColumnCanBeInteger( idx ) )
-            {
-                m_columnTypes->at( idx ) = WDataType::getInt();
-            }
-        }
-    }
 }
 
 std::string WProtonData::determineColumnTypeByString( std::string cellValue )
@@ -167,25 +202,6 @@ std::string WProtonData::determineColumnTypeByString( std::string cellValue )
     }
 }
 
-bool WProtonData::checkIfDoubleColumnCanBeInteger( int columnNumber )
-{
-    double doubleValue;
-    int intValue;
-
-    for( auto row : *m_csvData )
-    {
-        doubleValue = boost::lexical_cast< double >( row.at( columnNumber ) );
-        intValue = ( int )doubleValue;
-
-        if( doubleValue - intValue != 0 )
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 std::vector< std::string > WProtonData::getHeaderFromType( std::list< std::string > typeNames )
 {
     std::vector< std::string > header = m_csvHeader->at( 0 );
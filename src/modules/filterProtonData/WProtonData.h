@@ -37,7 +37,7 @@
 
 
 /**
- * Holds the csv data.
+ * Holds the csv data. The cells are accessed through the typed columns of WDataSetCSV.
  */
 class WProtonData
 {
@@ -59,6 +59,13 @@ public:
      */
     explicit WProtonData( WDataSetCSV::ContentSPtr csvHeader, WDataSetCSV::ContentSPtr csvData );
 
+    /**
+     * constructor
+     *
+     * \param csvDataSet the dataset created by the csv reader
+     */
+    explicit WProtonData( std::shared_ptr< WDataSetCSV > csvDataSet );
+
     /**
      * getter
      *
@@ -87,6 +94,35 @@ public:
      */
     void setCSVData( WDataSetCSV::ContentSPtr csvData );
 
+    /**
+     * setter, replaces header and data
+     *
+     * \param csvDataSet the dataset created by the csv reader
+     */
+    void setCSVDataSet( std::shared_ptr< WDataSetCSV > csvDataSet );
+
+    /**
+     * getter
+     *
+     * \return the number of data rows
+     */
+    size_t getNumberOfRows();
+
+    /**
+     * getter
+     *
+     * \param columnIndex position of column-header of the CSV-file
+     * \return the typed column
+     */
+    WCSVColumn::ConstSPtr getColumn( int columnIndex );
+
+    /**
+     * getter
+     *
+     * \return all typed columns in the order of the column-header
+     */
+    WDataSetCSV::Columns const& getColumns();
+
     /**
      * setter
      *
@@ -141,7 +177,7 @@ private:
     /**
      * Stores data from obtained input file.
      */
-    WDataSetCSV::ContentSPtr m_csvData;
+    std::shared_ptr< WDataSetCSV > m_csvDataSet;
 
     /**
      * Stores data as map
@@ -159,10 +195,9 @@ private:
     WDataSetCSV::ContentElemSPtr m_columnTypes;
 
     /**
-     * Reads csv data and stores column types in m_columnTypes
-     * \param csvData the input csv data
+     * Stores the column types of the typed columns in m_columnTypes
      */
-    void detectColumnTypesFromCsvData( WDataSetCSV::ContentSPtr csvData );
+    void detectColumnTypes();
 
     /**
      * Determines column type due to cellValue
@@ -170,13 +205,6 @@ private:
      * \return either "int", "double" or "string"
      */
     std::string determineColumnTypeByString( std::string cellValue );
-
-    /**
-     * Checks, if values of a column, containing double values, can be converted to integers
-     * \param columnNumber the column number within m_csvHeader
-     * \return true, if all double values of a column ends with ".0"; false otherwise
-     */
-    bool checkIfDoubleColumnCanBeInteger( int columnNumber );
 };
 
 #endif  // WPROTONDATA_H
@@ -82,19 +82,32 @@ void WEventIDLimitationPropertyHandler::determineMinMaxEventID()
         return;
     }
 
-    int minCap = std::stoi( m_protonData->getCSVData()->front().at( eventIDIndex ) );
-    int maxCap = maxCap;
-    for( auto iter = m_protonData->getCSVData()->begin(); iter != m_protonData->getCSVData()->end(); iter++ )
+    WCSVColumn::ConstSPtr column = m_protonData->getColumn( eventIDIndex );
+    if( column->getType() == WCSVColumn::COLUMN_STRING )
     {
-        int calc = std::stoi( ( *iter ).at( eventIDIndex ) );
-        if( calc < minCap )
+        return;
+    }
+
+    bool found = false;
+    int minCap = 0;
+    int maxCap = 0;
+    for( size_t row = 0; row < column->size(); row++ )
+    {
+        if( column->isMissing( row ) )
+        {
+            continue;
+        }
+
+        int calc = static_cast< int >( column->getNumber( row ) );
+        if( !found || calc < minCap )
         {
             minCap = calc;
         }
-        if( calc > maxCap )
+        if( !found || calc > maxCap )
         {
             maxCap = calc;
         }
+        found = true;
     }
 
     m_minCap->setMin( minCap );
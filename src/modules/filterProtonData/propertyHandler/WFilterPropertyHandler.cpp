@@ -109,25 +109,21 @@ void WFilterPropertyHandler::searchPDGTypes()
         return;
     }
 
-    for( size_t idx = 0; idx < m_protonData->getCSVData()->size(); idx++ )
+    WCSVColumn::ConstSPtr column = m_protonData->getColumn( pdgColumnIndex );
+    if( column->getType() == WCSVColumn::COLUMN_STRING )
     {
-        std::vector< std::string > row = m_protonData->getCSVData()->at( idx );
-        std::string rowContent = row.at( pdgColumnIndex );
-
-        int currentParticleID = -1;
+        throw WException( "The selected column has an incorrect format. Received: text in column " + column->getName() +
+                          ". Required: Numbers are expected." );
+    }
 
-        try
+    for( size_t idx = 0; idx < column->size(); idx++ )
+    {
+        if( column->isMissing( idx ) )
         {
-            currentParticleID = ( int ) boost::lexical_cast< double >( rowContent );
+            continue;
         }
-        catch( const boost::bad_lexical_cast &e )
-        {
-            std::string errorMessage = "The selected column has an incorrect format. Received: " +
-                                        rowContent + ". Required: Numbers are expected. " +
-                                        std::string( e.what() );
 
-            throw WException( errorMessage );
-        }
+        int currentParticleID = static_cast< int >( column->getNumber( idx ) );
 
         if( std::find( m_pdgTypes.begin(), m_pdgTypes.end(), currentParticleID ) == m_pdgTypes.end() )
         {
@@ -61,7 +61,8 @@ const std::string WMFunctionalMRIViewer::getName() const
 
 const std::string WMFunctionalMRIViewer::getDescription() const
 {
-    return "Allows one to select a point of time and to show the dataset at that point of time.";
+    return "Allows one to select a point of time and to show the dataset at that point of time. Can also compute the correlation"
+           " of the time course at a seed position with all other voxels.";
 }
 
 void WMFunctionalMRIViewer::connectors()
@@ -75,8 +76,13 @@ void WMFunctionalMRIViewer::connectors()
                             new WModuleOutputData< WDataSetScalar >( shared_from_this(),
                                 "out", "The selected time slice." ) );
 
+    m_correlationOutput = std::shared_ptr< WModuleOutputData< WDataSetScalar > >(
+                            new WModuleOutputData< WDataSetScalar >( shared_from_this(),
+                                "correlation", "The correlation of the seed voxel's time course with all voxels." ) );
+
     addConnector( m_input );
     addConnector( m_output );
+    addConnector( m_correlationOutput );
 
     WModule::connectors();
 }
@@ -91,6 +97,11 @@ void WMFunctionalMRIViewer::properties()
 
     m_texScaleNormalized = m_properties->addProperty( "Norm. Tex Scale", "Use the same texture scaling for all textures.", true, m_propCondition );
 
+    m_seedCorrelation = m_properties->addProperty( "Seed correlation", "Compute the correlation of the time course at the seed "
+                                                   "position with the time courses of all voxels.", false, m_propCondition );
+    m_seed = m_properties->addProperty( "Seed position", "The position of the seed voxel in world coordinates.", WPosition( 0.0, 0.0, 0.0 ),
+                                        m_propCondition );
+
     WModule::properties();
 }
 
@@ -143,6 +154,26 @@ void WMFunctionalMRIViewer::moduleMain()
             }
             m_output->updateData( m_dataSetAtTime );
         }
+
+        if( m_dataSet && m_seedCorrelation->get() && ( dataChanged || m_seedCorrelation->changed() || m_seed->changed() ) )
+        {
+            m_seedCorrelation->get( true );
+            int seedVoxel = m_dataSet->getGrid()->getVoxelNum( m_seed->get( true ) );
+            if( seedVoxel < 0 )
+            {
+                warnLog() << "The seed position is outside the grid.";
+                m_correlationOutput->updateData( std::shared_ptr< WDataSetScalar >() );
+            }
+            else
+            {
+                // the first call sets up the voxel-major layout of the time series, further seeds are cheap
+                m_correlationOutput->updateData( m_dataSet->calcSeedCorrelation( static_cast< std::size_t >( seedVoxel ) ) );
+            }
+        }
+        else if( m_seedCorrelation->changed() && !m_seedCorrelation->get( true ) )
+        {
+            m_correlationOutput->updateData( std::shared_ptr< WDataSetScalar >() );
+        }
     }
 
     if( m_dataSetAtTime )
@@ -34,7 +34,8 @@
 #include "core/kernel/WModuleOutputData.h"
 
 /**
- * Views a time series at different points in time.
+ * Views a time series at different points in time. Optionally computes the correlation of the time course of a seed
+ * voxel with the time courses of all other voxels.
  *
  * \class WMFunctionalMRIViewer
  * \ingroup modules
@@ -107,12 +108,21 @@ private:
     //! The output connector for the currently selected time slice.
     std::shared_ptr< WModuleOutputData< WDataSetScalar > > m_output;
 
+    //! The output connector for the seed correlation map.
+    std::shared_ptr< WModuleOutputData< WDataSetScalar > > m_correlationOutput;
+
     //! The current time.
     WPropDouble m_time;
 
     //! True, iff all textures should be scaled to the same intervall.
     WPropBool m_texScaleNormalized;
 
+    //! True, iff the seed correlation map should be computed.
+    WPropBool m_seedCorrelation;
+
+    //! The position of the seed voxel.
+    WPropPosition m_seed;
+
     //! A condition for property changes.
     std::shared_ptr< WCondition > m_propCondition;
 };
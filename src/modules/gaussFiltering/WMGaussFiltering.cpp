@@ -35,6 +35,7 @@
 #include "core/common/WAssert.h"
 #include "core/common/WProgress.h"
 #include "core/common/WStringUtils.h"
+#include "core/common/exceptions/WComputationCancelled.h"
 #include "core/dataHandler/WGridRegular3D.h"
 #include "core/kernel/WKernel.h"
 
@@ -200,7 +201,8 @@ void WMGaussFiltering::filterField1D( std::vector<T>* newVals,
 }
 
 template< typename T >
-std::shared_ptr< WValueSet< double > > WMGaussFiltering::iterativeFilterField( std::shared_ptr< WValueSet< T > > vals, unsigned int iterations )
+std::shared_ptr< WValueSet< double > > WMGaussFiltering::iterativeFilterField( std::shared_ptr< WValueSet< T > > vals, unsigned int iterations,
+                                                                                WCancelToken::ConstSPtr cancelToken )
 {
     // the grid used
     std::shared_ptr<WGridRegular3D> grid = std::dynamic_pointer_cast< WGridRegular3D >( m_dataSet->getGrid() );
@@ -219,21 +221,31 @@ std::shared_ptr< WValueSet< double > > WMGaussFiltering::iterativeFilterField( s
         prog = std::shared_ptr< WProgress >(
             new WProgress( "Gauss Filter Iteration", 3 * iterations * grid->getNbCoordsZ() ) );
     }
+    prog->setCancelToken( cancelToken );
     m_progress->addSubProgress( prog );
 
-    // iterate filter, apply at least once
-    std::shared_ptr< WValueSet< double > > valueSet = std::shared_ptr< WValueSet< double > >(
-        new WValueSet<double> ( vals->order(), vals->dimension(),
-        std::shared_ptr< std::vector< double > >( new std::vector< double >( filterField( vals, grid, prog ) ) ),
-        W_DT_DOUBLE )
-    );
-    for( unsigned int i = 1; i < iterations; ++i )    // this only runs if iter > 1
+    std::shared_ptr< WValueSet< double > > valueSet;
+    try
     {
+        // iterate filter, apply at least once
         valueSet = std::shared_ptr< WValueSet< double > >(
-            new WValueSet<double> ( valueSet->order(), valueSet->dimension(),
-            std::shared_ptr< std::vector< double > >( new std::vector< double >( filterField( valueSet, grid, prog ) ) ),
+            new WValueSet<double> ( vals->order(), vals->dimension(),
+            std::shared_ptr< std::vector< double > >( new std::vector< double >( filterField( vals, grid, prog ) ) ),
             W_DT_DOUBLE )
         );
+        for( unsigned int i = 1; i < iterations; ++i )    // this only runs if iter > 1
+        {
+            valueSet = std::shared_ptr< WValueSet< double > >(
+                new WValueSet<double> ( valueSet->order(), valueSet->dimension(),
+                std::shared_ptr< std::vector< double > >( new std::vector< double >( filterField( valueSet, grid, prog ) ) ),
+                W_DT_DOUBLE )
+            );
+        }
+    }
+    catch( WComputationCancelled const& )
+    {
+        // the progress finished itself
+        return std::shared_ptr< WValueSet< double > >();
     }
 
     prog->finish();
@@ -246,7 +258,10 @@ void WMGaussFiltering::moduleMain()
     // let the main loop awake if the data changes or the properties changed.
     m_moduleState.setResetable( true, true );
     m_moduleState.add( m_input->getDataChangedCondition() );
-    m_moduleState.add( m_propCondition );
+
+    // the properties use the condition of the scheduler, which already is part of m_moduleState. New data has to request a
+    // recomputation too.
+    m_recomputeScheduler.add( m_input->getDataChangedCondition() );
 
     // signal ready state
     ready();
@@ -258,9 +273,13 @@ void WMGaussFiltering::moduleMain()
     while( !m_shutdownFlag() )
     {
         // Now, the moduleState variable comes into play. The module can wait for the condition, which gets fired whenever the input receives data
-        // or an property changes. The main loop now waits until something happens.
-        debugLog() << "Waiting ...";
-        m_moduleState.wait();
+        // or an property changes. The main loop now waits until something happens. A change during the last run cancelled it, restart
+        // right away in this case.
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            debugLog() << "Waiting ...";
+            m_moduleState.wait();
+        }
 
         // woke up since the module is requested to finish
         if( m_shutdownFlag() )
@@ -268,6 +287,17 @@ void WMGaussFiltering::moduleMain()
             break;
         }
 
+        // wait until the changes calm down, then use the latest data and properties
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            continue;
+        }
+        WCancelToken::SPtr cancelToken = m_recomputeScheduler.start();
+        if( cancelToken->isCancelled() )
+        {
+            continue;
+        }
+
         // has the data changed?
         std::shared_ptr< WDataSetScalar > newDataSet = m_input->getData();
         bool dataChanged = ( m_dataSet != newDataSet );
@@ -289,21 +319,19 @@ void WMGaussFiltering::moduleMain()
             }
         }
 
-        // m_iterations changed
-        if( m_iterations->changed() )
+        // every request needs a recalculation, a cancelled run already reset the changed flags of the properties
+        iterations = m_iterations->get( true );
+        if( iterations >= 1 )
         {
-            // a changed number of iteration also requires recalculation
-            iterations = m_iterations->get( true );
-            dataChanged = ( iterations >= 1 );
-        }
-
-        if( m_3DMaskMode->changed() )
-        {
-            dataChanged = true;
-        }
+            // the result only depends on the data and the properties, reuse it if it was computed before
+            WResultKey key( getName() );
+            key.add( m_dataSet ).add( m_iterations ).add( m_3DMaskMode );
+            if( m_output->updateDataFromCache( key ) )
+            {
+                debugLog() << "Using the cached result.";
+                continue;
+            }
 
-        if( dataChanged )
-        {
             std::shared_ptr< WValueSet< double > >  newValueSet;
 
             switch( ( *m_dataSet ).getValueSet()->getDataType() )
@@ -313,7 +341,7 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<unsigned char> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<unsigned char> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 case W_DT_INT16:
@@ -321,7 +349,7 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<int16_t> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<int16_t> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 case W_DT_UINT16:
@@ -329,7 +357,7 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<uint16_t> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<uint16_t> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 case W_DT_SIGNED_INT:
@@ -337,7 +365,7 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<int32_t> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<int32_t> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 case W_DT_FLOAT:
@@ -345,7 +373,7 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<float> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<float> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 case W_DT_DOUBLE:
@@ -353,19 +381,24 @@ void WMGaussFiltering::moduleMain()
                     std::shared_ptr<WValueSet<double> > vals;
                     vals = std::dynamic_pointer_cast<WValueSet<double> >( ( *m_dataSet ).getValueSet() );
                     WAssert( vals, "Data type and data type indicator must fit." );
-                    newValueSet = iterativeFilterField( vals, iterations );
+                    newValueSet = iterativeFilterField( vals, iterations, cancelToken );
                     break;
                 }
                 default:
                     WAssert( false, "Unknown data type in Gauss Filtering module" );
             }
 
-            m_output->updateData( std::shared_ptr<WDataSetScalar>( new WDataSetScalar( newValueSet, m_dataSet->getGrid() ) ) );
-        }
+            if( !newValueSet )
+            {
+                debugLog() << "Cancelled, restarting with the latest values.";
+                continue;
+            }
 
-        // if the number of iterations is 0 -> simply set the input as output
-        if( iterations == 0 )
+            m_output->updateData( std::shared_ptr<WDataSetScalar>( new WDataSetScalar( newValueSet, m_dataSet->getGrid() ) ), key );
+        }
+        else
         {
+            // if the number of iterations is 0 -> simply set the input as output
             m_output->updateData( m_dataSet );
         }
     }
@@ -395,7 +428,8 @@ void WMGaussFiltering::connectors()
 
 void WMGaussFiltering::properties()
 {
-    m_propCondition = std::shared_ptr< WCondition >( new WCondition() );
+    // changes cancel the running filter and restart it with the latest values
+    m_propCondition = m_recomputeScheduler.getCondition();
 
     m_iterations = m_properties->addProperty( "Iterations", "How often should the filter be applied.", 1, m_propCondition );
     m_iterations->setMin( 0 );
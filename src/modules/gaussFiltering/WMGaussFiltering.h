@@ -103,7 +103,7 @@ protected:
 
 private:
     /**
-     * A condition used to notify about changes in several properties.
+     * A condition used to notify about changes in several properties. This is the condition of m_recomputeScheduler.
      */
     std::shared_ptr< WCondition > m_propCondition;
 
@@ -187,11 +187,13 @@ private:
      *
      * \param vals the valueset to work on
      * \param iterations the number of iterations. If this value is <=1 then the filter gets applied exactly once.
+     * \param cancelToken the filter throws a WComputationCancelled after this got cancelled
      *
-     * \return the filtered valueset.
+     * \return the filtered valueset, NULL if cancelled.
      */
     template< typename T > std::shared_ptr< WValueSet< double > > iterativeFilterField( std::shared_ptr< WValueSet< T > > vals,
-                                                                                          unsigned int iterations );
+                                                                                          unsigned int iterations,
+                                                                                          WCancelToken::ConstSPtr cancelToken );
 
     std::shared_ptr< WModuleInputData< WDataSetScalar > > m_input;  //!< Input connector required by this module.
     std::shared_ptr< WModuleOutputData< WDataSetScalar > > m_output; //!< The only output of this filter module.
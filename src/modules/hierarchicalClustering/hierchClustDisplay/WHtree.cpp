@@ -62,12 +62,137 @@
 #include <algorithm>
 #include <string>
 #include <fstream>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #include "core/common/WStringUtils.h"
 #include "core/common/exceptions/WFileOpenFailed.h"
 #include "core/common/WLogger.h"
 #include "WHtree.h"
 
+namespace
+{
+    //! signature at the start of every binary tree file
+    const char BINARY_TREE_MAGIC[8] = { 'W', 'H', 'T', 'R', 'E', 'E', 'B', '1' }; // NOLINT curly braces
+
+    //! version of the binary tree layout
+    const boost::uint32_t BINARY_TREE_VERSION = 1;
+
+    //! written in host byte order, used to reject files from machines with different endianness
+    const boost::uint32_t BINARY_TREE_ENDIAN_CHECK = 0x01020304;
+
+    //! all tables of a binary tree file start at a multiple of this alignment
+    const size_t BINARY_TREE_ALIGNMENT = 8;
+
+    /**
+     * header of a binary tree file, followed by the tables in the order of its counters
+     */
+    struct WHtreeBinaryHeader
+    {
+        char m_magic[8]; //!< BINARY_TREE_MAGIC
+        boost::uint32_t m_endianCheck; //!< BINARY_TREE_ENDIAN_CHECK
+        boost::uint32_t m_version; //!< BINARY_TREE_VERSION
+        boost::uint32_t m_grid; //!< coordinate grid of the stored coordinates
+        boost::uint32_t m_hasColors; //!< whether partition colors are stored
+        float m_datasetSize[3]; //!< size of the dataset
+        float m_logFactor; //!< logarithmic normalization factor
+        float m_cpcc; //!< cpcc value
+        boost::uint32_t m_padding; //!< unused
+        boost::uint64_t m_numStreamlines; //!< number of streamlines per seed voxel
+        boost::uint64_t m_numLeaves; //!< number of leaves, leaf parents and coordinates
+        boost::uint64_t m_numNodes; //!< number of node records
+        boost::uint64_t m_numChildEntries; //!< size of the child table
+        boost::uint64_t m_numTrackIds; //!< number of track ids, 0 or the number of leaves
+        boost::uint64_t m_numDiscarded; //!< number of discarded coordinates
+        boost::uint64_t m_numPartitions; //!< number of selected partitions
+        boost::uint64_t m_numPartitionEntries; //!< total number of clusters of all selected partitions
+    };
+
+    /**
+     * a node as stored in a binary tree file
+     */
+    struct WHtreeBinaryNode
+    {
+        boost::uint64_t m_parent; //!< encoded id of the parent
+        boost::uint64_t m_firstChild; //!< position of the first child in the child table
+        boost::uint64_t m_size; //!< number of leaves contained
+        boost::uint32_t m_numChildren; //!< number of children
+        boost::uint32_t m_hLevel; //!< hierarchical level
+        float m_distance; //!< distance level
+        boost::uint32_t m_padding; //!< unused
+    };
+
+    /**
+     * encodes a full node id into a single integer, the highest bit stores whether the id refers to a node
+     * \param id the full id
+     * \return the encoded id
+     */
+    boost::uint64_t encodeNodeID( const nodeID_t &id )
+    {
+        return ( static_cast< boost::uint64_t >( id.first ) << 63 ) | static_cast< boost::uint64_t >( id.second );
+    }
+
+    /**
+     * decodes a node id encoded with encodeNodeID()
+     * \param code the encoded id
+     * \return the full id
+     */
+    nodeID_t decodeNodeID( const boost::uint64_t code )
+    {
+        return std::make_pair( ( code >> 63 ) != 0, static_cast< size_t >( code & ~( static_cast< boost::uint64_t >( 1 ) << 63 ) ) );
+    }
+
+    /**
+     * size of a table including the padding to the next aligned position
+     * \param bytes size of the table content
+     * \return aligned size
+     */
+    size_t alignedSize( const size_t bytes )
+    {
+        return ( ( bytes + BINARY_TREE_ALIGNMENT - 1 ) / BINARY_TREE_ALIGNMENT ) * BINARY_TREE_ALIGNMENT;
+    }
+
+    /**
+     * writes a table to a binary tree file and pads it to the alignment
+     * \param outFile the file stream
+     * \param data the table content
+     * \param bytes size of the table content
+     */
+    void writeBinaryTable( std::ofstream &outFile, const void* data, const size_t bytes )
+    {
+        if( bytes != 0 )
+        {
+            outFile.write( static_cast< const char* >( data ), bytes );
+        }
+        const char padding[BINARY_TREE_ALIGNMENT] = { 0 }; // NOLINT curly braces
+        outFile.write( padding, alignedSize( bytes ) - bytes );
+    }
+
+    /**
+     * converts a coordinate to the grid the tree is written in
+     * \param coord the coordinate in the grid of the tree
+     * \param grid the grid of the tree
+     * \param datasetSize the size of the dataset
+     * \param niftiMode whether the output is in nifti coordinates
+     * \return the converted coordinate
+     */
+    WHcoord coordForOutput( const WHcoord &coord, const HC_GRID grid, const WHcoord &datasetSize, const bool niftiMode )
+    {
+        if( niftiMode && grid == HC_VISTA )
+        {
+            return coord.vista2nifti( datasetSize );
+        }
+        if( !niftiMode && grid == HC_NIFTI )
+        {
+            return coord.nifti2vista( datasetSize );
+        }
+        return coord;
+    }
+}
+
 
 
 WHtree::WHtree(): m_loadStatus( false ), m_cpcc( 0 )
@@ -114,7 +239,15 @@ WHtree::WHtree( const WHtree &object )
       m_coordinates( object.m_coordinates ),
       m_trackids( object.m_trackids ),
       m_discarded( object.m_discarded ),
-      m_containedLeaves( object.m_containedLeaves )
+      m_containedLeaves( object.m_containedLeaves ),
+      m_eulerLeaves( object.m_eulerLeaves ),
+      m_eulerLeafBegin( object.m_eulerLeafBegin ),
+      m_eulerLeafEnd( object.m_eulerLeafEnd ),
+      m_eulerNodePos( object.m_eulerNodePos ),
+      m_eulerBranchSize( object.m_eulerBranchSize ),
+      m_eulerDepth( object.m_eulerDepth ),
+      m_eulerLog2( object.m_eulerLog2 ),
+      m_eulerSparseTable( object.m_eulerSparseTable )
 {
 }
 
@@ -392,6 +525,13 @@ std::vector<size_t> WHtree::getLeaves4node( const size_t nodeID ) const
         {
             return m_containedLeaves[nodeID];
         }
+        else if( hasEulerIndex() ) // if the depth-first index is loaded, the leaves are a contiguous range of it
+        {
+            leafRange_t range( getLeafRange4node( nodeID ) );
+            returnVector.assign( range.first, range.second );
+            std::sort( returnVector.begin(), returnVector.end() );
+            return returnVector;
+        }
         else  // if not, calculate them for this node
         {
             std::list<size_t> worklist;
@@ -429,6 +569,15 @@ std::vector<size_t> WHtree::getLeaves4node( const nodeID_t &nodeID ) const
         return std::vector<size_t>( 1, nodeID.second );
     }
 } // end getLeaves4node() -------------------------------------------------------------------------------------
+leafRange_t WHtree::getLeafRange4node( const size_t nodeID ) const
+{
+    if( !hasEulerIndex() || nodeID >= m_nodes.size() )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::getLeafRange4node(): index not loaded or nodeID is out of boundaries";
+        return std::make_pair( m_eulerLeaves.end(), m_eulerLeaves.end() );
+    }
+    return std::make_pair( m_eulerLeaves.begin() + m_eulerLeafBegin[nodeID], m_eulerLeaves.begin() + m_eulerLeafEnd[nodeID] );
+} // end getLeafRange4node() -------------------------------------------------------------------------------------
 
 
 std::vector<size_t> WHtree::getBranchNodes( const size_t nodeID ) const
@@ -439,6 +588,14 @@ std::vector<size_t> WHtree::getBranchNodes( const size_t nodeID ) const
         wlog::error( "WHtree" ) << "ERROR @ WHtree::getBranchNodes(): nodeID is out of boundaries";
         return returnVector;
     }
+    else if( hasEulerIndex() ) // the branch is a contiguous range of the depth-first node order
+    {
+        const std::vector<unsigned int> &nodeOrder( m_eulerSparseTable[0] );
+        returnVector.assign( nodeOrder.begin() + m_eulerNodePos[nodeID],
+                             nodeOrder.begin() + m_eulerNodePos[nodeID] + m_eulerBranchSize[nodeID] );
+        std::sort( returnVector.begin(), returnVector.end() );
+        return returnVector;
+    }
     else
     {
         std::list<size_t> worklist;
@@ -538,6 +695,10 @@ size_t WHtree::getCommonAncestor( const size_t nodeID1, const size_t nodeID2 ) c
     {
         return nodeID1;
     }
+    else if( hasEulerIndex() && nodeID1 < m_nodes.size() && nodeID2 < m_nodes.size() )
+    {
+        return getEulerCommonAncestor( nodeID1, nodeID2 );
+    }
     else
     {
         size_t tempID1( getNode( nodeID1 ).getID() ), tempID2( getNode( nodeID2 ).getID() );
@@ -596,7 +757,14 @@ std::vector<nodeID_t> WHtree::getRoute2Root( const nodeID_t &nodeID ) const
     }
     const WHnode& root( getRoot() );
     const WHnode* current( &getNode( nodeID ) );
-    returnVector.reserve( root.getHLevel() - current->getHLevel() );
+    if( hasEulerIndex() )
+    {
+        returnVector.reserve( ( nodeID.first ? m_eulerDepth[nodeID.second] : m_eulerDepth[current->getParent().second] + 1 ) + 1 );
+    }
+    else
+    {
+        returnVector.reserve( root.getHLevel() - current->getHLevel() );
+    }
     returnVector.push_back( nodeID );
 
     while( !current->isRoot() )
@@ -863,6 +1031,111 @@ void WHtree::clearContainedLeaves()
     m_containedLeaves.swap( emptyThing );
 } // end clearContainedLeaves() -------------------------------------------------------------------------------------
 
+void WHtree::loadEulerIndex()
+{
+    clearEulerIndex();
+    if( m_nodes.empty() )
+    {
+        return;
+    }
+    const size_t numNodes( m_nodes.size() );
+
+    // children always have lower ids than their parents, so branch sizes can be accumulated in id order
+    m_eulerBranchSize.assign( numNodes, 1 );
+    std::vector<size_t> leafCount( numNodes, 0 );
+    for( size_t i = 0; i < m_leaves.size(); ++i )
+    {
+        ++leafCount[m_leaves[i].getParent().second];
+    }
+    for( size_t i = 0; i < numNodes; ++i )
+    {
+        if( !m_nodes[i].isRoot() )
+        {
+            m_eulerBranchSize[m_nodes[i].getParent().second] += m_eulerBranchSize[i];
+            leafCount[m_nodes[i].getParent().second] += leafCount[i];
+        }
+    }
+
+    // depth-first traversal, the leaves directly under a node are listed before the leaves of its child nodes
+    std::vector<unsigned int> nodeOrder;
+    nodeOrder.reserve( numNodes );
+    m_eulerLeaves.reserve( m_leaves.size() );
+    m_eulerLeafBegin.resize( numNodes );
+    m_eulerLeafEnd.resize( numNodes );
+    m_eulerNodePos.resize( numNodes );
+    m_eulerDepth.resize( numNodes );
+
+    const size_t rootID( getRoot().getID() );
+    m_eulerDepth[rootID] = 0;
+    std::vector<size_t> worklist( 1, rootID );
+    while( !worklist.empty() )
+    {
+        size_t currentNode( worklist.back() );
+        worklist.pop_back();
+        m_eulerNodePos[currentNode] = nodeOrder.size();
+        nodeOrder.push_back( currentNode );
+        m_eulerLeafBegin[currentNode] = m_eulerLeaves.size();
+        m_eulerLeafEnd[currentNode] = m_eulerLeaves.size() + leafCount[currentNode];
+
+        std::vector<nodeID_t> kids( m_nodes[currentNode].getChildren() );
+        for( std::vector<nodeID_t>::const_reverse_iterator iter( kids.rbegin() ); iter != kids.rend(); ++iter )
+        {
+            if( iter->first ) // is node
+            {
+                m_eulerDepth[iter->second] = m_eulerDepth[currentNode] + 1;
+                worklist.push_back( iter->second );
+            }
+        }
+        for( std::vector<nodeID_t>::const_iterator iter( kids.begin() ); iter != kids.end(); ++iter )
+        {
+            if( !iter->first ) // is leaf
+            {
+                m_eulerLeaves.push_back( iter->second );
+            }
+        }
+    }
+
+    if( nodeOrder.size() != numNodes || m_eulerLeaves.size() != m_leaves.size() )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::loadEulerIndex(): tree is not connected, index was not built";
+        clearEulerIndex();
+        return;
+    }
+
+    m_eulerLog2.resize( numNodes + 1, 0 );
+    for( size_t i = 2; i <= numNodes; ++i )
+    {
+        m_eulerLog2[i] = m_eulerLog2[i / 2] + 1;
+    }
+
+    m_eulerSparseTable.resize( m_eulerLog2[numNodes] + 1 );
+    m_eulerSparseTable[0].swap( nodeOrder );
+    for( size_t level = 1; level < m_eulerSparseTable.size(); ++level )
+    {
+        const std::vector<unsigned int> &lower( m_eulerSparseTable[level - 1] );
+        std::vector<unsigned int> &current( m_eulerSparseTable[level] );
+        const size_t halfLength( static_cast<size_t>( 1 ) << ( level - 1 ) );
+        current.resize( numNodes - 2 * halfLength + 1 );
+        for( size_t i = 0; i < current.size(); ++i )
+        {
+            const unsigned int node1( lower[i] ), node2( lower[i + halfLength] );
+            current[i] = ( m_eulerDepth[node2] < m_eulerDepth[node1] ) ? node2 : node1;
+        }
+    }
+} // end loadEulerIndex() -------------------------------------------------------------------------------------
+
+void WHtree::clearEulerIndex()
+{
+    std::vector<size_t>().swap( m_eulerLeaves );
+    std::vector<size_t>().swap( m_eulerLeafBegin );
+    std::vector<size_t>().swap( m_eulerLeafEnd );
+    std::vector<size_t>().swap( m_eulerNodePos );
+    std::vector<size_t>().swap( m_eulerBranchSize );
+    std::vector<unsigned int>().swap( m_eulerDepth );
+    std::vector<unsigned char>().swap( m_eulerLog2 );
+    std::vector<std::vector<unsigned int> >().swap( m_eulerSparseTable );
+} // end clearEulerIndex() -------------------------------------------------------------------------------------
+
 
 bool WHtree::convert2grid( const HC_GRID newGrid )
 {
@@ -910,6 +1183,12 @@ bool WHtree::convert2grid( const HC_GRID newGrid )
 
 bool WHtree::readTree( const std::string &filename )
 {
+    if( isBinaryTreeFile( filename ) )
+    {
+        return readTreeBinary( filename );
+    }
+
+    clearEulerIndex();
     m_nodes.clear();
     m_leaves.clear();
     m_coordinates.clear();
@@ -1228,10 +1507,246 @@ bool WHtree::readTree( const std::string &filename )
     return true;
 } // end readTree() -------------------------------------------------------------------------------------
 
+bool WHtree::readTreeBinary( const std::string &filename )
+{
+    m_nodes.clear();
+    m_leaves.clear();
+    m_coordinates.clear();
+    m_trackids.clear();
+    m_discarded.clear();
+    clearPartitions();
+    clearEulerIndex();
+    m_loadStatus = false;
+
+    boost::interprocess::mapped_region region;
+    try
+    {
+        boost::interprocess::file_mapping mapping( filename.c_str(), boost::interprocess::read_only );
+        boost::interprocess::mapped_region( mapping, boost::interprocess::read_only ).swap( region );
+    }
+    catch( const boost::interprocess::interprocess_exception &e )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): unable to map file \"" << filename << "\": " << e.what();
+        return false;
+    }
+
+    const char* data( static_cast< const char* >( region.get_address() ) );
+    const size_t fileSize( region.get_size() );
+
+    if( fileSize < sizeof( WHtreeBinaryHeader ) )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): file is too small to be a binary tree file";
+        return false;
+    }
+    WHtreeBinaryHeader header;
+    std::memcpy( &header, data, sizeof( WHtreeBinaryHeader ) );
+    if( std::memcmp( header.m_magic, BINARY_TREE_MAGIC, sizeof( BINARY_TREE_MAGIC ) ) != 0 )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): file is not a binary tree file";
+        return false;
+    }
+    if( header.m_endianCheck != BINARY_TREE_ENDIAN_CHECK )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): file was written on a machine with different byte order";
+        return false;
+    }
+    if( header.m_version != BINARY_TREE_VERSION )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): unsupported file version " << header.m_version;
+        return false;
+    }
+    if( header.m_grid != HC_VISTA && header.m_grid != HC_NIFTI )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): dataset grid type could not be identified";
+        return false;
+    }
+    if( header.m_numTrackIds != 0 && header.m_numTrackIds != header.m_numLeaves )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): track ids and leaves dimensions dont match";
+        return false;
+    }
+
+    // locate the tables, reject files that are truncated or have counts that would overflow the offsets
+    const size_t numLeaves( header.m_numLeaves );
+    const size_t numNodes( header.m_numNodes );
+    const size_t numColors( header.m_hasColors ? header.m_numPartitionEntries : 0 );
+    const boost::uint64_t tableCounts[] = { header.m_numNodes, header.m_numLeaves, header.m_numChildEntries, header.m_numLeaves, // NOLINT
+                                            header.m_numTrackIds, header.m_numDiscarded, header.m_numPartitions,
+                                            header.m_numPartitions, header.m_numPartitionEntries, numColors };
+    const size_t tableElementSizes[] = { sizeof( WHtreeBinaryNode ), sizeof( boost::uint64_t ), sizeof( boost::uint64_t ), // NOLINT
+                                         3 * sizeof( float ), sizeof( boost::uint64_t ), 3 * sizeof( float ), sizeof( float ),
+                                         sizeof( boost::uint64_t ), sizeof( boost::uint64_t ), 3 * sizeof( float ) };
+    const size_t numTables( sizeof( tableCounts ) / sizeof( tableCounts[0] ) );
+    const char* tables[ numTables ];
+    size_t offset( alignedSize( sizeof( WHtreeBinaryHeader ) ) );
+    for( size_t i = 0; i < numTables; ++i )
+    {
+        if( tableCounts[i] > fileSize / tableElementSizes[i] || offset > fileSize
+            || alignedSize( tableCounts[i] * tableElementSizes[i] ) > fileSize - offset )
+        {
+            wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): file is truncated";
+            return false;
+        }
+        tables[i] = data + offset;
+        offset += alignedSize( tableCounts[i] * tableElementSizes[i] );
+    }
+    const WHtreeBinaryNode* nodeTable( reinterpret_cast< const WHtreeBinaryNode* >( tables[0] ) );
+    const boost::uint64_t* leafParents( reinterpret_cast< const boost::uint64_t* >( tables[1] ) );
+    const boost::uint64_t* childTable( reinterpret_cast< const boost::uint64_t* >( tables[2] ) );
+    const float* coordTable( reinterpret_cast< const float* >( tables[3] ) );
+    const boost::uint64_t* trackTable( reinterpret_cast< const boost::uint64_t* >( tables[4] ) );
+    const float* discardedTable( reinterpret_cast< const float* >( tables[5] ) );
+    const float* partValueTable( reinterpret_cast< const float* >( tables[6] ) );
+    const boost::uint64_t* partSizeTable( reinterpret_cast< const boost::uint64_t* >( tables[7] ) );
+    const boost::uint64_t* partEntryTable( reinterpret_cast< const boost::uint64_t* >( tables[8] ) );
+    const float* colorTable( reinterpret_cast< const float* >( tables[9] ) );
+
+    m_datasetGrid = static_cast< HC_GRID >( header.m_grid );
+    m_datasetSize = WHcoord( header.m_datasetSize[0], header.m_datasetSize[1], header.m_datasetSize[2] );
+    m_numStreamlines = header.m_numStreamlines;
+    m_logFactor = header.m_logFactor;
+    m_cpcc = header.m_cpcc;
+
+    m_leaves.reserve( numLeaves );
+    m_coordinates.reserve( numLeaves );
+    for( size_t i = 0; i < numLeaves; ++i )
+    {
+        WHnode tempNode( std::make_pair( 0, i ) );
+        tempNode.setParent( decodeNodeID( leafParents[i] ) );
+        m_leaves.push_back( tempNode );
+        m_coordinates.push_back( WHcoord( coordTable[3 * i], coordTable[3 * i + 1], coordTable[3 * i + 2] ) );
+    }
+
+    if( header.m_numTrackIds != 0 )
+    {
+        m_trackids.assign( trackTable, trackTable + numLeaves );
+    }
+    else if( m_datasetGrid == HC_NIFTI )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): no tract ids in tree file, necessary to work on nifti mode";
+        return false;
+    }
+    else
+    {
+        m_trackids.reserve( numLeaves );
+        for( size_t i = 0; i < numLeaves; ++i )
+        {
+            m_trackids.push_back( i );
+        }
+    }
+
+    m_nodes.reserve( numNodes );
+    for( size_t i = 0; i < numNodes; ++i )
+    {
+        const WHtreeBinaryNode &record( nodeTable[i] );
+        if( record.m_firstChild > header.m_numChildEntries || record.m_numChildren > header.m_numChildEntries - record.m_firstChild )
+        {
+            wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): children of node " << i << " are out of boundaries";
+            return false;
+        }
+        std::vector<nodeID_t> children;
+        children.reserve( record.m_numChildren );
+        for( size_t j = 0; j < record.m_numChildren; ++j )
+        {
+            nodeID_t kid( decodeNodeID( childTable[record.m_firstChild + j] ) );
+            if( ( kid.first && kid.second >= i ) || ( !kid.first && kid.second >= numLeaves ) )
+            {
+                wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): kid id (" << kid.first << "-" << kid.second
+                                        << ") was out of boundaries. Nodes: " << i;
+                return false;
+            }
+            children.push_back( kid );
+        }
+        WHnode tempNode( std::make_pair( 1, i ), children, record.m_size, record.m_distance, record.m_hLevel );
+        tempNode.setParent( decodeNodeID( record.m_parent ) );
+        m_nodes.push_back( tempNode );
+    }
+
+    for( size_t i = 0; i < header.m_numDiscarded; ++i )
+    {
+        m_discarded.push_back( WHcoord( discardedTable[3 * i], discardedTable[3 * i + 1], discardedTable[3 * i + 2] ) );
+    }
+
+    {
+        m_selectedValues.assign( partValueTable, partValueTable + header.m_numPartitions );
+        m_selectedPartitions.reserve( header.m_numPartitions );
+        if( numColors != 0 )
+        {
+            m_selectedColors.reserve( header.m_numPartitions );
+        }
+        size_t entry( 0 );
+        for( size_t i = 0; i < header.m_numPartitions; ++i )
+        {
+            if( partSizeTable[i] > header.m_numPartitionEntries - entry )
+            {
+                wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): partition entries are out of boundaries."
+                                        << " Fields will be left empty";
+                clearPartitions();
+                break;
+            }
+            m_selectedPartitions.push_back( std::vector<size_t>( partEntryTable + entry, partEntryTable + entry + partSizeTable[i] ) );
+            if( numColors != 0 )
+            {
+                std::vector<WHcoord> thisPartColors;
+                thisPartColors.reserve( partSizeTable[i] );
+                for( size_t j = entry; j < entry + partSizeTable[i]; ++j )
+                {
+                    thisPartColors.push_back( WHcoord( colorTable[3 * j], colorTable[3 * j + 1], colorTable[3 * j + 2] ) );
+                }
+                m_selectedColors.push_back( thisPartColors );
+            }
+            entry += partSizeTable[i];
+        }
+    }
+
+    if( !check() )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::readTreeBinary(): loaded tree is not consistent";
+        return false;
+    }
+
+    m_treeName = boost::filesystem::path( filename ).stem().string();
+
+    m_loadStatus = true;
+    return true;
+} // end readTreeBinary() -------------------------------------------------------------------------------------
+
+bool WHtree::isBinaryTreeFile( const std::string &filename )
+{
+    std::ifstream inFile( filename.c_str(), std::ios::in | std::ios::binary );
+    char magic[sizeof( BINARY_TREE_MAGIC )];
+    if( !inFile || !inFile.read( magic, sizeof( magic ) ) )
+    {
+        return false;
+    }
+    return std::memcmp( magic, BINARY_TREE_MAGIC, sizeof( magic ) ) == 0;
+} // end isBinaryTreeFile() -------------------------------------------------------------------------------------
+
+bool WHtree::convertTreeFile( const std::string &inFilename, const std::string &outFilename, const bool isNifti )
+{
+    WHtree tree;
+    if( !tree.readTree( inFilename ) )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::convertTreeFile(): unable to read tree file \"" << inFilename << "\"";
+        return false;
+    }
+    return tree.writeTree( outFilename, isNifti );
+} // end convertTreeFile() -------------------------------------------------------------------------------------
+
+std::string WHtree::getBinaryExtension()
+{
+    return ".htb";
+} // end getBinaryExtension() -------------------------------------------------------------------------------------
+
 
 
 bool WHtree::writeTree( const std::string &filename, const bool niftiMode ) const
 {
+    if( boost::filesystem::path( filename ).extension().string() == getBinaryExtension() )
+    {
+        return writeTreeBinary( filename, niftiMode );
+    }
+
     std::ofstream outFile( filename.c_str() );
     if( !outFile )
     {
@@ -1376,6 +1891,140 @@ bool WHtree::writeTree( const std::string &filename, const bool niftiMode ) cons
     return true;
 } // end writeTree() -------------------------------------------------------------------------------------
 
+bool WHtree::writeTreeBinary( const std::string &filename, const bool niftiMode ) const
+{
+    std::ofstream outFile( filename.c_str(), std::ios::out | std::ios::binary );
+    if( !outFile )
+    {
+        throw WFileOpenFailed( "ERROR: unable to open out file: \"" + filename + "." );
+    }
+
+    std::vector<WHtreeBinaryNode> nodeTable( m_nodes.size() );
+    std::vector<boost::uint64_t> childTable;
+    for( size_t i = 0; i < m_nodes.size(); ++i )
+    {
+        const WHnode &node( m_nodes[i] );
+        std::vector<nodeID_t> children( node.getChildren() );
+        WHtreeBinaryNode &record( nodeTable[i] );
+        record.m_parent = encodeNodeID( node.getParent() );
+        record.m_firstChild = childTable.size();
+        record.m_size = node.getSize();
+        record.m_numChildren = children.size();
+        record.m_hLevel = node.getHLevel();
+        record.m_distance = node.getDistLevel();
+        record.m_padding = 0;
+        for( std::vector<nodeID_t>::const_iterator kidIter( children.begin() ); kidIter != children.end(); ++kidIter )
+        {
+            childTable.push_back( encodeNodeID( *kidIter ) );
+        }
+    }
+
+    std::vector<boost::uint64_t> leafParents;
+    leafParents.reserve( m_leaves.size() );
+    for( std::vector<WHnode>::const_iterator leafIter( m_leaves.begin() ); leafIter != m_leaves.end(); ++leafIter )
+    {
+        leafParents.push_back( encodeNodeID( leafIter->getParent() ) );
+    }
+
+    std::vector<float> coordTable;
+    coordTable.reserve( 3 * m_coordinates.size() );
+    for( std::vector<WHcoord>::const_iterator coordIter( m_coordinates.begin() ); coordIter != m_coordinates.end(); ++coordIter )
+    {
+        WHcoord currentCoord( coordForOutput( *coordIter, m_datasetGrid, m_datasetSize, niftiMode ) );
+        coordTable.push_back( currentCoord.m_x );
+        coordTable.push_back( currentCoord.m_y );
+        coordTable.push_back( currentCoord.m_z );
+    }
+
+    std::vector<boost::uint64_t> trackTable;
+    if( m_trackids.size() == m_coordinates.size() )
+    {
+        trackTable.assign( m_trackids.begin(), m_trackids.end() );
+    }
+    else if( niftiMode )
+    {
+        wlog::error( "WHtree" ) << "WARNING @ WHtree::writeTreeBinary(): trackids(" << m_trackids.size() << ") and coordinates("
+        << m_coordinates.size() << ") vector sizes do not match. track ids will note written to file";
+    }
+
+    std::vector<float> discardedTable;
+    discardedTable.reserve( 3 * m_discarded.size() );
+    for( std::list<WHcoord>::const_iterator coordIter( m_discarded.begin() ); coordIter != m_discarded.end(); ++coordIter )
+    {
+        WHcoord currentCoord( coordForOutput( *coordIter, m_datasetGrid, m_datasetSize, niftiMode ) );
+        discardedTable.push_back( currentCoord.m_x );
+        discardedTable.push_back( currentCoord.m_y );
+        discardedTable.push_back( currentCoord.m_z );
+    }
+
+    std::vector<float> partValueTable;
+    std::vector<boost::uint64_t> partSizeTable;
+    std::vector<boost::uint64_t> partEntryTable;
+    std::vector<float> colorTable;
+    if( m_selectedValues.size() != 0 )
+    {
+        partValueTable.assign( m_selectedValues.begin(), m_selectedValues.end() );
+        for( size_t i = 0; i < m_selectedPartitions.size(); ++i )
+        {
+            partSizeTable.push_back( m_selectedPartitions[i].size() );
+            partEntryTable.insert( partEntryTable.end(), m_selectedPartitions[i].begin(), m_selectedPartitions[i].end() );
+        }
+        for( size_t i = 0; i < m_selectedColors.size(); ++i )
+        {
+            for( size_t j = 0; j < m_selectedColors[i].size(); ++j )
+            {
+                colorTable.push_back( m_selectedColors[i][j].m_x );
+                colorTable.push_back( m_selectedColors[i][j].m_y );
+                colorTable.push_back( m_selectedColors[i][j].m_z );
+            }
+        }
+        if( colorTable.size() != 3 * partEntryTable.size() )
+        {
+            colorTable.clear();
+        }
+    }
+
+    WHtreeBinaryHeader header;
+    std::memset( &header, 0, sizeof( WHtreeBinaryHeader ) );
+    std::memcpy( header.m_magic, BINARY_TREE_MAGIC, sizeof( BINARY_TREE_MAGIC ) );
+    header.m_endianCheck = BINARY_TREE_ENDIAN_CHECK;
+    header.m_version = BINARY_TREE_VERSION;
+    header.m_grid = niftiMode ? HC_NIFTI : HC_VISTA;
+    header.m_hasColors = colorTable.empty() ? 0 : 1;
+    header.m_datasetSize[0] = m_datasetSize.m_x;
+    header.m_datasetSize[1] = m_datasetSize.m_y;
+    header.m_datasetSize[2] = m_datasetSize.m_z;
+    header.m_logFactor = m_logFactor;
+    header.m_cpcc = m_cpcc;
+    header.m_numStreamlines = m_numStreamlines;
+    header.m_numLeaves = m_leaves.size();
+    header.m_numNodes = m_nodes.size();
+    header.m_numChildEntries = childTable.size();
+    header.m_numTrackIds = trackTable.size();
+    header.m_numDiscarded = m_discarded.size();
+    header.m_numPartitions = partValueTable.size();
+    header.m_numPartitionEntries = partEntryTable.size();
+
+    writeBinaryTable( outFile, &header, sizeof( WHtreeBinaryHeader ) );
+    writeBinaryTable( outFile, nodeTable.data(), nodeTable.size() * sizeof( WHtreeBinaryNode ) );
+    writeBinaryTable( outFile, leafParents.data(), leafParents.size() * sizeof( boost::uint64_t ) );
+    writeBinaryTable( outFile, childTable.data(), childTable.size() * sizeof( boost::uint64_t ) );
+    writeBinaryTable( outFile, coordTable.data(), coordTable.size() * sizeof( float ) );
+    writeBinaryTable( outFile, trackTable.data(), trackTable.size() * sizeof( boost::uint64_t ) );
+    writeBinaryTable( outFile, discardedTable.data(), discardedTable.size() * sizeof( float ) );
+    writeBinaryTable( outFile, partValueTable.data(), partValueTable.size() * sizeof( float ) );
+    writeBinaryTable( outFile, partSizeTable.data(), partSizeTable.size() * sizeof( boost::uint64_t ) );
+    writeBinaryTable( outFile, partEntryTable.data(), partEntryTable.size() * sizeof( boost::uint64_t ) );
+    writeBinaryTable( outFile, colorTable.data(), colorTable.size() * sizeof( float ) );
+
+    if( !outFile )
+    {
+        wlog::error( "WHtree" ) << "ERROR @ WHtree::writeTreeBinary(): error while writing file \"" << filename << "\"";
+        return false;
+    }
+    return true;
+} // end writeTreeBinary() -------------------------------------------------------------------------------------
+
 
 bool WHtree::writeTreeDebug( const std::string &filename ) const
 {
@@ -1707,6 +2356,25 @@ WHnode* WHtree::fetchLeaf( const size_t thisLeaf )
 } // end fetchLeaf() -------------------------------------------------------------------------------------
 
 
+size_t WHtree::getEulerCommonAncestor( const size_t nodeID1, const size_t nodeID2 ) const
+{
+    size_t pos1( m_eulerNodePos[nodeID1] ), pos2( m_eulerNodePos[nodeID2] );
+    if( pos1 == pos2 )
+    {
+        return nodeID1;
+    }
+    if( pos1 > pos2 )
+    {
+        std::swap( pos1, pos2 );
+    }
+    // the least deep node after the first node up to the second one in depth-first order is a child of the common ancestor
+    const size_t level( m_eulerLog2[pos2 - pos1] );
+    const std::vector<unsigned int> &table( m_eulerSparseTable[level] );
+    const unsigned int node1( table[pos1 + 1] ), node2( table[pos2 + 1 - ( static_cast<size_t>( 1 ) << level )] );
+    const unsigned int child( ( m_eulerDepth[node2] < m_eulerDepth[node1] ) ? node2 : node1 );
+    return m_nodes[child].getParent().second;
+} // end getEulerCommonAncestor() -------------------------------------------------------------------------------------
+
 WHnode* WHtree::fetchRoot()
 {
     return fetchNode( getNumNodes()-1 );
@@ -1978,6 +2646,7 @@ std::pair<size_t, size_t> WHtree::cleanup( std::vector<size_t> *outLookup )
 
     clearPartitions();
     clearPartColors();
+    clearEulerIndex();
     return std::make_pair( discardedLeaves, discardedNodes );
 } // end cleanup() -------------------------------------------------------------------------------------
 
@@ -2172,6 +2841,7 @@ size_t WHtree::debinarize( bool keepBaseNodes )
         m_nodes = nbNodes;
     }
     clearContainedLeaves();
+    clearEulerIndex();
     clearPartitions();
     // refill hLevel data
     for( unsigned int id = 0; id < getNumNodes(); ++id )
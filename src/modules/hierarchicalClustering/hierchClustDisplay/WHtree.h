@@ -73,6 +73,8 @@
 #include "WHnode.h"
 #include "WFileParser.h"
 
+//! a range of leaf IDs, as returned by WHtree::getLeafRange4node()
+typedef std::pair< std::vector<size_t>::const_iterator, std::vector<size_t>::const_iterator > leafRange_t;
 
 /**
  * this class implements a hierarchical tree and provides functions for creation, partitioning, selection and navigation
@@ -312,6 +314,14 @@ public:
      */
     std::vector<size_t> getLeaves4node( const nodeID_t &nodeID ) const;
 
+    /**
+     * Returns the range of all the leaf IDs contained in that cluster without copying them. Requires loadEulerIndex(),
+     * the leaves are in depth-first order and not sorted
+     * \param nodeID id of the selected node
+     * \return begin and end of the contained leaves, an empty range if the index is not loaded or the id is out of boundaries
+     */
+    leafRange_t getLeafRange4node( const size_t nodeID ) const;
+
     /**
      * Returns a vector with all the node IDs contained in that branch
      * \param nodeID id of the selected node
@@ -507,6 +517,23 @@ public:
      */
     void clearContainedLeaves();
 
+    /**
+     * builds the depth-first index of the tree: contiguous leaf and branch ranges for each node and a sparse table answering
+     * common ancestor queries in constant time. Must be rebuilt after the tree structure changes
+     */
+    void loadEulerIndex();
+
+    /**
+     * frees the memory of the depth-first index
+     */
+    void clearEulerIndex();
+
+    /**
+     * indicates whether the depth-first index is loaded
+     * \return true if loadEulerIndex() was called since the last change of the tree structure
+     */
+    bool hasEulerIndex() const;
+
     /**
      * converts all the coordinates to the grid format indicated
      * \param newGrid coordinate space in which to convert
@@ -516,19 +543,60 @@ public:
 
     /**
      * Reads the the tree data from a file and creates the structure, containing it in the leaves, nodes and coordinates vectors
+     * Binary tree files are detected by their header and read with readTreeBinary()
      * \param filename string containing std::vector<hNode> m_leavesthe name of the file with the tree data
      * \return success indicator
      */
     bool readTree( const std::string &filename );
 
     /**
-     * writes the current tree data
+     * Reads the tree data from a binary tree file as written by writeTreeBinary(). The file is memory mapped and the node,
+     * coordinate and partition tables are taken over directly, without any text parsing or recomputation of node sizes and levels
+     * \param filename string containing the name of the binary tree file
+     * \return success indicator
+     */
+    bool readTreeBinary( const std::string &filename );
+
+    /**
+     * writes the current tree data, in the binary format if the file name has the extension returned by getBinaryExtension()
      * \param filename string containing the name of the file to be written
      * \param isNifti a flag indicating whether the tree should be written in nifti coordinates
      * \return success indicator
      */
     bool writeTree( const std::string &filename, const bool isNifti = true ) const;
 
+    /**
+     * writes the current tree data in the binary tree format: a fixed header followed by 8-byte aligned tables of node records
+     * (parent, child table offset, size, level and distance), leaf parents, children, leaf coordinates, track ids, discarded
+     * coordinates and selected partitions
+     * \param filename string containing the name of the file to be written
+     * \param isNifti a flag indicating whether the tree should be written in nifti coordinates
+     * \return success indicator
+     */
+    bool writeTreeBinary( const std::string &filename, const bool isNifti = true ) const;
+
+    /**
+     * checks whether a file starts with the binary tree file signature
+     * \param filename string containing the name of the file to be checked
+     * \return true if the file is a binary tree file
+     */
+    static bool isBinaryTreeFile( const std::string &filename );
+
+    /**
+     * converts a tree file between the text and the binary format, the output format is chosen by the output file extension
+     * \param inFilename string containing the name of the tree file to be read
+     * \param outFilename string containing the name of the tree file to be written
+     * \param isNifti a flag indicating whether the tree should be written in nifti coordinates
+     * \return success indicator
+     */
+    static bool convertTreeFile( const std::string &inFilename, const std::string &outFilename, const bool isNifti = true );
+
+    /**
+     * returns the file extension of binary tree files
+     * \return the extension including the dot
+     */
+    static std::string getBinaryExtension();
+
     /**
      * writes all redundant tree data for debugging purposes
      * \param filename string containing the name of the file to be written
@@ -657,6 +725,30 @@ private:
     //! Stores the contained leafs of each node
     std::vector<std::vector<size_t> > m_containedLeaves;
 
+    //! Stores the leaf IDs in depth-first order, the leaves of each node form a contiguous range
+    std::vector<size_t> m_eulerLeaves;
+
+    //! Stores for each node the position of its first leaf in m_eulerLeaves
+    std::vector<size_t> m_eulerLeafBegin;
+
+    //! Stores for each node the position after its last leaf in m_eulerLeaves
+    std::vector<size_t> m_eulerLeafEnd;
+
+    //! Stores for each node its position in the depth-first order of the nodes
+    std::vector<size_t> m_eulerNodePos;
+
+    //! Stores for each node the number of nodes in its branch, including itself
+    std::vector<size_t> m_eulerBranchSize;
+
+    //! Stores for each node its depth, the root has depth 0
+    std::vector<unsigned int> m_eulerDepth;
+
+    //! Stores the floor of the binary logarithm of the range lengths used in the sparse table
+    std::vector<unsigned char> m_eulerLog2;
+
+    //! Sparse table, level k holds for each position the least deep node of the 2^k nodes starting there in depth-first order
+    std::vector<std::vector<unsigned int> > m_eulerSparseTable;
+
     //! Stores a set of selected partitions
     std::vector< std::vector<size_t> > m_selectedPartitions;
 
@@ -696,6 +788,14 @@ private:
      */
     WHnode* fetchRoot();
 
+    /**
+     * computes the common ancestor of two nodes with the depth-first index
+     * \param nodeID1 id of the first node, must be within boundaries
+     * \param nodeID2 id of the second node, must be within boundaries
+     * \return id of the common ancestor
+     */
+    size_t getEulerCommonAncestor( const size_t nodeID1, const size_t nodeID2 ) const;
+
     /**
      * cleans leaves/nodes set to be pruned
      * \param outLookup pointer to a vector where to store the lookup table of changes done to nodes
@@ -933,4 +1033,9 @@ inline std::vector< WHcoord > WHtree::getSelectedColors( size_t index ) const
     }
 }
 
+inline bool WHtree::hasEulerIndex() const
+{
+    return !m_eulerNodePos.empty();
+}
+
 #endif  // WHTREE_H
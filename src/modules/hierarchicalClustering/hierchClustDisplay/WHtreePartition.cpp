@@ -61,8 +61,13 @@
 
 
 
-WHtreePartition::WHtreePartition( WHtree* const tree ) : m_tree( *tree )
+WHtreePartition::WHtreePartition( WHtree* const tree ) : m_tree( *tree ), m_stopFlag( 0 )
 {
+    // common ancestor and leaf queries of the partition evaluation use the depth-first index of the tree
+    if( !m_tree.hasEulerIndex() )
+    {
+        m_tree.loadEulerIndex();
+    }
 }
 
 WHtreePartition::~WHtreePartition()
@@ -72,6 +77,16 @@ WHtreePartition::~WHtreePartition()
 
 // === PUBLIC MEMBER FUNCTIONS ===
 
+void WHtreePartition::setStopFlag( const WBoolFlag* stopFlag )
+{
+    m_stopFlag = stopFlag;
+}
+
+void WHtreePartition::setProgress( std::shared_ptr< WProgress > progress )
+{
+    m_progress = progress;
+}
+
 void WHtreePartition::scanOptimalPartitions( const size_t levelDepth, std::vector< float >* partitionValuesPointer,
                                              std::vector< std::vector< size_t> >* partitionVectorPointer, const bool verbose )
 {
@@ -115,9 +130,10 @@ void WHtreePartition::scanOptimalPartitions( const size_t levelDepth, std::vecto
 
     size_t stepNr( 0 );
 
-    while( true )
+    while( !stopRequested() )
     {
         ++stepNr;
+        reportStep();
         std::cout << "\rStep: " << stepNr << ". Current partition size: ";
         std::cout << currentPartition.size() << ". Current value: ";
         std::cout << currentValue << "       " << std::flush;
@@ -139,23 +155,28 @@ void WHtreePartition::scanOptimalPartitions( const size_t levelDepth, std::vecto
         std::vector< std::vector< size_t > > derivedPartitionSet;
         std::vector< std::vector< unsigned int > > derivedIndexes( m_tree.getBranching( currentPartition, levelDepth, &derivedPartitionSet ) );
 
+        //if there are no more possible branchings stop the loop
+        if( derivedPartitionSet.empty() )
+        {
+            break;
+        }
+
         std::vector< double > derivedPartitionValues( derivedPartitionSet.size(), -1 );
-        bool stopLoop( true );
 
-        // get the partitions and values for all possible branchings
+        // get the values for all possible branchings, the tree is only read
         #pragma omp parallel for schedule( guided )
         for( size_t i = 0; i < derivedPartitionSet.size(); ++i )
         {
-            // if there are possible branchings continue looping
-            #pragma omp critical
-            stopLoop = false;
-
+            if( stopRequested() )
+            {
+                continue;
+            }
             //get the value for this partition
             derivedPartitionValues[i] = evalPartOptimal( derivedPartitionSet[i] );
         } // endFor
 
-        //if there are no more possible branchings stop the loop
-        if( stopLoop )
+        // the values are incomplete if the search was aborted, keep the partitions found so far
+        if( stopRequested() )
         {
             break;
         }
@@ -355,10 +376,11 @@ void WHtreePartition::scanHozPartitions( std::vector< float >* partitionValuesPo
     size_t partSizeCounter( currentPartition.size() );
     size_t lastSize( currentPartition.size() );
 
-    while( partSizeCounter <= 5000 )
+    while( partSizeCounter <= 5000 && !stopRequested() )
     {
         ++stepNr;
         ++partSizeCounter;
+        reportStep();
         std::cout << "\rStep: " << stepNr << ". Current partition size: ";
         std::cout << currentPartition.size() << ". Current value: ";
         std::cout << currentValue << "       " << std::flush;
@@ -481,6 +503,19 @@ void WHtreePartition::writePartitionSet( std::string partFileName,
 
 // === PRIVATE MEMBER FUNCTIONS ===
 
+bool WHtreePartition::stopRequested() const
+{
+    return ( m_stopFlag != 0 ) && ( *m_stopFlag )();
+} // end stopRequested() -------------------------------------------------------------------------------------
+
+void WHtreePartition::reportStep() const
+{
+    if( m_progress )
+    {
+        m_progress->increment( 1 );
+    }
+} // end reportStep() -------------------------------------------------------------------------------------
+
 
 float WHtreePartition::evalPartOptimal( const std::vector<size_t> &partition ) const
 {
@@ -896,8 +931,9 @@ float WHtreePartition::partitionOptimized( float compValue, std::vector<nodeID_t
         break;
     }
 
-    while( loopCondition )
+    while( loopCondition && !stopRequested() )
     {
+        reportStep();
         std::vector< std::vector< nodeID_t > > derivedPartitionSet;
         std::vector< std::vector< unsigned int > > derivedIndexes( m_tree.getBranching( bestPartition,
                                                                                         levelDepth,
@@ -926,17 +962,20 @@ float WHtreePartition::partitionOptimized( float compValue, std::vector<nodeID_t
             break;
         }
 
-        bool stopLoop( true );
+        //if there are no more possible branchings stop the loop
+        if( derivedPartitionSet.empty() )
+        {
+            break;
+        }
 
-        // get the partitions and values for all possible branchings
+        // get the values for all possible branchings, the tree is only read
 #pragma omp parallel for schedule( guided )
         for( size_t i = 0; i < derivedPartitionSet.size(); ++i )
         {
-            // if there are possible branchings continue looping
-#pragma omp critical
-            stopLoop = false;
-
-            derivedPartitionValues[i] = evalPartOptimal( derivedPartitionSet[i] );
+            if( stopRequested() )
+            {
+                continue;
+            }
             switch( mode )
             {
             case HTP2_CSD:
@@ -962,8 +1001,8 @@ float WHtreePartition::partitionOptimized( float compValue, std::vector<nodeID_t
             }
         } // endFor
 
-        //if there are no more possible branchings stop the loop
-        if( stopLoop )
+        // the values are incomplete if the search was aborted, keep the best partition found so far
+        if( stopRequested() )
         {
             break;
         }
@@ -57,9 +57,13 @@
 #include <utility>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 
 
 // hClustering
+#include "core/common/WFlag.h"
+#include "core/common/WProgress.h"
+
 #include "WHtree.h"
 
 // type of classic partitioning
@@ -111,6 +115,19 @@ public:
 
     // === PUBLIC MEMBER FUNCTIONS ===
 
+    /**
+     * Sets a flag that aborts the partition searches when set, e.g. the shutdown flag of a module. Aborted searches return the
+     * best result found so far
+     * \param stopFlag pointer to the flag, 0 to disable cancellation. Must outlive the searches
+     */
+    void setStopFlag( const WBoolFlag* stopFlag );
+
+    /**
+     * Sets a progress that is incremented once per greedy step of the partition searches
+     * \param progress the progress, may be empty
+     */
+    void setProgress( std::shared_ptr< WProgress > progress );
+
     /**
      * Obtain the partition quality values for the optimized (inter vs weighted intra cluster distance) partitions at each granulairty of the tree
      * \param levelDepth number of levels down where to search for the best branching decision
@@ -233,8 +250,25 @@ private:
     //! tree object
     WHtree &m_tree;
 
+    //! flag aborting the partition searches, may be 0
+    const WBoolFlag* m_stopFlag;
+
+    //! progress of the partition searches, may be empty
+    std::shared_ptr< WProgress > m_progress;
+
     // === PRIVATE MEMBER FUNCTIONS ===
 
+    /**
+     * checks whether the partition searches should be aborted, can be called from parallel sections
+     * \return true if the stop flag is set
+     */
+    bool stopRequested() const;
+
+    /**
+     * increments the progress by one step, if any
+     */
+    void reportStep() const;
+
     /**
      * Evaluate partition cluster size difference (using only non-leaf node ID)
      * \param partition vector with the partition to be evaluated
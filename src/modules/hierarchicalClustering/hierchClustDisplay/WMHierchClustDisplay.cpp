@@ -178,7 +178,7 @@ void WMHierchClustDisplay::properties()
 
     // Group Read
     m_groupRead = m_properties->addPropertyGroup( "Read file",  "Groups the tree loading options" ); //NOLINT
-    m_propReadFilename = m_groupRead->addProperty( "Tree file", "", boost::filesystem::path( "" ) );
+    m_propReadFilename = m_groupRead->addProperty( "Tree file", "Text or binary (.htb) tree file", boost::filesystem::path( "" ) );
     m_propReadTreeTrigger = m_groupRead->addProperty( "Load tree",  "Load tree", WPVBaseTypes::PV_TRIGGER_READY, m_propTriggerChange );
 
     // Group Dendrogram
@@ -383,7 +383,8 @@ void WMHierchClustDisplay::properties()
 
     // Group Write
     m_groupWrite = m_properties->addPropertyGroup( "Write Files",  "Groups the file writing options" ); //NOLINT
-    m_propWriteTreeFilename = m_groupWrite->addProperty( "Output Tree file", "", boost::filesystem::path( "" ) );
+    m_propWriteTreeFilename = m_groupWrite->addProperty( "Output Tree file", "The tree is written in the binary format if the file name ends with "
+                                                        + WHtree::getBinaryExtension(), boost::filesystem::path( "" ) );
     m_propWriteTreeTrigger = m_groupWrite->addProperty( "Write Tree",  "Press!", WPVBaseTypes::PV_TRIGGER_READY, m_propTriggerChange );
     m_propPartitionFile = m_groupWrite->addProperty( "Output Partition file", "", boost::filesystem::path( "" ) );
 //    WPropertyHelper::PC_PATHEXISTS::addTo( dirname );
@@ -617,17 +618,23 @@ void WMHierchClustDisplay::initTreeData()
     m_treeDisplayColors.clear();
     m_treeDisplayColors.resize( m_tree.getNumNodes() );
 
-    //save a vector of seed voxel indices for each cluster
+    //save a vector of seed voxel indices for each cluster, the leaves of each cluster are a contiguous range of the depth-first index
+    m_tree.loadEulerIndex();
+    std::vector<size_t> leafVoxels( m_tree.getNumLeaves() );
+    for( size_t i = 0; i < leafVoxels.size(); ++i )
+    {
+        WHcoord leafCoord( m_tree.getCoordinate4leaf( i ) );
+        leafVoxels[i] = m_grid->getVoxelNum( leafCoord.m_x, leafCoord.m_y, leafCoord.m_z );
+    }
     m_clusterVoxels.clear();
     m_clusterVoxels.resize( m_tree.getNumNodes() );
     for( size_t i = 0; i < m_clusterVoxels.size(); ++i )
     {
-        std::vector<WHcoord> clusterCoords( m_tree.getCoordinates4node( i ) );
-        m_clusterVoxels[i].reserve( clusterCoords.size() );
-        for( size_t j = 0; j < clusterCoords.size(); ++j )
+        leafRange_t clusterLeaves( m_tree.getLeafRange4node( i ) );
+        m_clusterVoxels[i].reserve( clusterLeaves.second - clusterLeaves.first );
+        for( std::vector<size_t>::const_iterator leafIter( clusterLeaves.first ); leafIter != clusterLeaves.second; ++leafIter )
         {
-            size_t voxelID( m_grid->getVoxelNum( clusterCoords[j].m_x, clusterCoords[j].m_y, clusterCoords[j].m_z ) );
-            m_clusterVoxels[i].push_back( voxelID );
+            m_clusterVoxels[i].push_back( leafVoxels[*leafIter] );
         }
     }
     m_discardedVoxels.clear();
@@ -2295,6 +2302,13 @@ void WMHierchClustDisplay::clusterSelection()
         break;
     case 2:
     case 3:
+    {
+        // the number of greedy steps is only known when searching for a number of clusters
+        size_t searchSteps( conditionMode == HTC_CNUM ? static_cast< size_t >( std::max( conditionValue, 1.0f ) ) : 0 );
+        std::shared_ptr< WProgress > progressSearch( new WProgress( "Searching optimal partition...", searchSteps ) );
+        m_progress->addSubProgress( progressSearch );
+        partitioner.setStopFlag( &m_shutdownFlag );
+        partitioner.setProgress( progressSearch );
         returnedCutValue = partitioner.partitionOptimized( conditionValue,
                                                       &partition,
                                                       partitionMode2,
@@ -2302,7 +2316,9 @@ void WMHierchClustDisplay::clusterSelection()
                                                       m_propPartExcludeLeaves->get( true ),
                                                       m_propSourceCluster->get( true ),
                                                       m_propPartSearchDepthValue->get( true ) );
+        progressSearch->finish();
         break;
+    }
     case 4:
         returnedCutValue = partitioner.partitionSharp( conditionValue,
                                                   &partition,
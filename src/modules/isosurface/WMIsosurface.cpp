@@ -46,6 +46,7 @@
 #include "core/common/WProgress.h"
 #include "core/common/algorithms/WMarchingCubesAlgorithm.h"
 #include "core/common/algorithms/WMarchingLegoAlgorithm.h"
+#include "core/common/exceptions/WComputationCancelled.h"
 #include "core/common/math/WLinearAlgebraFunctions.h"
 #include "core/common/math/WMath.h"
 #include "core/dataHandler/WDataHandler.h"
@@ -65,7 +66,6 @@ W_LOADABLE_MODULE( WMIsosurface )
 
 WMIsosurface::WMIsosurface():
     WModule(),
-    m_recompute( std::shared_ptr< WCondition >( new WCondition() ) ),
     m_dataSet(),
     m_moduleNodeInserted( false ),
     m_surfaceGeode( 0 )
@@ -108,7 +108,9 @@ void WMIsosurface::moduleMain()
     // use the m_input "data changed" flag
     m_moduleState.setResetable( true, true );
     m_moduleState.add( m_input->getDataChangedCondition() );
-    m_moduleState.add( m_recompute );
+
+    // new data cancels the current surface just like the properties do
+    m_recomputeScheduler.add( m_input->getDataChangedCondition() );
 
     // create the post-processing node which actually does the nice stuff to the rendered image
     osg::ref_ptr< WGEPostprocessingNode > postNode = new WGEPostprocessingNode(
@@ -138,8 +140,12 @@ void WMIsosurface::moduleMain()
     // loop until the module container requests the module to quit
     while( !m_shutdownFlag() )
     {
-        debugLog() << "Waiting ...";
-        m_moduleState.wait();
+        // a request arriving during the last computation cancelled it, restart right away
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            debugLog() << "Waiting ...";
+            m_moduleState.wait();
+        }
 
         // woke up since the module is requested to finish?
         if( m_shutdownFlag() )
@@ -147,10 +153,22 @@ void WMIsosurface::moduleMain()
             break;
         }
 
+        // if nothing has changed, continue waiting
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            continue;
+        }
+
+        // wait until the user stops dragging the slider
+        WCancelToken::SPtr cancelToken = m_recomputeScheduler.start();
+        if( cancelToken->isCancelled() )
+        {
+            continue;
+        }
+
         // query changes in data and data validity
         bool dataChanged = m_input->handledUpdate();
         std::shared_ptr< WDataSetScalar > incomingDataSet = m_input->getData();
-        bool propChanged = m_useMarchingLego->changed() || m_isoValueProp->changed();
         if( !incomingDataSet )
         {
             // OK, the output has not yet sent data
@@ -174,9 +192,16 @@ void WMIsosurface::moduleMain()
             }
         }
 
-        // if nothing has changed, continue waiting
-        if( !propChanged && !dataChanged )
+        // the surface only depends on these, reuse it if it was computed before
+        WResultKey key( getName() );
+        key.add( m_dataSet ).add( m_isoValueProp ).add( m_useMarchingLego );
+        if( m_output->updateDataFromCache( key ) )
         {
+            debugLog() << "Rendering cached surface ...";
+            m_triMesh = m_output->getData();
+            m_nbTriangles->set( m_triMesh->triangleSize() );
+            m_nbVertices->set( m_triMesh->vertSize() );
+            renderMesh();
             continue;
         }
 
@@ -184,17 +209,25 @@ void WMIsosurface::moduleMain()
         debugLog() << "Computing surface ...";
 
         std::shared_ptr< WProgress > progress( new WProgress( "Marching Cubes", 2 ) );
+        progress->setCancelToken( cancelToken );
         m_progress->addSubProgress( progress );
 
-        generateSurfacePre( m_isoValueProp->get( true ) );
+        try
+        {
+            generateSurfacePre( m_isoValueProp->get( true ), cancelToken );
 
-        ++*progress;
-        debugLog() << "Rendering surface ...";
+            ++*progress;
+            debugLog() << "Rendering surface ...";
 
-        renderMesh();
-        m_output->updateData( m_triMesh );
+            renderMesh();
+            m_output->updateData( m_triMesh, key );
 
-        debugLog() << "Done!";
+            debugLog() << "Done!";
+        }
+        catch( WComputationCancelled const& )
+        {
+            debugLog() << "Cancelled, restarting with the latest values.";
+        }
         progress->finish();
     }
 
@@ -229,7 +262,8 @@ void WMIsosurface::properties()
     m_nbVertices = m_infoProperties->addProperty( "Vertices", "The number of vertices in the produced mesh.", 0 );
     m_nbVertices->setMax( std::numeric_limits< int >::max() );
 
-    m_isoValueProp = m_properties->addProperty( "Iso value", "The surface will show the area that has this value.", 100., m_recompute );
+    m_isoValueProp = m_properties->addProperty( "Iso value", "The surface will show the area that has this value.", 100.,
+                                                m_recomputeScheduler.getCondition() );
     m_isoValueProp->setMin( wlimits::MIN_DOUBLE );
     m_isoValueProp->setMax( wlimits::MAX_DOUBLE );
 
@@ -241,7 +275,8 @@ void WMIsosurface::properties()
 
     m_surfaceColor = m_properties->addProperty( "Surface color", "Description.", WColor( 1.0, 1.0, 1.0, 1.0 ) );
 
-    m_useMarchingLego = m_properties->addProperty( "Voxel surface", "Not interpolated surface", false, m_recompute );
+    m_useMarchingLego = m_properties->addProperty( "Voxel surface", "Not interpolated surface", false,
+                                                    m_recomputeScheduler.getCondition() );
 
     WModule::properties();
 }
@@ -261,7 +296,8 @@ namespace
                                                             const WMatrix<double>& matrix,
                                                             std::shared_ptr<WValueSetBase> valueSet,
                                                             double isoValue,
-                                                            std::shared_ptr<WProgressCombiner> ) = 0;
+                                                            std::shared_ptr<WProgressCombiner>,
+                                                            WCancelToken::ConstSPtr ) = 0;
     };
 
     /**
@@ -284,7 +320,7 @@ namespace
      *
      * \param AlgoBase
      * AlgoBase is the algorithm that will be called and must implement
-     * AlgoBase::generateSurface( x,y,z, matrix, vals_raw_ptr, isoValue, progress )
+     * AlgoBase::generateSurface( x,y,z, matrix, vals_raw_ptr, isoValue, progress, cancelToken )
      */
     template<class AlgoBase, typename T>
     struct MCAlgoMapper : public MCAlgoMapperBase<AlgoBase>
@@ -297,12 +333,13 @@ namespace
                                                             const WMatrix<double>& matrix,
                                                             std::shared_ptr<WValueSetBase> valueSet,
                                                             double isoValue,
-                                                            std::shared_ptr<WProgressCombiner> progress )
+                                                            std::shared_ptr<WProgressCombiner> progress,
+                                                            WCancelToken::ConstSPtr cancelToken )
         {
             std::shared_ptr< WValueSet< T > > vals(
                     std::dynamic_pointer_cast< WValueSet< T > >( valueSet ) );
             WAssert( vals, "Data type and data type indicator must fit." );
-            return AlgoBase::generateSurface( x, y, z, matrix, vals->rawDataVectorPointer(), isoValue, progress );
+            return AlgoBase::generateSurface( x, y, z, matrix, vals->rawDataVectorPointer(), isoValue, progress, cancelToken );
         }
     };
 
@@ -313,7 +350,7 @@ namespace
      *
      * \param AlgoBase
      * AlgoBase is the algorithm that will be called and must implement
-     * AlgoBase::generateSurface( x,y,z, matrix, vals_raw_ptr, isoValue, progress )
+     * AlgoBase::generateSurface( x,y,z, matrix, vals_raw_ptr, isoValue, progress, cancelToken )
      *
      * \param enum_type the OpenWalnut type enum of the data on which the isosurface should be computed.
       */
@@ -347,7 +384,7 @@ namespace
     }
 }  // namespace
 
-void WMIsosurface::generateSurfacePre( double isoValue )
+void WMIsosurface::generateSurfacePre( double isoValue, WCancelToken::ConstSPtr cancelToken )
 {
     debugLog() << "Isovalue: " << isoValue;
     WAssert( ( *m_dataSet ).getValueSet()->order() == 0, "This module only works on scalars." );
@@ -375,7 +412,7 @@ void WMIsosurface::generateSurfacePre( double isoValue )
         m_triMesh = algo->execute( m_grid->getNbCoordsX(), m_grid->getNbCoordsY(), m_grid->getNbCoordsZ(),
                                           m_grid->getTransformationMatrix(),
                                           valueSet,
-                                          isoValue, m_progress );
+                                          isoValue, m_progress, cancelToken );
 
         // Set the info properties
         m_nbTriangles->set( m_triMesh->triangleSize() );
@@ -122,8 +122,9 @@ private:
      * Kind of a convenience function for generate surface.
      * It performs the conversions of the value sets of different data types.
      * \param isoValue The surface will represent this value.
+     * \param cancelToken the computation throws a WComputationCancelled after this got cancelled
      */
-    void generateSurfacePre( double isoValue );
+    void generateSurfacePre( double isoValue, WCancelToken::ConstSPtr cancelToken );
 
     std::shared_mutex m_updateLock; //!< Lock to prevent concurrent threads trying to update the osg node
 
@@ -137,11 +138,6 @@ private:
 
     WPropBool m_useMarchingLego; //!< Property indicating whether to use interpolated or non interpolated triangulation
 
-    /**
-     * This condition denotes whether we need to recompute the surface
-     */
-    std::shared_ptr< WCondition > m_recompute;
-
 
     std::shared_ptr< WModuleInputData< WDataSetScalar > > m_input;  //!< Input connector required by this module.
     std::shared_ptr< WModuleOutputData< WTriangleMesh > > m_output;  //!< Input connector required by this module.
@@ -24,12 +24,16 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <vector>
 
 #include "WMSampleOnFibers.h"
 #include "core/common/WPropertyHelper.h"
-#include "core/common/math/WMath.h"
 #include "core/dataHandler/WDataHandler.h"
+#include "core/dataHandler/WFiberSampler.h"
+#include "core/dataHandler/WFiberView.h"
+#include "core/dataHandler/exceptions/WDHException.h"
 #include "core/kernel/WKernel.h"
 
 // This line is needed by the module loader to actually find your module. You need to add this to your module too. Do NOT add a ";" here.
@@ -62,7 +66,8 @@ const std::string WMSampleOnFibers::getName() const
 
 const std::string WMSampleOnFibers::getDescription() const
 {
-    return "This module allows you to sample points on fibers using the parameters on a fiber.";
+    return "This module allows you to sample points on fibers using the parameters on a fiber. The parameters can be sampled from "
+           "a scalar dataset.";
 }
 
 void WMSampleOnFibers::connectors()
@@ -75,6 +80,18 @@ void WMSampleOnFibers::connectors()
     // As properties, every connector needs to be added to the list of connectors.
     addConnector( m_fiberInput );
 
+    // the optional scalars to sample along the fibers
+    m_scalarInput = std::shared_ptr< WModuleInputData < WDataSetScalar > >(
+        new WModuleInputData< WDataSetScalar >( shared_from_this(), "scalars", "The scalar dataset to sample at the fiber vertices." )
+    );
+    addConnector( m_scalarInput );
+
+    // the fibers with the sampled values
+    m_fiberOutput = std::shared_ptr< WModuleOutputData < WDataSetFibers > >(
+        new WModuleOutputData< WDataSetFibers >( shared_from_this(), "sampledFibers", "The fibers with the sampled scalar values." )
+    );
+    addConnector( m_fiberOutput );
+
     // the points
     m_pointsOutput = std::shared_ptr< WModuleOutputData < WDataSetPoints > >(
         new WModuleOutputData< WDataSetPoints >( shared_from_this(), "out", "The point data." )
@@ -102,11 +119,118 @@ void WMSampleOnFibers::properties()
     WModule::properties();
 }
 
+void WMSampleOnFibers::updateSampledFibers( std::shared_ptr< WDataSetFibers > fibers, std::shared_ptr< WDataSetScalar > scalars )
+{
+    m_sampledFibers = fibers;
+    if( !scalars )
+    {
+        m_fiberOutput->reset();
+        return;
+    }
+
+    debugLog() << "Sampling scalars at the fiber vertices.";
+    try
+    {
+        WFiberSampler sampler( *scalars );
+        m_sampledFibers = sampler.createSampledFibers( *fibers );
+    }
+    catch( WDHException const& e )
+    {
+        errorLog() << e.what();
+        m_fiberOutput->reset();
+        return;
+    }
+
+    // a gray color scheme allows coloring the fibers by the sampled values
+    WDataSetFibers::VertexParemeterArray values = m_sampledFibers->getVertexParameters();
+    if( !values->empty() )
+    {
+        double const min = *std::min_element( values->begin(), values->end() );
+        double const max = *std::max_element( values->begin(), values->end() );
+        double const scale = max > min ? 1.0 / ( max - min ) : 0.0;
+        WDataSetFibers::ColorArray colors( new WDataSetFibers::ColorArray::element_type( values->size() ) );
+        for( size_t i = 0; i < values->size(); ++i )
+        {
+            ( *colors )[ i ] = static_cast< float >( ( ( *values )[ i ] - min ) * scale );
+        }
+        m_sampledFibers->addColorScheme( colors, "Sampled Values", "The values of the scalar dataset at the vertices, scaled to [0,1]." );
+    }
+
+    m_fiberOutput->updateData( m_sampledFibers );
+}
+
+WDataSetPoints::VertexArray WMSampleOnFibers::createPoints( WDataSetFibers const& fibers, std::vector< double > const& params,
+                                                          double value ) const
+{
+    WFiberConstView const view = createFiberView( fibers );
+
+    // writes the points of a fiber if out is not NULL and returns their number
+    auto sampleFiber = [ &view, &params, value ]( size_t fidx, float* out )
+    {
+        WFiberConstSpan const fiber = view[ fidx ];
+        double const* param = params.data() + view.getStartIndex( fidx );
+        size_t count = 0;
+        for( size_t k = 0; k < fiber.size(); ++k )
+        {
+            // the first vertex on its own, then every crossing of a segment ( k - 1, k ] exactly once
+            double t = -1.0;
+            if( k == 0 )
+            {
+                t = ( param[ 0 ] == value ) ? 0.0 : -1.0;
+            }
+            else if( ( param[ k - 1 ] < value && value <= param[ k ] ) || ( param[ k ] <= value && value < param[ k - 1 ] ) )
+            {
+                t = ( value - param[ k - 1 ] ) / ( param[ k ] - param[ k - 1 ] );
+            }
+            if( t < 0.0 )
+            {
+                continue;
+            }
+
+            if( out )
+            {
+                // linearly interpolate
+                float const* a = fiber[ k == 0 ? 0 : k - 1 ];
+                float const* b = fiber[ k ];
+                for( size_t c = 0; c < 3; ++c )
+                {
+                    out[ 3 * count + c ] = static_cast< float >( a[ c ] + t * ( b[ c ] - a[ c ] ) );
+                }
+            }
+            ++count;
+        }
+        return count;
+    };
+
+    // count the points of each fiber first, so they can be written to their final place in parallel
+    std::vector< size_t > offsets( view.size() + 1, 0 );
+    forEachFiberBlock( view.size(), [ &sampleFiber, &offsets ]( size_t begin, size_t end )
+    {
+        for( size_t fidx = begin; fidx < end; ++fidx )
+        {
+            offsets[ fidx + 1 ] = sampleFiber( fidx, NULL );
+        }
+    } );
+    std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+
+    WDataSetPoints::VertexArray points( new WDataSetPoints::VertexArray::element_type( 3 * offsets.back() ) );
+    float* target = points->data();
+    forEachFiberBlock( view.size(), [ &sampleFiber, &offsets, target ]( size_t begin, size_t end )
+    {
+        for( size_t fidx = begin; fidx < end; ++fidx )
+        {
+            sampleFiber( fidx, target + 3 * offsets[ fidx ] );
+        }
+    } );
+    return points;
+}
+
 void WMSampleOnFibers::moduleMain()
 {
     // get notified about data changes
     m_moduleState.setResetable( true, true );
     m_moduleState.add( m_fiberInput->getDataChangedCondition() );
+    m_moduleState.add( m_scalarInput->getDataChangedCondition() );
     // Remember the condition provided to some properties in properties()? The condition can now be used with this condition set.
     m_moduleState.add( m_propCondition );
 
@@ -126,31 +250,32 @@ void WMSampleOnFibers::moduleMain()
 
         // To query whether an input was updated, simply ask the input:
         bool dataUpdated = m_fiberInput->handledUpdate();
+        dataUpdated = m_scalarInput->handledUpdate() || dataUpdated;
         std::shared_ptr< WDataSetFibers > dataSet = m_fiberInput->getData();
         bool dataValid = ( dataSet != NULL );
-        bool propsChanged = m_parameter ||
+        bool propsChanged = m_parameter->changed() ||
                             m_color->changed();
 
         // reset everything if input was disconnected/invalid
         if( !dataValid )
         {
             debugLog() << "Resetting output.";
+            m_sampledFibers.reset();
             m_pointsOutput->reset();
+            m_fiberOutput->reset();
             continue;
         }
 
         if( dataValid && dataUpdated )
         {
-            if( dataSet->getVertexParameters() )
+            // the sampled values are kept until fibers or scalars change
+            updateSampledFibers( dataSet, m_scalarInput->getData() );
+
+            WDataSetFibers::VertexParemeterArray params = m_sampledFibers->getVertexParameters();
+            if( params && !params->empty() )
             {
-                m_parameterMin = dataSet->getVertexParameters()->operator[]( 0 );
-                m_parameterMax = dataSet->getVertexParameters()->operator[]( 0 );
-                for( WDataSetFibers::VertexParemeterArray::element_type::const_iterator it = dataSet->getVertexParameters()->begin();
-                     it != dataSet->getVertexParameters()->end(); ++it )
-                {
-                    m_parameterMax = std::max( *it, m_parameterMax );
-                    m_parameterMin = std::min( *it, m_parameterMin );
-                }
+                m_parameterMin = *std::min_element( params->begin(), params->end() );
+                m_parameterMax = *std::max_element( params->begin(), params->end() );
             }
             else
             {
@@ -168,104 +293,32 @@ void WMSampleOnFibers::moduleMain()
             continue;
         }
 
-        WDataSetFibers::VertexArray fibVerts = dataSet->getVertices();
-        WDataSetFibers::ColorArray fibColors = dataSet->getColorScheme()->getColor();
-        WDataSetFibers::IndexArray  fibStart = dataSet->getLineStartIndexes();
-        WDataSetFibers::LengthArray fibLen   = dataSet->getLineLengths();
-        WDataSetFibers::VertexParemeterArray fibParams = dataSet->getVertexParameters();
-
-        debugLog() << "Creating point data.";
-        WDataSetFibers::VertexArray filteredVerts( new WDataSetFibers::VertexArray::element_type() );
-        WDataSetFibers::ColorArray filteredColors( new WDataSetFibers::ColorArray::element_type() );
-        WBoundingBox filteredBB;
-
+        WDataSetFibers::VertexParemeterArray fibParams = m_sampledFibers->getVertexParameters();
         if( fibParams )
         {
             m_paramHint->setHidden( true );
 
+            debugLog() << "Creating point data.";
             double v = m_parameter->get( true );
+            WColor color = m_color->get( true );
 
             // progress indication
-            WProgress::SPtr progress = WProgress::SPtr( new WProgress( "Creating Points from Fibers.", fibStart->size() ) );
+            WProgress::SPtr progress = WProgress::SPtr( new WProgress( "Creating Points from Fibers." ) );
             m_progress->addSubProgress( progress );
 
-            // for each fiber:
-            for( size_t fidx = 0; fidx < fibStart->size() ; ++fidx )
-            {
-                ++*progress;
-
-                // the start vertex index
-                size_t sidx = fibStart->at( fidx ) * 3;
-
-                // the length of the fiber
-                size_t len = fibLen->at( fidx );
-
-                // a line needs 2 verts at least, but also check first and only vertex
-                if( len < 2 )
-                {
-                    if( fibParams->at( fibStart->at( fidx ) ) == v )
-                    {
-                        filteredVerts->push_back( fibVerts->at( sidx + 0 ) );
-                        filteredVerts->push_back( fibVerts->at( sidx + 1 ) );
-                        filteredVerts->push_back( fibVerts->at( sidx + 2 ) );
-
-                        filteredBB.expandBy(
-                            osg::Vec3(
-                                fibVerts->at( sidx + 0 ),
-                                fibVerts->at( sidx + 1 ),
-                                fibVerts->at( sidx + 2 ) )
-                        );
-                    }
-                    continue;
-                }
-
-                // keep track of the previous vertex
-                osg::Vec3 lastVert = osg::Vec3( fibVerts->at( sidx ),
-                                                fibVerts->at( sidx + 1 ),
-                                                fibVerts->at( sidx + 2 ) );
-                // keep track of the previous value
-                double lastParam = fibParams->at( fibStart->at( fidx ) );
-
-                // walk along the fiber
-                for( size_t k = 0; k < len; ++k )
-                {
-                    // get current vertex and value
-                    osg::Vec3 vert = osg::Vec3( fibVerts->at( ( 3 * k ) + sidx ),
-                                                fibVerts->at( ( 3 * k ) + sidx + 1 ),
-                                                fibVerts->at( ( 3 * k ) + sidx + 2 ) );
-                    double param = fibParams->at( k + fibStart->at( fidx ) );
-
-                    // is there a sample in between the values?
-                    WIntervalDouble interval( param, lastParam );
-                    if( isInClosed( interval, v ) )
-                    {
-                        // linearly interpolate
-                        double n = ( v - lastParam ) / ( param - lastParam );
-                        osg::Vec3 interpolatedVert( lastVert + ( vert - lastVert ) * n );
-
-                        filteredVerts->push_back( interpolatedVert.x() );
-                        filteredVerts->push_back( interpolatedVert.y() );
-                        filteredVerts->push_back( interpolatedVert.z() );
-
-                        filteredBB.expandBy( interpolatedVert );
-                    }
-
-                    // keep track of the last value/vertex
-                    lastParam = param;
-                    lastVert = vert;
-                }
-            }
+            WDataSetPoints::VertexArray filteredVerts = createPoints( *m_sampledFibers, *fibParams, v );
 
             // add colors
-            for( size_t i = 0; i < filteredVerts->size() / 3; ++i )
+            WDataSetPoints::ColorArray filteredColors( new WDataSetPoints::ColorArray::element_type( filteredVerts->size() / 3 * 4 ) );
+            for( size_t i = 0; i < filteredColors->size(); i += 4 )
             {
-                filteredColors->push_back( m_color->get( true ).r() );
-                filteredColors->push_back( m_color->get( true ).g() );
-                filteredColors->push_back( m_color->get( true ).b() );
-                filteredColors->push_back( m_color->get( true ).a() );
+                ( *filteredColors )[ i + 0 ] = color.r();
+                ( *filteredColors )[ i + 1 ] = color.g();
+                ( *filteredColors )[ i + 2 ] = color.b();
+                ( *filteredColors )[ i + 3 ] = color.a();
             }
 
-            WDataSetPoints::SPtr result( new WDataSetPoints( filteredVerts, filteredColors, filteredBB ) );
+            WDataSetPoints::SPtr result( new WDataSetPoints( filteredVerts, filteredColors ) );
             m_pointsOutput->updateData( result );
             progress->finish();
             m_progress->removeSubProgress( progress );
@@ -278,4 +331,3 @@ void WMSampleOnFibers::moduleMain()
         }
     }
 }
-
@@ -27,15 +27,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "core/dataHandler/WDataSetFibers.h"
 #include "core/dataHandler/WDataSetPoints.h"
+#include "core/dataHandler/WDataSetScalar.h"
 #include "core/kernel/WModule.h"
 #include "core/kernel/WModuleInputData.h"
 #include "core/kernel/WModuleOutputData.h"
 
 /**
- * This modules takes a fiber dataset and samples it at a given parameter value.
+ * This modules takes a fiber dataset and samples it at a given parameter value. If a scalar dataset is connected, its
+ * values at the fiber vertices are used as parameters and the fibers are provided with the sampled values.
  *
  * \ingroup modules
  */
@@ -95,11 +98,48 @@ protected:
     virtual void properties();
 
 private:
+    /**
+     * Sample the scalar dataset at the vertices of the fibers and provide the fibers with the sampled values. Without scalar
+     * dataset the fibers are used as they are.
+     *
+     * \param fibers the input fibers
+     * \param scalars the scalar dataset, can be NULL
+     */
+    void updateSampledFibers( std::shared_ptr< WDataSetFibers > fibers, std::shared_ptr< WDataSetScalar > scalars );
+
+    /**
+     * Create the points where the parameter of the fibers equals the given value. The fibers are processed in parallel,
+     * the number of points of each fiber is counted first so all points are written directly to their final place.
+     *
+     * \param fibers the fibers
+     * \param params the parameter of each vertex
+     * \param value the parameter value to sample at
+     *
+     * \return the vertices of the points
+     */
+    WDataSetPoints::VertexArray createPoints( WDataSetFibers const& fibers, std::vector< double > const& params, double value ) const;
+
+
     /**
      * The fiber dataset which is going to be used.
      */
     std::shared_ptr< WModuleInputData< WDataSetFibers > > m_fiberInput;
 
+    /**
+     * The optional scalar dataset sampled at the fiber vertices.
+     */
+    std::shared_ptr< WModuleInputData< WDataSetScalar > > m_scalarInput;
+
+    /**
+     * The fibers with the sampled scalar values as vertex parameters.
+     */
+    std::shared_ptr< WModuleOutputData< WDataSetFibers > > m_fiberOutput;
+
+    /**
+     * The fibers whose parameters are used, either the input fibers or the fibers with the sampled values.
+     */
+    std::shared_ptr< WDataSetFibers > m_sampledFibers;
+
     /**
      * The output connector used to provide the calculated point data to other modules.
      */
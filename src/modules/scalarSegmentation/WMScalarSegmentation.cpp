@@ -92,7 +92,7 @@ void WMScalarSegmentation::connectors()
 
 void WMScalarSegmentation::properties()
 {
-    m_propCondition = std::shared_ptr< WCondition >( new WCondition() );
+    m_propCondition = m_recomputeScheduler.getCondition();
 
     m_algoSelection = std::shared_ptr< WItemSelection >( new WItemSelection );
     for( AlgoList::iterator it = m_algos.begin(); it != m_algos.end(); ++it )
@@ -119,23 +119,40 @@ void WMScalarSegmentation::moduleMain()
 {
     m_moduleState.setResetable( true, true );
     m_moduleState.add( m_input->getDataChangedCondition() );
-    m_moduleState.add( m_propCondition );
+
+    // every change requests a new segmentation, the condition of the scheduler is part of m_moduleState
+    m_recomputeScheduler.add( m_input->getDataChangedCondition() );
     for( AlgoList::iterator it = m_algos.begin(); it != m_algos.end(); ++it )
     {
-        m_moduleState.add( ( *it )->getCondition() );
+        m_recomputeScheduler.add( ( *it )->getCondition() );
     }
 
     ready();
 
     while( !m_shutdownFlag() )
     {
-        m_moduleState.wait();
+        // a change during the last segmentation outdated it, restart right away
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            m_moduleState.wait();
+        }
 
         if( m_shutdownFlag() )
         {
             break;
         }
 
+        // wait until the user stops changing the parameters
+        if( !m_recomputeScheduler.isRequested() )
+        {
+            continue;
+        }
+        WCancelToken::SPtr cancelToken = m_recomputeScheduler.start();
+        if( cancelToken->isCancelled() )
+        {
+            continue;
+        }
+
         std::shared_ptr< WDataSetScalar > newDataSet = m_input->getData();
         bool dataChanged = ( m_dataSet != newDataSet );
         bool dataValid   = ( newDataSet != NULL );
@@ -160,19 +177,21 @@ void WMScalarSegmentation::moduleMain()
             m_algos.at( m_algoIndex )->hideProperties( false );
         }
 
-        bool propChanged = m_algos.at( m_algoIndex )->propChanged();
-        if( m_dataSet && ( dataChanged || propChanged || algoChanged ) )
+        // every request stems from a change of the data, the algorithm or its parameters
+        if( m_dataSet )
         {
             // redo calculation
             doSegmentation();
+
+            // the segmentation algorithms cannot be interrupted, but an outdated result is not worth showing
+            if( cancelToken->isCancelled() )
+            {
+                debugLog() << "Discarding the outdated segmentation.";
+                continue;
+            }
             m_output->updateData( m_result );
         }
     }
-
-    for( AlgoList::iterator it = m_algos.begin(); it != m_algos.end(); ++it )
-    {
-        m_moduleState.remove( ( *it )->getCondition() );
-    }
 }
 
 void WMScalarSegmentation::activate()
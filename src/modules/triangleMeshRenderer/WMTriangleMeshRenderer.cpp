@@ -28,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <osg/Geode>
@@ -54,6 +55,11 @@ WMTriangleMeshRenderer::WMTriangleMeshRenderer():
 {
 }
 
+WMTriangleMeshRenderer::MeshGeometry::MeshGeometry():
+    m_mode( 0 )
+{
+}
+
 WMTriangleMeshRenderer::~WMTriangleMeshRenderer()
 {
     // Cleanup!
@@ -312,6 +318,16 @@ void WMTriangleMeshRenderer::moduleMain()
     moduleNodeState->addUniform( new WGEPropertyUniform< WPropDouble >( "u_opacity", m_opacity ) );
     moduleNodeState->addUniform( new WGEPropertyUniform< WPropBool >( "u_outline", m_showOutline ) );
 
+    // the geode keeps the mesh geometry, which gets swapped during the update traversal
+    m_meshGeode = new osg::Geode;
+    m_meshGeode->getOrCreateStateSet()->addUniform( m_colorMapTransformation );
+    m_meshGeode->getOrCreateStateSet()->addUniform( new WGEPropertyUniform< WPropDouble >( "u_colormapRatio", m_colormapRatio ) );
+    m_shader->apply( m_meshGeode );
+    WGEColormapping::apply( m_meshGeode, m_shader );
+    m_meshGeode->addUpdateCallback(
+        new WGEFunctorCallback< osg::Node >( boost::bind( &WMTriangleMeshRenderer::updateGeometry, this ) )
+    );
+
     // signal ready state. The module is now ready to be used.
     ready();
 
@@ -358,18 +374,10 @@ void WMTriangleMeshRenderer::renderMesh( std::shared_ptr< WTriangleMesh > mesh )
     m_nbTriangles->set( mesh->triangleSize() );
     m_nbVertices->set( mesh->vertSize() );
 
-    // prepare the geometry node
     debugLog() << "Start rendering Mesh";
-    osg::ref_ptr< osg::Geometry > geometry;
-    osg::ref_ptr< osg::Geode > geode( new osg::Geode );
-    geode->getOrCreateStateSet()->addUniform( m_colorMapTransformation );
-    geode->getOrCreateStateSet()->addUniform( new WGEPropertyUniform< WPropDouble >( "u_colormapRatio", m_colormapRatio ) );
-
-    // apply shader only to mesh
-    m_shader->apply( geode );
 
     // get the middle point of the mesh
-    std::vector< size_t >triangles = mesh->getTriangles();
+    std::vector< size_t > const& triangles = mesh->getTriangles();
     std::vector< size_t >::const_iterator trianglesIterator;
     double minX = wlimits::MAX_DOUBLE;
     double minY = wlimits::MAX_DOUBLE;
@@ -407,49 +415,71 @@ void WMTriangleMeshRenderer::renderMesh( std::shared_ptr< WTriangleMesh > mesh )
 
     // now create the mesh but handle the color mode properly
     WItemSelector renderingModeSelector = m_renderingMode->get( true );
+    std::size_t const renderingMode = renderingModeSelector.getItemIndexOfSelected( 0 );
+    WColor const color = m_color->get();
+    GeometryConversion conversion;
 
-    if( renderingModeSelector.getItemIndexOfSelected( 0 ) == 2 )
+    if( renderingMode == 2 )
     {
-        geometry = wge::convertToOsgGeometryLines( mesh, m_color->get(), false );
+        conversion = [ mesh, color ]( osg::ref_ptr< osg::Geometry > geometry ) // NOLINT
+        {
+            return wge::convertToOsgGeometryLines( mesh, color, false, geometry );
+        };
     }
-    else if( renderingModeSelector.getItemIndexOfSelected( 0 ) == 1 )
+    else if( renderingMode == 1 )
     {
         bool useColorFromMesh =  m_colorMode->get( true ).getItemIndexOfSelected( 0 ) == 1;
-        geometry = wge::convertToOsgGeometryFlatShaded( mesh, m_color->get(), true, true, useColorFromMesh );
+        conversion = [ mesh, color, useColorFromMesh ]( osg::ref_ptr< osg::Geometry > geometry ) // NOLINT
+        {
+            return wge::convertToOsgGeometryFlatShaded( mesh, color, true, true, useColorFromMesh, geometry );
+        };
     }
-    else // if( renderingModeSelector.getItemIndexOfSelected( 0 ) == 0 )
+    else // if( renderingMode == 0 )
     {
         WItemSelector colorModeSelector = m_colorMode->get( true );
-        if( colorModeSelector.getItemIndexOfSelected( 0 ) == 0 )
+        bool useColorFromMesh = colorModeSelector.getItemIndexOfSelected( 0 ) == 1;
+        if( colorModeSelector.getItemIndexOfSelected( 0 ) == 2 && colorMap )
         {
-            geometry = wge::convertToOsgGeometry( mesh, m_color->get(), true, true, false );
-        }
-        else if( colorModeSelector.getItemIndexOfSelected( 0 ) == 1 )
-        {
-            // take color from mesh
-            geometry = wge::convertToOsgGeometry( mesh, m_color->get(), true, true, true );
+            // take color from map
+            conversion = [ mesh, colorMap, color ]( osg::ref_ptr< osg::Geometry > geometry ) // NOLINT
+            {
+                return wge::convertToOsgGeometry( mesh, *colorMap, color, true, true, geometry );
+            };
         }
         else
         {
-            // take color from map
-            if( colorMap )
-            {
-                geometry = wge::convertToOsgGeometry( mesh, *colorMap, m_color->get(), true, true );
-            }
-            else
+            if( colorModeSelector.getItemIndexOfSelected( 0 ) == 2 )
             {
                 warnLog() << "External colormap not connected. Using default color.";
-                geometry = wge::convertToOsgGeometry( mesh, m_color->get(), true, true, false );
             }
+            // take color from mesh or use the default color
+            conversion = [ mesh, color, useColorFromMesh ]( osg::ref_ptr< osg::Geometry > geometry ) // NOLINT
+            {
+                return wge::convertToOsgGeometry( mesh, color, true, true, useColorFromMesh, geometry );
+            };
         }
     }
 
-    WGEColormapping::apply( geode, m_shader );
+    // convert into a geometry which is not drawn, the next update traversal shows it. A geometry that was not shown yet gets replaced
+    // anyway, so it is reused first.
+    MeshGeometry target;
+    {
+        std::lock_guard< std::mutex > lock( m_geometryMutex );
+        std::swap( target, m_readyGeometry.m_geometry.valid() ? m_readyGeometry : m_spareGeometry );
+    }
+    MeshGeometry converted;
+    converted.m_geometry = conversion( target.m_mode == renderingMode ? target.m_geometry : osg::ref_ptr< osg::Geometry >() );
+    converted.m_geometry->setDataVariance( osg::Object::DYNAMIC );
+    converted.m_mode = renderingMode;
+    {
+        std::lock_guard< std::mutex > lock( m_geometryMutex );
+        m_readyGeometry = converted;
+    }
+    ++*progress;
 
     // done. Set the new drawable
-    geode->addDrawable( geometry );
     m_moduleNode->clear();
-    m_moduleNode->insert( geode );
+    m_moduleNode->insert( m_meshGeode );
     if( m_showCoordinateSystem->get() )
     {
         m_moduleNode->insert( wge::creatCoordinateSystem( m_meshCenter,
@@ -463,6 +493,26 @@ void WMTriangleMeshRenderer::renderMesh( std::shared_ptr< WTriangleMesh > mesh )
     progress->finish();
 }
 
+void WMTriangleMeshRenderer::updateGeometry()
+{
+    std::lock_guard< std::mutex > lock( m_geometryMutex );
+    if( !m_readyGeometry.m_geometry.valid() )
+    {
+        return;
+    }
+
+    if( m_shownGeometry.m_geometry.valid() )
+    {
+        m_meshGeode->removeDrawable( m_shownGeometry.m_geometry );
+    }
+    m_meshGeode->addDrawable( m_readyGeometry.m_geometry );
+
+    // the replaced geometry is not drawn from now on
+    m_spareGeometry = m_shownGeometry;
+    m_shownGeometry = m_readyGeometry;
+    m_readyGeometry = MeshGeometry();
+}
+
 void WMTriangleMeshRenderer::updateTransformation()
 {
     if( m_moduleNode )
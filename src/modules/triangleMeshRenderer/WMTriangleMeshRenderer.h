@@ -25,9 +25,15 @@
 #ifndef WMTRIANGLEMESHRENDERER_H
 #define WMTRIANGLEMESHRENDERER_H
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 
+#include <boost/function.hpp>
+
+#include <osg/Geode>
+#include <osg/Geometry>
 #include <osg/Uniform>
 
 #include "core/common/datastructures/WColoredVertices.h"
@@ -297,6 +303,64 @@ private:
      */
     WGEManagedGroupNode::SPtr m_moduleNode;
 
+    /**
+     * Converts the mesh into the given geometry, or into a new one if it is NULL, and returns the geometry.
+     */
+    typedef boost::function< osg::ref_ptr< osg::Geometry >( osg::ref_ptr< osg::Geometry > ) > GeometryConversion;
+
+    /**
+     * A mesh geometry and the rendering mode it was converted with.
+     */
+    struct MeshGeometry
+    {
+        /**
+         * An empty one.
+         */
+        MeshGeometry();
+
+        /**
+         * The geometry, NULL if there is none.
+         */
+        osg::ref_ptr< osg::Geometry > m_geometry;
+
+        /**
+         * The rendering mode.
+         */
+        std::size_t m_mode;
+    };
+
+    /**
+     * Shows the geometry converted last, if there is a new one. Called every frame in the update traversal, as the geode must not be
+     * modified while it gets drawn. The conversion itself runs in the module thread, this only swaps the geometries.
+     */
+    void updateGeometry();
+
+    /**
+     * The geode containing the mesh geometry.
+     */
+    osg::ref_ptr< osg::Geode > m_meshGeode;
+
+    /**
+     * The geometry in m_meshGeode. Only used in the update traversal.
+     */
+    MeshGeometry m_shownGeometry;
+
+    /**
+     * The geometry to show in the next update traversal, empty if there is none.
+     */
+    MeshGeometry m_readyGeometry;
+
+    /**
+     * The geometry replaced by the last update traversal. It is not drawn anymore, so conversions with the same rendering mode update
+     * it in place.
+     */
+    MeshGeometry m_spareGeometry;
+
+    /**
+     * Protects m_readyGeometry and m_spareGeometry.
+     */
+    std::mutex m_geometryMutex;
+
     /**
      * The shader for the mesh
      */
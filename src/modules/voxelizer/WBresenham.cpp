@@ -67,6 +67,26 @@ void WBresenham::raster( const WLine& line )
     lock.unlock();
 }
 
+std::shared_ptr< WRasterAlgorithm > WBresenham::createThreadLocal() const
+{
+    std::shared_ptr< WBresenham > local = createEmpty();
+    for( size_t i = 0; i < m_parameterizations.size(); ++i )
+    {
+        std::shared_ptr< WRasterParameterization > parameterization = m_parameterizations[ i ]->createThreadLocal();
+        if( !parameterization )
+        {
+            return std::shared_ptr< WRasterAlgorithm >();
+        }
+        local->addParameterizationAlgorithm( parameterization );
+    }
+    return local;
+}
+
+std::shared_ptr< WBresenham > WBresenham::createEmpty() const
+{
+    return std::shared_ptr< WBresenham >( new WBresenham( m_grid, m_antialiased ) );
+}
+
 void WBresenham::rasterSegment( const WPosition& start, const WPosition& end )
 {
     int i;
@@ -68,7 +68,22 @@ public:
      */
     virtual void raster( const WLine& line );
 
+    /**
+     * Creates a Bresenham algorithm on the same grid with its own voxel values and thread-local copies of all parameterizations.
+     *
+     * \return the thread-local algorithm, or an invalid pointer if a parameterization does not support threads.
+     */
+    virtual std::shared_ptr< WRasterAlgorithm > createThreadLocal() const;
+
 protected:
+    /**
+     * Creates an algorithm of the same kind on the same grid, without parameterizations. Subclasses override this, so their thread-local
+     * copies use their own rasterization.
+     *
+     * \return the new algorithm
+     */
+    virtual std::shared_ptr< WBresenham > createEmpty() const;
+
     /**
      * Scans a line segment for voxels which are hit.
      *
@@ -39,6 +39,11 @@ WBresenhamDBL::~WBresenhamDBL()
 {
 }
 
+std::shared_ptr< WBresenham > WBresenhamDBL::createEmpty() const
+{
+    return std::shared_ptr< WBresenham >( new WBresenhamDBL( m_grid, m_antialiased ) );
+}
+
 void WBresenhamDBL::rasterSegment( const WPosition& start, const WPosition& end )
 {
     int i;
@@ -71,6 +71,13 @@ protected:
      */
     void rasterSegment( const WPosition& start, const WPosition& stop );
 
+    /**
+     * Creates a WBresenhamDBL on the same grid, without parameterizations.
+     *
+     * \return the new algorithm
+     */
+    virtual std::shared_ptr< WBresenham > createEmpty() const;
+
 private:
 };
 
@@ -25,19 +25,36 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "WCenterlineParameterization.h"
+#include "core/common/WAssert.h"
 #include "core/common/math/linearAlgebra/WVectorFixed.h"
 
 WCenterlineParameterization::WCenterlineParameterization( std::shared_ptr< WGridRegular3D > grid, std::shared_ptr< WFiber > centerline ):
     WRasterParameterization( grid ),
     m_paramValues( grid->size(), 0.0 ),
     m_paramFinalValues( grid->size(), 0.0 ),
-    m_paramSetValues( grid->size(), false ),
+    m_paramSetValues( grid->size(), 0 ),
     m_centerline( centerline ),
     m_currentStartParameter( 0.0 ),
-    m_currentEndParameter( 0.0 )
+    m_currentEndParameter( 0.0 ),
+    m_threadLocal( false )
+{
+    // initialize members
+}
+
+WCenterlineParameterization::WCenterlineParameterization( std::shared_ptr< WGridRegular3D > grid, std::shared_ptr< WFiber > centerline,
+                                                          bool threadLocal ):
+    WRasterParameterization( grid ),
+    m_paramValues( threadLocal ? 0 : grid->size(), 0.0 ),
+    m_paramFinalValues( threadLocal ? 0 : grid->size(), 0.0 ),
+    m_paramSetValues( threadLocal ? 0 : grid->size(), 0 ),
+    m_centerline( centerline ),
+    m_currentStartParameter( 0.0 ),
+    m_currentEndParameter( 0.0 ),
+    m_threadLocal( threadLocal )
 {
     // initialize members
 }
@@ -125,27 +142,84 @@ void WCenterlineParameterization::parameterizeVoxel( const WVector3i& voxel, siz
                                                       const double /*value*/,
                                                       const WPosition& /*start*/,
                                                       const WPosition& /*end*/ )
+{
+    if( m_threadLocal )
+    {
+        VoxelUpdate update = { voxel, m_currentStartParameter }; // NOLINT curly braces
+        m_updates.push_back( update );
+        return;
+    }
+    updateNeighbourhood( voxel, m_currentStartParameter, 0, m_grid->getNbCoordsZ() );
+}
+
+void WCenterlineParameterization::updateNeighbourhood( const WVector3i& voxel, double parameter, size_t firstZ, size_t endZ )
 {
     // update a 27 neighbourhood
     wcp::Neighbourhood n = wcp::neighbourhood( voxel[0], voxel[1], voxel[2], m_grid );
+    size_t const nbXY = m_grid->getNbCoordsX() * m_grid->getNbCoordsY();
 
     // now update the neighbourhood
     for( unsigned int i = 0; i < 27; ++i )
     {
+        if( n.indices[i] < firstZ * nbXY || n.indices[i] >= endZ * nbXY )
+        {
+            continue;
+        }
+
         if( m_paramSetValues[ n.indices[i] ] )
         {
-            m_paramValues[ n.indices[i] ] = 0.5 * ( m_paramValues[ n.indices[i] ] + m_currentStartParameter );
-            //m_paramValues[ n.indices[i] ] = std::max( m_paramValues[ n.indices[i] ], m_currentStartParameter );
+            m_paramValues[ n.indices[i] ] = 0.5 * ( m_paramValues[ n.indices[i] ] + parameter );
+            //m_paramValues[ n.indices[i] ] = std::max( m_paramValues[ n.indices[i] ], parameter );
         }
         else
         {
-            m_paramValues[ n.indices[i] ] = m_currentStartParameter;
+            m_paramValues[ n.indices[i] ] = parameter;
         }
 
         m_paramSetValues[ n.indices[i] ] = true;
     }
 }
 
+std::shared_ptr< WRasterParameterization > WCenterlineParameterization::createThreadLocal() const
+{
+    return std::shared_ptr< WRasterParameterization >( new WCenterlineParameterization( m_grid, m_centerline, true ) );
+}
+
+void WCenterlineParameterization::merge( std::vector< std::shared_ptr< WRasterParameterization > > const& locals )
+{
+    std::vector< std::shared_ptr< WCenterlineParameterization > > centerlines;
+    for( size_t j = 0; j < locals.size(); ++j )
+    {
+        centerlines.push_back( std::dynamic_pointer_cast< WCenterlineParameterization >( locals[ j ] ) );
+        WAssert( centerlines.back() && centerlines.back()->m_threadLocal, "Can only merge thread-local centerline parameterizations." );
+    }
+
+    // every slab replays all updates in order, but only writes its own voxels
+    std::ptrdiff_t const nbZ = m_grid->getNbCoordsZ();
+    std::ptrdiff_t const nbSlabs = std::min< std::ptrdiff_t >( nbZ, std::max( 1u, std::thread::hardware_concurrency() ) );
+    #pragma omp parallel for schedule( static )
+    for( std::ptrdiff_t slab = 0; slab < nbSlabs; ++slab )
+    {
+        int const firstZ = static_cast< int >( nbZ * slab / nbSlabs );
+        int const endZ = static_cast< int >( nbZ * ( slab + 1 ) / nbSlabs );
+        for( size_t j = 0; j < centerlines.size(); ++j )
+        {
+            std::vector< VoxelUpdate > const& updates = centerlines[ j ]->m_updates;
+            for( size_t i = 0; i < updates.size(); ++i )
+            {
+                // the neighbourhood reaches one slice further, voxels outside of the grid are clamped to it
+                int const lastSlice = static_cast< int >( nbZ ) - 1;
+                int const z = updates[ i ].m_voxel[2];
+                if( std::min( std::max( z + 1, 0 ), lastSlice ) < firstZ || std::min( std::max( z - 1, 0 ), lastSlice ) >= endZ )
+                {
+                    continue;
+                }
+                updateNeighbourhood( updates[ i ].m_voxel, updates[ i ].m_parameter, firstZ, endZ );
+            }
+        }
+    }
+}
+
 void WCenterlineParameterization::newLine( const WLine& line )
 {
     // do nothing here
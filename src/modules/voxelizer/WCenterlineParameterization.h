@@ -91,7 +91,51 @@ public:
      */
     virtual void finished();
 
+    /**
+     * Creates a parameterization for one thread which only records its voxel updates, they are replayed in order by merge().
+     *
+     * \return the thread-local parameterization.
+     */
+    virtual std::shared_ptr< WRasterParameterization > createThreadLocal() const;
+
+    /**
+     * Replays the voxel updates of the thread-local parameterizations in the order of their lines. Since the values are averaged
+     * with every update, only this order gives the same values as a single threaded rasterization. A voxel only depends on the
+     * updates of its own neighbourhood, so slabs along the z axis are replayed in parallel.
+     *
+     * \param locals the thread-local parameterizations in the order of their lines.
+     */
+    virtual void merge( std::vector< std::shared_ptr< WRasterParameterization > > const& locals );
+
 protected:
+    /**
+     * A recorded update of the 27-neighbourhood of a voxel.
+     */
+    struct VoxelUpdate
+    {
+        WVector3i m_voxel; //!< the center voxel
+        double m_parameter; //!< the centerline parameter of the segment
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param grid the grid used for the new dataset.
+     * \param centerline the centerline of the cluster
+     * \param threadLocal if true, only record updates without allocating the value grids.
+     */
+    WCenterlineParameterization( std::shared_ptr< WGridRegular3D > grid, std::shared_ptr< WFiber > centerline, bool threadLocal );
+
+    /**
+     * Averages the parameter into the voxels of the 27-neighbourhood of a voxel within a range of z slices.
+     *
+     * \param voxel the center voxel
+     * \param parameter the centerline parameter
+     * \param firstZ the first z slice to update
+     * \param endZ the z slice after the last one to update
+     */
+    void updateNeighbourhood( const WVector3i& voxel, double parameter, size_t firstZ, size_t endZ );
+
     /**
      * Stores the current length of the centerline fiber at each voxel.
      */
@@ -103,9 +147,9 @@ protected:
     std::vector< double > m_paramFinalValues;
 
     /**
-     * Stores whether the voxel has been set in the past or not.
+     * Stores whether the voxel has been set in the past or not. Not a vector of bool, so slabs can be written in parallel.
      */
-    std::vector< bool > m_paramSetValues;
+    std::vector< char > m_paramSetValues;
 
     /**
      * The centerline of the cluster
@@ -122,6 +166,17 @@ protected:
      */
     double m_currentEndParameter;
 
+    /**
+     * True if this instance records the updates of one thread.
+     */
+    bool m_threadLocal;
+
+    /**
+     * The recorded updates of a thread-local instance in rasterization order. WMVoxelizer rasterizes in rounds and merges after
+     * each of them, which bounds their number.
+     */
+    std::vector< VoxelUpdate > m_updates;
+
 private:
 };
 
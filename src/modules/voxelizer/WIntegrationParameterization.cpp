@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "WIntegrationParameterization.h"
+#include "core/common/WAssert.h"
 #include "core/common/math/linearAlgebra/WVectorFixed.h"
 
 WIntegrationParameterization::WIntegrationParameterization( std::shared_ptr< WGridRegular3D > grid ):
@@ -75,36 +76,22 @@ void WIntegrationParameterization::parameterizeVoxel( const WVector3i& voxel, si
                                                       const WPosition& /*start*/,
                                                       const WPosition& /*end*/ )
 {
-    // ok, this looks ugly but setting the whole 27-neighborhood produces better results
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]+1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]+1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]+1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]-1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]-1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1]-1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1],   voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1],   voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0],   voxel[1],   voxel[2],   m_grid ) ] = m_curLength;
-
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]+1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]+1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]+1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]-1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]-1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1]-1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1],   voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1],   voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]+1, voxel[1],   voxel[2],   m_grid ) ] = m_curLength;
-
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]+1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]+1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]+1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]-1, voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]-1, voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1]-1, voxel[2],   m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1],   voxel[2]+1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1],   voxel[2]-1, m_grid ) ] = m_curLength;
-    m_lengthValues[ wip::index( voxel[0]-1, voxel[1],   voxel[2],   m_grid ) ] = m_curLength;
+    // setting the whole 27-neighborhood produces better results
+    for( int x = -1; x <= 1; ++x )
+    {
+        for( int y = -1; y <= 1; ++y )
+        {
+            for( int z = -1; z <= 1; ++z )
+            {
+                size_t idx = wip::index( voxel[0] + x, voxel[1] + y, voxel[2] + z, m_grid );
+                m_lengthValues[ idx ] = m_curLength;
+                if( !m_written.empty() )
+                {
+                    m_written[ idx ] = true;
+                }
+            }
+        }
+    }
 }
 
 void WIntegrationParameterization::newLine( const WLine& /*line*/ )
@@ -119,3 +106,40 @@ void WIntegrationParameterization::newSegment( const WPosition& start, const WPo
     m_curLength += length2( start - end );
 }
 
+
+std::shared_ptr< WRasterParameterization > WIntegrationParameterization::createThreadLocal() const
+{
+    std::shared_ptr< WIntegrationParameterization > local( new WIntegrationParameterization( m_grid ) );
+    local->m_written.resize( m_grid->size(), false );
+    return local;
+}
+
+size_t WIntegrationParameterization::getThreadLocalBytes() const
+{
+    return m_grid->size() * ( sizeof( double ) + sizeof( char ) );
+}
+
+void WIntegrationParameterization::merge( std::vector< std::shared_ptr< WRasterParameterization > > const& locals )
+{
+    std::vector< std::shared_ptr< WIntegrationParameterization > > integrations;
+    for( size_t j = 0; j < locals.size(); ++j )
+    {
+        integrations.push_back( std::dynamic_pointer_cast< WIntegrationParameterization >( locals[ j ] ) );
+        WAssert( integrations.back() && !integrations.back()->m_written.empty(),
+                 "Can only merge thread-local integration parameterizations." );
+    }
+
+    std::ptrdiff_t const nbValues = m_lengthValues.size();
+    #pragma omp parallel for schedule( static )
+    for( std::ptrdiff_t i = 0; i < nbValues; ++i )
+    {
+        for( size_t j = integrations.size(); j > 0; --j )
+        {
+            if( integrations[ j - 1 ]->m_written[ i ] )
+            {
+                m_lengthValues[ i ] = integrations[ j - 1 ]->m_lengthValues[ i ];
+                break;
+            }
+        }
+    }
+}
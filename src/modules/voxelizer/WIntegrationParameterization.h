@@ -85,6 +85,27 @@ public:
      */
     virtual void newSegment( const WPosition& start, const WPosition& end );
 
+    /**
+     * Creates a parameterization for one thread, which additionally remembers the voxels it has written.
+     *
+     * \return the thread-local parameterization.
+     */
+    virtual std::shared_ptr< WRasterParameterization > createThreadLocal() const;
+
+    /**
+     * A thread-local parameterization has the values and the written flags of every voxel.
+     *
+     * \return the number of bytes.
+     */
+    virtual size_t getThreadLocalBytes() const;
+
+    /**
+     * Every voxel gets the value of the last thread which has written it, as the last line written it in a single threaded rasterization.
+     *
+     * \param locals the thread-local parameterizations in the order of their lines.
+     */
+    virtual void merge( std::vector< std::shared_ptr< WRasterParameterization > > const& locals );
+
 protected:
     /**
      * Stores the current length of the fiber at each voxel.
@@ -96,6 +117,11 @@ protected:
      */
     double m_curLength;
 
+    /**
+     * For thread-local instances: whether a voxel has been written, empty otherwise.
+     */
+    std::vector< char > m_written;
+
 private:
 };
 
@@ -26,7 +26,9 @@
 #include <iomanip>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -41,11 +43,14 @@
 #include "WMVoxelizer.h"
 #include "WRasterAlgorithm.h"
 #include "core/common/WColor.h"
+#include "core/common/WException.h"
 #include "core/common/WLogger.h"
 #include "core/common/WPropertyHelper.h"
+#include "core/common/WThreadedFunction.h"
 #include "core/common/datastructures/WFiber.h"
 #include "core/dataHandler/WDataSetFiberVector.h"
 #include "core/dataHandler/WDataSetScalar.h"
+#include "core/dataHandler/WFiberView.h"
 #include "core/dataHandler/WGridTransformOrtho.h"
 #include "core/dataHandler/WSubject.h"
 #include "core/dataHandler/datastructures/WFiberCluster.h"
@@ -65,6 +70,99 @@
 // This line is needed by the module loader to actually find your module.
 W_LOADABLE_MODULE( WMVoxelizer )
 
+namespace
+{
+    //! the thread-local grids of all threads together may use this much memory
+    size_t const THREAD_LOCAL_MEMORY = size_t( 1 ) << 30;
+
+    //! the number of lines each thread rasterizes before the thread-local results are merged, bounds recorded updates
+    size_t const LINES_PER_ROUND = size_t( 1 ) << 15;
+
+    /**
+     * Rasterizes a consecutive range of lines per thread into a thread-local copy of a raster algorithm. The copies are merged
+     * afterwards in the order of their line ranges. To be used with WThreadedFunction.
+     */
+    class WRasterThreadFunction
+    {
+    public:
+        //! copies the line with the given index into the given line
+        typedef boost::function< void ( size_t, WLine* ) > LineFunction;
+
+        /**
+         * Constructor.
+         *
+         * \param algo The algorithm to create the thread-local copies from.
+         * \param begin The first line.
+         * \param end The line after the last one.
+         * \param getLine Gets a line by index.
+         */
+        WRasterThreadFunction( std::shared_ptr< const WRasterAlgorithm > algo, size_t begin, size_t end, LineFunction const& getLine )
+            : m_algo( algo ),
+              m_begin( begin ),
+              m_nbLines( end - begin ),
+              m_getLine( getLine )
+        {
+        }
+
+        /**
+         * Rasterizes the lines of this thread.
+         *
+         * \param id The number of this thread.
+         * \param mx The number of threads.
+         * \param stop Set if the computation should be stopped.
+         */
+        void operator()( size_t id, size_t mx, WBoolFlag const& stop )
+        {
+            std::shared_ptr< WRasterAlgorithm > local = m_algo->createThreadLocal();
+            {
+                std::lock_guard< std::mutex > lock( m_localsMutex );
+                m_locals.resize( std::max( m_locals.size(), mx ) );
+                m_locals[ id ] = local;
+            }
+            if( !local )
+            {
+                return;
+            }
+
+            WLine line;
+            for( size_t i = m_begin + m_nbLines * id / mx; i < m_begin + m_nbLines * ( id + 1 ) / mx && !stop(); ++i )
+            {
+                m_getLine( i, &line );
+                local->raster( line );
+            }
+        }
+
+        /**
+         * The thread-local algorithms in the order of their lines. Contains invalid pointers if the algorithm does not support threads.
+         *
+         * \return the algorithms
+         */
+        std::vector< std::shared_ptr< WRasterAlgorithm > > const& getLocals() const
+        {
+            return m_locals;
+        }
+
+    private:
+        //! the algorithm to copy
+        std::shared_ptr< const WRasterAlgorithm > m_algo;
+
+        //! the first line
+        size_t m_begin;
+
+        //! the number of lines
+        size_t m_nbLines;
+
+        //! gets the lines
+        LineFunction m_getLine;
+
+        //! protects m_locals
+        std::mutex m_localsMutex;
+
+        //! the thread-local algorithms
+        std::vector< std::shared_ptr< WRasterAlgorithm > > m_locals;
+    };
+}
+
 WMVoxelizer::WMVoxelizer()
     : WModule(),
       m_fullUpdate( new WCondition() )
@@ -305,7 +403,23 @@ std::shared_ptr< WFiber > WMVoxelizer::longestLine( std::shared_ptr< const WData
     {
         return cluster->getLongestLine();
     }
-    return longestLine( tracts );
+
+    // find the longest tract on the flat arrays and copy only this one
+    std::shared_ptr< WFiber > result( new WFiber() );
+    WFiberConstView const view = createFiberView( *tracts );
+    std::size_t longest = 0;
+    for( std::size_t i = 1; i < view.size(); ++i )
+    {
+        if( view.getLength( i ) > view.getLength( longest ) )
+        {
+            longest = i;
+        }
+    }
+    if( view.size() > 0 )
+    {
+        view[ longest ].copyTo( result.get() );
+    }
+    return result;
 }
 
 std::shared_ptr< WFiber > WMVoxelizer::centerLine( std::shared_ptr< const WDataSetFibers > tracts,
@@ -315,30 +429,81 @@ std::shared_ptr< WFiber > WMVoxelizer::centerLine( std::shared_ptr< const WDataS
     {
         return cluster->getCenterLine();
     }
-    return centerLine( tracts );
+    return ::centerLine( tracts );
 }
 
 void WMVoxelizer::raster( std::shared_ptr< WRasterAlgorithm > algo, std::shared_ptr< const WDataSetFibers > tracts,
         std::shared_ptr< const WFiberCluster > cluster ) const
 {
-    // for each tract apply a call to algo->raster( tract );
-
+    // for each tract apply a call to algo->raster( tract ), the tracts are either those of the cluster or all tracts
+    size_t nbLines = 0;
+    WRasterThreadFunction::LineFunction getLine;
+    std::vector< size_t > tractIDs;
+    WFiberConstView const view = createFiberView( *tracts );
     if( cluster )
     {
         std::shared_ptr< const WDataSetFiberVector > clusterTracts = cluster->getDataSetReference();
-        const std::list< size_t >& tractIDs = cluster->getIndices();
-        std::list< size_t >::const_iterator cit = tractIDs.begin();
-        for( cit = tractIDs.begin(); cit != tractIDs.end(); ++cit )
+        tractIDs.assign( cluster->getIndices().begin(), cluster->getIndices().end() );
+        nbLines = tractIDs.size();
+        getLine = [ &tractIDs, clusterTracts ]( size_t i, WLine* line )
         {
-            algo->raster( clusterTracts->at( *cit ) );
-        }
+            *line = clusterTracts->at( tractIDs[ i ] );
+        };
     }
     else
     {
-        std::shared_ptr< WDataSetFiberVector > allTracts( new WDataSetFiberVector( tracts ) );
-        for( WDataSetFiberVector::const_iterator cit = allTracts->begin(); cit != allTracts->end(); ++cit )
+        // rasterize directly from the flat arrays, each thread reuses one line for all its tracts
+        nbLines = view.size();
+        getLine = [ &view ]( size_t i, WLine* line )
+        {
+            view[ i ].copyTo( line );
+        };
+    }
+
+    // every thread keeps its own copy of the grids, large grids use fewer threads
+    size_t const threadLocalBytes = std::max< size_t >( algo->getThreadLocalBytes(), 1 );
+    size_t const nbThreads = std::min< size_t >( std::max( 1u, std::thread::hardware_concurrency() / 2 ),
+                                                 THREAD_LOCAL_MEMORY / threadLocalBytes );
+    bool parallel = nbThreads > 1;
+    if( !parallel )
+    {
+        debugLog() << "Not enough memory for thread-local grids, rasterizing single threaded.";
+    }
+
+    // in every round each thread rasterizes a consecutive range of tracts into its own grids, merging them in this order gives the
+    // same result as rasterizing all tracts one after another
+    for( size_t begin = 0; begin < nbLines && parallel; begin += nbThreads * LINES_PER_ROUND )
+    {
+        size_t const end = std::min( nbLines, begin + nbThreads * LINES_PER_ROUND );
+        std::shared_ptr< WRasterThreadFunction > function( new WRasterThreadFunction( algo, begin, end, getLine ) );
+        WThreadedFunction< WRasterThreadFunction > pool( nbThreads, function );
+        pool.run();
+        pool.wait();
+        if( pool.status() != W_THREADS_FINISHED )
+        {
+            throw WException( std::string( "A thread rasterizing the tracts was aborted." ) );
+        }
+
+        std::vector< std::shared_ptr< WRasterAlgorithm > > const& locals = function->getLocals();
+        parallel = std::find( locals.begin(), locals.end(), std::shared_ptr< WRasterAlgorithm >() ) == locals.end();
+        if( parallel )
+        {
+            algo->merge( locals );
+        }
+        else
+        {
+            // nothing was merged yet, as every round creates the same kind of thread-local algorithms
+            debugLog() << "Rasterization algorithm does not support threads, rasterizing single threaded.";
+        }
+    }
+
+    if( !parallel )
+    {
+        WLine line;
+        for( size_t i = 0; i < nbLines; ++i )
         {
-            algo->raster( *cit );
+            getLine( i, &line );
+            algo->raster( line );
         }
     }
 
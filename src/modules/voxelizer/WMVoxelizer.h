@@ -134,7 +134,9 @@ protected:
     osg::ref_ptr< osg::Node > genDataSetGeode( std::shared_ptr< WDataSetScalar > dataset ) const;
 
     /**
-     * Performs rasterization with the given algorithm on either all tracts or only a subset if given.
+     * Performs rasterization with the given algorithm on either all tracts or only a subset if given. The tracts are split into
+     * consecutive ranges rasterized in parallel into thread-local copies of the algorithm, which are merged into the given one.
+     * The copies of large grids limit the number of threads, and long lists of tracts are rasterized and merged in rounds.
      *
      * \param algo The algorithm which actually rasters every fiber.
      * \param tracts Dataset of tracts.
@@ -170,9 +172,6 @@ protected:
      * \param tracts The dataset of tracts.
      * \param cluster A subset of tracts.
      *
-     * \note This involves heavy computational time, including dataset convertion to WDataSetFiberVector, since I didn't had the
-     * time to use the crappy index lists of the original WDataSetFibers.
-     *
      * \return A reference of a copy of the longest line.
      */
     std::shared_ptr< WFiber > longestLine( std::shared_ptr< const WDataSetFibers > tracts,
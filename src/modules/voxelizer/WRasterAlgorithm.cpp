@@ -22,12 +22,14 @@
 //
 //---------------------------------------------------------------------------
 
+#include <algorithm>
 #include <memory>
 #include <shared_mutex>
 #include <vector>
 
 
 #include "WRasterAlgorithm.h"
+#include "core/common/WAssert.h"
 #include "core/common/WLogger.h"
 #include "core/common/math/linearAlgebra/WVectorFixed.h"
 #include "core/dataHandler/WDataSetScalar.h"
@@ -106,3 +108,53 @@ void WRasterAlgorithm::finished()
     lock.unlock();
 }
 
+
+std::shared_ptr< WRasterAlgorithm > WRasterAlgorithm::createThreadLocal() const
+{
+    // not supported by default
+    return std::shared_ptr< WRasterAlgorithm >();
+}
+
+void WRasterAlgorithm::merge( std::vector< std::shared_ptr< WRasterAlgorithm > > const& locals )
+{
+    // lock the parameterization list for reading
+    boost::shared_lock< std::shared_mutex > lock =  boost::shared_lock< std::shared_mutex >( m_parameterizationsLock );
+
+    // the maximum does not depend on the order of the threads, so the voxels can be reduced in parallel
+    for( size_t j = 0; j < locals.size(); ++j )
+    {
+        WAssert( locals[ j ]->m_values.size() == m_values.size(), "Thread-local raster algorithm uses another grid." );
+        WAssert( locals[ j ]->m_parameterizations.size() == m_parameterizations.size(), "Thread-local parameterizations missing." );
+    }
+    std::ptrdiff_t const nbValues = m_values.size();
+    #pragma omp parallel for schedule( static )
+    for( std::ptrdiff_t i = 0; i < nbValues; ++i )
+    {
+        for( size_t j = 0; j < locals.size(); ++j )
+        {
+            m_values[ i ] = std::max( m_values[ i ], locals[ j ]->m_values[ i ] );
+        }
+    }
+
+    for( size_t i = 0; i < m_parameterizations.size(); ++i )
+    {
+        std::vector< std::shared_ptr< WRasterParameterization > > parameterizations;
+        for( size_t j = 0; j < locals.size(); ++j )
+        {
+            parameterizations.push_back( locals[ j ]->m_parameterizations[ i ] );
+        }
+        m_parameterizations[ i ]->merge( parameterizations );
+    }
+
+    lock.unlock();
+}
+
+size_t WRasterAlgorithm::getThreadLocalBytes() const
+{
+    size_t bytes = m_values.size() * sizeof( double );
+    for( size_t i = 0; i < m_parameterizations.size(); ++i )
+    {
+        bytes += m_parameterizations[ i ]->getThreadLocalBytes();
+    }
+    return bytes;
+}
@@ -90,6 +90,32 @@ public:
      */
     virtual void finished();
 
+    /**
+     * Creates an empty raster algorithm of the same kind with its own voxel values and thread-local copies of all parameterizations. It
+     * is used by one thread of a parallel rasterization and merged back with merge(). The default implementation returns an invalid
+     * pointer, which means the algorithm can only be used by a single thread. Call this after all parameterizations were added.
+     *
+     * \return the thread-local raster algorithm or an invalid pointer.
+     */
+    virtual std::shared_ptr< WRasterAlgorithm > createThreadLocal() const;
+
+    /**
+     * Merges the results of thread-local raster algorithms created with createThreadLocal(). The lines rasterized by locals[ i ] directly
+     * follow the lines rasterized by locals[ i - 1 ]. Voxel values are combined with their maximum, which is order independent for the
+     * values composed by WBresenham, the parameterizations are merged by WRasterParameterization::merge().
+     *
+     * \param locals the thread-local raster algorithms in the order of their lines.
+     */
+    void merge( std::vector< std::shared_ptr< WRasterAlgorithm > > const& locals );
+
+    /**
+     * The memory of the grids a thread-local raster algorithm created with createThreadLocal() allocates, including its
+     * parameterizations.
+     *
+     * \return the number of bytes.
+     */
+    size_t getThreadLocalBytes() const;
+
 protected:
     /**
      * All the parameterization algorithms to apply while rasterizing a line.
@@ -23,6 +23,7 @@
 //---------------------------------------------------------------------------
 
 #include <memory>
+#include <vector>
 
 #include "WRasterParameterization.h"
 
@@ -55,3 +56,20 @@ void WRasterParameterization::finished()
     // Overwrite in your class if you need to handle this.
 }
 
+
+std::shared_ptr< WRasterParameterization > WRasterParameterization::createThreadLocal() const
+{
+    // not supported by default
+    return std::shared_ptr< WRasterParameterization >();
+}
+
+size_t WRasterParameterization::getThreadLocalBytes() const
+{
+    return 0;
+}
+
+void WRasterParameterization::merge( std::vector< std::shared_ptr< WRasterParameterization > > const& /*locals*/ )
+{
+    // do nothing here
+    // Overwrite in your class if you implement createThreadLocal.
+}
@@ -26,6 +26,7 @@
 #define WRASTERPARAMETERIZATION_H
 
 #include <memory>
+#include <vector>
 
 #include "core/common/math/WLine.h"
 #include "core/common/math/linearAlgebra/WPosition.h"
@@ -94,6 +95,31 @@ public:
      */
     virtual void finished();
 
+    /**
+     * Creates an empty parameterization of the same kind for one thread of a parallel rasterization, see merge(). The default
+     * implementation returns an invalid pointer, which means that this parameterization can only be used by a single thread.
+     *
+     * \return the thread-local parameterization or an invalid pointer.
+     */
+    virtual std::shared_ptr< WRasterParameterization > createThreadLocal() const;
+
+    /**
+     * The memory of the grids a thread-local parameterization created with createThreadLocal() allocates. The default
+     * implementation returns zero.
+     *
+     * \return the number of bytes.
+     */
+    virtual size_t getThreadLocalBytes() const;
+
+    /**
+     * Merges the results of thread-local parameterizations created with createThreadLocal() into this one. The lines rasterized by
+     * locals[ i ] directly follow the lines rasterized by locals[ i - 1 ], so the result has to equal the one of rasterizing all lines
+     * with this instance. Gets called before finished().
+     *
+     * \param locals the thread-local parameterizations in the order of their lines.
+     */
+    virtual void merge( std::vector< std::shared_ptr< WRasterParameterization > > const& locals );
+
 protected:
     /**
      * The grid, which needs to be used for the created dataset and to which the parameterizeVoxel method is relating to.
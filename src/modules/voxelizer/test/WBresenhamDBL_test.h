@@ -107,6 +107,15 @@ public:
         TS_ASSERT_EQUALS( m_algo->m_values, expected );
     }
 
+    /**
+     * Thread-local copies raster with the DBL algorithm too.
+     */
+    void testCreateThreadLocal( void )
+    {
+        std::shared_ptr< WRasterAlgorithm > local = m_algo->createThreadLocal();
+        TS_ASSERT( std::dynamic_pointer_cast< WBresenhamDBL >( local ) );
+    }
+
 // TODO(math): This fails, but I decided not to improve the DBL algo, instead I write a new one with christians approach
 // So either fix this or create a new one and discard this algorithm. The traceback of the error is in the err1 and err2
 // variables: is must be err1 = dy2 -l - ( dx2 * yoffset ); etc.. but this makes new issues!
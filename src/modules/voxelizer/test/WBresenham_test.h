@@ -31,6 +31,8 @@
 #include <cxxtest/TestSuite.h>
 
 #include "../WBresenham.h"
+#include "../WCenterlineParameterization.h"
+#include "../WIntegrationParameterization.h"
 #include "core/common/WLogger.h"
 
 /**
@@ -188,7 +190,86 @@ public:
         m_algo->raster( k );
         TS_ASSERT_EQUALS( m_algo->m_values, expected );
     }
+
+    /**
+     * Rasterizing consecutive ranges of lines with thread-local algorithms and merging them gives exactly the same values and
+     * parameterizations as rasterizing all lines with one algorithm, also if the ranges are merged in several rounds.
+     */
+    void testThreadLocalMerge( void )
+    {
+        std::shared_ptr< WGridRegular3D > grid( new WGridRegular3D( 20, 20, 20 ) );
+        std::shared_ptr< WFiber > centerline( new WFiber() );
+        centerline->push_back( WPosition( 1.0, 10.0, 10.0 ) );
+        centerline->push_back( WPosition( 10.0, 10.0, 10.0 ) );
+        centerline->push_back( WPosition( 18.0, 10.0, 10.0 ) );
+
+        // crossing lines so that many voxels are hit by several lines
+        std::vector< WLine > lines;
+        for( size_t i = 0; i < 30; ++i )
+        {
+            WLine line;
+            line.push_back( WPosition( 1.0 + 0.3 * i, 2.0 + 0.5 * i, 3.0 ) );
+            line.push_back( WPosition( 10.0, 10.0 - 0.1 * i, 10.0 ) );
+            line.push_back( WPosition( 17.5 - 0.4 * i, 16.0, 4.0 + 0.45 * i ) );
+            lines.push_back( line );
+        }
+
+        for( int antialiased = 0; antialiased < 2; ++antialiased )
+        {
+            std::shared_ptr< WBresenham > single( new WBresenham( grid, antialiased ) );
+            std::shared_ptr< WBresenham > merged( new WBresenham( grid, antialiased ) );
+            std::shared_ptr< WCenterlineParameterization > singleCenterline( new WCenterlineParameterization( grid, centerline ) );
+            std::shared_ptr< WCenterlineParameterization > mergedCenterline( new WCenterlineParameterization( grid, centerline ) );
+            std::shared_ptr< WIntegrationParameterization > singleIntegration( new WIntegrationParameterization( grid ) );
+            std::shared_ptr< WIntegrationParameterization > mergedIntegration( new WIntegrationParameterization( grid ) );
+            single->addParameterizationAlgorithm( singleCenterline );
+            single->addParameterizationAlgorithm( singleIntegration );
+            merged->addParameterizationAlgorithm( mergedCenterline );
+            merged->addParameterizationAlgorithm( mergedIntegration );
+
+            std::vector< std::shared_ptr< WRasterAlgorithm > > locals;
+            for( size_t i = 0; i < lines.size(); ++i )
+            {
+                single->raster( lines[ i ] );
+                if( i % 7 == 0 )
+                {
+                    locals.push_back( merged->createThreadLocal() );
+                    TS_ASSERT( locals.back() );
+                }
+                locals.back()->raster( lines[ i ] );
+
+                // with antialiasing merge in two rounds
+                if( antialiased == 1 && i == 13 )
+                {
+                    merged->merge( locals );
+                    locals.clear();
+                }
+            }
+            single->finished();
+            merged->merge( locals );
+            merged->finished();
+
+            TS_ASSERT_EQUALS( single->m_values, merged->m_values );
+            TS_ASSERT_EQUALS( getValues( singleCenterline ), getValues( mergedCenterline ) );
+            TS_ASSERT_EQUALS( getValues( singleIntegration ), getValues( mergedIntegration ) );
+        }
+    }
+
 private:
+    /**
+     * The values of a parameterization.
+     *
+     * \param parameterization the parameterization
+     *
+     * \return the values
+     */
+    std::vector< double > getValues( std::shared_ptr< WRasterParameterization > parameterization )
+    {
+        std::shared_ptr< WValueSet< double > > values = std::dynamic_pointer_cast< WValueSet< double > >(
+                parameterization->getDataSet()->getValueSet() );
+        return std::vector< double >( values->rawData(), values->rawData() + values->rawSize() );
+    }
+
     std::shared_ptr< WBresenham > m_algo; //!< test instace of the WBresenham algo
 };
 
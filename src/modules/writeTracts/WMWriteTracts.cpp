@@ -136,7 +136,15 @@ void WMWriteTracts::moduleMain()
                         WWriterFiberVTK w( m_savePath->get(), true );
                         if( m_clusterIC->getData() )
                         {
-                            w.writeFibs( m_clusterIC->getData()->getDataSetReference() );
+                            // write the fibers of the cluster only, without copying them
+                            std::shared_ptr< const WFiberCluster > cluster = m_clusterIC->getData();
+                            std::shared_ptr< std::vector< bool > > selection(
+                                new std::vector< bool >( cluster->getDataSetReference()->size(), false ) );
+                            for( size_t index : cluster->getIndices() )
+                            {
+                                ( *selection )[ index ] = true;
+                            }
+                            w.writeFibs( cluster->getDataSetReference(), selection );
                         }
                         else if( m_tractIC->getData() )
                         {
@@ -62,6 +62,7 @@
 #include "core/common/WIOTools.h"
 #include "core/common/WPathHelper.h"
 #include "core/common/WProjectFileIO.h"
+#include "core/common/WTracer.h"
 #include "core/dataHandler/WDataHandler.h"
 #include "core/dataHandler/WDataSetFibers.h"
 #include "core/dataHandler/WDataSetSingle.h"
@@ -361,6 +362,13 @@ void WMainWindow::setupGUI()
     m_settingsMenu->addSeparator();
     m_settingsMenu->addMenu( logLevels );
     m_settingsMenu->addSeparator();
+    QMenu* traceMenu = m_settingsMenu->addMenu( "Tracing" );
+    QAction* recordTrace = traceMenu->addAction( "Record Trace" );
+    recordTrace->setCheckable( true );
+    recordTrace->setChecked( WTracer::isEnabled() );
+    connect( recordTrace, SIGNAL( toggled( bool ) ), this, SLOT( handleTraceRecording( bool ) ) );
+    traceMenu->addAction( "Export Trace ...", this, SLOT( exportTrace() ) );
+    m_settingsMenu->addSeparator();
     m_settingsAction->setMenu( m_settingsMenu );
 
     QAction* controlPanelTrigger = m_controlPanel->toggleViewAction();
@@ -1172,6 +1180,38 @@ void WMainWindow::handleLogLevelUpdate( unsigned int logLevel )
     WLogger::getLogger()->setDefaultLogLevel( static_cast< LogLevel >( logLevel ) );
 }
 
+void WMainWindow::handleTraceRecording( bool record )
+{
+    if( record )
+    {
+        // start with an empty trace
+        WTracer::clear();
+    }
+    WTracer::setEnabled( record );
+}
+
+void WMainWindow::exportTrace()
+{
+    QString lastPath = WQtGui::getSettings().value( "LastTraceSavePath", "" ).toString();
+    QString selected = QFileDialog::getSaveFileName( this, "Export Trace", lastPath, "Chrome Trace (*.json)" );
+    if( selected == "" )
+    {
+        return;
+    }
+
+    boost::filesystem::path p( selected.toStdString() );
+    WQtGui::getSettings().setValue( "LastTraceSavePath", QString::fromStdString( p.parent_path().string() ) );
+    if( p.extension() != ".json" )
+    {
+        p += ".json";
+    }
+
+    if( !WTracer::writeChromeTrace( p ) )
+    {
+        QMessageBox::critical( this, "Export Trace", QString::fromStdString( "Could not write the trace to " + p.string() + "." ) );
+    }
+}
+
 void WMainWindow::handleGLVendor()
 {
     // WARNING: never put blocking code here, as it might freeze the mainGLWidget.
@@ -527,6 +527,18 @@ private:
     void slotLoadFinished( boost::filesystem::path file, std::vector< std::string > errors, std::vector< std::string > warnings );
 
 private slots:
+    /**
+     * Starts or stops recording a trace.
+     *
+     * \param record true to start recording.
+     */
+    void handleTraceRecording( bool record );
+
+    /**
+     * Asks for a file name and writes the recorded trace to it.
+     */
+    void exportTrace();
+
     /**
      * Handles some special GL vendors and shows the user a dialog.
      */
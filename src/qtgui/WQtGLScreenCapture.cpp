@@ -26,7 +26,7 @@
 #include <sstream>
 #include <string>
 
-#include <osgDB/WriteFile>
+#include <boost/filesystem.hpp>
 
 #include <QtCore/QDir>
 #include <QtCore/QEvent>
@@ -44,7 +44,8 @@
 WQtGLScreenCapture::WQtGLScreenCapture( WQtGLDockWidget* parent ):
     QWidget( parent ),
     m_glDockWidget( parent ),
-    m_viewer( m_glDockWidget->getGLWidget()->getViewer() )
+    m_viewer( m_glDockWidget->getGLWidget()->getViewer() ),
+    m_frameWriter( new WGEFrameWriter() )
 {
     // initialize
     setObjectName( "Recorder Dock - " + parent->getDockTitle() );
@@ -123,8 +124,25 @@ WQtGLScreenCapture::WQtGLScreenCapture( WQtGLDockWidget* parent ):
                                     "OpenWalnut - " + parent->getDockTitle() + " - Frame %f.png" ).toStdString();
     m_configFileEdit->setText( QString::fromStdString( defaultFilename ) );
 
+    // movie frames are encoded in background threads
+    m_configFormatCombo = new QComboBox();
+    m_configFormatCombo->addItem( "Image files (format by file extension)" );
+    m_configFormatCombo->addItem( "Raw frames in a single file (encode later)" );
+    m_configFormatCombo->setToolTip( "Raw frames are not compressed. This is fastest but needs a lot of disk space. "
+                                     "The command to encode the raw file with ffmpeg is written to the log." );
+
+    m_configQueueCombo = new QComboBox();
+    m_configQueueCombo->addItem( "Wait for the encoders (no frame loss)" );
+    m_configQueueCombo->addItem( "Drop new frames" );
+    m_configQueueCombo->addItem( "Drop old frames" );
+    m_configQueueCombo->setToolTip( "What to do if frames are captured faster than they can be written." );
+
     fileGroupLayout->addWidget( configFileHint );
     fileGroupLayout->addWidget( m_configFileEdit );
+    fileGroupLayout->addWidget( new QLabel( "Movie Format" ) );
+    fileGroupLayout->addWidget( m_configFormatCombo );
+    fileGroupLayout->addWidget( new QLabel( "If Encoding Falls Behind" ) );
+    fileGroupLayout->addWidget( m_configQueueCombo );
 
     // add the groups
     configLayout->addWidget( resolutionGroup );
@@ -168,7 +186,8 @@ WQtGLScreenCapture::WQtGLScreenCapture( WQtGLDockWidget* parent ):
     movieLabel->setText( "Take a screenshot for every frame with the current camera. You need to specify a filename "
                          "in the toolbox item \"Configuration\". "
                               "You should always add %f to your filename to differentiate between each frame. "
-                              "This kind of recording can be very slow and produce a high IO load on your machine. Consider recording movies with "
+                              "The frames are encoded and written in the background. Nevertheless, this kind of recording can produce "
+                              "a high IO load on your machine. Consider recording movies with "
                               "the animation tool which plays back a previously recorded scene and snapshot it frame-wise. "
                               "To create a movie with these images, you can use free encoders like ffmpeg, transcode or mencoder."
                               );
@@ -223,6 +242,8 @@ void WQtGLScreenCapture::saveSettings()
     WQtGui::getSettings().setValue( objectName() + "/customResolutionWidth", m_customWidth->text() );
     WQtGui::getSettings().setValue( objectName() + "/customResolutionHeight", m_customHeight->text() );
     WQtGui::getSettings().setValue( objectName() + "/filename", m_configFileEdit->text() );
+    WQtGui::getSettings().setValue( objectName() + "/movieFormat", m_configFormatCombo->currentIndex() );
+    WQtGui::getSettings().setValue( objectName() + "/movieQueue", m_configQueueCombo->currentIndex() );
 }
 
 void WQtGLScreenCapture::restoreSettings()
@@ -231,6 +252,8 @@ void WQtGLScreenCapture::restoreSettings()
     m_customHeight->setText( WQtGui::getSettings().value( objectName() + "/customResolutionHeight", m_customHeight->text() ).toString() );
     m_configFileEdit->setText( WQtGui::getSettings().value( objectName() + "/filename", m_configFileEdit->text() ).toString() );
     m_resolutionCombo->setCurrentIndex(  WQtGui::getSettings().value( objectName() + "/resolution", m_resolutionCombo->currentIndex() ).toInt() );
+    m_configFormatCombo->setCurrentIndex( WQtGui::getSettings().value( objectName() + "/movieFormat", 0 ).toInt() );
+    m_configQueueCombo->setCurrentIndex( WQtGui::getSettings().value( objectName() + "/movieQueue", 0 ).toInt() );
 }
 
 QAction* WQtGLScreenCapture::getScreenshotTrigger() const
@@ -257,8 +280,11 @@ void WQtGLScreenCapture::handleImage( size_t /* framesLeft */, size_t totalFrame
         filename.replace( pos, 2, ss.str() );
     }
 
-    wlog::info( "WQtGLScreenCapture" ) << "Writing frame " << totalFrames << " to " << filename;
-    osgDB::writeImageFile( *image, filename );
+    wlog::debug( "WQtGLScreenCapture" ) << "Queueing frame " << totalFrames << " for " << filename;
+    if( !m_frameWriter->push( image, filename ) )
+    {
+        wlog::warn( "WQtGLScreenCapture" ) << "Dropped a frame as the encoders are busy.";
+    }
 }
 
 bool WQtGLScreenCapture::event( QEvent* event )
@@ -310,13 +336,29 @@ void WQtGLScreenCapture::screenShot()
 void WQtGLScreenCapture::startRec()
 {
     wlog::info( "WQtGLScreenCapture" ) << "Started recording.";
+    m_frameWriter->setQueuePolicy( static_cast< WGEFrameWriter::QueuePolicy >( m_configQueueCombo->currentIndex() ) );
+    if( m_configFormatCombo->currentIndex() == 1 )
+    {
+        // all frames go to one file, the frame number tag is useless here
+        std::string filename = m_configFileEdit->text().toStdString();
+        size_t pos;
+        while( ( pos = filename.find( "%f" ) ) != std::string::npos )
+        {
+            filename.erase( pos, 2 );
+        }
+        m_frameWriter->setRawFile( boost::filesystem::path( filename ).replace_extension( ".raw" ).string() );
+    }
     m_viewer->getScreenCapture()->recordStart();
 }
 
 void WQtGLScreenCapture::stopRec()
 {
-    wlog::info( "WQtGLScreenCapture" ) << "Stopped recording.";
     m_viewer->getScreenCapture()->recordStop();
+
+    // write the remaining frames, this also closes the raw file
+    m_frameWriter->setRawFile( "" );
+    wlog::info( "WQtGLScreenCapture" ) << "Stopped recording. Frames written so far: " << m_frameWriter->getWrittenFrames()
+                                       << ", dropped: " << m_frameWriter->getDroppedFrames() << ".";
 }
 
 void WQtGLScreenCapture::resetFrames()
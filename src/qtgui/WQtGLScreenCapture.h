@@ -40,6 +40,7 @@
 #include <osg/Image>
 #include <osg/RenderInfo>
 
+#include "core/graphicsEngine/WGEFrameWriter.h"
 #include "core/graphicsEngine/WGEViewer.h"
 
 #include "WIconManager.h"
@@ -147,7 +148,7 @@ private:
     void recCallback();
 
     /**
-     * The function handles new images. Implement it.
+     * The function handles new images. It queues them for the frame writer.
      *
      * \param framesLeft how much frames to come
      * \param totalFrames the total number of frames until now
@@ -155,6 +156,11 @@ private:
      */
     void handleImage( size_t framesLeft, size_t totalFrames, osg::ref_ptr< osg::Image > image ) const;
 
+    /**
+     * Encodes and writes the captured frames in the background.
+     */
+    WGEFrameWriter::SPtr m_frameWriter;
+
     /**
      * Recording - callback connection
      */
@@ -180,6 +186,16 @@ private:
      */
     QLineEdit* m_configFileEdit;
 
+    /**
+     * Selects whether movie frames are written as image files or appended to a raw file.
+     */
+    QComboBox* m_configFormatCombo;
+
+    /**
+     * Selects what to do with new frames if the encoders cannot keep up.
+     */
+    QComboBox* m_configQueueCombo;
+
     /**
      * Shows recorded frames.
      */
@@ -107,7 +107,16 @@ int main( int argc, char** argv )
         ( "log,l", po::value< std::string >(), ( std::string( "The log-file to use. If not specified, \"" ) + logFile +
                                                  std::string( "\" is used in the current directory." ) ).c_str() )
         ( "interp,i", po::value< std::string >(), "The interpreter to use." )
-        ( "file,f", po::value< std::vector< std::string > >()->multitoken(), "The script file to load and its parameters." );
+        ( "file,f", po::value< std::vector< std::string > >()->multitoken(), "The script file to load and its parameters." )
+        ( "trace,t", po::value< std::string >(), "Record a trace of the session and write it as Chrome trace JSON to the given file "
+                                                 "on exit. Open it with https://ui.perfetto.dev." )
+        ( "project,p", po::value< std::string >(), "Run the given project without interaction and exit as soon as all modules are idle." )
+        ( "report,r", po::value< std::string >(), "Together with --project: write the timing and memory report as JSON to the given file." )
+        ( "dump,d", po::value< std::string >(), "Together with --project: write all module outputs to the given directory." )
+        ( "settle-time", po::value< unsigned int >()->default_value( 2000 ),
+          "Together with --project: the time in ms all modules need to be idle before the project counts as finished." )
+        ( "timeout", po::value< double >()->default_value( 0.0 ),
+          "Together with --project: give up after the given time in s, 0 waits forever." );
 
     boost::program_options::variables_map optionsMap;
     try
@@ -128,7 +137,8 @@ int main( int argc, char** argv )
         printVersion();
         return 0;
     }
-    else if( optionsMap.count( "help" ) || ( optionsMap.count( "interp" ) == 0 && optionsMap.count( "file" ) == 0 ) )
+    else if( optionsMap.count( "help" ) || ( optionsMap.count( "interp" ) == 0 && optionsMap.count( "file" ) == 0 &&
+                                                 optionsMap.count( "project" ) == 0 ) )
     {
         // NOTE: if you modify this, check that help2man still works properly! (http://www.gnu.org/software/help2man) But be careful. There need
         // to be several manual changes to be done in the manual after help2man has done its job.
@@ -143,6 +153,9 @@ int main( int argc, char** argv )
                   << "  openwalnut-script -i python \t\tStartup OpenWalnut in python interpreter mode." << std::endl
                   << std::endl
                   << "  openwalnut-script -f doSth.py\t\tStart OpenWalnut and execute the doSth.py python script." << std::endl
+                  << std::endl
+                  << "  openwalnut-script -p nightly.owp -r report.json -d out\tRun nightly.owp, report the module timings to" << std::endl
+                  << "\t\t\t\t\t\treport.json and write all results to the directory out." << std::endl
                   << std::endl;
         return 0;
     }
@@ -0,0 +1,624 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#if( defined( __linux__ ) && !defined( __ANDROID__ ) )
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <osg/Vec3>
+
+#include "WBatchRunner.h"
+#include "core/common/WLogger.h"
+#include "core/common/WProgressCombiner.h"
+#include "core/common/WPropertyTypes.h"
+#include "core/common/WTracer.h"
+#include "core/dataHandler/WDataSetFibers.h"
+#include "core/dataHandler/WDataSetSingle.h"
+#include "core/dataHandler/WValueSet.h"
+#include "core/graphicsEngine/WTriangleMesh.h"
+#include "core/kernel/WKernel.h"
+#include "core/kernel/WModuleContainer.h"
+#include "core/kernel/WModuleInputConnector.h"
+#include "core/kernel/WModuleOutputConnector.h"
+#include "core/kernel/WProjectFile.h"
+
+namespace
+{
+    /**
+     * Calculates the memory used by the values of a value set.
+     */
+    struct ValueSetSize : public boost::static_visitor< int64_t >
+    {
+        /**
+         * Calculates the size.
+         *
+         * \tparam T the value type
+         * \param valueSet the value set
+         *
+         * \return the size in bytes
+         */
+        template< typename T >
+        int64_t operator()( WValueSet< T > const* valueSet ) const
+        {
+            return static_cast< int64_t >( valueSet->rawSize() * sizeof( T ) );
+        }
+    };
+
+    /**
+     * Describes a writer module able to dump data of some type.
+     */
+    struct WriterDescription
+    {
+        //! the name of the module
+        char const* m_module;
+
+        //! the name of the input connector
+        char const* m_input;
+
+        //! the property holding the file name
+        char const* m_filename;
+
+        //! the trigger property starting the write
+        char const* m_trigger;
+
+        //! the extension of the written file
+        char const* m_extension;
+    };
+
+    /**
+     * Finds a writer for the given data.
+     *
+     * \param data the data
+     *
+     * \return the writer or NULL if there is none
+     */
+    WriterDescription const* findWriter( std::shared_ptr< WTransferable > data )
+    {
+        static WriterDescription const nifti = { "Write NIfTI", "in", "Filename", "Do save", ".nii" }; // NOLINT curly braces
+        static WriterDescription const tracts = { "Write Tracts", "tractInput", "Save Path", "Save", ".fib" }; // NOLINT curly braces
+        static WriterDescription const mesh = { "Write Mesh", "mesh", "Save Surface/Mesh file", "Save Surface/Do save", ".vtk" }; // NOLINT
+
+        if( std::dynamic_pointer_cast< WDataSetSingle >( data ) )
+        {
+            return &nifti;
+        }
+        if( std::dynamic_pointer_cast< WDataSetFibers >( data ) )
+        {
+            return &tracts;
+        }
+        if( std::dynamic_pointer_cast< WTriangleMesh >( data ) )
+        {
+            return &mesh;
+        }
+        return NULL;
+    }
+
+    /**
+     * Replaces all characters which might cause trouble in file names.
+     *
+     * \param name the name
+     *
+     * \return the cleaned name
+     */
+    std::string sanitize( std::string name )
+    {
+        for( std::string::iterator it = name.begin(); it != name.end(); ++it )
+        {
+            if( !std::isalnum( static_cast< unsigned char >( *it ) ) && *it != '-' )
+            {
+                *it = '_';
+            }
+        }
+        return name;
+    }
+
+    /**
+     * Escapes a string for use in JSON.
+     *
+     * \param str the string
+     *
+     * \return the quoted and escaped string
+     */
+    std::string quote( std::string const& str )
+    {
+        std::ostringstream out;
+        out << '"';
+        for( std::string::const_iterator it = str.begin(); it != str.end(); ++it )
+        {
+            switch( *it )
+            {
+                case '"':
+                    out << "\\\"";
+                    break;
+                case '\\':
+                    out << "\\\\";
+                    break;
+                case '\n':
+                    out << "\\n";
+                    break;
+                case '\t':
+                    out << "\\t";
+                    break;
+                default:
+                    if( static_cast< unsigned char >( *it ) < 0x20 )
+                    {
+                        out << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' ) << static_cast< int >( *it ) << std::dec;
+                    }
+                    else
+                    {
+                        out << *it;
+                    }
+            }
+        }
+        out << '"';
+        return out.str();
+    }
+
+    /**
+     * What the project loader reports back. It is shared with the loader thread.
+     */
+    struct LoadState
+    {
+        /**
+         * Constructor.
+         */
+        LoadState()
+            : m_done( false )
+        {
+        }
+
+        //! true as soon as the loader is done
+        std::atomic< bool > m_done;
+
+        //! protects the messages
+        std::mutex m_mutex;
+
+        //! the errors of the loader
+        std::vector< std::string > m_errors;
+
+        //! the warnings of the loader
+        std::vector< std::string > m_warnings;
+    };
+
+    //! the time between two samples
+    std::chrono::milliseconds const samplingInterval( 10 );
+}
+
+WBatchRunner::WBatchRunner( boost::filesystem::path project )
+    : m_project( project ),
+      m_settleTime( 2000 ),
+      m_timeout( 0.0 ),
+      m_totalWallTime( 0.0 ),
+      m_totalCPUTime( 0.0 )
+{
+}
+
+void WBatchRunner::setReportFile( boost::filesystem::path report )
+{
+    m_report = report;
+}
+
+void WBatchRunner::setDumpDirectory( boost::filesystem::path directory )
+{
+    m_dumpDirectory = directory;
+}
+
+void WBatchRunner::setSettleTime( unsigned int milliseconds )
+{
+    m_settleTime = milliseconds;
+}
+
+void WBatchRunner::setTimeout( double seconds )
+{
+    m_timeout = seconds;
+}
+
+int WBatchRunner::run()
+{
+    WTRACE_SCOPE( "Batch run" );
+
+    if( !boost::filesystem::exists( m_project ) )
+    {
+        wlog::error( "Batch" ) << "Could not find project file: " << m_project.string();
+        return 1;
+    }
+
+    wlog::info( "Batch" ) << "Processing project " << m_project.string();
+    bool const timedOut = !monitor();
+    if( timedOut )
+    {
+        wlog::error( "Batch" ) << "Modules still busy after " << m_timeout << "s. Stopped waiting.";
+    }
+
+    bool crashed = false;
+    for( std::vector< ModuleStatistics >::const_iterator it = m_statistics.begin(); it != m_statistics.end(); ++it )
+    {
+        crashed = crashed || it->m_module->isCrashed()();
+    }
+
+    if( !m_dumpDirectory.empty() && !timedOut )
+    {
+        dumpOutputs();
+    }
+
+    logSummary();
+    if( !m_report.empty() )
+    {
+        std::ofstream out( m_report.string().c_str() );
+        writeReport( out, timedOut );
+        if( !out )
+        {
+            wlog::error( "Batch" ) << "Could not write report to " << m_report.string();
+            return 1;
+        }
+        wlog::info( "Batch" ) << "Wrote report to " << m_report.string();
+    }
+
+    if( timedOut )
+    {
+        return 2;
+    }
+    return ( crashed || !m_errors.empty() ) ? 1 : 0;
+}
+
+bool WBatchRunner::monitor()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // the project loader runs in its own thread and reports back when all modules are created and connected
+    std::shared_ptr< LoadState > loaded( new LoadState() );
+    std::shared_ptr< WProjectFile > proj( new WProjectFile( m_project,
+        [ loaded ]( boost::filesystem::path, std::vector< std::string > errors, std::vector< std::string > warnings )
+        {
+            std::lock_guard< std::mutex > lock( loaded->m_mutex );
+            loaded->m_errors = errors;
+            loaded->m_warnings = warnings;
+            loaded->m_done = true;
+        } ) );
+
+    Clock::time_point const start = Clock::now();
+    Clock::time_point idleSince = start;
+    double const startCPU = getProcessCPUTime();
+    double lastCPU = startCPU;
+    Clock::time_point lastSample = start;
+    std::map< WModule*, std::size_t > indices;
+    bool timedOut = false;
+
+    proj->load();
+
+    std::shared_ptr< WModuleContainer > root = WKernel::getRunningKernel()->getRootContainer();
+    while( true )
+    {
+        std::this_thread::sleep_for( samplingInterval );
+
+        Clock::time_point const now = Clock::now();
+        double const cpu = getProcessCPUTime();
+        std::size_t const rss = getCurrentRSS();
+        double const interval = std::chrono::duration< double >( now - lastSample ).count();
+
+        // add new modules and update the state of all the others
+        std::vector< std::size_t > busy;
+        {
+            WModuleContainer::ModuleSharedContainerType::Snapshot modules = root->getModuleSnapshot();
+            for( WModuleContainer::ModuleConstIterator it = modules->begin(); it != modules->end(); ++it )
+            {
+                std::map< WModule*, std::size_t >::const_iterator index = indices.find( it->get() );
+                if( index == indices.end() )
+                {
+                    ModuleStatistics stats = { *it, false, 0, 0.0, 0.0, 0, 0 }; // NOLINT curly braces
+                    index = indices.insert( std::make_pair( it->get(), m_statistics.size() ) ).first;
+                    m_statistics.push_back( stats );
+                }
+
+                ModuleStatistics& stats = m_statistics[ index->second ];
+                bool const isBusy = WBatchRunner::isBusy( *it );
+                if( isBusy && !stats.m_busy )
+                {
+                    ++stats.m_busyPeriods;
+                    stats.m_rssAtStart = rss;
+                }
+                stats.m_busy = isBusy;
+                if( isBusy )
+                {
+                    busy.push_back( index->second );
+                }
+            }
+        }
+
+        for( std::vector< std::size_t >::const_iterator it = busy.begin(); it != busy.end(); ++it )
+        {
+            ModuleStatistics& stats = m_statistics[ *it ];
+            stats.m_wallTime += interval;
+            stats.m_cpuTime += ( cpu - lastCPU ) / busy.size();
+            if( rss > stats.m_rssAtStart )
+            {
+                stats.m_peakRSSDelta = std::max( stats.m_peakRSSDelta, rss - stats.m_rssAtStart );
+            }
+        }
+        lastCPU = cpu;
+        lastSample = now;
+
+        // finished when the project is loaded and nothing happened for a while
+        if( !busy.empty() || !loaded->m_done )
+        {
+            idleSince = now;
+        }
+        else if( now - idleSince >= std::chrono::milliseconds( m_settleTime ) )
+        {
+            break;
+        }
+
+        if( m_timeout > 0.0 && std::chrono::duration< double >( now - start ).count() > m_timeout )
+        {
+            timedOut = true;
+            break;
+        }
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( loaded->m_mutex );
+        if( !loaded->m_done )
+        {
+            m_errors.push_back( "Loading the project did not finish." );
+        }
+        m_errors.insert( m_errors.end(), loaded->m_errors.begin(), loaded->m_errors.end() );
+        m_warnings = loaded->m_warnings;
+    }
+
+    // the settle time is not part of the processing
+    m_totalWallTime = std::chrono::duration< double >( ( timedOut ? lastSample : idleSince ) - start ).count();
+    m_totalCPUTime = lastCPU - startCPU;
+    return !timedOut;
+}
+
+bool WBatchRunner::isBusy( WModule::SPtr module )
+{
+    if( module->isCrashed()() )
+    {
+        return false;
+    }
+    if( !module->isReadyOrCrashed()() )
+    {
+        return true;
+    }
+    std::shared_ptr< WProgressCombiner > progress = module->getRootProgressCombiner();
+    progress->update();
+    return progress->isPending();
+}
+
+void WBatchRunner::writeReport( std::ostream& out, bool timedOut ) const
+{
+    out << "{" << std::endl
+        << "  \"project\": " << quote( m_project.string() ) << "," << std::endl
+        << "  \"timedOut\": " << ( timedOut ? "true" : "false" ) << "," << std::endl
+        << "  \"wallTime\": " << m_totalWallTime << "," << std::endl
+        << "  \"cpuTime\": " << m_totalCPUTime << "," << std::endl;
+
+    out << "  \"errors\": [";
+    for( std::size_t i = 0; i < m_errors.size(); ++i )
+    {
+        out << ( i ? ", " : "" ) << quote( m_errors[ i ] );
+    }
+    out << "]," << std::endl << "  \"warnings\": [";
+    for( std::size_t i = 0; i < m_warnings.size(); ++i )
+    {
+        out << ( i ? ", " : "" ) << quote( m_warnings[ i ] );
+    }
+    out << "]," << std::endl;
+
+    out << "  \"modules\": [";
+    for( std::size_t i = 0; i < m_statistics.size(); ++i )
+    {
+        ModuleStatistics const& stats = m_statistics[ i ];
+        out << ( i ? "," : "" ) << std::endl
+            << "    {" << std::endl
+            << "      \"name\": " << quote( stats.m_module->getName() ) << "," << std::endl
+            << "      \"uuid\": " << quote( stats.m_module->getUUID() ) << "," << std::endl
+            << "      \"crashed\": " << ( stats.m_module->isCrashed()() ? "true" : "false" ) << "," << std::endl;
+        if( stats.m_module->isCrashed()() )
+        {
+            out << "      \"crashMessage\": " << quote( stats.m_module->getCrashMessage() ) << "," << std::endl;
+        }
+        out << "      \"busyPeriods\": " << stats.m_busyPeriods << "," << std::endl
+            << "      \"wallTime\": " << stats.m_wallTime << "," << std::endl
+            << "      \"cpuTime\": " << stats.m_cpuTime << "," << std::endl
+            << "      \"peakRSSDelta\": " << stats.m_peakRSSDelta << "," << std::endl
+            << "      \"outputs\": [";
+
+        WModule::OutputConnectorList const& outputs = stats.m_module->getOutputConnectors();
+        for( std::size_t j = 0; j < outputs.size(); ++j )
+        {
+            std::shared_ptr< WTransferable > data = outputs[ j ]->getRawData();
+            int64_t const size = estimateSize( data );
+            out << ( j ? "," : "" ) << std::endl
+                << "        { \"name\": " << quote( outputs[ j ]->getName() )
+                << ", \"type\": " << ( data ? quote( data->getName() ) : "null" )
+                << ", \"bytes\": ";
+            if( size < 0 )
+            {
+                out << "null";
+            }
+            else
+            {
+                out << size;
+            }
+            out << " }";
+        }
+        out << ( outputs.empty() ? "" : "\n      " ) << "]" << std::endl
+            << "    }";
+    }
+    out << std::endl << "  ]," << std::endl;
+
+    out << "  \"dumped\": [";
+    for( std::size_t i = 0; i < m_dumpedFiles.size(); ++i )
+    {
+        out << ( i ? ", " : "" ) << quote( m_dumpedFiles[ i ] );
+    }
+    out << "]" << std::endl << "}" << std::endl;
+}
+
+void WBatchRunner::logSummary() const
+{
+    wlog::info( "Batch" ) << "Processing took " << m_totalWallTime << "s wall time and " << m_totalCPUTime << "s CPU time.";
+    for( std::vector< ModuleStatistics >::const_iterator it = m_statistics.begin(); it != m_statistics.end(); ++it )
+    {
+        std::ostringstream line;
+        line << std::left << std::setw( 32 ) << it->m_module->getName() << std::right << std::fixed << std::setprecision( 3 )
+             << " wall " << std::setw( 9 ) << it->m_wallTime << "s"
+             << " cpu " << std::setw( 9 ) << it->m_cpuTime << "s"
+             << " rss +" << std::setw( 7 ) << ( it->m_peakRSSDelta >> 20 ) << "MiB";
+        if( it->m_module->isCrashed()() )
+        {
+            line << " CRASHED: " << it->m_module->getCrashMessage();
+        }
+        wlog::info( "Batch" ) << line.str();
+    }
+    for( std::vector< std::string >::const_iterator it = m_errors.begin(); it != m_errors.end(); ++it )
+    {
+        wlog::error( "Batch" ) << "Project: " << *it;
+    }
+}
+
+void WBatchRunner::dumpOutputs()
+{
+    WTRACE_SCOPE( "Batch dump outputs" );
+
+    boost::filesystem::create_directories( m_dumpDirectory );
+    std::shared_ptr< WModuleContainer > root = WKernel::getRunningKernel()->getRootContainer();
+
+    for( std::size_t i = 0; i < m_statistics.size(); ++i )
+    {
+        WModule::SPtr module = m_statistics[ i ].m_module;
+        WModule::OutputConnectorList const& outputs = module->getOutputConnectors();
+        for( WModule::OutputConnectorList::const_iterator output = outputs.begin(); output != outputs.end(); ++output )
+        {
+            WriterDescription const* description = findWriter( ( *output )->getRawData() );
+            if( !description )
+            {
+                continue;
+            }
+
+            boost::filesystem::path const file = m_dumpDirectory / ( std::to_string( i ) + "_" + sanitize( module->getName() ) + "_" +
+                                                                     sanitize( ( *output )->getName() ) + description->m_extension );
+
+            WModule::SPtr writer = root->createAndAdd( description->m_module );
+            writer->isReadyOrCrashed().wait();
+            if( writer->isCrashed()() )
+            {
+                wlog::error( "Batch" ) << "Could not dump " << ( *output )->getCanonicalName() << ": " << writer->getCrashMessage();
+                root->remove( writer );
+                continue;
+            }
+
+            // the file name needs to be known before the data arrives as some writers save on every update
+            writer->getProperties()->findProperty( description->m_filename )->setAsString( file.string() );
+            writer->getInputConnector( description->m_input )->connect( *output );
+            WPropTrigger trigger = writer->getProperties()->findProperty( description->m_trigger )->toPropTrigger();
+            trigger->set( WPVBaseTypes::PV_TRIGGER_TRIGGERED );
+
+            // the writer resets the trigger when it starts or finishes writing, shutting it down waits for the write to complete
+            std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+            while( trigger->get() == WPVBaseTypes::PV_TRIGGER_TRIGGERED && !writer->isCrashed()() &&
+                   ( m_timeout <= 0.0 || std::chrono::steady_clock::now() - start < std::chrono::duration< double >( m_timeout ) ) )
+            {
+                std::this_thread::sleep_for( samplingInterval );
+            }
+            writer->wait( true );
+            root->remove( writer );
+
+            if( boost::filesystem::exists( file ) )
+            {
+                wlog::info( "Batch" ) << "Dumped " << ( *output )->getCanonicalName() << " to " << file.string();
+                m_dumpedFiles.push_back( file.string() );
+            }
+            else
+            {
+                wlog::warn( "Batch" ) << "Writing " << ( *output )->getCanonicalName() << " to " << file.string() << " failed.";
+            }
+        }
+    }
+}
+
+int64_t WBatchRunner::estimateSize( std::shared_ptr< WTransferable > data )
+{
+    if( std::shared_ptr< WDataSetSingle > single = std::dynamic_pointer_cast< WDataSetSingle >( data ) )
+    {
+        return single->getValueSet() ? single->getValueSet()->applyFunction( ValueSetSize() ) : 0;
+    }
+    if( std::shared_ptr< WDataSetFibers > fibers = std::dynamic_pointer_cast< WDataSetFibers >( data ) )
+    {
+        return static_cast< int64_t >( fibers->getVertices()->size() * sizeof( float ) +
+                                       ( fibers->getLineStartIndexes()->size() + fibers->getLineLengths()->size() +
+                                         fibers->getVerticesReverse()->size() ) * sizeof( size_t ) );
+    }
+    if( std::shared_ptr< WTriangleMesh > mesh = std::dynamic_pointer_cast< WTriangleMesh >( data ) )
+    {
+        return static_cast< int64_t >( mesh->vertSize() * sizeof( osg::Vec3 ) + mesh->triangleSize() * 3 * sizeof( size_t ) );
+    }
+    return -1;
+}
+
+double WBatchRunner::getProcessCPUTime()
+{
+#if( defined( __linux__ ) && !defined( __ANDROID__ ) )
+    rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+    {
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + 1e-6 * ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec );
+    }
+#endif
+    return 0.0;
+}
+
+std::size_t WBatchRunner::getCurrentRSS()
+{
+#if( defined( __linux__ ) && !defined( __ANDROID__ ) )
+    // the second field is the number of resident pages
+    std::ifstream statm( "/proc/self/statm" );
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    if( statm >> size >> resident )
+    {
+        return resident * static_cast< std::size_t >( sysconf( _SC_PAGESIZE ) );
+    }
+#endif
+    return 0;
+}
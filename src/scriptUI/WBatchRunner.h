@@ -0,0 +1,214 @@
+//---------------------------------------------------------------------------
+//
+// Project: OpenWalnut ( http://www.openwalnut.org )
+//
+// Copyright 2014 OpenWalnut Community, BSV@Uni-Leipzig and CNCF@MPI-CBS
+// For more information see http://www.openwalnut.org/copying
+//
+// This file is part of OpenWalnut.
+//
+// OpenWalnut is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenWalnut is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with OpenWalnut. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------
+
+#ifndef WBATCHRUNNER_H
+#define WBATCHRUNNER_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include "core/common/WTransferable.h"
+#include "core/kernel/WModule.h"
+
+/**
+ * Runs a project file without user interaction. The project is loaded into the root container of the running kernel and
+ * the runner waits until all modules are idle, i.e. did not report any pending progress for the settle time. Meanwhile,
+ * the wall time, CPU time and memory growth of the modules are sampled. Afterwards, a report is written and the outputs
+ * can be dumped to files using the writer modules.
+ *
+ * The process wide CPU time and memory are attributed to the modules that are busy while they are sampled. If several
+ * modules compute at the same time, the CPU time is split evenly among them and each of them sees the memory growth.
+ *
+ * \ingroup ui
+ */
+class WBatchRunner // NOLINT
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param project the project file to run
+     */
+    explicit WBatchRunner( boost::filesystem::path project );
+
+    /**
+     * Write the report as JSON to the given file. Without report file, only a summary is logged.
+     *
+     * \param report the file
+     */
+    void setReportFile( boost::filesystem::path report );
+
+    /**
+     * Write the outputs of all modules to the given directory using the writer modules.
+     *
+     * \param directory the directory, created if needed
+     */
+    void setDumpDirectory( boost::filesystem::path directory );
+
+    /**
+     * The time all modules need to be idle before the project counts as finished.
+     *
+     * \param milliseconds the time
+     */
+    void setSettleTime( unsigned int milliseconds );
+
+    /**
+     * Abort waiting after the given time.
+     *
+     * \param seconds the time, 0 waits forever
+     */
+    void setTimeout( double seconds );
+
+    /**
+     * Load the project and wait until it is processed. Needs a running kernel.
+     *
+     * \return 0 on success, 1 if the project could not be loaded or a module crashed, 2 on timeout.
+     */
+    int run();
+
+private:
+    /**
+     * What was measured for a single module.
+     */
+    struct ModuleStatistics
+    {
+        //! the module
+        WModule::SPtr m_module;
+
+        //! true while the module reports pending progress
+        bool m_busy;
+
+        //! how often the module became busy
+        std::size_t m_busyPeriods;
+
+        //! the time the module was busy, in seconds
+        double m_wallTime;
+
+        //! the CPU time attributed to the module, in seconds
+        double m_cpuTime;
+
+        //! the resident set size when the current busy period started
+        std::size_t m_rssAtStart;
+
+        //! the largest growth of the resident set size during a busy period
+        std::size_t m_peakRSSDelta;
+    };
+
+    /**
+     * Samples the modules until all are idle or the timeout is reached.
+     *
+     * \return false on timeout
+     */
+    bool monitor();
+
+    /**
+     * Checks whether a module is computing.
+     *
+     * \param module the module
+     *
+     * \return true if the module is not ready yet or reports pending progress
+     */
+    static bool isBusy( WModule::SPtr module );
+
+    /**
+     * Write the report.
+     *
+     * \param out the stream
+     * \param timedOut true if the runner stopped waiting
+     */
+    void writeReport( std::ostream& out, bool timedOut ) const;
+
+    /**
+     * Log a summary table of the report.
+     */
+    void logSummary() const;
+
+    /**
+     * Write all outputs of all modules, as far as there is a writer for them.
+     */
+    void dumpOutputs();
+
+    /**
+     * The size of the given data in memory.
+     *
+     * \param data the data
+     *
+     * \return the size in bytes or -1 if unknown
+     */
+    static int64_t estimateSize( std::shared_ptr< WTransferable > data );
+
+    /**
+     * The CPU time used by this process.
+     *
+     * \return user and system time in seconds
+     */
+    static double getProcessCPUTime();
+
+    /**
+     * The current resident set size of this process.
+     *
+     * \return the size in bytes, 0 if unknown
+     */
+    static std::size_t getCurrentRSS();
+
+    //! the project file
+    boost::filesystem::path m_project;
+
+    //! the report file, may be empty
+    boost::filesystem::path m_report;
+
+    //! the dump directory, may be empty
+    boost::filesystem::path m_dumpDirectory;
+
+    //! the settle time in milliseconds
+    unsigned int m_settleTime;
+
+    //! the timeout in seconds
+    double m_timeout;
+
+    //! the statistics of all modules, in the order they appeared
+    std::vector< ModuleStatistics > m_statistics;
+
+    //! the errors reported while loading the project
+    std::vector< std::string > m_errors;
+
+    //! the warnings reported while loading the project
+    std::vector< std::string > m_warnings;
+
+    //! the time from starting to load the project until all modules were idle
+    double m_totalWallTime;
+
+    //! the CPU time used meanwhile
+    double m_totalCPUTime;
+
+    //! the files written by dumpOutputs
+    std::vector< std::string > m_dumpedFiles;
+};
+
+#endif  // WBATCHRUNNER_H
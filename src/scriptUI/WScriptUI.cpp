@@ -30,14 +30,18 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/bind/bind.hpp>
 
+#include "WBatchRunner.h"
 #include "WScriptUI.h"
+#include "core/common/WConditionOneShot.h"
 #include "core/common/WIOTools.h"
 #include "core/common/WLogStream.h"
 #include "core/common/WLogger.h"
 #include "core/common/WPathHelper.h"
 #include "core/common/WSegmentationFault.h"
 #include "core/common/WThreadedRunner.h"
+#include "core/common/WTracer.h"
 #include "core/kernel/WKernel.h"
 #include "core/kernel/WModuleFactory.h"
 
@@ -82,6 +86,12 @@ int WScriptUI::run()
 
     loadToolboxes( WPathHelper::getHomePath() / "config.script" );
 
+    // record everything from the kernel startup on
+    if( m_programOptions.count( "trace" ) )
+    {
+        WTracer::setEnabled( true );
+    }
+
     //----------------------------
     // startup
     //----------------------------
@@ -90,6 +100,12 @@ int WScriptUI::run()
     std::shared_ptr< WKernel > kernel( WKernel::instance( WGraphicsEngine::getGraphicsEngine(), shared_from_this() ) );
     kernel->run();
 
+    // run a project without interaction
+    if( m_programOptions.count( "project" ) )
+    {
+        return runProject( kernel );
+    }
+
     //--------------------------------
     // choose interpreter to use
     //--------------------------------
@@ -187,6 +203,7 @@ int WScriptUI::run()
 
     // signal everybody to shut down properly.
     WKernel::getRunningKernel()->wait( true );
+    writeTrace();
 
     // TODO(reichenbach): waiting for the graphics engine to stop will result in a deadlock; why?
     // WKernel::getRunningKernel()->getGraphicsEngine()->wait( true );
@@ -194,6 +211,51 @@ int WScriptUI::run()
     return 0;
 }
 
+int WScriptUI::runProject( std::shared_ptr< WKernel > kernel )
+{
+    WBatchRunner runner( m_programOptions[ "project" ].as< std::string >() );
+    if( m_programOptions.count( "report" ) )
+    {
+        runner.setReportFile( m_programOptions[ "report" ].as< std::string >() );
+    }
+    if( m_programOptions.count( "dump" ) )
+    {
+        runner.setDumpDirectory( m_programOptions[ "dump" ].as< std::string >() );
+    }
+    runner.setSettleTime( m_programOptions[ "settle-time" ].as< unsigned int >() );
+    runner.setTimeout( m_programOptions[ "timeout" ].as< double >() );
+
+    // the kernel loads modules only after the UI is initialized
+    std::shared_ptr< WConditionOneShot > startupCompleted( new WConditionOneShot() );
+    kernel->subscribeSignal( WKernel::KERNEL_STARTUPCOMPLETE, boost::bind( &WConditionOneShot::notify, startupCompleted ) );
+    m_isInitialized( true );
+    startupCompleted->wait();
+
+    int result = runner.run();
+
+    // signal everybody to shut down properly.
+    kernel->wait( true );
+    writeTrace();
+    return result;
+}
+
+void WScriptUI::writeTrace() const
+{
+    if( m_programOptions.count( "trace" ) )
+    {
+        boost::filesystem::path traceFile( m_programOptions[ "trace" ].as< std::string >() );
+        WTracer::setEnabled( false );
+        if( WTracer::writeChromeTrace( traceFile ) )
+        {
+            wlog::info( "Walnut" ) << "Wrote trace to " << traceFile.string();
+        }
+        else
+        {
+            wlog::error( "Walnut" ) << "Could not write trace to " << traceFile.string();
+        }
+    }
+}
+
 void WScriptUI::loadToolboxes( boost::filesystem::path configPath )
 {
     // add additional module paths to the PathHelper, the rest will be done by module loader
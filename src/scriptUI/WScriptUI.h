@@ -25,12 +25,15 @@
 #ifndef WSCRIPTUI_H
 #define WSCRIPTUI_H
 
+#include <memory>
 #include <string>
 
 #include <boost/program_options.hpp>
 
 #include "core/ui/WUI.h"
 
+class WKernel;
+
 /**
  * \class WScriptUI
  *
@@ -81,6 +84,20 @@ protected:
      */
     virtual void loadToolboxes( boost::filesystem::path configPath );
 
+    /**
+     * Loads the project given on the command line, waits until all modules are done and writes the report. See WBatchRunner.
+     *
+     * \param kernel the running kernel
+     *
+     * \return the return code.
+     */
+    int runProject( std::shared_ptr< WKernel > kernel );
+
+    /**
+     * Writes the trace if requested on the command line.
+     */
+    void writeTrace() const;
+
     //! The programm options.
     boost::program_options::variables_map const& m_programOptions;
 };
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#
+# Compares the JSON results of ow_benchmarks against a baseline.
+#
+# Usage: compareBenchmarks.py [--threshold PERCENT] [--metric min_ns|median_ns|mean_ns] baseline.json current.json
+#
+# The exit code is 1 if any benchmark got slower than the threshold allows, 2 if the files cannot be compared.
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    if data.get("format") != "ow_benchmarks 1":
+        raise ValueError(filename + " is not an ow_benchmarks result file")
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare ow_benchmarks results against a baseline.")
+    parser.add_argument("baseline", help="the stored baseline results")
+    parser.add_argument("current", help="the results to check")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent before a benchmark counts as regression (default: 10)")
+    parser.add_argument("--metric", default="median_ns", choices=["min_ns", "median_ns", "mean_ns"],
+                        help="the time to compare (default: median_ns)")
+    args = parser.parse_args()
+
+    try:
+        baseline = load(args.baseline)
+        current = load(args.current)
+    except (IOError, ValueError) as e:
+        print("error: " + str(e), file=sys.stderr)
+        return 2
+
+    if baseline["parameters"] != current["parameters"]:
+        print("warning: the benchmarks used different parameters, times are not comparable", file=sys.stderr)
+        for key in sorted(set(baseline["parameters"]) | set(current["parameters"])):
+            print("  %s: %s -> %s" % (key, baseline["parameters"].get(key), current["parameters"].get(key)), file=sys.stderr)
+
+    old = dict((b["name"], b) for b in baseline["benchmarks"])
+    regressions = 0
+    width = max([len(b["name"]) for b in current["benchmarks"]] + [9])
+    print("%-*s %14s %14s %9s" % (width, "benchmark", "baseline [ms]", "current [ms]", "change"))
+    for b in current["benchmarks"]:
+        name = b["name"]
+        if name not in old:
+            print("%-*s %14s %14.3f %9s" % (width, name, "-", b[args.metric] * 1e-6, "new"))
+            continue
+        before = old[name][args.metric]
+        after = b[args.metric]
+        change = 100.0 * (after - before) / before if before > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        print("%-*s %14.3f %14.3f %+8.1f%%%s" % (width, name, before * 1e-6, after * 1e-6, change, mark))
+
+    for name in sorted(set(old) - set(b["name"] for b in current["benchmarks"])):
+        print("%-*s %14.3f %14s %9s" % (width, name, old[name][args.metric] * 1e-6, "-", "missing"))
+
+    if regressions:
+        print("%d benchmark(s) got more than %.1f%% slower." % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())